@@ -36,6 +36,24 @@
 #define DT_MIN_TO_CORRECT 1e-5
 #define DT_MIN            0.001
 
+/* Helper functions for temporally blocked time stepping (defined below) */
+
+/*
+ * Function type for computing the right-hand side of the level set
+ * equation for 'phi' on the fill boxes of 'grid'.
+ */
+typedef void (*LSE_RHS_Function3d)(LSM_DataArrays *,LSMLIB_REAL *,Grid *,
+                                   Options *);
+
+void computeCurvatureModelLSERHS3d(LSM_DataArrays *,LSMLIB_REAL *,Grid *,
+                                   Options *);
+void computeReinitializationLSERHS3d(LSM_DataArrays *,LSMLIB_REAL *,Grid *,
+                                     Options *);
+LSMLIB_REAL computeCurvatureModelStableDt3d(LSM_DataArrays *,Grid *,Options *,
+                                       LSMLIB_REAL,LSMLIB_REAL,LSMLIB_REAL);
+void advanceTVDRK2BySlabs3d(LSM_DataArrays *,Grid *,Options *,
+                            LSE_RHS_Function3d,LSMLIB_REAL,int,int);
+
 /* Main loop for constant curvature level set method model in 3D */
 
 void curvatureModelMedium3dMainLoop(
@@ -145,6 +163,25 @@ void curvatureModelMedium3dMainLoop(
       INNER_STEP++;
       TOTAL_STEP++;
       
+      if( o->slab_size > 0 )
+      { /* temporally blocked time step - advance the grid slab by slab */
+      
+        /* for a > 0, dt depends on grad phi over the whole grid, so the  */
+        /* first stage right-hand side is computed before the slab sweep */ 
+        if( o->a > 0 ) computeCurvatureModelLSERHS3d(d,d->phi,g,o);
+        dt = computeCurvatureModelStableDt3d(d,g,o,cfl_number,dt_corr,tplot);
+        
+        if( dt < DT_MIN_TO_CORRECT ) dt = DT_MIN; 
+        if( dt_sub + dt > tplot ) dt = tplot - dt_sub;
+        if( dt > dt_max ) dt_max = dt;
+        if( dt < dt_min ) dt_min = dt;
+        
+        advanceTVDRK2BySlabs3d(d,g,o,computeCurvatureModelLSERHS3d,dt,
+                               o->do_mask,(o->a > 0));
+        dt_sub = dt_sub + dt;
+        continue;
+      }
+      
       SET_DATA_TO_CONSTANT(d->lse_rhs,g,zero)    
      
       if(o->a > 0)
@@ -505,6 +542,13 @@ void reinitializeMedium3d(
     
     while(t_r < tmax_r )
     {
+      if( o->slab_size > 0 )
+      { /* temporally blocked time step - advance the grid slab by slab */
+        advanceTVDRK2BySlabs3d(d,g,o,computeReinitializationLSERHS3d,dt_r,0,0);
+        t_r = t_r + dt_r;
+        continue;
+      }
+      
       LSM3D_HJ_ENO2(d->phi_x_plus, d->phi_y_plus, d->phi_z_plus,
                     &(g->ilo_gb), &(g->ihi_gb), &(g->jlo_gb), &(g->jhi_gb),
 		    &(g->klo_gb),&(g->khi_gb),
@@ -624,3 +668,541 @@ void reinitializeMedium3d(
     }
 }	 
 
+
+
+/*======== Helper functions for temporally blocked time stepping ========*/
+
+/*
+ * SLAB_OFFSET() returns the index of the first point of plane k.
+ */
+#define SLAB_OFFSET(grid, k) \
+  (((k) - (grid)->klo_gb)*(grid)->grid_dims_ghostbox[0]* \
+                          (grid)->grid_dims_ghostbox[1])
+
+
+/*
+ * OFFSET_POINTER() shifts a data pointer by 'offset' grid points unless
+ * it is NULL.
+ */
+#define OFFSET_POINTER(p, offset) ((p) ? (p) + (offset) : NULL)
+
+
+/*
+ * setSlabView() sets 'slab_grid' and 'slab_data_arrays' to a view of
+ * the planes klo <= k <= khi of the fill box of 'grid' together with
+ * ghost_width planes on either side:
+ *  - the ghostbox of the view is restricted to klo - ghost_width <= k <=
+ *    khi + ghost_width and its fill boxes to klo <= k <= khi (the fill
+ *    boxes of the undivided differences keep their widths relative to
+ *    the fill box) 
+ *  - the data pointers of the view point to the first plane of its 
+ *    ghostbox
+ * Kernels called with the view only touch the planes of the view, so
+ * the cost of a call is proportional to the size of the slab.
+ */
+static void setSlabView(
+  Grid           *slab_grid, 
+  LSM_DataArrays *slab_data_arrays, 
+  Grid           *grid,
+  LSM_DataArrays *data_arrays,
+  int             klo,
+  int             khi,
+  int             ghost_width)
+{
+  int offset = SLAB_OFFSET(grid,klo-ghost_width);
+  Grid           *s = slab_grid;
+  LSM_DataArrays *sd = slab_data_arrays;
+  LSM_DataArrays *d = data_arrays;
+  
+  *s = *grid;
+  s->klo_gb = klo - ghost_width;
+  s->khi_gb = khi + ghost_width;
+  s->grid_dims_ghostbox[2] = s->khi_gb - s->klo_gb + 1;
+  s->num_gridpts = s->grid_dims_ghostbox[0]*s->grid_dims_ghostbox[1]*
+                   s->grid_dims_ghostbox[2];
+  
+  s->klo_fb = klo;
+  s->khi_fb = khi;
+  s->klo_D1_fb = klo - (grid->klo_fb - grid->klo_D1_fb);
+  s->khi_D1_fb = khi + (grid->khi_D1_fb - grid->khi_fb);
+  s->klo_D2_fb = klo - (grid->klo_fb - grid->klo_D2_fb);
+  s->khi_D2_fb = khi + (grid->khi_D2_fb - grid->khi_fb);
+  s->klo_D3_fb = klo - (grid->klo_fb - grid->klo_D3_fb);
+  s->khi_D3_fb = khi + (grid->khi_D3_fb - grid->khi_fb);
+  
+  /* only the arrays used by the time stepping are offset */
+  *sd = *d;
+  sd->phi         = OFFSET_POINTER(d->phi,offset);
+  sd->phi_stage1  = OFFSET_POINTER(d->phi_stage1,offset);
+  sd->phi_next    = OFFSET_POINTER(d->phi_next,offset);
+  sd->phi0        = OFFSET_POINTER(d->phi0,offset);
+  sd->mask        = OFFSET_POINTER(d->mask,offset);
+  sd->lse_rhs     = OFFSET_POINTER(d->lse_rhs,offset);
+  sd->phi_x_plus  = OFFSET_POINTER(d->phi_x_plus,offset);
+  sd->phi_y_plus  = OFFSET_POINTER(d->phi_y_plus,offset);
+  sd->phi_z_plus  = OFFSET_POINTER(d->phi_z_plus,offset);
+  sd->phi_x_minus = OFFSET_POINTER(d->phi_x_minus,offset);
+  sd->phi_y_minus = OFFSET_POINTER(d->phi_y_minus,offset);
+  sd->phi_z_minus = OFFSET_POINTER(d->phi_z_minus,offset);
+  sd->phi_x       = OFFSET_POINTER(d->phi_x,offset);
+  sd->phi_y       = OFFSET_POINTER(d->phi_y,offset);
+  sd->phi_z       = OFFSET_POINTER(d->phi_z,offset);
+  sd->D1          = OFFSET_POINTER(d->D1,offset);
+  sd->D2          = OFFSET_POINTER(d->D2,offset);
+  sd->D3          = OFFSET_POINTER(d->D3,offset);
+  sd->phi_xx      = OFFSET_POINTER(d->phi_xx,offset);
+  sd->phi_yy      = OFFSET_POINTER(d->phi_yy,offset);
+  sd->phi_zz      = OFFSET_POINTER(d->phi_zz,offset);
+  sd->phi_xy      = OFFSET_POINTER(d->phi_xy,offset);
+  sd->phi_xz      = OFFSET_POINTER(d->phi_xz,offset);
+  sd->phi_yz      = OFFSET_POINTER(d->phi_yz,offset);
+}
+
+
+/*
+ * signedLinearExtrapolationBCSlab() imposes signedLinearExtrapolationBC()
+ * on all boundaries for the planes klo <= k <= khi of the fill box.
+ * The x and y boundaries are extrapolated within those planes only; the
+ * z boundaries are extrapolated when klo (khi) is the first (last) plane
+ * of the fill box.  The result is the same as that of
+ * signedLinearExtrapolationBC() with bdry_location_idx = 9 once all
+ * planes have been processed in increasing order.
+ */
+static void signedLinearExtrapolationBCSlab(
+  LSMLIB_REAL *phi,
+  Grid        *g,
+  int          klo,
+  int          khi)
+{
+  int bdry_location_idx;
+  
+  for (bdry_location_idx = 0; bdry_location_idx < 4; bdry_location_idx++) {
+    LSM3D_SIGNED_LINEAR_EXTRAPOLATION(phi + SLAB_OFFSET(g,klo),
+      &(g->ilo_gb), &(g->ihi_gb), &(g->jlo_gb), &(g->jhi_gb), &klo, &khi,
+      &(g->ilo_fb), &(g->ihi_fb), &(g->jlo_fb), &(g->jhi_fb), &klo, &khi,
+      &bdry_location_idx);
+  }
+  
+  if (klo == g->klo_fb) {
+    bdry_location_idx = 4;
+    LSM3D_SIGNED_LINEAR_EXTRAPOLATION(phi,
+      &(g->ilo_gb), &(g->ihi_gb), &(g->jlo_gb), &(g->jhi_gb),
+      &(g->klo_gb), &(g->khi_gb),
+      &(g->ilo_fb), &(g->ihi_fb), &(g->jlo_fb), &(g->jhi_fb),
+      &(g->klo_fb), &(g->khi_fb),
+      &bdry_location_idx);
+  }
+  if (khi == g->khi_fb) {
+    bdry_location_idx = 5;
+    LSM3D_SIGNED_LINEAR_EXTRAPOLATION(phi,
+      &(g->ilo_gb), &(g->ihi_gb), &(g->jlo_gb), &(g->jhi_gb),
+      &(g->klo_gb), &(g->khi_gb),
+      &(g->ilo_fb), &(g->ihi_fb), &(g->jlo_fb), &(g->jhi_fb),
+      &(g->klo_fb), &(g->khi_fb),
+      &bdry_location_idx);
+  }
+}
+
+
+/*
+ * imposeMaskSlab() sets phi_masked = max(phi,mask) (or phi_masked = phi
+ * if do_mask is 0) on the planes klo <= k <= khi of the ghostbox.
+ */
+static void imposeMaskSlab(
+  LSMLIB_REAL *phi_masked,
+  LSMLIB_REAL *mask,
+  LSMLIB_REAL *phi,
+  Grid        *g,
+  int          klo,
+  int          khi,
+  int          do_mask)
+{
+  int idx;
+  int idx_hi = SLAB_OFFSET(g,khi+1);
+  
+  if (do_mask) {
+    for (idx = SLAB_OFFSET(g,klo); idx < idx_hi; idx++) {
+      phi_masked[idx] = (mask[idx] > phi[idx]) ? mask[idx] : phi[idx];
+    }
+  } else if (phi_masked != phi) {
+    for (idx = SLAB_OFFSET(g,klo); idx < idx_hi; idx++) {
+      phi_masked[idx] = phi[idx];
+    }
+  }
+}
+
+
+/*
+ * computeCurvatureModelLSERHS3d() computes the right-hand side of the
+ * level set equation phi_t + a |grad phi| = b kappa |grad phi| on the
+ * fill box of grid (HJ ENO2 for the normal velocity term, second-order
+ * central differences for the curvature term).
+ *
+ * Arguments:
+ *   data_arrays - LSMLIB Serial package data arrays structure; lse_rhs
+ *                 and the derivative arrays are overwritten
+ *   phi         - level set function
+ *   grid        - Grid structure
+ *
+ * NOTES:
+ *  - data_arrays, phi and grid may be a slab view set by setSlabView()
+ *   options     - Options structure; 'a' and 'b' are used
+ */
+void computeCurvatureModelLSERHS3d(
+     LSM_DataArrays *data_arrays,
+     LSMLIB_REAL    *phi,
+     Grid           *grid,
+     Options        *options)
+{
+  LSMLIB_REAL vel_n = options->a;
+  LSMLIB_REAL zero = 0.0;
+  
+  /* writing shortcuts */
+  Grid             *g = grid;
+  LSM_DataArrays   *d = data_arrays;
+  Options          *o = options;
+  
+  SET_DATA_TO_CONSTANT(d->lse_rhs,g,zero)
+  
+  if( o->a > 0 )
+  {
+    LSM3D_HJ_ENO2(d->phi_x_plus, d->phi_y_plus, d->phi_z_plus,
+              &(g->ilo_gb), &(g->ihi_gb), &(g->jlo_gb), &(g->jhi_gb),
+              &(g->klo_gb), &(g->khi_gb),
+              d->phi_x_minus, d->phi_y_minus, d->phi_z_minus,
+              &(g->ilo_gb), &(g->ihi_gb), &(g->jlo_gb), &(g->jhi_gb),
+              &(g->klo_gb), &(g->khi_gb),
+              phi,
+              &(g->ilo_gb), &(g->ihi_gb), &(g->jlo_gb), &(g->jhi_gb),
+              &(g->klo_gb), &(g->khi_gb),
+              d->D1,
+              &(g->ilo_gb), &(g->ihi_gb), &(g->jlo_gb), &(g->jhi_gb),
+              &(g->klo_gb), &(g->khi_gb),
+              d->D2,
+              &(g->ilo_gb), &(g->ihi_gb), &(g->jlo_gb), &(g->jhi_gb),
+              &(g->klo_gb), &(g->khi_gb),
+              &(g->ilo_fb), &(g->ihi_fb), &(g->jlo_fb), &(g->jhi_fb),
+              &(g->klo_fb), &(g->khi_fb),
+              &((g->dx)[0]),&((g->dx)[1]),&((g->dx)[2]));
+    LSM3D_ADD_CONST_NORMAL_VEL_TERM_TO_LSE_RHS(d->lse_rhs,
+              &(g->ilo_gb), &(g->ihi_gb), &(g->jlo_gb), &(g->jhi_gb),
+              &(g->klo_gb), &(g->khi_gb),
+              d->phi_x_plus, d->phi_y_plus, d->phi_z_plus,
+              &(g->ilo_gb), &(g->ihi_gb), &(g->jlo_gb), &(g->jhi_gb),
+              &(g->klo_gb), &(g->khi_gb),
+              d->phi_x_minus, d->phi_y_minus, d->phi_z_minus,
+              &(g->ilo_gb), &(g->ihi_gb), &(g->jlo_gb), &(g->jhi_gb),
+              &(g->klo_gb), &(g->khi_gb),
+              &vel_n,
+              &(g->ilo_fb), &(g->ihi_fb), &(g->jlo_fb), &(g->jhi_fb),
+              &(g->klo_fb), &(g->khi_fb));
+  }
+  
+  if( o->b > 0 )
+  {
+    LSM3D_CENTRAL_GRAD_ORDER2(d->phi_x, d->phi_y, d->phi_z,
+              &(g->ilo_gb), &(g->ihi_gb), &(g->jlo_gb), &(g->jhi_gb),
+              &(g->klo_gb), &(g->khi_gb),
+              phi,
+              &(g->ilo_gb), &(g->ihi_gb), &(g->jlo_gb), &(g->jhi_gb),
+              &(g->klo_gb), &(g->khi_gb),
+              &(g->ilo_D1_fb), &(g->ihi_D1_fb),
+              &(g->jlo_D1_fb), &(g->jhi_D1_fb),
+              &(g->klo_D1_fb), &(g->khi_D1_fb),
+              &((g->dx)[0]),&((g->dx)[1]),&((g->dx)[2]));
+    LSM3D_CENTRAL_GRAD_ORDER2(d->phi_xx, d->phi_xy, d->phi_xz,
+              &(g->ilo_gb), &(g->ihi_gb), &(g->jlo_gb), &(g->jhi_gb),
+              &(g->klo_gb), &(g->khi_gb),
+              d->phi_x,
+              &(g->ilo_gb), &(g->ihi_gb), &(g->jlo_gb), &(g->jhi_gb),
+              &(g->klo_gb), &(g->khi_gb),
+              &(g->ilo_D2_fb), &(g->ihi_D2_fb),
+              &(g->jlo_D2_fb), &(g->jhi_D2_fb),
+              &(g->klo_D2_fb), &(g->khi_D2_fb),
+              &((g->dx)[0]),&((g->dx)[1]),&((g->dx)[2]));
+    LSM3D_CENTRAL_GRAD_ORDER2(d->phi_xy, d->phi_yy, d->phi_yz,
+              &(g->ilo_gb), &(g->ihi_gb), &(g->jlo_gb), &(g->jhi_gb),
+              &(g->klo_gb), &(g->khi_gb),
+              d->phi_y,
+              &(g->ilo_gb), &(g->ihi_gb), &(g->jlo_gb), &(g->jhi_gb),
+              &(g->klo_gb), &(g->khi_gb),
+              &(g->ilo_D2_fb), &(g->ihi_D2_fb),
+              &(g->jlo_D2_fb), &(g->jhi_D2_fb),
+              &(g->klo_D2_fb), &(g->khi_D2_fb),
+              &((g->dx)[0]),&((g->dx)[1]),&((g->dx)[2]));
+    LSM3D_CENTRAL_GRAD_ORDER2(d->phi_xz, d->phi_yz, d->phi_zz,
+              &(g->ilo_gb), &(g->ihi_gb), &(g->jlo_gb), &(g->jhi_gb),
+              &(g->klo_gb), &(g->khi_gb),
+              d->phi_z,
+              &(g->ilo_gb), &(g->ihi_gb), &(g->jlo_gb), &(g->jhi_gb),
+              &(g->klo_gb), &(g->khi_gb),
+              &(g->ilo_D2_fb), &(g->ihi_D2_fb),
+              &(g->jlo_D2_fb), &(g->jhi_D2_fb),
+              &(g->klo_D2_fb), &(g->khi_D2_fb),
+              &((g->dx)[0]),&((g->dx)[1]),&((g->dx)[2]));
+    LSM3D_ADD_CONST_CURV_TERM_TO_LSE_RHS(d->lse_rhs,
+              &(g->ilo_gb), &(g->ihi_gb), &(g->jlo_gb), &(g->jhi_gb),
+              &(g->klo_gb), &(g->khi_gb),
+              d->phi_x,d->phi_y,d->phi_z,
+              &(g->ilo_gb), &(g->ihi_gb), &(g->jlo_gb), &(g->jhi_gb),
+              &(g->klo_gb), &(g->khi_gb),
+              d->phi_xx,d->phi_xy,d->phi_xz,
+              d->phi_yy,d->phi_yz,d->phi_zz,
+              &(g->ilo_gb), &(g->ihi_gb), &(g->jlo_gb), &(g->jhi_gb),
+              &(g->klo_gb), &(g->khi_gb),
+              &(o->b),
+              &(g->ilo_D2_fb), &(g->ihi_D2_fb),
+              &(g->jlo_D2_fb), &(g->jhi_D2_fb),
+              &(g->klo_D2_fb), &(g->khi_D2_fb));
+  }
+}
+
+
+/*
+ * computeReinitializationLSERHS3d() computes the right-hand side of the
+ * reinitialization equation (HJ ENO2) on the fill box of grid.  The sign
+ * of data_arrays->phi0 is NOT used.
+ *
+ * Arguments:  same as computeCurvatureModelLSERHS3d(); options is unused
+ */
+void computeReinitializationLSERHS3d(
+     LSM_DataArrays *data_arrays,
+     LSMLIB_REAL    *phi,
+     Grid           *grid,
+     Options        *options)
+{
+  int use_phi0_for_sign = 0;
+  
+  /* writing shortcuts */
+  Grid             *g = grid;
+  LSM_DataArrays   *d = data_arrays;
+  
+  LSM3D_HJ_ENO2(d->phi_x_plus, d->phi_y_plus, d->phi_z_plus,
+              &(g->ilo_gb), &(g->ihi_gb), &(g->jlo_gb), &(g->jhi_gb),
+              &(g->klo_gb), &(g->khi_gb),
+              d->phi_x_minus, d->phi_y_minus, d->phi_z_minus,
+              &(g->ilo_gb), &(g->ihi_gb), &(g->jlo_gb), &(g->jhi_gb),
+              &(g->klo_gb), &(g->khi_gb),
+              phi,
+              &(g->ilo_gb), &(g->ihi_gb), &(g->jlo_gb), &(g->jhi_gb),
+              &(g->klo_gb), &(g->khi_gb),
+              d->D1,
+              &(g->ilo_gb), &(g->ihi_gb), &(g->jlo_gb), &(g->jhi_gb),
+              &(g->klo_gb), &(g->khi_gb),
+              d->D2,
+              &(g->ilo_gb), &(g->ihi_gb), &(g->jlo_gb), &(g->jhi_gb),
+              &(g->klo_gb), &(g->khi_gb),
+              &(g->ilo_fb), &(g->ihi_fb), &(g->jlo_fb), &(g->jhi_fb),
+              &(g->klo_fb), &(g->khi_fb),
+              &((g->dx)[0]),&((g->dx)[1]),&((g->dx)[2]));
+  LSM3D_COMPUTE_REINITIALIZATION_EQN_RHS(d->lse_rhs,
+              &(g->ilo_gb), &(g->ihi_gb), &(g->jlo_gb), &(g->jhi_gb),
+              &(g->klo_gb), &(g->khi_gb),
+              phi,
+              &(g->ilo_gb), &(g->ihi_gb), &(g->jlo_gb), &(g->jhi_gb),
+              &(g->klo_gb), &(g->khi_gb),
+              d->phi0,
+              &(g->ilo_gb), &(g->ihi_gb), &(g->jlo_gb), &(g->jhi_gb),
+              &(g->klo_gb), &(g->khi_gb),
+              d->phi_x_plus, d->phi_y_plus, d->phi_z_plus,
+              &(g->ilo_gb), &(g->ihi_gb), &(g->jlo_gb), &(g->jhi_gb),
+              &(g->klo_gb), &(g->khi_gb),
+              d->phi_x_minus, d->phi_y_minus, d->phi_z_minus,
+              &(g->ilo_gb), &(g->ihi_gb), &(g->jlo_gb), &(g->jhi_gb),
+              &(g->klo_gb), &(g->khi_gb),
+              &(g->ilo_fb), &(g->ihi_fb), &(g->jlo_fb), &(g->jhi_fb),
+              &(g->klo_fb), &(g->khi_fb),
+              &((g->dx)[0]), &((g->dx)[1]),&((g->dx)[2]),
+              &use_phi0_for_sign);
+}
+
+
+/*
+ * computeCurvatureModelStableDt3d() computes the stable time step for
+ * the curvature model on the whole grid (the same time step that
+ * curvatureModelMedium3dMainLoop() uses for a full grid sweep).
+ *
+ * Arguments:
+ *   data_arrays - LSMLIB Serial package data arrays structure
+ *   grid        - Grid structure
+ *   options     - Options structure; 'a' and 'b' are used
+ *   cfl_number  - CFL number
+ *   dt_corr     - time step correction for the curvature term
+ *   tplot       - time step used if a = 0 and b = 0
+ *
+ * Return value: stable time step
+ *
+ * NOTES:
+ *  - if a > 0, the upwind derivatives of phi must have been computed on
+ *    the whole grid by computeCurvatureModelLSERHS3d().
+ */
+LSMLIB_REAL computeCurvatureModelStableDt3d(
+     LSM_DataArrays *data_arrays,
+     Grid           *grid,
+     Options        *options,
+     LSMLIB_REAL     cfl_number,
+     LSMLIB_REAL     dt_corr,
+     LSMLIB_REAL     tplot)
+{
+  LSMLIB_REAL dt, max_H;
+  LSMLIB_REAL vel_n = options->a;
+  
+  /* writing shortcuts */
+  Grid             *g = grid;
+  LSM_DataArrays   *d = data_arrays;
+  Options          *o = options;
+  
+  if( o->a > 0 )
+  {
+    LSM3D_COMPUTE_STABLE_CONST_NORMAL_VEL_DT(&dt,&vel_n,
+              d->phi_x_plus, d->phi_y_plus, d->phi_z_plus,
+              &(g->ilo_gb), &(g->ihi_gb), &(g->jlo_gb), &(g->jhi_gb),
+              &(g->klo_gb), &(g->khi_gb),
+              d->phi_x_minus, d->phi_y_minus,  d->phi_z_minus,
+              &(g->ilo_gb), &(g->ihi_gb), &(g->jlo_gb), &(g->jhi_gb),
+              &(g->klo_gb), &(g->khi_gb),
+              &(g->ilo_fb), &(g->ihi_fb), &(g->jlo_fb), &(g->jhi_fb),
+              &(g->klo_fb), &(g->khi_fb),
+              &((g->dx)[0]),&((g->dx)[1]),&((g->dx)[2]),
+              &cfl_number);
+  }
+  else dt = tplot;
+  
+  if( o->b > 0 )
+  {
+    /* correct dt due to parabolic (curvature) term */
+    if( o->a > 0 )
+      max_H = cfl_number / dt;
+    else 
+      max_H = 0;
+    
+    dt =  cfl_number / (max_H + dt_corr);
+  }
+  
+  return dt;
+}
+
+
+/*
+ * advanceTVDRK2BySlabs3d() advances data_arrays->phi by one second-order
+ * TVD Runge-Kutta step with time step dt, taking both stages for one
+ * slab of options->slab_size z-planes before moving on to the next one
+ * (temporal blocking).  Each slab recomputes the first stage on its
+ * planes plus a ghost region as wide as the ghostbox (i.e. the stencil
+ * of the spatial derivatives chosen by setIndexSpaceLimits()), so the
+ * working set of a step is a few slabs instead of the whole grid.  The
+ * result is identical to sweeping the whole grid for each stage.
+ *
+ * Arguments:
+ *   data_arrays   - LSMLIB Serial package data arrays structure
+ *   grid          - Grid structure
+ *   options       - Options structure; 'slab_size' and 'do_mask' are used
+ *   compute_rhs   - function that computes the right-hand side of the
+ *                   level set equation on the fill box of a grid
+ *   dt            - time step
+ *   mask_stage1   - impose the mask on the first stage (1) or not (0)
+ *   have_stage1_rhs - data_arrays->lse_rhs already holds the first stage
+ *                   right-hand side on the whole fill box (1) or not (0)
+ *
+ * NOTES:
+ *  - signedLinearExtrapolationBC() is imposed on all boundaries after
+ *    each stage; the mask (if options->do_mask) is imposed on the result.
+ *  - data_arrays->phi_stage1, phi_next, lse_rhs and the derivative
+ *    arrays are used as scratch space.
+ */
+void advanceTVDRK2BySlabs3d(
+     LSM_DataArrays     *data_arrays,
+     Grid               *grid,
+     Options            *options,
+     LSE_RHS_Function3d  compute_rhs,
+     LSMLIB_REAL         dt,
+     int                 mask_stage1,
+     int                 have_stage1_rhs)
+{
+  Grid           slab;
+  LSM_DataArrays slab_data;
+  int ghost_width = grid->klo_fb - grid->klo_gb;
+  int slab_size = (options->slab_size < 2) ? 2 : options->slab_size;
+  
+  int klo, khi;                   /* planes of the current slab         */
+  int klo_s1, khi_s1;             /* planes of phi_stage1 computed for  */
+                                  /* the current slab                   */
+  int klo_mask = grid->klo_gb;    /* first plane of phi_stage1 not yet  */ 
+                                  /* masked                             */
+  int klo_phi = grid->klo_gb;     /* first plane of phi not yet updated */
+  int khi_mask, khi_phi;
+  
+  /* writing shortcuts */
+  Grid             *g = grid;
+  LSM_DataArrays   *d = data_arrays;
+  Grid             *s = &slab;
+  LSM_DataArrays   *sd = &slab_data;
+  Options          *o = options;
+  
+  khi_s1 = g->klo_fb - 1;
+  for (klo = g->klo_fb; klo <= g->khi_fb; klo = khi + 1) {
+    
+    /* the last slab absorbs the remaining planes if they are too few   */
+    /* for the extrapolation at the upper z boundary to be done last    */
+    khi = klo + slab_size - 1;
+    if (khi + ghost_width + 2 > g->khi_fb) khi = g->khi_fb;
+    
+    /* first stage on the planes needed by the slab not computed so far */
+    klo_s1 = khi_s1 + 1;
+    khi_s1 = khi + ghost_width;
+    if (khi_s1 > g->khi_fb) khi_s1 = g->khi_fb;
+    
+    /* (if have_stage1_rhs, the second stage right-hand side of the      */
+    /* previous slab only overwrote planes of lse_rhs already used here) */
+    setSlabView(s, sd, g, d, klo_s1, khi_s1, ghost_width);
+    if (!have_stage1_rhs) compute_rhs(sd, sd->phi, s, o);
+    LSM3D_TVD_RK2_STAGE1(sd->phi_stage1,
+                   &(s->ilo_gb), &(s->ihi_gb), &(s->jlo_gb), &(s->jhi_gb),
+                   &(s->klo_gb), &(s->khi_gb),
+                   sd->phi,
+                   &(s->ilo_gb), &(s->ihi_gb), &(s->jlo_gb), &(s->jhi_gb),
+                   &(s->klo_gb), &(s->khi_gb),
+                   sd->lse_rhs,
+                   &(s->ilo_gb), &(s->ihi_gb), &(s->jlo_gb), &(s->jhi_gb),
+                   &(s->klo_gb), &(s->khi_gb),
+                   &(s->ilo_fb), &(s->ihi_fb), &(s->jlo_fb), &(s->jhi_fb),
+                   &(s->klo_fb), &(s->khi_fb),
+                   &dt);
+    signedLinearExtrapolationBCSlab(d->phi_stage1, g, klo_s1, khi_s1);
+    
+    /* the planes next to the upper z boundary are masked only after */
+    /* they have been used for the extrapolation                     */
+    if (mask_stage1) {
+      khi_mask = (khi_s1 == g->khi_fb) ? g->khi_gb : khi_s1;
+      imposeMaskSlab(d->phi_stage1, d->mask, d->phi_stage1, g,
+                     klo_mask, khi_mask, 1);
+      klo_mask = khi_mask + 1;
+    }
+    
+    /* second stage on the slab */
+    setSlabView(s, sd, g, d, klo, khi, ghost_width);
+    compute_rhs(sd, sd->phi_stage1, s, o);
+    LSM3D_TVD_RK2_STAGE2(sd->phi_next,
+                   &(s->ilo_gb), &(s->ihi_gb), &(s->jlo_gb), &(s->jhi_gb),
+                   &(s->klo_gb), &(s->khi_gb),
+                   sd->phi_stage1,
+                   &(s->ilo_gb), &(s->ihi_gb), &(s->jlo_gb), &(s->jhi_gb),
+                   &(s->klo_gb), &(s->khi_gb),
+                   sd->phi,
+                   &(s->ilo_gb), &(s->ihi_gb), &(s->jlo_gb), &(s->jhi_gb),
+                   &(s->klo_gb), &(s->khi_gb),
+                   sd->lse_rhs,
+                   &(s->ilo_gb), &(s->ihi_gb), &(s->jlo_gb), &(s->jhi_gb),
+                   &(s->klo_gb), &(s->khi_gb),
+                   &(s->ilo_fb), &(s->ihi_fb), &(s->jlo_fb), &(s->jhi_fb),
+                   &(s->klo_fb), &(s->khi_fb),
+                   &dt);
+    signedLinearExtrapolationBCSlab(d->phi_next, g, klo, khi);
+    
+    /* phi is updated on the planes that later first stages do not read */
+    khi_phi = (khi == g->khi_fb) ? g->khi_gb : khi_s1 - ghost_width;
+    imposeMaskSlab(d->phi, d->mask, d->phi_next, g, klo_phi, khi_phi,
+                   o->do_mask);
+    klo_phi = khi_phi + 1;
+  }
+}
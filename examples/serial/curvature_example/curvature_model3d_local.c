@@ -18,10 +18,12 @@
 #include "LSMLIB_config.h"
 #include "lsm_level_set_evolution3d_local.h"
 #include "lsm_spatial_derivatives3d_local.h"
+#include "lsm_utilities3d.h"
 #include "lsm_utilities3d_local.h"
 #include "lsm_tvd_runge_kutta3d_local.h"
 #include "lsm_reinitialization3d_local.h"
 #include "lsm_geometry3d.h"
+#include "lsm_geometry3d_local.h"
 #include "lsm_localization3d.h"
 
 /* LSMLIB Serial package headers */
@@ -91,6 +93,10 @@ void curvatureModelMedium3dLocalMainLoop(
   int      n_outer, change_sgn;
   int      n_lo_copy[6], n_hi_copy[6];
   int      change_sgn_steps, grad_phi_ave_steps;
+  
+  /* number of voxels outside of the narrow band where phi < 0 
+     (used to compute the volume using only the narrow band voxels) */
+  int      num_vox_outside_nb, num_vox_nb, num_neg_change;
    
   t = 0;
   /* every TPLOT time period we evaluate max. abs. error as well as
@@ -186,8 +192,17 @@ void curvatureModelMedium3dLocalMainLoop(
       INNER_STEP++;
       TOTAL_STEP++;
       
-       /* localization : determine T0 */	   
-      LSM3D_DETERMINE_NARROW_BAND(d->phi,
+       /* localization : determine T0 
+       *  (the narrow band is computed from scratch on the first step
+       *  only.  Afterwards, phi changes only within the narrow band, so 
+       *  the previous narrow band is updated instead of rescanning the 
+       *  grid.  The update is needed on every step because the level 
+       *  set function changes within the narrow band on every step, so 
+       *  voxels move between the levels of the narrow band)
+       */	   
+      if( TOTAL_STEP == 1 )
+      {
+        LSM3D_DETERMINE_NARROW_BAND(d->phi,
            &(g->ilo_gb), &(g->ihi_gb), &(g->jlo_gb), &(g->jhi_gb),
            &(g->klo_gb), &(g->khi_gb),
 	   d->narrow_band,
@@ -201,85 +216,113 @@ void curvatureModelMedium3dLocalMainLoop(
 	   &(d->nlo_outer_plus),  &(d->nhi_outer_plus),
 	   &(d->nlo_outer_minus), &(d->nhi_outer_minus),
            &gamma,&beta,&level);
-	   
-     
+         
+        /* localization : count voxels outside of T0 (all levels) where 
+           phi < 0 once; afterwards the count is updated from the 
+           narrow band voxels only */
+        LSM3D_VOXEL_COUNT_LESS_THAN_ZERO(&num_vox_outside_nb,
+           d->phi,
+           &(g->ilo_gb), &(g->ihi_gb), &(g->jlo_gb), &(g->jhi_gb),
+           &(g->klo_gb), &(g->khi_gb),
+           &(g->ilo_gb), &(g->ihi_gb), &(g->jlo_gb), &(g->jhi_gb),
+           &(g->klo_gb), &(g->khi_gb));
+        LSM3D_VOXEL_COUNT_LESS_THAN_ZERO_LOCAL(&num_vox_nb,
+           d->phi,
+           &(g->ilo_gb), &(g->ihi_gb), &(g->jlo_gb), &(g->jhi_gb),
+           &(g->klo_gb), &(g->khi_gb),
+           d->index_x, d->index_y, d->index_z,
+           &(d->n_lo)[0],&(d->n_hi)[level],
+           d->narrow_band,
+           &(g->ilo_gb), &(g->ihi_gb), &(g->jlo_gb), &(g->jhi_gb),
+           &(g->klo_gb), &(g->khi_gb),
+           &mark_gb);
+        num_vox_outside_nb -= num_vox_nb;
+      }
+      else
+      {
+        /* phi is not changed by the update, so voxels with phi < 0
+           that enter (leave) the narrow band subtract from (add to) 
+           the outside count */
+        LSM3D_UPDATE_NARROW_BAND(d->phi,
+           &(g->ilo_gb), &(g->ihi_gb), &(g->jlo_gb), &(g->jhi_gb),
+           &(g->klo_gb), &(g->khi_gb),
+	   d->narrow_band,
+	   &(g->ilo_gb), &(g->ihi_gb), &(g->jlo_gb), &(g->jhi_gb),
+           &(g->klo_gb), &(g->khi_gb),
+	   d->index_x, d->index_y, d->index_z,
+	   &nlo_index, &nhi_index,	   
+	   d->n_lo,d->n_hi,
+	   d->index_outer_pts,
+	   &nlo_index_outer, &nhi_index_outer,
+	   &(d->nlo_outer_plus),  &(d->nhi_outer_plus),
+	   &(d->nlo_outer_minus), &(d->nhi_outer_minus),
+           &gamma,&beta,&level,&num_neg_change);
+        num_vox_outside_nb -= num_neg_change;
+      }
+    
+      /* linear offsets of the narrow band voxels (all levels, since
+         reinitialization runs on levels 0 to 3) */
+      LSM3D_COMPUTE_NARROW_BAND_LINEAR_INDEX(d->index_lin,
+           d->index_x, d->index_y, d->index_z,
+           &(d->n_lo)[0],&(d->n_hi)[level],
+           &(g->ilo_gb), &(g->ihi_gb), &(g->jlo_gb), &(g->jhi_gb),
+           &(g->klo_gb), &(g->khi_gb));
+   
       /* mark boundary layers in narrow_band array 
-      *  These layer marks to be used in Fortran functions for checking if the
-      *	 point is in the correct fill box.
-     */     	   	   
+      *  These layer marks to be used in Fortran functions for checking 
+      *  if the point is in the correct fill box.
+      */     	   	   
       LSM3D_MARK_NARROW_BAND_BOUNDARY_LAYER(d->narrow_band,
-       	   &(g->ilo_gb), &(g->ihi_gb), &(g->jlo_gb), &(g->jhi_gb),
+     	     &(g->ilo_gb), &(g->ihi_gb), &(g->jlo_gb), &(g->jhi_gb),
            &(g->klo_gb), &(g->khi_gb),
 	   &(g->ilo_D2_fb), &(g->ihi_D2_fb), &(g->jlo_D2_fb), &(g->jhi_D2_fb),
            &(g->klo_D2_fb), &(g->khi_D2_fb),
 	   &mark_D2);
-	   
+	 
       LSM3D_MARK_NARROW_BAND_BOUNDARY_LAYER(d->narrow_band,
-       	   &(g->ilo_gb), &(g->ihi_gb), &(g->jlo_gb), &(g->jhi_gb),
+     	     &(g->ilo_gb), &(g->ihi_gb), &(g->jlo_gb), &(g->jhi_gb),
            &(g->klo_gb), &(g->khi_gb),
 	   &(g->ilo_D1_fb), &(g->ihi_D1_fb), &(g->jlo_D1_fb), &(g->jhi_D1_fb),
            &(g->klo_D1_fb), &(g->khi_D1_fb),
 	   &mark_D1);
-	   
+	 
       LSM3D_MARK_NARROW_BAND_BOUNDARY_LAYER(d->narrow_band,
-       	   &(g->ilo_gb), &(g->ihi_gb), &(g->jlo_gb), &(g->jhi_gb),
+     	     &(g->ilo_gb), &(g->ihi_gb), &(g->jlo_gb), &(g->jhi_gb),
            &(g->klo_gb), &(g->khi_gb),
 	   &(g->ilo_gb), &(g->ihi_gb), &(g->jlo_gb), &(g->jhi_gb),
            &(g->klo_gb), &(g->khi_gb),
-	   &mark_gb);	   	   
-	   
-      LSM3D_ZERO_OUT_LEVEL_SET_EQN_RHS_LOCAL(d->lse_rhs,
-		    &(g->ilo_gb), &(g->ihi_gb), &(g->jlo_gb), &(g->jhi_gb),
-		    &(g->klo_gb), &(g->khi_gb),
-                    d->index_x, d->index_y, d->index_z,
-		    &(d->n_lo)[0],&(d->n_hi)[0]);
+	   &mark_gb);
+	 
+      LSM3D_ZERO_OUT_LEVEL_SET_EQN_RHS_LOCAL_LINEAR(d->lse_rhs,
+                d->index_lin,
+                &(d->n_lo)[0], &(d->n_hi)[0]);
      
       if(o->a > 0)
       {  
          /* Compute upwinding gradient approximations */ 
-          LSM3D_HJ_ENO2_LOCAL(d->phi_x_plus, d->phi_y_plus, d->phi_z_plus,
-                    &(g->ilo_gb), &(g->ihi_gb), &(g->jlo_gb), &(g->jhi_gb),
-		    &(g->klo_gb), &(g->khi_gb),
+          LSM3D_HJ_ENO2_LOCAL_LINEAR(d->phi_x_plus, d->phi_y_plus, d->phi_z_plus,
                     d->phi_x_minus, d->phi_y_minus, d->phi_z_minus,
-		    &(g->ilo_gb), &(g->ihi_gb), &(g->jlo_gb), &(g->jhi_gb),
-		    &(g->klo_gb), &(g->khi_gb),
-		    d->phi,
-		    &(g->ilo_gb), &(g->ihi_gb), &(g->jlo_gb), &(g->jhi_gb),
-		    &(g->klo_gb), &(g->khi_gb),
-		    d->D1,
-		    &(g->ilo_gb), &(g->ihi_gb), &(g->jlo_gb), &(g->jhi_gb),
-		    &(g->klo_gb), &(g->khi_gb),
-		    d->D2,
-		    &(g->ilo_gb), &(g->ihi_gb), &(g->jlo_gb), &(g->jhi_gb),
-		    &(g->klo_gb), &(g->khi_gb),
-		    &((g->dx)[0]),&((g->dx)[1]),&((g->dx)[2]),
-		    d->index_x, d->index_y, d->index_z,
-		    &(d->n_lo)[0],&(d->n_hi)[0],
-		    &(d->n_lo)[1],&(d->n_hi)[1],
-		    &(d->n_lo)[2],&(d->n_hi)[2],
-		    d->narrow_band,
-		    &(g->ilo_gb), &(g->ihi_gb), &(g->jlo_gb), &(g->jhi_gb),
-		    &(g->klo_gb), &(g->khi_gb),
-		    &mark_fb,&mark_D1,&mark_D2); 
+                    d->phi, d->D1, d->D2,
+                    &(g->ilo_gb), &(g->ihi_gb), &(g->jlo_gb), &(g->jhi_gb),
+                    &(g->klo_gb), &(g->khi_gb),
+                    &((g->dx)[0]), &((g->dx)[1]), &((g->dx)[2]),
+                    d->index_lin,
+                    &(d->n_lo)[0], &(d->n_hi)[0],
+                    &(d->n_lo)[1], &(d->n_hi)[1],
+                    &(d->n_lo)[2], &(d->n_hi)[2],
+                    d->narrow_band,
+                    &mark_fb, &mark_D1, &mark_D2); 
 	 
 	 vel_n = o->a;
 	 
-	 LSM3D_ADD_CONST_NORMAL_VEL_TERM_TO_LSE_RHS_LOCAL(d->lse_rhs,
-                    &(g->ilo_gb), &(g->ihi_gb), &(g->jlo_gb), &(g->jhi_gb),
-		    &(g->klo_gb), &(g->khi_gb),
-		    d->phi_x_plus, d->phi_y_plus, d->phi_z_plus,
-		    &(g->ilo_gb), &(g->ihi_gb), &(g->jlo_gb), &(g->jhi_gb),
-		    &(g->klo_gb), &(g->khi_gb),
-		    d->phi_x_minus, d->phi_y_minus, d->phi_z_minus,
-		    &(g->ilo_gb), &(g->ihi_gb), &(g->jlo_gb), &(g->jhi_gb),
-		    &(g->klo_gb), &(g->khi_gb),
-		    &vel_n,
-		    d->index_x, d->index_y, d->index_z,
-		    &(d->n_lo)[0],&(d->n_hi)[0],		    
-                    d->narrow_band,
-		    &(g->ilo_gb), &(g->ihi_gb), &(g->jlo_gb), &(g->jhi_gb),
-		    &(g->klo_gb), &(g->khi_gb),
-		    &mark_fb);
+         LSM3D_ADD_CONST_NORMAL_VEL_TERM_TO_LSE_RHS_LOCAL_LINEAR(d->lse_rhs,
+                   d->phi_x_plus, d->phi_y_plus, d->phi_z_plus,
+                   d->phi_x_minus, d->phi_y_minus, d->phi_z_minus,
+                   &vel_n,
+                   d->index_lin,
+                   &(d->n_lo)[0], &(d->n_hi)[0],
+                   d->narrow_band,
+                   &mark_fb);
                   
 	 /* figure out time spacing for hyperbolic term */
 	 LSM3D_COMPUTE_STABLE_CONST_NORMAL_VEL_DT_LOCAL(&dt,&vel_n,
@@ -302,76 +345,52 @@ void curvatureModelMedium3dLocalMainLoop(
       if( o->b > 0)
       {
 	/* Compute derivatives needed for curvature */	
-	LSM3D_CENTRAL_GRAD_ORDER2_LOCAL(d->phi_x, d->phi_y, d->phi_z,
-                    &(g->ilo_gb), &(g->ihi_gb), &(g->jlo_gb), &(g->jhi_gb),
-		    &(g->klo_gb), &(g->khi_gb),
-		    d->phi,
-		    &(g->ilo_gb), &(g->ihi_gb), &(g->jlo_gb), &(g->jhi_gb),
-		    &(g->klo_gb), &(g->khi_gb),
-		    &((g->dx)[0]),&((g->dx)[1]),&((g->dx)[2]),
-		    d->index_x, d->index_y, d->index_z, 
-		    &(d->n_lo)[0],&(d->n_hi)[1],
-		    d->narrow_band,
-		    &(g->ilo_gb), &(g->ihi_gb), &(g->jlo_gb), &(g->jhi_gb),
-		    &(g->klo_gb), &(g->khi_gb),
-		    &mark_D1);	
-	LSM3D_CENTRAL_GRAD_ORDER2_LOCAL(d->phi_xx, d->phi_xy, d->phi_xz,
-                    &(g->ilo_gb), &(g->ihi_gb), &(g->jlo_gb), &(g->jhi_gb),
-		    &(g->klo_gb), &(g->khi_gb),
-		    d->phi_x,
-		    &(g->ilo_gb), &(g->ihi_gb), &(g->jlo_gb), &(g->jhi_gb),
-		    &(g->klo_gb), &(g->khi_gb),
-		    &((g->dx)[0]),&((g->dx)[1]),&((g->dx)[2]),
-		    d->index_x, d->index_y, d->index_z, 
-		    &(d->n_lo)[0],&(d->n_hi)[0],
-		    d->narrow_band,
-		    &(g->ilo_gb), &(g->ihi_gb), &(g->jlo_gb), &(g->jhi_gb),
-		    &(g->klo_gb), &(g->khi_gb),
-		    &mark_D2);		
-	LSM3D_CENTRAL_GRAD_ORDER2_LOCAL(d->phi_xy, d->phi_yy, d->phi_yz,
-                    &(g->ilo_gb), &(g->ihi_gb), &(g->jlo_gb), &(g->jhi_gb),
-		    &(g->klo_gb), &(g->khi_gb),
-		    d->phi_y,
-		    &(g->ilo_gb), &(g->ihi_gb), &(g->jlo_gb), &(g->jhi_gb),
-		    &(g->klo_gb), &(g->khi_gb),
-		    &((g->dx)[0]),&((g->dx)[1]),&((g->dx)[2]),
-		    d->index_x, d->index_y, d->index_z,
-		    &(d->n_lo)[0],&(d->n_hi)[0],
-		    d->narrow_band,
-		    &(g->ilo_gb), &(g->ihi_gb), &(g->jlo_gb), &(g->jhi_gb),
-		    &(g->klo_gb), &(g->khi_gb),
-		    &mark_D2);	
-	LSM3D_CENTRAL_GRAD_ORDER2_LOCAL(d->phi_xz, d->phi_yz, d->phi_zz,
-                    &(g->ilo_gb), &(g->ihi_gb), &(g->jlo_gb), &(g->jhi_gb),
-		    &(g->klo_gb), &(g->khi_gb),
-		    d->phi_z,
-		    &(g->ilo_gb), &(g->ihi_gb), &(g->jlo_gb), &(g->jhi_gb),
-		    &(g->klo_gb), &(g->khi_gb),
-		    &((g->dx)[0]),&((g->dx)[1]),&((g->dx)[2]),
-		    d->index_x, d->index_y, d->index_z,
-		    &(d->n_lo)[0],&(d->n_hi)[0],
-		    d->narrow_band,
-		    &(g->ilo_gb), &(g->ihi_gb), &(g->jlo_gb), &(g->jhi_gb),
-		    &(g->klo_gb), &(g->khi_gb),
-		    &mark_D2);
+        LSM3D_CENTRAL_GRAD_ORDER2_LOCAL_LINEAR(d->phi_x, d->phi_y, d->phi_z,
+                  d->phi,
+                  &(g->ilo_gb), &(g->ihi_gb), &(g->jlo_gb), &(g->jhi_gb),
+                  &(g->klo_gb), &(g->khi_gb),
+                  &((g->dx)[0]), &((g->dx)[1]), &((g->dx)[2]),
+                  d->index_lin,
+                  &(d->n_lo)[0], &(d->n_hi)[1],
+                  d->narrow_band,
+                  &mark_D1);	
+        LSM3D_CENTRAL_GRAD_ORDER2_LOCAL_LINEAR(d->phi_xx, d->phi_xy, d->phi_xz,
+                  d->phi_x,
+                  &(g->ilo_gb), &(g->ihi_gb), &(g->jlo_gb), &(g->jhi_gb),
+                  &(g->klo_gb), &(g->khi_gb),
+                  &((g->dx)[0]), &((g->dx)[1]), &((g->dx)[2]),
+                  d->index_lin,
+                  &(d->n_lo)[0], &(d->n_hi)[0],
+                  d->narrow_band,
+                  &mark_D2);		
+        LSM3D_CENTRAL_GRAD_ORDER2_LOCAL_LINEAR(d->phi_xy, d->phi_yy, d->phi_yz,
+                  d->phi_y,
+                  &(g->ilo_gb), &(g->ihi_gb), &(g->jlo_gb), &(g->jhi_gb),
+                  &(g->klo_gb), &(g->khi_gb),
+                  &((g->dx)[0]), &((g->dx)[1]), &((g->dx)[2]),
+                  d->index_lin,
+                  &(d->n_lo)[0], &(d->n_hi)[0],
+                  d->narrow_band,
+                  &mark_D2);	
+        LSM3D_CENTRAL_GRAD_ORDER2_LOCAL_LINEAR(d->phi_xz, d->phi_yz, d->phi_zz,
+                  d->phi_z,
+                  &(g->ilo_gb), &(g->ihi_gb), &(g->jlo_gb), &(g->jhi_gb),
+                  &(g->klo_gb), &(g->khi_gb),
+                  &((g->dx)[0]), &((g->dx)[1]), &((g->dx)[2]),
+                  d->index_lin,
+                  &(d->n_lo)[0], &(d->n_hi)[0],
+                  d->narrow_band,
+                  &mark_D2);
 		    
-	LSM3D_ADD_CONST_CURV_TERM_TO_LSE_RHS_LOCAL(d->lse_rhs,
-	            &(g->ilo_gb), &(g->ihi_gb), &(g->jlo_gb), &(g->jhi_gb),
-		    &(g->klo_gb), &(g->khi_gb),
-		    d->phi_x,d->phi_y,d->phi_z,
-		    &(g->ilo_gb), &(g->ihi_gb), &(g->jlo_gb), &(g->jhi_gb),
-		    &(g->klo_gb), &(g->khi_gb),
-		    d->phi_xx,d->phi_xy,d->phi_xz,
-		    d->phi_yy,d->phi_yz,d->phi_zz,
-		    &(g->ilo_gb), &(g->ihi_gb), &(g->jlo_gb), &(g->jhi_gb),
-		    &(g->klo_gb), &(g->khi_gb),
-		    &(o->b),
-		    d->index_x, d->index_y, d->index_z,
-		    &(d->n_lo)[0], &(d->n_hi)[0],
-                    d->narrow_band,
-		    &(g->ilo_gb), &(g->ihi_gb), &(g->jlo_gb), &(g->jhi_gb),
-		    &(g->klo_gb), &(g->khi_gb),
-		    &mark_fb);
+        LSM3D_ADD_CONST_CURV_TERM_TO_LSE_RHS_LOCAL_LINEAR(d->lse_rhs,
+                  d->phi_x, d->phi_y, d->phi_z,
+                  d->phi_xx, d->phi_xy, d->phi_xz,
+                  d->phi_yy, d->phi_yz, d->phi_zz,
+                  &(o->b),
+                  d->index_lin,
+                  &(d->n_lo)[0], &(d->n_hi)[0],
+                  d->narrow_band,
+                  &mark_fb);
 		    	
 	/* correct dt due to parabolic (curvature) term */
         if( o->a > 0 )
@@ -394,33 +413,20 @@ void curvatureModelMedium3dLocalMainLoop(
       if(dt < dt_min) dt_min = dt;
       
       /* localization: modify equation by a cut-off function */
-      LSM3D_MULTIPLY_CUT_OFF_LSE_RHS_LOCAL(d->phi, d->lse_rhs,
-                    &(g->ilo_gb), &(g->ihi_gb), &(g->jlo_gb), &(g->jhi_gb),
-		    &(g->klo_gb), &(g->khi_gb),
-		    d->index_x, d->index_y, d->index_z,
-		    &(d->n_lo)[0],&(d->n_hi)[0],
-		    d->narrow_band,
-		    &(g->ilo_gb), &(g->ihi_gb), &(g->jlo_gb), &(g->jhi_gb),
-		    &(g->klo_gb), &(g->khi_gb),
-		    &mark_fb,
-		    &beta,&gamma);
+      LSM3D_MULTIPLY_CUT_OFF_LSE_RHS_LOCAL_LINEAR(d->phi, d->lse_rhs,
+                d->index_lin,
+                &(d->n_lo)[0], &(d->n_hi)[0],
+                d->narrow_band,
+                &mark_fb, &beta, &gamma);
       
-      LSM3D_TVD_RK2_STAGE1_LOCAL(d->phi_stage1,
-                   &(g->ilo_gb), &(g->ihi_gb), &(g->jlo_gb), &(g->jhi_gb),
-		   &(g->klo_gb), &(g->khi_gb),
-		   d->phi,
-		   &(g->ilo_gb), &(g->ihi_gb), &(g->jlo_gb), &(g->jhi_gb),
-		   &(g->klo_gb), &(g->khi_gb),
-		   d->lse_rhs,
-		   &(g->ilo_gb), &(g->ihi_gb), &(g->jlo_gb), &(g->jhi_gb),
-		   &(g->klo_gb), &(g->khi_gb),
-		   &dt,
-		   d->index_x, d->index_y, d->index_z,
-		   &(d->n_lo)[0],&(d->n_hi)[0],
-		   d->narrow_band,
-		   &(g->ilo_gb), &(g->ihi_gb), &(g->jlo_gb), &(g->jhi_gb),
-		   &(g->klo_gb), &(g->khi_gb),
-		   &mark_fb);	
+      LSM3D_TVD_RK2_STAGE1_LOCAL_LINEAR(d->phi_stage1,
+                d->phi,
+                d->lse_rhs,
+                &dt,
+                d->index_lin,
+                &(d->n_lo)[0], &(d->n_hi)[0],
+                d->narrow_band,
+                &mark_fb);	
 
        /* boundary conditions */
        signedLinearExtrapolationBC(d->phi_stage1,g,bdry_location_idx);
@@ -428,161 +434,101 @@ void curvatureModelMedium3dLocalMainLoop(
       /* masking enforced so that the interface stays within pore space */
       if(o->do_mask) IMPOSE_MASK_LOCAL(d->phi_stage1,d->mask,d->phi_stage1,g,d);       
 
-      LSM3D_ZERO_OUT_LEVEL_SET_EQN_RHS_LOCAL(d->lse_rhs,
-		    &(g->ilo_gb), &(g->ihi_gb), &(g->jlo_gb), &(g->jhi_gb),
-		    &(g->klo_gb), &(g->khi_gb),
-                    d->index_x, d->index_y, d->index_z,
-		    &(d->n_lo)[0],&(d->n_hi)[2]);  
+      LSM3D_ZERO_OUT_LEVEL_SET_EQN_RHS_LOCAL_LINEAR(d->lse_rhs,
+                d->index_lin,
+                &(d->n_lo)[0], &(d->n_hi)[2]);  
       
       if(o->a)
       {
-	  LSM3D_HJ_ENO2_LOCAL(d->phi_x_plus, d->phi_y_plus, d->phi_z_plus,
-                    &(g->ilo_gb), &(g->ihi_gb), &(g->jlo_gb), &(g->jhi_gb),
-		    &(g->klo_gb), &(g->khi_gb),
+          LSM3D_HJ_ENO2_LOCAL_LINEAR(d->phi_x_plus, d->phi_y_plus, d->phi_z_plus,
                     d->phi_x_minus, d->phi_y_minus, d->phi_z_minus,
-		    &(g->ilo_gb), &(g->ihi_gb), &(g->jlo_gb), &(g->jhi_gb),
-		    &(g->klo_gb), &(g->khi_gb),
-		    d->phi_stage1,
-		    &(g->ilo_gb), &(g->ihi_gb), &(g->jlo_gb), &(g->jhi_gb),
-		    &(g->klo_gb), &(g->khi_gb),
-		    d->D1,
-		    &(g->ilo_gb), &(g->ihi_gb), &(g->jlo_gb), &(g->jhi_gb),
-		    &(g->klo_gb), &(g->khi_gb),
-		    d->D2,
-		    &(g->ilo_gb), &(g->ihi_gb), &(g->jlo_gb), &(g->jhi_gb),
-		    &(g->klo_gb), &(g->khi_gb),
-		    &((g->dx)[0]),&((g->dx)[1]),&((g->dx)[2]),
-		    d->index_x, d->index_y, d->index_z,
-		    &(d->n_lo)[0],&(d->n_hi)[0],
-		    &(d->n_lo)[1],&(d->n_hi)[1],
-		    &(d->n_lo)[2],&(d->n_hi)[2],
-		    d->narrow_band,
-		    &(g->ilo_gb), &(g->ihi_gb), &(g->jlo_gb), &(g->jhi_gb),
-		    &(g->klo_gb), &(g->khi_gb),
-		    &mark_fb,&mark_D1,&mark_D2);   
-		        
-	 LSM3D_ADD_CONST_NORMAL_VEL_TERM_TO_LSE_RHS_LOCAL(d->lse_rhs,
+                    d->phi_stage1, d->D1, d->D2,
                     &(g->ilo_gb), &(g->ihi_gb), &(g->jlo_gb), &(g->jhi_gb),
-		    &(g->klo_gb), &(g->khi_gb),
-		    d->phi_x_plus, d->phi_y_plus, d->phi_z_plus,
-		    &(g->ilo_gb), &(g->ihi_gb), &(g->jlo_gb), &(g->jhi_gb),
-		    &(g->klo_gb), &(g->khi_gb),
-		    d->phi_x_minus, d->phi_y_minus, d->phi_z_minus,
-		    &(g->ilo_gb), &(g->ihi_gb), &(g->jlo_gb), &(g->jhi_gb),
-		    &(g->klo_gb), &(g->khi_gb),
-		    &vel_n,
-		    d->index_x, d->index_y, d->index_z,
-		    &(d->n_lo)[0],&(d->n_hi)[0],		    
+                    &(g->klo_gb), &(g->khi_gb),
+                    &((g->dx)[0]), &((g->dx)[1]), &((g->dx)[2]),
+                    d->index_lin,
+                    &(d->n_lo)[0], &(d->n_hi)[0],
+                    &(d->n_lo)[1], &(d->n_hi)[1],
+                    &(d->n_lo)[2], &(d->n_hi)[2],
                     d->narrow_band,
-		    &(g->ilo_gb), &(g->ihi_gb), &(g->jlo_gb), &(g->jhi_gb),
-		    &(g->klo_gb), &(g->khi_gb),
-		    &mark_fb);	    
+                    &mark_fb, &mark_D1, &mark_D2);   
+		        
+         LSM3D_ADD_CONST_NORMAL_VEL_TERM_TO_LSE_RHS_LOCAL_LINEAR(d->lse_rhs,
+                   d->phi_x_plus, d->phi_y_plus, d->phi_z_plus,
+                   d->phi_x_minus, d->phi_y_minus, d->phi_z_minus,
+                   &vel_n,
+                   d->index_lin,
+                   &(d->n_lo)[0], &(d->n_hi)[0],
+                   d->narrow_band,
+                   &mark_fb);	    
       }
       
       if( o->b )
       {       
-	LSM3D_CENTRAL_GRAD_ORDER2_LOCAL(d->phi_x,d->phi_y,d->phi_z,
-                    &(g->ilo_gb), &(g->ihi_gb), &(g->jlo_gb), &(g->jhi_gb),
-		    &(g->klo_gb), &(g->khi_gb),
-		    d->phi_stage1,
-		    &(g->ilo_gb), &(g->ihi_gb), &(g->jlo_gb), &(g->jhi_gb),
-		    &(g->klo_gb), &(g->khi_gb),
-		    &((g->dx)[0]),&((g->dx)[1]),&((g->dx)[2]),
-		    d->index_x, d->index_y, d->index_z,
-		    &(d->n_lo)[0],&(d->n_hi)[1],
-		    d->narrow_band,
-		    &(g->ilo_gb), &(g->ihi_gb), &(g->jlo_gb), &(g->jhi_gb),
-		    &(g->klo_gb), &(g->khi_gb),
-		    &mark_D1);		
-	LSM3D_CENTRAL_GRAD_ORDER2_LOCAL(d->phi_xx,d->phi_xy,d->phi_xz,
-                    &(g->ilo_gb), &(g->ihi_gb), &(g->jlo_gb), &(g->jhi_gb),
-		    &(g->klo_gb), &(g->khi_gb),
-		    d->phi_x,
-		    &(g->ilo_gb), &(g->ihi_gb), &(g->jlo_gb), &(g->jhi_gb),
-		    &(g->klo_gb), &(g->khi_gb),
-		    &((g->dx)[0]),&((g->dx)[1]),&((g->dx)[2]),
-		    d->index_x, d->index_y, d->index_z,
-		    &(d->n_lo)[0],&(d->n_hi)[0],
-		    d->narrow_band,
-		    &(g->ilo_gb), &(g->ihi_gb), &(g->jlo_gb), &(g->jhi_gb),
-		    &(g->klo_gb), &(g->khi_gb),
-		    &mark_D2);		
-	LSM3D_CENTRAL_GRAD_ORDER2_LOCAL(d->phi_xy,d->phi_yy,d->phi_yz,
-                    &(g->ilo_gb), &(g->ihi_gb), &(g->jlo_gb), &(g->jhi_gb),
-		    &(g->klo_gb), &(g->khi_gb),
-		    d->phi_y,
-		    &(g->ilo_gb), &(g->ihi_gb), &(g->jlo_gb), &(g->jhi_gb),
-		    &(g->klo_gb), &(g->khi_gb),
-		    &((g->dx)[0]),&((g->dx)[1]),&((g->dx)[2]),
-		    d->index_x, d->index_y, d->index_z,
-		    &(d->n_lo)[0],&(d->n_hi)[0],
-		    d->narrow_band,
-		    &(g->ilo_gb), &(g->ihi_gb), &(g->jlo_gb), &(g->jhi_gb),
-		    &(g->klo_gb), &(g->khi_gb),
-		    &mark_D2);	
-	LSM3D_CENTRAL_GRAD_ORDER2_LOCAL(d->phi_xz, d->phi_yz, d->phi_zz,
-                    &(g->ilo_gb), &(g->ihi_gb), &(g->jlo_gb), &(g->jhi_gb),
-		    &(g->klo_gb), &(g->khi_gb),
-		    d->phi_z,
-		    &(g->ilo_gb), &(g->ihi_gb), &(g->jlo_gb), &(g->jhi_gb),
-		    &(g->klo_gb), &(g->khi_gb),
-		    &((g->dx)[0]),&((g->dx)[1]),&((g->dx)[2]),
-		    d->index_x, d->index_y, d->index_z,
-		    &(d->n_lo)[0],&(d->n_hi)[0],
-		    d->narrow_band,
-		    &(g->ilo_gb), &(g->ihi_gb), &(g->jlo_gb), &(g->jhi_gb),
-		    &(g->klo_gb), &(g->khi_gb),
-		    &mark_D2);
+        LSM3D_CENTRAL_GRAD_ORDER2_LOCAL_LINEAR(d->phi_x, d->phi_y, d->phi_z,
+                  d->phi_stage1,
+                  &(g->ilo_gb), &(g->ihi_gb), &(g->jlo_gb), &(g->jhi_gb),
+                  &(g->klo_gb), &(g->khi_gb),
+                  &((g->dx)[0]), &((g->dx)[1]), &((g->dx)[2]),
+                  d->index_lin,
+                  &(d->n_lo)[0], &(d->n_hi)[1],
+                  d->narrow_band,
+                  &mark_D1);		
+        LSM3D_CENTRAL_GRAD_ORDER2_LOCAL_LINEAR(d->phi_xx, d->phi_xy, d->phi_xz,
+                  d->phi_x,
+                  &(g->ilo_gb), &(g->ihi_gb), &(g->jlo_gb), &(g->jhi_gb),
+                  &(g->klo_gb), &(g->khi_gb),
+                  &((g->dx)[0]), &((g->dx)[1]), &((g->dx)[2]),
+                  d->index_lin,
+                  &(d->n_lo)[0], &(d->n_hi)[0],
+                  d->narrow_band,
+                  &mark_D2);		
+        LSM3D_CENTRAL_GRAD_ORDER2_LOCAL_LINEAR(d->phi_xy, d->phi_yy, d->phi_yz,
+                  d->phi_y,
+                  &(g->ilo_gb), &(g->ihi_gb), &(g->jlo_gb), &(g->jhi_gb),
+                  &(g->klo_gb), &(g->khi_gb),
+                  &((g->dx)[0]), &((g->dx)[1]), &((g->dx)[2]),
+                  d->index_lin,
+                  &(d->n_lo)[0], &(d->n_hi)[0],
+                  d->narrow_band,
+                  &mark_D2);	
+        LSM3D_CENTRAL_GRAD_ORDER2_LOCAL_LINEAR(d->phi_xz, d->phi_yz, d->phi_zz,
+                  d->phi_z,
+                  &(g->ilo_gb), &(g->ihi_gb), &(g->jlo_gb), &(g->jhi_gb),
+                  &(g->klo_gb), &(g->khi_gb),
+                  &((g->dx)[0]), &((g->dx)[1]), &((g->dx)[2]),
+                  d->index_lin,
+                  &(d->n_lo)[0], &(d->n_hi)[0],
+                  d->narrow_band,
+                  &mark_D2);
 
-	LSM3D_ADD_CONST_CURV_TERM_TO_LSE_RHS_LOCAL(d->lse_rhs,
-	            &(g->ilo_gb), &(g->ihi_gb), &(g->jlo_gb), &(g->jhi_gb),
-		    &(g->klo_gb), &(g->khi_gb),
-		    d->phi_x,d->phi_y,d->phi_z,
-		    &(g->ilo_gb), &(g->ihi_gb), &(g->jlo_gb), &(g->jhi_gb),
-		    &(g->klo_gb), &(g->khi_gb),
-		    d->phi_xx,d->phi_xy,d->phi_xz,
-		    d->phi_yy,d->phi_yz,d->phi_zz,
-		    &(g->ilo_gb), &(g->ihi_gb), &(g->jlo_gb), &(g->jhi_gb),
-		    &(g->klo_gb), &(g->khi_gb),
-		    &(o->b),
-		    d->index_x, d->index_y, d->index_z,
-		    &(d->n_lo)[0], &(d->n_hi)[0],
-                    d->narrow_band,
-		    &(g->ilo_gb), &(g->ihi_gb), &(g->jlo_gb), &(g->jhi_gb),
-		    &(g->klo_gb), &(g->khi_gb),
-		    &mark_fb);
+        LSM3D_ADD_CONST_CURV_TERM_TO_LSE_RHS_LOCAL_LINEAR(d->lse_rhs,
+                  d->phi_x, d->phi_y, d->phi_z,
+                  d->phi_xx, d->phi_xy, d->phi_xz,
+                  d->phi_yy, d->phi_yz, d->phi_zz,
+                  &(o->b),
+                  d->index_lin,
+                  &(d->n_lo)[0], &(d->n_hi)[0],
+                  d->narrow_band,
+                  &mark_fb);
       }     
      
       /* localization: modify equation by a cut-off function */
-      LSM3D_MULTIPLY_CUT_OFF_LSE_RHS_LOCAL(d->phi_stage1, d->lse_rhs,
-                    &(g->ilo_gb), &(g->ihi_gb), &(g->jlo_gb), &(g->jhi_gb),
-		    &(g->klo_gb), &(g->khi_gb),
-		    d->index_x, d->index_y, d->index_z,
-		    &(d->n_lo)[0],&(d->n_hi)[0],		    
-		    d->narrow_band,
-		    &(g->ilo_gb), &(g->ihi_gb), &(g->jlo_gb), &(g->jhi_gb),
-		    &(g->klo_gb), &(g->khi_gb),
-		    &mark_fb,&beta,&gamma);
+      LSM3D_MULTIPLY_CUT_OFF_LSE_RHS_LOCAL_LINEAR(d->phi_stage1, d->lse_rhs,
+                d->index_lin,
+                &(d->n_lo)[0], &(d->n_hi)[0],
+                d->narrow_band,
+                &mark_fb, &beta, &gamma);
 		    
-      LSM3D_TVD_RK2_STAGE2_LOCAL(d->phi_next,
-                   &(g->ilo_gb), &(g->ihi_gb), &(g->jlo_gb), &(g->jhi_gb),
-		   &(g->klo_gb), &(g->khi_gb),
-		   d->phi_stage1,
-		   &(g->ilo_gb), &(g->ihi_gb), &(g->jlo_gb), &(g->jhi_gb),
-		   &(g->klo_gb), &(g->khi_gb),
-		   d->phi,
-		   &(g->ilo_gb), &(g->ihi_gb), &(g->jlo_gb), &(g->jhi_gb),
-		   &(g->klo_gb), &(g->khi_gb),
-		   d->lse_rhs,
-		   &(g->ilo_gb), &(g->ihi_gb), &(g->jlo_gb), &(g->jhi_gb),
-		   &(g->klo_gb), &(g->khi_gb),
-		   &dt,
-		   d->index_x, d->index_y, d->index_z,
-		   &(d->n_lo)[0],&(d->n_hi)[0],
-		   d->narrow_band,
-		   &(g->ilo_gb), &(g->ihi_gb), &(g->jlo_gb), &(g->jhi_gb),
-		   &(g->klo_gb), &(g->khi_gb),
-		   &mark_fb);
+      LSM3D_TVD_RK2_STAGE2_LOCAL_LINEAR(d->phi_next,
+                d->phi_stage1,
+                d->phi,
+                d->lse_rhs,
+                &dt,
+                d->index_lin,
+                &(d->n_lo)[0], &(d->n_hi)[0],
+                d->narrow_band,
+                &mark_fb);
         
       /* boundary conditions */
        signedLinearExtrapolationBC(d->phi_next,g,bdry_location_idx);	 
@@ -694,14 +640,21 @@ void curvatureModelMedium3dLocalMainLoop(
 	    &(g->ilo_gb), &(g->ihi_gb), &(g->jlo_gb), &(g->jhi_gb),
             &(g->klo_gb), &(g->khi_gb),	
             &mark_fb);
-   LSM3D_VOLUME_REGION_PHI_LESS_THAN_ZERO(&vol_phi,
+   /* compute volume only in the narrow band (voxels outside of it 
+      are accounted for by num_vox_outside_nb) */
+   LSM3D_VOLUME_REGION_PHI_LESS_THAN_ZERO_LOCAL(&vol_phi,
 	    d->phi,
             &(g->ilo_gb), &(g->ihi_gb), &(g->jlo_gb), &(g->jhi_gb),
 	    &(g->klo_gb), &(g->khi_gb),
-            &(g->ilo_gb), &(g->ihi_gb), &(g->jlo_gb), &(g->jhi_gb),
-            &(g->klo_gb), &(g->khi_gb),
             &(g->dx[0]),&(g->dx[1]),&(g->dx[2]),
-	    &eps);		    
+	    &eps,
+            &num_vox_outside_nb,
+	    d->index_x, d->index_y, d->index_z,
+            &(d->n_lo)[0],&(d->n_hi)[level],
+            d->narrow_band,
+	    &(g->ilo_gb), &(g->ihi_gb), &(g->jlo_gb), &(g->jhi_gb),
+            &(g->klo_gb), &(g->khi_gb),	
+            &mark_gb);
     
    printf("Time interval [%g,%g], max. abs. error %g\n", t-tplot,t,max_abs_err);
    fprintf(fp_out,"Time interval [%g,%g], max. abs. error %g\n",t-tplot,t,
@@ -783,143 +736,77 @@ void reinitializeMedium3dLocal(
     
     while(t_r < tmax_r )
     {
-       LSM3D_HJ_ENO2_LOCAL(d->phi_x_plus, d->phi_y_plus, d->phi_z_plus,
-                    &(g->ilo_gb), &(g->ihi_gb), &(g->jlo_gb), &(g->jhi_gb),
-		    &(g->klo_gb),&(g->khi_gb),
-                    d->phi_x_minus, d->phi_y_minus, d->phi_z_minus,
-		    &(g->ilo_gb), &(g->ihi_gb), &(g->jlo_gb), &(g->jhi_gb),
-		    &(g->klo_gb),&(g->khi_gb),
-		    d->phi,
-		    &(g->ilo_gb), &(g->ihi_gb), &(g->jlo_gb), &(g->jhi_gb),
-		    &(g->klo_gb), &(g->khi_gb),
-		    d->D1,
-		    &(g->ilo_gb), &(g->ihi_gb), &(g->jlo_gb), &(g->jhi_gb),
-		    &(g->klo_gb), &(g->khi_gb),
-		    d->D2,
-		    &(g->ilo_gb), &(g->ihi_gb), &(g->jlo_gb), &(g->jhi_gb),
-		    &(g->klo_gb), &(g->khi_gb),
-		    &((g->dx)[0]),&((g->dx)[1]),&((g->dx)[2]),
-		    d->index_x, d->index_y, d->index_z,
-		    &(d->n_lo)[0],&(d->n_hi)[0],
-		    &(d->n_lo)[1],&(d->n_hi)[1],
-		    &(d->n_lo)[2],&(d->n_hi)[2],
-		    d->narrow_band,
-		    &(g->ilo_gb), &(g->ihi_gb), &(g->jlo_gb), &(g->jhi_gb),
-		    &(g->klo_gb), &(g->khi_gb),
-		    &mark_fb,&mark_D1,&mark_D2);
-		    
-      LSM3D_COMPUTE_REINITIALIZATION_EQN_RHS_LOCAL(d->lse_rhs,
+       LSM3D_HJ_ENO2_LOCAL_LINEAR(d->phi_x_plus, d->phi_y_plus, d->phi_z_plus,
+                 d->phi_x_minus, d->phi_y_minus, d->phi_z_minus,
+                 d->phi, d->D1, d->D2,
                  &(g->ilo_gb), &(g->ihi_gb), &(g->jlo_gb), &(g->jhi_gb),
-		 &(g->klo_gb), &(g->khi_gb),
-		 d->phi,
-		 &(g->ilo_gb), &(g->ihi_gb), &(g->jlo_gb), &(g->jhi_gb),
-		 &(g->klo_gb), &(g->khi_gb),
-		 d->phi0,
-		 &(g->ilo_gb), &(g->ihi_gb), &(g->jlo_gb), &(g->jhi_gb),
-		 &(g->klo_gb), &(g->khi_gb),
-		 d->phi_x_plus, d->phi_y_plus, d->phi_z_plus,
-		 &(g->ilo_gb), &(g->ihi_gb), &(g->jlo_gb), &(g->jhi_gb),
-		 &(g->klo_gb), &(g->khi_gb),
-		 d->phi_x_minus, d->phi_y_minus, d->phi_z_minus,
-		 &(g->ilo_gb), &(g->ihi_gb), &(g->jlo_gb), &(g->jhi_gb),
-		 &(g->klo_gb), &(g->khi_gb),
-		 &((g->dx)[0]), &((g->dx)[1]),&((g->dx)[2]),
-		 &use_phi0_for_sign,
-		 d->index_x, d->index_y, d->index_z,
-		 &(d->n_lo)[0],&(d->n_hi)[0],
-		 d->narrow_band,
-		 &(g->ilo_gb), &(g->ihi_gb), &(g->jlo_gb), &(g->jhi_gb),
-		 &(g->klo_gb), &(g->khi_gb),
-		 &mark_fb);
+                 &(g->klo_gb), &(g->khi_gb),
+                 &((g->dx)[0]), &((g->dx)[1]), &((g->dx)[2]),
+                 d->index_lin,
+                 &(d->n_lo)[0], &(d->n_hi)[0],
+                 &(d->n_lo)[1], &(d->n_hi)[1],
+                 &(d->n_lo)[2], &(d->n_hi)[2],
+                 d->narrow_band,
+                 &mark_fb, &mark_D1, &mark_D2);
+		    
+      LSM3D_COMPUTE_REINITIALIZATION_EQN_RHS_LOCAL_LINEAR(d->lse_rhs,
+                d->phi,
+                d->phi0,
+                d->phi_x_plus, d->phi_y_plus, d->phi_z_plus,
+                d->phi_x_minus, d->phi_y_minus, d->phi_z_minus,
+                &((g->dx)[0]), &((g->dx)[1]), &((g->dx)[2]),
+                &use_phi0_for_sign,
+                d->index_lin,
+                &(d->n_lo)[0], &(d->n_hi)[0],
+                d->narrow_band,
+                &mark_fb);
  
-       LSM3D_TVD_RK2_STAGE1_LOCAL(d->phi_stage1,
-                   &(g->ilo_gb), &(g->ihi_gb), &(g->jlo_gb), &(g->jhi_gb),
-		   &(g->klo_gb), &(g->khi_gb),
-		   d->phi,
-		   &(g->ilo_gb), &(g->ihi_gb), &(g->jlo_gb), &(g->jhi_gb),
-		   &(g->klo_gb), &(g->khi_gb),
-		   d->lse_rhs,
-		   &(g->ilo_gb), &(g->ihi_gb), &(g->jlo_gb), &(g->jhi_gb),
-		   &(g->klo_gb), &(g->khi_gb),
-		   &dt_r,		   
-		   d->index_x, d->index_y, d->index_z,
-		   &(d->n_lo)[0],&(d->n_hi)[0],
-		   d->narrow_band,
-		   &(g->ilo_gb), &(g->ihi_gb), &(g->jlo_gb), &(g->jhi_gb),
-		   &(g->klo_gb), &(g->khi_gb),
-		   &mark_fb);
+       LSM3D_TVD_RK2_STAGE1_LOCAL_LINEAR(d->phi_stage1,
+                 d->phi,
+                 d->lse_rhs,
+                 &dt_r,
+                 d->index_lin,
+                 &(d->n_lo)[0], &(d->n_hi)[0],
+                 d->narrow_band,
+                 &mark_fb);
 
       /* boundary conditions */ 
       signedLinearExtrapolationBC(d->phi_stage1,g,bdry_location_idx);
       
-      LSM3D_HJ_ENO2_LOCAL(d->phi_x_plus, d->phi_y_plus, d->phi_z_plus,
-                    &(g->ilo_gb), &(g->ihi_gb), &(g->jlo_gb), &(g->jhi_gb),
-		    &(g->klo_gb),&(g->khi_gb),
-                    d->phi_x_minus, d->phi_y_minus, d->phi_z_minus,
-		    &(g->ilo_gb), &(g->ihi_gb), &(g->jlo_gb), &(g->jhi_gb),
-		    &(g->klo_gb),&(g->khi_gb),
-		    d->phi_stage1,
-		    &(g->ilo_gb), &(g->ihi_gb), &(g->jlo_gb), &(g->jhi_gb),
-		    &(g->klo_gb), &(g->khi_gb),
-		    d->D1,
-		    &(g->ilo_gb), &(g->ihi_gb), &(g->jlo_gb), &(g->jhi_gb),
-		    &(g->klo_gb), &(g->khi_gb),
-		    d->D2,
-		    &(g->ilo_gb), &(g->ihi_gb), &(g->jlo_gb), &(g->jhi_gb),
-		    &(g->klo_gb), &(g->khi_gb),
-		    &((g->dx)[0]),&((g->dx)[1]),&((g->dx)[2]),
-		    d->index_x, d->index_y, d->index_z,
-		    &(d->n_lo)[0],&(d->n_hi)[0],
-		    &(d->n_lo)[1],&(d->n_hi)[1],
-		    &(d->n_lo)[2],&(d->n_hi)[2],
-		    d->narrow_band,
-		    &(g->ilo_gb), &(g->ihi_gb), &(g->jlo_gb), &(g->jhi_gb),
-		    &(g->klo_gb), &(g->khi_gb),
-		    &mark_fb,&mark_D1, &mark_D2);   
+      LSM3D_HJ_ENO2_LOCAL_LINEAR(d->phi_x_plus, d->phi_y_plus, d->phi_z_plus,
+                d->phi_x_minus, d->phi_y_minus, d->phi_z_minus,
+                d->phi_stage1, d->D1, d->D2,
+                &(g->ilo_gb), &(g->ihi_gb), &(g->jlo_gb), &(g->jhi_gb),
+                &(g->klo_gb), &(g->khi_gb),
+                &((g->dx)[0]), &((g->dx)[1]), &((g->dx)[2]),
+                d->index_lin,
+                &(d->n_lo)[0], &(d->n_hi)[0],
+                &(d->n_lo)[1], &(d->n_hi)[1],
+                &(d->n_lo)[2], &(d->n_hi)[2],
+                d->narrow_band,
+                &mark_fb, &mark_D1, &mark_D2);   
  
-       LSM3D_COMPUTE_REINITIALIZATION_EQN_RHS_LOCAL(d->lse_rhs,
-                 &(g->ilo_gb), &(g->ihi_gb), &(g->jlo_gb), &(g->jhi_gb),
-		 &(g->klo_gb), &(g->khi_gb),
-		 d->phi_stage1,
-		 &(g->ilo_gb), &(g->ihi_gb), &(g->jlo_gb), &(g->jhi_gb),
-		 &(g->klo_gb), &(g->khi_gb),
-		 d->phi0,
-		 &(g->ilo_gb), &(g->ihi_gb), &(g->jlo_gb), &(g->jhi_gb),
-		 &(g->klo_gb), &(g->khi_gb),
-		 d->phi_x_plus, d->phi_y_plus, d->phi_z_plus,
-		 &(g->ilo_gb), &(g->ihi_gb), &(g->jlo_gb), &(g->jhi_gb),
-		 &(g->klo_gb), &(g->khi_gb),
-		 d->phi_x_minus, d->phi_y_minus, d->phi_z_minus,
-		 &(g->ilo_gb), &(g->ihi_gb), &(g->jlo_gb), &(g->jhi_gb),
-		 &(g->klo_gb), &(g->khi_gb),
-		 &((g->dx)[0]), &((g->dx)[1]),&((g->dx)[2]),
-		 &use_phi0_for_sign,
-		 d->index_x, d->index_y, d->index_z,
-		 &(d->n_lo)[0],&(d->n_hi)[0], 
-		 d->narrow_band,
-                 &(g->ilo_gb), &(g->ihi_gb), &(g->jlo_gb), &(g->jhi_gb),
-		 &(g->klo_gb), &(g->khi_gb),
-		 &mark_fb);
+       LSM3D_COMPUTE_REINITIALIZATION_EQN_RHS_LOCAL_LINEAR(d->lse_rhs,
+                 d->phi_stage1,
+                 d->phi0,
+                 d->phi_x_plus, d->phi_y_plus, d->phi_z_plus,
+                 d->phi_x_minus, d->phi_y_minus, d->phi_z_minus,
+                 &((g->dx)[0]), &((g->dx)[1]), &((g->dx)[2]),
+                 &use_phi0_for_sign,
+                 d->index_lin,
+                 &(d->n_lo)[0], &(d->n_hi)[0],
+                 d->narrow_band,
+                 &mark_fb);
 	 
-       LSM3D_TVD_RK2_STAGE2_LOCAL(d->phi_next,
-                   &(g->ilo_gb), &(g->ihi_gb), &(g->jlo_gb), &(g->jhi_gb),
-		   &(g->klo_gb), &(g->khi_gb),
-		   d->phi_stage1,
-		   &(g->ilo_gb), &(g->ihi_gb), &(g->jlo_gb), &(g->jhi_gb),
-		   &(g->klo_gb), &(g->khi_gb),
-		   d->phi,
-		   &(g->ilo_gb), &(g->ihi_gb), &(g->jlo_gb), &(g->jhi_gb),
-		   &(g->klo_gb), &(g->khi_gb),
-		   d->lse_rhs,
-		   &(g->ilo_gb), &(g->ihi_gb), &(g->jlo_gb), &(g->jhi_gb),
-		   &(g->klo_gb), &(g->khi_gb),
-		   &dt_r,
-		   d->index_x, d->index_y, d->index_z,
-		   &(d->n_lo)[0],&(d->n_hi)[0],
-		   d->narrow_band,
-		   &(g->ilo_gb), &(g->ihi_gb), &(g->jlo_gb), &(g->jhi_gb),
-		   &(g->klo_gb), &(g->khi_gb),
-		   &mark_fb);   	 
+       LSM3D_TVD_RK2_STAGE2_LOCAL_LINEAR(d->phi_next,
+                 d->phi_stage1,
+                 d->phi,
+                 d->lse_rhs,
+                 &dt_r,
+                 d->index_lin,
+                 &(d->n_lo)[0], &(d->n_hi)[0],
+                 d->narrow_band,
+                 &mark_fb);   	 
 
 	/* boundary conditions */ 
        signedLinearExtrapolationBC(d->phi_next,g,bdry_location_idx);
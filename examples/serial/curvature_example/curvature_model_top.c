@@ -178,6 +178,7 @@ void setArrayAllocationCurvatureModel(
        data_arrays->index_x = (int *)NULL;
        data_arrays->index_y = (int *)NULL;
        data_arrays->index_z = (int *)NULL;
+       data_arrays->index_lin = (int *)NULL;
        data_arrays->index_outer_pts = (int *)NULL;
     }
         
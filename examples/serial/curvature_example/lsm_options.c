@@ -68,6 +68,7 @@ Options *createOptionsDefault(void)
   options->do_mask = 1;
 
   options->narrow_band = 0;
+  options->slab_size = 0;
   
   /* User additions */
   
@@ -103,6 +104,7 @@ Options *copyOptions(Options *options_src)
   options->do_mask = options_src->do_mask;	
 
   options->narrow_band = options_src->narrow_band;
+  options->slab_size = options_src->slab_size;
   
   /* User additions */
   
@@ -252,6 +254,16 @@ Options *createOptionsFromInputFile(char *filename)
         printf("\nIncorrect save_data option %d, set to default.\n",tmp1);
       }
     }
+    else if( c == 's' && (tolower(line[n+1]) == 'l') )
+    { /* 'slab_size' */  
+      sscanf(line+n,"%*s %d ",&tmp1);
+      if ( tmp1 >= 0 )
+        options->slab_size = tmp1;
+      else
+      {
+        printf("\nIncorrect slab_size option %d, set to default.\n",tmp1);
+      }
+    }
 
 
     /* User additions */
@@ -303,6 +315,8 @@ void  printOptions(Options *options,FILE *fp)
                                                               options->do_mask);
   fprintf(fp,"  narrow_band   %4d [ apply narrow banding (1) or not (0)]\n",
                                                           options->narrow_band);							      							    
+  fprintf(fp,"  slab_size     %4d [ z-planes per temporal block (0 = off)]\n",
+                                                            options->slab_size);
 
   /* User additions */
   fprintf(fp,"  print_details %4d [ print details (1) or not (0)   ]\n",
@@ -67,6 +67,11 @@ typedef struct _Options
 			   LSM_DataArrays structure */
 			   
    int    narrow_band;      /* use narrow banding or no */			   
+
+   int    slab_size;    /* number of z-planes advanced through all TVD RK
+                           stages at a time (temporal blocking) by the
+                           full grid method; 0 sweeps the whole grid
+                           once per stage */
    
    /* User additions */
    
@@ -0,0 +1,394 @@
+/*
+ * File:        HJ_WENO5_NORMAL_VELOCITY_LSE_RHS_3D.c
+ * Copyrights:  (c) 2005 The Trustees of Princeton University and Board of
+ *                  Regents of the University of Texas.  All rights reserved.
+ *              (c) 2009 Kevin T. Chu.  All rights reserved.
+ * Revision:    $Revision$
+ * Modified:    $Date$
+ * Description: MATLAB MEX-file for computing the fifth-order HJ WENO
+ *              plus and minus derivatives and the normal velocity
+ *              contribution to the RHS of level set equation in a
+ *              single call
+ */
+
+/*=======================================================================
+ *
+ * HJ_WENO5_NORMAL_VELOCITY_LSE_RHS_3D() computes the fifth-order plus
+ * and minus HJ WENO approximations to grad(phi) and the contribution
+ * of a normal velocity term to the right-hand side of the level set
+ * equation in a single call.  It is equivalent to calling HJ_WENO5_3D()
+ * followed by COMPUTE_NORMAL_VELOCITY_TERM_FOR_LSE_RHS_3D().
+ *
+ * Usage:  [lse_rhs, ...
+ *          phi_x_plus, phi_y_plus, phi_z_plus, ...
+ *          phi_x_minus, phi_y_minus, phi_z_minus] = ...
+ *         HJ_WENO5_NORMAL_VELOCITY_LSE_RHS_3D( ...
+ *           phi, ghostcell_width, normal_velocity, dX)
+ *
+ * Arguments:
+ * - phi:               level set function
+ * - ghostcell_width:   ghostcell width for phi
+ * - normal_velocity:   normal velocity
+ * - dX:                array containing the grid spacing
+ *                        in coordinate directions
+ *
+ * Return values:
+ * - lse_rhs:           normal velocity contribution to right-hand side
+ *                      level set evolution equation
+ * - phi_x_plus:        x-component of fifth-order, plus
+ *                        HJ WENO derivative (optional)
+ * - phi_y_plus:        y-component of fifth-order, plus
+ *                        HJ WENO derivative (optional)
+ * - phi_z_plus:        z-component of fifth-order, plus
+ *                        HJ WENO derivative (optional)
+ * - phi_x_minus:       x-component of fifth-order, minus
+ *                        HJ WENO derivative (optional)
+ * - phi_y_minus:       y-component of fifth-order, minus
+ *                        HJ WENO derivative (optional)
+ * - phi_z_minus:       z-component of fifth-order, minus
+ *                        HJ WENO derivative (optional)
+ *
+ * NOTES:
+ * - All data arrays are assumed to be in the order generated by the
+ *   MATLAB meshgrid() function.  That is, data corresponding to the
+ *   point (x_i,y_j,z_k) is stored at index (j,i,k).  The output data
+ *   arrays will be returned with the same ordering as the input data
+ *   arrays.
+ *
+ * - The returned arrays are the same size as phi.  Values in the
+ *   ghostcells are set to 0.
+ *
+ * - The derivatives are only copied out to MATLAB arrays if they are
+ *   requested.  When only lse_rhs is requested, the derivatives are
+ *   stored in scratch memory.
+ *
+ * - Scratch memory is cached between calls.  It is only reallocated
+ *   when a larger grid is encountered and is freed when the MEX-file
+ *   is cleared (e.g. "clear mex").
+ *
+ * - When the MEX-file is compiled with OpenMP support (e.g. by adding
+ *   the OpenMP compiler flag to MEX_FLAGS), the grid is split into
+ *   slabs in the z-direction that are processed concurrently.  The
+ *   number of threads is controlled by the OMP_NUM_THREADS environment
+ *   variable.
+ *
+ *=======================================================================*/
+
+#include "mex.h"
+#include "matrix.h"
+#include "LSMLIB_config.h"
+#include "lsm_spatial_derivatives3d.h"
+#include "lsm_level_set_evolution3d.h"
+
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
+/* Input Arguments */
+#define PHI             (prhs[0])
+#define GHOSTCELL_WIDTH (prhs[1])
+#define NORMAL_VELOCITY (prhs[2])
+#define DX              (prhs[3])
+
+/* Output Arguments */
+#define LSE_RHS         (plhs[0])
+#define PHI_X_PLUS      (plhs[1])
+#define PHI_Y_PLUS      (plhs[2])
+#define PHI_Z_PLUS      (plhs[3])
+#define PHI_X_MINUS     (plhs[4])
+#define PHI_Y_MINUS     (plhs[5])
+#define PHI_Z_MINUS     (plhs[6])
+
+/* Other Macros */
+#define NDIM            (3)
+#define D1_GHOSTCELL_WIDTH (3)
+
+
+/* Scratch memory cache (persists between calls) */
+static LSMLIB_REAL *scratch_cache = 0;
+static int scratch_cache_size = 0;
+
+static void freeScratchMemory(void)
+{
+  if (scratch_cache) mxFree(scratch_cache);
+  scratch_cache = 0;
+  scratch_cache_size = 0;
+}
+
+static LSMLIB_REAL* getScratchMemory(int size)
+{
+  if (size > scratch_cache_size) {
+    freeScratchMemory();
+    scratch_cache = (LSMLIB_REAL*) mxMalloc(sizeof(LSMLIB_REAL)*size);
+    if (!scratch_cache) {
+      mexErrMsgTxt("Unable to allocate memory for scratch data...aborting....");
+    }
+    mexMakeMemoryPersistent(scratch_cache);
+    scratch_cache_size = size;
+    mexAtExit(freeScratchMemory);
+  }
+  return scratch_cache;
+}
+
+
+void mexFunction( int nlhs, mxArray *plhs[],
+		  int nrhs, const mxArray*prhs[] )
+
+{
+  LSMLIB_REAL *lse_rhs;
+  LSMLIB_REAL *phi_x_plus, *phi_y_plus, *phi_z_plus;
+  LSMLIB_REAL *phi_x_minus, *phi_y_minus, *phi_z_minus;
+  int ilo_gb, ihi_gb, jlo_gb, jhi_gb, klo_gb, khi_gb;
+  LSMLIB_REAL *phi;
+  LSMLIB_REAL *normal_velocity;
+  int ilo_vel_gb, ihi_vel_gb, jlo_vel_gb, jhi_vel_gb, klo_vel_gb, khi_vel_gb;
+  LSMLIB_REAL *D1;
+  int ilo_D1_gb, ihi_D1_gb, jlo_D1_gb, jhi_D1_gb, klo_D1_gb, khi_D1_gb;
+  int ilo_fb, ihi_fb, jlo_fb, jhi_fb, klo_fb, khi_fb;
+  int num_slabs, slab_size, D1_slab_size;
+  int slab;
+  double *dX;
+  LSMLIB_REAL dX_meshgrid_order[3];
+  int ghostcell_width;
+  int num_data_array_dims;
+  const int *data_array_dims_in;
+  int data_array_dims_out[NDIM];
+  int num_grid_cells;
+  int return_derivatives;
+  LSMLIB_REAL *scratch;
+
+  /* Check for proper number of arguments */
+  if (nrhs != 4) {
+    mexErrMsgTxt("Four required input arguments.");
+  } else if (nlhs > 7) {
+    mexErrMsgTxt("Too many output arguments.");
+  }
+
+  /* Parameter Checks */
+  num_data_array_dims = mxGetNumberOfDimensions(PHI);
+  if (num_data_array_dims != 3) {
+    mexErrMsgTxt("phi should be a 3 dimensional array.");
+  }
+
+  /* Check that the inputs have the correct floating-point precision */
+#ifdef LSMLIB_DOUBLE_PRECISION
+    if (!mxIsDouble(PHI)) {
+      mexErrMsgTxt("Incompatible precision: LSMLIB built for double-precision but phi is single-precision");
+    }
+    if (!mxIsDouble(NORMAL_VELOCITY)) {
+      mexErrMsgTxt("Incompatible precision: LSMLIB built for double-precision but normal_velocity is single-precision");
+    }
+#else
+    if (!mxIsSingle(PHI)) {
+      mexErrMsgTxt("Incompatible precision: LSMLIB built for single-precision but phi is double-precision");
+    }
+    if (!mxIsSingle(NORMAL_VELOCITY)) {
+      mexErrMsgTxt("Incompatible precision: LSMLIB built for single-precision but normal_velocity is double-precision");
+    }
+#endif
+
+  /* Get ghostcell_width */
+  ghostcell_width = mxGetPr(GHOSTCELL_WIDTH)[0];
+
+  /* Get dX */
+  dX = mxGetPr(DX);
+
+  /* Change order of dX to be match MATLAB meshgrid() order for grids. */
+  dX_meshgrid_order[0] = dX[1];
+  dX_meshgrid_order[1] = dX[0];
+  dX_meshgrid_order[2] = dX[2];
+
+  /* Assign pointers for phi and normal velocity */
+  phi = (LSMLIB_REAL*) mxGetPr(PHI);
+  normal_velocity = (LSMLIB_REAL*) mxGetPr(NORMAL_VELOCITY);
+
+  /* Get size of phi data (all output arrays have the same size) */
+  data_array_dims_in = mxGetDimensions(PHI);
+  ilo_gb = 1;
+  ihi_gb = data_array_dims_in[0];
+  jlo_gb = 1;
+  jhi_gb = data_array_dims_in[1];
+  klo_gb = 1;
+  khi_gb = data_array_dims_in[2];
+  data_array_dims_out[0] = ihi_gb-ilo_gb+1;
+  data_array_dims_out[1] = jhi_gb-jlo_gb+1;
+  data_array_dims_out[2] = khi_gb-klo_gb+1;
+  num_grid_cells = data_array_dims_out[0]*data_array_dims_out[1]
+                 * data_array_dims_out[2];
+
+  /* Get size of normal velocity data */
+  data_array_dims_in = mxGetDimensions(NORMAL_VELOCITY);
+  ilo_vel_gb = 1;
+  ihi_vel_gb = data_array_dims_in[0];
+  jlo_vel_gb = 1;
+  jhi_vel_gb = data_array_dims_in[1];
+  klo_vel_gb = 1;
+  khi_vel_gb = data_array_dims_in[2];
+
+  /* if necessary, shift ghostbox for velocity to be */
+  /* centered with respect to the ghostbox for phi.  */
+  if (ihi_vel_gb != ihi_gb) {
+    int shift = (ihi_gb-ihi_vel_gb)/2;
+    ilo_vel_gb += shift;
+    ihi_vel_gb += shift;
+  }
+  if (jhi_vel_gb != jhi_gb) {
+    int shift = (jhi_gb-jhi_vel_gb)/2;
+    jlo_vel_gb += shift;
+    jhi_vel_gb += shift;
+  }
+  if (khi_vel_gb != khi_gb) {
+    int shift = (khi_gb-khi_vel_gb)/2;
+    klo_vel_gb += shift;
+    khi_vel_gb += shift;
+  }
+
+  /* Compute fill-box */
+  ilo_fb = ilo_gb+ghostcell_width;
+  ihi_fb = ihi_gb-ghostcell_width;
+  jlo_fb = jlo_gb+ghostcell_width;
+  jhi_fb = jhi_gb-ghostcell_width;
+  klo_fb = klo_gb+ghostcell_width;
+  khi_fb = khi_gb-ghostcell_width;
+
+  /*
+   * Split fill-box into slabs in the z-direction.  Each slab has its
+   * own block of scratch memory for undivided differences (which
+   * covers the slab plus the cells required by the WENO5 stencil).
+   */
+#ifdef _OPENMP
+  num_slabs = omp_get_max_threads();
+#else
+  num_slabs = 1;
+#endif
+  if (num_slabs > khi_fb-klo_fb+1) num_slabs = khi_fb-klo_fb+1;
+  if (num_slabs < 1) num_slabs = 1;
+  slab_size = (khi_fb-klo_fb+1 + num_slabs-1)/num_slabs;
+  D1_slab_size = data_array_dims_out[0]*data_array_dims_out[1]
+               * (slab_size+2*D1_GHOSTCELL_WIDTH);
+
+  /* Create output matrices and get scratch memory */
+  return_derivatives = (nlhs > 1);
+#ifdef LSMLIB_DOUBLE_PRECISION
+  LSE_RHS = mxCreateNumericArray(NDIM, data_array_dims_out,
+          mxDOUBLE_CLASS, mxREAL);
+#else
+  LSE_RHS = mxCreateNumericArray(NDIM, data_array_dims_out,
+          mxSINGLE_CLASS, mxREAL);
+#endif
+  lse_rhs = (LSMLIB_REAL*) mxGetPr(LSE_RHS);
+
+  if (return_derivatives) {
+#ifdef LSMLIB_DOUBLE_PRECISION
+    PHI_X_PLUS = mxCreateNumericArray(NDIM, data_array_dims_out,
+            mxDOUBLE_CLASS, mxREAL);
+    PHI_Y_PLUS = mxCreateNumericArray(NDIM, data_array_dims_out,
+            mxDOUBLE_CLASS, mxREAL);
+    PHI_Z_PLUS = mxCreateNumericArray(NDIM, data_array_dims_out,
+            mxDOUBLE_CLASS, mxREAL);
+    PHI_X_MINUS = mxCreateNumericArray(NDIM, data_array_dims_out,
+            mxDOUBLE_CLASS, mxREAL);
+    PHI_Y_MINUS = mxCreateNumericArray(NDIM, data_array_dims_out,
+            mxDOUBLE_CLASS, mxREAL);
+    PHI_Z_MINUS = mxCreateNumericArray(NDIM, data_array_dims_out,
+            mxDOUBLE_CLASS, mxREAL);
+#else
+    PHI_X_PLUS = mxCreateNumericArray(NDIM, data_array_dims_out,
+            mxSINGLE_CLASS, mxREAL);
+    PHI_Y_PLUS = mxCreateNumericArray(NDIM, data_array_dims_out,
+            mxSINGLE_CLASS, mxREAL);
+    PHI_Z_PLUS = mxCreateNumericArray(NDIM, data_array_dims_out,
+            mxSINGLE_CLASS, mxREAL);
+    PHI_X_MINUS = mxCreateNumericArray(NDIM, data_array_dims_out,
+            mxSINGLE_CLASS, mxREAL);
+    PHI_Y_MINUS = mxCreateNumericArray(NDIM, data_array_dims_out,
+            mxSINGLE_CLASS, mxREAL);
+    PHI_Z_MINUS = mxCreateNumericArray(NDIM, data_array_dims_out,
+            mxSINGLE_CLASS, mxREAL);
+#endif
+    phi_x_plus  = (LSMLIB_REAL*) mxGetPr(PHI_X_PLUS);
+    phi_y_plus  = (LSMLIB_REAL*) mxGetPr(PHI_Y_PLUS);
+    phi_z_plus  = (LSMLIB_REAL*) mxGetPr(PHI_Z_PLUS);
+    phi_x_minus = (LSMLIB_REAL*) mxGetPr(PHI_X_MINUS);
+    phi_y_minus = (LSMLIB_REAL*) mxGetPr(PHI_Y_MINUS);
+    phi_z_minus = (LSMLIB_REAL*) mxGetPr(PHI_Z_MINUS);
+
+    scratch = getScratchMemory(num_slabs*D1_slab_size);
+    D1 = scratch;
+
+  } else {
+
+    /* store derivatives in scratch memory */
+    scratch = getScratchMemory(6*num_grid_cells + num_slabs*D1_slab_size);
+    phi_x_plus  = scratch;
+    phi_y_plus  = scratch +   num_grid_cells;
+    phi_z_plus  = scratch + 2*num_grid_cells;
+    phi_x_minus = scratch + 3*num_grid_cells;
+    phi_y_minus = scratch + 4*num_grid_cells;
+    phi_z_minus = scratch + 5*num_grid_cells;
+    D1 = scratch + 6*num_grid_cells;
+  }
+
+  /*
+   * Do the actual computations in Fortran 77 subroutines.  For each
+   * slab, the derivatives are computed and then immediately used to
+   * compute the normal velocity contribution to the RHS so that the
+   * derivative data is reused while it is still in cache.
+   *
+   * NOTE: ordering of data arrays from meshgrid() is (y,x,z), so
+   * order derivative data arrays need to be permuted.
+   */
+#ifdef _OPENMP
+#pragma omp parallel for private(ilo_D1_gb, ihi_D1_gb, jlo_D1_gb, jhi_D1_gb, \
+                                 klo_D1_gb, khi_D1_gb) \
+                         schedule(static,1)
+#endif
+  for (slab = 0; slab < num_slabs; slab++) {
+    int klo_slab_fb = klo_fb + slab*slab_size;
+    int khi_slab_fb = klo_slab_fb + slab_size - 1;
+    if (khi_slab_fb > khi_fb) khi_slab_fb = khi_fb;
+
+    if (klo_slab_fb <= khi_slab_fb) {
+      ilo_D1_gb = ilo_gb;
+      ihi_D1_gb = ihi_gb;
+      jlo_D1_gb = jlo_gb;
+      jhi_D1_gb = jhi_gb;
+      klo_D1_gb = klo_slab_fb - D1_GHOSTCELL_WIDTH;
+      khi_D1_gb = klo_D1_gb + slab_size + 2*D1_GHOSTCELL_WIDTH - 1;
+
+      LSM3D_HJ_WENO5(
+        phi_y_plus, phi_x_plus, phi_z_plus,
+        &ilo_gb, &ihi_gb, &jlo_gb, &jhi_gb, &klo_gb, &khi_gb,
+        phi_y_minus, phi_x_minus, phi_z_minus,
+        &ilo_gb, &ihi_gb, &jlo_gb, &jhi_gb, &klo_gb, &khi_gb,
+        phi,
+        &ilo_gb, &ihi_gb, &jlo_gb, &jhi_gb, &klo_gb, &khi_gb,
+        D1 + slab*D1_slab_size,
+        &ilo_D1_gb, &ihi_D1_gb,
+        &jlo_D1_gb, &jhi_D1_gb,
+        &klo_D1_gb, &khi_D1_gb,
+        &ilo_fb, &ihi_fb,
+        &jlo_fb, &jhi_fb,
+        &klo_slab_fb, &khi_slab_fb,
+        &dX_meshgrid_order[0], &dX_meshgrid_order[1],
+        &dX_meshgrid_order[2]);
+
+      LSM3D_ADD_NORMAL_VEL_TERM_TO_LSE_RHS(
+        lse_rhs,
+        &ilo_gb, &ihi_gb, &jlo_gb, &jhi_gb, &klo_gb, &khi_gb,
+        phi_x_plus, phi_y_plus, phi_z_plus,
+        &ilo_gb, &ihi_gb, &jlo_gb, &jhi_gb, &klo_gb, &khi_gb,
+        phi_x_minus, phi_y_minus, phi_z_minus,
+        &ilo_gb, &ihi_gb, &jlo_gb, &jhi_gb, &klo_gb, &khi_gb,
+        normal_velocity,
+        &ilo_vel_gb, &ihi_vel_gb,
+        &jlo_vel_gb, &jhi_vel_gb,
+        &klo_vel_gb, &khi_vel_gb,
+        &ilo_fb, &ihi_fb,
+        &jlo_fb, &jhi_fb,
+        &klo_slab_fb, &khi_slab_fb);
+    }
+  }
+
+  return;
+}
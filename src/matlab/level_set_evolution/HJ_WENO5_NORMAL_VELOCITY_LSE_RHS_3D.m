@@ -0,0 +1,71 @@
+%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+%
+% HJ_WENO5_NORMAL_VELOCITY_LSE_RHS_3D() computes the fifth-order plus
+% and minus HJ WENO approximations to grad(phi) and the contribution
+% of a normal velocity term to the right-hand side of the level set
+% equation in a single call.  It is equivalent to calling HJ_WENO5_3D()
+% followed by COMPUTE_NORMAL_VELOCITY_TERM_FOR_LSE_RHS_3D().
+%
+% Usage:  [lse_rhs, ...
+%          phi_x_plus, phi_y_plus, phi_z_plus, ...
+%          phi_x_minus, phi_y_minus, phi_z_minus] = ...
+%         HJ_WENO5_NORMAL_VELOCITY_LSE_RHS_3D( ...
+%           phi, ghostcell_width, normal_velocity, dX)
+%
+% Arguments:
+% - phi:               level set function
+% - ghostcell_width:   ghostcell width for phi
+% - normal_velocity:   normal velocity
+% - dX:                array containing the grid spacing
+%                        in coordinate directions
+%
+% Return values:
+% - lse_rhs:           normal velocity contribution to right-hand side
+%                      level set evolution equation
+% - phi_x_plus:        x-component of fifth-order, plus
+%                        HJ WENO derivative (optional)
+% - phi_y_plus:        y-component of fifth-order, plus
+%                        HJ WENO derivative (optional)
+% - phi_z_plus:        z-component of fifth-order, plus
+%                        HJ WENO derivative (optional)
+% - phi_x_minus:       x-component of fifth-order, minus
+%                        HJ WENO derivative (optional)
+% - phi_y_minus:       y-component of fifth-order, minus
+%                        HJ WENO derivative (optional)
+% - phi_z_minus:       z-component of fifth-order, minus
+%                        HJ WENO derivative (optional)
+%
+% NOTES:
+% - All data arrays are assumed to be in the order generated by the
+%   MATLAB meshgrid() function.  That is, data corresponding to the
+%   point (x_i,y_j,z_k) is stored at index (j,i,k).  The output data
+%   arrays will be returned with the same ordering as the input data
+%   arrays.
+%
+% - The returned arrays are the same size as phi.  Values in the
+%   ghostcells are set to 0.
+%
+% - The derivatives are only copied out to MATLAB arrays if they are
+%   requested.  When only lse_rhs is requested, the derivatives are
+%   stored in scratch memory.
+%
+% - Scratch memory is cached between calls.  It is only reallocated
+%   when a larger grid is encountered and is freed when the MEX-file
+%   is cleared (e.g. "clear mex").
+%
+% - When the MEX-file is compiled with OpenMP support (e.g. by adding
+%   the OpenMP compiler flag to MEX_FLAGS), the grid is split into
+%   slabs in the z-direction that are processed concurrently.  The
+%   number of threads is controlled by the OMP_NUM_THREADS environment
+%   variable.
+%
+%
+%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
+%
+% Copyrights: (c) 2005 The Trustees of Princeton University and Board of
+%                 Regents of the University of Texas.  All rights reserved.
+%             (c) 2009 Kevin T. Chu.  All rights reserved.
+% Revision:   $Revision$
+% Modified:   $Date$
+%
+%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
@@ -18,6 +18,10 @@
 %
 % NOTES:
 % - phi_x_plus and phi_x_minus have the same ghostcell width as phi.
+%
+% - The scratch memory for the undivided differences is cached between
+%   calls.  It is only reallocated when a larger grid is encountered
+%   and is freed when the MEX-file is cleared (e.g. "clear mex").
 % 
 %%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
 %
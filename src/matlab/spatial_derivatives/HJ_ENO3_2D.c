@@ -43,6 +43,10 @@
  *   point (x_i,y_j) is stored at index (j,i).  The output data arrays 
  *   will be returned with the same ordering as the input data arrays. 
  *
+ * - The scratch memory for the undivided differences is cached between
+ *   calls.  It is only reallocated when a larger grid is encountered
+ *   and is freed when the MEX-file is cleared (e.g. "clear mex").
+ *
  *=======================================================================*/
 
 #include "mex.h"
@@ -62,6 +66,33 @@
 #define PHI_Y_MINUS     (plhs[3])
 
 
+/* Scratch memory cache (persists between calls) */
+static LSMLIB_REAL *D_cache = 0;
+static int D_cache_size = 0;
+
+static void freeScratchMemory(void)
+{
+  if (D_cache) mxFree(D_cache);
+  D_cache = 0;
+  D_cache_size = 0;
+}
+
+static LSMLIB_REAL* getScratchMemory(int size)
+{
+  if (size > D_cache_size) {
+    freeScratchMemory();
+    D_cache = (LSMLIB_REAL*) mxMalloc(sizeof(LSMLIB_REAL)*size);
+    if (!D_cache) {
+      mexErrMsgTxt("Unable to allocate memory for scratch data...aborting....");
+    }
+    mexMakeMemoryPersistent(D_cache);
+    D_cache_size = size;
+    mexAtExit(freeScratchMemory);
+  }
+  return D_cache;
+}
+
+
 void mexFunction( int nlhs, mxArray *plhs[], 
 		  int nrhs, const mxArray*prhs[] )
      
@@ -77,6 +108,7 @@ void mexFunction( int nlhs, mxArray *plhs[],
   LSMLIB_REAL *D3;
   int ilo_D3_gb, ihi_D3_gb, jlo_D3_gb, jhi_D3_gb;
   int ilo_fb, ihi_fb, jlo_fb, jhi_fb;
+  int D_size;
   double *dX;
   LSMLIB_REAL dX_meshgrid_order[2];
   int ghostcell_width;
@@ -163,37 +195,24 @@ void mexFunction( int nlhs, mxArray *plhs[],
   phi_y_minus = (LSMLIB_REAL*) mxGetPr(PHI_Y_MINUS); 
 
 
-  /* Allocate scratch memory for undivided differences */
+  /* Get (cached) scratch memory for undivided differences */
   ilo_D1_gb = ilo_phi_gb;
   ihi_D1_gb = ihi_phi_gb;
   jlo_D1_gb = ilo_phi_gb;
   jhi_D1_gb = jhi_phi_gb;
-  D1 = (LSMLIB_REAL*) mxMalloc( sizeof(LSMLIB_REAL)
-                              * (ihi_D1_gb-ilo_D1_gb+1) 
-                              * (jhi_D1_gb-jlo_D1_gb+1) );
-
   ilo_D2_gb = ilo_phi_gb;
   ihi_D2_gb = ihi_phi_gb;
   jlo_D2_gb = ilo_phi_gb;
   jhi_D2_gb = jhi_phi_gb;
-  D2 = (LSMLIB_REAL*) mxMalloc( sizeof(LSMLIB_REAL)
-                              * (ihi_D2_gb-ilo_D2_gb+1) 
-                              * (jhi_D2_gb-jlo_D2_gb+1) );
-
   ilo_D3_gb = ilo_phi_gb;
   ihi_D3_gb = ihi_phi_gb;
   jlo_D3_gb = ilo_phi_gb;
   jhi_D3_gb = jhi_phi_gb;
-  D3 = (LSMLIB_REAL*) mxMalloc( sizeof(LSMLIB_REAL)
-                              * (ihi_D3_gb-ilo_D3_gb+1) 
-                              * (jhi_D3_gb-jlo_D3_gb+1) );
-
-  if ( (!D1) || (!D2) || (!D3) ) {
-    if (D1) mxFree(D1);
-    if (D2) mxFree(D2);
-    if (D3) mxFree(D3);
-    mexErrMsgTxt("Unable to allocate memory for scratch data...aborting....");
-  }
+  D_size = (ihi_D1_gb-ilo_D1_gb+1)
+         * (jhi_D1_gb-jlo_D1_gb+1);
+  D1 = getScratchMemory(3*D_size);
+  D2 = D1 + D_size;
+  D3 = D2 + D_size;
 
   /* Do the actual computations in a Fortran 77 subroutine */
   ilo_fb = ilo_phi_gb+ghostcell_width;
@@ -223,10 +242,5 @@ void mexFunction( int nlhs, mxArray *plhs[],
     &ilo_fb, &ihi_fb, &jlo_fb, &jhi_fb,
     &dX_meshgrid_order[0], &dX_meshgrid_order[1]);
 
-  /* Deallocate scratch memory for undivided differences */
-  mxFree(D1);
-  mxFree(D2);
-  mxFree(D3);
-
   return;
 }
@@ -39,6 +39,16 @@
 %   arrays will be returned with the same ordering as the input data 
 %   arrays.
 %
+% - The scratch memory for the undivided differences is cached between
+%   calls.  It is only reallocated when a larger grid is encountered
+%   and is freed when the MEX-file is cleared (e.g. "clear mex").
+%
+% - When the MEX-file is compiled with OpenMP support (e.g. by adding
+%   the OpenMP compiler flag to MEX_FLAGS), the grid is split into 
+%   slabs in the z-direction that are processed concurrently.  The 
+%   number of threads is controlled by the OMP_NUM_THREADS environment
+%   variable.
+%
 %%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
 %
 % Copyrights: (c) 2005 The Trustees of Princeton University and Board of
@@ -29,6 +29,10 @@
  * NOTES:
  * - phi_x has the same ghostcell width as phi.
  *
+ * - The scratch memory for the undivided differences is cached between
+ *   calls.  It is only reallocated when a larger grid is encountered
+ *   and is freed when the MEX-file is cleared (e.g. "clear mex").
+ *
  *=======================================================================*/
 
 #include "mex.h"
@@ -46,6 +50,33 @@
 #define PHI_X           (plhs[0])
 
 
+/* Scratch memory cache (persists between calls) */
+static LSMLIB_REAL *D1_cache = 0;
+static int D1_cache_size = 0;
+
+static void freeScratchMemory(void)
+{
+  if (D1_cache) mxFree(D1_cache);
+  D1_cache = 0;
+  D1_cache_size = 0;
+}
+
+static LSMLIB_REAL* getScratchMemory(int size)
+{
+  if (size > D1_cache_size) {
+    freeScratchMemory();
+    D1_cache = (LSMLIB_REAL*) mxMalloc(sizeof(LSMLIB_REAL)*size);
+    if (!D1_cache) {
+      mexErrMsgTxt("Unable to allocate memory for scratch data...aborting....");
+    }
+    mexMakeMemoryPersistent(D1_cache);
+    D1_cache_size = size;
+    mexAtExit(freeScratchMemory);
+  }
+  return D1_cache;
+}
+
+
 void mexFunction( int nlhs, mxArray *plhs[], 
 		  int nrhs, const mxArray*prhs[] )
      
@@ -145,14 +176,10 @@ void mexFunction( int nlhs, mxArray *plhs[],
   phi_x = (LSMLIB_REAL*) mxGetPr(PHI_X); 
 
 
-  /* Allocate scratch memory for undivided differences */
+  /* Get (cached) scratch memory for undivided differences */
   ilo_D1_gb = ilo_phi_gb;
   ihi_D1_gb = ihi_phi_gb;
-  D1 = (LSMLIB_REAL*) mxMalloc( sizeof(LSMLIB_REAL) * (ihi_D1_gb-ilo_D1_gb+1) );
-
-  if (!D1) {
-    mexErrMsgTxt("Unable to allocate memory for scratch data...aborting....");
-  }
+  D1 = getScratchMemory(ihi_D1_gb-ilo_D1_gb+1);
 
   /* Do the actual computations in a Fortran 77 subroutine */
   ilo_fb = ilo_phi_gb+ghostcell_width;
@@ -165,9 +192,6 @@ void mexFunction( int nlhs, mxArray *plhs[],
     &ilo_fb, &ihi_fb,
     &dx);
 
-  /* Deallocate scratch memory for undivided differences */
-  mxFree(D1);
-
   return;
 }
 
@@ -42,6 +42,10 @@
  *   point (x_i,y_j) is stored at index (j,i).  The output data arrays
  *   will be returned with the same ordering as the input data arrays.
  *
+ * - The scratch memory for the undivided differences is cached between
+ *   calls.  It is only reallocated when a larger grid is encountered
+ *   and is freed when the MEX-file is cleared (e.g. "clear mex").
+ *
  *=======================================================================*/
 
 #include "mex.h"
@@ -61,6 +65,33 @@
 #define PHI_Y           (plhs[1])
 
 
+/* Scratch memory cache (persists between calls) */
+static LSMLIB_REAL *D1_cache = 0;
+static int D1_cache_size = 0;
+
+static void freeScratchMemory(void)
+{
+  if (D1_cache) mxFree(D1_cache);
+  D1_cache = 0;
+  D1_cache_size = 0;
+}
+
+static LSMLIB_REAL* getScratchMemory(int size)
+{
+  if (size > D1_cache_size) {
+    freeScratchMemory();
+    D1_cache = (LSMLIB_REAL*) mxMalloc(sizeof(LSMLIB_REAL)*size);
+    if (!D1_cache) {
+      mexErrMsgTxt("Unable to allocate memory for scratch data...aborting....");
+    }
+    mexMakeMemoryPersistent(D1_cache);
+    D1_cache_size = size;
+    mexAtExit(freeScratchMemory);
+  }
+  return D1_cache;
+}
+
+
 void mexFunction( int nlhs, mxArray *plhs[], 
 		  int nrhs, const mxArray*prhs[] )
      
@@ -187,17 +218,13 @@ void mexFunction( int nlhs, mxArray *plhs[],
   phi_y = (LSMLIB_REAL*) mxGetPr(PHI_Y); 
 
 
-  /* Allocate scratch memory for undivided differences */
+  /* Get (cached) scratch memory for undivided differences */
   ilo_D1_gb = ilo_phi_gb;
   ihi_D1_gb = ihi_phi_gb;
   jlo_D1_gb = ilo_phi_gb;
   jhi_D1_gb = jhi_phi_gb;
-  D1 = (LSMLIB_REAL*) mxMalloc( sizeof(LSMLIB_REAL)
-                              * (ihi_D1_gb-ilo_D1_gb+1) 
-                              * (jhi_D1_gb-jlo_D1_gb+1) );
-  if (!D1) {
-    mexErrMsgTxt("Unable to allocate memory for scratch data...aborting....");
-  }
+  D1 = getScratchMemory((ihi_D1_gb-ilo_D1_gb+1)
+                        * (jhi_D1_gb-jlo_D1_gb+1));
 
 
   /* Do the actual computations in a Fortran 77 subroutine */
@@ -223,8 +250,5 @@ void mexFunction( int nlhs, mxArray *plhs[],
     &ilo_fb, &ihi_fb, &jlo_fb, &jhi_fb,
     &dX_meshgrid_order[0], &dX_meshgrid_order[1]);
 
-  /* Deallocate scratch memory for undivided differences */
-  mxFree(D1);
-
   return;
 }
@@ -47,6 +47,16 @@
  *   arrays will be returned with the same ordering as the input data 
  *   arrays.
  *
+ * - The scratch memory for the undivided differences is cached between
+ *   calls.  It is only reallocated when a larger grid is encountered
+ *   and is freed when the MEX-file is cleared (e.g. "clear mex").
+ *
+ * - When the MEX-file is compiled with OpenMP support (e.g. by adding
+ *   the OpenMP compiler flag to MEX_FLAGS), the grid is split into 
+ *   slabs in the z-direction that are processed concurrently.  The 
+ *   number of threads is controlled by the OMP_NUM_THREADS environment
+ *   variable.
+ *
  *=======================================================================*/
 
 #include "mex.h"
@@ -54,6 +64,10 @@
 #include "LSMLIB_config.h"
 #include "lsm_spatial_derivatives3d.h"
 
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
 /* Input Arguments */ 
 #define PHI             (prhs[0])
 #define VEL_X           (prhs[1])
@@ -69,6 +83,34 @@
 
 /* Other Macros */ 
 #define NDIM            (3)
+#define D_GHOSTCELL_WIDTH (2)
+
+
+/* Scratch memory cache (persists between calls) */
+static LSMLIB_REAL *D_cache = 0;
+static int D_cache_size = 0;
+
+static void freeScratchMemory(void)
+{
+  if (D_cache) mxFree(D_cache);
+  D_cache = 0;
+  D_cache_size = 0;
+}
+
+static LSMLIB_REAL* getScratchMemory(int size)
+{
+  if (size > D_cache_size) {
+    freeScratchMemory();
+    D_cache = (LSMLIB_REAL*) mxMalloc(sizeof(LSMLIB_REAL)*size);
+    if (!D_cache) {
+      mexErrMsgTxt("Unable to allocate memory for scratch data...aborting....");
+    }
+    mexMakeMemoryPersistent(D_cache);
+    D_cache_size = size;
+    mexAtExit(freeScratchMemory);
+  }
+  return D_cache;
+}
 
 
 void mexFunction( int nlhs, mxArray *plhs[], 
@@ -83,11 +125,10 @@ void mexFunction( int nlhs, mxArray *plhs[],
   int ilo_phi_gb, ihi_phi_gb, jlo_phi_gb, jhi_phi_gb, klo_phi_gb, khi_phi_gb;
   LSMLIB_REAL *vel_x, *vel_y, *vel_z;
   int ilo_vel_gb, ihi_vel_gb, jlo_vel_gb, jhi_vel_gb, klo_vel_gb, khi_vel_gb;
-  LSMLIB_REAL *D1;
-  int ilo_D1_gb, ihi_D1_gb, jlo_D1_gb, jhi_D1_gb, klo_D1_gb, khi_D1_gb;
-  LSMLIB_REAL *D2;
-  int ilo_D2_gb, ihi_D2_gb, jlo_D2_gb, jhi_D2_gb, klo_D2_gb, khi_D2_gb;
+  LSMLIB_REAL *D;
   int ilo_fb, ihi_fb, jlo_fb, jhi_fb, klo_fb, khi_fb;
+  int num_slabs, slab_size, D_slab_size;
+  int slab;
   double *dX;
   LSMLIB_REAL dX_meshgrid_order[3];
   int ghostcell_width;
@@ -232,35 +273,6 @@ void mexFunction( int nlhs, mxArray *plhs[],
   phi_y = (LSMLIB_REAL*) mxGetPr(PHI_Y); 
   phi_z = (LSMLIB_REAL*) mxGetPr(PHI_Z); 
 
-  /* Allocate scratch memory for undivided differences */
-  ilo_D1_gb = ilo_phi_gb;
-  ihi_D1_gb = ihi_phi_gb;
-  jlo_D1_gb = jlo_phi_gb;
-  jhi_D1_gb = jhi_phi_gb;
-  klo_D1_gb = klo_phi_gb;
-  khi_D1_gb = khi_phi_gb;
-  D1 = (LSMLIB_REAL*) mxMalloc( sizeof(LSMLIB_REAL) 
-                              * (ihi_D1_gb-ilo_D1_gb+1)
-                              * (jhi_D1_gb-jlo_D1_gb+1)
-                              * (khi_D1_gb-klo_D1_gb+1) );
-
-  ilo_D2_gb = ilo_phi_gb;
-  ihi_D2_gb = ihi_phi_gb;
-  jlo_D2_gb = jlo_phi_gb;
-  jhi_D2_gb = jhi_phi_gb;
-  klo_D2_gb = klo_phi_gb;
-  khi_D2_gb = khi_phi_gb;
-  D2 = (LSMLIB_REAL*) mxMalloc( sizeof(LSMLIB_REAL) 
-                              * (ihi_D2_gb-ilo_D2_gb+1)
-                              * (jhi_D2_gb-jlo_D2_gb+1)
-                              * (khi_D2_gb-klo_D2_gb+1) );
-  
-  if ( (!D1) || (!D2) ) {
-    if (D1) mxFree(D1);
-    if (D2) mxFree(D2);
-    mexErrMsgTxt("Unable to allocate memory for scratch data...aborting....");
-  }
-
 
   /* Do the actual computations in a Fortran 77 subroutine */
   ilo_fb = ilo_phi_gb+ghostcell_width;
@@ -270,39 +282,71 @@ void mexFunction( int nlhs, mxArray *plhs[],
   klo_fb = klo_phi_gb+ghostcell_width;
   khi_fb = khi_phi_gb-ghostcell_width;
 
+  /* 
+   * Split fill-box into slabs in the z-direction.  Each slab has its 
+   * own block of scratch memory for undivided differences (which 
+   * covers the slab plus the cells required by the ENO2 stencil).
+   */
+#ifdef _OPENMP
+  num_slabs = omp_get_max_threads();
+#else
+  num_slabs = 1;
+#endif
+  if (num_slabs > khi_fb-klo_fb+1) num_slabs = khi_fb-klo_fb+1;
+  if (num_slabs < 1) num_slabs = 1;
+  slab_size = (khi_fb-klo_fb+1 + num_slabs-1)/num_slabs;
+  D_slab_size = (ihi_phi_gb-ilo_phi_gb+1) 
+              * (jhi_phi_gb-jlo_phi_gb+1)
+              * (slab_size+2*D_GHOSTCELL_WIDTH);
+  D = getScratchMemory(2*num_slabs*D_slab_size);
+
   /* 
    * NOTE: ordering of data arrays from meshgrid() is (y,x,z), so 
    * order derivative and velocity data arrays need to be permuted.
    */
-  LSM3D_UPWIND_HJ_ENO2(
-    phi_y, phi_x, phi_z,
-    &ilo_grad_phi_gb, &ihi_grad_phi_gb,
-    &jlo_grad_phi_gb, &jhi_grad_phi_gb,
-    &klo_grad_phi_gb, &khi_grad_phi_gb,
-    phi, 
-    &ilo_phi_gb, &ihi_phi_gb, 
-    &jlo_phi_gb, &jhi_phi_gb, 
-    &klo_phi_gb, &khi_phi_gb, 
-    vel_y, vel_x, vel_z,
-    &ilo_vel_gb, &ihi_vel_gb, 
-    &jlo_vel_gb, &jhi_vel_gb,
-    &klo_vel_gb, &khi_vel_gb,
-    D1,
-    &ilo_D1_gb, &ihi_D1_gb, 
-    &jlo_D1_gb, &jhi_D1_gb, 
-    &klo_D1_gb, &khi_D1_gb, 
-    D2,
-    &ilo_D2_gb, &ihi_D2_gb, 
-    &jlo_D2_gb, &jhi_D2_gb, 
-    &klo_D2_gb, &khi_D2_gb, 
-    &ilo_fb, &ihi_fb, 
-    &jlo_fb, &jhi_fb,
-    &klo_fb, &khi_fb,
-    &dX_meshgrid_order[0], &dX_meshgrid_order[1], &dX_meshgrid_order[2]);
+#ifdef _OPENMP
+#pragma omp parallel for schedule(static,1)
+#endif
+  for (slab = 0; slab < num_slabs; slab++) {
+    int klo_slab_fb = klo_fb + slab*slab_size;
+    int khi_slab_fb = klo_slab_fb + slab_size - 1;
+    LSMLIB_REAL *D1 = D + 2*slab*D_slab_size;
+    LSMLIB_REAL *D2 = D1 + D_slab_size;
+    int ilo_D_gb = ilo_phi_gb, ihi_D_gb = ihi_phi_gb;
+    int jlo_D_gb = jlo_phi_gb, jhi_D_gb = jhi_phi_gb;
+    int klo_D_gb = klo_slab_fb - D_GHOSTCELL_WIDTH;
+    int khi_D_gb = klo_D_gb + slab_size + 2*D_GHOSTCELL_WIDTH - 1;
 
-  /* Deallocate scratch memory for undivided differences */
-  mxFree(D1);
-  mxFree(D2);
+    if (khi_slab_fb > khi_fb) khi_slab_fb = khi_fb;
+    if (klo_slab_fb <= khi_slab_fb) {
+      LSM3D_UPWIND_HJ_ENO2(
+        phi_y, phi_x, phi_z,
+        &ilo_grad_phi_gb, &ihi_grad_phi_gb,
+        &jlo_grad_phi_gb, &jhi_grad_phi_gb,
+        &klo_grad_phi_gb, &khi_grad_phi_gb,
+        phi, 
+        &ilo_phi_gb, &ihi_phi_gb, 
+        &jlo_phi_gb, &jhi_phi_gb, 
+        &klo_phi_gb, &khi_phi_gb, 
+        vel_y, vel_x, vel_z,
+        &ilo_vel_gb, &ihi_vel_gb, 
+        &jlo_vel_gb, &jhi_vel_gb,
+        &klo_vel_gb, &khi_vel_gb,
+        D1,
+        &ilo_D_gb, &ihi_D_gb, 
+        &jlo_D_gb, &jhi_D_gb, 
+        &klo_D_gb, &khi_D_gb, 
+        D2,
+        &ilo_D_gb, &ihi_D_gb, 
+        &jlo_D_gb, &jhi_D_gb, 
+        &klo_D_gb, &khi_D_gb, 
+        &ilo_fb, &ihi_fb, 
+        &jlo_fb, &jhi_fb,
+        &klo_slab_fb, &khi_slab_fb,
+        &dX_meshgrid_order[0], &dX_meshgrid_order[1], 
+        &dX_meshgrid_order[2]);
+    }
+  }
 
   return;
 }
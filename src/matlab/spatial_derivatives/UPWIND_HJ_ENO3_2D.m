@@ -32,6 +32,10 @@
 %   point (x_i,y_j) is stored at index (j,i).  The output data arrays
 %   will be returned with the same ordering as the input data arrays.
 %
+% - The scratch memory for the undivided differences is cached between
+%   calls.  It is only reallocated when a larger grid is encountered
+%   and is freed when the MEX-file is cleared (e.g. "clear mex").
+%
 %%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%
 %
 % Copyrights: (c) 2005 The Trustees of Princeton University and Board of
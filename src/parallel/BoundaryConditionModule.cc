@@ -12,6 +12,7 @@
 #define included_BoundaryConditionModule_cc
 
 #include "BoundaryConditionModule.h"
+#include "LevelSetMethodStatistics.h"
 
 // SAMRAI headers
 #include "CartesianPatchGeometry.h"
@@ -51,6 +52,7 @@ d_geom_periodic_dirs(0)
   d_patch_hierarchy.setNull(); 
   d_boundary_boxes.setNull();
   d_touches_boundary.setNull();
+  d_fill_plans.setNull();
 }
 
 
@@ -66,6 +68,7 @@ d_geom_periodic_dirs(rhs.d_geom_periodic_dirs)
   d_touches_boundary.setNull();
   d_boundary_boxes = rhs.d_boundary_boxes;
   d_touches_boundary = rhs.d_touches_boundary;
+  d_fill_plans = rhs.d_fill_plans;
 }
 
 
@@ -79,6 +82,10 @@ void BoundaryConditionModule<DIM>::imposeBoundaryConditions(
   const int spatial_derivative_order,
   const int component)
 {
+  LevelSetMethodScopedTimer timer(
+    LevelSetMethodStatistics::getStatistics()->getTimer(
+      "BoundaryConditionModule::imposeBoundaryConditions()"));
+
   // loop over hierarchy and impose boundary conditions
   const int num_levels = d_patch_hierarchy->getNumberLevels();
   for ( int ln=0 ; ln < num_levels; ln++ ) {
@@ -230,6 +237,15 @@ void BoundaryConditionModule<DIM>::imposeAntiPeriodicBCsOnPatch(
   const IntVector<DIM>& upper_bc,
   const int component )
 {
+  // nothing to do unless some direction is anti-periodic
+  bool has_anti_periodic_dir = false;
+  for (int dim = 0; dim < DIM; dim++) {
+    if ( d_geom_periodic_dirs(dim) && (lower_bc[dim] == ANTI_PERIODIC) ) {
+      has_anti_periodic_dir = true;
+    }
+  }
+  if (!has_anti_periodic_dir) return;
+
   // get patch level number and patch number
   int level_num = patch.getPatchLevelNumber();
   int patch_num = patch.getPatchNumber();
@@ -248,17 +264,6 @@ void BoundaryConditionModule<DIM>::imposeAntiPeriodicBCsOnPatch(
               << endl );
   }
 
-  // get PatchGeometry
-  Pointer< CartesianPatchGeometry<DIM> > patch_geom = 
-    patch.getPatchGeometry();  
-
-  // get interior box for patch (used to compute boundary fill box)
-  Box<DIM> interior_box(patch.getBox());
-
-  // get ghostcell width to fill
-  IntVector<DIM> phi_ghost_width_to_fill = phi_data->getGhostCellWidth();
-  Box<DIM> phi_ghostbox = phi_data->getGhostBox();
-
   // get data components
   int comp_lo = component;
   int comp_hi = component+1;
@@ -267,419 +272,36 @@ void BoundaryConditionModule<DIM>::imposeAntiPeriodicBCsOnPatch(
     comp_hi = phi_data->getDepth();
   }
 
-  if (DIM == 3) {
-
-    /*
-     * fill face boundaries
-     */
-    const Array< BoundaryBox<DIM> > face_bdry = 
-      d_boundary_boxes[level_num][DIM*patch_num];
-    for (int i = 0; i < face_bdry.getSize(); i++) {
-
-      // check that boundary is a periodic boundary for level
-      // set functions
-      int bdry_location_idx = face_bdry[i].getLocationIndex();
-      if (  d_geom_periodic_dirs(bdry_location_idx/2) &&
-            (lower_bc[bdry_location_idx/2] == ANTI_PERIODIC) ) {
-
-        /*
-         * impose anti-periodic boundary conditions for phi 
-         */
-        Box<DIM> phi_fillbox = patch_geom->getBoundaryFillBox(
-          face_bdry[i], interior_box, phi_ghost_width_to_fill);
-        int phi_ghostbox_num_cells_x = phi_ghostbox.numberCells(0);
-        int phi_ghostbox_num_cells_y = phi_ghostbox.numberCells(1);
-        IntVector<DIM> phi_ghostbox_lower = phi_ghostbox.lower();
-
-        IntVector<DIM> fillbox_lower = phi_fillbox.lower();
-        IntVector<DIM> fillbox_upper = phi_fillbox.upper();
-
-        // loop over components
-        for (int comp = comp_lo; comp < comp_hi; comp++) {
-
-          LSMLIB_REAL* phi = phi_data->getPointer(comp);
-
-          for (int k = fillbox_lower(2); k <= fillbox_upper(2); k++) {
-            for (int j = fillbox_lower(1); j <= fillbox_upper(1); j++) {
-              for (int i = fillbox_lower(0); i <= fillbox_upper(0); i++) {
-
-                int phi_idx = (i - phi_ghostbox_lower(0))
-                            + (j - phi_ghostbox_lower(1))
-                             *phi_ghostbox_num_cells_x
-                            + (k - phi_ghostbox_lower(2))
-                             *phi_ghostbox_num_cells_x
-                             *phi_ghostbox_num_cells_y;
-
-                phi[phi_idx] *= -1.0;  // flip sign of boundary data
-                
-              }
-            }
-          } // end loop over grid
-
-        } // end loop over components
-
-      } // end case: boundary is a periodic direction for the
-        //           level set functions
-
-    } // end loop over face boundaries
-
-
-    /* 
-     * fill edge boundaries
-     */
-    const Array< BoundaryBox<DIM> > edge_bdry = 
-      d_boundary_boxes[level_num][DIM*patch_num+1];
-    for (int i = 0; i < edge_bdry.getSize(); i++) {
-
-      // check that boundary is a periodic boundary for level
-      // set functions
-      int bdry_location_idx = edge_bdry[i].getLocationIndex();
-      int check_dir_a = -1, check_dir_b = -1; // invalid values
-      switch(bdry_location_idx/4) {
-        case 0: { // edge lies along x-direction
-          check_dir_a = 1;
-          check_dir_b = 2;
-          break;
-        }
-        case 1: { // edge lies along y-direction
-          check_dir_a = 2;
-          check_dir_b = 0;
-          break;
-        }
-        case 2: { // edge lies along z-direction
-          check_dir_a = 0;
-          check_dir_b = 1;
-          break;
-        }
-        default: { 
-          TBOX_ERROR(  "BoundaryConditionModule::"
-                    << "imposeAntiPeriodicBCsOnPatch(): "
-                    << "Invalid boundary location index for edge type when DIM = 3"
-                    << endl );
-        }
-      }
-      if ( ( (d_geom_periodic_dirs(check_dir_a) &&
-              (lower_bc[check_dir_a] == ANTI_PERIODIC)) && 
-             !(d_geom_periodic_dirs(check_dir_b) &&
-              (lower_bc[check_dir_b] == ANTI_PERIODIC)) ) ||
-           (!(d_geom_periodic_dirs(check_dir_a) &&
-              (lower_bc[check_dir_a] == ANTI_PERIODIC)) &&
-             (d_geom_periodic_dirs(check_dir_b) &&
-              (lower_bc[check_dir_b] == ANTI_PERIODIC)) ) ) {
-
-        /*
-         * impose anti-periodic boundary conditions for phi 
-         */
-        Box<DIM> phi_fillbox = patch_geom->getBoundaryFillBox(
-          edge_bdry[i], interior_box, phi_ghost_width_to_fill);
-        int phi_ghostbox_num_cells_x = phi_ghostbox.numberCells(0);
-        int phi_ghostbox_num_cells_y = phi_ghostbox.numberCells(1);
-        IntVector<DIM> phi_ghostbox_lower = phi_ghostbox.lower();
-
-        IntVector<DIM> fillbox_lower = phi_fillbox.lower();
-        IntVector<DIM> fillbox_upper = phi_fillbox.upper();
-
-        // loop over components
-        for (int comp = comp_lo; comp < comp_hi; comp++) {
-
-          LSMLIB_REAL* phi = phi_data->getPointer(comp);
-
-          for (int k = fillbox_lower(2); k <= fillbox_upper(2); k++) {
-            for (int j = fillbox_lower(1); j <= fillbox_upper(1); j++) {
-              for (int i = fillbox_lower(0); i <= fillbox_upper(0); i++) {
-
-                int phi_idx = (i - phi_ghostbox_lower(0))
-                            + (j - phi_ghostbox_lower(1))
-                             *phi_ghostbox_num_cells_x
-                            + (k - phi_ghostbox_lower(2))
-                             *phi_ghostbox_num_cells_x
-                             *phi_ghostbox_num_cells_y;
-
-                phi[phi_idx] *= -1.0;  // flip sign of boundary data
-                
-              }
-            }
-          } // end loop over grid
-
-        } // end loop over components
-
-      } // end case: boundary is a periodic direction for the
-        //           level set functions
-
-    } // end loop over edge boundaries
-
-    /* 
-     * fill node boundaries
-     */
-    const Array< BoundaryBox<DIM> > node_bdry = 
-      d_boundary_boxes[level_num][DIM*patch_num+2];
-    for (int i = 0; i < node_bdry.getSize(); i++) {
-
-      // check that boundary is a periodic boundary for level
-      // set functions
-      bool anti_periodic = false;
-      for (int k = 0; k < 3; k++) {
-        if ( d_geom_periodic_dirs(k) && 
-             (lower_bc[k] == ANTI_PERIODIC) ) 
-          anti_periodic = !anti_periodic;
-      }
-
-      if ( anti_periodic ) {
-
-        /*
-         * impose anti-periodic boundary conditions for phi 
-         */
-        Box<DIM> phi_fillbox = patch_geom->getBoundaryFillBox(
-          node_bdry[i], interior_box, phi_ghost_width_to_fill);
-        int phi_ghostbox_num_cells_x = phi_ghostbox.numberCells(0);
-        int phi_ghostbox_num_cells_y = phi_ghostbox.numberCells(1);
-        IntVector<DIM> phi_ghostbox_lower = phi_ghostbox.lower();
-
-        IntVector<DIM> fillbox_lower = phi_fillbox.lower();
-        IntVector<DIM> fillbox_upper = phi_fillbox.upper();
-
-        // loop over components
-        for (int comp = comp_lo; comp < comp_hi; comp++) {
-
-          LSMLIB_REAL* phi = phi_data->getPointer(comp);
-
-          for (int k = fillbox_lower(2); k <= fillbox_upper(2); k++) {
-            for (int j = fillbox_lower(1); j <= fillbox_upper(1); j++) {
-              for (int i = fillbox_lower(0); i <= fillbox_upper(0); i++) {
-
-                int phi_idx = (i - phi_ghostbox_lower(0))
-                            + (j - phi_ghostbox_lower(1))
-                             *phi_ghostbox_num_cells_x
-                            + (k - phi_ghostbox_lower(2))
-                             *phi_ghostbox_num_cells_x
-                             *phi_ghostbox_num_cells_y;
-
-                phi[phi_idx] *= -1.0;  // flip sign of boundary data
-                
-              }
-            }
-          } // end loop over grid
-
-        } // end loop over components
-
-      } // end case: boundary is a periodic direction for the
-        //           level set functions
-
-    } // end loop over node boundaries
-
-// BEGIN DEBUGGING {
-/*
-    int phi_idx = 0;
-    for (int k = 0; k < phi_ghostbox.numberCells(2); k++) {
-      for (int j = 0; j < phi_ghostbox.numberCells(1); j++) {
-        for (int i = 0; i < phi_ghostbox.numberCells(0); i++) {
-
-           pout << phi[phi_idx] << ",";
-           phi_idx++;
-
-        }
-        pout << endl;
-      }
-      pout << "--------------------" << endl;
-    } // end loop over grid
-*/
-// } END DEBUGGING
-
-  } else if (DIM == 2) {
-
-    /*
-     * fill edge boundaries
-     */
-    const Array< BoundaryBox<DIM> > edge_bdry = 
-      d_boundary_boxes[level_num][DIM*patch_num];
-    for (int i = 0; i < edge_bdry.getSize(); i++) {
-
-      // check that boundary is a periodic boundary for level
-      // set functions
-      int bdry_location_idx = edge_bdry[i].getLocationIndex();
-      if ( d_geom_periodic_dirs(bdry_location_idx/2) &&
-           (lower_bc[bdry_location_idx/2] == ANTI_PERIODIC) ) { 
-
-        /*
-         * impose anti-periodic boundary conditions for phi 
-         */
-        Box<DIM> phi_fillbox = patch_geom->getBoundaryFillBox(
-          edge_bdry[i], interior_box, phi_ghost_width_to_fill);
-        int phi_ghostbox_num_cells_x = phi_ghostbox.numberCells(0);
-        IntVector<DIM> phi_ghostbox_lower = phi_ghostbox.lower();
-
-        IntVector<DIM> fillbox_lower = phi_fillbox.lower();
-        IntVector<DIM> fillbox_upper = phi_fillbox.upper();
-
-        // loop over components
-        for (int comp = comp_lo; comp < comp_hi; comp++) {
-
-          LSMLIB_REAL* phi = phi_data->getPointer(comp);
-
-          for (int j = fillbox_lower(1); j <= fillbox_upper(1); j++) {
-            for (int i = fillbox_lower(0); i <= fillbox_upper(0); i++) {
-
-              int phi_idx = (i - phi_ghostbox_lower(0))
-                          + (j - phi_ghostbox_lower(1))
-                            *phi_ghostbox_num_cells_x;
-
-              phi[phi_idx] *= -1.0;  // flip sign of boundary data
-
-            }
-          } // end loop over grid
-
-        } // end loop over components
-
-      } // end case: boundary is a periodic direction for the
-        //           level set functions
-
-    } // end loop over edge boundaries
-
-
-    /* 
-     * fill node boundaries
-     */
-    const Array< BoundaryBox<DIM> > node_bdry = 
-      d_boundary_boxes[level_num][DIM*patch_num+1];
-    for (int i = 0; i < node_bdry.getSize(); i++) {
-
-      // check that boundary is a periodic boundary for level
-      // set functions
-      if ( ( (d_geom_periodic_dirs(0) && 
-             (lower_bc[0] == ANTI_PERIODIC)) &&
-            !(d_geom_periodic_dirs(1) &&
-             (lower_bc[1] == ANTI_PERIODIC)) ) ||
-           (!(d_geom_periodic_dirs(0) && 
-             (lower_bc[0] == ANTI_PERIODIC)) &&
-             (d_geom_periodic_dirs(1) &&
-             (lower_bc[1] == ANTI_PERIODIC)) ) ) {
-
-        /*
-         * impose anti-periodic boundary conditions for phi 
-         */
-        Box<DIM> phi_fillbox = patch_geom->getBoundaryFillBox(
-          node_bdry[i], interior_box, phi_ghost_width_to_fill);
-        int phi_ghostbox_num_cells_x = phi_ghostbox.numberCells(0);
-        IntVector<DIM> phi_ghostbox_lower = phi_ghostbox.lower();
-
-        IntVector<DIM> fillbox_lower = phi_fillbox.lower();
-        IntVector<DIM> fillbox_upper = phi_fillbox.upper();
-
-        // loop over components
-        for (int comp = comp_lo; comp < comp_hi; comp++) {
-
-          LSMLIB_REAL* phi = phi_data->getPointer(comp);
-
-          for (int j = fillbox_lower(1); j <= fillbox_upper(1); j++) {
-            for (int i = fillbox_lower(0); i <= fillbox_upper(0); i++) {
-
-              int phi_idx = (i - phi_ghostbox_lower(0))
-                          + (j - phi_ghostbox_lower(1))
-                            *phi_ghostbox_num_cells_x;
-
-              phi[phi_idx] *= -1.0;  // flip sign of boundary data
-                
-            }
-          } // end loop over grid
-
-        } // end loop over components
-
-      } // end case: boundary is a periodic direction for the
-        //           level set functions
-
-    } // end loop over node boundaries
-
-// BEGIN DEBUGGING {
-/*
-    int phi_idx = 0;
-    for (int k = 0; k < phi_ghostbox.numberCells(2); k++) {
-      for (int j = 0; j < phi_ghostbox.numberCells(1); j++) {
-        for (int i = 0; i < phi_ghostbox.numberCells(0); i++) {
-
-           pout << phi[phi_idx] << ",";
-           phi_idx++;
-
-        }
-        pout << endl;
-      }
-      pout << "--------------------" << endl;
-    } // end loop over grid
-*/  
-// } END DEBUGGING
-
-  } else if (DIM == 1) {
-
-    /*
-     * fill node boundaries
-     */
-    const Array< BoundaryBox<DIM> > node_bdry = 
-      d_boundary_boxes[level_num][DIM*patch_num];
-    for (int i = 0; i < node_bdry.getSize(); i++) {
-
-      // check that boundary is a periodic boundary for level
-      // set functions
-      int bdry_location_idx = node_bdry[i].getLocationIndex();
-      if ( d_geom_periodic_dirs(bdry_location_idx/2) &&
-             (lower_bc[bdry_location_idx/2] == ANTI_PERIODIC) ) {
-
-        /*
-         * impose anti-periodic boundary conditions for phi 
-         */
-        Box<DIM> phi_fillbox = patch_geom->getBoundaryFillBox(
-          node_bdry[i], interior_box, phi_ghost_width_to_fill);
-        IntVector<DIM> phi_ghostbox_lower = phi_ghostbox.lower();
-
-        IntVector<DIM> fillbox_lower = phi_fillbox.lower();
-        IntVector<DIM> fillbox_upper = phi_fillbox.upper();
-
-        // loop over components
-        for (int comp = comp_lo; comp < comp_hi; comp++) {
-
-          LSMLIB_REAL* phi = phi_data->getPointer(comp);
-
-          for (int i = fillbox_lower(0); i <= fillbox_upper(0); i++) {
-
-                int phi_idx = i - phi_ghostbox_lower(0);
-
-                phi[phi_idx] *= -1.0;  // flip sign of boundary data
-                
-          } // end loop over grid
-
-        } // end loop over components
-
-      } // end case: boundary is a periodic direction for the
-        //           level set functions
-
-    } // end loop over node boundaries
+  // flip sign of boundary data for boundary boxes across which
+  // the level set functions are anti-periodic
+  const BoundaryFillPlan& plan = d_fill_plans[level_num][patch_num];
+  const int num_blocks = plan.fill_blocks.size();
+  for (int b = 0; b < num_blocks; b++) {
 
+    const BoundaryFillBlock& block = plan.fill_blocks[b];
+    if ( !isAntiPeriodicBoundary(block.bdry_type, block.bdry_location_idx,
+                                 lower_bc) ) {
+      continue;
+    }
 
-// BEGIN DEBUGGING {
-/*
-    int phi_idx = 0;
-    for (int k = 0; k < phi_ghostbox.numberCells(2); k++) {
-      for (int j = 0; j < phi_ghostbox.numberCells(1); j++) {
-        for (int i = 0; i < phi_ghostbox.numberCells(0); i++) {
+    // loop over components
+    for (int comp = comp_lo; comp < comp_hi; comp++) {
 
-           pout << phi[phi_idx] << ",";
-           phi_idx++;
+      LSMLIB_REAL* phi = phi_data->getPointer(comp) + block.offset;
 
+      for (int k = 0; k < block.num_cells[2]; k++) {
+        for (int j = 0; j < block.num_cells[1]; j++) {
+          LSMLIB_REAL* phi_row = phi + j*block.stride[1] 
+                                     + k*block.stride[2];
+          for (int i = 0; i < block.num_cells[0]; i++) {
+            phi_row[i] = -phi_row[i];  // flip sign of boundary data
+          }
         }
-        pout << endl;
-      }
-      pout << "--------------------" << endl;
-    } // end loop over grid
-*/
-// } END DEBUGGING
-
-  } else { 
+      } // end loop over grid
 
-    TBOX_ERROR(  "BoundaryConditionModule::"
-              << "imposeAntiPeriodicBCsOnPatch()"
-              << "Invalid value of DIM.  "
-              << "Only DIM = 1, 2, and 3 are supported."
-              << endl );
+    } // end loop over components
 
-  } // end switch over DIM
+  } // end loop over boundary boxes
 }
 
 
@@ -743,6 +365,55 @@ void BoundaryConditionModule<DIM>::imposeHomogeneousNeumannBCsOnPatch(
   int level_num = patch.getPatchLevelNumber();
   int patch_num = patch.getPatchNumber();
 
+  // nothing to do unless some boundary of the patch has the 
+  // boundary condition type
+  const vector<BoundaryFillBlock>& face_blocks = 
+    d_fill_plans[level_num][patch_num].face_blocks;
+  const int num_faces = face_blocks.size();
+  bool has_bc_type = false;
+  for (int i = 0; i < num_faces; i++) {
+    int bdry_loc_idx = face_blocks[i].bdry_location_idx;
+    if ( ((bdry_loc_idx%2==0) && (lower_bc[bdry_loc_idx/2] == HOMOGENEOUS_NEUMANN)) ||
+         ((bdry_loc_idx%2==1) && (upper_bc[bdry_loc_idx/2] == HOMOGENEOUS_NEUMANN)) ) {
+      has_bc_type = true;
+    }
+  }
+  if (!has_bc_type) return;
+
+  // check spatial derivative type and order (for all supported 
+  // discretizations, the homogeneous Neumann BC is imposed by 
+  // copying the data on the boundary into the ghostcells)
+  switch (spatial_derivative_type) {
+    case ENO: {
+      if ( (spatial_derivative_order < 1) || 
+           (spatial_derivative_order > 3) ) {
+        TBOX_ERROR(  "BoundaryConditionModule::"
+                  << "imposeHomogeneousNeumannBCsOnPatch(): "
+                  << "Unsupported order for ENO derivative.  "
+                  << "Only ENO1, ENO2, and ENO3 supported."  
+                  << endl );
+      }
+      break;
+    }
+    case WENO: {
+      if (spatial_derivative_order != 5) {
+        TBOX_ERROR(  "BoundaryConditionModule::"
+                  << "imposeHomogeneousNeumannBCsOnPatch(): "
+                  << "Unsupported order for WENO derivative.  "
+                  << "Only WENO5 supported."
+                  << endl );
+      }
+      break;
+    }
+    default: {
+      TBOX_ERROR(  "BoundaryConditionModule::"
+                << "imposeHomogeneousNeumannBCsOnPatch(): "
+                << "Unsupported spatial derivative type.  "
+                << "Only ENO and WENO derivatives are supported."
+                << endl );
+    } 
+  }
+
   // get PatchData
   Pointer< CellData<DIM,LSMLIB_REAL> > phi_data =
     patch.getPatchData( phi_handle );
@@ -757,21 +428,6 @@ void BoundaryConditionModule<DIM>::imposeHomogeneousNeumannBCsOnPatch(
               << endl );
   }
 
-  // get PatchGeometry
-  Pointer< CartesianPatchGeometry<DIM> > patch_geom =
-    patch.getPatchGeometry();
-
-  // get interior box for patch (used to compute boundary fill box)
-  Box<DIM> interior_box(patch.getBox());
-  IntVector<DIM> interior_box_lower = interior_box.lower();
-  IntVector<DIM> interior_box_upper = interior_box.upper();
-
-  // get ghostcell width to fill
-  IntVector<DIM> phi_ghost_width_to_fill = phi_data->getGhostCellWidth();
-  Box<DIM> phi_ghostbox = phi_data->getGhostBox();
-  IntVector<DIM> phi_ghostbox_lower = phi_ghostbox.lower();
-  IntVector<DIM> phi_ghostbox_upper = phi_ghostbox.upper();
-
   // get data components
   int comp_lo = component;
   int comp_hi = component+1;
@@ -780,360 +436,37 @@ void BoundaryConditionModule<DIM>::imposeHomogeneousNeumannBCsOnPatch(
     comp_hi = phi_data->getDepth();
   }
 
-  const Array< BoundaryBox<DIM> > bdry_boxes =
-    d_boundary_boxes[level_num][DIM*patch_num];
-  for (int i = 0; i < bdry_boxes.getSize(); i++) {
+  for (int b = 0; b < num_faces; b++) {
 
     // check that boundary is homogeneous Neumann boundary
-    int bdry_loc_idx = bdry_boxes[i].getLocationIndex();
+    const BoundaryFillBlock& block = face_blocks[b];
+    int bdry_loc_idx = block.bdry_location_idx;
     if ( ((bdry_loc_idx%2==0) && 
-          (lower_bc[bdry_loc_idx/2] == HOMOGENEOUS_NEUMANN)) ||
+          (lower_bc[bdry_loc_idx/2] != HOMOGENEOUS_NEUMANN)) ||
          ((bdry_loc_idx%2==1) && 
-          (upper_bc[bdry_loc_idx/2] == HOMOGENEOUS_NEUMANN)) ) {
-
-      switch (spatial_derivative_type) {
-        case ENO: {
-          switch (spatial_derivative_order) {
-            case 1: {
-
-              if ( DIM == 3 ) {
-
-                for (int comp = comp_lo; comp < comp_hi; comp++) {
-
-                  LSMLIB_REAL* phi = phi_data->getPointer(comp);
-
-                  LSM3D_HOMOGENEOUS_NEUMANN_ENO1(
-                    phi,
-                    &phi_ghostbox_lower[0],
-                    &phi_ghostbox_upper[0],
-                    &phi_ghostbox_lower[1],
-                    &phi_ghostbox_upper[1],
-                    &phi_ghostbox_lower[2],
-                    &phi_ghostbox_upper[2],
-                    &interior_box_lower[0],
-                    &interior_box_upper[0],
-                    &interior_box_lower[1],
-                    &interior_box_upper[1],
-                    &interior_box_lower[2],
-                    &interior_box_upper[2],
-                    &bdry_loc_idx);
-
-                } // end loop over components of PatchData
-
-              } else if ( DIM == 2 ) {
-
-                for (int comp = comp_lo; comp < comp_hi; comp++) {
-
-                  LSMLIB_REAL* phi = phi_data->getPointer(comp);
-
-                  LSM2D_HOMOGENEOUS_NEUMANN_ENO1(
-                    phi,
-                    &phi_ghostbox_lower[0],
-                    &phi_ghostbox_upper[0],
-                    &phi_ghostbox_lower[1],
-                    &phi_ghostbox_upper[1],
-                    &interior_box_lower[0],
-                    &interior_box_upper[0],
-                    &interior_box_lower[1],
-                    &interior_box_upper[1],
-                    &bdry_loc_idx);
-
-                } // end loop over components of PatchData
-
-              } else if ( DIM == 1 ) {
-
-                for (int comp = comp_lo; comp < comp_hi; comp++) {
-
-                  LSMLIB_REAL* phi = phi_data->getPointer(comp);
-
-                  LSM1D_HOMOGENEOUS_NEUMANN_ENO1(
-                    phi,
-                    &phi_ghostbox_lower[0],
-                    &phi_ghostbox_upper[0],
-                    &interior_box_lower[0],
-                    &interior_box_upper[0],
-                    &bdry_loc_idx);
-
-                } // end loop over components of PatchData
-
-              } else {
-
-                TBOX_ERROR(  "BoundaryConditionModule::"
-                          << "imposeHomogeneousNeumannBCsOnPatch(): "
-                          << "Invalid value of DIM.  "
-                          << "Only DIM = 1, 2, and 3 are supported."
-                          << endl );
-
-              } // end switch over dimensions
-
-              break;
-            } // end case: ENO1
-
-            case 2: {
-
-              if ( DIM == 3 ) {
-
-                for (int comp = comp_lo; comp < comp_hi; comp++) {
-
-                  LSMLIB_REAL* phi = phi_data->getPointer(comp);
-
-                  LSM3D_HOMOGENEOUS_NEUMANN_ENO2(
-                    phi,
-                    &phi_ghostbox_lower[0],
-                    &phi_ghostbox_upper[0],
-                    &phi_ghostbox_lower[1],
-                    &phi_ghostbox_upper[1],
-                    &phi_ghostbox_lower[2],
-                    &phi_ghostbox_upper[2],
-                    &interior_box_lower[0],
-                    &interior_box_upper[0],
-                    &interior_box_lower[1],
-                    &interior_box_upper[1],
-                    &interior_box_lower[2],
-                    &interior_box_upper[2],
-                    &bdry_loc_idx);
-
-                } // end loop over components of PatchData
-
-              } else if ( DIM == 2 ) {
-
-                for (int comp = comp_lo; comp < comp_hi; comp++) {
-
-                  LSMLIB_REAL* phi = phi_data->getPointer(comp);
-
-                  LSM2D_HOMOGENEOUS_NEUMANN_ENO2(
-                    phi,
-                    &phi_ghostbox_lower[0],
-                    &phi_ghostbox_upper[0],
-                    &phi_ghostbox_lower[1],
-                    &phi_ghostbox_upper[1],
-                    &interior_box_lower[0],
-                    &interior_box_upper[0],
-                    &interior_box_lower[1],
-                    &interior_box_upper[1],
-                    &bdry_loc_idx);
-
-                } // end loop over components of PatchData
-
-              } else if ( DIM == 1 ) {
-
-                for (int comp = comp_lo; comp < comp_hi; comp++) {
-
-                  LSMLIB_REAL* phi = phi_data->getPointer(comp);
-
-                  LSM1D_HOMOGENEOUS_NEUMANN_ENO2(
-                    phi,
-                    &phi_ghostbox_lower[0],
-                    &phi_ghostbox_upper[0],
-                    &interior_box_lower[0],
-                    &interior_box_upper[0],
-                    &bdry_loc_idx);
-
-                } // end loop over components of PatchData
-
-              } else {
-
-                TBOX_ERROR(  "BoundaryConditionModule::"
-                          << "imposeHomogeneousNeumannBCsOnPatch(): "
-                          << "Invalid value of DIM.  "
-                          << "Only DIM = 1, 2, and 3 are supported."
-                          << endl );
-
-              } // end switch over dimensions
-
-              break;
-            } // end case: ENO2
-
-            case 3: {
-
-              if ( DIM == 3 ) {
-
-                for (int comp = comp_lo; comp < comp_hi; comp++) {
-
-                  LSMLIB_REAL* phi = phi_data->getPointer(comp);
-
-                  LSM3D_HOMOGENEOUS_NEUMANN_ENO3(
-                    phi,
-                    &phi_ghostbox_lower[0],
-                    &phi_ghostbox_upper[0],
-                    &phi_ghostbox_lower[1],
-                    &phi_ghostbox_upper[1],
-                    &phi_ghostbox_lower[2],
-                    &phi_ghostbox_upper[2],
-                    &interior_box_lower[0],
-                    &interior_box_upper[0],
-                    &interior_box_lower[1],
-                    &interior_box_upper[1],
-                    &interior_box_lower[2],
-                    &interior_box_upper[2],
-                    &bdry_loc_idx);
-
-                } // end loop over components of PatchData
-
-              } else if ( DIM == 2 ) {
-
-                for (int comp = comp_lo; comp < comp_hi; comp++) {
-
-                  LSMLIB_REAL* phi = phi_data->getPointer(comp);
-
-                  LSM2D_HOMOGENEOUS_NEUMANN_ENO3(
-                    phi,
-                    &phi_ghostbox_lower[0],
-                    &phi_ghostbox_upper[0],
-                    &phi_ghostbox_lower[1],
-                    &phi_ghostbox_upper[1],
-                    &interior_box_lower[0],
-                    &interior_box_upper[0],
-                    &interior_box_lower[1],
-                    &interior_box_upper[1],
-                    &bdry_loc_idx);
-
-                } // end loop over components of PatchData
-
-              } else if ( DIM == 1 ) {
-
-                for (int comp = comp_lo; comp < comp_hi; comp++) {
-
-                  LSMLIB_REAL* phi = phi_data->getPointer(comp);
-
-                  LSM1D_HOMOGENEOUS_NEUMANN_ENO3(
-                    phi,
-                    &phi_ghostbox_lower[0],
-                    &phi_ghostbox_upper[0],
-                    &interior_box_lower[0],
-                    &interior_box_upper[0],
-                    &bdry_loc_idx);
-
-                } // end loop over components of PatchData
-
-              } else {
-
-                TBOX_ERROR(  "BoundaryConditionModule::"
-                          << "imposeHomogeneousNeumannBCsOnPatch(): "
-                          << "Invalid value of DIM.  "
-                          << "Only DIM = 1, 2, and 3 are supported."
-                          << endl );
-
-              } // end switch over dimensions
-
-              break;
-            } // end case: ENO3
-
-            default: {
-              TBOX_ERROR(  "BoundaryConditionModule::"
-                        << "imposeHomogeneousNeumannBCsOnPatch(): "
-                        << "Unsupported order for ENO derivative.  "
-                        << "Only ENO1, ENO2, and ENO3 supported."  
-                        << endl );
- 
-            }
-          } // end switch on spatial derivative order
-
-          break;
-        } // end case: ENO
-
-      case WENO: {
-          switch (spatial_derivative_order) {
-            case 5: {
-
-              if ( DIM == 3 ) {
-
-                for (int comp = comp_lo; comp < comp_hi; comp++) {
-
-                  LSMLIB_REAL* phi = phi_data->getPointer(comp);
-
-                  LSM3D_HOMOGENEOUS_NEUMANN_WENO5(
-                    phi,
-                    &phi_ghostbox_lower[0],
-                    &phi_ghostbox_upper[0],
-                    &phi_ghostbox_lower[1],
-                    &phi_ghostbox_upper[1],
-                    &phi_ghostbox_lower[2],
-                    &phi_ghostbox_upper[2],
-                    &interior_box_lower[0],
-                    &interior_box_upper[0],
-                    &interior_box_lower[1],
-                    &interior_box_upper[1],
-                    &interior_box_lower[2],
-                    &interior_box_upper[2],
-                    &bdry_loc_idx);
-
-                } // end loop over components of PatchData
-
-              } else if ( DIM == 2 ) {
-
-                for (int comp = comp_lo; comp < comp_hi; comp++) {
-
-                  LSMLIB_REAL* phi = phi_data->getPointer(comp);
-
-                  LSM2D_HOMOGENEOUS_NEUMANN_WENO5(
-                    phi,
-                    &phi_ghostbox_lower[0],
-                    &phi_ghostbox_upper[0],
-                    &phi_ghostbox_lower[1],
-                    &phi_ghostbox_upper[1],
-                    &interior_box_lower[0],
-                    &interior_box_upper[0],
-                    &interior_box_lower[1],
-                    &interior_box_upper[1],
-                    &bdry_loc_idx);
-
-                } // end loop over components of PatchData
-
-              } else if ( DIM == 1 ) {
-
-                for (int comp = comp_lo; comp < comp_hi; comp++) {
-
-                  LSMLIB_REAL* phi = phi_data->getPointer(comp);
-
-                  LSM1D_HOMOGENEOUS_NEUMANN_WENO5(
-                    phi,
-                    &phi_ghostbox_lower[0],
-                    &phi_ghostbox_upper[0],
-                    &interior_box_lower[0],
-                    &interior_box_upper[0],
-                    &bdry_loc_idx);
-
-                } // end loop over components of PatchData
-
-              } else {
-
-                TBOX_ERROR(  "BoundaryConditionModule::"
-                          << "imposeHomogeneousNeumannBCsOnPatch(): "
-                          << "Invalid value of DIM.  "
-                          << "Only DIM = 1, 2, and 3 are supported."
-                          << endl );
-
-              } // end switch over dimensions
-
-              break;
-            } // end case: WENO5
-
-            default: {
-              TBOX_ERROR(  "BoundaryConditionModule::"
-                           << "imposeHomogeneousNeumannBCsOnPatch(): "
-                           << "Unsupported order for WENO derivative.  "
-                           << "Only WENO5 supported."
-                           << endl );
-            }
-
-          } // end switch on spatial derivative order
+          (upper_bc[bdry_loc_idx/2] != HOMOGENEOUS_NEUMANN)) ) {
+      continue;
+    }
 
-          break;
+    // loop over components
+    const int s0 = block.stride[0];
+    for (int comp = comp_lo; comp < comp_hi; comp++) {
 
-        } // end case: WENO
+      LSMLIB_REAL* phi = phi_data->getPointer(comp) + block.offset;
 
-        default: {
-          TBOX_ERROR(  "BoundaryConditionModule::"
-                    << "imposeHomogeneousNeumannBCsOnPatch(): "
-                    << "Unsupported spatial derivative type.  "
-                    << "Only ENO and WENO derivatives are supported."
-                    << endl );
-        } 
+      for (int k = 0; k < block.num_cells[2]; k++) {
+        for (int j = 0; j < block.num_cells[1]; j++) {
+          LSMLIB_REAL* phi_ghost = phi + j*block.stride[1] 
+                                       + k*block.stride[2];
+          const LSMLIB_REAL phi_bdry = phi_ghost[-s0];
+          for (int i = 0; i < block.num_cells[0]; i++) {
+            phi_ghost[i*s0] = phi_bdry;
+          }
+        }
+      } // end loop over grid
 
-      } // end switch on spatial derivative type
+    } // end loop over components
 
-    } // end check that boundary is homogeneous Neumann boundary
   } // end loop over boundary boxes
 }
 
@@ -1192,6 +525,21 @@ void BoundaryConditionModule<DIM>::imposeLinearExtrapolationBCsOnPatch(
   int level_num = patch.getPatchLevelNumber();
   int patch_num = patch.getPatchNumber();
 
+  // nothing to do unless some boundary of the patch has the 
+  // boundary condition type
+  const vector<BoundaryFillBlock>& face_blocks = 
+    d_fill_plans[level_num][patch_num].face_blocks;
+  const int num_faces = face_blocks.size();
+  bool has_bc_type = false;
+  for (int i = 0; i < num_faces; i++) {
+    int bdry_loc_idx = face_blocks[i].bdry_location_idx;
+    if ( ((bdry_loc_idx%2==0) && (lower_bc[bdry_loc_idx/2] == LINEAR_EXTRAPOLATION)) ||
+         ((bdry_loc_idx%2==1) && (upper_bc[bdry_loc_idx/2] == LINEAR_EXTRAPOLATION)) ) {
+      has_bc_type = true;
+    }
+  }
+  if (!has_bc_type) return;
+
   // get PatchData
   Pointer< CellData<DIM,LSMLIB_REAL> > phi_data =
     patch.getPatchData( phi_handle );
@@ -1206,21 +554,6 @@ void BoundaryConditionModule<DIM>::imposeLinearExtrapolationBCsOnPatch(
               << endl );
   }
 
-  // get PatchGeometry
-  Pointer< CartesianPatchGeometry<DIM> > patch_geom =
-    patch.getPatchGeometry();
-
-  // get interior box for patch (used to compute boundary fill box)
-  Box<DIM> interior_box(patch.getBox());
-  IntVector<DIM> interior_box_lower = interior_box.lower();
-  IntVector<DIM> interior_box_upper = interior_box.upper();
-
-  // get ghostcell width to fill
-  IntVector<DIM> phi_ghost_width_to_fill = phi_data->getGhostCellWidth();
-  Box<DIM> phi_ghostbox = phi_data->getGhostBox();
-  IntVector<DIM> phi_ghostbox_lower = phi_ghostbox.lower();
-  IntVector<DIM> phi_ghostbox_upper = phi_ghostbox.upper();
-
   // get data components
   int comp_lo = component;
   int comp_hi = component+1;
@@ -1229,87 +562,38 @@ void BoundaryConditionModule<DIM>::imposeLinearExtrapolationBCsOnPatch(
     comp_hi = phi_data->getDepth();
   }
 
-  const Array< BoundaryBox<DIM> > bdry_boxes =
-    d_boundary_boxes[level_num][DIM*patch_num];
-  for (int i = 0; i < bdry_boxes.getSize(); i++) {
+  for (int b = 0; b < num_faces; b++) {
 
     // check that boundary is linear extrapolation boundary
-    int bdry_loc_idx = bdry_boxes[i].getLocationIndex();
+    const BoundaryFillBlock& block = face_blocks[b];
+    int bdry_loc_idx = block.bdry_location_idx;
     if ( ((bdry_loc_idx%2==0) && 
-          (lower_bc[bdry_loc_idx/2] == LINEAR_EXTRAPOLATION)) ||
+          (lower_bc[bdry_loc_idx/2] != LINEAR_EXTRAPOLATION)) ||
          ((bdry_loc_idx%2==1) && 
-          (upper_bc[bdry_loc_idx/2] == LINEAR_EXTRAPOLATION)) ) {
-
-      if ( DIM == 3 ) {
-
-        for (int comp = comp_lo; comp < comp_hi; comp++) {
-
-          LSMLIB_REAL* phi = phi_data->getPointer(comp);
-
-          LSM3D_LINEAR_EXTRAPOLATION(
-            phi,
-            &phi_ghostbox_lower[0],
-            &phi_ghostbox_upper[0],
-            &phi_ghostbox_lower[1],
-            &phi_ghostbox_upper[1],
-            &phi_ghostbox_lower[2],
-            &phi_ghostbox_upper[2],
-            &interior_box_lower[0],
-            &interior_box_upper[0],
-            &interior_box_lower[1],
-            &interior_box_upper[1],
-            &interior_box_lower[2],
-            &interior_box_upper[2],
-            &bdry_loc_idx);
-
-        } // end loop over components of PatchData
-
-      } else if ( DIM == 2 ) {
-
-        for (int comp = comp_lo; comp < comp_hi; comp++) {
-
-          LSMLIB_REAL* phi = phi_data->getPointer(comp);
-
-          LSM2D_LINEAR_EXTRAPOLATION(
-            phi,
-            &phi_ghostbox_lower[0],
-            &phi_ghostbox_upper[0],
-            &phi_ghostbox_lower[1],
-            &phi_ghostbox_upper[1],
-            &interior_box_lower[0],
-            &interior_box_upper[0],
-            &interior_box_lower[1],
-            &interior_box_upper[1],
-            &bdry_loc_idx);
-
-        } // end loop over components of PatchData
-
-      } else if ( DIM == 1 ) {
-
-        for (int comp = comp_lo; comp < comp_hi; comp++) {
-
-          LSMLIB_REAL* phi = phi_data->getPointer(comp);
-
-          LSM1D_LINEAR_EXTRAPOLATION(
-            phi,
-            &phi_ghostbox_lower[0],
-            &phi_ghostbox_upper[0],
-            &interior_box_lower[0],
-            &interior_box_upper[0],
-            &bdry_loc_idx);
-
-        } // end loop over components of PatchData
+          (upper_bc[bdry_loc_idx/2] != LINEAR_EXTRAPOLATION)) ) {
+      continue;
+    }
 
-      } else {
+    // loop over components
+    const int s0 = block.stride[0];
+    for (int comp = comp_lo; comp < comp_hi; comp++) {
+
+      LSMLIB_REAL* phi = phi_data->getPointer(comp) + block.offset;
+
+      for (int k = 0; k < block.num_cells[2]; k++) {
+        for (int j = 0; j < block.num_cells[1]; j++) {
+          LSMLIB_REAL* phi_ghost = phi + j*block.stride[1] 
+                                       + k*block.stride[2];
+          const LSMLIB_REAL phi_bdry = phi_ghost[-s0];
+          const LSMLIB_REAL slope = phi_bdry - phi_ghost[-2*s0];
+          for (int i = 0; i < block.num_cells[0]; i++) {
+            phi_ghost[i*s0] = phi_bdry + slope*(i+1);
+          }
+        }
+      } // end loop over grid
 
-        TBOX_ERROR(  "BoundaryConditionModule::"
-                  << "imposeLinearExtrapolationBCsOnPatch(): "
-                  << "Invalid value of DIM.  "
-                  << "Only DIM = 1, 2, and 3 are supported."
-                  << endl );
+    } // end loop over components
 
-      } // end switch over dimensions
-    } // end check that boundary is linear extrapolation boundary
   } // end loop over boundary boxes
 }
 
@@ -1368,6 +652,21 @@ void BoundaryConditionModule<DIM>::imposeSignedLinearExtrapolationBCsOnPatch(
   int level_num = patch.getPatchLevelNumber();
   int patch_num = patch.getPatchNumber();
 
+  // nothing to do unless some boundary of the patch has the 
+  // boundary condition type
+  const vector<BoundaryFillBlock>& face_blocks = 
+    d_fill_plans[level_num][patch_num].face_blocks;
+  const int num_faces = face_blocks.size();
+  bool has_bc_type = false;
+  for (int i = 0; i < num_faces; i++) {
+    int bdry_loc_idx = face_blocks[i].bdry_location_idx;
+    if ( ((bdry_loc_idx%2==0) && (lower_bc[bdry_loc_idx/2] == SIGNED_LINEAR_EXTRAPOLATION)) ||
+         ((bdry_loc_idx%2==1) && (upper_bc[bdry_loc_idx/2] == SIGNED_LINEAR_EXTRAPOLATION)) ) {
+      has_bc_type = true;
+    }
+  }
+  if (!has_bc_type) return;
+
   // get PatchData
   Pointer< CellData<DIM,LSMLIB_REAL> > phi_data =
     patch.getPatchData( phi_handle );
@@ -1382,17 +681,12 @@ void BoundaryConditionModule<DIM>::imposeSignedLinearExtrapolationBCsOnPatch(
               << endl );
   }
 
-  // get PatchGeometry
-  Pointer< CartesianPatchGeometry<DIM> > patch_geom =
-    patch.getPatchGeometry();
-
-  // get interior box for patch (used to compute boundary fill box)
+  // get interior box for patch
   Box<DIM> interior_box(patch.getBox());
   IntVector<DIM> interior_box_lower = interior_box.lower();
   IntVector<DIM> interior_box_upper = interior_box.upper();
 
-  // get ghostcell width to fill
-  IntVector<DIM> phi_ghost_width_to_fill = phi_data->getGhostCellWidth();
+  // get ghostbox
   Box<DIM> phi_ghostbox = phi_data->getGhostBox();
   IntVector<DIM> phi_ghostbox_lower = phi_ghostbox.lower();
   IntVector<DIM> phi_ghostbox_upper = phi_ghostbox.upper();
@@ -1405,12 +699,10 @@ void BoundaryConditionModule<DIM>::imposeSignedLinearExtrapolationBCsOnPatch(
     comp_hi = phi_data->getDepth();
   }
 
-  const Array< BoundaryBox<DIM> > bdry_boxes =
-    d_boundary_boxes[level_num][DIM*patch_num];
-  for (int i = 0; i < bdry_boxes.getSize(); i++) {
+  for (int i = 0; i < num_faces; i++) {
 
     // check that boundary is linear extrapolation boundary
-    int bdry_loc_idx = bdry_boxes[i].getLocationIndex();
+    int bdry_loc_idx = face_blocks[i].bdry_location_idx;
     if ( ((bdry_loc_idx%2==0) && 
           (lower_bc[bdry_loc_idx/2] == SIGNED_LINEAR_EXTRAPOLATION)) ||
          ((bdry_loc_idx%2==1) && 
@@ -1516,6 +808,7 @@ void BoundaryConditionModule<DIM>::resetHierarchyConfiguration(
     d_geom_periodic_dirs = zero_int_vect;
     d_boundary_boxes.setNull();
     d_touches_boundary.setNull();
+    d_fill_plans.setNull();
 
     return;
   }
@@ -1523,6 +816,7 @@ void BoundaryConditionModule<DIM>::resetHierarchyConfiguration(
   // resize output arrays 
   d_boundary_boxes.resizeArray(num_levels);
   d_touches_boundary.resizeArray(num_levels);
+  d_fill_plans.resizeArray(num_levels);
 
   // get grid geometry
   Pointer< GridGeometry<DIM> > grid_geometry = 
@@ -1585,9 +879,165 @@ void BoundaryConditionModule<DIM>::resetHierarchyConfiguration(
       true);  // true indicates that boundary boxes should be computed for
               // ALL patches (including those touching periodic boundaries)
 
+    // compute fill plans for local patches that touch the boundary
+    d_fill_plans[ln].resizeArray(num_patches);
+    for (PatchLevelIterator<DIM> pi(level); pi; pi++) { // loop over patches
+      const int patch_num = *pi;
+      d_fill_plans[ln][patch_num].face_blocks.clear();
+      d_fill_plans[ln][patch_num].fill_blocks.clear();
+      if ( d_touches_boundary[ln][patch_num] ) {
+        computeBoundaryFillPlan(d_fill_plans[ln][patch_num],
+                                *(level->getPatch(patch_num)), ln);
+      }
+    }
+
   } // end loop over PatchLevels
 }
 
+
+/* computeBoundaryFillPlan() */
+template <int DIM>
+void BoundaryConditionModule<DIM>::computeBoundaryFillPlan(
+  BoundaryFillPlan& plan,
+  Patch<DIM>& patch,
+  const int level_num)
+{
+  const int patch_num = patch.getPatchNumber();
+
+  // get PatchGeometry
+  Pointer< CartesianPatchGeometry<DIM> > patch_geom =
+    patch.getPatchGeometry();
+
+  // get interior box for patch (used to compute boundary fill box)
+  // and ghostbox of PatchData with the ghostcell width of this object
+  Box<DIM> interior_box(patch.getBox());
+  Box<DIM> ghostbox(interior_box);
+  ghostbox.grow(d_ghostcell_width);
+
+  // strides of data array
+  int stride[3] = {1, 1, 1};
+  for (int dim = 1; dim < DIM; dim++) {
+    stride[dim] = stride[dim-1]*ghostbox.numberCells(dim-1);
+  }
+
+  // boundary boxes are stored by type (i.e. codimension)
+  for (int bdry_type = 1; bdry_type <= DIM; bdry_type++) {
+
+    const Array< BoundaryBox<DIM> > bdry_boxes = 
+      d_boundary_boxes[level_num][DIM*patch_num+bdry_type-1];
+    for (int i = 0; i < bdry_boxes.getSize(); i++) {
+
+      int bdry_location_idx = bdry_boxes[i].getLocationIndex();
+      if (bdry_type == 1) {
+
+        // ghostcells outside of the face over the entire ghostbox in 
+        // the tangential directions.  direction 0 of the block is the 
+        // outward normal direction, so the data on the boundary of the 
+        // interior box is located at offset -stride[0] from a ghostcell 
+        // in the first layer.
+        const int normal_dir = bdry_location_idx/2;
+        BoundaryFillBlock face_block;
+        face_block.bdry_type = bdry_type;
+        face_block.bdry_location_idx = bdry_location_idx;
+        face_block.offset = 0;
+        for (int dim = 0; dim < 3; dim++) {
+          face_block.num_cells[dim] = 1;
+          face_block.stride[dim] = 0;
+        }
+        int tangential_dir = 1;
+        for (int dim = 0; dim < DIM; dim++) {
+          if (dim == normal_dir) {
+            face_block.num_cells[0] = d_ghostcell_width(dim);
+            if (bdry_location_idx%2 == 0) {
+              face_block.offset += 
+                (interior_box.lower(dim) - 1 - ghostbox.lower(dim))*stride[dim];
+              face_block.stride[0] = -stride[dim];
+            } else {
+              face_block.offset += 
+                (interior_box.upper(dim) + 1 - ghostbox.lower(dim))*stride[dim];
+              face_block.stride[0] = stride[dim];
+            }
+          } else {
+            face_block.num_cells[tangential_dir] = ghostbox.numberCells(dim);
+            face_block.stride[tangential_dir] = stride[dim];
+            tangential_dir++;
+          }
+        }
+        plan.face_blocks.push_back(face_block);
+
+      }
+
+      Box<DIM> fillbox = patch_geom->getBoundaryFillBox(
+        bdry_boxes[i], interior_box, d_ghostcell_width);
+      if (fillbox.empty()) continue;
+
+      BoundaryFillBlock block;
+      block.bdry_type = bdry_type;
+      block.bdry_location_idx = bdry_location_idx;
+      block.offset = 0;
+      for (int dim = 0; dim < 3; dim++) {
+        block.num_cells[dim] = 1;
+        block.stride[dim] = stride[dim];
+      }
+      for (int dim = 0; dim < DIM; dim++) {
+        block.offset += (fillbox.lower(dim) - ghostbox.lower(dim))*stride[dim];
+        block.num_cells[dim] = fillbox.numberCells(dim);
+      }
+      plan.fill_blocks.push_back(block);
+
+    } // end loop over boundary boxes
+
+  } // end loop over boundary types
+}
+
+
+/* isAntiPeriodicBoundary() */
+template <int DIM>
+bool BoundaryConditionModule<DIM>::isAntiPeriodicBoundary(
+  const int bdry_type,
+  const int bdry_location_idx,
+  const IntVector<DIM>& lower_bc) const
+{
+  // the sign of the level set functions changes across a boundary box
+  // if it changes across an odd number of the anti-periodic boundaries
+  // that meet at the boundary box
+  bool anti_periodic = false;
+
+  if (bdry_type == 1) {  // faces (DIM = 3), edges (DIM = 2), nodes (DIM = 1)
+
+    const int dir = bdry_location_idx/2;
+    anti_periodic = d_geom_periodic_dirs(dir) && 
+                    (lower_bc[dir] == ANTI_PERIODIC);
+
+  } else if (bdry_type == DIM) {  // nodes (DIM = 2, 3)
+
+    for (int dim = 0; dim < DIM; dim++) {
+      if ( d_geom_periodic_dirs(dim) && (lower_bc[dim] == ANTI_PERIODIC) )
+        anti_periodic = !anti_periodic;
+    }
+
+  } else {  // edges (DIM = 3)
+
+    // edges lie along the direction bdry_location_idx/4 
+    const int edge_dir = bdry_location_idx/4;
+    if ( (edge_dir < 0) || (edge_dir > 2) ) {
+      TBOX_ERROR(  "BoundaryConditionModule::"
+                << "isAntiPeriodicBoundary(): "
+                << "Invalid boundary location index for edge type "
+                << "when DIM = 3"
+                << endl );
+    }
+    for (int dim = 0; dim < DIM; dim++) {
+      if ( (dim != edge_dir) && 
+           d_geom_periodic_dirs(dim) && (lower_bc[dim] == ANTI_PERIODIC) )
+        anti_periodic = !anti_periodic;
+    }
+
+  }
+
+  return anti_periodic;
+}
+
 } // end LSMLIB namespace
 
 #endif
@@ -82,6 +82,7 @@
  */
 
 
+#include <vector>
 #include "SAMRAI_config.h"
 #include "BoundaryBox.h"
 #include "IntVector.h"
@@ -772,7 +773,13 @@ public:
    * The SAMRAI library internally carries out the same calculation, 
    * but it is necessary to repeat this calculation in order to 
    * impose anti-periodic boundary conditions at periodic boundaries 
-   * across which level set functions change sign.
+   * across which level set functions change sign.  The boundary boxes 
+   * are also used to compute a "fill plan" (i.e. the location indices
+   * of the boundary faces and the ghostcells of each boundary box as a
+   * strided block of the data array) for each local Patch that touches
+   * the boundary, so that the boundary boxes and fill boxes do not 
+   * need to be recomputed each time that boundary conditions are 
+   * imposed.
    *
    * Arguments:
    *  - patch_hierarchy (in):        PatchHierarchy to reconfigure
@@ -823,6 +830,7 @@ public:
     d_geom_periodic_dirs = rhs.d_geom_periodic_dirs;
     d_boundary_boxes = rhs.d_boundary_boxes;
     d_touches_boundary = rhs.d_touches_boundary;
+    d_fill_plans = rhs.d_fill_plans;
     return *this;
   }
 
@@ -890,8 +898,67 @@ public:
   //! @}
 
 
+  /*
+   * BoundaryFillBlock describes the ghostcells of a boundary box as a 
+   * strided block of the data array of a PatchData object with the 
+   * ghostcell width of the BoundaryConditionModule.
+   */
+  struct BoundaryFillBlock {
+    int bdry_type;            // boundary type (codimension)
+    int bdry_location_idx;    // boundary location index
+    int offset;               // offset of first ghostcell of the block
+    int num_cells[3];         // number of cells in each direction
+    int stride[3];            // stride in data array in each direction
+  };
+
+  /*
+   * BoundaryFillPlan holds the boundary data for a Patch that is
+   * computed by resetHierarchyConfiguration() so that it does not
+   * need to be recomputed every time boundary conditions are imposed.
+   */
+  struct BoundaryFillPlan {
+    // ghostcells outside of codimension-one boundary boxes over the 
+    // entire ghostbox in the tangential directions with the outward 
+    // normal direction stored as direction 0 (used to impose 
+    // extrapolation BCs)
+    vector<BoundaryFillBlock> face_blocks;
+
+    // ghostcells of all boundary boxes (used to impose anti-periodic BCs)
+    vector<BoundaryFillBlock> fill_blocks;
+  };
+
+
 protected:
 
+  //! @{
+  /*!
+   ****************************************************************
+   *
+   * @name Helper methods
+   *
+   ****************************************************************/
+
+  /*
+   * computeBoundaryFillPlan() computes the BoundaryFillPlan for the 
+   * specified Patch from the boundary boxes for the Patch.
+   */
+  void computeBoundaryFillPlan(
+    BoundaryFillPlan& plan,
+    Patch<DIM>& patch,
+    const int level_num);
+
+  /*
+   * isAntiPeriodicBoundary() returns true if the sign of a level set 
+   * function with the specified boundary conditions changes across the
+   * specified boundary box.
+   */
+  bool isAntiPeriodicBoundary(
+    const int bdry_type,
+    const int bdry_location_idx,
+    const IntVector<DIM>& lower_bc) const;
+
+  //! @}
+
   /****************************************************************
    *
    * Data members
@@ -906,6 +973,9 @@ protected:
   IntVector<DIM> d_geom_periodic_dirs;
   Array< Array< Array< BoundaryBox<DIM> > > > d_boundary_boxes;
   Array< Array<bool> > d_touches_boundary;
+
+  // boundary fill plans for local patches that touch the boundary
+  Array< Array<BoundaryFillPlan> > d_fill_plans;
   
 };
 
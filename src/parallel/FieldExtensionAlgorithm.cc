@@ -19,6 +19,8 @@ extern "C" {
 }
 
 #include "FieldExtensionAlgorithm.h" 
+#include "LevelSetMethodStatistics.h" 
+#include "RefineScheduleCache.h" 
 #include "LSMLIB_DefaultParameters.h"
 
 // SAMRAI Headers
@@ -187,6 +189,9 @@ void FieldExtensionAlgorithm<DIM>::computeExtensionField(
   const IntVector<DIM>& lower_bc_ext,
   const IntVector<DIM>& upper_bc_ext)
 {
+  LevelSetMethodScopedTimer timer(
+    LevelSetMethodStatistics::getStatistics()->getTimer(
+      "FieldExtensionAlgorithm::computeExtensionField()"));
 
   // reset hierarchy configuration if necessary
   if (d_hierarchy_configuration_needs_reset) {
@@ -251,10 +256,13 @@ void FieldExtensionAlgorithm<DIM>::computeExtensionField(
       d_phi_scr_handle, d_phi_handle, 
       0, phi_component);
   }
+  RefineScheduleCache<DIM>* sched_cache = 
+    RefineScheduleCache<DIM>::getCache();
   for ( int ln=0 ; ln < num_levels; ln++ ) {
     // NOTE: 0.0 is "current time" and true indicates that physical 
     //       boundary conditions should be set.
-    d_phi_fill_bdry_sched[ln]->fillData(0.0,true);
+    sched_cache->fillData(d_phi_fill_bdry_alg,
+                          d_phi_fill_bdry_sched[ln], 0.0);
   }
   if (d_phi_scr_handle != d_phi_handle) {
     d_phi_bc_module->imposeBoundaryConditions(
@@ -423,6 +431,9 @@ void FieldExtensionAlgorithm<DIM>::computeExtensionField(
                 << endl );
   }
 
+  LevelSetMethodStatistics::getStatistics()->incrementCounter(
+    "FieldExtensionAlgorithm::iterations", count);
+
   // VERBOSE MODE
   if (d_verbose_mode) {
     pout << endl;
@@ -456,6 +467,9 @@ void FieldExtensionAlgorithm<DIM>::computeExtensionFieldForSingleComponent(
   const IntVector<DIM>& lower_bc_ext,
   const IntVector<DIM>& upper_bc_ext)
 {
+  LevelSetMethodScopedTimer timer(
+    LevelSetMethodStatistics::getStatistics()->getTimer(
+      "FieldExtensionAlgorithm::computeExtensionField()"));
 
   // reset hierarchy configuration if necessary
   if (d_hierarchy_configuration_needs_reset) {
@@ -520,10 +534,13 @@ void FieldExtensionAlgorithm<DIM>::computeExtensionFieldForSingleComponent(
       d_phi_scr_handle, d_phi_handle, 
       0, phi_component);
   }
+  RefineScheduleCache<DIM>* sched_cache = 
+    RefineScheduleCache<DIM>::getCache();
   for ( int ln=0 ; ln < num_levels; ln++ ) {
     // NOTE: 0.0 is "current time" and true indicates that physical 
     //       boundary conditions should be set.
-    d_phi_fill_bdry_sched[ln]->fillData(0.0,true);
+    sched_cache->fillData(d_phi_fill_bdry_alg,
+                          d_phi_fill_bdry_sched[ln], 0.0);
   }
   if (d_phi_scr_handle != d_phi_handle) {
     d_phi_bc_module->imposeBoundaryConditions(
@@ -660,6 +677,9 @@ void FieldExtensionAlgorithm<DIM>::computeExtensionFieldForSingleComponent(
                 << endl );
   }
 
+  LevelSetMethodStatistics::getStatistics()->incrementCounter(
+    "FieldExtensionAlgorithm::iterations", count);
+
   // VERBOSE MODE
   if (d_verbose_mode) {
     pout << endl;
@@ -695,35 +715,40 @@ void FieldExtensionAlgorithm<DIM>::resetHierarchyConfiguration(
   // reset d_grid_geometry
   d_grid_geometry = d_patch_hierarchy->getGridGeometry();
 
-  // compute RefineSchedules for filling extension field boundary data
+  // get RefineSchedules for filling extension field boundary data from
+  // the schedule cache (shared with the other level set method algorithms)
+  RefineScheduleCache<DIM>* sched_cache = 
+    RefineScheduleCache<DIM>::getCache();
+  sched_cache->resetHierarchyConfiguration(
+    hierarchy, coarsest_level, finest_level);
   int num_levels = hierarchy->getNumberLevels();
   for (int k = 0; k < d_tvd_runge_kutta_order; k++) {
     d_extension_field_fill_bdry_sched[k].resizeArray(num_levels);
 
     for (int ln = coarsest_level; ln <= finest_level; ln++) {
-      Pointer< PatchLevel<DIM> > level = hierarchy->getPatchLevel(ln);
- 
       // reset data transfer configuration for boundary filling
       // before time advance
       d_extension_field_fill_bdry_sched[k][ln] =
-        d_extension_field_fill_bdry_alg[k]->createSchedule(
-          level, ln-1, hierarchy, 0);  // NULL RefinePatchStrategy
+        sched_cache->getSchedule(d_extension_field_fill_bdry_alg[k],
+                                 d_ext_field_scratch_ghostcell_width,
+                                 hierarchy, ln,
+                                 0);  // NULL RefinePatchStrategy
  
     } // end loop over levels
   } // end loop over TVD Runge-Kutta stages
 
-  // compute RefineSchedules for filling phi boundary data 
+  // get RefineSchedules for filling phi boundary data 
   // (required for calculating the signed normal vector)
   d_phi_fill_bdry_sched.resizeArray(num_levels);
 
   for (int ln = coarsest_level; ln <= finest_level; ln++) {
-    Pointer< PatchLevel<DIM> > level = hierarchy->getPatchLevel(ln);
-
     // reset data transfer configuration for filling phi boundary data
     // before computing signed normal vector
     d_phi_fill_bdry_sched[ln] =
-      d_phi_fill_bdry_alg->createSchedule(
-        level, ln-1, hierarchy, 0);  // NULL RefinePatchStrategy
+      sched_cache->getSchedule(d_phi_fill_bdry_alg,
+                               d_phi_scratch_ghostcell_width,
+                               hierarchy, ln,
+                               0);  // NULL RefinePatchStrategy
 
   } // end loop over levels
 
@@ -768,10 +793,14 @@ void FieldExtensionAlgorithm<DIM>::advanceFieldExtensionEqnUsingTVDRK1(
     0, field_component);
 
   const int num_levels = d_patch_hierarchy->getNumberLevels();
+  RefineScheduleCache<DIM>* sched_cache = 
+    RefineScheduleCache<DIM>::getCache();
   for ( int ln=0 ; ln < num_levels; ln++ ) {
     // NOTE: 0.0 is "current time" and true indicates that physical 
     //       boundary conditions should be set.
-    d_extension_field_fill_bdry_sched[rk_stage][ln]->fillData(0.0,true);
+    sched_cache->fillData(d_extension_field_fill_bdry_alg[rk_stage],
+                          d_extension_field_fill_bdry_sched[rk_stage][ln],
+                          0.0);
   }
   d_ext_field_bc_module->imposeBoundaryConditions(
     d_extension_field_scr_handles[rk_stage],
@@ -819,10 +848,14 @@ void FieldExtensionAlgorithm<DIM>::advanceFieldExtensionEqnUsingTVDRK2(
     0, field_component);
 
   const int num_levels = d_patch_hierarchy->getNumberLevels();
+  RefineScheduleCache<DIM>* sched_cache = 
+    RefineScheduleCache<DIM>::getCache();
   for ( int ln=0 ; ln < num_levels; ln++ ) {
     // NOTE: 0.0 is "current time" and true indicates that physical 
     //       boundary conditions should be set.
-    d_extension_field_fill_bdry_sched[rk_stage][ln]->fillData(0.0,true);
+    sched_cache->fillData(d_extension_field_fill_bdry_alg[rk_stage],
+                          d_extension_field_fill_bdry_sched[rk_stage][ln],
+                          0.0);
   }
   d_ext_field_bc_module->imposeBoundaryConditions(
     d_extension_field_scr_handles[rk_stage],
@@ -854,7 +887,9 @@ void FieldExtensionAlgorithm<DIM>::advanceFieldExtensionEqnUsingTVDRK2(
   for ( int ln=0 ; ln < num_levels; ln++ ) {
     // NOTE: 0.0 is "current time" and true indicates that physical 
     //       boundary conditions should be set.
-    d_extension_field_fill_bdry_sched[rk_stage][ln]->fillData(0.0,true);
+    sched_cache->fillData(d_extension_field_fill_bdry_alg[rk_stage],
+                          d_extension_field_fill_bdry_sched[rk_stage][ln],
+                          0.0);
   }
   d_ext_field_bc_module->imposeBoundaryConditions(
     d_extension_field_scr_handles[rk_stage],
@@ -906,10 +941,14 @@ void FieldExtensionAlgorithm<DIM>::advanceFieldExtensionEqnUsingTVDRK3(
     0, field_component);
 
   const int num_levels = d_patch_hierarchy->getNumberLevels();
+  RefineScheduleCache<DIM>* sched_cache = 
+    RefineScheduleCache<DIM>::getCache();
   for ( int ln=0 ; ln < num_levels; ln++ ) {
     // NOTE: 0.0 is "current time" and true indicates that physical 
     //       boundary conditions should be set.
-    d_extension_field_fill_bdry_sched[rk_stage][ln]->fillData(0.0,true);
+    sched_cache->fillData(d_extension_field_fill_bdry_alg[rk_stage],
+                          d_extension_field_fill_bdry_sched[rk_stage][ln],
+                          0.0);
   }
   d_ext_field_bc_module->imposeBoundaryConditions(
     d_extension_field_scr_handles[rk_stage],
@@ -941,7 +980,9 @@ void FieldExtensionAlgorithm<DIM>::advanceFieldExtensionEqnUsingTVDRK3(
   for ( int ln=0 ; ln < num_levels; ln++ ) {
     // NOTE: 0.0 is "current time" and true indicates that physical 
     //       boundary conditions should be set.
-    d_extension_field_fill_bdry_sched[rk_stage][ln]->fillData(0.0,true);
+    sched_cache->fillData(d_extension_field_fill_bdry_alg[rk_stage],
+                          d_extension_field_fill_bdry_sched[rk_stage][ln],
+                          0.0);
   }
   d_ext_field_bc_module->imposeBoundaryConditions(
     d_extension_field_scr_handles[rk_stage],
@@ -974,7 +1015,9 @@ void FieldExtensionAlgorithm<DIM>::advanceFieldExtensionEqnUsingTVDRK3(
   for ( int ln=0 ; ln < num_levels; ln++ ) {
     // NOTE: 0.0 is "current time" and true indicates that physical 
     //       boundary conditions should be set.
-    d_extension_field_fill_bdry_sched[rk_stage][ln]->fillData(0.0,true);
+    sched_cache->fillData(d_extension_field_fill_bdry_alg[rk_stage],
+                          d_extension_field_fill_bdry_sched[rk_stage][ln],
+                          0.0);
   }
   d_ext_field_bc_module->imposeBoundaryConditions(
     d_extension_field_scr_handles[rk_stage],
@@ -1023,9 +1066,15 @@ void FieldExtensionAlgorithm<DIM>::computeFieldExtensionEqnRHS(
 
     Pointer< PatchLevel<DIM> > level = d_patch_hierarchy->getPatchLevel(ln);
     
-    typename PatchLevel<DIM>::Iterator pi;
-    for (pi.initialize(level); pi; pi++) { // loop over patches
-      const int pn = *pi;
+    // patches are independent, so they may be processed concurrently
+    vector<int> patch_numbers;
+    LevelSetMethodToolbox<DIM>::getPatchNumbers(level, patch_numbers);
+    const int num_patches = patch_numbers.size();
+#ifdef _OPENMP
+#pragma omp parallel for schedule(dynamic)
+#endif
+    for (int p = 0; p < num_patches; p++) { // loop over patches
+      const int pn = patch_numbers[p];
       Pointer< Patch<DIM> > patch = level->getPatch(pn);
       if ( patch.isNull() ) {
         TBOX_ERROR(  d_object_name
@@ -22,5 +22,8 @@
 #define LSM_DEFAULT_TVD_RUNGE_KUTTA_ORDER                (3)
 #define LSM_DEFAULT_CFL_NUMBER                           (0.5)
 #define LSM_DEFAULT_VERBOSE_MODE                         (false)
+#define LSM_DEFAULT_WORKLOAD_WEIGHTING                   "NARROW_BAND"
+#define LSM_DEFAULT_WORKLOAD_BAND_WIDTH                  (6.0)
+#define LSM_DEFAULT_WORKLOAD_FAR_FIELD_WEIGHT            (0.1)
 
 #endif
@@ -20,6 +20,8 @@
 #include "LevelSetMethodVelocityFieldStrategy.h" 
 #include "LSMLIB_DefaultParameters.h" 
 #include "BoundaryConditionModule.h" 
+#include "LevelSetMethodStatistics.h" 
+#include "RefineScheduleCache.h" 
 
 // SAMRAI header files
 #include "Box.h"
@@ -67,6 +69,7 @@ using namespace pdat;
 #define LSM_DEFAULT_REINITIALIZATION_MAX_ITERS           (25)
 #define LSM_DEFAULT_ORTHOGONALIZATION_INTERVAL           (10)
 #define LSM_DEFAULT_ORTHOGONALIZATION_MAX_ITERS          (25)
+#define LSM_DEFAULT_USE_LOW_STORAGE_TVD_RUNGE_KUTTA      (false)
 #define LSM_DEFAULT_USE_AMR                              (false)
 #define LSM_DEFAULT_REGRID_INTERVAL                      (5)  // KTC - ADJUST
 #define LSM_DEFAULT_TAG_BUFFER_WIDTH                     (2)  // KTC - ADJUST
@@ -141,6 +144,23 @@ LevelSetFunctionIntegrator<DIM>::LevelSetFunctionIntegrator(
   // create empty BoundaryConditionModule
   d_bc_module = new BoundaryConditionModule<DIM>;
 
+  // get timers for performance statistics
+  LevelSetMethodStatistics* stats = LevelSetMethodStatistics::getStatistics();
+  d_timer_advance = stats->getTimer(
+    "LevelSetFunctionIntegrator::advanceLevelSetFunctions()");
+  d_timer_compute_stable_dt = stats->getTimer(
+    "LevelSetFunctionIntegrator::computeStableDt()");
+  d_timer_compute_rhs = stats->getTimer(
+    "LevelSetFunctionIntegrator::computeLevelSetEquationRHS()");
+  d_timer_fill_bdry = stats->getTimer(
+    "LevelSetFunctionIntegrator::fillBoundaryData()");
+  d_timer_reinitialization = stats->getTimer(
+    "LevelSetFunctionIntegrator::reinitializeLevelSetFunctions()");
+  d_timer_orthogonalization = stats->getTimer(
+    "LevelSetFunctionIntegrator::orthogonalizeLevelSetFunctions()");
+  d_num_local_cells = 0.0;
+  d_num_local_ghost_cells = 0.0;
+
   // initialize boundary condition data
   d_lower_bc_phi.resizeArray(d_num_level_set_fcn_components);
   d_upper_bc_phi.resizeArray(d_num_level_set_fcn_components);
@@ -172,6 +192,15 @@ LevelSetFunctionIntegrator<DIM>::LevelSetFunctionIntegrator(
   }
   getFromInput(input_db, is_from_restart);
 
+  // low-storage TVD-RK3 only requires one PatchData in addition to
+  // the current solution
+  if ( (d_tvd_runge_kutta_order == 3) && 
+       d_use_low_storage_tvd_runge_kutta ) {
+    d_num_tvd_runge_kutta_handles = 2;
+  } else {
+    d_num_tvd_runge_kutta_handles = d_tvd_runge_kutta_order;
+  }
+
   // initialize current time, integrator step and counter variables
   if (!is_from_restart) {
     d_current_time = d_start_time;
@@ -283,6 +312,8 @@ LevelSetFunctionIntegrator<DIM>::printClassData(
   os << "d_spatial_derivative_type = " << d_spatial_derivative_type << endl;
   os << "d_spatial_derivative_order = " << d_spatial_derivative_order << endl;
   os << "d_tvd_runge_kutta_order = " << d_tvd_runge_kutta_order << endl;
+  os << "d_use_low_storage_tvd_runge_kutta = " 
+     << (d_use_low_storage_tvd_runge_kutta ? "true" : "false") << endl;
   os << "d_reinitialization_interval = " 
      << d_reinitialization_interval << endl;
   os << "d_reinitialization_stop_tol = " 
@@ -344,6 +375,8 @@ LevelSetFunctionIntegrator<DIM>::printClassData(
 template <int DIM> 
 LSMLIB_REAL LevelSetFunctionIntegrator<DIM>::computeStableDt()
 {
+  LevelSetMethodScopedTimer timer(d_timer_compute_stable_dt);
+
   /*
    * compute maximum stable dt using:
    *
@@ -376,11 +409,8 @@ LSMLIB_REAL LevelSetFunctionIntegrator<DIM>::computeStableDt()
  
   // fill boundary data to for phi/psi to be used for computing
   // velocity field
-  for ( int ln=0 ; ln < num_levels; ln++ ) {
-    // NOTE: true indicates that physical boundary conditions should
-    //       be set.
-    d_fill_bdry_sched_compute_stable_dt[ln]->fillData(d_current_time,true);
-  }
+  fillBoundaryData(d_fill_bdry_compute_stable_dt,
+                   d_fill_bdry_sched_compute_stable_dt, d_current_time);
   for (int comp = 0; comp < d_num_level_set_fcn_components; comp++) {
     d_bc_module->imposeBoundaryConditions(
       d_phi_handles[0],
@@ -455,10 +485,7 @@ LSMLIB_REAL LevelSetFunctionIntegrator<DIM>::computeStableDt()
 
       // compute the velocity field for calculation of 
       // advection_dt and normal_vel_dt
-      d_lsm_velocity_field_strategy->computeVelocityField(
-        d_current_time, 
-        d_phi_handles[0], d_psi_handles[0],
-        comp);
+      computeVelocityFieldForStage(d_current_time, 0, comp);
   
       /*
        *  If necessary, compute the maximum CFL-based advection dt 
@@ -592,18 +619,16 @@ template <int DIM>
 bool LevelSetFunctionIntegrator<DIM>::advanceLevelSetFunctions(
   const LSMLIB_REAL dt)
 {
+  LevelSetMethodScopedTimer timer(d_timer_advance);
+
   // get number of levels in PatchHierarchy
   const int num_levels = d_patch_hierarchy->getNumberLevels();
   
   // if this is the first time step, synchronize data across processors 
   // NOTE:  normally this is done at the end of the time advance
   if (d_current_time == d_start_time) {
-    for ( int ln=0 ; ln < num_levels; ln++ ) {
-      // NOTE: true indicates that physical boundary conditions should
-      //       be set.
-      d_fill_bdry_sched_time_advance[0][ln]
-       ->fillData(d_current_time,true);
-    }
+      fillBoundaryData(d_fill_bdry_time_advance[0],
+                       d_fill_bdry_sched_time_advance[0], d_current_time);
     for (int comp = 0; comp < d_num_level_set_fcn_components; comp++) {
       d_bc_module->imposeBoundaryConditions(
         d_phi_handles[0],
@@ -655,6 +680,9 @@ bool LevelSetFunctionIntegrator<DIM>::advanceLevelSetFunctions(
     }
   }
 
+  LevelSetMethodStatistics::getStatistics()->incrementCounter(
+    "LevelSetFunctionIntegrator::time steps");
+
   // increment reinitialization and orthogonalization counters
   d_reinitialization_count++;
   d_orthogonalization_count++;
@@ -720,12 +748,8 @@ bool LevelSetFunctionIntegrator<DIM>::advanceLevelSetFunctions(
   }
 
   // synchronize data across processors
-  for ( int ln=0 ; ln < num_levels; ln++ ) {
-    // NOTE: true indicates that physical boundary conditions should
-    //       be set.
-    d_fill_bdry_sched_time_advance[0][ln]
-     ->fillData(d_current_time,true);
-  }
+  fillBoundaryData(d_fill_bdry_time_advance[0],
+                   d_fill_bdry_sched_time_advance[0], d_current_time);
   for (int comp = 0; comp < d_num_level_set_fcn_components; comp++) {
     d_bc_module->imposeBoundaryConditions(
       d_phi_handles[0],
@@ -803,6 +827,8 @@ void LevelSetFunctionIntegrator<DIM>::putToDatabase(Pointer<Database> db)
   db->putInteger("d_spatial_derivative_type", d_spatial_derivative_type);
   db->putInteger("d_spatial_derivative_order", d_spatial_derivative_order);
   db->putInteger("d_tvd_runge_kutta_order", d_tvd_runge_kutta_order);
+  db->putBool("d_use_low_storage_tvd_runge_kutta", 
+              d_use_low_storage_tvd_runge_kutta);
 
   db->putInteger("d_reinitialization_interval", d_reinitialization_interval);
   db->putDouble("d_reinitialization_stop_tol", d_reinitialization_stop_tol);
@@ -1085,19 +1111,26 @@ void LevelSetFunctionIntegrator<DIM>::resetHierarchyConfiguration(
 
   // reset communications schedules used to fill boundary data 
   // during time advance
-  for (int k = 0; k < d_tvd_runge_kutta_order; k++) {
+  //
+  // NOTE: the schedules are obtained from the RefineScheduleCache, so
+  //       all TVD Runge-Kutta stages (and the stable dt computation)
+  //       share a single schedule for each level.
+  RefineScheduleCache<DIM>* sched_cache = 
+    RefineScheduleCache<DIM>::getCache();
+  sched_cache->resetHierarchyConfiguration(
+    d_patch_hierarchy, coarsest_level, finest_level);
+  for (int k = 0; k < d_num_tvd_runge_kutta_handles; k++) {
     d_fill_bdry_sched_time_advance[k].resizeArray(num_levels);
 
     for (int ln = coarsest_level; ln <= finest_level; ln++) {
-      Pointer< PatchLevel<DIM> > level = hierarchy->getPatchLevel(ln);
-  
       // reset data transfer configuration for boundary filling 
       // before time advance
       d_fill_bdry_sched_time_advance[k][ln] =
-        d_fill_bdry_time_advance[k]->createSchedule(level,
-                                                    ln-1,
-                                                    hierarchy,
-                                                    this);
+        sched_cache->getSchedule(d_fill_bdry_time_advance[k],
+                                 d_level_set_ghostcell_width,
+                                 d_patch_hierarchy,
+                                 ln,
+                                 this);
   
     } // end loop over levels
   } // end loop over TVD Runge-Kutta stages
@@ -1107,15 +1140,14 @@ void LevelSetFunctionIntegrator<DIM>::resetHierarchyConfiguration(
   d_fill_bdry_sched_compute_stable_dt.resizeArray(num_levels);
 
   for (int ln = coarsest_level; ln <= finest_level; ln++) {
-    Pointer< PatchLevel<DIM> > level = hierarchy->getPatchLevel(ln);
-
     // reset data transfer configuration for boundary filling 
     // before time advance
     d_fill_bdry_sched_compute_stable_dt[ln] =
-      d_fill_bdry_compute_stable_dt->createSchedule(level,
-                                                    ln-1,
-                                                    hierarchy,
-                                                    this);
+      sched_cache->getSchedule(d_fill_bdry_compute_stable_dt,
+                               d_level_set_ghostcell_width,
+                               d_patch_hierarchy,
+                               ln,
+                               this);
   } // end loop over levels
 
   // reset hierarchy configuration for reinitialization and orthogonalization
@@ -1140,6 +1172,54 @@ void LevelSetFunctionIntegrator<DIM>::resetHierarchyConfiguration(
     finest_level,
     d_level_set_ghostcell_width);
 
+  // recompute number of local cells used to update performance counters
+  d_num_local_cells = 0.0;
+  d_num_local_ghost_cells = 0.0;
+  for (int ln = 0; ln < num_levels; ln++) {
+    Pointer< PatchLevel<DIM> > level = d_patch_hierarchy->getPatchLevel(ln);
+
+    typename PatchLevel<DIM>::Iterator pi;
+    for (pi.initialize(level); pi; pi++) { // loop over patches
+      const int pn = *pi;
+      Pointer< Patch<DIM> > patch = level->getPatch(pn);
+      const Box<DIM>& box = patch->getBox();
+      Box<DIM> ghostbox = box;
+      ghostbox.grow(d_level_set_ghostcell_width);
+      d_num_local_cells += box.size();
+      d_num_local_ghost_cells += ghostbox.size() - box.size();
+    }
+  }
+
+}
+
+
+/* fillBoundaryData() */
+template <int DIM> 
+void LevelSetFunctionIntegrator<DIM>::fillBoundaryData(
+  Pointer< RefineAlgorithm<DIM> > refine_alg,
+  Array< Pointer< RefineSchedule<DIM> > >& scheds,
+  const LSMLIB_REAL time)
+{
+  LevelSetMethodScopedTimer timer(d_timer_fill_bdry);
+
+  RefineScheduleCache<DIM>* sched_cache = 
+    RefineScheduleCache<DIM>::getCache();
+  const int num_levels = d_patch_hierarchy->getNumberLevels();
+  for ( int ln=0 ; ln < num_levels; ln++ ) {
+    sched_cache->fillData(refine_alg, scheds[ln], time);
+  }
+
+  // NOTE: the number of bytes exchanged is estimated as the number of 
+  //       ghost cells filled for all components of phi (and psi)
+  const double num_ghost_values = d_num_local_ghost_cells
+                                * d_num_level_set_fcn_components
+                                * d_codimension;
+  LevelSetMethodStatistics* stats = LevelSetMethodStatistics::getStatistics();
+  stats->incrementCounter(
+    "LevelSetFunctionIntegrator::ghost cell fills");
+  stats->incrementCounter(
+    "LevelSetFunctionIntegrator::bytes exchanged (estimate)",
+    num_ghost_values*sizeof(LSMLIB_REAL));
 }
 
 
@@ -1148,6 +1228,10 @@ template <int DIM>
 void LevelSetFunctionIntegrator<DIM>::advanceLevelSetEqnUsingTVDRK1(
   const LSMLIB_REAL dt)
 {
+  LevelSetMethodScopedTimer timer(
+    LevelSetMethodStatistics::getStatistics()->getTimer(
+      "LevelSetFunctionIntegrator::advanceLevelSetEqnUsingTVDRK()"));
+
   // initialize counter for current stage of TVD RK step
   // NOTE: the rk_stage begins at 0 for convenience
   int rk_stage = 0;
@@ -1156,33 +1240,23 @@ void LevelSetFunctionIntegrator<DIM>::advanceLevelSetEqnUsingTVDRK1(
   for (int comp = 0; comp < d_num_level_set_fcn_components; comp++) {
 
     // compute velocity field for current stage
-    d_lsm_velocity_field_strategy->computeVelocityField(
-      d_current_time, 
-      d_phi_handles[rk_stage],
-      d_psi_handles[rk_stage],
-      comp);
+    computeVelocityFieldForStage(d_current_time, rk_stage, comp);
 
     // advance phi through TVD-RK1 step 
-    computeLevelSetEquationRHS(PHI,d_phi_handles[rk_stage],
-                               comp);
-    LevelSetMethodToolbox<DIM>::TVDRK1Step(
-      d_patch_hierarchy,
+    advanceLevelSetEqnThroughStage(
+      PHI, TVD_RK1_STEP,
       d_phi_handles[0], 
       d_phi_handles[rk_stage], 
-      d_rhs_phi_handle, dt,
-      comp, comp, 0); // components of PatchData to use in TVD-RK1 step
+      -1, dt, comp);
 
     if (d_codimension == 2) {
 
       // advance psi through TVD-RK1 step 
-      computeLevelSetEquationRHS(PSI,d_psi_handles[rk_stage],
-                                 comp);
-      LevelSetMethodToolbox<DIM>::TVDRK1Step(
-        d_patch_hierarchy,
+      advanceLevelSetEqnThroughStage(
+        PSI, TVD_RK1_STEP,
         d_psi_handles[0], 
         d_psi_handles[rk_stage], 
-        d_rhs_psi_handle, dt,
-        comp, comp, 0); // components of PatchData to use in TVD-RK1 step
+        -1, dt, comp);
 
     } // end codimension-two case
 
@@ -1195,6 +1269,10 @@ template <int DIM>
 void LevelSetFunctionIntegrator<DIM>::advanceLevelSetEqnUsingTVDRK2(
   const LSMLIB_REAL dt)
 {
+  LevelSetMethodScopedTimer timer(
+    LevelSetMethodStatistics::getStatistics()->getTimer(
+      "LevelSetFunctionIntegrator::advanceLevelSetEqnUsingTVDRK()"));
+
   // { begin Stage 1
 
   // initialize counter for current stage of TVD RK step
@@ -1205,35 +1283,23 @@ void LevelSetFunctionIntegrator<DIM>::advanceLevelSetEqnUsingTVDRK2(
   for (int comp = 0; comp < d_num_level_set_fcn_components; comp++) {
 
     // compute velocity field for current stage
-    d_lsm_velocity_field_strategy->computeVelocityField(
-      d_current_time, 
-      d_phi_handles[rk_stage],
-      d_psi_handles[rk_stage],
-      comp);
+    computeVelocityFieldForStage(d_current_time, rk_stage, comp);
 
     // advance phi through the first stage of TVD-RK2 
-    computeLevelSetEquationRHS(PHI,d_phi_handles[rk_stage],
-                               comp);
-    LevelSetMethodToolbox<DIM>::TVDRK2Stage1(
-      d_patch_hierarchy,
+    advanceLevelSetEqnThroughStage(
+      PHI, TVD_RK2_STAGE1,
       d_phi_handles[rk_stage+1],
       d_phi_handles[rk_stage],
-      d_rhs_phi_handle, dt,
-      comp, comp, 0); // components of PatchData to use in first 
-                      // stage TVD-RK2 step
+      -1, dt, comp);
 
     if (d_codimension == 2) {
 
       // advance psi through the first stage of TVD-RK2 
-      computeLevelSetEquationRHS(PSI,d_psi_handles[rk_stage],
-                                 comp);
-      LevelSetMethodToolbox<DIM>::TVDRK2Stage1(
-        d_patch_hierarchy,
+      advanceLevelSetEqnThroughStage(
+        PSI, TVD_RK2_STAGE1,
         d_psi_handles[rk_stage+1],
         d_psi_handles[rk_stage],
-        d_rhs_psi_handle, dt,
-        comp, comp, 0); // components of PatchData to use in first 
-                        // stage TVD-RK2 step
+        -1, dt, comp);
     }
   } // end loop over vector level set function
 
@@ -1246,13 +1312,8 @@ void LevelSetFunctionIntegrator<DIM>::advanceLevelSetEqnUsingTVDRK2(
   rk_stage = 1;
 
   // fill scratch space for second stage of time advance
-  const int num_levels = d_patch_hierarchy->getNumberLevels();
-  for ( int ln=0 ; ln < num_levels; ln++ ) {
-    // NOTE: true indicates that physical boundary conditions should
-    //       be set.
-    d_fill_bdry_sched_time_advance[rk_stage][ln]
-     ->fillData(d_current_time,true);
-  }
+  fillBoundaryData(d_fill_bdry_time_advance[rk_stage],
+                   d_fill_bdry_sched_time_advance[rk_stage], d_current_time);
   for (int comp = 0; comp < d_num_level_set_fcn_components; comp++) {
     d_bc_module->imposeBoundaryConditions(
       d_phi_handles[rk_stage],
@@ -1276,37 +1337,25 @@ void LevelSetFunctionIntegrator<DIM>::advanceLevelSetEqnUsingTVDRK2(
   for (int comp = 0; comp < d_num_level_set_fcn_components; comp++) {
 
     // compute velocity field for current stage
-    d_lsm_velocity_field_strategy->computeVelocityField(
-      d_current_time+dt, 
-      d_phi_handles[rk_stage],
-      d_psi_handles[rk_stage],
-      comp);
+    computeVelocityFieldForStage(d_current_time+dt, rk_stage, comp);
 
     // advance phi through the second stage of TVD-RK2 
-    computeLevelSetEquationRHS(PHI,d_phi_handles[rk_stage],
-                               comp);
-    LevelSetMethodToolbox<DIM>::TVDRK2Stage2(
-      d_patch_hierarchy,
+    advanceLevelSetEqnThroughStage(
+      PHI, TVD_RK2_STAGE2,
       d_phi_handles[0],
       d_phi_handles[rk_stage],
       d_phi_handles[0],
-      d_rhs_phi_handle, dt,
-      comp, comp, comp, 0); // components of PatchData to use in final 
-                            // stage of TVD-RK2 step
+      dt, comp);
 
     if (d_codimension == 2) {
 
       // advance psi through the second stage of TVD-RK2 
-      computeLevelSetEquationRHS(PSI,d_psi_handles[rk_stage],
-                                 comp);
-      LevelSetMethodToolbox<DIM>::TVDRK2Stage2(
-        d_patch_hierarchy,
+      advanceLevelSetEqnThroughStage(
+        PSI, TVD_RK2_STAGE2,
         d_psi_handles[0],
         d_psi_handles[rk_stage],
         d_psi_handles[0],
-        d_rhs_psi_handle, dt,
-        comp, comp, comp, 0); // components of PatchData to use in final 
-                              // stage of TVD-RK2 step
+        dt, comp);
     }
   } // end loop over components of vector level set function
 
@@ -1319,6 +1368,10 @@ template <int DIM>
 void LevelSetFunctionIntegrator<DIM>::advanceLevelSetEqnUsingTVDRK3(
   const LSMLIB_REAL dt)
 {
+  LevelSetMethodScopedTimer timer(
+    LevelSetMethodStatistics::getStatistics()->getTimer(
+      "LevelSetFunctionIntegrator::advanceLevelSetEqnUsingTVDRK()"));
+
   // { begin Stage 1
 
   // initialize counter for current stage of TVD RK step
@@ -1329,40 +1382,37 @@ void LevelSetFunctionIntegrator<DIM>::advanceLevelSetEqnUsingTVDRK3(
   for (int comp = 0; comp < d_num_level_set_fcn_components; comp++) {
 
     // compute velocity field for current stage
-    d_lsm_velocity_field_strategy->computeVelocityField(
-      d_current_time,
-      d_phi_handles[rk_stage],
-      d_psi_handles[rk_stage],
-      comp);
+    computeVelocityFieldForStage(d_current_time, rk_stage, comp);
 
     // advance phi through the first stage of TVD-RK3
-    computeLevelSetEquationRHS(PHI,d_phi_handles[rk_stage],
-                               comp);
-    LevelSetMethodToolbox<DIM>::TVDRK3Stage1(
-      d_patch_hierarchy,
+    advanceLevelSetEqnThroughStage(
+      PHI, TVD_RK3_STAGE1,
       d_phi_handles[rk_stage+1],
       d_phi_handles[rk_stage],
-      d_rhs_phi_handle, dt,
-      comp, comp, 0); // components of PatchData to use in first stage 
-                      // of TVD-RK3 step
+      -1, dt, comp);
 
     if (d_codimension == 2) {
   
       // advance psi through the first stage of TVD-RK3
-      computeLevelSetEquationRHS(PSI,d_psi_handles[rk_stage],
-                                 comp);
-      LevelSetMethodToolbox<DIM>::TVDRK3Stage1(
-        d_patch_hierarchy,
+      advanceLevelSetEqnThroughStage(
+        PSI, TVD_RK3_STAGE1,
         d_psi_handles[rk_stage+1],
         d_psi_handles[rk_stage],
-        d_rhs_psi_handle, dt,
-        comp, comp, 0); // components of PatchData to use in first stage 
-                        // of TVD-RK3 step
+        -1, dt, comp);
     }
   } // end loop over vector level set function
 
   // } end Stage 1
 
+  // PatchData handle index for the data used in the second and third
+  // stages.  In low-storage mode, the second stage overwrites the data 
+  // computed in the first stage.
+  const int stage_handle_idx = (d_use_low_storage_tvd_runge_kutta ? 1 : 2);
+  const TVD_RK_STAGE_TYPE stage2_type = (d_use_low_storage_tvd_runge_kutta ?
+    LOW_STORAGE_TVD_RK3_STAGE2 : TVD_RK3_STAGE2);
+  const TVD_RK_STAGE_TYPE stage3_type = (d_use_low_storage_tvd_runge_kutta ?
+    LOW_STORAGE_TVD_RK3_STAGE3 : TVD_RK3_STAGE3);
+
 
   // { begin Stage 2
 
@@ -1370,13 +1420,8 @@ void LevelSetFunctionIntegrator<DIM>::advanceLevelSetEqnUsingTVDRK3(
   rk_stage = 1;
 
   // fill scratch space for second stage of time advance
-  const int num_levels = d_patch_hierarchy->getNumberLevels();
-  for ( int ln=0 ; ln < num_levels; ln++ ) {
-    // NOTE: true indicates that physical boundary conditions should
-    //       be set.
-    d_fill_bdry_sched_time_advance[rk_stage][ln]
-     ->fillData(d_current_time,true);
-  }
+  fillBoundaryData(d_fill_bdry_time_advance[rk_stage],
+                   d_fill_bdry_sched_time_advance[rk_stage], d_current_time);
   for (int comp = 0; comp < d_num_level_set_fcn_components; comp++) {
     d_bc_module->imposeBoundaryConditions(
       d_phi_handles[rk_stage],
@@ -1400,37 +1445,25 @@ void LevelSetFunctionIntegrator<DIM>::advanceLevelSetEqnUsingTVDRK3(
   for (int comp = 0; comp < d_num_level_set_fcn_components; comp++) {
 
     // compute velocity field for current stage
-    d_lsm_velocity_field_strategy->computeVelocityField(
-      d_current_time+dt,
-      d_phi_handles[rk_stage],
-      d_psi_handles[rk_stage],
-      comp);
+    computeVelocityFieldForStage(d_current_time+dt, rk_stage, comp);
 
     // advance phi through the second stage of TVD-RK3
-    computeLevelSetEquationRHS(PHI,d_phi_handles[rk_stage],
-                               comp);
-    LevelSetMethodToolbox<DIM>::TVDRK3Stage2(
-      d_patch_hierarchy,
-      d_phi_handles[rk_stage+1],
+    advanceLevelSetEqnThroughStage(
+      PHI, stage2_type,
+      d_phi_handles[stage_handle_idx],
       d_phi_handles[rk_stage],
       d_phi_handles[rk_stage-1],
-      d_rhs_phi_handle, dt,
-      comp, comp, comp, 0); // components of PatchData to use in second 
-                            // stage of TVD-RK3 step
+      dt, comp);
 
     if (d_codimension == 2) {
 
       // advance psi through the second stage of TVD-RK3
-      computeLevelSetEquationRHS(PSI,d_psi_handles[rk_stage],
-                                 comp);
-      LevelSetMethodToolbox<DIM>::TVDRK3Stage2(
-        d_patch_hierarchy,
-        d_psi_handles[rk_stage+1],
+      advanceLevelSetEqnThroughStage(
+        PSI, stage2_type,
+        d_psi_handles[stage_handle_idx],
         d_psi_handles[rk_stage],
         d_psi_handles[rk_stage-1],
-        d_rhs_psi_handle, dt,
-        comp, comp, comp, 0); // components of PatchData to use in second 
-                              // stage of TVD-RK3 step
+        dt, comp);
     }
   } // end loop over vector level set function
 
@@ -1443,15 +1476,12 @@ void LevelSetFunctionIntegrator<DIM>::advanceLevelSetEqnUsingTVDRK3(
   rk_stage = 2;
 
   // fill scratch space for second stage of time advance
-  for ( int ln=0 ; ln < num_levels; ln++ ) {
-    // NOTE: true indicates that physical boundary conditions should
-    //       be set.
-    d_fill_bdry_sched_time_advance[rk_stage][ln]
-     ->fillData(d_current_time,true);
-  }
+  fillBoundaryData(d_fill_bdry_time_advance[stage_handle_idx],
+                   d_fill_bdry_sched_time_advance[stage_handle_idx],
+                   d_current_time);
   for (int comp = 0; comp < d_num_level_set_fcn_components; comp++) {
     d_bc_module->imposeBoundaryConditions(
-      d_phi_handles[rk_stage],
+      d_phi_handles[stage_handle_idx],
       d_lower_bc_phi[comp], 
       d_upper_bc_phi[comp], 
       d_spatial_derivative_type,
@@ -1459,7 +1489,7 @@ void LevelSetFunctionIntegrator<DIM>::advanceLevelSetEqnUsingTVDRK3(
       comp);
     if (d_codimension == 2) {
       d_bc_module->imposeBoundaryConditions(
-        d_psi_handles[rk_stage],
+        d_psi_handles[stage_handle_idx],
         d_lower_bc_psi[comp], 
         d_upper_bc_psi[comp], 
         d_spatial_derivative_type,
@@ -1472,37 +1502,25 @@ void LevelSetFunctionIntegrator<DIM>::advanceLevelSetEqnUsingTVDRK3(
   for (int comp = 0; comp < d_num_level_set_fcn_components; comp++) {
 
     // compute velocity field for current stage
-    d_lsm_velocity_field_strategy->computeVelocityField(
-      d_current_time+0.5*dt,
-      d_phi_handles[rk_stage],
-      d_psi_handles[rk_stage],
-      comp);
+    computeVelocityFieldForStage(d_current_time+0.5*dt, rk_stage, comp);
 
-    // advance phi through the second stage of TVD-RK3
-    computeLevelSetEquationRHS(PHI,d_phi_handles[rk_stage],
-                               comp);
-    LevelSetMethodToolbox<DIM>::TVDRK3Stage3(
-      d_patch_hierarchy,
+    // advance phi through the third stage of TVD-RK3
+    advanceLevelSetEqnThroughStage(
+      PHI, stage3_type,
       d_phi_handles[0],
-      d_phi_handles[rk_stage],
+      d_phi_handles[stage_handle_idx],
       d_phi_handles[0],
-      d_rhs_phi_handle, dt,
-      comp, comp, comp, 0); // components of PatchData to use in final 
-                            // stage of TVD-RK3 step
+      dt, comp);
 
     if (d_codimension == 2) {
   
-      // advance psi through the second stage of TVD-RK3
-      computeLevelSetEquationRHS(PSI,d_psi_handles[rk_stage],
-                                 comp);
-      LevelSetMethodToolbox<DIM>::TVDRK3Stage3(
-        d_patch_hierarchy,
+      // advance psi through the third stage of TVD-RK3
+      advanceLevelSetEqnThroughStage(
+        PSI, stage3_type,
         d_psi_handles[0],
-        d_psi_handles[rk_stage],
+        d_psi_handles[stage_handle_idx],
         d_psi_handles[0],
-        d_rhs_psi_handle, dt,
-        comp, comp, comp, 0); // components of PatchData to use in final 
-                              // stage of TVD-RK3 step
+        dt, comp);
     }
   } // end loop over vector level set function
   
@@ -1510,102 +1528,473 @@ void LevelSetFunctionIntegrator<DIM>::advanceLevelSetEqnUsingTVDRK3(
 }
 
 
-/* computeLevelSetEquationRHS() first zeros out the RHS and then
- * calls addAdvectionTermToLevelSetEquationRHS() and 
- * addNormalVelocityTermToLevelSetEquationRHS() as appropriate.
+/* computeVelocityFieldForStage() */
+template <int DIM> 
+void LevelSetFunctionIntegrator<DIM>::computeVelocityFieldForStage(
+  const LSMLIB_REAL time,
+  const int rk_stage,
+  const int component)
+{
+  const bool batched = d_lsm_velocity_field_strategy->
+    providesBatchedVelocityFieldComputation();
+
+  // a stage-invariant velocity field computed in the first stage can
+  // be reused as long as the fields for different components are not
+  // stored in the same PatchData
+  if ( (rk_stage > 0) &&
+       d_lsm_velocity_field_strategy->velocityFieldIsStageInvariant() &&
+       (batched || (d_num_level_set_fcn_components == 1)) ) {
+    return;
+  }
+
+  // in low-storage mode, the last stages share a single PatchData
+  const int handle_idx = (rk_stage < d_num_tvd_runge_kutta_handles) ?
+    rk_stage : d_num_tvd_runge_kutta_handles-1;
+
+  if (batched) {
+
+    // the velocity field for all components is computed together
+    if (component > 0) return;
+
+    d_lsm_velocity_field_strategy->computeVelocityFieldForAllComponents(
+      time,
+      d_phi_handles[handle_idx],
+      d_psi_handles[handle_idx],
+      d_num_level_set_fcn_components);
+
+  } else {
+
+    d_lsm_velocity_field_strategy->computeVelocityField(
+      time,
+      d_phi_handles[handle_idx],
+      d_psi_handles[handle_idx],
+      component);
+
+  }
+
+  LevelSetMethodStatistics::getStatistics()->incrementCounter(
+    "LevelSetFunctionIntegrator::velocity field computations");
+}
+
+
+/* advanceLevelSetEqnThroughStage() computes the spatial derivatives 
+ * required by the velocity fields (forward and backward derivatives
+ * when there is a normal velocity, upwind derivatives otherwise), 
+ * assembles the RHS and takes the TVD Runge-Kutta stage in a single 
+ * pass over each patch.
  */
 template <int DIM> 
-void LevelSetFunctionIntegrator<DIM>::computeLevelSetEquationRHS(
+void LevelSetFunctionIntegrator<DIM>::advanceLevelSetEqnThroughStage(
   const LEVEL_SET_FCN_TYPE level_set_fcn,
+  const TVD_RK_STAGE_TYPE stage_type,
+  const int phi_next_handle,
   const int phi_handle,
+  const int phi_cur_handle,
+  const LSMLIB_REAL dt,
   const int component)
 {
+  LevelSetMethodScopedTimer timer(d_timer_compute_rhs);
+
+  LevelSetMethodStatistics* stats = LevelSetMethodStatistics::getStatistics();
+  stats->incrementCounter(
+    "LevelSetFunctionIntegrator::RHS evaluations");
+  stats->incrementCounter(
+    "LevelSetFunctionIntegrator::cells updated", d_num_local_cells);
+
+  int grad_phi_upwind_handle;
+  int grad_phi_plus_handle;
+  int grad_phi_minus_handle;
   int rhs_handle;
   if (level_set_fcn == PHI) {
+    grad_phi_upwind_handle = d_grad_phi_upwind_handle;
+    grad_phi_plus_handle = d_grad_phi_plus_handle;
+    grad_phi_minus_handle = d_grad_phi_minus_handle;
     rhs_handle = d_rhs_phi_handle;
   } else {
+    grad_phi_upwind_handle = d_grad_psi_upwind_handle;
+    grad_phi_plus_handle = d_grad_psi_plus_handle;
+    grad_phi_minus_handle = d_grad_psi_minus_handle;
     rhs_handle = d_rhs_psi_handle;
   } 
 
-  // loop over PatchHierarchy and zero out the RHS for level set 
-  // equation by calling Fortran routines
+  int velocity_handle = -1;
+  if (d_lsm_velocity_field_strategy->providesExternalVelocityField()) {
+    velocity_handle = d_lsm_velocity_field_strategy->
+      getExternalVelocityFieldPatchDataHandle(component);
+  }
+  int normal_velocity_handle = -1;
+  if (d_lsm_velocity_field_strategy->providesNormalVelocityField()) {
+    normal_velocity_handle = d_lsm_velocity_field_strategy->
+      getNormalVelocityFieldPatchDataHandle(level_set_fcn, component);
+  }
+  const bool need_spatial_derivatives = 
+    (velocity_handle >= 0) || (normal_velocity_handle >= 0);
+
+  // loop over PatchHierarchy and advance the level set function by 
+  // calling Fortran routines
   const int num_levels = d_patch_hierarchy->getNumberLevels();
   for ( int ln=0 ; ln < num_levels; ln++ ) {
 
     Pointer< PatchLevel<DIM> > level = d_patch_hierarchy->getPatchLevel(ln);
+
+    if (need_spatial_derivatives) {
+      LevelSetMethodToolbox<DIM>::allocateSpatialDerivativesScratchData(
+        level, d_spatial_derivative_type, d_spatial_derivative_order);
+    }
     
-    typename PatchLevel<DIM>::Iterator pi;
-    for (pi.initialize(level); pi; pi++) { // loop over patches
-      const int pn = *pi;
+    // patches are independent, so they may be processed concurrently
+    vector<int> patch_numbers;
+    LevelSetMethodToolbox<DIM>::getPatchNumbers(level, patch_numbers);
+    const int num_patches = patch_numbers.size();
+#ifdef _OPENMP
+#pragma omp parallel for schedule(dynamic)
+#endif
+    for (int p = 0; p < num_patches; p++) { // loop over patches
+      const int pn = patch_numbers[p];
       Pointer< Patch<DIM> > patch = level->getPatch(pn);
       if ( patch.isNull() ) {
         TBOX_ERROR(  d_object_name 
-                  << "::computeLevelSetEquationRHS(): "
+                  << "::advanceLevelSetEqnThroughStage(): "
                   << "Cannot find patch. Null patch pointer."
                   << endl);
       }
 
-      // get pointers to data and index space ranges
-      Pointer< CellData<DIM,LSMLIB_REAL> > rhs_data =
-        patch->getPatchData( rhs_handle );
-  
-      Box<DIM> rhs_ghostbox = rhs_data->getGhostBox();
-      const IntVector<DIM> rhs_ghostbox_lower = rhs_ghostbox.lower();
-      const IntVector<DIM> rhs_ghostbox_upper = rhs_ghostbox.upper();
-
-      LSMLIB_REAL* rhs = rhs_data->getPointer();
+      // compute the RHS 
+      if (normal_velocity_handle >= 0) {
+
+        // the forward and backward derivatives are needed for the 
+        // normal velocity term and also serve as the upwind candidates 
+        // for the advection term, so the upwind derivatives are not 
+        // computed
+        LevelSetMethodToolbox<DIM>::
+          computePlusAndMinusSpatialDerivativesOnPatch(
+            patch,
+            d_spatial_derivative_type,
+            d_spatial_derivative_order,
+            grad_phi_plus_handle,
+            grad_phi_minus_handle,
+            phi_handle,
+            component); 
+
+        computeLevelSetEquationRHSOnPatch(
+          patch, rhs_handle, grad_phi_plus_handle, grad_phi_minus_handle,
+          velocity_handle, normal_velocity_handle);
+
+      } else if (velocity_handle >= 0) {
+
+        // the upwind derivatives are selected by the same rule used in 
+        // the RHS kernel, so they may be passed as both the forward and 
+        // the backward derivatives
+        LevelSetMethodToolbox<DIM>::computeUpwindSpatialDerivativesOnPatch(
+          patch,
+          d_spatial_derivative_type,
+          d_spatial_derivative_order,
+          grad_phi_upwind_handle,
+          phi_handle,
+          velocity_handle,
+          component); 
 
-      // zero out level set equation RHS
-      if (DIM == 3) {
+        computeLevelSetEquationRHSOnPatch(
+          patch, rhs_handle, grad_phi_upwind_handle, grad_phi_upwind_handle,
+          velocity_handle, -1);
 
-        LSM3D_ZERO_OUT_LEVEL_SET_EQN_RHS(
-          rhs,
-          &rhs_ghostbox_lower[0],
-          &rhs_ghostbox_upper[0],
-          &rhs_ghostbox_lower[1],
-          &rhs_ghostbox_upper[1],
-          &rhs_ghostbox_lower[2],
-          &rhs_ghostbox_upper[2]);
+      } else {
 
-      } else if (DIM == 2) {
+        // no velocity field, so the RHS is zero
+        computeLevelSetEquationRHSOnPatch(
+          patch, rhs_handle, -1, -1, -1, -1);
 
-        LSM2D_ZERO_OUT_LEVEL_SET_EQN_RHS(
-          rhs,
-          &rhs_ghostbox_lower[0],
-          &rhs_ghostbox_upper[0],
-          &rhs_ghostbox_lower[1],
-          &rhs_ghostbox_upper[1]);
+      }
 
-      } else if (DIM == 1) {
+      // take the TVD Runge-Kutta stage while the RHS for the patch 
+      // is still in cache
+      switch (stage_type) {
+        case NO_TVD_RK_STAGE: {
+          break;
+        }
+        case TVD_RK1_STEP: {
+          LevelSetMethodToolbox<DIM>::TVDRK1StepOnPatch(
+            patch, phi_next_handle, phi_handle, rhs_handle, dt,
+            component, component, 0);
+          break;
+        }
+        case TVD_RK2_STAGE1: {
+          LevelSetMethodToolbox<DIM>::TVDRK2Stage1OnPatch(
+            patch, phi_next_handle, phi_handle, rhs_handle, dt,
+            component, component, 0);
+          break;
+        }
+        case TVD_RK2_STAGE2: {
+          LevelSetMethodToolbox<DIM>::TVDRK2Stage2OnPatch(
+            patch, phi_next_handle, phi_handle, phi_cur_handle, 
+            rhs_handle, dt,
+            component, component, component, 0);
+          break;
+        }
+        case TVD_RK3_STAGE1: {
+          LevelSetMethodToolbox<DIM>::TVDRK3Stage1OnPatch(
+            patch, phi_next_handle, phi_handle, rhs_handle, dt,
+            component, component, 0);
+          break;
+        }
+        case TVD_RK3_STAGE2: {
+          LevelSetMethodToolbox<DIM>::TVDRK3Stage2OnPatch(
+            patch, phi_next_handle, phi_handle, phi_cur_handle, 
+            rhs_handle, dt,
+            component, component, component, 0);
+          break;
+        }
+        case TVD_RK3_STAGE3: {
+          LevelSetMethodToolbox<DIM>::TVDRK3Stage3OnPatch(
+            patch, phi_next_handle, phi_handle, phi_cur_handle, 
+            rhs_handle, dt,
+            component, component, component, 0);
+          break;
+        }
+        case LOW_STORAGE_TVD_RK3_STAGE2: {
+          // phi_next_handle is the same as phi_handle
+          LevelSetMethodToolbox<DIM>::LowStorageTVDRK3Stage2OnPatch(
+            patch, phi_next_handle, phi_cur_handle, rhs_handle, dt,
+            component, component, 0);
+          break;
+        }
+        case LOW_STORAGE_TVD_RK3_STAGE3: {
+          // phi_next_handle is the same as phi_cur_handle
+          LevelSetMethodToolbox<DIM>::LowStorageTVDRK3Stage3OnPatch(
+            patch, phi_next_handle, phi_handle, rhs_handle, dt,
+            component, component, 0);
+          break;
+        }
+        default: {
+          TBOX_ERROR(  d_object_name 
+                    << "::advanceLevelSetEqnThroughStage(): "
+                    << "Invalid TVD Runge-Kutta stage."
+                    << endl);
+        }
+      } // end switch over TVD Runge-Kutta stage
 
-        LSM1D_ZERO_OUT_LEVEL_SET_EQN_RHS(
-          rhs,
-          &rhs_ghostbox_lower[0],
-          &rhs_ghostbox_upper[0]);
+    } // end loop over patches in level
 
-      } else {  // Unsupported dimension
-        TBOX_ERROR(  d_object_name 
-                  << "::computeLevelSetEquationRHS(): "
-                  << "Invalid value of DIM.  "
-                  << "Only DIM = 1, 2, and 3 are supported."
-                  << endl);
-      } // end switch over dimension (DIM) of calculation
+    if (need_spatial_derivatives) {
+      LevelSetMethodToolbox<DIM>::deallocateSpatialDerivativesScratchData(
+        level, d_spatial_derivative_type, d_spatial_derivative_order);
+    }
 
-    } // end loop over patches in level
   } // end loop over levels in hierarchy
+}
 
-  // invoke addAdvectionTermToLevelSetEquationRHS() if necessary
-  if (d_lsm_velocity_field_strategy->providesExternalVelocityField()) {
-    addAdvectionTermToLevelSetEquationRHS(level_set_fcn, phi_handle,
-                                          component);
+
+/* computeLevelSetEquationRHS() */
+template <int DIM> 
+void LevelSetFunctionIntegrator<DIM>::computeLevelSetEquationRHS(
+  const LEVEL_SET_FCN_TYPE level_set_fcn,
+  const int phi_handle,
+  const int component)
+{
+  advanceLevelSetEqnThroughStage(
+    level_set_fcn, NO_TVD_RK_STAGE, -1, phi_handle, -1, 0.0, component);
+}
+
+
+/* computeLevelSetEquationRHSOnPatch() */
+template <int DIM> 
+void LevelSetFunctionIntegrator<DIM>::computeLevelSetEquationRHSOnPatch(
+  Pointer< Patch<DIM> > patch,
+  const int rhs_handle,
+  const int grad_phi_plus_handle,
+  const int grad_phi_minus_handle,
+  const int velocity_handle,
+  const int normal_velocity_handle)
+{
+  const int use_external_vel = (velocity_handle >= 0) ? 1 : 0;
+  const int use_normal_vel = (normal_velocity_handle >= 0) ? 1 : 0;
+
+  // get pointers to data and index space ranges
+  Pointer< CellData<DIM,LSMLIB_REAL> > rhs_data =
+    patch->getPatchData( rhs_handle );
+  
+  Box<DIM> rhs_ghostbox = rhs_data->getGhostBox();
+  const IntVector<DIM> rhs_ghostbox_lower = rhs_ghostbox.lower();
+  const IntVector<DIM> rhs_ghostbox_upper = rhs_ghostbox.upper();
+
+  // fill box
+  Box<DIM> fillbox = rhs_data->getBox();
+  const IntVector<DIM> fillbox_lower = fillbox.lower();
+  const IntVector<DIM> fillbox_upper = fillbox.upper();
+
+  LSMLIB_REAL* rhs = rhs_data->getPointer();
+
+  // data that is not used by the Fortran subroutine is replaced 
+  // by the RHS data (which is never accessed through these 
+  // arguments)
+  Box<DIM> grad_phi_plus_ghostbox = rhs_ghostbox;
+  Box<DIM> grad_phi_minus_ghostbox = rhs_ghostbox;
+  Box<DIM> vel_ghostbox = rhs_ghostbox;
+  Box<DIM> vel_n_ghostbox = rhs_ghostbox;
+  LSMLIB_REAL* grad_phi_plus[LSM_DIM_MAX];
+  LSMLIB_REAL* grad_phi_minus[LSM_DIM_MAX];
+  LSMLIB_REAL* vel[LSM_DIM_MAX];
+  LSMLIB_REAL* vel_n = rhs;
+  for (int dim = 0; dim < DIM; dim++) {
+    grad_phi_plus[dim] = rhs;
+    grad_phi_minus[dim] = rhs;
+    vel[dim] = rhs;
   }
 
-  // invoke addNormalVelocityTermToLevelSetEquationRHS() if necessary
-  if (d_lsm_velocity_field_strategy->providesNormalVelocityField()) {
-    addNormalVelocityTermToLevelSetEquationRHS(level_set_fcn, phi_handle,
-                                               component);
+  if (use_external_vel || use_normal_vel) {
+    Pointer< CellData<DIM,LSMLIB_REAL> > grad_phi_plus_data =
+      patch->getPatchData( grad_phi_plus_handle );
+    Pointer< CellData<DIM,LSMLIB_REAL> > grad_phi_minus_data =
+      patch->getPatchData( grad_phi_minus_handle );
+    grad_phi_plus_ghostbox = grad_phi_plus_data->getGhostBox();
+    grad_phi_minus_ghostbox = grad_phi_minus_data->getGhostBox();
+    for (int dim = 0; dim < DIM; dim++) {
+      grad_phi_plus[dim] = grad_phi_plus_data->getPointer(dim);
+      grad_phi_minus[dim] = grad_phi_minus_data->getPointer(dim);
+    }
+  }
+
+  if (use_external_vel) {
+    Pointer< CellData<DIM,LSMLIB_REAL> > velocity_data =
+      patch->getPatchData( velocity_handle );
+    vel_ghostbox = velocity_data->getGhostBox();
+    for (int dim = 0; dim < DIM; dim++) {
+      vel[dim] = velocity_data->getPointer(dim);
+    }
   }
 
+  if (use_normal_vel) {
+    Pointer< CellData<DIM,LSMLIB_REAL> > normal_velocity_data =
+      patch->getPatchData( normal_velocity_handle );
+    vel_n_ghostbox = normal_velocity_data->getGhostBox();
+    vel_n = normal_velocity_data->getPointer();
+  }
+
+  const IntVector<DIM> grad_phi_plus_ghostbox_lower = 
+    grad_phi_plus_ghostbox.lower();
+  const IntVector<DIM> grad_phi_plus_ghostbox_upper = 
+    grad_phi_plus_ghostbox.upper();
+  const IntVector<DIM> grad_phi_minus_ghostbox_lower = 
+    grad_phi_minus_ghostbox.lower();
+  const IntVector<DIM> grad_phi_minus_ghostbox_upper = 
+    grad_phi_minus_ghostbox.upper();
+  const IntVector<DIM> vel_ghostbox_lower = vel_ghostbox.lower();
+  const IntVector<DIM> vel_ghostbox_upper = vel_ghostbox.upper();
+  const IntVector<DIM> vel_n_ghostbox_lower = vel_n_ghostbox.lower();
+  const IntVector<DIM> vel_n_ghostbox_upper = vel_n_ghostbox.upper();
+
+  if (DIM == 3) {
+
+    LSM3D_COMPUTE_ADVECTION_AND_NORMAL_VEL_LSE_RHS(
+      rhs,
+      &rhs_ghostbox_lower[0],
+      &rhs_ghostbox_upper[0],
+      &rhs_ghostbox_lower[1],
+      &rhs_ghostbox_upper[1],
+      &rhs_ghostbox_lower[2],
+      &rhs_ghostbox_upper[2],
+      grad_phi_plus[0], grad_phi_plus[1], grad_phi_plus[2],
+      &grad_phi_plus_ghostbox_lower[0],
+      &grad_phi_plus_ghostbox_upper[0],
+      &grad_phi_plus_ghostbox_lower[1],
+      &grad_phi_plus_ghostbox_upper[1],
+      &grad_phi_plus_ghostbox_lower[2],
+      &grad_phi_plus_ghostbox_upper[2],
+      grad_phi_minus[0], grad_phi_minus[1], grad_phi_minus[2],
+      &grad_phi_minus_ghostbox_lower[0],
+      &grad_phi_minus_ghostbox_upper[0],
+      &grad_phi_minus_ghostbox_lower[1],
+      &grad_phi_minus_ghostbox_upper[1],
+      &grad_phi_minus_ghostbox_lower[2],
+      &grad_phi_minus_ghostbox_upper[2],
+      vel[0], vel[1], vel[2],
+      &vel_ghostbox_lower[0],
+      &vel_ghostbox_upper[0],
+      &vel_ghostbox_lower[1],
+      &vel_ghostbox_upper[1],
+      &vel_ghostbox_lower[2],
+      &vel_ghostbox_upper[2],
+      vel_n,
+      &vel_n_ghostbox_lower[0],
+      &vel_n_ghostbox_upper[0],
+      &vel_n_ghostbox_lower[1],
+      &vel_n_ghostbox_upper[1],
+      &vel_n_ghostbox_lower[2],
+      &vel_n_ghostbox_upper[2],
+      &fillbox_lower[0],
+      &fillbox_upper[0],
+      &fillbox_lower[1],
+      &fillbox_upper[1],
+      &fillbox_lower[2],
+      &fillbox_upper[2],
+      &use_external_vel,
+      &use_normal_vel);
+
+  } else if (DIM == 2) {
+
+    LSM2D_COMPUTE_ADVECTION_AND_NORMAL_VEL_LSE_RHS(
+      rhs,
+      &rhs_ghostbox_lower[0],
+      &rhs_ghostbox_upper[0],
+      &rhs_ghostbox_lower[1],
+      &rhs_ghostbox_upper[1],
+      grad_phi_plus[0], grad_phi_plus[1],
+      &grad_phi_plus_ghostbox_lower[0],
+      &grad_phi_plus_ghostbox_upper[0],
+      &grad_phi_plus_ghostbox_lower[1],
+      &grad_phi_plus_ghostbox_upper[1],
+      grad_phi_minus[0], grad_phi_minus[1],
+      &grad_phi_minus_ghostbox_lower[0],
+      &grad_phi_minus_ghostbox_upper[0],
+      &grad_phi_minus_ghostbox_lower[1],
+      &grad_phi_minus_ghostbox_upper[1],
+      vel[0], vel[1],
+      &vel_ghostbox_lower[0],
+      &vel_ghostbox_upper[0],
+      &vel_ghostbox_lower[1],
+      &vel_ghostbox_upper[1],
+      vel_n,
+      &vel_n_ghostbox_lower[0],
+      &vel_n_ghostbox_upper[0],
+      &vel_n_ghostbox_lower[1],
+      &vel_n_ghostbox_upper[1],
+      &fillbox_lower[0],
+      &fillbox_upper[0],
+      &fillbox_lower[1],
+      &fillbox_upper[1],
+      &use_external_vel,
+      &use_normal_vel);
+
+  } else if (DIM == 1) {
+
+    LSM1D_COMPUTE_ADVECTION_AND_NORMAL_VEL_LSE_RHS(
+      rhs,
+      &rhs_ghostbox_lower[0],
+      &rhs_ghostbox_upper[0],
+      grad_phi_plus[0], 
+      &grad_phi_plus_ghostbox_lower[0],
+      &grad_phi_plus_ghostbox_upper[0],
+      grad_phi_minus[0], 
+      &grad_phi_minus_ghostbox_lower[0],
+      &grad_phi_minus_ghostbox_upper[0],
+      vel[0], 
+      &vel_ghostbox_lower[0],
+      &vel_ghostbox_upper[0],
+      vel_n,
+      &vel_n_ghostbox_lower[0],
+      &vel_n_ghostbox_upper[0],
+      &fillbox_lower[0],
+      &fillbox_upper[0],
+      &use_external_vel,
+      &use_normal_vel);
+
+  } else {  // Unsupported dimension
+    TBOX_ERROR(  d_object_name 
+              << "::computeLevelSetEquationRHSOnPatch(): "
+              << "Invalid value of DIM.  "
+              << "Only DIM = 1, 2, and 3 are supported."
+              << endl);
+  } // end switch over dimension (DIM) of calculation
 }
 
 
@@ -1646,9 +2035,15 @@ void LevelSetFunctionIntegrator<DIM>::addAdvectionTermToLevelSetEquationRHS(
 
     Pointer< PatchLevel<DIM> > level = d_patch_hierarchy->getPatchLevel(ln);
     
-    typename PatchLevel<DIM>::Iterator pi;
-    for (pi.initialize(level); pi; pi++) { // loop over patches
-      const int pn = *pi;
+    // patches are independent, so they may be processed concurrently
+    vector<int> patch_numbers;
+    LevelSetMethodToolbox<DIM>::getPatchNumbers(level, patch_numbers);
+    const int num_patches = patch_numbers.size();
+#ifdef _OPENMP
+#pragma omp parallel for schedule(dynamic)
+#endif
+    for (int p = 0; p < num_patches; p++) { // loop over patches
+      const int pn = patch_numbers[p];
       Pointer< Patch<DIM> > patch = level->getPatch(pn);
       if ( patch.isNull() ) {
         TBOX_ERROR(  d_object_name 
@@ -1814,9 +2209,15 @@ void LevelSetFunctionIntegrator<DIM>::addNormalVelocityTermToLevelSetEquationRHS
 
     Pointer< PatchLevel<DIM> > level = d_patch_hierarchy->getPatchLevel(ln);
     
-    typename PatchLevel<DIM>::Iterator pi;
-    for (pi.initialize(level); pi; pi++) { // loop over patches
-      const int pn = *pi;
+    // patches are independent, so they may be processed concurrently
+    vector<int> patch_numbers;
+    LevelSetMethodToolbox<DIM>::getPatchNumbers(level, patch_numbers);
+    const int num_patches = patch_numbers.size();
+#ifdef _OPENMP
+#pragma omp parallel for schedule(dynamic)
+#endif
+    for (int p = 0; p < num_patches; p++) { // loop over patches
+      const int pn = patch_numbers[p];
       Pointer< Patch<DIM> > patch = level->getPatch(pn);
       if ( patch.isNull() ) {
         TBOX_ERROR(  d_object_name 
@@ -1972,6 +2373,10 @@ void LevelSetFunctionIntegrator<DIM>::reinitializeLevelSetFunctions(
   const LEVEL_SET_FCN_TYPE level_set_fcn,
   const int max_iterations)
 {
+  LevelSetMethodScopedTimer timer(d_timer_reinitialization);
+  LevelSetMethodStatistics::getStatistics()->incrementCounter(
+    "LevelSetFunctionIntegrator::reinitializations");
+
   if (level_set_fcn == PHI) {
     for (int comp=0; comp < d_num_level_set_fcn_components; comp++) {
       d_phi_reinitialization_alg->
@@ -2001,6 +2406,10 @@ void LevelSetFunctionIntegrator<DIM>::orthogonalizeLevelSetFunctions(
   const int max_reinit_iterations,
   const int max_ortho_iterations)
 {
+  LevelSetMethodScopedTimer timer(d_timer_orthogonalization);
+  LevelSetMethodStatistics::getStatistics()->incrementCounter(
+    "LevelSetFunctionIntegrator::orthogonalizations");
+
   if (level_set_fcn == PHI) {
     reinitializeLevelSetFunctions(PSI, max_reinit_iterations);
     for (int comp=0; comp < d_num_level_set_fcn_components; comp++) {
@@ -2097,7 +2506,7 @@ void LevelSetFunctionIntegrator<DIM>::initializeVariables()
   }
  
   // reserve memory for scratch variable PatchData Handles
-  d_phi_handles.reserve(d_tvd_runge_kutta_order);
+  d_phi_handles.reserve(d_num_tvd_runge_kutta_handles);
 
   // phi - "CURRENT" context for time advance
   d_phi_handles[0] = var_db->registerVariableAndContext(
@@ -2105,7 +2514,7 @@ void LevelSetFunctionIntegrator<DIM>::initializeVariables()
   d_solution_variables.setFlag(d_phi_handles[0]);
 
   // phi - "SCRATCH" context for time advance
-  for (int k=1; k < d_tvd_runge_kutta_order; k++) {
+  for (int k=1; k < d_num_tvd_runge_kutta_handles; k++) {
     stringstream context_name("");
     context_name << "TVD_RK_SCRATCH_" << k;
     d_phi_handles[k] = var_db->registerVariableAndContext(
@@ -2155,7 +2564,7 @@ void LevelSetFunctionIntegrator<DIM>::initializeVariables()
    * Initialize psi variables for codimension-two problems
    */
   // reserve memory for scratch variable PatchData Handles
-  d_psi_handles.reserve(d_tvd_runge_kutta_order);
+  d_psi_handles.reserve(d_num_tvd_runge_kutta_handles);
 
   if (d_codimension == 2) {
 
@@ -2181,7 +2590,7 @@ void LevelSetFunctionIntegrator<DIM>::initializeVariables()
     d_solution_variables.setFlag(d_psi_handles[0]);
 
     // psi - "SCRATCH" context for time advance
-    for (int k=1; k < d_tvd_runge_kutta_order; k++) {
+    for (int k=1; k < d_num_tvd_runge_kutta_handles; k++) {
       stringstream context_name("");
       context_name << "TVD_RK_SCRATCH_" << k;
       d_psi_handles[k] = var_db->registerVariableAndContext(
@@ -2228,7 +2637,7 @@ void LevelSetFunctionIntegrator<DIM>::initializeVariables()
 
   } else { // set PatchData handles for filling psi scratch data to -1 
            // (a bogus value)
-    for (int k=0; k < d_tvd_runge_kutta_order; k++) 
+    for (int k=0; k < d_num_tvd_runge_kutta_handles; k++) 
       d_psi_handles[k] = -1;
   }
 
@@ -2298,10 +2707,10 @@ void LevelSetFunctionIntegrator<DIM>::initializeCommunicationObjects()
 
   // set up objects for filling boundary data during the 
   // time advance of the level set functions
-  d_fill_bdry_time_advance.resizeArray(d_tvd_runge_kutta_order);
-  d_fill_bdry_sched_time_advance.resizeArray(d_tvd_runge_kutta_order);
+  d_fill_bdry_time_advance.resizeArray(d_num_tvd_runge_kutta_handles);
+  d_fill_bdry_sched_time_advance.resizeArray(d_num_tvd_runge_kutta_handles);
 
-  for (int k = 0; k < d_tvd_runge_kutta_order; k++) {
+  for (int k = 0; k < d_num_tvd_runge_kutta_handles; k++) {
     d_fill_bdry_time_advance[k] = new RefineAlgorithm<DIM>;
 
     // empty out the boundary bdry fill schedules 
@@ -2498,6 +2907,9 @@ void LevelSetFunctionIntegrator<DIM>::getFromInput(
     }
     d_tvd_runge_kutta_order = db->getIntegerWithDefault(
       "tvd_runge_kutta_order", LSM_DEFAULT_TVD_RUNGE_KUTTA_ORDER);
+    d_use_low_storage_tvd_runge_kutta = db->getBoolWithDefault(
+      "use_low_storage_tvd_runge_kutta", 
+      LSM_DEFAULT_USE_LOW_STORAGE_TVD_RUNGE_KUTTA);
 
     // check that spatial derivative type, spatial derivative order,
     // and TVD Runge-Kutta order are valid.
@@ -2629,6 +3041,10 @@ void LevelSetFunctionIntegrator<DIM>::getFromRestart()
     (SPATIAL_DERIVATIVE_TYPE) db->getInteger("d_spatial_derivative_type");
   d_spatial_derivative_order = db->getInteger("d_spatial_derivative_order");
   d_tvd_runge_kutta_order = db->getInteger("d_tvd_runge_kutta_order");
+  // NOTE: restart files written before the low-storage TVD Runge-Kutta
+  //       option was added do not contain d_use_low_storage_tvd_runge_kutta
+  d_use_low_storage_tvd_runge_kutta = 
+    db->getBoolWithDefault("d_use_low_storage_tvd_runge_kutta", false);
 
   d_reinitialization_interval = db->getInteger("d_reinitialization_interval");
   d_reinitialization_stop_tol = db->getDouble("d_reinitialization_stop_tol");
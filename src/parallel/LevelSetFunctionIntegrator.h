@@ -56,6 +56,12 @@
  * - spatial_derivative_order    = order of spatial derivative (default = 5)
  * - tvd_runge_kutta_order       = order of Runge-Kutta time integration 
  *                                 (default = 3)
+ * - use_low_storage_tvd_runge_kutta
+ *                               = TRUE if the third-order TVD Runge-Kutta
+ *                                 method should overwrite the stage data
+ *                                 in place so that only two PatchData
+ *                                 are required for each level set
+ *                                 function (default = FALSE)
  * - reinitialization_interval   = interval between reinitialization 
  *                                 (default = 10)
  *                                 (reinitialization disabled if <= 0)
@@ -201,6 +207,15 @@
  *    problems) process uses the same order TVD Runge-Kutta as specified
  *    for the time evolution of the level set equation(s).
  *
+ *  - When use_low_storage_tvd_runge_kutta is TRUE, the second stage
+ *    of TVD-RK3 overwrites the first stage data one component at a
+ *    time.  As a result, velocity fields for vector level set
+ *    functions that are computed one component at a time (i.e. not
+ *    by computeVelocityFieldForAllComponents()) see the updated
+ *    values of the lower-numbered components during the second
+ *    stage.  The option has no effect for TVD-RK1 and TVD-RK2,
+ *    which already use at most two PatchData.
+ *
  *  - This class takes care of making sure that the scratch spaces
  *    for the level set functions have sufficient ghost cells to 
  *    carry out the spatial derivative calculations.
@@ -265,6 +280,7 @@
 #include "tbox/Database.h"
 #include "tbox/Pointer.h"
 #include "tbox/Serializable.h"
+#include "tbox/Timer.h"
 
 #include "LSMLIB_config.h"
 #include "BoundaryConditionModule.h"
@@ -1178,6 +1194,24 @@ public:
 
 protected:
 
+  /*! \enum TVD_RK_STAGE_TYPE
+   *
+   * Enumerated type for the TVD Runge-Kutta stages that may be taken
+   * by advanceLevelSetEqnThroughStage().  NO_TVD_RK_STAGE only 
+   * computes the RHS of the level set equation.
+   *
+   */
+  typedef enum {
+    NO_TVD_RK_STAGE            = 0,
+    TVD_RK1_STEP               = 1,
+    TVD_RK2_STAGE1             = 2,
+    TVD_RK2_STAGE2             = 3,
+    TVD_RK3_STAGE1             = 4,
+    TVD_RK3_STAGE2             = 5,
+    TVD_RK3_STAGE3             = 6,
+    LOW_STORAGE_TVD_RK3_STAGE2 = 7,
+    LOW_STORAGE_TVD_RK3_STAGE3 = 8} TVD_RK_STAGE_TYPE;
+
   //! @{
   /*!
    ****************************************************************
@@ -1204,6 +1238,89 @@ protected:
   virtual void advanceLevelSetEqnUsingTVDRK3(
     const LSMLIB_REAL dt);
 
+  /*!
+   * computeVelocityFieldForStage() computes the velocity field for
+   * the specified component at the specified stage of a TVD 
+   * Runge-Kutta step by calling the velocity field strategy.
+   *
+   * Arguments:     
+   *  - time (in):       time at which to compute the velocity field
+   *  - rk_stage (in):   stage of TVD Runge-Kutta step (begins at 0)
+   *  - component (in):  component of level set function for which
+   *                     the velocity field is required
+   *
+   * Return value:       none
+   *
+   * NOTES:
+   *  - If the velocity field strategy provides batched velocity field
+   *    computation, the velocity field for all components is computed
+   *    with a single call to computeVelocityFieldForAllComponents()
+   *    when component is 0, and nothing is done for the other 
+   *    components.
+   *  - If the velocity field strategy declares the velocity field to
+   *    be stage-invariant, the velocity field is only computed in the
+   *    first stage of a time step (unless there are multiple 
+   *    components and batched computation is not provided, in which 
+   *    case the velocity fields for different components may share 
+   *    the same PatchData).
+   *
+   */
+  virtual void computeVelocityFieldForStage(
+    const LSMLIB_REAL time,
+    const int rk_stage,
+    const int component);
+
+  /*!
+   * advanceLevelSetEqnThroughStage() computes the RHS of the level set
+   * equation when it is written in the form:
+   *
+   *   phi_t = - velocity dot grad(phi) - vel_n |grad(phi)|
+   *
+   * and takes the specified stage of a TVD Runge-Kutta step.  The 
+   * spatial derivatives, the RHS and the stage are computed in a 
+   * single loop over the patches of each PatchLevel.
+   *
+   * Arguments:     
+   *  - level_set_fcn (in):    level set function to advance 
+   *                           (i.e. PHI or PSI)
+   *  - stage_type (in):       TVD Runge-Kutta stage to take
+   *  - phi_next_handle (in):  PatchData handle for the result of the
+   *                           stage (ignored for NO_TVD_RK_STAGE)
+   *  - phi_handle (in):       PatchData handle for phi that should 
+   *                           be used to compute spatial derivatives
+   *                           (i.e. the input to the stage)
+   *  - phi_cur_handle (in):   PatchData handle for phi at the 
+   *                           beginning of the time step (only used
+   *                           by the second and third stages)
+   *  - dt (in):               time increment of the TVD Runge-Kutta
+   *                           step
+   *  - component (in):        component of level set function to 
+   *                           advance (default = 0)
+   *
+   * Return value:             none
+   *
+   * NOTES:
+   *  - When a normal velocity field is provided, only the forward and
+   *    backward spatial derivatives are computed; the upwind 
+   *    derivatives for the advection term are selected from them 
+   *    inside computeLevelSetEquationRHSOnPatch().
+   *  - For LOW_STORAGE_TVD_RK3_STAGE2, phi_next_handle must be the 
+   *    same as phi_handle.  For LOW_STORAGE_TVD_RK3_STAGE3, 
+   *    phi_next_handle must be the same as phi_cur_handle.
+   *  - A patch may be advanced in place because its spatial 
+   *    derivatives and RHS are computed before the stage is taken
+   *    and the other patches only read their own ghost cells.
+   *
+   */
+  virtual void advanceLevelSetEqnThroughStage(
+    const LEVEL_SET_FCN_TYPE level_set_fcn,
+    const TVD_RK_STAGE_TYPE stage_type,
+    const int phi_next_handle,
+    const int phi_handle,
+    const int phi_cur_handle,
+    const LSMLIB_REAL dt,
+    const int component = 0);
+
   /*!
    * computeLevelSetEquationRHS() computes the right-hand side of 
    * the level set equation when it is written in the form:
@@ -1222,6 +1339,12 @@ protected:
    *
    * Return value:           none
    *
+   * NOTES:
+   *  - computeLevelSetEquationRHS() calls 
+   *    advanceLevelSetEqnThroughStage() with NO_TVD_RK_STAGE, so
+   *    addAdvectionTermToLevelSetEquationRHS() and 
+   *    addNormalVelocityTermToLevelSetEquationRHS() are not used.
+   *
    */
   virtual void computeLevelSetEquationRHS(
     const LEVEL_SET_FCN_TYPE level_set_fcn,
@@ -1288,6 +1411,46 @@ protected:
     const int phi_handle,
     const int component = 0);
 
+  /*!
+   * computeLevelSetEquationRHSOnPatch() sets the right-hand side of 
+   * the level set equation on a single Patch using previously computed
+   * spatial derivatives.  The advection and normal velocity terms 
+   * (whichever are provided) are computed in a single pass over the 
+   * Patch, so the RHS does not need to be zeroed out beforehand.
+   *
+   * Arguments:     
+   *  - patch (in):                   Patch on which to compute the RHS
+   *  - rhs_handle (in):              PatchData handle for the RHS
+   *  - grad_phi_plus_handle (in):    PatchData handle for forward
+   *                                  approximation to grad(phi) 
+   *  - grad_phi_minus_handle (in):   PatchData handle for backward
+   *                                  approximation to grad(phi) 
+   *  - velocity_handle (in):         PatchData handle for the external
+   *                                  velocity field (-1 if none)
+   *  - normal_velocity_handle (in):  PatchData handle for the normal
+   *                                  velocity field (-1 if none)
+   *   
+   * Return value:                    none
+   *
+   * NOTES:
+   *  - When only an external velocity field is provided, the upwind
+   *    derivatives may be passed as both grad_phi_plus_handle and 
+   *    grad_phi_minus_handle.
+   *  - If there is neither an external nor a normal velocity field, 
+   *    the RHS is set to zero.
+   *  - The RHS is only set on the interior of the Patch.  Since the
+   *    RHS PatchData is registered with zero ghost cells, this covers
+   *    the entire PatchData, so no stale ghost cell values are left.
+   *
+   */
+  virtual void computeLevelSetEquationRHSOnPatch(
+    Pointer< Patch<DIM> > patch,
+    const int rhs_handle,
+    const int grad_phi_plus_handle,
+    const int grad_phi_minus_handle,
+    const int velocity_handle,
+    const int normal_velocity_handle);
+
   //! @}
 
 
@@ -1356,6 +1519,32 @@ protected:
    */
   virtual void getFromRestart();
 
+  /*!
+   * fillBoundaryData() fills the ghost cells on all levels of the
+   * PatchHierarchy using the specified RefineSchedules and records
+   * the timing and ghost cell statistics for the fill.
+   *
+   * Arguments:
+   *  - refine_alg (in):  RefineAlgorithm whose PatchData should be
+   *                      filled
+   *  - scheds (in):      RefineSchedules (one per level) to use to fill
+   *                      the ghost cells
+   *  - time (in):        time at which to fill the ghost cells
+   *
+   * Return value:        none
+   *
+   * NOTES:
+   *  - The schedules are shared with other algorithms through the
+   *    RefineScheduleCache, so they are filled using
+   *    RefineScheduleCache::fillData() which reconfigures them for
+   *    refine_alg if necessary.
+   *
+   */
+  virtual void fillBoundaryData(
+    Pointer< RefineAlgorithm<DIM> > refine_alg,
+    Array< Pointer< RefineSchedule<DIM> > >& scheds,
+    const LSMLIB_REAL time);
+
   //! @}
 
   /****************************************************************
@@ -1387,6 +1576,8 @@ protected:
   int d_spatial_derivative_order;       // order of spatial derivative
   int d_tvd_runge_kutta_order;          // order of TVD Runge-Kutta time 
                                         //   integration
+  bool d_use_low_storage_tvd_runge_kutta; // true if TVD-RK3 stages 
+                                        //   should be computed in place
   int d_reinitialization_interval;      // interval between reinitialization
   LSMLIB_REAL d_reinitialization_stop_tol;   // stopping criterion for termination
                                         //   of evolution of reinitialization 
@@ -1488,6 +1679,10 @@ protected:
   vector<int> d_phi_handles;
   vector<int> d_psi_handles;
 
+  // number of PatchData handles for each level set function used 
+  // during a TVD Runge-Kutta step (including the current solution)
+  int d_num_tvd_runge_kutta_handles;
+
   // forward and backward spatial derivatives
   int d_grad_phi_plus_handle;
   int d_grad_psi_plus_handle;
@@ -1568,6 +1763,24 @@ protected:
   Array< Array< Pointer< RefineSchedule<DIM> > > > 
     d_fill_bdry_sched_time_advance;
 
+  /*
+   * Performance statistics
+   */
+
+  // timers
+  Pointer<Timer> d_timer_advance;
+  Pointer<Timer> d_timer_compute_stable_dt;
+  Pointer<Timer> d_timer_compute_rhs;
+  Pointer<Timer> d_timer_fill_bdry;
+  Pointer<Timer> d_timer_reinitialization;
+  Pointer<Timer> d_timer_orthogonalization;
+
+  // number of cells (interior and ghost) on the local processor.
+  // These are recomputed whenever the hierarchy configuration is
+  // reset and are used to update the counters.
+  double d_num_local_cells;
+  double d_num_local_ghost_cells;
+
 private:
  
   /*
@@ -130,6 +130,23 @@ LevelSetMethodAlgorithm<DIM>::LevelSetMethodAlgorithm(
 }
 
 
+/* printPerformanceStatistics() */
+template<int DIM> 
+void LevelSetMethodAlgorithm<DIM>::printPerformanceStatistics(
+  ostream& os) const
+{
+  LevelSetMethodStatistics::getStatistics()->printStatistics(os);
+}
+
+
+/* resetPerformanceStatistics() */
+template<int DIM> 
+void LevelSetMethodAlgorithm<DIM>::resetPerformanceStatistics()
+{
+  LevelSetMethodStatistics::getStatistics()->resetStatistics();
+}
+
+
 /* printClassData() */
 template<int DIM> 
 void LevelSetMethodAlgorithm<DIM>::printClassData(ostream& os) const
@@ -489,6 +489,7 @@
 #include "ReinitializationAlgorithm.h"
 #include "OrthogonalizationAlgorithm.h"
 #include "BoundaryConditionModule.h"
+#include "LevelSetMethodStatistics.h"
 
 // namespaces
 using namespace std;
@@ -704,6 +705,40 @@ public:
    */
   virtual void printClassData(ostream& os) const;
 
+  /*!
+   * printPerformanceStatistics() prints the timers and counters 
+   * collected by the parallel level set method classes (e.g. time
+   * spent computing the RHS of the level set equation, filling ghost
+   * cells, imposing boundary conditions, reinitializing and 
+   * orthogonalizing the level set functions, and extending fields off
+   * of the zero level set).  For each timer, the maximum and average 
+   * wallclock time over all processors are printed.  Counters are 
+   * summed over all processors.
+   * 
+   * Arguments: 
+   *  - os (in):     output stream to write performance statistics
+   *
+   * Return value:   none
+   *
+   * NOTES:
+   *  - printPerformanceStatistics() is a collective operation.
+   *  - The "bytes exchanged" counter is an estimate based on the 
+   *    number of ghost cells filled (see LevelSetMethodStatistics).
+   *
+   */
+  virtual void printPerformanceStatistics(ostream& os) const;
+
+  /*!
+   * resetPerformanceStatistics() resets all of the timers and counters 
+   * collected by the parallel level set method classes to zero.
+   * 
+   * Arguments:      none
+   *
+   * Return value:   none
+   *
+   */
+  virtual void resetPerformanceStatistics();
+
   //! @}
 
 
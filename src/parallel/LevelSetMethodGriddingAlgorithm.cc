@@ -11,10 +11,17 @@
 #ifndef included_LevelSetMethodGriddingAlgorithm_cc
 #define included_LevelSetMethodGriddingAlgorithm_cc
 
+#include <math.h>
+
 #include "LevelSetMethodGriddingAlgorithm.h" 
+#include "LevelSetMethodStatistics.h" 
+#include "LSMLIB_DefaultParameters.h"
 #include "BergerRigoutsos.h" 
+#include "CartesianPatchGeometry.h" 
 #include "CellData.h" 
+#include "CellVariable.h" 
 #include "LoadBalancer.h" 
+#include "VariableDatabase.h" 
 #include "tbox/RestartManager.h" 
 
 #ifdef DEBUG_CHECK_ASSERTIONS
@@ -64,8 +71,24 @@ StandardTagAndInitialize<DIM>(object_name,
   d_velocity_field_strategies.setNull();
 
   // read input parameters
+  d_workload_handle = -1;
   getFromInput(input_db);
 
+  // register workload variable used by load balancer
+  if (d_use_interface_workload) {
+    VariableDatabase<DIM> *var_db = VariableDatabase<DIM>::getDatabase();
+    string workload_name = d_object_name + "::WORKLOAD";
+    Pointer< CellVariable<DIM,double> > workload_variable;
+    if (var_db->checkVariableExists(workload_name)) {
+      workload_variable = var_db->getVariable(workload_name);
+    } else {
+      workload_variable = new CellVariable<DIM,double>(workload_name, 1);
+    }
+    d_workload_handle = var_db->registerVariableAndContext(
+      workload_variable, var_db->getContext("WORKLOAD"), 
+      IntVector<DIM>(0));
+  }
+
   /*
    * Set up LevelSetMethodGriddingAlgorithm
    */ 
@@ -81,6 +104,9 @@ StandardTagAndInitialize<DIM>(object_name,
   } else {
     load_balancer = new LoadBalancer<DIM> ("load balancer");
   }
+  if (d_use_interface_workload) {
+    load_balancer->setWorkloadPatchDataIndex(d_workload_handle);
+  }
 
   // construct gridding algorithm using "this" as the 
   // TagAndInitializeStrategy.  
@@ -139,6 +165,7 @@ void LevelSetMethodGriddingAlgorithm<DIM>::initializePatchHierarchy(
          level_num++) {
 
       plog << "Adding finer level with level_num = " << level_num << endl;
+      computeWorkload();
       d_gridding_alg->makeFinerLevel(d_patch_hierarchy, time, true, 0);
 
       plog << "Just added finer level with level_num = " << level_num << endl;
@@ -182,11 +209,20 @@ template<int DIM>
 void LevelSetMethodGriddingAlgorithm<DIM>::regridPatchHierarchy(
   LSMLIB_REAL time)
 {
+  LevelSetMethodScopedTimer timer(
+    LevelSetMethodStatistics::getStatistics()->getTimer(
+      "LevelSetMethodGriddingAlgorithm::regridPatchHierarchy()"));
+  LevelSetMethodStatistics::getStatistics()->incrementCounter(
+    "LevelSetMethodGriddingAlgorithm::regrids");
+
   int num_levels = d_patch_hierarchy->getNumberLevels();
   Array<int> tag_buffer(num_levels, true);
   for (int ln=0; ln < num_levels ; ln++) 
     tag_buffer[ln] = d_gridding_alg->getProperNestingBuffer(ln);
 
+  // update cell workloads used to load balance the new levels
+  computeWorkload();
+
   d_gridding_alg->regridAllFinerLevels(
     d_patch_hierarchy, 
     0,    // regrid all levels finer than the coarsest level
@@ -453,8 +489,150 @@ void LevelSetMethodGriddingAlgorithm<DIM>::getFromInput(
       << "RICHARDSON_EXTRAPOLATION, or REFINE_BOXES\n"
       << "See class header for details.\n");
   }
+
+  /*
+   * Read interface-aware workload input
+   */
+  d_use_interface_workload = 
+    input_db->getBoolWithDefault("use_interface_workload", false);
+
+  string workload_weighting = input_db->getStringWithDefault(
+    "workload_weighting", LSM_DEFAULT_WORKLOAD_WEIGHTING);
+  if (workload_weighting == "NARROW_BAND") {
+    d_use_interface_distance_workload = false;
+  } else if (workload_weighting == "INTERFACE_DISTANCE") {
+    d_use_interface_distance_workload = true;
+  } else {
+    TBOX_ERROR(  d_object_name 
+              << "::getFromInput(): "
+              << "Invalid `workload_weighting' input: "
+              << workload_weighting << ".  "
+              << "Valid choices are NARROW_BAND and INTERFACE_DISTANCE."
+              << endl);
+  }
+
+  d_workload_band_width = input_db->getDoubleWithDefault(
+    "workload_band_width", LSM_DEFAULT_WORKLOAD_BAND_WIDTH);
+  if (d_workload_band_width <= 0.0) {
+    TBOX_ERROR(  d_object_name 
+              << "::getFromInput(): "
+              << "`workload_band_width' must be positive."
+              << endl);
+  }
+
+  d_workload_far_field_weight = input_db->getDoubleWithDefault(
+    "workload_far_field_weight", LSM_DEFAULT_WORKLOAD_FAR_FIELD_WEIGHT);
+  if ( (d_workload_far_field_weight <= 0.0) || 
+       (d_workload_far_field_weight > 1.0) ) {
+    TBOX_ERROR(  d_object_name 
+              << "::getFromInput(): "
+              << "`workload_far_field_weight' must lie in (0,1]."
+              << endl);
+  }
 }
 
+/* computeWorkload() */
+template<int DIM> 
+void LevelSetMethodGriddingAlgorithm<DIM>::computeWorkload()
+{
+  if (!d_use_interface_workload) return;
+
+  const int phi_handle = d_lsm_integrator_strategy->getPhiPatchDataHandle();
+
+  const int num_levels = d_patch_hierarchy->getNumberLevels();
+  for ( int ln=0 ; ln < num_levels; ln++ ) {
+
+    Pointer< PatchLevel<DIM> > level = d_patch_hierarchy->getPatchLevel(ln);
+    if (!level->checkAllocated(d_workload_handle)) {
+      level->allocatePatchData(d_workload_handle);
+    }
+
+    for (typename PatchLevel<DIM>::Iterator pi(level); pi; pi++) {
+      Pointer< Patch<DIM> > patch = level->getPatch(pi());
+      computeWorkloadOnPatch(*patch, d_workload_handle, phi_handle);
+    }
+
+  } // end loop over PatchLevels
+}
+
+
+/* computeWorkloadOnPatch() */
+template<int DIM> 
+void LevelSetMethodGriddingAlgorithm<DIM>::computeWorkloadOnPatch(
+  Patch<DIM>& patch,
+  const int workload_handle,
+  const int phi_handle)
+{
+  Pointer< CellData<DIM,double> > workload_data =
+    patch.getPatchData( workload_handle );
+  Pointer< CellData<DIM,LSMLIB_REAL> > phi_data =
+    patch.getPatchData( phi_handle );
+
+  // compute width of band in physical units
+  Pointer< CartesianPatchGeometry<DIM> > patch_geom = 
+    patch.getPatchGeometry();
+  const double* dx = patch_geom->getDx();
+  double dx_min = dx[0];
+  for (int dim = 1; dim < DIM; dim++) {
+    if (dx[dim] < dx_min) dx_min = dx[dim];
+  }
+  const double band_width = d_workload_band_width*dx_min;
+  const double far_field_weight = d_workload_far_field_weight;
+
+  // compute strides and offsets into the data arrays 
+  Box<DIM> box = patch.getBox();
+  Box<DIM> phi_ghostbox = phi_data->getGhostBox();
+  Box<DIM> workload_ghostbox = workload_data->getGhostBox();
+  int num_cells[3] = {1, 1, 1};
+  int phi_stride[3] = {1, 0, 0};
+  int workload_stride[3] = {1, 0, 0};
+  int phi_offset = 0;
+  int workload_offset = 0;
+  for (int dim = 0; dim < DIM; dim++) {
+    num_cells[dim] = box.numberCells(dim);
+    if (dim > 0) {
+      phi_stride[dim] = 
+        phi_stride[dim-1]*phi_ghostbox.numberCells(dim-1);
+      workload_stride[dim] = 
+        workload_stride[dim-1]*workload_ghostbox.numberCells(dim-1);
+    }
+    phi_offset += (box.lower(dim) - phi_ghostbox.lower(dim))*phi_stride[dim];
+    workload_offset += 
+      (box.lower(dim) - workload_ghostbox.lower(dim))*workload_stride[dim];
+  }
+
+  // estimate distance to the zero level set by min |phi| over components
+  double* workload = workload_data->getPointer() + workload_offset;
+  const LSMLIB_REAL* phi = phi_data->getPointer(0);
+  const int depth = phi_data->getDepth();
+  for (int k = 0; k < num_cells[2]; k++) {
+    for (int j = 0; j < num_cells[1]; j++) {
+      double* workload_row = workload + j*workload_stride[1]
+                                      + k*workload_stride[2];
+      const int phi_row_offset = phi_offset + j*phi_stride[1] 
+                                            + k*phi_stride[2];
+      for (int i = 0; i < num_cells[0]; i++) {
+        double dist = fabs(phi[phi_row_offset + i]);
+        for (int comp = 1; comp < depth; comp++) {
+          double dist_comp = 
+            fabs(phi_data->getPointer(comp)[phi_row_offset + i]);
+          if (dist_comp < dist) dist = dist_comp;
+        }
+
+        if (dist >= band_width) {
+          workload_row[i] = far_field_weight;
+        } else if (d_use_interface_distance_workload) {
+          workload_row[i] = 
+            1.0 - (1.0 - far_field_weight)*dist/band_width;
+        } else {
+          workload_row[i] = 1.0;
+        }
+      }
+    }
+  } // end loop over grid
+}
+
+
 /* Copy Constructor */
 template <int DIM>
 LevelSetMethodGriddingAlgorithm<DIM>::LevelSetMethodGriddingAlgorithm(
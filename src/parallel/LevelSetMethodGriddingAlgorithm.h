@@ -76,6 +76,32 @@
  * <h4> Load Balancer Input: </h4>
  * - NO REQUIRED INPUT PARAMETERS (several OPTIONAL input parameters)
  *
+ * <h4> Interface-Aware Workload Input: </h4>
+ * - use_interface_workload (OPTIONAL)    
+ *                                  =  boolean specifying whether the load 
+ *                                     balancer should weight cells by their
+ *                                     proximity to the zero level set 
+ *                                     (default = FALSE).  When FALSE, all 
+ *                                     cells are assigned the same workload.
+ * - workload_weighting (OPTIONAL)  =  string specifying how cell workloads 
+ *                                     are computed from the level set 
+ *                                     function.  Valid choices include:
+ *                                     ``NARROW_BAND'' (cells within the 
+ *                                     band have weight 1; all other cells
+ *                                     have the far-field weight) and 
+ *                                     ``INTERFACE_DISTANCE'' (weight 
+ *                                     decreases linearly from 1 at the 
+ *                                     interface to the far-field weight at
+ *                                     the edge of the band).
+ *                                     (default = ``NARROW_BAND'') 
+ * - workload_band_width (OPTIONAL) =  width of band around the zero level 
+ *                                     set in units of grid cells
+ *                                     (default = 6) 
+ * - workload_far_field_weight (OPTIONAL) 
+ *                                  =  workload of cells outside of the band
+ *                                     relative to cells near the zero level
+ *                                     set; must lie in (0,1] (default = 0.1) 
+ *
  *
  * <h3> NOTES: </h3>
  *   - The descriptions of the input parameters was taken almost verbatim 
@@ -101,6 +127,7 @@
 
 #include "SAMRAI_config.h"
 #include "GriddingAlgorithm.h"
+#include "Patch.h"
 #include "PatchHierarchy.h"
 #include "PatchLevel.h"
 #include "StandardTagAndInitialize.h"
@@ -379,7 +406,8 @@ protected:
    * getFromInput() re-reads the ``tagging_method'' input from the input
    * database.  This input has already been read by the parent class,
    * but the results are not available because the relevent data members
-   * are declared private in StandardTagAndInitialize.
+   * are declared private in StandardTagAndInitialize.  getFromInput()
+   * also reads the interface-aware workload input.
    *
    * Arguments:     
    *  - input_db (in):  input database
@@ -393,6 +421,47 @@ protected:
    */
   void getFromInput(Pointer<Database> input_db);
 
+  /*!
+   * computeWorkload() computes the cell workloads used by the load
+   * balancer on all levels of the PatchHierarchy.  The PatchData for
+   * the workload is allocated on levels where it has not yet been
+   * allocated.
+   *
+   * Arguments:     none
+   *                      
+   * Return value:  none
+   *                
+   * NOTES:
+   *  - computeWorkload() does nothing unless use_interface_workload 
+   *    is TRUE in the input database.
+   */
+  void computeWorkload();
+
+  /*!
+   * computeWorkloadOnPatch() computes the cell workloads on a single
+   * patch from the level set function.
+   *
+   * Arguments:     
+   *  - patch (in):            Patch on which to compute workload
+   *  - workload_handle (in):  PatchData handle for workload (cell-centered
+   *                           double data with a single component)
+   *  - phi_handle (in):       PatchData handle for phi
+   *                      
+   * Return value:             none
+   *                
+   * NOTES:
+   *  - The default implementation uses the distance of each cell to
+   *    the zero level set (estimated by the minimum of |phi| over all
+   *    components of phi) and the workload_weighting, 
+   *    workload_band_width and workload_far_field_weight input 
+   *    parameters.  Subclasses may override this method to provide
+   *    application-specific workload estimates.
+   */
+  virtual void computeWorkloadOnPatch(
+    Patch<DIM>& patch,
+    const int workload_handle,
+    const int phi_handle);
+
   //! @}
 
 
@@ -435,6 +504,20 @@ protected:
   Array< Pointer< LevelSetMethodVelocityFieldStrategy<DIM> > > 
     d_velocity_field_strategies;
 
+  /*
+   * Parameters for interface-aware workload estimation
+   */
+  bool d_use_interface_workload;
+  bool d_use_interface_distance_workload;
+  double d_workload_band_width;
+  double d_workload_far_field_weight;
+
+  /*
+   * PatchData handle for cell workloads (-1 if workload estimation
+   * is not used)
+   */
+  int d_workload_handle;
+
 private:
  
   /*
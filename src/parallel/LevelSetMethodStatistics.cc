@@ -0,0 +1,261 @@
+/*
+ * File:        LevelSetMethodStatistics.cc
+ * Copyrights:  (c) 2005 The Trustees of Princeton University and Board of
+ *                  Regents of the University of Texas.  All rights reserved.
+ *              (c) 2009 Kevin T. Chu.  All rights reserved.
+ * Revision:    $Revision$
+ * Modified:    $Date$
+ * Description: Implementation file for level set method performance
+ *              statistics
+ */
+
+#include "LevelSetMethodStatistics.h"
+
+// System Headers
+#include <iomanip>
+
+// SAMRAI header files
+#include "tbox/MPI.h"
+#include "tbox/TimerManager.h"
+#include "tbox/Utilities.h"
+
+
+/****************************************************************
+ *
+ * Methods for LevelSetMethodStatistics class
+ *
+ ****************************************************************/
+
+namespace LSMLIB {
+
+/* initialize static data members */
+LevelSetMethodStatistics*
+  LevelSetMethodStatistics::s_statistics_instance = NULL;
+
+/* names of timers and counters used by the LSMLIB classes */
+static const char* s_lsmlib_timer_names[] = {
+  "BoundaryConditionModule::imposeBoundaryConditions()",
+  "FieldExtensionAlgorithm::computeExtensionField()",
+  "LevelSetFunctionIntegrator::advanceLevelSetEqnUsingTVDRK()",
+  "LevelSetFunctionIntegrator::advanceLevelSetFunctions()",
+  "LevelSetFunctionIntegrator::computeLevelSetEquationRHS()",
+  "LevelSetFunctionIntegrator::computeStableDt()",
+  "LevelSetFunctionIntegrator::fillBoundaryData()",
+  "LevelSetFunctionIntegrator::orthogonalizeLevelSetFunctions()",
+  "LevelSetFunctionIntegrator::reinitializeLevelSetFunctions()",
+  "LevelSetMethodGriddingAlgorithm::regridPatchHierarchy()",
+  "LevelSetMethodToolbox::computePlusAndMinusSpatialDerivatives()",
+  "LevelSetMethodToolbox::computeUpwindSpatialDerivatives()",
+  "OrthogonalizationAlgorithm::orthogonalizeLevelSetFunctions()",
+  "ReinitializationAlgorithm::reinitializeLevelSetFunctions()",
+  NULL };
+static const char* s_lsmlib_counter_names[] = {
+  "FieldExtensionAlgorithm::iterations",
+  "LevelSetFunctionIntegrator::RHS evaluations",
+  "LevelSetFunctionIntegrator::bytes exchanged (estimate)",
+  "LevelSetFunctionIntegrator::cells updated",
+  "LevelSetFunctionIntegrator::ghost cell fills",
+  "LevelSetFunctionIntegrator::orthogonalizations",
+  "LevelSetFunctionIntegrator::reinitializations",
+  "LevelSetFunctionIntegrator::time steps",
+  "LevelSetFunctionIntegrator::velocity field computations",
+  "LevelSetMethodGriddingAlgorithm::regrids",
+  "RefineScheduleCache::schedules created",
+  "RefineScheduleCache::schedules reset",
+  "RefineScheduleCache::schedules reused",
+  "ReinitializationAlgorithm::iterations",
+  NULL };
+
+
+/* getStatistics() */
+LevelSetMethodStatistics* LevelSetMethodStatistics::getStatistics()
+{
+  if (!s_statistics_instance) {
+    s_statistics_instance = new LevelSetMethodStatistics;
+  }
+  return s_statistics_instance;
+}
+
+
+/* freeStatistics() */
+void LevelSetMethodStatistics::freeStatistics()
+{
+  if (s_statistics_instance) delete s_statistics_instance;
+  s_statistics_instance = NULL;
+}
+
+
+/* getTimer() */
+Pointer<Timer> LevelSetMethodStatistics::getTimer(const string& name)
+{
+  Pointer<Timer> timer;
+
+#ifdef _OPENMP
+#pragma omp critical (LSMLIB_LevelSetMethodStatistics)
+#endif
+  {
+    map< string, Pointer<Timer> >::iterator it = d_timers.find(name);
+    if (it != d_timers.end()) {
+      timer = it->second;
+    } else {
+      // NOTE: true indicates that the timer should be active regardless
+      //       of the TimerManager input
+      timer = TimerManager::getManager()->getTimer("LSMLIB::" + name, true);
+      d_timers[name] = timer;
+    }
+  }
+
+  return timer;
+}
+
+
+/* incrementCounter() */
+void LevelSetMethodStatistics::incrementCounter(
+  const string& name,
+  const double amount)
+{
+#ifdef _OPENMP
+#pragma omp critical (LSMLIB_LevelSetMethodStatistics)
+#endif
+  d_counters[name] += amount;
+}
+
+
+/* getCounter() */
+double LevelSetMethodStatistics::getCounter(const string& name) const
+{
+  map< string, double >::const_iterator it = d_counters.find(name);
+  if (it == d_counters.end()) return 0.0;
+  return it->second;
+}
+
+
+/* resetStatistics() */
+void LevelSetMethodStatistics::resetStatistics()
+{
+  map< string, Pointer<Timer> >::iterator t_it;
+  for (t_it = d_timers.begin(); t_it != d_timers.end(); t_it++) {
+    t_it->second->reset();
+  }
+
+  map< string, double >::iterator c_it;
+  for (c_it = d_counters.begin(); c_it != d_counters.end(); c_it++) {
+    c_it->second = 0.0;
+  }
+}
+
+
+/* printStatistics() */
+void LevelSetMethodStatistics::printStatistics(ostream& os) const
+{
+  const int num_procs = MPI::getNodes();
+
+  os << "\n===================================" << endl;
+  os << "LSMLIB Performance Statistics" << endl;
+  os << "  (" << num_procs << " processors)" << endl;
+
+  // check that all processors hold the same timer and counter names
+  // (otherwise the reductions below would not match up across
+  // processors)
+  const double num_names = d_timers.size() + d_counters.size();
+  const double name_hash = computeNameHash();
+  if ( (MPI::minReduction(num_names) != MPI::maxReduction(num_names)) ||
+       (MPI::minReduction(name_hash) != MPI::maxReduction(name_hash)) ) {
+    TBOX_WARNING(  "LevelSetMethodStatistics::printStatistics(): "
+                << "timer and counter names differ between processors.  "
+                << "Printing local values only."
+                << endl );
+
+    os << "\nTimers (wallclock seconds, local)" << endl;
+    map< string, Pointer<Timer> >::const_iterator t_it;
+    for (t_it = d_timers.begin(); t_it != d_timers.end(); t_it++) {
+      os << "  " << setw(64) << left << t_it->first
+         << setw(14) << right << t_it->second->getTotalWallclockTime()
+         << endl;
+    }
+
+    os << "\nCounters (local)" << endl;
+    map< string, double >::const_iterator c_it;
+    for (c_it = d_counters.begin(); c_it != d_counters.end(); c_it++) {
+      os << "  " << setw(64) << left << c_it->first
+         << setw(14) << right << c_it->second << endl;
+    }
+
+    os << "===================================" << endl << endl;
+    return;
+  }
+
+  os << "\nTimers (wallclock seconds)" << endl;
+  os << "  " << setw(64) << left << "name"
+     << setw(14) << right << "max"
+     << setw(14) << right << "avg" << endl;
+  map< string, Pointer<Timer> >::const_iterator t_it;
+  for (t_it = d_timers.begin(); t_it != d_timers.end(); t_it++) {
+    const double local_time = t_it->second->getTotalWallclockTime();
+    const double max_time = MPI::maxReduction(local_time);
+    const double avg_time = MPI::sumReduction(local_time)/num_procs;
+    os << "  " << setw(64) << left << t_it->first
+       << setw(14) << right << max_time
+       << setw(14) << right << avg_time << endl;
+  }
+
+  os << "\nCounters (summed over processors)" << endl;
+  map< string, double >::const_iterator c_it;
+  for (c_it = d_counters.begin(); c_it != d_counters.end(); c_it++) {
+    const double total = MPI::sumReduction(c_it->second);
+    os << "  " << setw(64) << left << c_it->first
+       << setw(14) << right << total << endl;
+  }
+
+  os << "===================================" << endl << endl;
+}
+
+
+/* computeNameHash() */
+double LevelSetMethodStatistics::computeNameHash() const
+{
+  // NOTE: the hash is kept below 2^31 so that it is represented
+  //       exactly as a double
+  const unsigned long modulus = 2147483647UL;
+  unsigned long hash = 5381;
+
+  map< string, Pointer<Timer> >::const_iterator t_it;
+  for (t_it = d_timers.begin(); t_it != d_timers.end(); t_it++) {
+    const string& name = t_it->first;
+    for (string::size_type i = 0; i < name.size(); i++) {
+      hash = (hash*33 + (unsigned char) name[i]) % modulus;
+    }
+    hash = (hash*33) % modulus;
+  }
+
+  map< string, double >::const_iterator c_it;
+  for (c_it = d_counters.begin(); c_it != d_counters.end(); c_it++) {
+    const string& name = c_it->first;
+    for (string::size_type i = 0; i < name.size(); i++) {
+      hash = (hash*33 + (unsigned char) name[i]) % modulus;
+    }
+    hash = (hash*33) % modulus;
+  }
+
+  return (double) hash;
+}
+
+
+/* Constructor */
+LevelSetMethodStatistics::LevelSetMethodStatistics()
+{
+  for (int i = 0; s_lsmlib_timer_names[i]; i++) {
+    getTimer(s_lsmlib_timer_names[i]);
+  }
+  for (int i = 0; s_lsmlib_counter_names[i]; i++) {
+    d_counters[s_lsmlib_counter_names[i]] = 0.0;
+  }
+}
+
+
+/* Destructor */
+LevelSetMethodStatistics::~LevelSetMethodStatistics()
+{
+}
+
+} // end LSMLIB namespace
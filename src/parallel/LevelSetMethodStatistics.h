@@ -0,0 +1,276 @@
+/*
+ * File:        LevelSetMethodStatistics.h
+ * Copyrights:  (c) 2005 The Trustees of Princeton University and Board of
+ *                  Regents of the University of Texas.  All rights reserved.
+ *              (c) 2009 Kevin T. Chu.  All rights reserved.
+ * Revision:    $Revision$
+ * Modified:    $Date$
+ * Description: Header file for level set method performance statistics
+ */
+
+#ifndef included_LevelSetMethodStatistics_h
+#define included_LevelSetMethodStatistics_h
+
+/*! \class LSMLIB::LevelSetMethodStatistics
+ *
+ * \brief
+ * LevelSetMethodStatistics collects wallclock timers and event counters
+ * for the hot paths of the parallel level set method classes (e.g.
+ * RHS evaluation, ghost cell filling, boundary condition imposition,
+ * reinitialization, orthogonalization, and field extension).
+ *
+ * There is a single LevelSetMethodStatistics object per processor.  It
+ * is created the first time getStatistics() is called and is shared by
+ * all of the parallel level set method classes.  Timers are managed by
+ * the SAMRAI TimerManager, so they also appear in any timer output
+ * generated by the TimerManager.  Counters are simple named
+ * accumulators.
+ *
+ * The statistics are usually accessed through the
+ * printPerformanceStatistics() and resetPerformanceStatistics() methods
+ * of the LevelSetMethodAlgorithm class.
+ *
+ *
+ * <h3> NOTES </h3>
+ *
+ *  - The "bytes exchanged" counters are estimates computed from the
+ *    number of ghost cells filled on the local processor and the size
+ *    of LSMLIB_REAL.  They count all ghost cells that are filled
+ *    (including those filled by local copies and physical boundary
+ *    conditions), so they are an upper bound on the amount of data
+ *    actually communicated between processors.
+ *
+ *  - printStatistics() is a collective operation.  The timers and
+ *    counters used by the LSMLIB classes are created when the
+ *    statistics object is created, so every processor holds the same
+ *    set of timer and counter names even if some code paths are only
+ *    executed on some processors.  If the sets of names differ (e.g.
+ *    because user code created a timer on only some processors),
+ *    printStatistics() prints the local values and a warning instead
+ *    of reducing over processors.
+ *
+ *  - incrementCounter() and getTimer() may be called from within
+ *    OpenMP parallel regions.  Timers themselves should only be started
+ *    and stopped outside of parallel regions.
+ *
+ */
+
+#include <map>
+#include <ostream>
+#include <string>
+
+#include "SAMRAI_config.h"
+#include "tbox/Pointer.h"
+#include "tbox/Timer.h"
+
+#include "LSMLIB_config.h"
+
+// SAMRAI namespaces
+using namespace std;
+using namespace SAMRAI;
+using namespace tbox;
+
+
+/******************************************************************
+ *
+ * LevelSetMethodStatistics Class Definition
+ *
+ ******************************************************************/
+
+namespace LSMLIB {
+
+class LevelSetMethodStatistics
+{
+public:
+
+  //! @{
+  /*!
+   ****************************************************************
+   *
+   * @name Methods for accessing the statistics object
+   *
+   ****************************************************************/
+
+  /*!
+   * getStatistics() returns a pointer to the LevelSetMethodStatistics
+   * object, creating it if necessary.
+   *
+   * Arguments:      none
+   *
+   * Return value:   pointer to LevelSetMethodStatistics object
+   *
+   */
+  static LevelSetMethodStatistics* getStatistics();
+
+  /*!
+   * freeStatistics() deallocates the LevelSetMethodStatistics object.
+   *
+   * Arguments:      none
+   *
+   * Return value:   none
+   *
+   */
+  static void freeStatistics();
+
+  //! @}
+
+
+  //! @{
+  /*!
+   ****************************************************************
+   *
+   * @name Methods for timers and counters
+   *
+   ****************************************************************/
+
+  /*!
+   * getTimer() returns the timer with the specified name, creating it
+   * if necessary.  The timer is registered with the SAMRAI TimerManager
+   * as "LSMLIB::<name>" and is always active (regardless of the
+   * TimerManager input).
+   *
+   * Arguments:
+   *  - name (in):    name of timer
+   *
+   * Return value:    pointer to timer
+   *
+   */
+  Pointer<Timer> getTimer(const string& name);
+
+  /*!
+   * incrementCounter() adds the specified amount to the counter with
+   * the specified name.  Counters are created (with an initial value
+   * of zero) the first time they are incremented.
+   *
+   * Arguments:
+   *  - name (in):    name of counter
+   *  - amount (in):  amount to add to counter (default = 1)
+   *
+   * Return value:    none
+   *
+   */
+  void incrementCounter(const string& name, const double amount = 1.0);
+
+  /*!
+   * getCounter() returns the local (i.e. on this processor) value of
+   * the counter with the specified name.
+   *
+   * Arguments:
+   *  - name (in):    name of counter
+   *
+   * Return value:    local value of counter (zero if the counter does
+   *                  not exist)
+   *
+   */
+  double getCounter(const string& name) const;
+
+  /*!
+   * resetStatistics() resets all timers and counters to zero.
+   *
+   * Arguments:      none
+   *
+   * Return value:   none
+   *
+   */
+  void resetStatistics();
+
+  /*!
+   * printStatistics() prints the timers and counters to the specified
+   * output stream.  For each timer, the maximum and average wallclock
+   * time over all processors are printed.  For each counter, the sum
+   * over all processors is printed.
+   *
+   * Arguments:
+   *  - os (in):      output stream
+   *
+   * Return value:    none
+   *
+   * NOTES:
+   *  - printStatistics() is a collective operation.
+   *
+   */
+  void printStatistics(ostream& os) const;
+
+  //! @}
+
+
+protected:
+
+  /*
+   * The constructor and destructor are protected to ensure that
+   * the LevelSetMethodStatistics object is only created/destroyed
+   * via getStatistics()/freeStatistics().
+   *
+   * The constructor creates the timers and counters used by the LSMLIB
+   * classes.
+   */
+  LevelSetMethodStatistics();
+  virtual ~LevelSetMethodStatistics();
+
+  /*
+   * computeNameHash() computes a hash of the timer and counter names
+   * that is used to check that all processors hold the same names.
+   */
+  double computeNameHash() const;
+
+  /****************************************************************
+   *
+   * Data members
+   *
+   ****************************************************************/
+
+  // the statistics object
+  static LevelSetMethodStatistics* s_statistics_instance;
+
+  // timers and counters (maps keep names in the same order on all
+  // processors)
+  map< string, Pointer<Timer> > d_timers;
+  map< string, double > d_counters;
+
+private:
+
+  /*
+   * Private copy constructor to prevent use.
+   */
+  LevelSetMethodStatistics(const LevelSetMethodStatistics& rhs){}
+
+  /*
+   * Private assignment operator to prevent use.
+   */
+  const LevelSetMethodStatistics& operator=(
+    const LevelSetMethodStatistics& rhs) {
+      return *this;
+  }
+
+};
+
+
+/*!
+ * \class LSMLIB::LevelSetMethodScopedTimer
+ *
+ * \brief
+ * LevelSetMethodScopedTimer starts a timer when it is constructed and
+ * stops the timer when it goes out of scope.
+ *
+ */
+class LevelSetMethodScopedTimer
+{
+public:
+  LevelSetMethodScopedTimer(const Pointer<Timer>& timer)
+  : d_timer(timer) { d_timer->start(); }
+  ~LevelSetMethodScopedTimer() { d_timer->stop(); }
+
+protected:
+  Pointer<Timer> d_timer;
+
+private:
+  LevelSetMethodScopedTimer(const LevelSetMethodScopedTimer& rhs){}
+  const LevelSetMethodScopedTimer& operator=(
+    const LevelSetMethodScopedTimer& rhs) {
+      return *this;
+  }
+};
+
+} // end LSMLIB namespace
+
+#endif
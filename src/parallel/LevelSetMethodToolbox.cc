@@ -12,11 +12,13 @@
 #define included_LevelSetMethodToolbox_cc
 
 // System Headers
+#include <sstream>
 #include <vector>
 #include <float.h>
 
 #include "LSMLIB_config.h" 
 #include "LevelSetMethodToolbox.h" 
+#include "LevelSetMethodStatistics.h" 
 #include "LSMLIB_DefaultParameters.h"
 
 // SAMRAI Headers
@@ -42,6 +44,7 @@ extern "C" {
   #include "lsm_spatial_derivatives1d.h"
   #include "lsm_spatial_derivatives2d.h"
   #include "lsm_spatial_derivatives3d.h"
+  #include "lsm_spatial_derivatives_simd.h"
   #include "lsm_samrai_f77_utilities.h"
   #include "lsm_tvd_runge_kutta1d.h"
   #include "lsm_tvd_runge_kutta2d.h"
@@ -112,18 +115,35 @@ void LevelSetMethodToolbox<DIM>::computeUpwindSpatialDerivatives(
   const int upwind_function_handle,
   const int phi_component)
 {
+  LevelSetMethodScopedTimer timer(
+    LevelSetMethodStatistics::getStatistics()->getTimer(
+      "LevelSetMethodToolbox::computeUpwindSpatialDerivatives()"));
 
   // make sure that the scratch PatchData handles have been created
   initializeComputeSpatialDerivativesParameters();
 
+  // scratch PatchData is allocated for the entire level before the
+  // patch loop because PatchData allocation is not thread-safe
+  const ComponentSelector scratch_data = 
+    getSpatialDerivativesScratchData(spatial_derivative_type,
+                                     spatial_derivative_order);
+
   const int finest_level = hierarchy->getFinestLevelNumber();
   for ( int ln=0 ; ln<=finest_level ; ln++ ) {
 
     Pointer< PatchLevel<DIM> > level = hierarchy->getPatchLevel(ln);
     
-    typename PatchLevel<DIM>::Iterator pi;
-    for (pi.initialize(level); pi; pi++) { // loop over patches
-      const int pn = *pi;
+    level->allocatePatchData(scratch_data);
+
+    // patches are independent, so they may be processed concurrently
+    vector<int> patch_numbers;
+    getPatchNumbers(level, patch_numbers);
+    const int num_patches = patch_numbers.size();
+#ifdef _OPENMP
+#pragma omp parallel for schedule(dynamic)
+#endif
+    for (int p = 0; p < num_patches; p++) { // loop over patches
+      const int pn = patch_numbers[p];
       Pointer< Patch<DIM> > patch = level->getPatch(pn);
       if ( patch.isNull() ) {
         TBOX_ERROR(  "LevelSetMethodToolbox::"
@@ -132,635 +152,629 @@ void LevelSetMethodToolbox<DIM>::computeUpwindSpatialDerivatives(
                   << endl );
       }
 
-      // compute spatial derivatives for phi
-      Pointer< CellData<DIM,LSMLIB_REAL> > grad_phi_data =
-        patch->getPatchData( grad_phi_handle );
-      Pointer< CellData<DIM,LSMLIB_REAL> > phi_data =
-        patch->getPatchData( phi_handle );
-      Pointer< CellData<DIM,LSMLIB_REAL> > upwind_function_data =
-        patch->getPatchData( upwind_function_handle );
+      computeUpwindSpatialDerivativesOnPatch(
+        patch,
+        spatial_derivative_type,
+        spatial_derivative_order,
+        grad_phi_handle,
+        phi_handle,
+        upwind_function_handle,
+        phi_component);
+
+    } // end loop over Patches
+
+    level->deallocatePatchData(scratch_data);
+  } // end loop over PatchLevels
+}
+
+
+/* computeUpwindSpatialDerivativesOnPatch() */
+template <int DIM> 
+void LevelSetMethodToolbox<DIM>::computeUpwindSpatialDerivativesOnPatch(
+  Pointer< Patch<DIM> > patch,
+  const SPATIAL_DERIVATIVE_TYPE spatial_derivative_type,
+  const int spatial_derivative_order,
+  const int grad_phi_handle,
+  const int phi_handle,
+  const int upwind_function_handle,
+  const int phi_component)
+{
+  // compute spatial derivatives for phi
+  Pointer< CellData<DIM,LSMLIB_REAL> > grad_phi_data =
+    patch->getPatchData( grad_phi_handle );
+  Pointer< CellData<DIM,LSMLIB_REAL> > phi_data =
+    patch->getPatchData( phi_handle );
+  Pointer< CellData<DIM,LSMLIB_REAL> > upwind_function_data =
+    patch->getPatchData( upwind_function_handle );
   
-      Pointer< CartesianPatchGeometry<DIM> > patch_geom =
-        patch->getPatchGeometry();
+  Pointer< CartesianPatchGeometry<DIM> > patch_geom =
+    patch->getPatchGeometry();
 #ifdef LSMLIB_DOUBLE_PRECISION
-      const double* dx = patch_geom->getDx();
+  const double* dx = patch_geom->getDx();
 #else
-      const double* dx_double = patch_geom->getDx();
-      float dx[DIM];
-      for (int i = 0; i < DIM; i++) dx[i] = (float) dx_double[i];
+  const double* dx_double = patch_geom->getDx();
+  float dx[DIM];
+  for (int i = 0; i < DIM; i++) dx[i] = (float) dx_double[i];
 #endif
   
-      Box<DIM> fillbox = grad_phi_data->getBox();
-      const IntVector<DIM> grad_phi_fillbox_lower = fillbox.lower();
-      const IntVector<DIM> grad_phi_fillbox_upper = fillbox.upper();
+  Box<DIM> fillbox = grad_phi_data->getBox();
+  const IntVector<DIM> grad_phi_fillbox_lower = fillbox.lower();
+  const IntVector<DIM> grad_phi_fillbox_upper = fillbox.upper();
+
+  Box<DIM> grad_phi_ghostbox = grad_phi_data->getGhostBox();
+  const IntVector<DIM> grad_phi_ghostbox_lower = grad_phi_ghostbox.lower();
+  const IntVector<DIM> grad_phi_ghostbox_upper = grad_phi_ghostbox.upper();
+
+  Box<DIM> phi_ghostbox = phi_data->getGhostBox();
+  const IntVector<DIM> phi_ghostbox_lower = phi_ghostbox.lower();
+  const IntVector<DIM> phi_ghostbox_upper = phi_ghostbox.upper();
+
+  Box<DIM> upwind_fcn_ghostbox = upwind_function_data->getGhostBox();
+  const IntVector<DIM> upwind_fcn_ghostbox_lower = 
+    upwind_fcn_ghostbox.lower();
+  const IntVector<DIM> upwind_fcn_ghostbox_upper = 
+    upwind_fcn_ghostbox.upper();
+
+  LSMLIB_REAL* grad_phi[LSM_DIM_MAX];
+  LSMLIB_REAL* phi = phi_data->getPointer(phi_component);
+  LSMLIB_REAL* upwind_function[LSM_DIM_MAX];
+  for (int dim = 0; dim < DIM; dim++) {
+    grad_phi[dim] = grad_phi_data->getPointer(dim);
+    upwind_function[dim] = upwind_function_data->getPointer(dim);
+  }
 
-      Box<DIM> grad_phi_ghostbox = grad_phi_data->getGhostBox();
-      const IntVector<DIM> grad_phi_ghostbox_lower = grad_phi_ghostbox.lower();
-      const IntVector<DIM> grad_phi_ghostbox_upper = grad_phi_ghostbox.upper();
+  switch (spatial_derivative_type) {
+    case ENO: {
+      switch (spatial_derivative_order) { 
+        case 1: {
 
-      Box<DIM> phi_ghostbox = phi_data->getGhostBox();
-      const IntVector<DIM> phi_ghostbox_lower = phi_ghostbox.lower();
-      const IntVector<DIM> phi_ghostbox_upper = phi_ghostbox.upper();
+          Pointer< CellData<DIM,LSMLIB_REAL> > D1_data =
+            patch->getPatchData( s_D1_one_ghostcell_handle );
 
-      Box<DIM> upwind_fcn_ghostbox = upwind_function_data->getGhostBox();
-      const IntVector<DIM> upwind_fcn_ghostbox_lower = 
-        upwind_fcn_ghostbox.lower();
-      const IntVector<DIM> upwind_fcn_ghostbox_upper = 
-        upwind_fcn_ghostbox.upper();
+          Box<DIM> D1_ghostbox = D1_data->getGhostBox();
+          const IntVector<DIM> D1_ghostbox_lower = D1_ghostbox.lower();
+          const IntVector<DIM> D1_ghostbox_upper = D1_ghostbox.upper();
 
-      LSMLIB_REAL* grad_phi[LSM_DIM_MAX];
-      LSMLIB_REAL* phi = phi_data->getPointer(phi_component);
-      LSMLIB_REAL* upwind_function[LSM_DIM_MAX];
-      for (int dim = 0; dim < DIM; dim++) {
-        grad_phi[dim] = grad_phi_data->getPointer(dim);
-        upwind_function[dim] = upwind_function_data->getPointer(dim);
-      }
+          LSMLIB_REAL* D1 = D1_data->getPointer();
 
-      switch (spatial_derivative_type) {
-        case ENO: {
-          switch (spatial_derivative_order) { 
-            case 1: {
+          if ( DIM == 3 ) {
 
-              // prepare scratch PatchData
-              patch->allocatePatchData( s_D1_one_ghostcell_handle );
+            LSM3D_UPWIND_HJ_ENO1(
+              grad_phi[0], grad_phi[1], grad_phi[2],
+              &grad_phi_ghostbox_lower[0],
+              &grad_phi_ghostbox_upper[0],
+              &grad_phi_ghostbox_lower[1],
+              &grad_phi_ghostbox_upper[1],
+              &grad_phi_ghostbox_lower[2],
+              &grad_phi_ghostbox_upper[2],
+              phi,
+              &phi_ghostbox_lower[0],
+              &phi_ghostbox_upper[0],
+              &phi_ghostbox_lower[1],
+              &phi_ghostbox_upper[1],
+              &phi_ghostbox_lower[2],
+              &phi_ghostbox_upper[2],
+              upwind_function[0], 
+              upwind_function[1], 
+              upwind_function[2],
+              &upwind_fcn_ghostbox_lower[0],
+              &upwind_fcn_ghostbox_upper[0],
+              &upwind_fcn_ghostbox_lower[1],
+              &upwind_fcn_ghostbox_upper[1],
+              &upwind_fcn_ghostbox_lower[2],
+              &upwind_fcn_ghostbox_upper[2],
+              D1, 
+              &D1_ghostbox_lower[0],
+              &D1_ghostbox_upper[0],
+              &D1_ghostbox_lower[1],
+              &D1_ghostbox_upper[1],
+              &D1_ghostbox_lower[2],
+              &D1_ghostbox_upper[2],
+              &grad_phi_fillbox_lower[0],
+              &grad_phi_fillbox_upper[0],
+              &grad_phi_fillbox_lower[1],
+              &grad_phi_fillbox_upper[1],
+              &grad_phi_fillbox_lower[2],
+              &grad_phi_fillbox_upper[2],
+              &dx[0], &dx[1], &dx[2]);
 
-              Pointer< CellData<DIM,LSMLIB_REAL> > D1_data =
-                patch->getPatchData( s_D1_one_ghostcell_handle );
+          } else if ( DIM == 2 ) {
 
-              Box<DIM> D1_ghostbox = D1_data->getGhostBox();
-              const IntVector<DIM> D1_ghostbox_lower = D1_ghostbox.lower();
-              const IntVector<DIM> D1_ghostbox_upper = D1_ghostbox.upper();
+            LSM2D_UPWIND_HJ_ENO1(
+              grad_phi[0], grad_phi[1], 
+              &grad_phi_ghostbox_lower[0],
+              &grad_phi_ghostbox_upper[0],
+              &grad_phi_ghostbox_lower[1],
+              &grad_phi_ghostbox_upper[1],
+              phi,
+              &phi_ghostbox_lower[0],
+              &phi_ghostbox_upper[0],
+              &phi_ghostbox_lower[1],
+              &phi_ghostbox_upper[1],
+              upwind_function[0], 
+              upwind_function[1], 
+              &upwind_fcn_ghostbox_lower[0],
+              &upwind_fcn_ghostbox_upper[0],
+              &upwind_fcn_ghostbox_lower[1],
+              &upwind_fcn_ghostbox_upper[1],
+              D1, 
+              &D1_ghostbox_lower[0],
+              &D1_ghostbox_upper[0],
+              &D1_ghostbox_lower[1],
+              &D1_ghostbox_upper[1],
+              &grad_phi_fillbox_lower[0],
+              &grad_phi_fillbox_upper[0],
+              &grad_phi_fillbox_lower[1],
+              &grad_phi_fillbox_upper[1],
+              &dx[0], &dx[1]);
 
-              LSMLIB_REAL* D1 = D1_data->getPointer();
+          } else if ( DIM == 1 ) {
 
-              if ( DIM == 3 ) {
+            LSM1D_UPWIND_HJ_ENO1(
+              grad_phi[0], 
+              &grad_phi_ghostbox_lower[0],
+              &grad_phi_ghostbox_upper[0],
+              phi,
+              &phi_ghostbox_lower[0],
+              &phi_ghostbox_upper[0],
+              upwind_function[0], 
+              &upwind_fcn_ghostbox_lower[0],
+              &upwind_fcn_ghostbox_upper[0],
+              D1, 
+              &D1_ghostbox_lower[0],
+              &D1_ghostbox_upper[0],
+              &grad_phi_fillbox_lower[0],
+              &grad_phi_fillbox_upper[0],
+              &dx[0]);
 
-                LSM3D_UPWIND_HJ_ENO1(
-                  grad_phi[0], grad_phi[1], grad_phi[2],
-                  &grad_phi_ghostbox_lower[0],
-                  &grad_phi_ghostbox_upper[0],
-                  &grad_phi_ghostbox_lower[1],
-                  &grad_phi_ghostbox_upper[1],
-                  &grad_phi_ghostbox_lower[2],
-                  &grad_phi_ghostbox_upper[2],
-                  phi,
-                  &phi_ghostbox_lower[0],
-                  &phi_ghostbox_upper[0],
-                  &phi_ghostbox_lower[1],
-                  &phi_ghostbox_upper[1],
-                  &phi_ghostbox_lower[2],
-                  &phi_ghostbox_upper[2],
-                  upwind_function[0], 
-                  upwind_function[1], 
-                  upwind_function[2],
-                  &upwind_fcn_ghostbox_lower[0],
-                  &upwind_fcn_ghostbox_upper[0],
-                  &upwind_fcn_ghostbox_lower[1],
-                  &upwind_fcn_ghostbox_upper[1],
-                  &upwind_fcn_ghostbox_lower[2],
-                  &upwind_fcn_ghostbox_upper[2],
-                  D1, 
-                  &D1_ghostbox_lower[0],
-                  &D1_ghostbox_upper[0],
-                  &D1_ghostbox_lower[1],
-                  &D1_ghostbox_upper[1],
-                  &D1_ghostbox_lower[2],
-                  &D1_ghostbox_upper[2],
-                  &grad_phi_fillbox_lower[0],
-                  &grad_phi_fillbox_upper[0],
-                  &grad_phi_fillbox_lower[1],
-                  &grad_phi_fillbox_upper[1],
-                  &grad_phi_fillbox_lower[2],
-                  &grad_phi_fillbox_upper[2],
-                  &dx[0], &dx[1], &dx[2]);
+          } else {
 
-              } else if ( DIM == 2 ) {
+            TBOX_ERROR(  "LevelSetMethodToolbox::"
+                      << "computeUpwindSpatialDerivatives(): "
+                      << "Invalid value of DIM.  "
+                      << "Only DIM = 1, 2, and 3 are supported."
+                      << endl );
 
-                LSM2D_UPWIND_HJ_ENO1(
-                  grad_phi[0], grad_phi[1], 
-                  &grad_phi_ghostbox_lower[0],
-                  &grad_phi_ghostbox_upper[0],
-                  &grad_phi_ghostbox_lower[1],
-                  &grad_phi_ghostbox_upper[1],
-                  phi,
-                  &phi_ghostbox_lower[0],
-                  &phi_ghostbox_upper[0],
-                  &phi_ghostbox_lower[1],
-                  &phi_ghostbox_upper[1],
-                  upwind_function[0], 
-                  upwind_function[1], 
-                  &upwind_fcn_ghostbox_lower[0],
-                  &upwind_fcn_ghostbox_upper[0],
-                  &upwind_fcn_ghostbox_lower[1],
-                  &upwind_fcn_ghostbox_upper[1],
-                  D1, 
-                  &D1_ghostbox_lower[0],
-                  &D1_ghostbox_upper[0],
-                  &D1_ghostbox_lower[1],
-                  &D1_ghostbox_upper[1],
-                  &grad_phi_fillbox_lower[0],
-                  &grad_phi_fillbox_upper[0],
-                  &grad_phi_fillbox_lower[1],
-                  &grad_phi_fillbox_upper[1],
-                  &dx[0], &dx[1]);
+          } // end switch over dimensions
 
-              } else if ( DIM == 1 ) {
+          break;
+        }
+        case 2: {
 
-                LSM1D_UPWIND_HJ_ENO1(
-                  grad_phi[0], 
-                  &grad_phi_ghostbox_lower[0],
-                  &grad_phi_ghostbox_upper[0],
-                  phi,
-                  &phi_ghostbox_lower[0],
-                  &phi_ghostbox_upper[0],
-                  upwind_function[0], 
-                  &upwind_fcn_ghostbox_lower[0],
-                  &upwind_fcn_ghostbox_upper[0],
-                  D1, 
-                  &D1_ghostbox_lower[0],
-                  &D1_ghostbox_upper[0],
-                  &grad_phi_fillbox_lower[0],
-                  &grad_phi_fillbox_upper[0],
-                  &dx[0]);
+          Pointer< CellData<DIM,LSMLIB_REAL> > D1_data =
+            patch->getPatchData( s_D1_two_ghostcells_handle );
+          Pointer< CellData<DIM,LSMLIB_REAL> > D2_data =
+            patch->getPatchData( s_D2_two_ghostcells_handle );
 
-              } else {
+          Box<DIM> D1_ghostbox = D1_data->getGhostBox();
+          const IntVector<DIM> D1_ghostbox_lower = D1_ghostbox.lower();
+          const IntVector<DIM> D1_ghostbox_upper = D1_ghostbox.upper();
+          Box<DIM> D2_ghostbox = D2_data->getGhostBox();
+          const IntVector<DIM> D2_ghostbox_lower = D2_ghostbox.lower();
+          const IntVector<DIM> D2_ghostbox_upper = D2_ghostbox.upper();
 
-                TBOX_ERROR(  "LevelSetMethodToolbox::"
-                          << "computeUpwindSpatialDerivatives(): "
-                          << "Invalid value of DIM.  "
-                          << "Only DIM = 1, 2, and 3 are supported."
-                          << endl );
+          LSMLIB_REAL* D1 = D1_data->getPointer();
+          LSMLIB_REAL* D2 = D2_data->getPointer();
 
-              } // end switch over dimensions
+          if ( DIM == 3 ) {
 
-              // deallocate scratch PatchData
-              patch->deallocatePatchData( s_D1_one_ghostcell_handle );
+            LSM3D_UPWIND_HJ_ENO2(
+              grad_phi[0], grad_phi[1], grad_phi[2],
+              &grad_phi_ghostbox_lower[0],
+              &grad_phi_ghostbox_upper[0],
+              &grad_phi_ghostbox_lower[1],
+              &grad_phi_ghostbox_upper[1],
+              &grad_phi_ghostbox_lower[2],
+              &grad_phi_ghostbox_upper[2],
+              phi,
+              &phi_ghostbox_lower[0],
+              &phi_ghostbox_upper[0],
+              &phi_ghostbox_lower[1],
+              &phi_ghostbox_upper[1],
+              &phi_ghostbox_lower[2],
+              &phi_ghostbox_upper[2],
+              upwind_function[0], 
+              upwind_function[1], 
+              upwind_function[2],
+              &upwind_fcn_ghostbox_lower[0],
+              &upwind_fcn_ghostbox_upper[0],
+              &upwind_fcn_ghostbox_lower[1],
+              &upwind_fcn_ghostbox_upper[1],
+              &upwind_fcn_ghostbox_lower[2],
+              &upwind_fcn_ghostbox_upper[2],
+              D1,
+              &D1_ghostbox_lower[0],
+              &D1_ghostbox_upper[0],
+              &D1_ghostbox_lower[1],
+              &D1_ghostbox_upper[1],
+              &D1_ghostbox_lower[2],
+              &D1_ghostbox_upper[2],
+              D2,
+              &D2_ghostbox_lower[0],
+              &D2_ghostbox_upper[0],
+              &D2_ghostbox_lower[1],
+              &D2_ghostbox_upper[1],
+              &D2_ghostbox_lower[2],
+              &D2_ghostbox_upper[2],
+              &grad_phi_fillbox_lower[0],
+              &grad_phi_fillbox_upper[0],
+              &grad_phi_fillbox_lower[1],
+              &grad_phi_fillbox_upper[1],
+              &grad_phi_fillbox_lower[2],
+              &grad_phi_fillbox_upper[2],
+              &dx[0], &dx[1], &dx[2]);
+  
+          } else if ( DIM == 2 ) {
 
-              break;
-            }
-            case 2: {
+            LSM2D_UPWIND_HJ_ENO2(
+              grad_phi[0], grad_phi[1], 
+              &grad_phi_ghostbox_lower[0],
+              &grad_phi_ghostbox_upper[0],
+              &grad_phi_ghostbox_lower[1],
+              &grad_phi_ghostbox_upper[1],
+              phi,
+              &phi_ghostbox_lower[0],
+              &phi_ghostbox_upper[0],
+              &phi_ghostbox_lower[1],
+              &phi_ghostbox_upper[1],
+              upwind_function[0], 
+              upwind_function[1], 
+              &upwind_fcn_ghostbox_lower[0],
+              &upwind_fcn_ghostbox_upper[0],
+              &upwind_fcn_ghostbox_lower[1],
+              &upwind_fcn_ghostbox_upper[1],
+              D1,
+              &D1_ghostbox_lower[0],
+              &D1_ghostbox_upper[0],
+              &D1_ghostbox_lower[1],
+              &D1_ghostbox_upper[1],
+              D2,
+              &D2_ghostbox_lower[0],
+              &D2_ghostbox_upper[0],
+              &D2_ghostbox_lower[1],
+              &D2_ghostbox_upper[1],
+              &grad_phi_fillbox_lower[0],
+              &grad_phi_fillbox_upper[0],
+              &grad_phi_fillbox_lower[1],
+              &grad_phi_fillbox_upper[1],
+              &dx[0], &dx[1]);
 
-              // prepare scratch PatchData
-              patch->allocatePatchData( s_D1_two_ghostcells_handle );
-              patch->allocatePatchData( s_D2_two_ghostcells_handle );
+          } else if ( DIM == 1 ) {
+  
+            LSM1D_UPWIND_HJ_ENO2(
+              grad_phi[0], 
+              &grad_phi_ghostbox_lower[0],
+              &grad_phi_ghostbox_upper[0],
+              phi,
+              &phi_ghostbox_lower[0],
+              &phi_ghostbox_upper[0],
+              upwind_function[0], 
+              &upwind_fcn_ghostbox_lower[0],
+              &upwind_fcn_ghostbox_upper[0],
+              D1,
+              &D1_ghostbox_lower[0],
+              &D1_ghostbox_upper[0],
+              D2,
+              &D2_ghostbox_lower[0],
+              &D2_ghostbox_upper[0],
+              &grad_phi_fillbox_lower[0],
+              &grad_phi_fillbox_upper[0],
+              &dx[0]);
 
-              Pointer< CellData<DIM,LSMLIB_REAL> > D1_data =
-                patch->getPatchData( s_D1_two_ghostcells_handle );
-              Pointer< CellData<DIM,LSMLIB_REAL> > D2_data =
-                patch->getPatchData( s_D2_two_ghostcells_handle );
+          } else {
 
-              Box<DIM> D1_ghostbox = D1_data->getGhostBox();
-              const IntVector<DIM> D1_ghostbox_lower = D1_ghostbox.lower();
-              const IntVector<DIM> D1_ghostbox_upper = D1_ghostbox.upper();
-              Box<DIM> D2_ghostbox = D2_data->getGhostBox();
-              const IntVector<DIM> D2_ghostbox_lower = D2_ghostbox.lower();
-              const IntVector<DIM> D2_ghostbox_upper = D2_ghostbox.upper();
+            TBOX_ERROR(  "LevelSetMethodToolbox::"
+                      << "computeUpwindSpatialDerivatives(): "
+                      << "Invalid value of DIM.  "
+                      << "Only DIM = 1, 2, and 3 are supported."
+                      << endl );
 
-              LSMLIB_REAL* D1 = D1_data->getPointer();
-              LSMLIB_REAL* D2 = D2_data->getPointer();
+          } // end switch over dimensions
 
-              if ( DIM == 3 ) {
+          break;
+        }
+        case 3: {
+
+          Pointer< CellData<DIM,LSMLIB_REAL> > D1_data =
+            patch->getPatchData( s_D1_three_ghostcells_handle );
+          Pointer< CellData<DIM,LSMLIB_REAL> > D2_data =
+            patch->getPatchData( s_D2_three_ghostcells_handle );
+          Pointer< CellData<DIM,LSMLIB_REAL> > D3_data =
+            patch->getPatchData( s_D3_three_ghostcells_handle );
+
+          Box<DIM> D1_ghostbox = D1_data->getGhostBox();
+          const IntVector<DIM> D1_ghostbox_lower = D1_ghostbox.lower();
+          const IntVector<DIM> D1_ghostbox_upper = D1_ghostbox.upper();
+          Box<DIM> D2_ghostbox = D2_data->getGhostBox();
+          const IntVector<DIM> D2_ghostbox_lower = D2_ghostbox.lower();
+          const IntVector<DIM> D2_ghostbox_upper = D2_ghostbox.upper();
+          Box<DIM> D3_ghostbox = D3_data->getGhostBox();
+          const IntVector<DIM> D3_ghostbox_lower = D3_ghostbox.lower();
+          const IntVector<DIM> D3_ghostbox_upper = D3_ghostbox.upper();
+
+          LSMLIB_REAL* D1 = D1_data->getPointer();
+          LSMLIB_REAL* D2 = D2_data->getPointer();
+          LSMLIB_REAL* D3 = D3_data->getPointer();
 
-                LSM3D_UPWIND_HJ_ENO2(
-                  grad_phi[0], grad_phi[1], grad_phi[2],
-                  &grad_phi_ghostbox_lower[0],
-                  &grad_phi_ghostbox_upper[0],
-                  &grad_phi_ghostbox_lower[1],
-                  &grad_phi_ghostbox_upper[1],
-                  &grad_phi_ghostbox_lower[2],
-                  &grad_phi_ghostbox_upper[2],
-                  phi,
-                  &phi_ghostbox_lower[0],
-                  &phi_ghostbox_upper[0],
-                  &phi_ghostbox_lower[1],
-                  &phi_ghostbox_upper[1],
-                  &phi_ghostbox_lower[2],
-                  &phi_ghostbox_upper[2],
-                  upwind_function[0], 
-                  upwind_function[1], 
-                  upwind_function[2],
-                  &upwind_fcn_ghostbox_lower[0],
-                  &upwind_fcn_ghostbox_upper[0],
-                  &upwind_fcn_ghostbox_lower[1],
-                  &upwind_fcn_ghostbox_upper[1],
-                  &upwind_fcn_ghostbox_lower[2],
-                  &upwind_fcn_ghostbox_upper[2],
-                  D1,
-                  &D1_ghostbox_lower[0],
-                  &D1_ghostbox_upper[0],
-                  &D1_ghostbox_lower[1],
-                  &D1_ghostbox_upper[1],
-                  &D1_ghostbox_lower[2],
-                  &D1_ghostbox_upper[2],
-                  D2,
-                  &D2_ghostbox_lower[0],
-                  &D2_ghostbox_upper[0],
-                  &D2_ghostbox_lower[1],
-                  &D2_ghostbox_upper[1],
-                  &D2_ghostbox_lower[2],
-                  &D2_ghostbox_upper[2],
-                  &grad_phi_fillbox_lower[0],
-                  &grad_phi_fillbox_upper[0],
-                  &grad_phi_fillbox_lower[1],
-                  &grad_phi_fillbox_upper[1],
-                  &grad_phi_fillbox_lower[2],
-                  &grad_phi_fillbox_upper[2],
-                  &dx[0], &dx[1], &dx[2]);
-  
-              } else if ( DIM == 2 ) {
+          if ( DIM == 3 ) {
 
-                LSM2D_UPWIND_HJ_ENO2(
-                  grad_phi[0], grad_phi[1], 
-                  &grad_phi_ghostbox_lower[0],
-                  &grad_phi_ghostbox_upper[0],
-                  &grad_phi_ghostbox_lower[1],
-                  &grad_phi_ghostbox_upper[1],
-                  phi,
-                  &phi_ghostbox_lower[0],
-                  &phi_ghostbox_upper[0],
-                  &phi_ghostbox_lower[1],
-                  &phi_ghostbox_upper[1],
-                  upwind_function[0], 
-                  upwind_function[1], 
-                  &upwind_fcn_ghostbox_lower[0],
-                  &upwind_fcn_ghostbox_upper[0],
-                  &upwind_fcn_ghostbox_lower[1],
-                  &upwind_fcn_ghostbox_upper[1],
-                  D1,
-                  &D1_ghostbox_lower[0],
-                  &D1_ghostbox_upper[0],
-                  &D1_ghostbox_lower[1],
-                  &D1_ghostbox_upper[1],
-                  D2,
-                  &D2_ghostbox_lower[0],
-                  &D2_ghostbox_upper[0],
-                  &D2_ghostbox_lower[1],
-                  &D2_ghostbox_upper[1],
-                  &grad_phi_fillbox_lower[0],
-                  &grad_phi_fillbox_upper[0],
-                  &grad_phi_fillbox_lower[1],
-                  &grad_phi_fillbox_upper[1],
-                  &dx[0], &dx[1]);
-
-              } else if ( DIM == 1 ) {
+            LSM3D_UPWIND_HJ_ENO3(
+              grad_phi[0], grad_phi[1], grad_phi[2],
+              &grad_phi_ghostbox_lower[0],
+              &grad_phi_ghostbox_upper[0],
+              &grad_phi_ghostbox_lower[1],
+              &grad_phi_ghostbox_upper[1],
+              &grad_phi_ghostbox_lower[2],
+              &grad_phi_ghostbox_upper[2],
+              phi,
+              &phi_ghostbox_lower[0],
+              &phi_ghostbox_upper[0],
+              &phi_ghostbox_lower[1],
+              &phi_ghostbox_upper[1],
+              &phi_ghostbox_lower[2],
+              &phi_ghostbox_upper[2],
+              upwind_function[0], 
+              upwind_function[1], 
+              upwind_function[2],
+              &upwind_fcn_ghostbox_lower[0],
+              &upwind_fcn_ghostbox_upper[0],
+              &upwind_fcn_ghostbox_lower[1],
+              &upwind_fcn_ghostbox_upper[1],
+              &upwind_fcn_ghostbox_lower[2],
+              &upwind_fcn_ghostbox_upper[2],
+              D1,
+              &D1_ghostbox_lower[0],
+              &D1_ghostbox_upper[0],
+              &D1_ghostbox_lower[1],
+              &D1_ghostbox_upper[1],
+              &D1_ghostbox_lower[2],
+              &D1_ghostbox_upper[2],
+              D2,
+              &D2_ghostbox_lower[0],
+              &D2_ghostbox_upper[0],
+              &D2_ghostbox_lower[1],
+              &D2_ghostbox_upper[1],
+              &D2_ghostbox_lower[2],
+              &D2_ghostbox_upper[2],
+              D3,
+              &D3_ghostbox_lower[0],
+              &D3_ghostbox_upper[0],
+              &D3_ghostbox_lower[1],
+              &D3_ghostbox_upper[1],
+              &D3_ghostbox_lower[2],
+              &D3_ghostbox_upper[2],
+              &grad_phi_fillbox_lower[0],
+              &grad_phi_fillbox_upper[0],
+              &grad_phi_fillbox_lower[1],
+              &grad_phi_fillbox_upper[1],
+              &grad_phi_fillbox_lower[2],
+              &grad_phi_fillbox_upper[2],
+              &dx[0], &dx[1], &dx[2]);
   
-                LSM1D_UPWIND_HJ_ENO2(
-                  grad_phi[0], 
-                  &grad_phi_ghostbox_lower[0],
-                  &grad_phi_ghostbox_upper[0],
-                  phi,
-                  &phi_ghostbox_lower[0],
-                  &phi_ghostbox_upper[0],
-                  upwind_function[0], 
-                  &upwind_fcn_ghostbox_lower[0],
-                  &upwind_fcn_ghostbox_upper[0],
-                  D1,
-                  &D1_ghostbox_lower[0],
-                  &D1_ghostbox_upper[0],
-                  D2,
-                  &D2_ghostbox_lower[0],
-                  &D2_ghostbox_upper[0],
-                  &grad_phi_fillbox_lower[0],
-                  &grad_phi_fillbox_upper[0],
-                  &dx[0]);
+          } else if ( DIM == 2 ) {
 
-              } else {
+            LSM2D_UPWIND_HJ_ENO3(
+              grad_phi[0], grad_phi[1],
+              &grad_phi_ghostbox_lower[0],
+              &grad_phi_ghostbox_upper[0],
+              &grad_phi_ghostbox_lower[1],
+              &grad_phi_ghostbox_upper[1],
+              phi,
+              &phi_ghostbox_lower[0],
+              &phi_ghostbox_upper[0],
+              &phi_ghostbox_lower[1],
+              &phi_ghostbox_upper[1],
+              upwind_function[0], 
+              upwind_function[1], 
+              &upwind_fcn_ghostbox_lower[0],
+              &upwind_fcn_ghostbox_upper[0],
+              &upwind_fcn_ghostbox_lower[1],
+              &upwind_fcn_ghostbox_upper[1],
+              D1,
+              &D1_ghostbox_lower[0],
+              &D1_ghostbox_upper[0],
+              &D1_ghostbox_lower[1],
+              &D1_ghostbox_upper[1],
+              D2,
+              &D2_ghostbox_lower[0],
+              &D2_ghostbox_upper[0],
+              &D2_ghostbox_lower[1],
+              &D2_ghostbox_upper[1],
+              D3,
+              &D3_ghostbox_lower[0],
+              &D3_ghostbox_upper[0],
+              &D3_ghostbox_lower[1],
+              &D3_ghostbox_upper[1],
+              &grad_phi_fillbox_lower[0],
+              &grad_phi_fillbox_upper[0],
+              &grad_phi_fillbox_lower[1],
+              &grad_phi_fillbox_upper[1],
+              &dx[0], &dx[1]);
+  
+          } else if ( DIM == 1 ) {
 
-                TBOX_ERROR(  "LevelSetMethodToolbox::"
-                          << "computeUpwindSpatialDerivatives(): "
-                          << "Invalid value of DIM.  "
-                          << "Only DIM = 1, 2, and 3 are supported."
-                          << endl );
+            LSM1D_UPWIND_HJ_ENO3(
+              grad_phi[0], 
+              &grad_phi_ghostbox_lower[0],
+              &grad_phi_ghostbox_upper[0],
+              phi,
+              &phi_ghostbox_lower[0],
+              &phi_ghostbox_upper[0],
+              upwind_function[0], 
+              &upwind_fcn_ghostbox_lower[0],
+              &upwind_fcn_ghostbox_upper[0],
+              D1,
+              &D1_ghostbox_lower[0],
+              &D1_ghostbox_upper[0],
+              D2,
+              &D2_ghostbox_lower[0],
+              &D2_ghostbox_upper[0],
+              D3,
+              &D3_ghostbox_lower[0],
+              &D3_ghostbox_upper[0],
+              &grad_phi_fillbox_lower[0],
+              &grad_phi_fillbox_upper[0],
+              &dx[0]);
 
-              } // end switch over dimensions
+          } else {
 
-              // deallocate scratch PatchData
-              patch->deallocatePatchData( s_D1_two_ghostcells_handle );
-              patch->deallocatePatchData( s_D2_two_ghostcells_handle );
+            TBOX_ERROR(  "LevelSetMethodToolbox::"
+                      << "computeUpwindSpatialDerivatives(): "
+                      << "Invalid value of DIM.  "
+                      << "Only DIM = 1, 2, and 3 are supported."
+                      << endl );
+          }
 
-              break;
-            }
-            case 3: {
+          break;
+        }
+        default: {
+          TBOX_ERROR(  "LevelSetMethodToolbox::"
+                    << "computeUpwindSpatialDerivatives(): "
+                    << "Unsupported order for ENO derivative.  "
+                    << "Only ENO1, ENO2, and ENO3 supported."
+                    << endl );
+        }
+      } // end switch on ENO spatial derivative order
 
-              // prepare scratch PatchData
-              patch->allocatePatchData( s_D1_three_ghostcells_handle );
-              patch->allocatePatchData( s_D2_three_ghostcells_handle );
-              patch->allocatePatchData( s_D3_three_ghostcells_handle );
+      break;
+    } // end case ENO
 
-              Pointer< CellData<DIM,LSMLIB_REAL> > D1_data =
-                patch->getPatchData( s_D1_three_ghostcells_handle );
-              Pointer< CellData<DIM,LSMLIB_REAL> > D2_data =
-                patch->getPatchData( s_D2_three_ghostcells_handle );
-              Pointer< CellData<DIM,LSMLIB_REAL> > D3_data =
-                patch->getPatchData( s_D3_three_ghostcells_handle );
+    case WENO: {
+      switch (spatial_derivative_order) { 
+        case 5: {
 
-              Box<DIM> D1_ghostbox = D1_data->getGhostBox();
-              const IntVector<DIM> D1_ghostbox_lower = D1_ghostbox.lower();
-              const IntVector<DIM> D1_ghostbox_upper = D1_ghostbox.upper();
-              Box<DIM> D2_ghostbox = D2_data->getGhostBox();
-              const IntVector<DIM> D2_ghostbox_lower = D2_ghostbox.lower();
-              const IntVector<DIM> D2_ghostbox_upper = D2_ghostbox.upper();
-              Box<DIM> D3_ghostbox = D3_data->getGhostBox();
-              const IntVector<DIM> D3_ghostbox_lower = D3_ghostbox.lower();
-              const IntVector<DIM> D3_ghostbox_upper = D3_ghostbox.upper();
+          Pointer< CellData<DIM,LSMLIB_REAL> > D1_data =
+            patch->getPatchData( s_D1_three_ghostcells_handle );
 
-              LSMLIB_REAL* D1 = D1_data->getPointer();
-              LSMLIB_REAL* D2 = D2_data->getPointer();
-              LSMLIB_REAL* D3 = D3_data->getPointer();
+          Box<DIM> D1_ghostbox = D1_data->getGhostBox();
+          const IntVector<DIM> D1_ghostbox_lower = D1_ghostbox.lower();
+          const IntVector<DIM> D1_ghostbox_upper = D1_ghostbox.upper();
 
-              if ( DIM == 3 ) {
+          LSMLIB_REAL* D1 = D1_data->getPointer();
 
-                LSM3D_UPWIND_HJ_ENO3(
-                  grad_phi[0], grad_phi[1], grad_phi[2],
-                  &grad_phi_ghostbox_lower[0],
-                  &grad_phi_ghostbox_upper[0],
-                  &grad_phi_ghostbox_lower[1],
-                  &grad_phi_ghostbox_upper[1],
-                  &grad_phi_ghostbox_lower[2],
-                  &grad_phi_ghostbox_upper[2],
-                  phi,
-                  &phi_ghostbox_lower[0],
-                  &phi_ghostbox_upper[0],
-                  &phi_ghostbox_lower[1],
-                  &phi_ghostbox_upper[1],
-                  &phi_ghostbox_lower[2],
-                  &phi_ghostbox_upper[2],
-                  upwind_function[0], 
-                  upwind_function[1], 
-                  upwind_function[2],
-                  &upwind_fcn_ghostbox_lower[0],
-                  &upwind_fcn_ghostbox_upper[0],
-                  &upwind_fcn_ghostbox_lower[1],
-                  &upwind_fcn_ghostbox_upper[1],
-                  &upwind_fcn_ghostbox_lower[2],
-                  &upwind_fcn_ghostbox_upper[2],
-                  D1,
-                  &D1_ghostbox_lower[0],
-                  &D1_ghostbox_upper[0],
-                  &D1_ghostbox_lower[1],
-                  &D1_ghostbox_upper[1],
-                  &D1_ghostbox_lower[2],
-                  &D1_ghostbox_upper[2],
-                  D2,
-                  &D2_ghostbox_lower[0],
-                  &D2_ghostbox_upper[0],
-                  &D2_ghostbox_lower[1],
-                  &D2_ghostbox_upper[1],
-                  &D2_ghostbox_lower[2],
-                  &D2_ghostbox_upper[2],
-                  D3,
-                  &D3_ghostbox_lower[0],
-                  &D3_ghostbox_upper[0],
-                  &D3_ghostbox_lower[1],
-                  &D3_ghostbox_upper[1],
-                  &D3_ghostbox_lower[2],
-                  &D3_ghostbox_upper[2],
-                  &grad_phi_fillbox_lower[0],
-                  &grad_phi_fillbox_upper[0],
-                  &grad_phi_fillbox_lower[1],
-                  &grad_phi_fillbox_upper[1],
-                  &grad_phi_fillbox_lower[2],
-                  &grad_phi_fillbox_upper[2],
-                  &dx[0], &dx[1], &dx[2]);
-  
-              } else if ( DIM == 2 ) {
+          if ( DIM == 3 ) {
 
-                LSM2D_UPWIND_HJ_ENO3(
-                  grad_phi[0], grad_phi[1],
-                  &grad_phi_ghostbox_lower[0],
-                  &grad_phi_ghostbox_upper[0],
-                  &grad_phi_ghostbox_lower[1],
-                  &grad_phi_ghostbox_upper[1],
-                  phi,
-                  &phi_ghostbox_lower[0],
-                  &phi_ghostbox_upper[0],
-                  &phi_ghostbox_lower[1],
-                  &phi_ghostbox_upper[1],
-                  upwind_function[0], 
-                  upwind_function[1], 
-                  &upwind_fcn_ghostbox_lower[0],
-                  &upwind_fcn_ghostbox_upper[0],
-                  &upwind_fcn_ghostbox_lower[1],
-                  &upwind_fcn_ghostbox_upper[1],
-                  D1,
-                  &D1_ghostbox_lower[0],
-                  &D1_ghostbox_upper[0],
-                  &D1_ghostbox_lower[1],
-                  &D1_ghostbox_upper[1],
-                  D2,
-                  &D2_ghostbox_lower[0],
-                  &D2_ghostbox_upper[0],
-                  &D2_ghostbox_lower[1],
-                  &D2_ghostbox_upper[1],
-                  D3,
-                  &D3_ghostbox_lower[0],
-                  &D3_ghostbox_upper[0],
-                  &D3_ghostbox_lower[1],
-                  &D3_ghostbox_upper[1],
-                  &grad_phi_fillbox_lower[0],
-                  &grad_phi_fillbox_upper[0],
-                  &grad_phi_fillbox_lower[1],
-                  &grad_phi_fillbox_upper[1],
-                  &dx[0], &dx[1]);
+            LSM3D_UPWIND_HJ_WENO5_SIMD(
+              grad_phi[0], grad_phi[1], grad_phi[2],
+              &grad_phi_ghostbox_lower[0],
+              &grad_phi_ghostbox_upper[0],
+              &grad_phi_ghostbox_lower[1],
+              &grad_phi_ghostbox_upper[1],
+              &grad_phi_ghostbox_lower[2],
+              &grad_phi_ghostbox_upper[2],
+              phi,
+              &phi_ghostbox_lower[0],
+              &phi_ghostbox_upper[0],
+              &phi_ghostbox_lower[1],
+              &phi_ghostbox_upper[1],
+              &phi_ghostbox_lower[2],
+              &phi_ghostbox_upper[2],
+              upwind_function[0], 
+              upwind_function[1], 
+              upwind_function[2],
+              &upwind_fcn_ghostbox_lower[0],
+              &upwind_fcn_ghostbox_upper[0],
+              &upwind_fcn_ghostbox_lower[1],
+              &upwind_fcn_ghostbox_upper[1],
+              &upwind_fcn_ghostbox_lower[2],
+              &upwind_fcn_ghostbox_upper[2],
+              D1,
+              &D1_ghostbox_lower[0],
+              &D1_ghostbox_upper[0],
+              &D1_ghostbox_lower[1],
+              &D1_ghostbox_upper[1],
+              &D1_ghostbox_lower[2],
+              &D1_ghostbox_upper[2],
+              &grad_phi_fillbox_lower[0],
+              &grad_phi_fillbox_upper[0],
+              &grad_phi_fillbox_lower[1],
+              &grad_phi_fillbox_upper[1],
+              &grad_phi_fillbox_lower[2],
+              &grad_phi_fillbox_upper[2],
+              &dx[0], &dx[1], &dx[2]);
   
-              } else if ( DIM == 1 ) {
+          } else if ( DIM == 2 ) {
 
-                LSM1D_UPWIND_HJ_ENO3(
-                  grad_phi[0], 
-                  &grad_phi_ghostbox_lower[0],
-                  &grad_phi_ghostbox_upper[0],
-                  phi,
-                  &phi_ghostbox_lower[0],
-                  &phi_ghostbox_upper[0],
-                  upwind_function[0], 
-                  &upwind_fcn_ghostbox_lower[0],
-                  &upwind_fcn_ghostbox_upper[0],
-                  D1,
-                  &D1_ghostbox_lower[0],
-                  &D1_ghostbox_upper[0],
-                  D2,
-                  &D2_ghostbox_lower[0],
-                  &D2_ghostbox_upper[0],
-                  D3,
-                  &D3_ghostbox_lower[0],
-                  &D3_ghostbox_upper[0],
-                  &grad_phi_fillbox_lower[0],
-                  &grad_phi_fillbox_upper[0],
-                  &dx[0]);
+            LSM2D_UPWIND_HJ_WENO5_SIMD(
+              grad_phi[0], grad_phi[1],
+              &grad_phi_ghostbox_lower[0],
+              &grad_phi_ghostbox_upper[0],
+              &grad_phi_ghostbox_lower[1],
+              &grad_phi_ghostbox_upper[1],
+              phi,
+              &phi_ghostbox_lower[0],
+              &phi_ghostbox_upper[0],
+              &phi_ghostbox_lower[1],
+              &phi_ghostbox_upper[1],
+              upwind_function[0], 
+              upwind_function[1], 
+              &upwind_fcn_ghostbox_lower[0],
+              &upwind_fcn_ghostbox_upper[0],
+              &upwind_fcn_ghostbox_lower[1],
+              &upwind_fcn_ghostbox_upper[1],
+              D1,
+              &D1_ghostbox_lower[0],
+              &D1_ghostbox_upper[0],
+              &D1_ghostbox_lower[1],
+              &D1_ghostbox_upper[1],
+              &grad_phi_fillbox_lower[0],
+              &grad_phi_fillbox_upper[0],
+              &grad_phi_fillbox_lower[1],
+              &grad_phi_fillbox_upper[1],
+              &dx[0], &dx[1]);
 
-              } else {
+          } else if ( DIM == 1 ) {
 
-                TBOX_ERROR(  "LevelSetMethodToolbox::"
-                          << "computeUpwindSpatialDerivatives(): "
-                          << "Invalid value of DIM.  "
-                          << "Only DIM = 1, 2, and 3 are supported."
-                          << endl );
-              }
+            LSM1D_UPWIND_HJ_WENO5(
+              grad_phi[0],
+              &grad_phi_ghostbox_lower[0],
+              &grad_phi_ghostbox_upper[0],
+              phi,
+              &phi_ghostbox_lower[0],
+              &phi_ghostbox_upper[0],
+              upwind_function[0], 
+              &upwind_fcn_ghostbox_lower[0],
+              &upwind_fcn_ghostbox_upper[0],
+              D1,
+              &D1_ghostbox_lower[0],
+              &D1_ghostbox_upper[0],
+              &grad_phi_fillbox_lower[0],
+              &grad_phi_fillbox_upper[0],
+              &dx[0]);
 
-              // deallocate scratch PatchData
-              patch->deallocatePatchData( s_D1_three_ghostcells_handle );
-              patch->deallocatePatchData( s_D2_three_ghostcells_handle );
-              patch->deallocatePatchData( s_D3_three_ghostcells_handle );
+          } else {
 
-              break;
-            }
-            default: {
-              TBOX_ERROR(  "LevelSetMethodToolbox::"
-                        << "computeUpwindSpatialDerivatives(): "
-                        << "Unsupported order for ENO derivative.  "
-                        << "Only ENO1, ENO2, and ENO3 supported."
-                        << endl );
-            }
-          } // end switch on ENO spatial derivative order
+            TBOX_ERROR(  "LevelSetMethodToolbox::"
+                      << "computeUpwindSpatialDerivatives(): "
+                      << "Invalid value of DIM.  "
+                      << "Only DIM = 1, 2, and 3 are supported."
+                      << endl );
+          }
 
           break;
-        } // end case ENO
+        }
+        default: {
+          TBOX_ERROR(  "LevelSetMethodToolbox::"
+                    << "computeUpwindSpatialDerivatives(): "
+                    << "Unsupported order for WENO derivative.  "
+                    << "Only WENO5 supported."
+                    << endl );
+        }
 
-        case WENO: {
-          switch (spatial_derivative_order) { 
-            case 5: {
+      } // end switch on WENO spatial derivative order
 
-              // prepare scratch PatchData
-              patch->allocatePatchData( s_D1_three_ghostcells_handle );
-
-              Pointer< CellData<DIM,LSMLIB_REAL> > D1_data =
-                patch->getPatchData( s_D1_three_ghostcells_handle );
-
-              Box<DIM> D1_ghostbox = D1_data->getGhostBox();
-              const IntVector<DIM> D1_ghostbox_lower = D1_ghostbox.lower();
-              const IntVector<DIM> D1_ghostbox_upper = D1_ghostbox.upper();
-
-              LSMLIB_REAL* D1 = D1_data->getPointer();
-
-              if ( DIM == 3 ) {
-
-                LSM3D_UPWIND_HJ_WENO5(
-                  grad_phi[0], grad_phi[1], grad_phi[2],
-                  &grad_phi_ghostbox_lower[0],
-                  &grad_phi_ghostbox_upper[0],
-                  &grad_phi_ghostbox_lower[1],
-                  &grad_phi_ghostbox_upper[1],
-                  &grad_phi_ghostbox_lower[2],
-                  &grad_phi_ghostbox_upper[2],
-                  phi,
-                  &phi_ghostbox_lower[0],
-                  &phi_ghostbox_upper[0],
-                  &phi_ghostbox_lower[1],
-                  &phi_ghostbox_upper[1],
-                  &phi_ghostbox_lower[2],
-                  &phi_ghostbox_upper[2],
-                  upwind_function[0], 
-                  upwind_function[1], 
-                  upwind_function[2],
-                  &upwind_fcn_ghostbox_lower[0],
-                  &upwind_fcn_ghostbox_upper[0],
-                  &upwind_fcn_ghostbox_lower[1],
-                  &upwind_fcn_ghostbox_upper[1],
-                  &upwind_fcn_ghostbox_lower[2],
-                  &upwind_fcn_ghostbox_upper[2],
-                  D1,
-                  &D1_ghostbox_lower[0],
-                  &D1_ghostbox_upper[0],
-                  &D1_ghostbox_lower[1],
-                  &D1_ghostbox_upper[1],
-                  &D1_ghostbox_lower[2],
-                  &D1_ghostbox_upper[2],
-                  &grad_phi_fillbox_lower[0],
-                  &grad_phi_fillbox_upper[0],
-                  &grad_phi_fillbox_lower[1],
-                  &grad_phi_fillbox_upper[1],
-                  &grad_phi_fillbox_lower[2],
-                  &grad_phi_fillbox_upper[2],
-                  &dx[0], &dx[1], &dx[2]);
-  
-              } else if ( DIM == 2 ) {
-
-                LSM2D_UPWIND_HJ_WENO5(
-                  grad_phi[0], grad_phi[1],
-                  &grad_phi_ghostbox_lower[0],
-                  &grad_phi_ghostbox_upper[0],
-                  &grad_phi_ghostbox_lower[1],
-                  &grad_phi_ghostbox_upper[1],
-                  phi,
-                  &phi_ghostbox_lower[0],
-                  &phi_ghostbox_upper[0],
-                  &phi_ghostbox_lower[1],
-                  &phi_ghostbox_upper[1],
-                  upwind_function[0], 
-                  upwind_function[1], 
-                  &upwind_fcn_ghostbox_lower[0],
-                  &upwind_fcn_ghostbox_upper[0],
-                  &upwind_fcn_ghostbox_lower[1],
-                  &upwind_fcn_ghostbox_upper[1],
-                  D1,
-                  &D1_ghostbox_lower[0],
-                  &D1_ghostbox_upper[0],
-                  &D1_ghostbox_lower[1],
-                  &D1_ghostbox_upper[1],
-                  &grad_phi_fillbox_lower[0],
-                  &grad_phi_fillbox_upper[0],
-                  &grad_phi_fillbox_lower[1],
-                  &grad_phi_fillbox_upper[1],
-                  &dx[0], &dx[1]);
-
-              } else if ( DIM == 1 ) {
-
-                LSM1D_UPWIND_HJ_WENO5(
-                  grad_phi[0],
-                  &grad_phi_ghostbox_lower[0],
-                  &grad_phi_ghostbox_upper[0],
-                  phi,
-                  &phi_ghostbox_lower[0],
-                  &phi_ghostbox_upper[0],
-                  upwind_function[0], 
-                  &upwind_fcn_ghostbox_lower[0],
-                  &upwind_fcn_ghostbox_upper[0],
-                  D1,
-                  &D1_ghostbox_lower[0],
-                  &D1_ghostbox_upper[0],
-                  &grad_phi_fillbox_lower[0],
-                  &grad_phi_fillbox_upper[0],
-                  &dx[0]);
-
-              } else {
-
-                TBOX_ERROR(  "LevelSetMethodToolbox::"
-                          << "computeUpwindSpatialDerivatives(): "
-                          << "Invalid value of DIM.  "
-                          << "Only DIM = 1, 2, and 3 are supported."
-                          << endl );
-              }
-
-              // deallocate scratch PatchData
-              patch->deallocatePatchData( s_D1_three_ghostcells_handle );
-
-              break;
-            }
-            default: {
-              TBOX_ERROR(  "LevelSetMethodToolbox::"
-                        << "computeUpwindSpatialDerivatives(): "
-                        << "Unsupported order for WENO derivative.  "
-                        << "Only WENO5 supported."
-                        << endl );
-            }
-
-          } // end switch on WENO spatial derivative order
-
-          break;
-        } // end case WENO
-
-        default: {
-          TBOX_ERROR(  "LevelSetMethodToolbox::"
-                    << "computeUpwindSpatialDerivatives(): "
-                    << "Unsupported spatial derivative type.  "
-                    << "Only ENO and WENO derivatives are supported."
-                    << endl );
-        }
+      break;
+    } // end case WENO
 
-      } // end switch on derivative type
+    default: {
+      TBOX_ERROR(  "LevelSetMethodToolbox::"
+                << "computeUpwindSpatialDerivatives(): "
+                << "Unsupported spatial derivative type.  "
+                << "Only ENO and WENO derivatives are supported."
+                << endl );
+    }
 
-    } // end loop over Patches
-  } // end loop over PatchLevels
+  } // end switch on derivative type
 }
 
 
@@ -775,18 +789,35 @@ void LevelSetMethodToolbox<DIM>::computePlusAndMinusSpatialDerivatives(
   const int phi_handle,
   const int phi_component)
 {
+  LevelSetMethodScopedTimer timer(
+    LevelSetMethodStatistics::getStatistics()->getTimer(
+      "LevelSetMethodToolbox::computePlusAndMinusSpatialDerivatives()"));
 
   // make sure that the scratch PatchData handles have been created
   initializeComputeSpatialDerivativesParameters();
 
+  // scratch PatchData is allocated for the entire level before the
+  // patch loop because PatchData allocation is not thread-safe
+  const ComponentSelector scratch_data = 
+    getSpatialDerivativesScratchData(spatial_derivative_type,
+                                     spatial_derivative_order);
+
   const int finest_level = hierarchy->getFinestLevelNumber();
   for ( int ln=0 ; ln<=finest_level ; ln++ ) {
 
     Pointer< PatchLevel<DIM> > level = hierarchy->getPatchLevel(ln);
     
-    typename PatchLevel<DIM>::Iterator pi;
-    for (pi.initialize(level); pi; pi++) { // loop over patches
-      const int pn = *pi;
+    level->allocatePatchData(scratch_data);
+
+    // patches are independent, so they may be processed concurrently
+    vector<int> patch_numbers;
+    getPatchNumbers(level, patch_numbers);
+    const int num_patches = patch_numbers.size();
+#ifdef _OPENMP
+#pragma omp parallel for schedule(dynamic)
+#endif
+    for (int p = 0; p < num_patches; p++) { // loop over patches
+      const int pn = patch_numbers[p];
       Pointer< Patch<DIM> > patch = level->getPatch(pn);
       if ( patch.isNull() ) {
         TBOX_ERROR(  "LevelSetMethodToolbox::"
@@ -795,629 +826,623 @@ void LevelSetMethodToolbox<DIM>::computePlusAndMinusSpatialDerivatives(
                   << endl );
       }
 
-      // compute spatial derivatives for phi
-      Pointer< CartesianPatchGeometry<DIM> > patch_geom =
-        patch->getPatchGeometry();
+      computePlusAndMinusSpatialDerivativesOnPatch(
+        patch,
+        spatial_derivative_type,
+        spatial_derivative_order,
+        grad_phi_plus_handle,
+        grad_phi_minus_handle,
+        phi_handle,
+        phi_component);
+
+    } // end loop over Patches
+
+    level->deallocatePatchData(scratch_data);
+  } // end loop over PatchLevels
+}
+
+
+/* computePlusAndMinusSpatialDerivativesOnPatch() */
+template <int DIM> 
+void LevelSetMethodToolbox<DIM>::computePlusAndMinusSpatialDerivativesOnPatch(
+  Pointer< Patch<DIM> > patch,
+  const SPATIAL_DERIVATIVE_TYPE spatial_derivative_type,
+  const int spatial_derivative_order,
+  const int grad_phi_plus_handle,
+  const int grad_phi_minus_handle,
+  const int phi_handle,
+  const int phi_component)
+{
+  // compute spatial derivatives for phi
+  Pointer< CartesianPatchGeometry<DIM> > patch_geom =
+    patch->getPatchGeometry();
 #ifdef LSMLIB_DOUBLE_PRECISION
-      const double* dx = patch_geom->getDx();
+  const double* dx = patch_geom->getDx();
 #else
-      const double* dx_double = patch_geom->getDx();
-      float dx[DIM];
-      for (int i = 0; i < DIM; i++) dx[i] = (float) dx_double[i];
+  const double* dx_double = patch_geom->getDx();
+  float dx[DIM];
+  for (int i = 0; i < DIM; i++) dx[i] = (float) dx_double[i];
 #endif
   
-      Pointer< CellData<DIM,LSMLIB_REAL> > grad_phi_plus_data =
-        patch->getPatchData( grad_phi_plus_handle );
-      Pointer< CellData<DIM,LSMLIB_REAL> > grad_phi_minus_data =
-        patch->getPatchData( grad_phi_minus_handle );
-      Pointer< CellData<DIM,LSMLIB_REAL> > phi_data =
-        patch->getPatchData( phi_handle );
+  Pointer< CellData<DIM,LSMLIB_REAL> > grad_phi_plus_data =
+    patch->getPatchData( grad_phi_plus_handle );
+  Pointer< CellData<DIM,LSMLIB_REAL> > grad_phi_minus_data =
+    patch->getPatchData( grad_phi_minus_handle );
+  Pointer< CellData<DIM,LSMLIB_REAL> > phi_data =
+    patch->getPatchData( phi_handle );
   
-      Box<DIM> fillbox = grad_phi_plus_data->getBox();
-      const IntVector<DIM> grad_phi_fillbox_lower = fillbox.lower();
-      const IntVector<DIM> grad_phi_fillbox_upper = fillbox.upper();
+  Box<DIM> fillbox = grad_phi_plus_data->getBox();
+  const IntVector<DIM> grad_phi_fillbox_lower = fillbox.lower();
+  const IntVector<DIM> grad_phi_fillbox_upper = fillbox.upper();
+
+  Box<DIM> grad_phi_plus_ghostbox = grad_phi_plus_data->getGhostBox();
+  const IntVector<DIM> grad_phi_plus_ghostbox_lower = 
+    grad_phi_plus_ghostbox.lower();
+  const IntVector<DIM> grad_phi_plus_ghostbox_upper = 
+    grad_phi_plus_ghostbox.upper();
+
+  Box<DIM> grad_phi_minus_ghostbox = grad_phi_minus_data->getGhostBox();
+  const IntVector<DIM> grad_phi_minus_ghostbox_lower = 
+    grad_phi_minus_ghostbox.lower();
+  const IntVector<DIM> grad_phi_minus_ghostbox_upper = 
+    grad_phi_minus_ghostbox.upper();
+
+  Box<DIM> phi_ghostbox = phi_data->getGhostBox();
+  const IntVector<DIM> phi_ghostbox_lower = phi_ghostbox.lower();
+  const IntVector<DIM> phi_ghostbox_upper = phi_ghostbox.upper();
+
+  LSMLIB_REAL* grad_phi_plus[LSM_DIM_MAX];
+  LSMLIB_REAL* grad_phi_minus[LSM_DIM_MAX];
+  LSMLIB_REAL* phi = phi_data->getPointer(phi_component);
+  for (int dim = 0; dim < DIM; dim++) {
+    grad_phi_plus[dim] = grad_phi_plus_data->getPointer(dim);
+    grad_phi_minus[dim] = grad_phi_minus_data->getPointer(dim);
+  }
 
-      Box<DIM> grad_phi_plus_ghostbox = grad_phi_plus_data->getGhostBox();
-      const IntVector<DIM> grad_phi_plus_ghostbox_lower = 
-        grad_phi_plus_ghostbox.lower();
-      const IntVector<DIM> grad_phi_plus_ghostbox_upper = 
-        grad_phi_plus_ghostbox.upper();
+  switch (spatial_derivative_type) {
+    case ENO: {
+      switch (spatial_derivative_order) { 
+        case 1: {
 
-      Box<DIM> grad_phi_minus_ghostbox = grad_phi_minus_data->getGhostBox();
-      const IntVector<DIM> grad_phi_minus_ghostbox_lower = 
-        grad_phi_minus_ghostbox.lower();
-      const IntVector<DIM> grad_phi_minus_ghostbox_upper = 
-        grad_phi_minus_ghostbox.upper();
+          Pointer< CellData<DIM,LSMLIB_REAL> > D1_data =
+            patch->getPatchData( s_D1_one_ghostcell_handle );
 
-      Box<DIM> phi_ghostbox = phi_data->getGhostBox();
-      const IntVector<DIM> phi_ghostbox_lower = phi_ghostbox.lower();
-      const IntVector<DIM> phi_ghostbox_upper = phi_ghostbox.upper();
+          Box<DIM> D1_ghostbox = D1_data->getGhostBox();
+          const IntVector<DIM> D1_ghostbox_lower = D1_ghostbox.lower();
+          const IntVector<DIM> D1_ghostbox_upper = D1_ghostbox.upper();
 
-      LSMLIB_REAL* grad_phi_plus[LSM_DIM_MAX];
-      LSMLIB_REAL* grad_phi_minus[LSM_DIM_MAX];
-      LSMLIB_REAL* phi = phi_data->getPointer(phi_component);
-      for (int dim = 0; dim < DIM; dim++) {
-        grad_phi_plus[dim] = grad_phi_plus_data->getPointer(dim);
-        grad_phi_minus[dim] = grad_phi_minus_data->getPointer(dim);
-      }
+          LSMLIB_REAL* D1 = D1_data->getPointer();
 
-      switch (spatial_derivative_type) {
-        case ENO: {
-          switch (spatial_derivative_order) { 
-            case 1: {
+          if ( DIM == 3 ) {
 
-              // prepare scratch PatchData
-              patch->allocatePatchData( s_D1_one_ghostcell_handle );
+            LSM3D_HJ_ENO1(
+              grad_phi_plus[0], grad_phi_plus[1], grad_phi_plus[2],
+              &grad_phi_plus_ghostbox_lower[0],
+              &grad_phi_plus_ghostbox_upper[0],
+              &grad_phi_plus_ghostbox_lower[1],
+              &grad_phi_plus_ghostbox_upper[1],
+              &grad_phi_plus_ghostbox_lower[2],
+              &grad_phi_plus_ghostbox_upper[2],
+              grad_phi_minus[0], grad_phi_minus[1], grad_phi_minus[2],
+              &grad_phi_minus_ghostbox_lower[0],
+              &grad_phi_minus_ghostbox_upper[0],
+              &grad_phi_minus_ghostbox_lower[1],
+              &grad_phi_minus_ghostbox_upper[1],
+              &grad_phi_minus_ghostbox_lower[2],
+              &grad_phi_minus_ghostbox_upper[2],
+              phi,
+              &phi_ghostbox_lower[0],
+              &phi_ghostbox_upper[0],
+              &phi_ghostbox_lower[1],
+              &phi_ghostbox_upper[1],
+              &phi_ghostbox_lower[2],
+              &phi_ghostbox_upper[2],
+              D1,
+              &D1_ghostbox_lower[0],
+              &D1_ghostbox_upper[0],
+              &D1_ghostbox_lower[1],
+              &D1_ghostbox_upper[1],
+              &D1_ghostbox_lower[2],
+              &D1_ghostbox_upper[2],
+              &grad_phi_fillbox_lower[0],
+              &grad_phi_fillbox_upper[0],
+              &grad_phi_fillbox_lower[1],
+              &grad_phi_fillbox_upper[1],
+              &grad_phi_fillbox_lower[2],
+              &grad_phi_fillbox_upper[2],
+              &dx[0], &dx[1], &dx[2]);
 
-              Pointer< CellData<DIM,LSMLIB_REAL> > D1_data =
-                patch->getPatchData( s_D1_one_ghostcell_handle );
+          } else if ( DIM == 2 ) {
 
-              Box<DIM> D1_ghostbox = D1_data->getGhostBox();
-              const IntVector<DIM> D1_ghostbox_lower = D1_ghostbox.lower();
-              const IntVector<DIM> D1_ghostbox_upper = D1_ghostbox.upper();
+            LSM2D_HJ_ENO1(
+              grad_phi_plus[0], grad_phi_plus[1],
+              &grad_phi_plus_ghostbox_lower[0],
+              &grad_phi_plus_ghostbox_upper[0],
+              &grad_phi_plus_ghostbox_lower[1],
+              &grad_phi_plus_ghostbox_upper[1],
+              grad_phi_minus[0], grad_phi_minus[1],
+              &grad_phi_minus_ghostbox_lower[0],
+              &grad_phi_minus_ghostbox_upper[0],
+              &grad_phi_minus_ghostbox_lower[1],
+              &grad_phi_minus_ghostbox_upper[1],
+              phi,
+              &phi_ghostbox_lower[0],
+              &phi_ghostbox_upper[0],
+              &phi_ghostbox_lower[1],
+              &phi_ghostbox_upper[1],
+              D1,
+              &D1_ghostbox_lower[0],
+              &D1_ghostbox_upper[0],
+              &D1_ghostbox_lower[1],
+              &D1_ghostbox_upper[1],
+              &grad_phi_fillbox_lower[0],
+              &grad_phi_fillbox_upper[0],
+              &grad_phi_fillbox_lower[1],
+              &grad_phi_fillbox_upper[1],
+              &dx[0], &dx[1]);
 
-              LSMLIB_REAL* D1 = D1_data->getPointer();
+          } else if ( DIM == 1 ) {
 
-              if ( DIM == 3 ) {
+            LSM1D_HJ_ENO1(
+              grad_phi_plus[0],
+              &grad_phi_plus_ghostbox_lower[0],
+              &grad_phi_plus_ghostbox_upper[0],
+              grad_phi_minus[0],
+              &grad_phi_minus_ghostbox_lower[0],
+              &grad_phi_minus_ghostbox_upper[0],
+              phi,
+              &phi_ghostbox_lower[0],
+              &phi_ghostbox_upper[0],
+              D1,
+              &D1_ghostbox_lower[0],
+              &D1_ghostbox_upper[0],
+              &grad_phi_fillbox_lower[0],
+              &grad_phi_fillbox_upper[0],
+              &dx[0]);
 
-                LSM3D_HJ_ENO1(
-                  grad_phi_plus[0], grad_phi_plus[1], grad_phi_plus[2],
-                  &grad_phi_plus_ghostbox_lower[0],
-                  &grad_phi_plus_ghostbox_upper[0],
-                  &grad_phi_plus_ghostbox_lower[1],
-                  &grad_phi_plus_ghostbox_upper[1],
-                  &grad_phi_plus_ghostbox_lower[2],
-                  &grad_phi_plus_ghostbox_upper[2],
-                  grad_phi_minus[0], grad_phi_minus[1], grad_phi_minus[2],
-                  &grad_phi_minus_ghostbox_lower[0],
-                  &grad_phi_minus_ghostbox_upper[0],
-                  &grad_phi_minus_ghostbox_lower[1],
-                  &grad_phi_minus_ghostbox_upper[1],
-                  &grad_phi_minus_ghostbox_lower[2],
-                  &grad_phi_minus_ghostbox_upper[2],
-                  phi,
-                  &phi_ghostbox_lower[0],
-                  &phi_ghostbox_upper[0],
-                  &phi_ghostbox_lower[1],
-                  &phi_ghostbox_upper[1],
-                  &phi_ghostbox_lower[2],
-                  &phi_ghostbox_upper[2],
-                  D1,
-                  &D1_ghostbox_lower[0],
-                  &D1_ghostbox_upper[0],
-                  &D1_ghostbox_lower[1],
-                  &D1_ghostbox_upper[1],
-                  &D1_ghostbox_lower[2],
-                  &D1_ghostbox_upper[2],
-                  &grad_phi_fillbox_lower[0],
-                  &grad_phi_fillbox_upper[0],
-                  &grad_phi_fillbox_lower[1],
-                  &grad_phi_fillbox_upper[1],
-                  &grad_phi_fillbox_lower[2],
-                  &grad_phi_fillbox_upper[2],
-                  &dx[0], &dx[1], &dx[2]);
+          } else {
 
-              } else if ( DIM == 2 ) {
+            TBOX_ERROR(  "LevelSetMethodToolbox::"
+                      << "computePlusAndMinusSpatialDerivatives(): "
+                      << "Invalid value of DIM.  "
+                      << "Only DIM = 1, 2, and 3 are supported."
+                      << endl );
 
-                LSM2D_HJ_ENO1(
-                  grad_phi_plus[0], grad_phi_plus[1],
-                  &grad_phi_plus_ghostbox_lower[0],
-                  &grad_phi_plus_ghostbox_upper[0],
-                  &grad_phi_plus_ghostbox_lower[1],
-                  &grad_phi_plus_ghostbox_upper[1],
-                  grad_phi_minus[0], grad_phi_minus[1],
-                  &grad_phi_minus_ghostbox_lower[0],
-                  &grad_phi_minus_ghostbox_upper[0],
-                  &grad_phi_minus_ghostbox_lower[1],
-                  &grad_phi_minus_ghostbox_upper[1],
-                  phi,
-                  &phi_ghostbox_lower[0],
-                  &phi_ghostbox_upper[0],
-                  &phi_ghostbox_lower[1],
-                  &phi_ghostbox_upper[1],
-                  D1,
-                  &D1_ghostbox_lower[0],
-                  &D1_ghostbox_upper[0],
-                  &D1_ghostbox_lower[1],
-                  &D1_ghostbox_upper[1],
-                  &grad_phi_fillbox_lower[0],
-                  &grad_phi_fillbox_upper[0],
-                  &grad_phi_fillbox_lower[1],
-                  &grad_phi_fillbox_upper[1],
-                  &dx[0], &dx[1]);
+          } 
 
-              } else if ( DIM == 1 ) {
+          break;
+        }
 
-                LSM1D_HJ_ENO1(
-                  grad_phi_plus[0],
-                  &grad_phi_plus_ghostbox_lower[0],
-                  &grad_phi_plus_ghostbox_upper[0],
-                  grad_phi_minus[0],
-                  &grad_phi_minus_ghostbox_lower[0],
-                  &grad_phi_minus_ghostbox_upper[0],
-                  phi,
-                  &phi_ghostbox_lower[0],
-                  &phi_ghostbox_upper[0],
-                  D1,
-                  &D1_ghostbox_lower[0],
-                  &D1_ghostbox_upper[0],
-                  &grad_phi_fillbox_lower[0],
-                  &grad_phi_fillbox_upper[0],
-                  &dx[0]);
+        case 2: {
 
-              } else {
+          Pointer< CellData<DIM,LSMLIB_REAL> > D1_data =
+            patch->getPatchData( s_D1_two_ghostcells_handle );
+          Pointer< CellData<DIM,LSMLIB_REAL> > D2_data =
+            patch->getPatchData( s_D2_two_ghostcells_handle );
 
-                TBOX_ERROR(  "LevelSetMethodToolbox::"
-                          << "computePlusAndMinusSpatialDerivatives(): "
-                          << "Invalid value of DIM.  "
-                          << "Only DIM = 1, 2, and 3 are supported."
-                          << endl );
+          Box<DIM> D1_ghostbox = D1_data->getGhostBox();
+          const IntVector<DIM> D1_ghostbox_lower = D1_ghostbox.lower();
+          const IntVector<DIM> D1_ghostbox_upper = D1_ghostbox.upper();
+          Box<DIM> D2_ghostbox = D2_data->getGhostBox();
+          const IntVector<DIM> D2_ghostbox_lower = D2_ghostbox.lower();
+          const IntVector<DIM> D2_ghostbox_upper = D2_ghostbox.upper();
 
-              } 
+          LSMLIB_REAL* D1 = D1_data->getPointer();
+          LSMLIB_REAL* D2 = D2_data->getPointer();
 
-              // deallocate scratch PatchData
-              patch->deallocatePatchData( s_D1_one_ghostcell_handle );
+          if ( DIM == 3 ) {
 
-              break;
-            }
+            LSM3D_HJ_ENO2(
+              grad_phi_plus[0], grad_phi_plus[1], grad_phi_plus[2],
+              &grad_phi_plus_ghostbox_lower[0],
+              &grad_phi_plus_ghostbox_upper[0],
+              &grad_phi_plus_ghostbox_lower[1],
+              &grad_phi_plus_ghostbox_upper[1],
+              &grad_phi_plus_ghostbox_lower[2],
+              &grad_phi_plus_ghostbox_upper[2],
+              grad_phi_minus[0], grad_phi_minus[1], grad_phi_minus[2],
+              &grad_phi_minus_ghostbox_lower[0],
+              &grad_phi_minus_ghostbox_upper[0],
+              &grad_phi_minus_ghostbox_lower[1],
+              &grad_phi_minus_ghostbox_upper[1],
+              &grad_phi_minus_ghostbox_lower[2],
+              &grad_phi_minus_ghostbox_upper[2],
+              phi,
+              &phi_ghostbox_lower[0],
+              &phi_ghostbox_upper[0],
+              &phi_ghostbox_lower[1],
+              &phi_ghostbox_upper[1],
+              &phi_ghostbox_lower[2],
+              &phi_ghostbox_upper[2],
+              D1,
+              &D1_ghostbox_lower[0],
+              &D1_ghostbox_upper[0],
+              &D1_ghostbox_lower[1],
+              &D1_ghostbox_upper[1],
+              &D1_ghostbox_lower[2],
+              &D1_ghostbox_upper[2],
+              D2,
+              &D2_ghostbox_lower[0],
+              &D2_ghostbox_upper[0],
+              &D2_ghostbox_lower[1],
+              &D2_ghostbox_upper[1],
+              &D2_ghostbox_lower[2],
+              &D2_ghostbox_upper[2],
+              &grad_phi_fillbox_lower[0],
+              &grad_phi_fillbox_upper[0],
+              &grad_phi_fillbox_lower[1],
+              &grad_phi_fillbox_upper[1],
+              &grad_phi_fillbox_lower[2],
+              &grad_phi_fillbox_upper[2],
+              &dx[0], &dx[1], &dx[2]);
 
-            case 2: {
+          } else if ( DIM == 2 ) {
 
-              // prepare scratch PatchData
-              patch->allocatePatchData( s_D1_two_ghostcells_handle );
-              patch->allocatePatchData( s_D2_two_ghostcells_handle );
+            LSM2D_HJ_ENO2(
+              grad_phi_plus[0], grad_phi_plus[1],
+              &grad_phi_plus_ghostbox_lower[0],
+              &grad_phi_plus_ghostbox_upper[0],
+              &grad_phi_plus_ghostbox_lower[1],
+              &grad_phi_plus_ghostbox_upper[1],
+              grad_phi_minus[0], grad_phi_minus[1],
+              &grad_phi_minus_ghostbox_lower[0],
+              &grad_phi_minus_ghostbox_upper[0],
+              &grad_phi_minus_ghostbox_lower[1],
+              &grad_phi_minus_ghostbox_upper[1],
+              phi,
+              &phi_ghostbox_lower[0],
+              &phi_ghostbox_upper[0],
+              &phi_ghostbox_lower[1],
+              &phi_ghostbox_upper[1],
+              D1,
+              &D1_ghostbox_lower[0],
+              &D1_ghostbox_upper[0],
+              &D1_ghostbox_lower[1],
+              &D1_ghostbox_upper[1],
+              D2,
+              &D2_ghostbox_lower[0],
+              &D2_ghostbox_upper[0],
+              &D2_ghostbox_lower[1],
+              &D2_ghostbox_upper[1],
+              &grad_phi_fillbox_lower[0],
+              &grad_phi_fillbox_upper[0],
+              &grad_phi_fillbox_lower[1],
+              &grad_phi_fillbox_upper[1],
+              &dx[0], &dx[1]);
 
-              Pointer< CellData<DIM,LSMLIB_REAL> > D1_data =
-                patch->getPatchData( s_D1_two_ghostcells_handle );
-              Pointer< CellData<DIM,LSMLIB_REAL> > D2_data =
-                patch->getPatchData( s_D2_two_ghostcells_handle );
+          } else if ( DIM == 1 ) {
 
-              Box<DIM> D1_ghostbox = D1_data->getGhostBox();
-              const IntVector<DIM> D1_ghostbox_lower = D1_ghostbox.lower();
-              const IntVector<DIM> D1_ghostbox_upper = D1_ghostbox.upper();
-              Box<DIM> D2_ghostbox = D2_data->getGhostBox();
-              const IntVector<DIM> D2_ghostbox_lower = D2_ghostbox.lower();
-              const IntVector<DIM> D2_ghostbox_upper = D2_ghostbox.upper();
+            LSM1D_HJ_ENO2(
+              grad_phi_plus[0],
+              &grad_phi_plus_ghostbox_lower[0],
+              &grad_phi_plus_ghostbox_upper[0],
+              grad_phi_minus[0],
+              &grad_phi_minus_ghostbox_lower[0],
+              &grad_phi_minus_ghostbox_upper[0],
+              phi,
+              &phi_ghostbox_lower[0],
+              &phi_ghostbox_upper[0],
+              D1,
+              &D1_ghostbox_lower[0],
+              &D1_ghostbox_upper[0],
+              D2,
+              &D2_ghostbox_lower[0],
+              &D2_ghostbox_upper[0],
+              &grad_phi_fillbox_lower[0],
+              &grad_phi_fillbox_upper[0],
+              &dx[0]);
 
-              LSMLIB_REAL* D1 = D1_data->getPointer();
-              LSMLIB_REAL* D2 = D2_data->getPointer();
+          } else {
 
-              if ( DIM == 3 ) {
+            TBOX_ERROR(  "LevelSetMethodToolbox::"
+                      << "computePlusAndMinusSpatialDerivatives(): "
+                      << "Invalid value of DIM.  "
+                      << "Only DIM = 1, 2, and 3 are supported."
+                      << endl );
 
-                LSM3D_HJ_ENO2(
-                  grad_phi_plus[0], grad_phi_plus[1], grad_phi_plus[2],
-                  &grad_phi_plus_ghostbox_lower[0],
-                  &grad_phi_plus_ghostbox_upper[0],
-                  &grad_phi_plus_ghostbox_lower[1],
-                  &grad_phi_plus_ghostbox_upper[1],
-                  &grad_phi_plus_ghostbox_lower[2],
-                  &grad_phi_plus_ghostbox_upper[2],
-                  grad_phi_minus[0], grad_phi_minus[1], grad_phi_minus[2],
-                  &grad_phi_minus_ghostbox_lower[0],
-                  &grad_phi_minus_ghostbox_upper[0],
-                  &grad_phi_minus_ghostbox_lower[1],
-                  &grad_phi_minus_ghostbox_upper[1],
-                  &grad_phi_minus_ghostbox_lower[2],
-                  &grad_phi_minus_ghostbox_upper[2],
-                  phi,
-                  &phi_ghostbox_lower[0],
-                  &phi_ghostbox_upper[0],
-                  &phi_ghostbox_lower[1],
-                  &phi_ghostbox_upper[1],
-                  &phi_ghostbox_lower[2],
-                  &phi_ghostbox_upper[2],
-                  D1,
-                  &D1_ghostbox_lower[0],
-                  &D1_ghostbox_upper[0],
-                  &D1_ghostbox_lower[1],
-                  &D1_ghostbox_upper[1],
-                  &D1_ghostbox_lower[2],
-                  &D1_ghostbox_upper[2],
-                  D2,
-                  &D2_ghostbox_lower[0],
-                  &D2_ghostbox_upper[0],
-                  &D2_ghostbox_lower[1],
-                  &D2_ghostbox_upper[1],
-                  &D2_ghostbox_lower[2],
-                  &D2_ghostbox_upper[2],
-                  &grad_phi_fillbox_lower[0],
-                  &grad_phi_fillbox_upper[0],
-                  &grad_phi_fillbox_lower[1],
-                  &grad_phi_fillbox_upper[1],
-                  &grad_phi_fillbox_lower[2],
-                  &grad_phi_fillbox_upper[2],
-                  &dx[0], &dx[1], &dx[2]);
+          } 
 
-              } else if ( DIM == 2 ) {
+          break;
+        }
 
-                LSM2D_HJ_ENO2(
-                  grad_phi_plus[0], grad_phi_plus[1],
-                  &grad_phi_plus_ghostbox_lower[0],
-                  &grad_phi_plus_ghostbox_upper[0],
-                  &grad_phi_plus_ghostbox_lower[1],
-                  &grad_phi_plus_ghostbox_upper[1],
-                  grad_phi_minus[0], grad_phi_minus[1],
-                  &grad_phi_minus_ghostbox_lower[0],
-                  &grad_phi_minus_ghostbox_upper[0],
-                  &grad_phi_minus_ghostbox_lower[1],
-                  &grad_phi_minus_ghostbox_upper[1],
-                  phi,
-                  &phi_ghostbox_lower[0],
-                  &phi_ghostbox_upper[0],
-                  &phi_ghostbox_lower[1],
-                  &phi_ghostbox_upper[1],
-                  D1,
-                  &D1_ghostbox_lower[0],
-                  &D1_ghostbox_upper[0],
-                  &D1_ghostbox_lower[1],
-                  &D1_ghostbox_upper[1],
-                  D2,
-                  &D2_ghostbox_lower[0],
-                  &D2_ghostbox_upper[0],
-                  &D2_ghostbox_lower[1],
-                  &D2_ghostbox_upper[1],
-                  &grad_phi_fillbox_lower[0],
-                  &grad_phi_fillbox_upper[0],
-                  &grad_phi_fillbox_lower[1],
-                  &grad_phi_fillbox_upper[1],
-                  &dx[0], &dx[1]);
+        case 3: {
 
-              } else if ( DIM == 1 ) {
+          Pointer< CellData<DIM,LSMLIB_REAL> > D1_data =
+            patch->getPatchData( s_D1_three_ghostcells_handle );
+          Pointer< CellData<DIM,LSMLIB_REAL> > D2_data =
+            patch->getPatchData( s_D2_three_ghostcells_handle );
+          Pointer< CellData<DIM,LSMLIB_REAL> > D3_data =
+            patch->getPatchData( s_D3_three_ghostcells_handle );
 
-                LSM1D_HJ_ENO2(
-                  grad_phi_plus[0],
-                  &grad_phi_plus_ghostbox_lower[0],
-                  &grad_phi_plus_ghostbox_upper[0],
-                  grad_phi_minus[0],
-                  &grad_phi_minus_ghostbox_lower[0],
-                  &grad_phi_minus_ghostbox_upper[0],
-                  phi,
-                  &phi_ghostbox_lower[0],
-                  &phi_ghostbox_upper[0],
-                  D1,
-                  &D1_ghostbox_lower[0],
-                  &D1_ghostbox_upper[0],
-                  D2,
-                  &D2_ghostbox_lower[0],
-                  &D2_ghostbox_upper[0],
-                  &grad_phi_fillbox_lower[0],
-                  &grad_phi_fillbox_upper[0],
-                  &dx[0]);
+          Box<DIM> D1_ghostbox = D1_data->getGhostBox();
+          const IntVector<DIM> D1_ghostbox_lower = D1_ghostbox.lower();
+          const IntVector<DIM> D1_ghostbox_upper = D1_ghostbox.upper();
+          Box<DIM> D2_ghostbox = D2_data->getGhostBox();
+          const IntVector<DIM> D2_ghostbox_lower = D2_ghostbox.lower();
+          const IntVector<DIM> D2_ghostbox_upper = D2_ghostbox.upper();
+          Box<DIM> D3_ghostbox = D3_data->getGhostBox();
+          const IntVector<DIM> D3_ghostbox_lower = D3_ghostbox.lower();
+          const IntVector<DIM> D3_ghostbox_upper = D3_ghostbox.upper();
 
-              } else {
+          LSMLIB_REAL* D1 = D1_data->getPointer();
+          LSMLIB_REAL* D2 = D2_data->getPointer();
+          LSMLIB_REAL* D3 = D3_data->getPointer();
 
-                TBOX_ERROR(  "LevelSetMethodToolbox::"
-                          << "computePlusAndMinusSpatialDerivatives(): "
-                          << "Invalid value of DIM.  "
-                          << "Only DIM = 1, 2, and 3 are supported."
-                          << endl );
+          if ( DIM == 3 ) { 
 
-              } 
+            LSM3D_HJ_ENO3(
+              grad_phi_plus[0], grad_phi_plus[1], grad_phi_plus[2],
+              &grad_phi_plus_ghostbox_lower[0],
+              &grad_phi_plus_ghostbox_upper[0],
+              &grad_phi_plus_ghostbox_lower[1],
+              &grad_phi_plus_ghostbox_upper[1],
+              &grad_phi_plus_ghostbox_lower[2],
+              &grad_phi_plus_ghostbox_upper[2],
+              grad_phi_minus[0], grad_phi_minus[1], grad_phi_minus[2],
+              &grad_phi_minus_ghostbox_lower[0],
+              &grad_phi_minus_ghostbox_upper[0],
+              &grad_phi_minus_ghostbox_lower[1],
+              &grad_phi_minus_ghostbox_upper[1],
+              &grad_phi_minus_ghostbox_lower[2],
+              &grad_phi_minus_ghostbox_upper[2],
+              phi,
+              &phi_ghostbox_lower[0],
+              &phi_ghostbox_upper[0],
+              &phi_ghostbox_lower[1],
+              &phi_ghostbox_upper[1],
+              &phi_ghostbox_lower[2],
+              &phi_ghostbox_upper[2],
+              D1,
+              &D1_ghostbox_lower[0],
+              &D1_ghostbox_upper[0],
+              &D1_ghostbox_lower[1],
+              &D1_ghostbox_upper[1],
+              &D1_ghostbox_lower[2],
+              &D1_ghostbox_upper[2],
+              D2,
+              &D2_ghostbox_lower[0],
+              &D2_ghostbox_upper[0],
+              &D2_ghostbox_lower[1],
+              &D2_ghostbox_upper[1],
+              &D2_ghostbox_lower[2],
+              &D2_ghostbox_upper[2],
+              D3,
+              &D3_ghostbox_lower[0],
+              &D3_ghostbox_upper[0],
+              &D3_ghostbox_lower[1],
+              &D3_ghostbox_upper[1],
+              &D3_ghostbox_lower[2],
+              &D3_ghostbox_upper[2],
+              &grad_phi_fillbox_lower[0],
+              &grad_phi_fillbox_upper[0],
+              &grad_phi_fillbox_lower[1],
+              &grad_phi_fillbox_upper[1],
+              &grad_phi_fillbox_lower[2],
+              &grad_phi_fillbox_upper[2],
+              &dx[0], &dx[1], &dx[2]);
 
-              // deallocate scratch PatchData
-              patch->deallocatePatchData( s_D1_two_ghostcells_handle );
-              patch->deallocatePatchData( s_D2_two_ghostcells_handle );
+          } else if ( DIM == 2 ) {
 
-              break;
-            }
-
-            case 3: {
-
-              // prepare scratch PatchData
-              patch->allocatePatchData( s_D1_three_ghostcells_handle );
-              patch->allocatePatchData( s_D2_three_ghostcells_handle );
-              patch->allocatePatchData( s_D3_three_ghostcells_handle );
-
-              Pointer< CellData<DIM,LSMLIB_REAL> > D1_data =
-                patch->getPatchData( s_D1_three_ghostcells_handle );
-              Pointer< CellData<DIM,LSMLIB_REAL> > D2_data =
-                patch->getPatchData( s_D2_three_ghostcells_handle );
-              Pointer< CellData<DIM,LSMLIB_REAL> > D3_data =
-                patch->getPatchData( s_D3_three_ghostcells_handle );
-
-              Box<DIM> D1_ghostbox = D1_data->getGhostBox();
-              const IntVector<DIM> D1_ghostbox_lower = D1_ghostbox.lower();
-              const IntVector<DIM> D1_ghostbox_upper = D1_ghostbox.upper();
-              Box<DIM> D2_ghostbox = D2_data->getGhostBox();
-              const IntVector<DIM> D2_ghostbox_lower = D2_ghostbox.lower();
-              const IntVector<DIM> D2_ghostbox_upper = D2_ghostbox.upper();
-              Box<DIM> D3_ghostbox = D3_data->getGhostBox();
-              const IntVector<DIM> D3_ghostbox_lower = D3_ghostbox.lower();
-              const IntVector<DIM> D3_ghostbox_upper = D3_ghostbox.upper();
-
-              LSMLIB_REAL* D1 = D1_data->getPointer();
-              LSMLIB_REAL* D2 = D2_data->getPointer();
-              LSMLIB_REAL* D3 = D3_data->getPointer();
-
-              if ( DIM == 3 ) { 
-
-                LSM3D_HJ_ENO3(
-                  grad_phi_plus[0], grad_phi_plus[1], grad_phi_plus[2],
-                  &grad_phi_plus_ghostbox_lower[0],
-                  &grad_phi_plus_ghostbox_upper[0],
-                  &grad_phi_plus_ghostbox_lower[1],
-                  &grad_phi_plus_ghostbox_upper[1],
-                  &grad_phi_plus_ghostbox_lower[2],
-                  &grad_phi_plus_ghostbox_upper[2],
-                  grad_phi_minus[0], grad_phi_minus[1], grad_phi_minus[2],
-                  &grad_phi_minus_ghostbox_lower[0],
-                  &grad_phi_minus_ghostbox_upper[0],
-                  &grad_phi_minus_ghostbox_lower[1],
-                  &grad_phi_minus_ghostbox_upper[1],
-                  &grad_phi_minus_ghostbox_lower[2],
-                  &grad_phi_minus_ghostbox_upper[2],
-                  phi,
-                  &phi_ghostbox_lower[0],
-                  &phi_ghostbox_upper[0],
-                  &phi_ghostbox_lower[1],
-                  &phi_ghostbox_upper[1],
-                  &phi_ghostbox_lower[2],
-                  &phi_ghostbox_upper[2],
-                  D1,
-                  &D1_ghostbox_lower[0],
-                  &D1_ghostbox_upper[0],
-                  &D1_ghostbox_lower[1],
-                  &D1_ghostbox_upper[1],
-                  &D1_ghostbox_lower[2],
-                  &D1_ghostbox_upper[2],
-                  D2,
-                  &D2_ghostbox_lower[0],
-                  &D2_ghostbox_upper[0],
-                  &D2_ghostbox_lower[1],
-                  &D2_ghostbox_upper[1],
-                  &D2_ghostbox_lower[2],
-                  &D2_ghostbox_upper[2],
-                  D3,
-                  &D3_ghostbox_lower[0],
-                  &D3_ghostbox_upper[0],
-                  &D3_ghostbox_lower[1],
-                  &D3_ghostbox_upper[1],
-                  &D3_ghostbox_lower[2],
-                  &D3_ghostbox_upper[2],
-                  &grad_phi_fillbox_lower[0],
-                  &grad_phi_fillbox_upper[0],
-                  &grad_phi_fillbox_lower[1],
-                  &grad_phi_fillbox_upper[1],
-                  &grad_phi_fillbox_lower[2],
-                  &grad_phi_fillbox_upper[2],
-                  &dx[0], &dx[1], &dx[2]);
-
-              } else if ( DIM == 2 ) {
-
-                LSM2D_HJ_ENO3(
-                  grad_phi_plus[0], grad_phi_plus[1],
-                  &grad_phi_plus_ghostbox_lower[0],
-                  &grad_phi_plus_ghostbox_upper[0],
-                  &grad_phi_plus_ghostbox_lower[1],
-                  &grad_phi_plus_ghostbox_upper[1],
-                  grad_phi_minus[0], grad_phi_minus[1],
-                  &grad_phi_minus_ghostbox_lower[0],
-                  &grad_phi_minus_ghostbox_upper[0],
-                  &grad_phi_minus_ghostbox_lower[1],
-                  &grad_phi_minus_ghostbox_upper[1],
-                  phi,
-                  &phi_ghostbox_lower[0],
-                  &phi_ghostbox_upper[0],
-                  &phi_ghostbox_lower[1],
-                  &phi_ghostbox_upper[1],
-                  D1,
-                  &D1_ghostbox_lower[0],
-                  &D1_ghostbox_upper[0],
-                  &D1_ghostbox_lower[1],
-                  &D1_ghostbox_upper[1],
-                  D2,
-                  &D2_ghostbox_lower[0],
-                  &D2_ghostbox_upper[0],
-                  &D2_ghostbox_lower[1],
-                  &D2_ghostbox_upper[1],
-                  D3,
-                  &D3_ghostbox_lower[0],
-                  &D3_ghostbox_upper[0],
-                  &D3_ghostbox_lower[1],
-                  &D3_ghostbox_upper[1],
-                  &grad_phi_fillbox_lower[0],
-                  &grad_phi_fillbox_upper[0],
-                  &grad_phi_fillbox_lower[1],
-                  &grad_phi_fillbox_upper[1],
-                  &dx[0], &dx[1]);
-
-              } else if ( DIM == 1 ) {
-
-                LSM1D_HJ_ENO3(
-                  grad_phi_plus[0],
-                  &grad_phi_plus_ghostbox_lower[0],
-                  &grad_phi_plus_ghostbox_upper[0],
-                  grad_phi_minus[0],
-                  &grad_phi_minus_ghostbox_lower[0],
-                  &grad_phi_minus_ghostbox_upper[0],
-                  phi,
-                  &phi_ghostbox_lower[0],
-                  &phi_ghostbox_upper[0],
-                  D1,
-                  &D1_ghostbox_lower[0],
-                  &D1_ghostbox_upper[0],
-                  D2,
-                  &D2_ghostbox_lower[0],
-                  &D2_ghostbox_upper[0],
-                  D3,
-                  &D3_ghostbox_lower[0],
-                  &D3_ghostbox_upper[0],
-                  &grad_phi_fillbox_lower[0],
-                  &grad_phi_fillbox_upper[0],
-                  &dx[0]);
-
-              } else {
-
-                TBOX_ERROR(  "LevelSetMethodToolbox::"
-                          << "computePlusAndMinusSpatialDerivatives(): "
-                          << "Invalid value of DIM.  "
-                          << "Only DIM = 1, 2, and 3 are supported."
-                          << endl );
-
-              } 
-
-              // deallocate scratch PatchData
-              patch->deallocatePatchData( s_D1_three_ghostcells_handle );
-              patch->deallocatePatchData( s_D2_three_ghostcells_handle );
-              patch->deallocatePatchData( s_D3_three_ghostcells_handle );
-
-              break;
-            }
-            default: {
-              TBOX_ERROR(  "LevelSetMethodToolbox::"
-                        << "computePlusAndMinusSpatialDerivatives(): "
-                        << "Unsupported order for ENO derivative.  "
-                        << "Only ENO1, ENO2, and ENO3 supported."
-                        << endl );
-            }
-          } // end switch on ENO spatial derivative order
-
-          break;
-        } // end case ENO
-
-        case WENO: {
-          switch (spatial_derivative_order) { 
-            case 5: {
-
-              // prepare scratch PatchData
-              patch->allocatePatchData( s_D1_three_ghostcells_handle );
-
-              Pointer< CellData<DIM,LSMLIB_REAL> > D1_data =
-                patch->getPatchData( s_D1_three_ghostcells_handle );
-
-              Box<DIM> D1_ghostbox = D1_data->getGhostBox();
-              const IntVector<DIM> D1_ghostbox_lower = D1_ghostbox.lower();
-              const IntVector<DIM> D1_ghostbox_upper = D1_ghostbox.upper();
-
-              LSMLIB_REAL* D1 = D1_data->getPointer();
+            LSM2D_HJ_ENO3(
+              grad_phi_plus[0], grad_phi_plus[1],
+              &grad_phi_plus_ghostbox_lower[0],
+              &grad_phi_plus_ghostbox_upper[0],
+              &grad_phi_plus_ghostbox_lower[1],
+              &grad_phi_plus_ghostbox_upper[1],
+              grad_phi_minus[0], grad_phi_minus[1],
+              &grad_phi_minus_ghostbox_lower[0],
+              &grad_phi_minus_ghostbox_upper[0],
+              &grad_phi_minus_ghostbox_lower[1],
+              &grad_phi_minus_ghostbox_upper[1],
+              phi,
+              &phi_ghostbox_lower[0],
+              &phi_ghostbox_upper[0],
+              &phi_ghostbox_lower[1],
+              &phi_ghostbox_upper[1],
+              D1,
+              &D1_ghostbox_lower[0],
+              &D1_ghostbox_upper[0],
+              &D1_ghostbox_lower[1],
+              &D1_ghostbox_upper[1],
+              D2,
+              &D2_ghostbox_lower[0],
+              &D2_ghostbox_upper[0],
+              &D2_ghostbox_lower[1],
+              &D2_ghostbox_upper[1],
+              D3,
+              &D3_ghostbox_lower[0],
+              &D3_ghostbox_upper[0],
+              &D3_ghostbox_lower[1],
+              &D3_ghostbox_upper[1],
+              &grad_phi_fillbox_lower[0],
+              &grad_phi_fillbox_upper[0],
+              &grad_phi_fillbox_lower[1],
+              &grad_phi_fillbox_upper[1],
+              &dx[0], &dx[1]);
 
-              if ( DIM == 3 ) {
+          } else if ( DIM == 1 ) {
 
-                LSM3D_HJ_WENO5(
-                  grad_phi_plus[0], grad_phi_plus[1], grad_phi_plus[2],
-                  &grad_phi_plus_ghostbox_lower[0],
-                  &grad_phi_plus_ghostbox_upper[0],
-                  &grad_phi_plus_ghostbox_lower[1],
-                  &grad_phi_plus_ghostbox_upper[1],
-                  &grad_phi_plus_ghostbox_lower[2],
-                  &grad_phi_plus_ghostbox_upper[2],
-                  grad_phi_minus[0], grad_phi_minus[1], grad_phi_minus[2],
-                  &grad_phi_minus_ghostbox_lower[0],
-                  &grad_phi_minus_ghostbox_upper[0],
-                  &grad_phi_minus_ghostbox_lower[1],
-                  &grad_phi_minus_ghostbox_upper[1],
-                  &grad_phi_minus_ghostbox_lower[2],
-                  &grad_phi_minus_ghostbox_upper[2],
-                  phi,
-                  &phi_ghostbox_lower[0],
-                  &phi_ghostbox_upper[0],
-                  &phi_ghostbox_lower[1],
-                  &phi_ghostbox_upper[1],
-                  &phi_ghostbox_lower[2],
-                  &phi_ghostbox_upper[2],
-                  D1,
-                  &D1_ghostbox_lower[0],
-                  &D1_ghostbox_upper[0],
-                  &D1_ghostbox_lower[1],
-                  &D1_ghostbox_upper[1],
-                  &D1_ghostbox_lower[2],
-                  &D1_ghostbox_upper[2],
-                  &grad_phi_fillbox_lower[0],
-                  &grad_phi_fillbox_upper[0],
-                  &grad_phi_fillbox_lower[1],
-                  &grad_phi_fillbox_upper[1],
-                  &grad_phi_fillbox_lower[2],
-                  &grad_phi_fillbox_upper[2],
-                  &dx[0], &dx[1], &dx[2]);
+            LSM1D_HJ_ENO3(
+              grad_phi_plus[0],
+              &grad_phi_plus_ghostbox_lower[0],
+              &grad_phi_plus_ghostbox_upper[0],
+              grad_phi_minus[0],
+              &grad_phi_minus_ghostbox_lower[0],
+              &grad_phi_minus_ghostbox_upper[0],
+              phi,
+              &phi_ghostbox_lower[0],
+              &phi_ghostbox_upper[0],
+              D1,
+              &D1_ghostbox_lower[0],
+              &D1_ghostbox_upper[0],
+              D2,
+              &D2_ghostbox_lower[0],
+              &D2_ghostbox_upper[0],
+              D3,
+              &D3_ghostbox_lower[0],
+              &D3_ghostbox_upper[0],
+              &grad_phi_fillbox_lower[0],
+              &grad_phi_fillbox_upper[0],
+              &dx[0]);
 
-              } else if ( DIM == 2 ) {
+          } else {
 
-                LSM2D_HJ_WENO5(
-                  grad_phi_plus[0], grad_phi_plus[1],
-                  &grad_phi_plus_ghostbox_lower[0],
-                  &grad_phi_plus_ghostbox_upper[0],
-                  &grad_phi_plus_ghostbox_lower[1],
-                  &grad_phi_plus_ghostbox_upper[1],
-                  grad_phi_minus[0], grad_phi_minus[1],
-                  &grad_phi_minus_ghostbox_lower[0],
-                  &grad_phi_minus_ghostbox_upper[0],
-                  &grad_phi_minus_ghostbox_lower[1],
-                  &grad_phi_minus_ghostbox_upper[1],
-                  phi,
-                  &phi_ghostbox_lower[0],
-                  &phi_ghostbox_upper[0],
-                  &phi_ghostbox_lower[1],
-                  &phi_ghostbox_upper[1],
-                  D1,
-                  &D1_ghostbox_lower[0],
-                  &D1_ghostbox_upper[0],
-                  &D1_ghostbox_lower[1],
-                  &D1_ghostbox_upper[1],
-                  &grad_phi_fillbox_lower[0],
-                  &grad_phi_fillbox_upper[0],
-                  &grad_phi_fillbox_lower[1],
-                  &grad_phi_fillbox_upper[1],
-                  &dx[0], &dx[1]);
+            TBOX_ERROR(  "LevelSetMethodToolbox::"
+                      << "computePlusAndMinusSpatialDerivatives(): "
+                      << "Invalid value of DIM.  "
+                      << "Only DIM = 1, 2, and 3 are supported."
+                      << endl );
 
-              } else if ( DIM == 1 ) {
+          } 
 
-                LSM1D_HJ_WENO5(
-                  grad_phi_plus[0],
-                  &grad_phi_plus_ghostbox_lower[0],
-                  &grad_phi_plus_ghostbox_upper[0],
-                  grad_phi_minus[0],
-                  &grad_phi_minus_ghostbox_lower[0],
-                  &grad_phi_minus_ghostbox_upper[0],
-                  phi,
-                  &phi_ghostbox_lower[0],
-                  &phi_ghostbox_upper[0],
-                  D1,
-                  &D1_ghostbox_lower[0],
-                  &D1_ghostbox_upper[0],
-                  &grad_phi_fillbox_lower[0],
-                  &grad_phi_fillbox_upper[0],
-                  &dx[0]);
+          break;
+        }
+        default: {
+          TBOX_ERROR(  "LevelSetMethodToolbox::"
+                    << "computePlusAndMinusSpatialDerivatives(): "
+                    << "Unsupported order for ENO derivative.  "
+                    << "Only ENO1, ENO2, and ENO3 supported."
+                    << endl );
+        }
+      } // end switch on ENO spatial derivative order
 
-              } else {
+      break;
+    } // end case ENO
 
-                TBOX_ERROR(  "LevelSetMethodToolbox::"
-                          << "computePlusAndMinusSpatialDerivatives(): "
-                          << "Invalid value of DIM.  "
-                          << "Only DIM = 1, 2, and 3 are supported."
-                          << endl );
+    case WENO: {
+      switch (spatial_derivative_order) { 
+        case 5: {
 
-              } 
+          Pointer< CellData<DIM,LSMLIB_REAL> > D1_data =
+            patch->getPatchData( s_D1_three_ghostcells_handle );
 
-              // deallocate scratch PatchData
-              patch->deallocatePatchData( s_D1_three_ghostcells_handle );
+          Box<DIM> D1_ghostbox = D1_data->getGhostBox();
+          const IntVector<DIM> D1_ghostbox_lower = D1_ghostbox.lower();
+          const IntVector<DIM> D1_ghostbox_upper = D1_ghostbox.upper();
 
-              break;
-            }
-            default: {
-              TBOX_ERROR(  "LevelSetMethodToolbox::"
-                        << "computePlusAndMinusSpatialDerivatives(): "
-                        << "Unsupported order for WENO derivative.  "
-                        << "Only WENO5 supported."
-                        << endl );
-            }
+          LSMLIB_REAL* D1 = D1_data->getPointer();
 
-          } // end switch on WENO spatial derivative order
+          if ( DIM == 3 ) {
 
-          break;
-        } // end case WENO
+            LSM3D_HJ_WENO5_SIMD(
+              grad_phi_plus[0], grad_phi_plus[1], grad_phi_plus[2],
+              &grad_phi_plus_ghostbox_lower[0],
+              &grad_phi_plus_ghostbox_upper[0],
+              &grad_phi_plus_ghostbox_lower[1],
+              &grad_phi_plus_ghostbox_upper[1],
+              &grad_phi_plus_ghostbox_lower[2],
+              &grad_phi_plus_ghostbox_upper[2],
+              grad_phi_minus[0], grad_phi_minus[1], grad_phi_minus[2],
+              &grad_phi_minus_ghostbox_lower[0],
+              &grad_phi_minus_ghostbox_upper[0],
+              &grad_phi_minus_ghostbox_lower[1],
+              &grad_phi_minus_ghostbox_upper[1],
+              &grad_phi_minus_ghostbox_lower[2],
+              &grad_phi_minus_ghostbox_upper[2],
+              phi,
+              &phi_ghostbox_lower[0],
+              &phi_ghostbox_upper[0],
+              &phi_ghostbox_lower[1],
+              &phi_ghostbox_upper[1],
+              &phi_ghostbox_lower[2],
+              &phi_ghostbox_upper[2],
+              D1,
+              &D1_ghostbox_lower[0],
+              &D1_ghostbox_upper[0],
+              &D1_ghostbox_lower[1],
+              &D1_ghostbox_upper[1],
+              &D1_ghostbox_lower[2],
+              &D1_ghostbox_upper[2],
+              &grad_phi_fillbox_lower[0],
+              &grad_phi_fillbox_upper[0],
+              &grad_phi_fillbox_lower[1],
+              &grad_phi_fillbox_upper[1],
+              &grad_phi_fillbox_lower[2],
+              &grad_phi_fillbox_upper[2],
+              &dx[0], &dx[1], &dx[2]);
+
+          } else if ( DIM == 2 ) {
+
+            LSM2D_HJ_WENO5_SIMD(
+              grad_phi_plus[0], grad_phi_plus[1],
+              &grad_phi_plus_ghostbox_lower[0],
+              &grad_phi_plus_ghostbox_upper[0],
+              &grad_phi_plus_ghostbox_lower[1],
+              &grad_phi_plus_ghostbox_upper[1],
+              grad_phi_minus[0], grad_phi_minus[1],
+              &grad_phi_minus_ghostbox_lower[0],
+              &grad_phi_minus_ghostbox_upper[0],
+              &grad_phi_minus_ghostbox_lower[1],
+              &grad_phi_minus_ghostbox_upper[1],
+              phi,
+              &phi_ghostbox_lower[0],
+              &phi_ghostbox_upper[0],
+              &phi_ghostbox_lower[1],
+              &phi_ghostbox_upper[1],
+              D1,
+              &D1_ghostbox_lower[0],
+              &D1_ghostbox_upper[0],
+              &D1_ghostbox_lower[1],
+              &D1_ghostbox_upper[1],
+              &grad_phi_fillbox_lower[0],
+              &grad_phi_fillbox_upper[0],
+              &grad_phi_fillbox_lower[1],
+              &grad_phi_fillbox_upper[1],
+              &dx[0], &dx[1]);
+
+          } else if ( DIM == 1 ) {
+
+            LSM1D_HJ_WENO5(
+              grad_phi_plus[0],
+              &grad_phi_plus_ghostbox_lower[0],
+              &grad_phi_plus_ghostbox_upper[0],
+              grad_phi_minus[0],
+              &grad_phi_minus_ghostbox_lower[0],
+              &grad_phi_minus_ghostbox_upper[0],
+              phi,
+              &phi_ghostbox_lower[0],
+              &phi_ghostbox_upper[0],
+              D1,
+              &D1_ghostbox_lower[0],
+              &D1_ghostbox_upper[0],
+              &grad_phi_fillbox_lower[0],
+              &grad_phi_fillbox_upper[0],
+              &dx[0]);
 
+          } else {
+
+            TBOX_ERROR(  "LevelSetMethodToolbox::"
+                      << "computePlusAndMinusSpatialDerivatives(): "
+                      << "Invalid value of DIM.  "
+                      << "Only DIM = 1, 2, and 3 are supported."
+                      << endl );
+
+          } 
+
+          break;
+        }
         default: {
           TBOX_ERROR(  "LevelSetMethodToolbox::"
                     << "computePlusAndMinusSpatialDerivatives(): "
-                    << "Unsupported spatial derivative type.  "
-                    << "Only ENO and WENO derivatives are supported."
+                    << "Unsupported order for WENO derivative.  "
+                    << "Only WENO5 supported."
                     << endl );
         }
 
-      } // end switch on derivative type
+      } // end switch on WENO spatial derivative order
 
-    } // end loop over Patches
-  } // end loop over PatchLevels
+      break;
+    } // end case WENO
+
+    default: {
+      TBOX_ERROR(  "LevelSetMethodToolbox::"
+                << "computePlusAndMinusSpatialDerivatives(): "
+                << "Unsupported spatial derivative type.  "
+                << "Only ENO and WENO derivatives are supported."
+                << endl );
+    }
+
+  } // end switch on derivative type
 }
 
 
@@ -1439,9 +1464,15 @@ void LevelSetMethodToolbox<DIM>::computeCentralSpatialDerivatives(
 
     Pointer< PatchLevel<DIM> > level = hierarchy->getPatchLevel(ln);
     
-    typename PatchLevel<DIM>::Iterator pi;
-    for (pi.initialize(level); pi; pi++) { // loop over patches
-      const int pn = *pi;
+    // patches are independent, so they may be processed concurrently
+    vector<int> patch_numbers;
+    getPatchNumbers(level, patch_numbers);
+    const int num_patches = patch_numbers.size();
+#ifdef _OPENMP
+#pragma omp parallel for schedule(dynamic)
+#endif
+    for (int p = 0; p < num_patches; p++) { // loop over patches
+      const int pn = patch_numbers[p];
       Pointer< Patch<DIM> > patch = level->getPatch(pn);
       if ( patch.isNull() ) {
         TBOX_ERROR(  "LevelSetMethodToolbox::"
@@ -1666,9 +1697,15 @@ void LevelSetMethodToolbox<DIM>::TVDRK1Step(
 
     Pointer< PatchLevel<DIM> > level = patch_hierarchy->getPatchLevel(ln);
     
-    typename PatchLevel<DIM>::Iterator pi;
-    for (pi.initialize(level); pi; pi++) { // loop over patches
-      const int pn = *pi;
+    // patches are independent, so they may be processed concurrently
+    vector<int> patch_numbers;
+    getPatchNumbers(level, patch_numbers);
+    const int num_patches = patch_numbers.size();
+#ifdef _OPENMP
+#pragma omp parallel for schedule(dynamic)
+#endif
+    for (int p = 0; p < num_patches; p++) { // loop over patches
+      const int pn = patch_numbers[p];
       Pointer< Patch<DIM> > patch = level->getPatch(pn);
       if ( patch.isNull() ) {
         TBOX_ERROR(  "LevelSetMethodToolbox::" 
@@ -1677,117 +1714,141 @@ void LevelSetMethodToolbox<DIM>::TVDRK1Step(
                   << endl);
       }
 
-      // get pointers to data and index space ranges
-      Pointer< CellData<DIM,LSMLIB_REAL> > u_next_data =
-        patch->getPatchData( u_next_handle );
-      Pointer< CellData<DIM,LSMLIB_REAL> > u_cur_data =
-        patch->getPatchData( u_cur_handle );
-      Pointer< CellData<DIM,LSMLIB_REAL> > rhs_data =
-        patch->getPatchData( rhs_handle );
-  
-      Box<DIM> u_next_ghostbox = u_next_data->getGhostBox();
-      const IntVector<DIM> u_next_ghostbox_lower = u_next_ghostbox.lower();
-      const IntVector<DIM> u_next_ghostbox_upper = u_next_ghostbox.upper();
-
-      Box<DIM> u_cur_ghostbox = u_cur_data->getGhostBox();
-      const IntVector<DIM> u_cur_ghostbox_lower = u_cur_ghostbox.lower();
-      const IntVector<DIM> u_cur_ghostbox_upper = u_cur_ghostbox.upper();
-
-      Box<DIM> rhs_ghostbox = rhs_data->getGhostBox();
-      const IntVector<DIM> rhs_ghostbox_lower = rhs_ghostbox.lower();
-      const IntVector<DIM> rhs_ghostbox_upper = rhs_ghostbox.upper();
-
-      // fill box
-      Box<DIM> fillbox = rhs_data->getBox();
-      const IntVector<DIM> fillbox_lower = fillbox.lower();
-      const IntVector<DIM> fillbox_upper = fillbox.upper();
-
-      LSMLIB_REAL* u_next = u_next_data->getPointer(u_next_component);
-      LSMLIB_REAL* u_cur = u_cur_data->getPointer(u_cur_component);
-      LSMLIB_REAL* rhs = rhs_data->getPointer(rhs_component);
-
-      if ( DIM == 3 ) {
-        LSM3D_RK1_STEP(
-          u_next,
-          &u_next_ghostbox_lower[0],
-          &u_next_ghostbox_upper[0],
-          &u_next_ghostbox_lower[1],
-          &u_next_ghostbox_upper[1],
-          &u_next_ghostbox_lower[2],
-          &u_next_ghostbox_upper[2],
-          u_cur,
-          &u_cur_ghostbox_lower[0],
-          &u_cur_ghostbox_upper[0],
-          &u_cur_ghostbox_lower[1],
-          &u_cur_ghostbox_upper[1],
-          &u_cur_ghostbox_lower[2],
-          &u_cur_ghostbox_upper[2],
-          rhs,
-          &rhs_ghostbox_lower[0],
-          &rhs_ghostbox_upper[0],
-          &rhs_ghostbox_lower[1],
-          &rhs_ghostbox_upper[1],
-          &rhs_ghostbox_lower[2],
-          &rhs_ghostbox_upper[2],
-          &fillbox_lower[0],
-          &fillbox_upper[0],
-          &fillbox_lower[1],
-          &fillbox_upper[1],
-          &fillbox_lower[2],
-          &fillbox_upper[2],
-          &dt);
-
-      } else if ( DIM == 2 ) {
-        LSM2D_RK1_STEP(
-          u_next,
-          &u_next_ghostbox_lower[0],
-          &u_next_ghostbox_upper[0],
-          &u_next_ghostbox_lower[1],
-          &u_next_ghostbox_upper[1],
-          u_cur,
-          &u_cur_ghostbox_lower[0],
-          &u_cur_ghostbox_upper[0],
-          &u_cur_ghostbox_lower[1],
-          &u_cur_ghostbox_upper[1],
-          rhs,
-          &rhs_ghostbox_lower[0],
-          &rhs_ghostbox_upper[0],
-          &rhs_ghostbox_lower[1],
-          &rhs_ghostbox_upper[1],
-          &fillbox_lower[0],
-          &fillbox_upper[0],
-          &fillbox_lower[1],
-          &fillbox_upper[1],
-          &dt);
-
-      } else if ( DIM == 1 ) {
-        LSM1D_RK1_STEP(
-          u_next,
-          &u_next_ghostbox_lower[0],
-          &u_next_ghostbox_upper[0],
-          u_cur,
-          &u_cur_ghostbox_lower[0],
-          &u_cur_ghostbox_upper[0],
-          rhs,
-          &rhs_ghostbox_lower[0],
-          &rhs_ghostbox_upper[0],
-          &fillbox_lower[0],
-          &fillbox_upper[0],
-          &dt);
-
-      } else {  // Unsupported dimension
-        TBOX_ERROR(  "LevelSetMethodToolbox::" 
-                  << "TVDRK1Step(): "
-                  << "Invalid value of DIM.  "
-                  << "Only DIM = 1, 2, and 3 are supported."
-                  << endl);
-      }
+      TVDRK1StepOnPatch(
+        patch,
+        u_next_handle,
+        u_cur_handle,
+        rhs_handle,
+        dt,
+        u_next_component,
+        u_cur_component,
+        rhs_component);
 
     } // end loop over patches in level
   } // end loop over levels in hierarchy
 }
 
 
+/* TVDRK1StepOnPatch() */
+template <int DIM> 
+void LevelSetMethodToolbox<DIM>::TVDRK1StepOnPatch(
+  Pointer< Patch<DIM> > patch,
+  const int u_next_handle,
+  const int u_cur_handle,
+  const int rhs_handle,
+  const LSMLIB_REAL dt,
+  const int u_next_component,
+  const int u_cur_component,
+  const int rhs_component)
+{
+  // get pointers to data and index space ranges
+  Pointer< CellData<DIM,LSMLIB_REAL> > u_next_data =
+    patch->getPatchData( u_next_handle );
+  Pointer< CellData<DIM,LSMLIB_REAL> > u_cur_data =
+    patch->getPatchData( u_cur_handle );
+  Pointer< CellData<DIM,LSMLIB_REAL> > rhs_data =
+    patch->getPatchData( rhs_handle );
+  
+  Box<DIM> u_next_ghostbox = u_next_data->getGhostBox();
+  const IntVector<DIM> u_next_ghostbox_lower = u_next_ghostbox.lower();
+  const IntVector<DIM> u_next_ghostbox_upper = u_next_ghostbox.upper();
+
+  Box<DIM> u_cur_ghostbox = u_cur_data->getGhostBox();
+  const IntVector<DIM> u_cur_ghostbox_lower = u_cur_ghostbox.lower();
+  const IntVector<DIM> u_cur_ghostbox_upper = u_cur_ghostbox.upper();
+
+  Box<DIM> rhs_ghostbox = rhs_data->getGhostBox();
+  const IntVector<DIM> rhs_ghostbox_lower = rhs_ghostbox.lower();
+  const IntVector<DIM> rhs_ghostbox_upper = rhs_ghostbox.upper();
+
+  // fill box
+  Box<DIM> fillbox = rhs_data->getBox();
+  const IntVector<DIM> fillbox_lower = fillbox.lower();
+  const IntVector<DIM> fillbox_upper = fillbox.upper();
+
+  LSMLIB_REAL* u_next = u_next_data->getPointer(u_next_component);
+  LSMLIB_REAL* u_cur = u_cur_data->getPointer(u_cur_component);
+  LSMLIB_REAL* rhs = rhs_data->getPointer(rhs_component);
+
+  if ( DIM == 3 ) {
+    LSM3D_RK1_STEP(
+      u_next,
+      &u_next_ghostbox_lower[0],
+      &u_next_ghostbox_upper[0],
+      &u_next_ghostbox_lower[1],
+      &u_next_ghostbox_upper[1],
+      &u_next_ghostbox_lower[2],
+      &u_next_ghostbox_upper[2],
+      u_cur,
+      &u_cur_ghostbox_lower[0],
+      &u_cur_ghostbox_upper[0],
+      &u_cur_ghostbox_lower[1],
+      &u_cur_ghostbox_upper[1],
+      &u_cur_ghostbox_lower[2],
+      &u_cur_ghostbox_upper[2],
+      rhs,
+      &rhs_ghostbox_lower[0],
+      &rhs_ghostbox_upper[0],
+      &rhs_ghostbox_lower[1],
+      &rhs_ghostbox_upper[1],
+      &rhs_ghostbox_lower[2],
+      &rhs_ghostbox_upper[2],
+      &fillbox_lower[0],
+      &fillbox_upper[0],
+      &fillbox_lower[1],
+      &fillbox_upper[1],
+      &fillbox_lower[2],
+      &fillbox_upper[2],
+      &dt);
+
+  } else if ( DIM == 2 ) {
+    LSM2D_RK1_STEP(
+      u_next,
+      &u_next_ghostbox_lower[0],
+      &u_next_ghostbox_upper[0],
+      &u_next_ghostbox_lower[1],
+      &u_next_ghostbox_upper[1],
+      u_cur,
+      &u_cur_ghostbox_lower[0],
+      &u_cur_ghostbox_upper[0],
+      &u_cur_ghostbox_lower[1],
+      &u_cur_ghostbox_upper[1],
+      rhs,
+      &rhs_ghostbox_lower[0],
+      &rhs_ghostbox_upper[0],
+      &rhs_ghostbox_lower[1],
+      &rhs_ghostbox_upper[1],
+      &fillbox_lower[0],
+      &fillbox_upper[0],
+      &fillbox_lower[1],
+      &fillbox_upper[1],
+      &dt);
+
+  } else if ( DIM == 1 ) {
+    LSM1D_RK1_STEP(
+      u_next,
+      &u_next_ghostbox_lower[0],
+      &u_next_ghostbox_upper[0],
+      u_cur,
+      &u_cur_ghostbox_lower[0],
+      &u_cur_ghostbox_upper[0],
+      rhs,
+      &rhs_ghostbox_lower[0],
+      &rhs_ghostbox_upper[0],
+      &fillbox_lower[0],
+      &fillbox_upper[0],
+      &dt);
+
+  } else {  // Unsupported dimension
+    TBOX_ERROR(  "LevelSetMethodToolbox::" 
+              << "TVDRK1Step(): "
+              << "Invalid value of DIM.  "
+              << "Only DIM = 1, 2, and 3 are supported."
+              << endl);
+  }
+}
+
+
 /* TVDRK2Stage1() */
 template <int DIM> 
 void LevelSetMethodToolbox<DIM>::TVDRK2Stage1(
@@ -1807,9 +1868,15 @@ void LevelSetMethodToolbox<DIM>::TVDRK2Stage1(
 
     Pointer< PatchLevel<DIM> > level = patch_hierarchy->getPatchLevel(ln);
     
-    typename PatchLevel<DIM>::Iterator pi;
-    for (pi.initialize(level); pi; pi++) { // loop over patches
-      const int pn = *pi;
+    // patches are independent, so they may be processed concurrently
+    vector<int> patch_numbers;
+    getPatchNumbers(level, patch_numbers);
+    const int num_patches = patch_numbers.size();
+#ifdef _OPENMP
+#pragma omp parallel for schedule(dynamic)
+#endif
+    for (int p = 0; p < num_patches; p++) { // loop over patches
+      const int pn = patch_numbers[p];
       Pointer< Patch<DIM> > patch = level->getPatch(pn);
       if ( patch.isNull() ) {
         TBOX_ERROR(  "LevelSetMethodToolbox::" 
@@ -1818,125 +1885,205 @@ void LevelSetMethodToolbox<DIM>::TVDRK2Stage1(
                   << endl);
       }
 
-      // get pointers to data and index space ranges
-      Pointer< CellData<DIM,LSMLIB_REAL> > u_stage1_data =
-        patch->getPatchData( u_stage1_handle );
-      Pointer< CellData<DIM,LSMLIB_REAL> > u_cur_data =
-        patch->getPatchData( u_cur_handle );
-      Pointer< CellData<DIM,LSMLIB_REAL> > rhs_data =
-        patch->getPatchData( rhs_handle );
-  
-      Box<DIM> u_stage1_ghostbox = u_stage1_data->getGhostBox();
-      const IntVector<DIM> u_stage1_ghostbox_lower = 
-        u_stage1_ghostbox.lower();
-      const IntVector<DIM> u_stage1_ghostbox_upper = 
-        u_stage1_ghostbox.upper();
-
-      Box<DIM> u_cur_ghostbox = u_cur_data->getGhostBox();
-      const IntVector<DIM> u_cur_ghostbox_lower = 
-        u_cur_ghostbox.lower();
-      const IntVector<DIM> u_cur_ghostbox_upper = 
-        u_cur_ghostbox.upper();
-
-      Box<DIM> rhs_ghostbox = rhs_data->getGhostBox();
-      const IntVector<DIM> rhs_ghostbox_lower = rhs_ghostbox.lower();
-      const IntVector<DIM> rhs_ghostbox_upper = rhs_ghostbox.upper();
-
-      // fill box
-      Box<DIM> fillbox = u_stage1_data->getBox();
-      const IntVector<DIM> fillbox_lower = fillbox.lower();
-      const IntVector<DIM> fillbox_upper = fillbox.upper();
+      TVDRK2Stage1OnPatch(
+        patch,
+        u_stage1_handle,
+        u_cur_handle,
+        rhs_handle,
+        dt,
+        u_stage1_component,
+        u_cur_component,
+        rhs_component);
 
-      LSMLIB_REAL* u_stage1 = u_stage1_data->getPointer(u_stage1_component);
-      LSMLIB_REAL* u_cur = u_cur_data->getPointer(u_cur_component);
-      LSMLIB_REAL* rhs = rhs_data->getPointer(rhs_component);
+    } // end loop over patches in level
+  } // end loop over levels in hierarchy
+}
 
-      if ( DIM == 3 ) {
-        LSM3D_TVD_RK2_STAGE1(
-          u_stage1,
-          &u_stage1_ghostbox_lower[0],
-          &u_stage1_ghostbox_upper[0],
-          &u_stage1_ghostbox_lower[1],
-          &u_stage1_ghostbox_upper[1],
-          &u_stage1_ghostbox_lower[2],
-          &u_stage1_ghostbox_upper[2],
-          u_cur,
-          &u_cur_ghostbox_lower[0],
-          &u_cur_ghostbox_upper[0],
-          &u_cur_ghostbox_lower[1],
-          &u_cur_ghostbox_upper[1],
-          &u_cur_ghostbox_lower[2],
-          &u_cur_ghostbox_upper[2],
-          rhs,
-          &rhs_ghostbox_lower[0],
-          &rhs_ghostbox_upper[0],
-          &rhs_ghostbox_lower[1],
-          &rhs_ghostbox_upper[1],
-          &rhs_ghostbox_lower[2],
-          &rhs_ghostbox_upper[2],
-          &fillbox_lower[0],
-          &fillbox_upper[0],
-          &fillbox_lower[1],
-          &fillbox_upper[1],
-          &fillbox_lower[2],
-          &fillbox_upper[2],
-          &dt);
 
-      } else if ( DIM == 2 ) {
-        LSM2D_TVD_RK2_STAGE1(
-          u_stage1,
-          &u_stage1_ghostbox_lower[0],
-          &u_stage1_ghostbox_upper[0],
-          &u_stage1_ghostbox_lower[1],
-          &u_stage1_ghostbox_upper[1],
-          u_cur,
-          &u_cur_ghostbox_lower[0],
-          &u_cur_ghostbox_upper[0],
-          &u_cur_ghostbox_lower[1],
-          &u_cur_ghostbox_upper[1],
-          rhs,
-          &rhs_ghostbox_lower[0],
-          &rhs_ghostbox_upper[0],
-          &rhs_ghostbox_lower[1],
-          &rhs_ghostbox_upper[1],
-          &fillbox_lower[0],
-          &fillbox_upper[0],
-          &fillbox_lower[1],
-          &fillbox_upper[1],
-          &dt);
+/* TVDRK2Stage1OnPatch() */
+template <int DIM> 
+void LevelSetMethodToolbox<DIM>::TVDRK2Stage1OnPatch(
+  Pointer< Patch<DIM> > patch,
+  const int u_stage1_handle,
+  const int u_cur_handle,
+  const int rhs_handle,
+  const LSMLIB_REAL dt,
+  const int u_stage1_component,
+  const int u_cur_component,
+  const int rhs_component)
+{
+  // get pointers to data and index space ranges
+  Pointer< CellData<DIM,LSMLIB_REAL> > u_stage1_data =
+    patch->getPatchData( u_stage1_handle );
+  Pointer< CellData<DIM,LSMLIB_REAL> > u_cur_data =
+    patch->getPatchData( u_cur_handle );
+  Pointer< CellData<DIM,LSMLIB_REAL> > rhs_data =
+    patch->getPatchData( rhs_handle );
+  
+  Box<DIM> u_stage1_ghostbox = u_stage1_data->getGhostBox();
+  const IntVector<DIM> u_stage1_ghostbox_lower = 
+    u_stage1_ghostbox.lower();
+  const IntVector<DIM> u_stage1_ghostbox_upper = 
+    u_stage1_ghostbox.upper();
+
+  Box<DIM> u_cur_ghostbox = u_cur_data->getGhostBox();
+  const IntVector<DIM> u_cur_ghostbox_lower = 
+    u_cur_ghostbox.lower();
+  const IntVector<DIM> u_cur_ghostbox_upper = 
+    u_cur_ghostbox.upper();
+
+  Box<DIM> rhs_ghostbox = rhs_data->getGhostBox();
+  const IntVector<DIM> rhs_ghostbox_lower = rhs_ghostbox.lower();
+  const IntVector<DIM> rhs_ghostbox_upper = rhs_ghostbox.upper();
+
+  // fill box
+  Box<DIM> fillbox = u_stage1_data->getBox();
+  const IntVector<DIM> fillbox_lower = fillbox.lower();
+  const IntVector<DIM> fillbox_upper = fillbox.upper();
+
+  LSMLIB_REAL* u_stage1 = u_stage1_data->getPointer(u_stage1_component);
+  LSMLIB_REAL* u_cur = u_cur_data->getPointer(u_cur_component);
+  LSMLIB_REAL* rhs = rhs_data->getPointer(rhs_component);
+
+  if ( DIM == 3 ) {
+    LSM3D_TVD_RK2_STAGE1(
+      u_stage1,
+      &u_stage1_ghostbox_lower[0],
+      &u_stage1_ghostbox_upper[0],
+      &u_stage1_ghostbox_lower[1],
+      &u_stage1_ghostbox_upper[1],
+      &u_stage1_ghostbox_lower[2],
+      &u_stage1_ghostbox_upper[2],
+      u_cur,
+      &u_cur_ghostbox_lower[0],
+      &u_cur_ghostbox_upper[0],
+      &u_cur_ghostbox_lower[1],
+      &u_cur_ghostbox_upper[1],
+      &u_cur_ghostbox_lower[2],
+      &u_cur_ghostbox_upper[2],
+      rhs,
+      &rhs_ghostbox_lower[0],
+      &rhs_ghostbox_upper[0],
+      &rhs_ghostbox_lower[1],
+      &rhs_ghostbox_upper[1],
+      &rhs_ghostbox_lower[2],
+      &rhs_ghostbox_upper[2],
+      &fillbox_lower[0],
+      &fillbox_upper[0],
+      &fillbox_lower[1],
+      &fillbox_upper[1],
+      &fillbox_lower[2],
+      &fillbox_upper[2],
+      &dt);
+
+  } else if ( DIM == 2 ) {
+    LSM2D_TVD_RK2_STAGE1(
+      u_stage1,
+      &u_stage1_ghostbox_lower[0],
+      &u_stage1_ghostbox_upper[0],
+      &u_stage1_ghostbox_lower[1],
+      &u_stage1_ghostbox_upper[1],
+      u_cur,
+      &u_cur_ghostbox_lower[0],
+      &u_cur_ghostbox_upper[0],
+      &u_cur_ghostbox_lower[1],
+      &u_cur_ghostbox_upper[1],
+      rhs,
+      &rhs_ghostbox_lower[0],
+      &rhs_ghostbox_upper[0],
+      &rhs_ghostbox_lower[1],
+      &rhs_ghostbox_upper[1],
+      &fillbox_lower[0],
+      &fillbox_upper[0],
+      &fillbox_lower[1],
+      &fillbox_upper[1],
+      &dt);
+
+  } else if ( DIM == 1 ) {
+    LSM1D_TVD_RK2_STAGE1(
+      u_stage1,
+      &u_stage1_ghostbox_lower[0],
+      &u_stage1_ghostbox_upper[0],
+      u_cur,
+      &u_cur_ghostbox_lower[0],
+      &u_cur_ghostbox_upper[0],
+      rhs,
+      &rhs_ghostbox_lower[0],
+      &rhs_ghostbox_upper[0],
+      &fillbox_lower[0],
+      &fillbox_upper[0],
+      &dt);
+
+  } else {  // Unsupported dimension
+    TBOX_ERROR(  "LevelSetMethodToolbox::" 
+              << "TVDRK2Stage1(): "
+              << "Invalid value of DIM.  "
+              << "Only DIM = 1, 2, and 3 are supported."
+              << endl);
+  }
+}
 
-      } else if ( DIM == 1 ) {
-        LSM1D_TVD_RK2_STAGE1(
-          u_stage1,
-          &u_stage1_ghostbox_lower[0],
-          &u_stage1_ghostbox_upper[0],
-          u_cur,
-          &u_cur_ghostbox_lower[0],
-          &u_cur_ghostbox_upper[0],
-          rhs,
-          &rhs_ghostbox_lower[0],
-          &rhs_ghostbox_upper[0],
-          &fillbox_lower[0],
-          &fillbox_upper[0],
-          &dt);
 
-      } else {  // Unsupported dimension
+/* TVDRK2Stage2() */
+template <int DIM> 
+void LevelSetMethodToolbox<DIM>::TVDRK2Stage2(
+  Pointer< PatchHierarchy<DIM> > patch_hierarchy,
+  const int u_next_handle,
+  const int u_stage1_handle,
+  const int u_cur_handle,
+  const int rhs_handle,
+  const LSMLIB_REAL dt,
+  const int u_next_component,
+  const int u_stage1_component,
+  const int u_cur_component,
+  const int rhs_component)
+{
+  // loop over PatchHierarchy and take Runge-Kutta step
+  // by calling Fortran routines
+  const int num_levels = patch_hierarchy->getNumberLevels();
+  for ( int ln=0 ; ln < num_levels; ln++ ) {
+
+    Pointer< PatchLevel<DIM> > level = patch_hierarchy->getPatchLevel(ln);
+    
+    // patches are independent, so they may be processed concurrently
+    vector<int> patch_numbers;
+    getPatchNumbers(level, patch_numbers);
+    const int num_patches = patch_numbers.size();
+#ifdef _OPENMP
+#pragma omp parallel for schedule(dynamic)
+#endif
+    for (int p = 0; p < num_patches; p++) { // loop over patches
+      const int pn = patch_numbers[p];
+      Pointer< Patch<DIM> > patch = level->getPatch(pn);
+      if ( patch.isNull() ) {
         TBOX_ERROR(  "LevelSetMethodToolbox::" 
-                  << "TVDRK2Stage1(): "
-                  << "Invalid value of DIM.  "
-                  << "Only DIM = 1, 2, and 3 are supported."
+                  << "TVDRK2Stage2(): "
+                  << "Cannot find patch. Null patch pointer."
                   << endl);
       }
 
+      TVDRK2Stage2OnPatch(
+        patch,
+        u_next_handle,
+        u_stage1_handle,
+        u_cur_handle,
+        rhs_handle,
+        dt,
+        u_next_component,
+        u_stage1_component,
+        u_cur_component,
+        rhs_component);
+
     } // end loop over patches in level
   } // end loop over levels in hierarchy
+
 }
 
 
-/* TVDRK2Stage2() */
+/* TVDRK2Stage2OnPatch() */
 template <int DIM> 
-void LevelSetMethodToolbox<DIM>::TVDRK2Stage2(
-  Pointer< PatchHierarchy<DIM> > patch_hierarchy,
+void LevelSetMethodToolbox<DIM>::TVDRK2Stage2OnPatch(
+  Pointer< Patch<DIM> > patch,
   const int u_next_handle,
   const int u_stage1_handle,
   const int u_cur_handle,
@@ -1946,6 +2093,154 @@ void LevelSetMethodToolbox<DIM>::TVDRK2Stage2(
   const int u_stage1_component,
   const int u_cur_component,
   const int rhs_component)
+{
+  // get pointers to data and index space ranges
+  Pointer< CellData<DIM,LSMLIB_REAL> > u_next_data =
+    patch->getPatchData( u_next_handle );
+  Pointer< CellData<DIM,LSMLIB_REAL> > u_stage1_data =
+    patch->getPatchData( u_stage1_handle );
+  Pointer< CellData<DIM,LSMLIB_REAL> > u_cur_data =
+    patch->getPatchData( u_cur_handle );
+  Pointer< CellData<DIM,LSMLIB_REAL> > rhs_data =
+    patch->getPatchData( rhs_handle );
+  
+  Box<DIM> u_next_ghostbox = u_next_data->getGhostBox();
+  const IntVector<DIM> u_next_ghostbox_lower = 
+    u_next_ghostbox.lower();
+  const IntVector<DIM> u_next_ghostbox_upper = 
+    u_next_ghostbox.upper();
+
+  Box<DIM> u_stage1_ghostbox = u_stage1_data->getGhostBox();
+  const IntVector<DIM> u_stage1_ghostbox_lower = 
+    u_stage1_ghostbox.lower();
+  const IntVector<DIM> u_stage1_ghostbox_upper = 
+    u_stage1_ghostbox.upper();
+
+  Box<DIM> u_cur_ghostbox = u_cur_data->getGhostBox();
+  const IntVector<DIM> u_cur_ghostbox_lower = 
+    u_cur_ghostbox.lower();
+  const IntVector<DIM> u_cur_ghostbox_upper = 
+    u_cur_ghostbox.upper();
+
+  Box<DIM> rhs_ghostbox = rhs_data->getGhostBox();
+  const IntVector<DIM> rhs_ghostbox_lower = rhs_ghostbox.lower();
+  const IntVector<DIM> rhs_ghostbox_upper = rhs_ghostbox.upper();
+
+  // fill box
+  Box<DIM> fillbox = u_next_data->getBox();
+  const IntVector<DIM> fillbox_lower = fillbox.lower();
+  const IntVector<DIM> fillbox_upper = fillbox.upper();
+
+  LSMLIB_REAL* u_next = u_next_data->getPointer(u_next_component);
+  LSMLIB_REAL* u_stage1 = u_stage1_data->getPointer(u_stage1_component);
+  LSMLIB_REAL* u_cur = u_cur_data->getPointer(u_cur_component);
+  LSMLIB_REAL* rhs = rhs_data->getPointer(rhs_component);
+
+  if ( DIM == 3 ) {
+    LSM3D_TVD_RK2_STAGE2(
+      u_next,
+      &u_next_ghostbox_lower[0],
+      &u_next_ghostbox_upper[0],
+      &u_next_ghostbox_lower[1],
+      &u_next_ghostbox_upper[1],
+      &u_next_ghostbox_lower[2],
+      &u_next_ghostbox_upper[2],
+      u_stage1,
+      &u_stage1_ghostbox_lower[0],
+      &u_stage1_ghostbox_upper[0],
+      &u_stage1_ghostbox_lower[1],
+      &u_stage1_ghostbox_upper[1],
+      &u_stage1_ghostbox_lower[2],
+      &u_stage1_ghostbox_upper[2],
+      u_cur,
+      &u_cur_ghostbox_lower[0],
+      &u_cur_ghostbox_upper[0],
+      &u_cur_ghostbox_lower[1],
+      &u_cur_ghostbox_upper[1],
+      &u_cur_ghostbox_lower[2],
+      &u_cur_ghostbox_upper[2],
+      rhs,
+      &rhs_ghostbox_lower[0],
+      &rhs_ghostbox_upper[0],
+      &rhs_ghostbox_lower[1],
+      &rhs_ghostbox_upper[1],
+      &rhs_ghostbox_lower[2],
+      &rhs_ghostbox_upper[2],
+      &fillbox_lower[0],
+      &fillbox_upper[0],
+      &fillbox_lower[1],
+      &fillbox_upper[1],
+      &fillbox_lower[2],
+      &fillbox_upper[2],
+      &dt);
+
+  } else if ( DIM == 2 ) {
+    LSM2D_TVD_RK2_STAGE2(
+      u_next,
+      &u_next_ghostbox_lower[0],
+      &u_next_ghostbox_upper[0],
+      &u_next_ghostbox_lower[1],
+      &u_next_ghostbox_upper[1],
+      u_stage1,
+      &u_stage1_ghostbox_lower[0],
+      &u_stage1_ghostbox_upper[0],
+      &u_stage1_ghostbox_lower[1],
+      &u_stage1_ghostbox_upper[1],
+      u_cur,
+      &u_cur_ghostbox_lower[0],
+      &u_cur_ghostbox_upper[0],
+      &u_cur_ghostbox_lower[1],
+      &u_cur_ghostbox_upper[1],
+      rhs,
+      &rhs_ghostbox_lower[0],
+      &rhs_ghostbox_upper[0],
+      &rhs_ghostbox_lower[1],
+      &rhs_ghostbox_upper[1],
+      &fillbox_lower[0],
+      &fillbox_upper[0],
+      &fillbox_lower[1],
+      &fillbox_upper[1],
+      &dt);
+
+  } else if ( DIM == 1 ) {
+    LSM1D_TVD_RK2_STAGE2(
+      u_next,
+      &u_next_ghostbox_lower[0],
+      &u_next_ghostbox_upper[0],
+      u_stage1,
+      &u_stage1_ghostbox_lower[0],
+      &u_stage1_ghostbox_upper[0],
+      u_cur,
+      &u_cur_ghostbox_lower[0],
+      &u_cur_ghostbox_upper[0],
+      rhs,
+      &rhs_ghostbox_lower[0],
+      &rhs_ghostbox_upper[0],
+      &fillbox_lower[0],
+      &fillbox_upper[0],
+      &dt);
+
+  } else {  // Unsupported dimension
+    TBOX_ERROR(  "LevelSetMethodToolbox::" 
+              << "TVDRK2Stage2(): "
+              << "Invalid value of DIM.  "
+              << "Only DIM = 1, 2, and 3 are supported."
+              << endl);
+  }
+}
+
+
+/* TVDRK3Stage1() */
+template <int DIM> 
+void LevelSetMethodToolbox<DIM>::TVDRK3Stage1(
+  Pointer< PatchHierarchy<DIM> > patch_hierarchy,
+  const int u_stage1_handle,
+  const int u_cur_handle,
+  const int rhs_handle,
+  const LSMLIB_REAL dt,
+  const int u_stage1_component,
+  const int u_cur_component,
+  const int rhs_component)
 {
   // loop over PatchHierarchy and take Runge-Kutta step
   // by calling Fortran routines
@@ -1954,165 +2249,172 @@ void LevelSetMethodToolbox<DIM>::TVDRK2Stage2(
 
     Pointer< PatchLevel<DIM> > level = patch_hierarchy->getPatchLevel(ln);
     
-    typename PatchLevel<DIM>::Iterator pi;
-    for (pi.initialize(level); pi; pi++) { // loop over patches
-      const int pn = *pi;
+    // patches are independent, so they may be processed concurrently
+    vector<int> patch_numbers;
+    getPatchNumbers(level, patch_numbers);
+    const int num_patches = patch_numbers.size();
+#ifdef _OPENMP
+#pragma omp parallel for schedule(dynamic)
+#endif
+    for (int p = 0; p < num_patches; p++) { // loop over patches
+      const int pn = patch_numbers[p];
       Pointer< Patch<DIM> > patch = level->getPatch(pn);
       if ( patch.isNull() ) {
         TBOX_ERROR(  "LevelSetMethodToolbox::" 
-                  << "TVDRK2Stage2(): "
+                  << "TVDRK3Stage1(): "
                   << "Cannot find patch. Null patch pointer."
                   << endl);
       }
 
-      // get pointers to data and index space ranges
-      Pointer< CellData<DIM,LSMLIB_REAL> > u_next_data =
-        patch->getPatchData( u_next_handle );
-      Pointer< CellData<DIM,LSMLIB_REAL> > u_stage1_data =
-        patch->getPatchData( u_stage1_handle );
-      Pointer< CellData<DIM,LSMLIB_REAL> > u_cur_data =
-        patch->getPatchData( u_cur_handle );
-      Pointer< CellData<DIM,LSMLIB_REAL> > rhs_data =
-        patch->getPatchData( rhs_handle );
-  
-      Box<DIM> u_next_ghostbox = u_next_data->getGhostBox();
-      const IntVector<DIM> u_next_ghostbox_lower = 
-        u_next_ghostbox.lower();
-      const IntVector<DIM> u_next_ghostbox_upper = 
-        u_next_ghostbox.upper();
-
-      Box<DIM> u_stage1_ghostbox = u_stage1_data->getGhostBox();
-      const IntVector<DIM> u_stage1_ghostbox_lower = 
-        u_stage1_ghostbox.lower();
-      const IntVector<DIM> u_stage1_ghostbox_upper = 
-        u_stage1_ghostbox.upper();
-
-      Box<DIM> u_cur_ghostbox = u_cur_data->getGhostBox();
-      const IntVector<DIM> u_cur_ghostbox_lower = 
-        u_cur_ghostbox.lower();
-      const IntVector<DIM> u_cur_ghostbox_upper = 
-        u_cur_ghostbox.upper();
-
-      Box<DIM> rhs_ghostbox = rhs_data->getGhostBox();
-      const IntVector<DIM> rhs_ghostbox_lower = rhs_ghostbox.lower();
-      const IntVector<DIM> rhs_ghostbox_upper = rhs_ghostbox.upper();
-
-      // fill box
-      Box<DIM> fillbox = u_next_data->getBox();
-      const IntVector<DIM> fillbox_lower = fillbox.lower();
-      const IntVector<DIM> fillbox_upper = fillbox.upper();
-
-      LSMLIB_REAL* u_next = u_next_data->getPointer(u_next_component);
-      LSMLIB_REAL* u_stage1 = u_stage1_data->getPointer(u_stage1_component);
-      LSMLIB_REAL* u_cur = u_cur_data->getPointer(u_cur_component);
-      LSMLIB_REAL* rhs = rhs_data->getPointer(rhs_component);
-
-      if ( DIM == 3 ) {
-        LSM3D_TVD_RK2_STAGE2(
-          u_next,
-          &u_next_ghostbox_lower[0],
-          &u_next_ghostbox_upper[0],
-          &u_next_ghostbox_lower[1],
-          &u_next_ghostbox_upper[1],
-          &u_next_ghostbox_lower[2],
-          &u_next_ghostbox_upper[2],
-          u_stage1,
-          &u_stage1_ghostbox_lower[0],
-          &u_stage1_ghostbox_upper[0],
-          &u_stage1_ghostbox_lower[1],
-          &u_stage1_ghostbox_upper[1],
-          &u_stage1_ghostbox_lower[2],
-          &u_stage1_ghostbox_upper[2],
-          u_cur,
-          &u_cur_ghostbox_lower[0],
-          &u_cur_ghostbox_upper[0],
-          &u_cur_ghostbox_lower[1],
-          &u_cur_ghostbox_upper[1],
-          &u_cur_ghostbox_lower[2],
-          &u_cur_ghostbox_upper[2],
-          rhs,
-          &rhs_ghostbox_lower[0],
-          &rhs_ghostbox_upper[0],
-          &rhs_ghostbox_lower[1],
-          &rhs_ghostbox_upper[1],
-          &rhs_ghostbox_lower[2],
-          &rhs_ghostbox_upper[2],
-          &fillbox_lower[0],
-          &fillbox_upper[0],
-          &fillbox_lower[1],
-          &fillbox_upper[1],
-          &fillbox_lower[2],
-          &fillbox_upper[2],
-          &dt);
-
-      } else if ( DIM == 2 ) {
-        LSM2D_TVD_RK2_STAGE2(
-          u_next,
-          &u_next_ghostbox_lower[0],
-          &u_next_ghostbox_upper[0],
-          &u_next_ghostbox_lower[1],
-          &u_next_ghostbox_upper[1],
-          u_stage1,
-          &u_stage1_ghostbox_lower[0],
-          &u_stage1_ghostbox_upper[0],
-          &u_stage1_ghostbox_lower[1],
-          &u_stage1_ghostbox_upper[1],
-          u_cur,
-          &u_cur_ghostbox_lower[0],
-          &u_cur_ghostbox_upper[0],
-          &u_cur_ghostbox_lower[1],
-          &u_cur_ghostbox_upper[1],
-          rhs,
-          &rhs_ghostbox_lower[0],
-          &rhs_ghostbox_upper[0],
-          &rhs_ghostbox_lower[1],
-          &rhs_ghostbox_upper[1],
-          &fillbox_lower[0],
-          &fillbox_upper[0],
-          &fillbox_lower[1],
-          &fillbox_upper[1],
-          &dt);
-
-      } else if ( DIM == 1 ) {
-        LSM1D_TVD_RK2_STAGE2(
-          u_next,
-          &u_next_ghostbox_lower[0],
-          &u_next_ghostbox_upper[0],
-          u_stage1,
-          &u_stage1_ghostbox_lower[0],
-          &u_stage1_ghostbox_upper[0],
-          u_cur,
-          &u_cur_ghostbox_lower[0],
-          &u_cur_ghostbox_upper[0],
-          rhs,
-          &rhs_ghostbox_lower[0],
-          &rhs_ghostbox_upper[0],
-          &fillbox_lower[0],
-          &fillbox_upper[0],
-          &dt);
-
-      } else {  // Unsupported dimension
-        TBOX_ERROR(  "LevelSetMethodToolbox::" 
-                  << "TVDRK2Stage2(): "
-                  << "Invalid value of DIM.  "
-                  << "Only DIM = 1, 2, and 3 are supported."
-                  << endl);
-      }
+      TVDRK3Stage1OnPatch(
+        patch,
+        u_stage1_handle,
+        u_cur_handle,
+        rhs_handle,
+        dt,
+        u_stage1_component,
+        u_cur_component,
+        rhs_component);
 
     } // end loop over patches in level
   } // end loop over levels in hierarchy
+}
 
+
+/* TVDRK3Stage1OnPatch() */
+template <int DIM> 
+void LevelSetMethodToolbox<DIM>::TVDRK3Stage1OnPatch(
+  Pointer< Patch<DIM> > patch,
+  const int u_stage1_handle,
+  const int u_cur_handle,
+  const int rhs_handle,
+  const LSMLIB_REAL dt,
+  const int u_stage1_component,
+  const int u_cur_component,
+  const int rhs_component)
+{
+  // get pointers to data and index space ranges
+  Pointer< CellData<DIM,LSMLIB_REAL> > u_stage1_data =
+    patch->getPatchData( u_stage1_handle );
+  Pointer< CellData<DIM,LSMLIB_REAL> > u_cur_data =
+    patch->getPatchData( u_cur_handle );
+  Pointer< CellData<DIM,LSMLIB_REAL> > rhs_data =
+    patch->getPatchData( rhs_handle );
+  
+  Box<DIM> u_stage1_ghostbox = u_stage1_data->getGhostBox();
+  const IntVector<DIM> u_stage1_ghostbox_lower = 
+    u_stage1_ghostbox.lower();
+  const IntVector<DIM> u_stage1_ghostbox_upper = 
+    u_stage1_ghostbox.upper();
+
+  Box<DIM> u_cur_ghostbox = u_cur_data->getGhostBox();
+  const IntVector<DIM> u_cur_ghostbox_lower = 
+    u_cur_ghostbox.lower();
+  const IntVector<DIM> u_cur_ghostbox_upper = 
+    u_cur_ghostbox.upper();
+
+  Box<DIM> rhs_ghostbox = rhs_data->getGhostBox();
+  const IntVector<DIM> rhs_ghostbox_lower = rhs_ghostbox.lower();
+  const IntVector<DIM> rhs_ghostbox_upper = rhs_ghostbox.upper();
+
+  // fill box
+  Box<DIM> fillbox = u_stage1_data->getBox();
+  const IntVector<DIM> fillbox_lower = fillbox.lower();
+  const IntVector<DIM> fillbox_upper = fillbox.upper();
+
+  LSMLIB_REAL* u_stage1 = u_stage1_data->getPointer(u_stage1_component);
+  LSMLIB_REAL* u_cur = u_cur_data->getPointer(u_cur_component);
+  LSMLIB_REAL* rhs = rhs_data->getPointer(rhs_component);
+
+  if ( DIM == 3 ) {
+    LSM3D_TVD_RK3_STAGE1(
+      u_stage1,
+      &u_stage1_ghostbox_lower[0],
+      &u_stage1_ghostbox_upper[0],
+      &u_stage1_ghostbox_lower[1],
+      &u_stage1_ghostbox_upper[1],
+      &u_stage1_ghostbox_lower[2],
+      &u_stage1_ghostbox_upper[2],
+      u_cur,
+      &u_cur_ghostbox_lower[0],
+      &u_cur_ghostbox_upper[0],
+      &u_cur_ghostbox_lower[1],
+      &u_cur_ghostbox_upper[1],
+      &u_cur_ghostbox_lower[2],
+      &u_cur_ghostbox_upper[2],
+      rhs,
+      &rhs_ghostbox_lower[0],
+      &rhs_ghostbox_upper[0],
+      &rhs_ghostbox_lower[1],
+      &rhs_ghostbox_upper[1],
+      &rhs_ghostbox_lower[2],
+      &rhs_ghostbox_upper[2],
+      &fillbox_lower[0],
+      &fillbox_upper[0],
+      &fillbox_lower[1],
+      &fillbox_upper[1],
+      &fillbox_lower[2],
+      &fillbox_upper[2],
+      &dt);
+
+  } else if ( DIM == 2 ) {
+    LSM2D_TVD_RK3_STAGE1(
+      u_stage1,
+      &u_stage1_ghostbox_lower[0],
+      &u_stage1_ghostbox_upper[0],
+      &u_stage1_ghostbox_lower[1],
+      &u_stage1_ghostbox_upper[1],
+      u_cur,
+      &u_cur_ghostbox_lower[0],
+      &u_cur_ghostbox_upper[0],
+      &u_cur_ghostbox_lower[1],
+      &u_cur_ghostbox_upper[1],
+      rhs,
+      &rhs_ghostbox_lower[0],
+      &rhs_ghostbox_upper[0],
+      &rhs_ghostbox_lower[1],
+      &rhs_ghostbox_upper[1],
+      &fillbox_lower[0],
+      &fillbox_upper[0],
+      &fillbox_lower[1],
+      &fillbox_upper[1],
+      &dt);
+
+  } else if ( DIM == 1 ) {
+    LSM1D_TVD_RK3_STAGE1(
+      u_stage1,
+      &u_stage1_ghostbox_lower[0],
+      &u_stage1_ghostbox_upper[0],
+      u_cur,
+      &u_cur_ghostbox_lower[0],
+      &u_cur_ghostbox_upper[0],
+      rhs,
+      &rhs_ghostbox_lower[0],
+      &rhs_ghostbox_upper[0],
+      &fillbox_lower[0],
+      &fillbox_upper[0],
+      &dt);
+
+  } else {  // Unsupported dimension
+    TBOX_ERROR(  "LevelSetMethodToolbox::" 
+              << "TVDRK3Stage1(): "
+              << "Invalid value of DIM.  "
+              << "Only DIM = 1, 2, and 3 are supported."
+              << endl);
+  }
 }
 
 
-/* TVDRK3Stage1() */
+/* TVDRK3Stage2() */
 template <int DIM> 
-void LevelSetMethodToolbox<DIM>::TVDRK3Stage1(
+void LevelSetMethodToolbox<DIM>::TVDRK3Stage2(
   Pointer< PatchHierarchy<DIM> > patch_hierarchy,
+  const int u_stage2_handle,
   const int u_stage1_handle,
   const int u_cur_handle,
   const int rhs_handle,
   const LSMLIB_REAL dt,
+  const int u_stage2_component,
   const int u_stage1_component,
   const int u_cur_component,
   const int rhs_component)
@@ -2124,136 +2426,45 @@ void LevelSetMethodToolbox<DIM>::TVDRK3Stage1(
 
     Pointer< PatchLevel<DIM> > level = patch_hierarchy->getPatchLevel(ln);
     
-    typename PatchLevel<DIM>::Iterator pi;
-    for (pi.initialize(level); pi; pi++) { // loop over patches
-      const int pn = *pi;
+    // patches are independent, so they may be processed concurrently
+    vector<int> patch_numbers;
+    getPatchNumbers(level, patch_numbers);
+    const int num_patches = patch_numbers.size();
+#ifdef _OPENMP
+#pragma omp parallel for schedule(dynamic)
+#endif
+    for (int p = 0; p < num_patches; p++) { // loop over patches
+      const int pn = patch_numbers[p];
       Pointer< Patch<DIM> > patch = level->getPatch(pn);
       if ( patch.isNull() ) {
         TBOX_ERROR(  "LevelSetMethodToolbox::" 
-                  << "TVDRK3Stage1(): "
+                  << "TVDRK3Stage2(): "
                   << "Cannot find patch. Null patch pointer."
                   << endl);
       }
 
-      // get pointers to data and index space ranges
-      Pointer< CellData<DIM,LSMLIB_REAL> > u_stage1_data =
-        patch->getPatchData( u_stage1_handle );
-      Pointer< CellData<DIM,LSMLIB_REAL> > u_cur_data =
-        patch->getPatchData( u_cur_handle );
-      Pointer< CellData<DIM,LSMLIB_REAL> > rhs_data =
-        patch->getPatchData( rhs_handle );
-  
-      Box<DIM> u_stage1_ghostbox = u_stage1_data->getGhostBox();
-      const IntVector<DIM> u_stage1_ghostbox_lower = 
-        u_stage1_ghostbox.lower();
-      const IntVector<DIM> u_stage1_ghostbox_upper = 
-        u_stage1_ghostbox.upper();
-
-      Box<DIM> u_cur_ghostbox = u_cur_data->getGhostBox();
-      const IntVector<DIM> u_cur_ghostbox_lower = 
-        u_cur_ghostbox.lower();
-      const IntVector<DIM> u_cur_ghostbox_upper = 
-        u_cur_ghostbox.upper();
-
-      Box<DIM> rhs_ghostbox = rhs_data->getGhostBox();
-      const IntVector<DIM> rhs_ghostbox_lower = rhs_ghostbox.lower();
-      const IntVector<DIM> rhs_ghostbox_upper = rhs_ghostbox.upper();
-
-      // fill box
-      Box<DIM> fillbox = u_stage1_data->getBox();
-      const IntVector<DIM> fillbox_lower = fillbox.lower();
-      const IntVector<DIM> fillbox_upper = fillbox.upper();
-
-      LSMLIB_REAL* u_stage1 = u_stage1_data->getPointer(u_stage1_component);
-      LSMLIB_REAL* u_cur = u_cur_data->getPointer(u_cur_component);
-      LSMLIB_REAL* rhs = rhs_data->getPointer(rhs_component);
-
-      if ( DIM == 3 ) {
-        LSM3D_TVD_RK3_STAGE1(
-          u_stage1,
-          &u_stage1_ghostbox_lower[0],
-          &u_stage1_ghostbox_upper[0],
-          &u_stage1_ghostbox_lower[1],
-          &u_stage1_ghostbox_upper[1],
-          &u_stage1_ghostbox_lower[2],
-          &u_stage1_ghostbox_upper[2],
-          u_cur,
-          &u_cur_ghostbox_lower[0],
-          &u_cur_ghostbox_upper[0],
-          &u_cur_ghostbox_lower[1],
-          &u_cur_ghostbox_upper[1],
-          &u_cur_ghostbox_lower[2],
-          &u_cur_ghostbox_upper[2],
-          rhs,
-          &rhs_ghostbox_lower[0],
-          &rhs_ghostbox_upper[0],
-          &rhs_ghostbox_lower[1],
-          &rhs_ghostbox_upper[1],
-          &rhs_ghostbox_lower[2],
-          &rhs_ghostbox_upper[2],
-          &fillbox_lower[0],
-          &fillbox_upper[0],
-          &fillbox_lower[1],
-          &fillbox_upper[1],
-          &fillbox_lower[2],
-          &fillbox_upper[2],
-          &dt);
-
-      } else if ( DIM == 2 ) {
-        LSM2D_TVD_RK3_STAGE1(
-          u_stage1,
-          &u_stage1_ghostbox_lower[0],
-          &u_stage1_ghostbox_upper[0],
-          &u_stage1_ghostbox_lower[1],
-          &u_stage1_ghostbox_upper[1],
-          u_cur,
-          &u_cur_ghostbox_lower[0],
-          &u_cur_ghostbox_upper[0],
-          &u_cur_ghostbox_lower[1],
-          &u_cur_ghostbox_upper[1],
-          rhs,
-          &rhs_ghostbox_lower[0],
-          &rhs_ghostbox_upper[0],
-          &rhs_ghostbox_lower[1],
-          &rhs_ghostbox_upper[1],
-          &fillbox_lower[0],
-          &fillbox_upper[0],
-          &fillbox_lower[1],
-          &fillbox_upper[1],
-          &dt);
-
-      } else if ( DIM == 1 ) {
-        LSM1D_TVD_RK3_STAGE1(
-          u_stage1,
-          &u_stage1_ghostbox_lower[0],
-          &u_stage1_ghostbox_upper[0],
-          u_cur,
-          &u_cur_ghostbox_lower[0],
-          &u_cur_ghostbox_upper[0],
-          rhs,
-          &rhs_ghostbox_lower[0],
-          &rhs_ghostbox_upper[0],
-          &fillbox_lower[0],
-          &fillbox_upper[0],
-          &dt);
-
-      } else {  // Unsupported dimension
-        TBOX_ERROR(  "LevelSetMethodToolbox::" 
-                  << "TVDRK3Stage1(): "
-                  << "Invalid value of DIM.  "
-                  << "Only DIM = 1, 2, and 3 are supported."
-                  << endl);
-      }
+      TVDRK3Stage2OnPatch(
+        patch,
+        u_stage2_handle,
+        u_stage1_handle,
+        u_cur_handle,
+        rhs_handle,
+        dt,
+        u_stage2_component,
+        u_stage1_component,
+        u_cur_component,
+        rhs_component);
 
     } // end loop over patches in level
   } // end loop over levels in hierarchy
+
 }
 
 
-/* TVDRK3Stage2() */
+/* TVDRK3Stage2OnPatch() */
 template <int DIM> 
-void LevelSetMethodToolbox<DIM>::TVDRK3Stage2(
-  Pointer< PatchHierarchy<DIM> > patch_hierarchy,
+void LevelSetMethodToolbox<DIM>::TVDRK3Stage2OnPatch(
+  Pointer< Patch<DIM> > patch,
   const int u_stage2_handle,
   const int u_stage1_handle,
   const int u_cur_handle,
@@ -2263,6 +2474,156 @@ void LevelSetMethodToolbox<DIM>::TVDRK3Stage2(
   const int u_stage1_component,
   const int u_cur_component,
   const int rhs_component)
+{
+  // get pointers to data and index space ranges
+  Pointer< CellData<DIM,LSMLIB_REAL> > u_stage2_data =
+    patch->getPatchData( u_stage2_handle );
+  Pointer< CellData<DIM,LSMLIB_REAL> > u_stage1_data =
+    patch->getPatchData( u_stage1_handle );
+  Pointer< CellData<DIM,LSMLIB_REAL> > u_cur_data =
+    patch->getPatchData( u_cur_handle );
+  Pointer< CellData<DIM,LSMLIB_REAL> > rhs_data =
+    patch->getPatchData( rhs_handle );
+  
+  Box<DIM> u_stage2_ghostbox = u_stage2_data->getGhostBox();
+  const IntVector<DIM> u_stage2_ghostbox_lower = 
+    u_stage2_ghostbox.lower();
+  const IntVector<DIM> u_stage2_ghostbox_upper = 
+    u_stage2_ghostbox.upper();
+
+  Box<DIM> u_stage1_ghostbox = u_stage1_data->getGhostBox();
+  const IntVector<DIM> u_stage1_ghostbox_lower = 
+    u_stage1_ghostbox.lower();
+  const IntVector<DIM> u_stage1_ghostbox_upper = 
+    u_stage1_ghostbox.upper();
+
+  Box<DIM> u_cur_ghostbox = u_cur_data->getGhostBox();
+  const IntVector<DIM> u_cur_ghostbox_lower = 
+    u_cur_ghostbox.lower();
+  const IntVector<DIM> u_cur_ghostbox_upper = 
+    u_cur_ghostbox.upper();
+
+  Box<DIM> rhs_ghostbox = rhs_data->getGhostBox();
+  const IntVector<DIM> rhs_ghostbox_lower = rhs_ghostbox.lower();
+  const IntVector<DIM> rhs_ghostbox_upper = rhs_ghostbox.upper();
+
+  // fill box
+  Box<DIM> fillbox = u_stage2_data->getBox();
+  const IntVector<DIM> fillbox_lower = fillbox.lower();
+  const IntVector<DIM> fillbox_upper = fillbox.upper();
+
+  LSMLIB_REAL* u_stage2 = u_stage2_data->getPointer(u_stage2_component);
+  LSMLIB_REAL* u_stage1 = u_stage1_data->getPointer(u_stage1_component);
+  LSMLIB_REAL* u_cur = u_cur_data->getPointer(u_cur_component);
+  LSMLIB_REAL* rhs = rhs_data->getPointer(rhs_component);
+
+  if ( DIM == 3 ) {
+    LSM3D_TVD_RK3_STAGE2(
+      u_stage2,
+      &u_stage2_ghostbox_lower[0],
+      &u_stage2_ghostbox_upper[0],
+      &u_stage2_ghostbox_lower[1],
+      &u_stage2_ghostbox_upper[1],
+      &u_stage2_ghostbox_lower[2],
+      &u_stage2_ghostbox_upper[2],
+      u_stage1,
+      &u_stage1_ghostbox_lower[0],
+      &u_stage1_ghostbox_upper[0],
+      &u_stage1_ghostbox_lower[1],
+      &u_stage1_ghostbox_upper[1],
+      &u_stage1_ghostbox_lower[2],
+      &u_stage1_ghostbox_upper[2],
+      u_cur,
+      &u_cur_ghostbox_lower[0],
+      &u_cur_ghostbox_upper[0],
+      &u_cur_ghostbox_lower[1],
+      &u_cur_ghostbox_upper[1],
+      &u_cur_ghostbox_lower[2],
+      &u_cur_ghostbox_upper[2],
+      rhs,
+      &rhs_ghostbox_lower[0],
+      &rhs_ghostbox_upper[0],
+      &rhs_ghostbox_lower[1],
+      &rhs_ghostbox_upper[1],
+      &rhs_ghostbox_lower[2],
+      &rhs_ghostbox_upper[2],
+      &fillbox_lower[0],
+      &fillbox_upper[0],
+      &fillbox_lower[1],
+      &fillbox_upper[1],
+      &fillbox_lower[2],
+      &fillbox_upper[2],
+      &dt);
+
+  } else if ( DIM == 2 ) {
+    LSM2D_TVD_RK3_STAGE2(
+      u_stage2,
+      &u_stage2_ghostbox_lower[0],
+      &u_stage2_ghostbox_upper[0],
+      &u_stage2_ghostbox_lower[1],
+      &u_stage2_ghostbox_upper[1],
+      u_stage1,
+      &u_stage1_ghostbox_lower[0],
+      &u_stage1_ghostbox_upper[0],
+      &u_stage1_ghostbox_lower[1],
+      &u_stage1_ghostbox_upper[1],
+      u_cur,
+      &u_cur_ghostbox_lower[0],
+      &u_cur_ghostbox_upper[0],
+      &u_cur_ghostbox_lower[1],
+      &u_cur_ghostbox_upper[1],
+      rhs,
+      &rhs_ghostbox_lower[0],
+      &rhs_ghostbox_upper[0],
+      &rhs_ghostbox_lower[1],
+      &rhs_ghostbox_upper[1],
+      &fillbox_lower[0],
+      &fillbox_upper[0],
+      &fillbox_lower[1],
+      &fillbox_upper[1],
+      &dt);
+
+  } else if ( DIM == 1 ) {
+    LSM1D_TVD_RK3_STAGE2(
+      u_stage2,
+      &u_stage2_ghostbox_lower[0],
+      &u_stage2_ghostbox_upper[0],
+      u_stage1,
+      &u_stage1_ghostbox_lower[0],
+      &u_stage1_ghostbox_upper[0],
+      u_cur,
+      &u_cur_ghostbox_lower[0],
+      &u_cur_ghostbox_upper[0],
+      rhs,
+      &rhs_ghostbox_lower[0],
+      &rhs_ghostbox_upper[0],
+      &fillbox_lower[0],
+      &fillbox_upper[0],
+      &dt);
+
+  } else {  // Unsupported dimension
+    TBOX_ERROR(  "LevelSetMethodToolbox::" 
+              << "TVDRK3Stage2(): "
+              << "Invalid value of DIM.  "
+              << "Only DIM = 1, 2, and 3 are supported."
+              << endl);
+  }
+}
+
+
+/* TVDRK3Stage3() */
+template <int DIM> 
+void LevelSetMethodToolbox<DIM>::TVDRK3Stage3(
+  Pointer< PatchHierarchy<DIM> > patch_hierarchy,
+  const int u_next_handle,
+  const int u_stage2_handle,
+  const int u_cur_handle,
+  const int rhs_handle,
+  const LSMLIB_REAL dt,
+  const int u_next_component,
+  const int u_stage2_component,
+  const int u_cur_component,
+  const int rhs_component)
 {
   // loop over PatchHierarchy and take Runge-Kutta step
   // by calling Fortran routines
@@ -2271,169 +2632,377 @@ void LevelSetMethodToolbox<DIM>::TVDRK3Stage2(
 
     Pointer< PatchLevel<DIM> > level = patch_hierarchy->getPatchLevel(ln);
     
-    typename PatchLevel<DIM>::Iterator pi;
-    for (pi.initialize(level); pi; pi++) { // loop over patches
-      const int pn = *pi;
+    // patches are independent, so they may be processed concurrently
+    vector<int> patch_numbers;
+    getPatchNumbers(level, patch_numbers);
+    const int num_patches = patch_numbers.size();
+#ifdef _OPENMP
+#pragma omp parallel for schedule(dynamic)
+#endif
+    for (int p = 0; p < num_patches; p++) { // loop over patches
+      const int pn = patch_numbers[p];
       Pointer< Patch<DIM> > patch = level->getPatch(pn);
       if ( patch.isNull() ) {
         TBOX_ERROR(  "LevelSetMethodToolbox::" 
-                  << "TVDRK3Stage2(): "
+                  << "TVDRK3Stage3(): "
                   << "Cannot find patch. Null patch pointer."
                   << endl);
       }
 
-      // get pointers to data and index space ranges
-      Pointer< CellData<DIM,LSMLIB_REAL> > u_stage2_data =
-        patch->getPatchData( u_stage2_handle );
-      Pointer< CellData<DIM,LSMLIB_REAL> > u_stage1_data =
-        patch->getPatchData( u_stage1_handle );
-      Pointer< CellData<DIM,LSMLIB_REAL> > u_cur_data =
-        patch->getPatchData( u_cur_handle );
-      Pointer< CellData<DIM,LSMLIB_REAL> > rhs_data =
-        patch->getPatchData( rhs_handle );
-  
-      Box<DIM> u_stage2_ghostbox = u_stage2_data->getGhostBox();
-      const IntVector<DIM> u_stage2_ghostbox_lower = 
-        u_stage2_ghostbox.lower();
-      const IntVector<DIM> u_stage2_ghostbox_upper = 
-        u_stage2_ghostbox.upper();
-
-      Box<DIM> u_stage1_ghostbox = u_stage1_data->getGhostBox();
-      const IntVector<DIM> u_stage1_ghostbox_lower = 
-        u_stage1_ghostbox.lower();
-      const IntVector<DIM> u_stage1_ghostbox_upper = 
-        u_stage1_ghostbox.upper();
-
-      Box<DIM> u_cur_ghostbox = u_cur_data->getGhostBox();
-      const IntVector<DIM> u_cur_ghostbox_lower = 
-        u_cur_ghostbox.lower();
-      const IntVector<DIM> u_cur_ghostbox_upper = 
-        u_cur_ghostbox.upper();
-
-      Box<DIM> rhs_ghostbox = rhs_data->getGhostBox();
-      const IntVector<DIM> rhs_ghostbox_lower = rhs_ghostbox.lower();
-      const IntVector<DIM> rhs_ghostbox_upper = rhs_ghostbox.upper();
-
-      // fill box
-      Box<DIM> fillbox = u_stage2_data->getBox();
-      const IntVector<DIM> fillbox_lower = fillbox.lower();
-      const IntVector<DIM> fillbox_upper = fillbox.upper();
+      TVDRK3Stage3OnPatch(
+        patch,
+        u_next_handle,
+        u_stage2_handle,
+        u_cur_handle,
+        rhs_handle,
+        dt,
+        u_next_component,
+        u_stage2_component,
+        u_cur_component,
+        rhs_component);
 
-      LSMLIB_REAL* u_stage2 = u_stage2_data->getPointer(u_stage2_component);
-      LSMLIB_REAL* u_stage1 = u_stage1_data->getPointer(u_stage1_component);
-      LSMLIB_REAL* u_cur = u_cur_data->getPointer(u_cur_component);
-      LSMLIB_REAL* rhs = rhs_data->getPointer(rhs_component);
+    } // end loop over patches in level
+  } // end loop over levels in hierarchy
 
-      if ( DIM == 3 ) {
-        LSM3D_TVD_RK3_STAGE2(
-          u_stage2,
-          &u_stage2_ghostbox_lower[0],
-          &u_stage2_ghostbox_upper[0],
-          &u_stage2_ghostbox_lower[1],
-          &u_stage2_ghostbox_upper[1],
-          &u_stage2_ghostbox_lower[2],
-          &u_stage2_ghostbox_upper[2],
-          u_stage1,
-          &u_stage1_ghostbox_lower[0],
-          &u_stage1_ghostbox_upper[0],
-          &u_stage1_ghostbox_lower[1],
-          &u_stage1_ghostbox_upper[1],
-          &u_stage1_ghostbox_lower[2],
-          &u_stage1_ghostbox_upper[2],
-          u_cur,
-          &u_cur_ghostbox_lower[0],
-          &u_cur_ghostbox_upper[0],
-          &u_cur_ghostbox_lower[1],
-          &u_cur_ghostbox_upper[1],
-          &u_cur_ghostbox_lower[2],
-          &u_cur_ghostbox_upper[2],
-          rhs,
-          &rhs_ghostbox_lower[0],
-          &rhs_ghostbox_upper[0],
-          &rhs_ghostbox_lower[1],
-          &rhs_ghostbox_upper[1],
-          &rhs_ghostbox_lower[2],
-          &rhs_ghostbox_upper[2],
-          &fillbox_lower[0],
-          &fillbox_upper[0],
-          &fillbox_lower[1],
-          &fillbox_upper[1],
-          &fillbox_lower[2],
-          &fillbox_upper[2],
-          &dt);
+}
 
-      } else if ( DIM == 2 ) {
-        LSM2D_TVD_RK3_STAGE2(
-          u_stage2,
-          &u_stage2_ghostbox_lower[0],
-          &u_stage2_ghostbox_upper[0],
-          &u_stage2_ghostbox_lower[1],
-          &u_stage2_ghostbox_upper[1],
-          u_stage1,
-          &u_stage1_ghostbox_lower[0],
-          &u_stage1_ghostbox_upper[0],
-          &u_stage1_ghostbox_lower[1],
-          &u_stage1_ghostbox_upper[1],
-          u_cur,
-          &u_cur_ghostbox_lower[0],
-          &u_cur_ghostbox_upper[0],
-          &u_cur_ghostbox_lower[1],
-          &u_cur_ghostbox_upper[1],
-          rhs,
-          &rhs_ghostbox_lower[0],
-          &rhs_ghostbox_upper[0],
-          &rhs_ghostbox_lower[1],
-          &rhs_ghostbox_upper[1],
-          &fillbox_lower[0],
-          &fillbox_upper[0],
-          &fillbox_lower[1],
-          &fillbox_upper[1],
-          &dt);
 
-      } else if ( DIM == 1 ) {
-        LSM1D_TVD_RK3_STAGE2(
-          u_stage2,
-          &u_stage2_ghostbox_lower[0],
-          &u_stage2_ghostbox_upper[0],
-          u_stage1,
-          &u_stage1_ghostbox_lower[0],
-          &u_stage1_ghostbox_upper[0],
-          u_cur,
-          &u_cur_ghostbox_lower[0],
-          &u_cur_ghostbox_upper[0],
-          rhs,
-          &rhs_ghostbox_lower[0],
-          &rhs_ghostbox_upper[0],
-          &fillbox_lower[0],
-          &fillbox_upper[0],
-          &dt);
+/* TVDRK3Stage3OnPatch() */
+template <int DIM> 
+void LevelSetMethodToolbox<DIM>::TVDRK3Stage3OnPatch(
+  Pointer< Patch<DIM> > patch,
+  const int u_next_handle,
+  const int u_stage2_handle,
+  const int u_cur_handle,
+  const int rhs_handle,
+  const LSMLIB_REAL dt,
+  const int u_next_component,
+  const int u_stage2_component,
+  const int u_cur_component,
+  const int rhs_component)
+{
+  // get pointers to data and index space ranges
+  Pointer< CellData<DIM,LSMLIB_REAL> > u_next_data =
+    patch->getPatchData( u_next_handle );
+  Pointer< CellData<DIM,LSMLIB_REAL> > u_stage2_data =
+    patch->getPatchData( u_stage2_handle );
+  Pointer< CellData<DIM,LSMLIB_REAL> > u_cur_data =
+    patch->getPatchData( u_cur_handle );
+  Pointer< CellData<DIM,LSMLIB_REAL> > rhs_data =
+    patch->getPatchData( rhs_handle );
+  
+  Box<DIM> u_next_ghostbox = u_next_data->getGhostBox();
+  const IntVector<DIM> u_next_ghostbox_lower = 
+    u_next_ghostbox.lower();
+  const IntVector<DIM> u_next_ghostbox_upper = 
+    u_next_ghostbox.upper();
+
+  Box<DIM> u_stage2_ghostbox = u_stage2_data->getGhostBox();
+  const IntVector<DIM> u_stage2_ghostbox_lower = 
+    u_stage2_ghostbox.lower();
+  const IntVector<DIM> u_stage2_ghostbox_upper = 
+    u_stage2_ghostbox.upper();
+
+  Box<DIM> u_cur_ghostbox = u_cur_data->getGhostBox();
+  const IntVector<DIM> u_cur_ghostbox_lower = 
+    u_cur_ghostbox.lower();
+  const IntVector<DIM> u_cur_ghostbox_upper = 
+    u_cur_ghostbox.upper();
+
+  Box<DIM> rhs_ghostbox = rhs_data->getGhostBox();
+  const IntVector<DIM> rhs_ghostbox_lower = rhs_ghostbox.lower();
+  const IntVector<DIM> rhs_ghostbox_upper = rhs_ghostbox.upper();
+
+  // fill box
+  Box<DIM> fillbox = u_stage2_data->getBox();
+  const IntVector<DIM> fillbox_lower = fillbox.lower();
+  const IntVector<DIM> fillbox_upper = fillbox.upper();
+
+  LSMLIB_REAL* u_next = u_next_data->getPointer(u_next_component);
+  LSMLIB_REAL* u_stage2 = u_stage2_data->getPointer(u_stage2_component);
+  LSMLIB_REAL* u_cur = u_cur_data->getPointer(u_cur_component);
+  LSMLIB_REAL* rhs = rhs_data->getPointer(rhs_component);
+
+  if ( DIM == 3 ) {
+    LSM3D_TVD_RK3_STAGE3(
+      u_next,
+      &u_next_ghostbox_lower[0],
+      &u_next_ghostbox_upper[0],
+      &u_next_ghostbox_lower[1],
+      &u_next_ghostbox_upper[1],
+      &u_next_ghostbox_lower[2],
+      &u_next_ghostbox_upper[2],
+      u_stage2,
+      &u_stage2_ghostbox_lower[0],
+      &u_stage2_ghostbox_upper[0],
+      &u_stage2_ghostbox_lower[1],
+      &u_stage2_ghostbox_upper[1],
+      &u_stage2_ghostbox_lower[2],
+      &u_stage2_ghostbox_upper[2],
+      u_cur,
+      &u_cur_ghostbox_lower[0],
+      &u_cur_ghostbox_upper[0],
+      &u_cur_ghostbox_lower[1],
+      &u_cur_ghostbox_upper[1],
+      &u_cur_ghostbox_lower[2],
+      &u_cur_ghostbox_upper[2],
+      rhs,
+      &rhs_ghostbox_lower[0],
+      &rhs_ghostbox_upper[0],
+      &rhs_ghostbox_lower[1],
+      &rhs_ghostbox_upper[1],
+      &rhs_ghostbox_lower[2],
+      &rhs_ghostbox_upper[2],
+      &fillbox_lower[0],
+      &fillbox_upper[0],
+      &fillbox_lower[1],
+      &fillbox_upper[1],
+      &fillbox_lower[2],
+      &fillbox_upper[2],
+      &dt);
+
+  } else if ( DIM == 2 ) {
+    LSM2D_TVD_RK3_STAGE3(
+      u_next,
+      &u_next_ghostbox_lower[0],
+      &u_next_ghostbox_upper[0],
+      &u_next_ghostbox_lower[1],
+      &u_next_ghostbox_upper[1],
+      u_stage2,
+      &u_stage2_ghostbox_lower[0],
+      &u_stage2_ghostbox_upper[0],
+      &u_stage2_ghostbox_lower[1],
+      &u_stage2_ghostbox_upper[1],
+      u_cur,
+      &u_cur_ghostbox_lower[0],
+      &u_cur_ghostbox_upper[0],
+      &u_cur_ghostbox_lower[1],
+      &u_cur_ghostbox_upper[1],
+      rhs,
+      &rhs_ghostbox_lower[0],
+      &rhs_ghostbox_upper[0],
+      &rhs_ghostbox_lower[1],
+      &rhs_ghostbox_upper[1],
+      &fillbox_lower[0],
+      &fillbox_upper[0],
+      &fillbox_lower[1],
+      &fillbox_upper[1],
+      &dt);
+
+  } else if ( DIM == 1 ) {
+    LSM1D_TVD_RK3_STAGE3(
+      u_next,
+      &u_next_ghostbox_lower[0],
+      &u_next_ghostbox_upper[0],
+      u_stage2,
+      &u_stage2_ghostbox_lower[0],
+      &u_stage2_ghostbox_upper[0],
+      u_cur,
+      &u_cur_ghostbox_lower[0],
+      &u_cur_ghostbox_upper[0],
+      rhs,
+      &rhs_ghostbox_lower[0],
+      &rhs_ghostbox_upper[0],
+      &fillbox_lower[0],
+      &fillbox_upper[0],
+      &dt);
+
+  } else {  // Unsupported dimension
+    TBOX_ERROR(  "LevelSetMethodToolbox::" 
+              << "TVDRK3Stage3(): "
+              << "Invalid value of DIM.  "
+              << "Only DIM = 1, 2, and 3 are supported."
+              << endl);
+  }
+}
 
-      } else {  // Unsupported dimension
+
+/* LowStorageTVDRK3Stage2() */
+template <int DIM> 
+void LevelSetMethodToolbox<DIM>::LowStorageTVDRK3Stage2(
+  Pointer< PatchHierarchy<DIM> > patch_hierarchy,
+  const int u_stage_handle,
+  const int u_cur_handle,
+  const int rhs_handle,
+  const LSMLIB_REAL dt,
+  const int u_stage_component,
+  const int u_cur_component,
+  const int rhs_component)
+{
+  // loop over PatchHierarchy and take Runge-Kutta step
+  // by calling Fortran routines
+  const int num_levels = patch_hierarchy->getNumberLevels();
+  for ( int ln=0 ; ln < num_levels; ln++ ) {
+
+    Pointer< PatchLevel<DIM> > level = patch_hierarchy->getPatchLevel(ln);
+    
+    // patches are independent, so they may be processed concurrently
+    vector<int> patch_numbers;
+    getPatchNumbers(level, patch_numbers);
+    const int num_patches = patch_numbers.size();
+#ifdef _OPENMP
+#pragma omp parallel for schedule(dynamic)
+#endif
+    for (int p = 0; p < num_patches; p++) { // loop over patches
+      const int pn = patch_numbers[p];
+      Pointer< Patch<DIM> > patch = level->getPatch(pn);
+      if ( patch.isNull() ) {
         TBOX_ERROR(  "LevelSetMethodToolbox::" 
-                  << "TVDRK3Stage2(): "
-                  << "Invalid value of DIM.  "
-                  << "Only DIM = 1, 2, and 3 are supported."
+                  << "LowStorageTVDRK3Stage2(): "
+                  << "Cannot find patch. Null patch pointer."
                   << endl);
       }
 
+      LowStorageTVDRK3Stage2OnPatch(
+        patch,
+        u_stage_handle,
+        u_cur_handle,
+        rhs_handle,
+        dt,
+        u_stage_component,
+        u_cur_component,
+        rhs_component);
+
     } // end loop over patches in level
   } // end loop over levels in hierarchy
 
 }
 
 
-/* TVDRK3Stage3() */
+/* LowStorageTVDRK3Stage2OnPatch() */
 template <int DIM> 
-void LevelSetMethodToolbox<DIM>::TVDRK3Stage3(
+void LevelSetMethodToolbox<DIM>::LowStorageTVDRK3Stage2OnPatch(
+  Pointer< Patch<DIM> > patch,
+  const int u_stage_handle,
+  const int u_cur_handle,
+  const int rhs_handle,
+  const LSMLIB_REAL dt,
+  const int u_stage_component,
+  const int u_cur_component,
+  const int rhs_component)
+{
+  // get pointers to data and index space ranges
+  Pointer< CellData<DIM,LSMLIB_REAL> > u_stage_data =
+    patch->getPatchData( u_stage_handle );
+  Pointer< CellData<DIM,LSMLIB_REAL> > u_cur_data =
+    patch->getPatchData( u_cur_handle );
+  Pointer< CellData<DIM,LSMLIB_REAL> > rhs_data =
+    patch->getPatchData( rhs_handle );
+  
+  Box<DIM> u_stage_ghostbox = u_stage_data->getGhostBox();
+  const IntVector<DIM> u_stage_ghostbox_lower = 
+    u_stage_ghostbox.lower();
+  const IntVector<DIM> u_stage_ghostbox_upper = 
+    u_stage_ghostbox.upper();
+
+  Box<DIM> u_cur_ghostbox = u_cur_data->getGhostBox();
+  const IntVector<DIM> u_cur_ghostbox_lower = 
+    u_cur_ghostbox.lower();
+  const IntVector<DIM> u_cur_ghostbox_upper = 
+    u_cur_ghostbox.upper();
+
+  Box<DIM> rhs_ghostbox = rhs_data->getGhostBox();
+  const IntVector<DIM> rhs_ghostbox_lower = rhs_ghostbox.lower();
+  const IntVector<DIM> rhs_ghostbox_upper = rhs_ghostbox.upper();
+
+  // fill box
+  Box<DIM> fillbox = u_stage_data->getBox();
+  const IntVector<DIM> fillbox_lower = fillbox.lower();
+  const IntVector<DIM> fillbox_upper = fillbox.upper();
+
+  LSMLIB_REAL* u_stage = u_stage_data->getPointer(u_stage_component);
+  LSMLIB_REAL* u_cur = u_cur_data->getPointer(u_cur_component);
+  LSMLIB_REAL* rhs = rhs_data->getPointer(rhs_component);
+
+  if ( DIM == 3 ) {
+    LSM3D_LOW_STORAGE_TVD_RK3_STAGE2(
+      u_stage,
+      &u_stage_ghostbox_lower[0],
+      &u_stage_ghostbox_upper[0],
+      &u_stage_ghostbox_lower[1],
+      &u_stage_ghostbox_upper[1],
+      &u_stage_ghostbox_lower[2],
+      &u_stage_ghostbox_upper[2],
+      u_cur,
+      &u_cur_ghostbox_lower[0],
+      &u_cur_ghostbox_upper[0],
+      &u_cur_ghostbox_lower[1],
+      &u_cur_ghostbox_upper[1],
+      &u_cur_ghostbox_lower[2],
+      &u_cur_ghostbox_upper[2],
+      rhs,
+      &rhs_ghostbox_lower[0],
+      &rhs_ghostbox_upper[0],
+      &rhs_ghostbox_lower[1],
+      &rhs_ghostbox_upper[1],
+      &rhs_ghostbox_lower[2],
+      &rhs_ghostbox_upper[2],
+      &fillbox_lower[0],
+      &fillbox_upper[0],
+      &fillbox_lower[1],
+      &fillbox_upper[1],
+      &fillbox_lower[2],
+      &fillbox_upper[2],
+      &dt);
+
+  } else if ( DIM == 2 ) {
+    LSM2D_LOW_STORAGE_TVD_RK3_STAGE2(
+      u_stage,
+      &u_stage_ghostbox_lower[0],
+      &u_stage_ghostbox_upper[0],
+      &u_stage_ghostbox_lower[1],
+      &u_stage_ghostbox_upper[1],
+      u_cur,
+      &u_cur_ghostbox_lower[0],
+      &u_cur_ghostbox_upper[0],
+      &u_cur_ghostbox_lower[1],
+      &u_cur_ghostbox_upper[1],
+      rhs,
+      &rhs_ghostbox_lower[0],
+      &rhs_ghostbox_upper[0],
+      &rhs_ghostbox_lower[1],
+      &rhs_ghostbox_upper[1],
+      &fillbox_lower[0],
+      &fillbox_upper[0],
+      &fillbox_lower[1],
+      &fillbox_upper[1],
+      &dt);
+
+  } else if ( DIM == 1 ) {
+    LSM1D_LOW_STORAGE_TVD_RK3_STAGE2(
+      u_stage,
+      &u_stage_ghostbox_lower[0],
+      &u_stage_ghostbox_upper[0],
+      u_cur,
+      &u_cur_ghostbox_lower[0],
+      &u_cur_ghostbox_upper[0],
+      rhs,
+      &rhs_ghostbox_lower[0],
+      &rhs_ghostbox_upper[0],
+      &fillbox_lower[0],
+      &fillbox_upper[0],
+      &dt);
+
+  } else {  // Unsupported dimension
+    TBOX_ERROR(  "LevelSetMethodToolbox::" 
+              << "LowStorageTVDRK3Stage2(): "
+              << "Invalid value of DIM.  "
+              << "Only DIM = 1, 2, and 3 are supported."
+              << endl);
+  }
+}
+
+
+/* LowStorageTVDRK3Stage3() */
+template <int DIM> 
+void LevelSetMethodToolbox<DIM>::LowStorageTVDRK3Stage3(
   Pointer< PatchHierarchy<DIM> > patch_hierarchy,
-  const int u_next_handle,
-  const int u_stage2_handle,
   const int u_cur_handle,
+  const int u_stage_handle,
   const int rhs_handle,
   const LSMLIB_REAL dt,
-  const int u_next_component,
-  const int u_stage2_component,
   const int u_cur_component,
+  const int u_stage_component,
   const int rhs_component)
 {
   // loop over PatchHierarchy and take Runge-Kutta step
@@ -2443,154 +3012,189 @@ void LevelSetMethodToolbox<DIM>::TVDRK3Stage3(
 
     Pointer< PatchLevel<DIM> > level = patch_hierarchy->getPatchLevel(ln);
     
-    typename PatchLevel<DIM>::Iterator pi;
-    for (pi.initialize(level); pi; pi++) { // loop over patches
-      const int pn = *pi;
+    // patches are independent, so they may be processed concurrently
+    vector<int> patch_numbers;
+    getPatchNumbers(level, patch_numbers);
+    const int num_patches = patch_numbers.size();
+#ifdef _OPENMP
+#pragma omp parallel for schedule(dynamic)
+#endif
+    for (int p = 0; p < num_patches; p++) { // loop over patches
+      const int pn = patch_numbers[p];
       Pointer< Patch<DIM> > patch = level->getPatch(pn);
       if ( patch.isNull() ) {
         TBOX_ERROR(  "LevelSetMethodToolbox::" 
-                  << "TVDRK3Stage3(): "
+                  << "LowStorageTVDRK3Stage3(): "
                   << "Cannot find patch. Null patch pointer."
                   << endl);
       }
 
-      // get pointers to data and index space ranges
-      Pointer< CellData<DIM,LSMLIB_REAL> > u_next_data =
-        patch->getPatchData( u_next_handle );
-      Pointer< CellData<DIM,LSMLIB_REAL> > u_stage2_data =
-        patch->getPatchData( u_stage2_handle );
-      Pointer< CellData<DIM,LSMLIB_REAL> > u_cur_data =
-        patch->getPatchData( u_cur_handle );
-      Pointer< CellData<DIM,LSMLIB_REAL> > rhs_data =
-        patch->getPatchData( rhs_handle );
-  
-      Box<DIM> u_next_ghostbox = u_next_data->getGhostBox();
-      const IntVector<DIM> u_next_ghostbox_lower = 
-        u_next_ghostbox.lower();
-      const IntVector<DIM> u_next_ghostbox_upper = 
-        u_next_ghostbox.upper();
-
-      Box<DIM> u_stage2_ghostbox = u_stage2_data->getGhostBox();
-      const IntVector<DIM> u_stage2_ghostbox_lower = 
-        u_stage2_ghostbox.lower();
-      const IntVector<DIM> u_stage2_ghostbox_upper = 
-        u_stage2_ghostbox.upper();
-
-      Box<DIM> u_cur_ghostbox = u_cur_data->getGhostBox();
-      const IntVector<DIM> u_cur_ghostbox_lower = 
-        u_cur_ghostbox.lower();
-      const IntVector<DIM> u_cur_ghostbox_upper = 
-        u_cur_ghostbox.upper();
-
-      Box<DIM> rhs_ghostbox = rhs_data->getGhostBox();
-      const IntVector<DIM> rhs_ghostbox_lower = rhs_ghostbox.lower();
-      const IntVector<DIM> rhs_ghostbox_upper = rhs_ghostbox.upper();
-
-      // fill box
-      Box<DIM> fillbox = u_stage2_data->getBox();
-      const IntVector<DIM> fillbox_lower = fillbox.lower();
-      const IntVector<DIM> fillbox_upper = fillbox.upper();
+      LowStorageTVDRK3Stage3OnPatch(
+        patch,
+        u_cur_handle,
+        u_stage_handle,
+        rhs_handle,
+        dt,
+        u_cur_component,
+        u_stage_component,
+        rhs_component);
 
-      LSMLIB_REAL* u_next = u_next_data->getPointer(u_next_component);
-      LSMLIB_REAL* u_stage2 = u_stage2_data->getPointer(u_stage2_component);
-      LSMLIB_REAL* u_cur = u_cur_data->getPointer(u_cur_component);
-      LSMLIB_REAL* rhs = rhs_data->getPointer(rhs_component);
+    } // end loop over patches in level
+  } // end loop over levels in hierarchy
 
-      if ( DIM == 3 ) {
-        LSM3D_TVD_RK3_STAGE3(
-          u_next,
-          &u_next_ghostbox_lower[0],
-          &u_next_ghostbox_upper[0],
-          &u_next_ghostbox_lower[1],
-          &u_next_ghostbox_upper[1],
-          &u_next_ghostbox_lower[2],
-          &u_next_ghostbox_upper[2],
-          u_stage2,
-          &u_stage2_ghostbox_lower[0],
-          &u_stage2_ghostbox_upper[0],
-          &u_stage2_ghostbox_lower[1],
-          &u_stage2_ghostbox_upper[1],
-          &u_stage2_ghostbox_lower[2],
-          &u_stage2_ghostbox_upper[2],
-          u_cur,
-          &u_cur_ghostbox_lower[0],
-          &u_cur_ghostbox_upper[0],
-          &u_cur_ghostbox_lower[1],
-          &u_cur_ghostbox_upper[1],
-          &u_cur_ghostbox_lower[2],
-          &u_cur_ghostbox_upper[2],
-          rhs,
-          &rhs_ghostbox_lower[0],
-          &rhs_ghostbox_upper[0],
-          &rhs_ghostbox_lower[1],
-          &rhs_ghostbox_upper[1],
-          &rhs_ghostbox_lower[2],
-          &rhs_ghostbox_upper[2],
-          &fillbox_lower[0],
-          &fillbox_upper[0],
-          &fillbox_lower[1],
-          &fillbox_upper[1],
-          &fillbox_lower[2],
-          &fillbox_upper[2],
-          &dt);
+}
 
-      } else if ( DIM == 2 ) {
-        LSM2D_TVD_RK3_STAGE3(
-          u_next,
-          &u_next_ghostbox_lower[0],
-          &u_next_ghostbox_upper[0],
-          &u_next_ghostbox_lower[1],
-          &u_next_ghostbox_upper[1],
-          u_stage2,
-          &u_stage2_ghostbox_lower[0],
-          &u_stage2_ghostbox_upper[0],
-          &u_stage2_ghostbox_lower[1],
-          &u_stage2_ghostbox_upper[1],
-          u_cur,
-          &u_cur_ghostbox_lower[0],
-          &u_cur_ghostbox_upper[0],
-          &u_cur_ghostbox_lower[1],
-          &u_cur_ghostbox_upper[1],
-          rhs,
-          &rhs_ghostbox_lower[0],
-          &rhs_ghostbox_upper[0],
-          &rhs_ghostbox_lower[1],
-          &rhs_ghostbox_upper[1],
-          &fillbox_lower[0],
-          &fillbox_upper[0],
-          &fillbox_lower[1],
-          &fillbox_upper[1],
-          &dt);
 
-      } else if ( DIM == 1 ) {
-        LSM1D_TVD_RK3_STAGE3(
-          u_next,
-          &u_next_ghostbox_lower[0],
-          &u_next_ghostbox_upper[0],
-          u_stage2,
-          &u_stage2_ghostbox_lower[0],
-          &u_stage2_ghostbox_upper[0],
-          u_cur,
-          &u_cur_ghostbox_lower[0],
-          &u_cur_ghostbox_upper[0],
-          rhs,
-          &rhs_ghostbox_lower[0],
-          &rhs_ghostbox_upper[0],
-          &fillbox_lower[0],
-          &fillbox_upper[0],
-          &dt);
+/* LowStorageTVDRK3Stage3OnPatch() */
+template <int DIM> 
+void LevelSetMethodToolbox<DIM>::LowStorageTVDRK3Stage3OnPatch(
+  Pointer< Patch<DIM> > patch,
+  const int u_cur_handle,
+  const int u_stage_handle,
+  const int rhs_handle,
+  const LSMLIB_REAL dt,
+  const int u_cur_component,
+  const int u_stage_component,
+  const int rhs_component)
+{
+  // get pointers to data and index space ranges
+  Pointer< CellData<DIM,LSMLIB_REAL> > u_cur_data =
+    patch->getPatchData( u_cur_handle );
+  Pointer< CellData<DIM,LSMLIB_REAL> > u_stage_data =
+    patch->getPatchData( u_stage_handle );
+  Pointer< CellData<DIM,LSMLIB_REAL> > rhs_data =
+    patch->getPatchData( rhs_handle );
+  
+  Box<DIM> u_cur_ghostbox = u_cur_data->getGhostBox();
+  const IntVector<DIM> u_cur_ghostbox_lower = 
+    u_cur_ghostbox.lower();
+  const IntVector<DIM> u_cur_ghostbox_upper = 
+    u_cur_ghostbox.upper();
+
+  Box<DIM> u_stage_ghostbox = u_stage_data->getGhostBox();
+  const IntVector<DIM> u_stage_ghostbox_lower = 
+    u_stage_ghostbox.lower();
+  const IntVector<DIM> u_stage_ghostbox_upper = 
+    u_stage_ghostbox.upper();
+
+  Box<DIM> rhs_ghostbox = rhs_data->getGhostBox();
+  const IntVector<DIM> rhs_ghostbox_lower = rhs_ghostbox.lower();
+  const IntVector<DIM> rhs_ghostbox_upper = rhs_ghostbox.upper();
+
+  // fill box
+  Box<DIM> fillbox = u_cur_data->getBox();
+  const IntVector<DIM> fillbox_lower = fillbox.lower();
+  const IntVector<DIM> fillbox_upper = fillbox.upper();
+
+  LSMLIB_REAL* u_cur = u_cur_data->getPointer(u_cur_component);
+  LSMLIB_REAL* u_stage = u_stage_data->getPointer(u_stage_component);
+  LSMLIB_REAL* rhs = rhs_data->getPointer(rhs_component);
+
+  if ( DIM == 3 ) {
+    LSM3D_LOW_STORAGE_TVD_RK3_STAGE3(
+      u_cur,
+      &u_cur_ghostbox_lower[0],
+      &u_cur_ghostbox_upper[0],
+      &u_cur_ghostbox_lower[1],
+      &u_cur_ghostbox_upper[1],
+      &u_cur_ghostbox_lower[2],
+      &u_cur_ghostbox_upper[2],
+      u_stage,
+      &u_stage_ghostbox_lower[0],
+      &u_stage_ghostbox_upper[0],
+      &u_stage_ghostbox_lower[1],
+      &u_stage_ghostbox_upper[1],
+      &u_stage_ghostbox_lower[2],
+      &u_stage_ghostbox_upper[2],
+      rhs,
+      &rhs_ghostbox_lower[0],
+      &rhs_ghostbox_upper[0],
+      &rhs_ghostbox_lower[1],
+      &rhs_ghostbox_upper[1],
+      &rhs_ghostbox_lower[2],
+      &rhs_ghostbox_upper[2],
+      &fillbox_lower[0],
+      &fillbox_upper[0],
+      &fillbox_lower[1],
+      &fillbox_upper[1],
+      &fillbox_lower[2],
+      &fillbox_upper[2],
+      &dt);
+
+  } else if ( DIM == 2 ) {
+    LSM2D_LOW_STORAGE_TVD_RK3_STAGE3(
+      u_cur,
+      &u_cur_ghostbox_lower[0],
+      &u_cur_ghostbox_upper[0],
+      &u_cur_ghostbox_lower[1],
+      &u_cur_ghostbox_upper[1],
+      u_stage,
+      &u_stage_ghostbox_lower[0],
+      &u_stage_ghostbox_upper[0],
+      &u_stage_ghostbox_lower[1],
+      &u_stage_ghostbox_upper[1],
+      rhs,
+      &rhs_ghostbox_lower[0],
+      &rhs_ghostbox_upper[0],
+      &rhs_ghostbox_lower[1],
+      &rhs_ghostbox_upper[1],
+      &fillbox_lower[0],
+      &fillbox_upper[0],
+      &fillbox_lower[1],
+      &fillbox_upper[1],
+      &dt);
+
+  } else if ( DIM == 1 ) {
+    LSM1D_LOW_STORAGE_TVD_RK3_STAGE3(
+      u_cur,
+      &u_cur_ghostbox_lower[0],
+      &u_cur_ghostbox_upper[0],
+      u_stage,
+      &u_stage_ghostbox_lower[0],
+      &u_stage_ghostbox_upper[0],
+      rhs,
+      &rhs_ghostbox_lower[0],
+      &rhs_ghostbox_upper[0],
+      &fillbox_lower[0],
+      &fillbox_upper[0],
+      &dt);
+
+  } else {  // Unsupported dimension
+    TBOX_ERROR(  "LevelSetMethodToolbox::" 
+              << "LowStorageTVDRK3Stage3(): "
+              << "Invalid value of DIM.  "
+              << "Only DIM = 1, 2, and 3 are supported."
+              << endl);
+  }
+}
+
 
-      } else {  // Unsupported dimension
-        TBOX_ERROR(  "LevelSetMethodToolbox::" 
-                  << "TVDRK3Stage3(): "
-                  << "Invalid value of DIM.  "
-                  << "Only DIM = 1, 2, and 3 are supported."
-                  << endl);
-      }
+/* allocateSpatialDerivativesScratchData() */
+template <int DIM> 
+void LevelSetMethodToolbox<DIM>::allocateSpatialDerivativesScratchData(
+  Pointer< PatchLevel<DIM> > level,
+  const SPATIAL_DERIVATIVE_TYPE spatial_derivative_type,
+  const int spatial_derivative_order)
+{
+  // make sure that the scratch PatchData handles have been created
+  initializeComputeSpatialDerivativesParameters();
 
-    } // end loop over patches in level
-  } // end loop over levels in hierarchy
+  level->allocatePatchData(
+    getSpatialDerivativesScratchData(spatial_derivative_type,
+                                     spatial_derivative_order));
+}
 
+
+/* deallocateSpatialDerivativesScratchData() */
+template <int DIM> 
+void LevelSetMethodToolbox<DIM>::deallocateSpatialDerivativesScratchData(
+  Pointer< PatchLevel<DIM> > level,
+  const SPATIAL_DERIVATIVE_TYPE spatial_derivative_type,
+  const int spatial_derivative_order)
+{
+  level->deallocatePatchData(
+    getSpatialDerivativesScratchData(spatial_derivative_type,
+                                     spatial_derivative_order));
 }
 
 
@@ -3438,7 +4042,7 @@ void LevelSetMethodToolbox<DIM>::computeUnitNormalVectorFromPhi(
 
               if ( DIM == 3 ) {
               
-                LSM3D_HJ_WENO5(
+                LSM3D_HJ_WENO5_SIMD(
                   grad_phi_plus[0], grad_phi_plus[1], grad_phi_plus[2],
                   &grad_phi_plus_ghostbox_lower[0],
                   &grad_phi_plus_ghostbox_upper[0],
@@ -3477,7 +4081,7 @@ void LevelSetMethodToolbox<DIM>::computeUnitNormalVectorFromPhi(
 
               } else if ( DIM == 2 ) {
               
-                LSM2D_HJ_WENO5(
+                LSM2D_HJ_WENO5_SIMD(
                   grad_phi_plus[0], grad_phi_plus[1],
                   &grad_phi_plus_ghostbox_lower[0],
                   &grad_phi_plus_ghostbox_upper[0],
@@ -4385,7 +4989,7 @@ void LevelSetMethodToolbox<DIM>::computeSignedUnitNormalVectorFromPhi(
 
               if ( DIM == 3 ) {
               
-                LSM3D_HJ_WENO5(
+                LSM3D_HJ_WENO5_SIMD(
                   grad_phi_plus[0], grad_phi_plus[1], grad_phi_plus[2],
                   &grad_phi_plus_ghostbox_lower[0],
                   &grad_phi_plus_ghostbox_upper[0],
@@ -4424,7 +5028,7 @@ void LevelSetMethodToolbox<DIM>::computeSignedUnitNormalVectorFromPhi(
 
               } else if ( DIM == 2 ) {
               
-                LSM2D_HJ_WENO5(
+                LSM2D_HJ_WENO5_SIMD(
                   grad_phi_plus[0], grad_phi_plus[1],
                   &grad_phi_plus_ghostbox_lower[0],
                   &grad_phi_plus_ghostbox_upper[0],
@@ -4804,9 +5408,15 @@ void LevelSetMethodToolbox<DIM>::computeUnitNormalVectorFromGradPhi(
 
     Pointer< PatchLevel<DIM> > level = patch_hierarchy->getPatchLevel(ln);
     
-    typename PatchLevel<DIM>::Iterator pi;
-    for (pi.initialize(level); pi; pi++) { // loop over patches
-      const int pn = *pi;
+    // patches are independent, so they may be processed concurrently
+    vector<int> patch_numbers;
+    getPatchNumbers(level, patch_numbers);
+    const int num_patches = patch_numbers.size();
+#ifdef _OPENMP
+#pragma omp parallel for schedule(dynamic)
+#endif
+    for (int p = 0; p < num_patches; p++) { // loop over patches
+      const int pn = patch_numbers[p];
       Pointer< Patch<DIM> > patch = level->getPatch(pn);
       if ( patch.isNull() ) {
         TBOX_ERROR(  "LevelSetMethodToolbox::"
@@ -4930,9 +5540,15 @@ void LevelSetMethodToolbox<DIM>::computeSignedUnitNormalVectorFromGradPhi(
 
     Pointer< PatchLevel<DIM> > level = patch_hierarchy->getPatchLevel(ln);
     
-    typename PatchLevel<DIM>::Iterator pi;
-    for (pi.initialize(level); pi; pi++) { // loop over patches
-      const int pn = *pi;
+    // patches are independent, so they may be processed concurrently
+    vector<int> patch_numbers;
+    getPatchNumbers(level, patch_numbers);
+    const int num_patches = patch_numbers.size();
+#ifdef _OPENMP
+#pragma omp parallel for schedule(dynamic)
+#endif
+    for (int p = 0; p < num_patches; p++) { // loop over patches
+      const int pn = patch_numbers[p];
       Pointer< Patch<DIM> > patch = level->getPatch(pn);
       if ( patch.isNull() ) {
         TBOX_ERROR(  "LevelSetMethodToolbox::"
@@ -5095,9 +5711,16 @@ LSMLIB_REAL LevelSetMethodToolbox<DIM>::computeVolumeOfRegionDefinedByZeroLevelS
 
       Pointer< PatchLevel<DIM> > level = patch_hierarchy->getPatchLevel(ln);
       
-      typename PatchLevel<DIM>::Iterator pi;
-      for (pi.initialize(level); pi; pi++) { // loop over patches
-        const int pn = *pi;
+      // patches are independent, so they may be processed concurrently
+      vector<int> patch_numbers;
+      getPatchNumbers(level, patch_numbers);
+      const int num_patches = patch_numbers.size();
+      vector<LSMLIB_REAL> volume_on_patches(num_patches);
+#ifdef _OPENMP
+#pragma omp parallel for schedule(dynamic)
+#endif
+      for (int p = 0; p < num_patches; p++) { // loop over patches
+        const int pn = patch_numbers[p];
         Pointer< Patch<DIM> > patch = level->getPatch(pn);
         if ( patch.isNull() ) {
           TBOX_ERROR(  "LevelSetMethodToolbox::" 
@@ -5219,9 +5842,15 @@ LSMLIB_REAL LevelSetMethodToolbox<DIM>::computeVolumeOfRegionDefinedByZeroLevelS
                     << endl);
         }
 
-        volume += volume_on_patch;
+        volume_on_patches[p] = volume_on_patch;
 
       } // end loop over patches in level
+
+      // combine the results in patch order so that they do not
+      // depend on the number of threads
+      for (int p = 0; p < num_patches; p++) {
+        volume += volume_on_patches[p];
+      }
     } // end loop over levels in hierarchy
 
   } else { // integrate over region {x | phi(x) < 0}
@@ -5230,9 +5859,16 @@ LSMLIB_REAL LevelSetMethodToolbox<DIM>::computeVolumeOfRegionDefinedByZeroLevelS
 
       Pointer< PatchLevel<DIM> > level = patch_hierarchy->getPatchLevel(ln);
       
-      typename PatchLevel<DIM>::Iterator pi;
-      for (pi.initialize(level); pi; pi++) { // loop over patches
-        const int pn = *pi;
+      // patches are independent, so they may be processed concurrently
+      vector<int> patch_numbers;
+      getPatchNumbers(level, patch_numbers);
+      const int num_patches = patch_numbers.size();
+      vector<LSMLIB_REAL> volume_on_patches(num_patches);
+#ifdef _OPENMP
+#pragma omp parallel for schedule(dynamic)
+#endif
+      for (int p = 0; p < num_patches; p++) { // loop over patches
+        const int pn = patch_numbers[p];
         Pointer< Patch<DIM> > patch = level->getPatch(pn);
         if ( patch.isNull() ) {
           TBOX_ERROR(  "LevelSetMethodToolbox::" 
@@ -5354,9 +5990,15 @@ LSMLIB_REAL LevelSetMethodToolbox<DIM>::computeVolumeOfRegionDefinedByZeroLevelS
                     << endl);
         }
 
-        volume += volume_on_patch;
+        volume_on_patches[p] = volume_on_patch;
 
       } // end loop over patches in level
+
+      // combine the results in patch order so that they do not
+      // depend on the number of threads
+      for (int p = 0; p < num_patches; p++) {
+        volume += volume_on_patches[p];
+      }
     } // end loop over levels in hierarchy
 
   } // end if statement on (region_indicator > 0)
@@ -5385,9 +6027,16 @@ LSMLIB_REAL LevelSetMethodToolbox<DIM>::computeVolumeOfZeroLevelSet(
 
     Pointer< PatchLevel<DIM> > level = patch_hierarchy->getPatchLevel(ln);
     
-    typename PatchLevel<DIM>::Iterator pi;
-    for (pi.initialize(level); pi; pi++) { // loop over patches
-      const int pn = *pi;
+    // patches are independent, so they may be processed concurrently
+    vector<int> patch_numbers;
+    getPatchNumbers(level, patch_numbers);
+    const int num_patches = patch_numbers.size();
+    vector<LSMLIB_REAL> volume_on_patches(num_patches);
+#ifdef _OPENMP
+#pragma omp parallel for schedule(dynamic)
+#endif
+    for (int p = 0; p < num_patches; p++) { // loop over patches
+      const int pn = patch_numbers[p];
       Pointer< Patch<DIM> > patch = level->getPatch(pn);
       if ( patch.isNull() ) {
         TBOX_ERROR(  "LevelSetMethodToolbox::" 
@@ -5536,15 +6185,239 @@ LSMLIB_REAL LevelSetMethodToolbox<DIM>::computeVolumeOfZeroLevelSet(
                   << endl);
       }
 
-      volume += volume_on_patch;
+      volume_on_patches[p] = volume_on_patch;
 
     } // end loop over patches in level
+
+    // combine the results in patch order so that they do not
+    // depend on the number of threads
+    for (int p = 0; p < num_patches; p++) {
+      volume += volume_on_patches[p];
+    }
   } // end loop over levels in hierarchy
 
   return tbox::MPI::sumReduction(volume);
 }
 
 
+/* computeLengthOfZeroLevelSetCurve() */
+template <int DIM> 
+LSMLIB_REAL LevelSetMethodToolbox<DIM>::computeLengthOfZeroLevelSetCurve(
+  Pointer< PatchHierarchy<DIM> > patch_hierarchy,
+  const int phi_handle,
+  const int psi_handle,
+  const int control_volume_handle,
+  const int phi_component,
+  const int psi_component)
+{
+  if ( DIM != 3 ) {
+    TBOX_ERROR(  "LevelSetMethodToolbox::" 
+              << "computeLengthOfZeroLevelSetCurve(): "
+              << "Invalid value of DIM.  "
+              << "Only DIM = 3 is supported."
+              << endl);
+  }
+
+  LSMLIB_REAL length = 0.0;
+
+  // loop over PatchHierarchy and compute the length on each Patch
+  const int num_levels = patch_hierarchy->getNumberLevels();
+
+  for ( int ln=0 ; ln < num_levels; ln++ ) {
+
+    Pointer< PatchLevel<DIM> > level = patch_hierarchy->getPatchLevel(ln);
+    
+    // patches are independent, so they may be processed concurrently
+    vector<int> patch_numbers;
+    getPatchNumbers(level, patch_numbers);
+    const int num_patches = patch_numbers.size();
+    vector<LSMLIB_REAL> length_on_patches(num_patches);
+#ifdef _OPENMP
+#pragma omp parallel for schedule(dynamic)
+#endif
+    for (int p = 0; p < num_patches; p++) { // loop over patches
+      const int pn = patch_numbers[p];
+      Pointer< Patch<DIM> > patch = level->getPatch(pn);
+      if ( patch.isNull() ) {
+        TBOX_ERROR(  "LevelSetMethodToolbox::" 
+                  << "computeLengthOfZeroLevelSetCurve(): "
+                  << "Cannot find patch. Null patch pointer."
+                  << endl);
+      }
+
+      length_on_patches[p] = computeZeroLevelSetCurveSegmentsOnPatch(
+        patch, 0, phi_handle, psi_handle, control_volume_handle,
+        phi_component, psi_component);
+
+    } // end loop over patches in level
+
+    // combine the results in patch order so that they do not
+    // depend on the number of threads
+    for (int p = 0; p < num_patches; p++) {
+      length += length_on_patches[p];
+    }
+  } // end loop over levels in hierarchy
+
+  return tbox::MPI::sumReduction(length);
+}
+
+
+/* extractZeroLevelSetCurveSegments() */
+template <int DIM> 
+int LevelSetMethodToolbox<DIM>::extractZeroLevelSetCurveSegments(
+  Pointer< PatchHierarchy<DIM> > patch_hierarchy,
+  vector<LSMLIB_REAL>& segments,
+  const int phi_handle,
+  const int psi_handle,
+  const int control_volume_handle,
+  const int phi_component,
+  const int psi_component)
+{
+  if ( DIM != 3 ) {
+    TBOX_ERROR(  "LevelSetMethodToolbox::" 
+              << "extractZeroLevelSetCurveSegments(): "
+              << "Invalid value of DIM.  "
+              << "Only DIM = 3 is supported."
+              << endl);
+  }
+
+  segments.clear();
+
+  // loop over PatchHierarchy and compute the line segments on each Patch
+  const int num_levels = patch_hierarchy->getNumberLevels();
+
+  for ( int ln=0 ; ln < num_levels; ln++ ) {
+
+    Pointer< PatchLevel<DIM> > level = patch_hierarchy->getPatchLevel(ln);
+    
+    // patches are independent, so they may be processed concurrently
+    vector<int> patch_numbers;
+    getPatchNumbers(level, patch_numbers);
+    const int num_patches = patch_numbers.size();
+    vector< vector<LSMLIB_REAL> > segments_on_patches(num_patches);
+#ifdef _OPENMP
+#pragma omp parallel for schedule(dynamic)
+#endif
+    for (int p = 0; p < num_patches; p++) { // loop over patches
+      const int pn = patch_numbers[p];
+      Pointer< Patch<DIM> > patch = level->getPatch(pn);
+      if ( patch.isNull() ) {
+        TBOX_ERROR(  "LevelSetMethodToolbox::" 
+                  << "extractZeroLevelSetCurveSegments(): "
+                  << "Cannot find patch. Null patch pointer."
+                  << endl);
+      }
+
+      computeZeroLevelSetCurveSegmentsOnPatch(
+        patch, &(segments_on_patches[p]), 
+        phi_handle, psi_handle, control_volume_handle,
+        phi_component, psi_component);
+
+    } // end loop over patches in level
+
+    // combine the results in patch order so that they do not
+    // depend on the number of threads
+    for (int p = 0; p < num_patches; p++) {
+      segments.insert(segments.end(), 
+                      segments_on_patches[p].begin(),
+                      segments_on_patches[p].end());
+    }
+  } // end loop over levels in hierarchy
+
+  return segments.size()/6;
+}
+
+
+/* writeZeroLevelSetSurface() */
+template <int DIM> 
+int LevelSetMethodToolbox<DIM>::writeZeroLevelSetSurface(
+  Pointer< PatchHierarchy<DIM> > patch_hierarchy,
+  const string& file_base,
+  const int phi_handle,
+  const int control_volume_handle,
+  const int field_handle,
+  const int phi_component,
+  const int field_component)
+{
+  if ( (DIM != 2) && (DIM != 3) ) {
+    TBOX_ERROR(  "LevelSetMethodToolbox::" 
+              << "writeZeroLevelSetSurface(): "
+              << "Invalid value of DIM.  "
+              << "Only DIM = 2 and DIM = 3 are supported."
+              << endl);
+  }
+
+  const int has_vertex_field = (field_handle >= 0) ? 1 : 0;
+  ZeroLevelSetSurface* surface = 
+    createZeroLevelSetSurface(DIM, has_vertex_field);
+
+  // loop over PatchHierarchy and extract the zero level set on each Patch
+  const int num_levels = patch_hierarchy->getNumberLevels();
+
+  for ( int ln=0 ; ln < num_levels; ln++ ) {
+
+    Pointer< PatchLevel<DIM> > level = patch_hierarchy->getPatchLevel(ln);
+    
+    // patches are independent, so they may be processed concurrently
+    vector<int> patch_numbers;
+    getPatchNumbers(level, patch_numbers);
+    const int num_patches = patch_numbers.size();
+    vector<ZeroLevelSetSurface*> surface_on_patches(num_patches);
+#ifdef _OPENMP
+#pragma omp parallel for schedule(dynamic)
+#endif
+    for (int p = 0; p < num_patches; p++) { // loop over patches
+      const int pn = patch_numbers[p];
+      Pointer< Patch<DIM> > patch = level->getPatch(pn);
+      if ( patch.isNull() ) {
+        TBOX_ERROR(  "LevelSetMethodToolbox::" 
+                  << "writeZeroLevelSetSurface(): "
+                  << "Cannot find patch. Null patch pointer."
+                  << endl);
+      }
+
+      surface_on_patches[p] = 
+        createZeroLevelSetSurface(DIM, has_vertex_field);
+      computeZeroLevelSetSurfaceOnPatch(
+        patch, surface_on_patches[p], 
+        phi_handle, control_volume_handle, field_handle,
+        phi_component, field_component);
+
+    } // end loop over patches in level
+
+    // combine the results in patch order so that they do not
+    // depend on the number of threads
+    for (int p = 0; p < num_patches; p++) {
+      if (appendZeroLevelSetSurface(surface, surface_on_patches[p])) {
+        TBOX_ERROR(  "LevelSetMethodToolbox::" 
+                  << "writeZeroLevelSetSurface(): "
+                  << "Failed to combine zero level sets on patches."
+                  << endl);
+      }
+      destroyZeroLevelSetSurface(surface_on_patches[p]);
+    }
+  } // end loop over levels in hierarchy
+
+  // write zero level set to file for local processor
+  stringstream file_name("");
+  file_name << file_base << "." << tbox::MPI::getRank();
+  string file_name_str = file_name.str();
+  vector<char> file_name_buffer(file_name_str.begin(), file_name_str.end());
+  file_name_buffer.push_back('\0');
+  if (writeZeroLevelSetSurfaceToBinaryFile(surface, &(file_name_buffer[0]))) {
+    TBOX_ERROR(  "LevelSetMethodToolbox::" 
+              << "writeZeroLevelSetSurface(): "
+              << "Unable to write " << file_name_str << "."
+              << endl);
+  }
+
+  const int num_elements = surface->num_elements;
+  destroyZeroLevelSetSurface(surface);
+
+  return num_elements;
+}
+
+
 /* computeVolumeIntegral() */
 template <int DIM> 
 LSMLIB_REAL LevelSetMethodToolbox<DIM>::computeVolumeIntegral(
@@ -5568,9 +6441,16 @@ LSMLIB_REAL LevelSetMethodToolbox<DIM>::computeVolumeIntegral(
 
       Pointer< PatchLevel<DIM> > level = patch_hierarchy->getPatchLevel(ln);
       
-      typename PatchLevel<DIM>::Iterator pi;
-      for (pi.initialize(level); pi; pi++) { // loop over patches
-        const int pn = *pi;
+      // patches are independent, so they may be processed concurrently
+      vector<int> patch_numbers;
+      getPatchNumbers(level, patch_numbers);
+      const int num_patches = patch_numbers.size();
+      vector<LSMLIB_REAL> integral_F_on_patches(num_patches);
+#ifdef _OPENMP
+#pragma omp parallel for schedule(dynamic)
+#endif
+      for (int p = 0; p < num_patches; p++) { // loop over patches
+        const int pn = patch_numbers[p];
         Pointer< Patch<DIM> > patch = level->getPatch(pn);
         if ( patch.isNull() ) {
           TBOX_ERROR(  "LevelSetMethodToolbox::" 
@@ -5714,9 +6594,15 @@ LSMLIB_REAL LevelSetMethodToolbox<DIM>::computeVolumeIntegral(
                     << endl);
         }
 
-        integral_F += integral_F_on_patch;
+        integral_F_on_patches[p] = integral_F_on_patch;
 
       } // end loop over patches in level
+
+      // combine the results in patch order so that they do not
+      // depend on the number of threads
+      for (int p = 0; p < num_patches; p++) {
+        integral_F += integral_F_on_patches[p];
+      }
     } // end loop over levels in hierarchy
 
   } else {
@@ -5725,9 +6611,16 @@ LSMLIB_REAL LevelSetMethodToolbox<DIM>::computeVolumeIntegral(
 
       Pointer< PatchLevel<DIM> > level = patch_hierarchy->getPatchLevel(ln);
       
-      typename PatchLevel<DIM>::Iterator pi;
-      for (pi.initialize(level); pi; pi++) { // loop over patches
-        const int pn = *pi;
+      // patches are independent, so they may be processed concurrently
+      vector<int> patch_numbers;
+      getPatchNumbers(level, patch_numbers);
+      const int num_patches = patch_numbers.size();
+      vector<LSMLIB_REAL> integral_F_on_patches(num_patches);
+#ifdef _OPENMP
+#pragma omp parallel for schedule(dynamic)
+#endif
+      for (int p = 0; p < num_patches; p++) { // loop over patches
+        const int pn = patch_numbers[p];
         Pointer< Patch<DIM> > patch = level->getPatch(pn);
         if ( patch.isNull() ) {
           TBOX_ERROR(  "LevelSetMethodToolbox::" 
@@ -5871,9 +6764,15 @@ LSMLIB_REAL LevelSetMethodToolbox<DIM>::computeVolumeIntegral(
                     << endl);
         }
 
-        integral_F += integral_F_on_patch;
+        integral_F_on_patches[p] = integral_F_on_patch;
 
       } // end loop over patches in level
+
+      // combine the results in patch order so that they do not
+      // depend on the number of threads
+      for (int p = 0; p < num_patches; p++) {
+        integral_F += integral_F_on_patches[p];
+      }
     } // end loop over levels in hierarchy
 
   } // end if statement on (region_indicator > 0)
@@ -5904,9 +6803,16 @@ LSMLIB_REAL LevelSetMethodToolbox<DIM>::computeSurfaceIntegral(
 
     Pointer< PatchLevel<DIM> > level = patch_hierarchy->getPatchLevel(ln);
     
-    typename PatchLevel<DIM>::Iterator pi;
-    for (pi.initialize(level); pi; pi++) { // loop over patches
-      const int pn = *pi;
+    // patches are independent, so they may be processed concurrently
+    vector<int> patch_numbers;
+    getPatchNumbers(level, patch_numbers);
+    const int num_patches = patch_numbers.size();
+    vector<LSMLIB_REAL> integral_F_on_patches(num_patches);
+#ifdef _OPENMP
+#pragma omp parallel for schedule(dynamic)
+#endif
+    for (int p = 0; p < num_patches; p++) { // loop over patches
+      const int pn = patch_numbers[p];
       Pointer< Patch<DIM> > patch = level->getPatch(pn);
       if ( patch.isNull() ) {
         TBOX_ERROR(  "LevelSetMethodToolbox::" 
@@ -6077,9 +6983,15 @@ LSMLIB_REAL LevelSetMethodToolbox<DIM>::computeSurfaceIntegral(
                   << endl);
       }
 
-      integral_F += integral_F_on_patch;
+      integral_F_on_patches[p] = integral_F_on_patch;
 
     } // end loop over patches in level
+
+    // combine the results in patch order so that they do not
+    // depend on the number of threads
+    for (int p = 0; p < num_patches; p++) {
+      integral_F += integral_F_on_patches[p];
+    }
   } // end loop over levels in hierarchy
 
   return tbox::MPI::sumReduction(integral_F);
@@ -6118,9 +7030,16 @@ LSMLIB_REAL LevelSetMethodToolbox<DIM>::computeStableAdvectionDt(
       dx[dir] = dx_level0[dir]/ratio_to_coarsest[dir];
     }
     
-    typename PatchLevel<DIM>::Iterator pi;
-    for (pi.initialize(level); pi; pi++) { // loop over patches
-      const int pn = *pi;
+    // patches are independent, so they may be processed concurrently
+    vector<int> patch_numbers;
+    getPatchNumbers(level, patch_numbers);
+    const int num_patches = patch_numbers.size();
+    vector<LSMLIB_REAL> max_advection_dt_on_patches(num_patches);
+#ifdef _OPENMP
+#pragma omp parallel for schedule(dynamic)
+#endif
+    for (int p = 0; p < num_patches; p++) { // loop over patches
+      const int pn = patch_numbers[p];
       Pointer< Patch<DIM> > patch = level->getPatch(pn);
       if ( patch.isNull() ) {
         TBOX_ERROR(  "LevelSetMethodToolbox::" 
@@ -6227,11 +7146,17 @@ LSMLIB_REAL LevelSetMethodToolbox<DIM>::computeStableAdvectionDt(
                   << endl );
       } // end switch over dimension (DIM) of level set method calculation
 
-      // update max_advection_dt
-      if (max_advection_dt_on_patch < max_advection_dt)
-        max_advection_dt = max_advection_dt_on_patch;
+      // save the stable dt for this patch
+      max_advection_dt_on_patches[p] = max_advection_dt_on_patch;
 
     } // end loop over patches in level
+
+    // combine the results in patch order so that they do not
+    // depend on the number of threads
+    for (int p = 0; p < num_patches; p++) {
+      if (max_advection_dt_on_patches[p] < max_advection_dt)
+        max_advection_dt = max_advection_dt_on_patches[p];
+    }
   } // end loop over levels in hierarchy
 
   return tbox::MPI::minReduction(max_advection_dt);
@@ -6272,9 +7197,16 @@ LSMLIB_REAL LevelSetMethodToolbox<DIM>::computeStableNormalVelocityDt(
       dx[dir] = dx_level0[dir]/ratio_to_coarsest[dir];
     }
     
-    typename PatchLevel<DIM>::Iterator pi;
-    for (pi.initialize(level); pi; pi++) { // loop over patches
-      const int pn = *pi;
+    // patches are independent, so they may be processed concurrently
+    vector<int> patch_numbers;
+    getPatchNumbers(level, patch_numbers);
+    const int num_patches = patch_numbers.size();
+    vector<LSMLIB_REAL> max_normal_vel_dt_on_patches(num_patches);
+#ifdef _OPENMP
+#pragma omp parallel for schedule(dynamic)
+#endif
+    for (int p = 0; p < num_patches; p++) { // loop over patches
+      const int pn = patch_numbers[p];
       Pointer< Patch<DIM> > patch = level->getPatch(pn);
       if ( patch.isNull() ) {
         TBOX_ERROR(  "LevelSetMethodToolbox::" 
@@ -6429,11 +7361,17 @@ LSMLIB_REAL LevelSetMethodToolbox<DIM>::computeStableNormalVelocityDt(
                   << endl );
       } // end switch over dimension (DIM) of level set method calculation
 
-      // update max_normal_vel_dt
-      if (max_normal_vel_dt_on_patch < max_normal_vel_dt)
-        max_normal_vel_dt = max_normal_vel_dt_on_patch;
+      // save the stable dt for this patch
+      max_normal_vel_dt_on_patches[p] = max_normal_vel_dt_on_patch;
 
     } // end loop over patches in level
+
+    // combine the results in patch order so that they do not
+    // depend on the number of threads
+    for (int p = 0; p < num_patches; p++) {
+      if (max_normal_vel_dt_on_patches[p] < max_normal_vel_dt)
+        max_normal_vel_dt = max_normal_vel_dt_on_patches[p];
+    }
   } // end loop over levels in hierarchy
 
   return tbox::MPI::minReduction(max_normal_vel_dt);
@@ -6459,9 +7397,16 @@ LSMLIB_REAL LevelSetMethodToolbox<DIM>::maxNormOfDifference(
 
     Pointer< PatchLevel<DIM> > level = patch_hierarchy->getPatchLevel(ln);
     
-    typename PatchLevel<DIM>::Iterator pi;
-    for (pi.initialize(level); pi; pi++) { // loop over patches
-      const int pn = *pi;
+    // patches are independent, so they may be processed concurrently
+    vector<int> patch_numbers;
+    getPatchNumbers(level, patch_numbers);
+    const int num_patches = patch_numbers.size();
+    vector<LSMLIB_REAL> max_norm_diff_on_patches(num_patches);
+#ifdef _OPENMP
+#pragma omp parallel for schedule(dynamic)
+#endif
+    for (int p = 0; p < num_patches; p++) { // loop over patches
+      const int pn = patch_numbers[p];
       Pointer< Patch<DIM> > patch = level->getPatch(pn);
       if ( patch.isNull() ) {
         TBOX_ERROR(  "LevelSetMethodToolbox::" 
@@ -6585,10 +7530,16 @@ LSMLIB_REAL LevelSetMethodToolbox<DIM>::maxNormOfDifference(
                   << endl);
       }
 
-      if (max_norm_diff < max_norm_diff_on_patch)
-        max_norm_diff = max_norm_diff_on_patch; 
+      max_norm_diff_on_patches[p] = max_norm_diff_on_patch;
 
     } // end loop over patches in level
+
+    // combine the results in patch order so that they do not
+    // depend on the number of threads
+    for (int p = 0; p < num_patches; p++) {
+      if (max_norm_diff < max_norm_diff_on_patches[p])
+        max_norm_diff = max_norm_diff_on_patches[p];
+    }
   } // end loop over levels in hierarchy
 
   return tbox::MPI::maxReduction(max_norm_diff);
@@ -6802,6 +7753,300 @@ void LevelSetMethodToolbox<DIM>::copySAMRAIData(
 }
 
 
+/* getPatchNumbers() */
+template <int DIM> 
+void LevelSetMethodToolbox<DIM>::getPatchNumbers(
+  Pointer< PatchLevel<DIM> > level,
+  vector<int>& patch_numbers)
+{
+  patch_numbers.clear();
+  patch_numbers.reserve(level->getNumberOfPatches());
+
+  typename PatchLevel<DIM>::Iterator pi;
+  for (pi.initialize(level); pi; pi++) { // loop over patches
+    patch_numbers.push_back(*pi);
+  }
+}
+
+
+/* computeZeroLevelSetCurveSegmentsOnPatch() */
+template <int DIM> 
+LSMLIB_REAL LevelSetMethodToolbox<DIM>::computeZeroLevelSetCurveSegmentsOnPatch(
+  Pointer< Patch<DIM> > patch,
+  vector<LSMLIB_REAL>* segments,
+  const int phi_handle,
+  const int psi_handle,
+  const int control_volume_handle,
+  const int phi_component,
+  const int psi_component)
+{
+  // get dx and coordinates of lower corner of patch
+  Pointer< CartesianPatchGeometry<DIM> > patch_geom =
+    patch->getPatchGeometry();
+#ifdef LSMLIB_DOUBLE_PRECISION
+  const double* dx = patch_geom->getDx();
+#else
+  const double* dx_double = patch_geom->getDx();
+  float dx[DIM]; 
+  for (int i = 0; i < DIM; i++) dx[i] = (float) dx_double[i];
+#endif
+  const double* x_lower = patch_geom->getXLower();
+
+  // get pointers to data and index space ranges
+  Pointer< CellData<DIM,LSMLIB_REAL> > phi_data =
+    patch->getPatchData( phi_handle );
+  Pointer< CellData<DIM,LSMLIB_REAL> > psi_data =
+    patch->getPatchData( psi_handle );
+  Pointer< CellData<DIM,LSMLIB_REAL> > control_volume_data =
+    patch->getPatchData( control_volume_handle );
+
+  Box<DIM> phi_ghostbox = phi_data->getGhostBox();
+  const IntVector<DIM> phi_ghostbox_lower = phi_ghostbox.lower();
+  const IntVector<DIM> phi_ghostbox_upper = phi_ghostbox.upper();
+
+  // LSM3D_findLineSegmentsInBox() requires phi and psi to have the 
+  // same layout and at least one ghostcell
+  if ( !(psi_data->getGhostBox() == phi_ghostbox) ) {
+    TBOX_ERROR(  "LevelSetMethodToolbox::" 
+              << "computeZeroLevelSetCurveSegmentsOnPatch(): "
+              << "phi and psi must have the same ghostcell width."
+              << endl);
+  }
+  if ( phi_data->getGhostCellWidth().min() < 1 ) {
+    TBOX_ERROR(  "LevelSetMethodToolbox::" 
+              << "computeZeroLevelSetCurveSegmentsOnPatch(): "
+              << "phi and psi must have at least one ghostcell."
+              << endl);
+  }
+
+  Box<DIM> control_volume_ghostbox = control_volume_data->getGhostBox();
+  const IntVector<DIM> control_volume_ghostbox_lower = 
+    control_volume_ghostbox.lower();
+  const IntVector<DIM> control_volume_ghostbox_upper = 
+    control_volume_ghostbox.upper();
+
+  // interior box
+  Box<DIM> interior_box = patch->getBox();
+  const IntVector<DIM> interior_box_lower = interior_box.lower();
+  const IntVector<DIM> interior_box_upper = interior_box.upper();
+
+  // coordinates of the cell center at the lower corner of the ghostbox
+  LSMLIB_REAL x_lo[LSM_DIM_MAX];
+  for (int k = 0; k < DIM; k++) {
+    x_lo[k] = x_lower[k] 
+            + (phi_ghostbox_lower[k] - interior_box_lower[k] + 0.5)*dx[k];
+  }
+
+  LSMLIB_REAL* phi = phi_data->getPointer(phi_component);
+  LSMLIB_REAL* psi = psi_data->getPointer(psi_component);
+  LSMLIB_REAL* control_volume = control_volume_data->getPointer();
+  LSMLIB_REAL length_on_patch = 0.0;
+
+  // initial guess for the number of line segments (recomputed below 
+  // if it is too small)
+  int max_num_segments = 0;
+  if (segments) {
+    const IntVector<DIM> num_cells = interior_box.numberCells();
+    max_num_segments = 6*(num_cells[0] + num_cells[1] + num_cells[2]);
+    segments->resize(6*max_num_segments);
+  }
+
+  int num_segments = 0;
+  for (int attempt = 0; attempt < 2; attempt++) {
+    num_segments = LSM3D_findLineSegmentsInBox(
+      (segments ? &((*segments)[0]) : 0),
+      max_num_segments,
+      &length_on_patch,
+      phi, psi,
+      &phi_ghostbox_lower[0],
+      &phi_ghostbox_upper[0],
+      &phi_ghostbox_lower[1],
+      &phi_ghostbox_upper[1],
+      &phi_ghostbox_lower[2],
+      &phi_ghostbox_upper[2],
+      control_volume,
+      &control_volume_ghostbox_lower[0],
+      &control_volume_ghostbox_upper[0],
+      &control_volume_ghostbox_lower[1],
+      &control_volume_ghostbox_upper[1],
+      &control_volume_ghostbox_lower[2],
+      &control_volume_ghostbox_upper[2],
+      &interior_box_lower[0],
+      &interior_box_upper[0],
+      &interior_box_lower[1],
+      &interior_box_upper[1],
+      &interior_box_lower[2],
+      &interior_box_upper[2],
+      x_lo,
+      &dx[0], &dx[1], &dx[2]);
+
+    if ( (!segments) || (num_segments <= max_num_segments) ) break;
+
+    max_num_segments = num_segments;
+    segments->resize(6*max_num_segments);
+  }
+
+  if (num_segments < 0) {
+    TBOX_ERROR(  "LevelSetMethodToolbox::" 
+              << "computeZeroLevelSetCurveSegmentsOnPatch(): "
+              << "LSM3D_findLineInTetrahedron() failed with error code "
+              << num_segments << "."
+              << endl);
+  }
+
+  if (segments) {
+    segments->resize(6*num_segments);
+  }
+
+  return length_on_patch;
+}
+
+
+/* computeZeroLevelSetSurfaceOnPatch() */
+template <int DIM> 
+int LevelSetMethodToolbox<DIM>::computeZeroLevelSetSurfaceOnPatch(
+  Pointer< Patch<DIM> > patch,
+  ZeroLevelSetSurface* surface,
+  const int phi_handle,
+  const int control_volume_handle,
+  const int field_handle,
+  const int phi_component,
+  const int field_component)
+{
+  // get dx and coordinates of lower corner of patch
+  Pointer< CartesianPatchGeometry<DIM> > patch_geom =
+    patch->getPatchGeometry();
+#ifdef LSMLIB_DOUBLE_PRECISION
+  const double* dx = patch_geom->getDx();
+#else
+  const double* dx_double = patch_geom->getDx();
+  float dx[DIM]; 
+  for (int i = 0; i < DIM; i++) dx[i] = (float) dx_double[i];
+#endif
+  const double* x_lower = patch_geom->getXLower();
+
+  // get pointers to data and index space ranges
+  Pointer< CellData<DIM,LSMLIB_REAL> > phi_data =
+    patch->getPatchData( phi_handle );
+  Pointer< CellData<DIM,LSMLIB_REAL> > control_volume_data =
+    patch->getPatchData( control_volume_handle );
+  Pointer< CellData<DIM,LSMLIB_REAL> > field_data;
+  if (field_handle >= 0) {
+    field_data = patch->getPatchData( field_handle );
+  }
+
+  // the upper corners of the dual cells in the interior box lie in 
+  // the first layer of ghostcells
+  if ( phi_data->getGhostCellWidth().min() < 1 ) {
+    TBOX_ERROR(  "LevelSetMethodToolbox::" 
+              << "computeZeroLevelSetSurfaceOnPatch(): "
+              << "phi must have at least one ghostcell."
+              << endl);
+  }
+  if ( !field_data.isNull() && (field_data->getGhostCellWidth().min() < 1) ) {
+    TBOX_ERROR(  "LevelSetMethodToolbox::" 
+              << "computeZeroLevelSetSurfaceOnPatch(): "
+              << "field must have at least one ghostcell."
+              << endl);
+  }
+
+  Box<DIM> phi_ghostbox = phi_data->getGhostBox();
+  Box<DIM> control_volume_ghostbox = control_volume_data->getGhostBox();
+  Box<DIM> field_ghostbox = field_data.isNull() ? phi_ghostbox 
+                                                : field_data->getGhostBox();
+  Box<DIM> interior_box = patch->getBox();
+
+  // index ranges in the format used by addZeroLevelSetSurfaceInBox()
+  int phi_gb[2*LSM_DIM_MAX];
+  int control_volume_gb[2*LSM_DIM_MAX];
+  int field_gb[2*LSM_DIM_MAX];
+  int ib[2*LSM_DIM_MAX];
+  for (int k = 0; k < DIM; k++) {
+    phi_gb[2*k] = phi_ghostbox.lower(k);
+    phi_gb[2*k+1] = phi_ghostbox.upper(k);
+    control_volume_gb[2*k] = control_volume_ghostbox.lower(k);
+    control_volume_gb[2*k+1] = control_volume_ghostbox.upper(k);
+    field_gb[2*k] = field_ghostbox.lower(k);
+    field_gb[2*k+1] = field_ghostbox.upper(k);
+    ib[2*k] = interior_box.lower(k);
+    ib[2*k+1] = interior_box.upper(k);
+  }
+
+  // coordinates of the cell center at the lower corner of the ghostbox
+  LSMLIB_REAL x_lo[LSM_DIM_MAX];
+  for (int k = 0; k < DIM; k++) {
+    x_lo[k] = x_lower[k] 
+            + (phi_ghostbox.lower(k) - interior_box.lower(k) + 0.5)*dx[k];
+  }
+
+  LSMLIB_REAL* phi = phi_data->getPointer(phi_component);
+  LSMLIB_REAL* control_volume = control_volume_data->getPointer();
+  LSMLIB_REAL* field = field_data.isNull() ? 0 
+                     : field_data->getPointer(field_component);
+
+  int num_elements = addZeroLevelSetSurfaceInBox(
+    surface,
+    phi, phi_gb,
+    field, field_gb,
+    control_volume, control_volume_gb,
+    ib,
+    x_lo,
+    &dx[0]);
+
+  if (num_elements < 0) {
+    TBOX_ERROR(  "LevelSetMethodToolbox::" 
+              << "computeZeroLevelSetSurfaceOnPatch(): "
+              << "addZeroLevelSetSurfaceInBox() failed."
+              << endl);
+  }
+
+  return num_elements;
+}
+
+
+/* getSpatialDerivativesScratchData() */
+template <int DIM> 
+ComponentSelector LevelSetMethodToolbox<DIM>::getSpatialDerivativesScratchData(
+  const SPATIAL_DERIVATIVE_TYPE spatial_derivative_type,
+  const int spatial_derivative_order)
+{
+  ComponentSelector scratch_data;
+
+  switch (spatial_derivative_type) {
+    case ENO: {
+      switch (spatial_derivative_order) { 
+        case 1: {
+          scratch_data.setFlag(s_D1_one_ghostcell_handle);
+          break;
+        }
+        case 2: {
+          scratch_data.setFlag(s_D1_two_ghostcells_handle);
+          scratch_data.setFlag(s_D2_two_ghostcells_handle);
+          break;
+        }
+        case 3: {
+          scratch_data.setFlag(s_D1_three_ghostcells_handle);
+          scratch_data.setFlag(s_D2_three_ghostcells_handle);
+          scratch_data.setFlag(s_D3_three_ghostcells_handle);
+          break;
+        }
+        default: break; // invalid order is reported by the caller
+      }
+      break;
+    }
+    case WENO: {
+      if (spatial_derivative_order == 5) {
+        scratch_data.setFlag(s_D1_three_ghostcells_handle);
+      }
+      break;
+    }
+    default: break; // invalid type is reported by the caller
+  }
+
+  return scratch_data;
+}
+
+
 /* initializeComputeSpatialDerivativesParameters() */
 template <int DIM>
 void LevelSetMethodToolbox<DIM>::initializeComputeSpatialDerivativesParameters()
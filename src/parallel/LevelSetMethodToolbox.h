@@ -35,6 +35,12 @@
  *  - computation of volume and surface integrals over regions
  *    defined by the zero level set; 
  *
+ *  - extraction of the curve defined by the zero level sets of two
+ *    level set functions (codimension-two problems in 3D);
+ *
+ *  - output of the zero level set as a triangle mesh (3D) or line
+ *    segment mesh (2D);
+ *
  *  - computation of stable time step sizes for advection and 
  *    normal velocity evolution; 
  * 
@@ -57,6 +63,7 @@
  */
 
 
+#include <string>
 #include <vector>
 
 #include "SAMRAI_config.h"
@@ -69,6 +76,7 @@
 #include "tbox/Pointer.h"
 
 #include "LSMLIB_config.h"
+#include "lsm_zero_level_set_surface.h"
 
 // SAMRAI namespaces 
 using namespace SAMRAI;
@@ -495,6 +503,277 @@ public:
     const int u_cur_component = 0,
     const int rhs_component = 0);
 
+  /*!
+   * LowStorageTVDRK3Stage2() advances the solution through the second
+   * stage of the third-order TVD Runge-Kutta method by overwriting
+   * the first stage solution.
+   *
+   * Arguments:
+   *  - hierarchy (in):           Pointer to PatchHierarchy containing
+   *                              data
+   *  - u_stage_handle (in/out):  PatchData handle for u_approx(t+dt)
+   *                              on input and u_approx(t+dt/2) on
+   *                              output
+   *  - u_cur_handle (in):        PatchData handle for u(t)
+   *  - rhs_handle (in):          PatchData handle for rhs(t)
+   *  - dt (in):                  time increment to advance u
+   *  - u_stage_component (in):   component of u_stage to use in step
+   *                              (default = 0)
+   *  - u_cur_component (in):     component of u_cur to use in step
+   *                              (default = 0)
+   *  - rhs_component (in):       component of rhs to use in step
+   *                              (default = 0)
+   *
+   * Return value:                none
+   *
+   * NOTES:
+   *  - TVDRK3Stage1(), LowStorageTVDRK3Stage2() and
+   *    LowStorageTVDRK3Stage3() take a complete TVD-RK3 step using
+   *    only two PatchData for the solution (u_cur and u_stage).
+   *    The result is identical to the one computed using
+   *    TVDRK3Stage1(), TVDRK3Stage2() and TVDRK3Stage3().
+   *
+   */
+  static void LowStorageTVDRK3Stage2(
+    Pointer< PatchHierarchy<DIM> > hierarchy,
+    const int u_stage_handle,
+    const int u_cur_handle,
+    const int rhs_handle,
+    const LSMLIB_REAL dt,
+    const int u_stage_component = 0,
+    const int u_cur_component = 0,
+    const int rhs_component = 0);
+
+  /*!
+   * LowStorageTVDRK3Stage3() completes advancing the solution through
+   * a single step of the third-order TVD Runge-Kutta method by
+   * overwriting u(t) with u(t+dt).
+   *
+   * Arguments:
+   *  - hierarchy (in):           Pointer to PatchHierarchy containing
+   *                              data
+   *  - u_cur_handle (in/out):    PatchData handle for u(t) on input
+   *                              and u(t+dt) on output
+   *  - u_stage_handle (in):      PatchData handle for u_approx(t+dt/2)
+   *  - rhs_handle (in):          PatchData handle for rhs(t)
+   *  - dt (in):                  time increment to advance u
+   *  - u_cur_component (in):     component of u_cur to use in step
+   *                              (default = 0)
+   *  - u_stage_component (in):   component of u_stage to use in step
+   *                              (default = 0)
+   *  - rhs_component (in):       component of rhs to use in step
+   *                              (default = 0)
+   *
+   * Return value:                none
+   *
+   */
+  static void LowStorageTVDRK3Stage3(
+    Pointer< PatchHierarchy<DIM> > hierarchy,
+    const int u_cur_handle,
+    const int u_stage_handle,
+    const int rhs_handle,
+    const LSMLIB_REAL dt,
+    const int u_cur_component = 0,
+    const int u_stage_component = 0,
+    const int rhs_component = 0);
+
+  //! @}
+
+
+  //! @{
+  /*!
+   ********************************************************************
+   *
+   * @name Patch-level methods
+   *
+   * Patch-level versions of the spatial derivative and TVD Runge-Kutta
+   * methods.  They allow a caller to compute spatial derivatives, the
+   * RHS and a TVD Runge-Kutta stage in a single loop over the patches
+   * of a PatchLevel while the data for each patch is still in cache.
+   *
+   ********************************************************************/
+
+  /*!
+   * allocateSpatialDerivativesScratchData() allocates the scratch
+   * PatchData required by computeUpwindSpatialDerivativesOnPatch()
+   * and computePlusAndMinusSpatialDerivativesOnPatch() on a 
+   * PatchLevel.
+   *
+   * Arguments:
+   *  - level (in):                     PatchLevel on which to allocate
+   *                                    the scratch PatchData
+   *  - spatial_derivative_type (in):   type of spatial derivative 
+   *  - spatial_derivative_order (in):  order of spatial derivative
+   *
+   * Return value:                      none
+   *
+   * NOTES:
+   *  - The scratch PatchData must be allocated before (and deallocated
+   *    after) the patch loop because PatchData allocation is not
+   *    thread-safe.
+   *
+   */
+  static void allocateSpatialDerivativesScratchData(
+    Pointer< PatchLevel<DIM> > level,
+    const SPATIAL_DERIVATIVE_TYPE spatial_derivative_type,
+    const int spatial_derivative_order);
+
+  /*!
+   * deallocateSpatialDerivativesScratchData() deallocates the scratch
+   * PatchData allocated by allocateSpatialDerivativesScratchData().
+   *
+   * Arguments:
+   *  - level (in):                     PatchLevel on which to deallocate
+   *                                    the scratch PatchData
+   *  - spatial_derivative_type (in):   type of spatial derivative 
+   *  - spatial_derivative_order (in):  order of spatial derivative
+   *
+   * Return value:                      none
+   *
+   */
+  static void deallocateSpatialDerivativesScratchData(
+    Pointer< PatchLevel<DIM> > level,
+    const SPATIAL_DERIVATIVE_TYPE spatial_derivative_type,
+    const int spatial_derivative_order);
+
+  /*!
+   * computeUpwindSpatialDerivativesOnPatch() and 
+   * computePlusAndMinusSpatialDerivativesOnPatch() compute the 
+   * spatial derivatives computed by computeUpwindSpatialDerivatives() 
+   * and computePlusAndMinusSpatialDerivatives() on a single Patch.
+   *
+   * Arguments:
+   *  - patch (in):  Patch on which to compute the spatial derivatives
+   *  - remaining arguments are the same as for the PatchHierarchy 
+   *    versions
+   *
+   * Return value:   none
+   *
+   * NOTES:
+   *  - The scratch PatchData must have been allocated on the 
+   *    PatchLevel containing the Patch using 
+   *    allocateSpatialDerivativesScratchData().
+   *
+   */
+  static void computeUpwindSpatialDerivativesOnPatch(
+    Pointer< Patch<DIM> > patch,
+    const SPATIAL_DERIVATIVE_TYPE spatial_derivative_type,
+    const int spatial_derivative_order,
+    const int grad_phi_handle,
+    const int phi_handle,
+    const int upwind_function_handle,
+    const int phi_component = 0);
+
+  static void computePlusAndMinusSpatialDerivativesOnPatch(
+    Pointer< Patch<DIM> > patch,
+    const SPATIAL_DERIVATIVE_TYPE spatial_derivative_type,
+    const int spatial_derivative_order,
+    const int grad_phi_plus_handle,
+    const int grad_phi_minus_handle,
+    const int phi_handle,
+    const int phi_component = 0);
+
+  /*!
+   * TVDRK1StepOnPatch(), TVDRK2Stage1OnPatch(), TVDRK2Stage2OnPatch(),
+   * TVDRK3Stage1OnPatch(), TVDRK3Stage2OnPatch(), TVDRK3Stage3OnPatch(),
+   * LowStorageTVDRK3Stage2OnPatch() and LowStorageTVDRK3Stage3OnPatch()
+   * take the TVD Runge-Kutta step (or stage) taken by the PatchHierarchy
+   * version of the method on a single Patch.
+   *
+   * Arguments:
+   *  - patch (in):  Patch on which to take the step (or stage)
+   *  - remaining arguments are the same as for the PatchHierarchy 
+   *    versions
+   *
+   * Return value:   none
+   *
+   */
+  static void TVDRK1StepOnPatch(
+    Pointer< Patch<DIM> > patch,
+    const int u_next_handle,
+    const int u_cur_handle,
+    const int rhs_handle,
+    const LSMLIB_REAL dt,
+    const int u_next_component = 0,
+    const int u_cur_component = 0,
+    const int rhs_component = 0);
+
+  static void TVDRK2Stage1OnPatch(
+    Pointer< Patch<DIM> > patch,
+    const int u_stage1_handle,
+    const int u_cur_handle,
+    const int rhs_handle,
+    const LSMLIB_REAL dt,
+    const int u_stage1_component = 0,
+    const int u_cur_component = 0,
+    const int rhs_component = 0);
+
+  static void TVDRK2Stage2OnPatch(
+    Pointer< Patch<DIM> > patch,
+    const int u_next_handle,
+    const int u_stage1_handle,
+    const int u_cur_handle,
+    const int rhs_handle,
+    const LSMLIB_REAL dt,
+    const int u_next_component = 0,
+    const int u_stage1_component = 0,
+    const int u_cur_component = 0,
+    const int rhs_component = 0);
+
+  static void TVDRK3Stage1OnPatch(
+    Pointer< Patch<DIM> > patch,
+    const int u_stage1_handle,
+    const int u_cur_handle,
+    const int rhs_handle,
+    const LSMLIB_REAL dt,
+    const int u_stage1_component = 0,
+    const int u_cur_component = 0,
+    const int rhs_component = 0);
+
+  static void TVDRK3Stage2OnPatch(
+    Pointer< Patch<DIM> > patch,
+    const int u_stage2_handle,
+    const int u_stage1_handle,
+    const int u_cur_handle,
+    const int rhs_handle,
+    const LSMLIB_REAL dt,
+    const int u_stage2_component = 0,
+    const int u_stage1_component = 0,
+    const int u_cur_component = 0,
+    const int rhs_component = 0);
+
+  static void TVDRK3Stage3OnPatch(
+    Pointer< Patch<DIM> > patch,
+    const int u_next_handle,
+    const int u_stage2_handle,
+    const int u_cur_handle,
+    const int rhs_handle,
+    const LSMLIB_REAL dt,
+    const int u_next_component = 0,
+    const int u_stage2_component = 0,
+    const int u_cur_component = 0,
+    const int rhs_component = 0);
+
+  static void LowStorageTVDRK3Stage2OnPatch(
+    Pointer< Patch<DIM> > patch,
+    const int u_stage_handle,
+    const int u_cur_handle,
+    const int rhs_handle,
+    const LSMLIB_REAL dt,
+    const int u_stage_component = 0,
+    const int u_cur_component = 0,
+    const int rhs_component = 0);
+
+  static void LowStorageTVDRK3Stage3OnPatch(
+    Pointer< Patch<DIM> > patch,
+    const int u_cur_handle,
+    const int u_stage_handle,
+    const int rhs_handle,
+    const LSMLIB_REAL dt,
+    const int u_cur_component = 0,
+    const int u_stage_component = 0,
+    const int rhs_component = 0);
+
   //! @}
 
 
@@ -858,6 +1137,145 @@ public:
     const int phi_component = 0,
     const int delta_width = 3);
 
+  /*!
+   * computeLengthOfZeroLevelSetCurve() computes the length of the 
+   * codimension-two curve defined by the zero level sets of phi and psi
+   * (3D problems only).
+   *
+   * Arguments:
+   *  - patch_hierarchy (in):        PatchHierarchy on which to compute 
+   *                                 the length
+   *  - phi_handle (in):             PatchData handle for phi
+   *  - psi_handle (in):             PatchData handle for psi
+   *  - control_volume_handle (in):  PatchData handle for control volume
+   *  - phi_component (in):          component of phi to use as level set 
+   *                                 function (default = 0)
+   *  - psi_component (in):          component of psi to use as level set 
+   *                                 function (default = 0)
+   *
+   * Return value:                   length of curve
+   *
+   * NOTES:
+   *  - The curve is computed by decomposing the grid cells (i.e. the
+   *    cells whose corners are the cell centers of the patch) into 
+   *    tetrahedra (see LSM3D_findLineSegmentsInBox()).  The cells 
+   *    whose lower corners lie in the interior box of each patch are 
+   *    used, so phi and psi must have at least one ghostcell and the 
+   *    ghostcells MUST be filled before calling this method.
+   *
+   *  - Cells whose lower corners are covered by a finer level (i.e. 
+   *    have zero control volume) are excluded.  No attempt is made to
+   *    match the curve across coarse-fine boundaries, so the length
+   *    is accurate only to within a few grid cells of the coarse-fine 
+   *    boundaries crossed by the curve.
+   *
+   */
+  static LSMLIB_REAL computeLengthOfZeroLevelSetCurve(
+    Pointer< PatchHierarchy<DIM> > patch_hierarchy,
+    const int phi_handle,
+    const int psi_handle,
+    const int control_volume_handle,
+    const int phi_component = 0,
+    const int psi_component = 0);
+
+  /*!
+   * extractZeroLevelSetCurveSegments() computes the line segments that
+   * make up the codimension-two curve defined by the zero level sets of 
+   * phi and psi on the patches owned by the local processor (3D problems
+   * only).
+   *
+   * Arguments:
+   *  - patch_hierarchy (in):        PatchHierarchy on which to compute 
+   *                                 the curve
+   *  - segments (out):              endpoints of line segments (x,y,z of
+   *                                 first endpoint followed by x,y,z of 
+   *                                 second endpoint for each segment)
+   *  - phi_handle (in):             PatchData handle for phi
+   *  - psi_handle (in):             PatchData handle for psi
+   *  - control_volume_handle (in):  PatchData handle for control volume
+   *  - phi_component (in):          component of phi to use as level set 
+   *                                 function (default = 0)
+   *  - psi_component (in):          component of psi to use as level set 
+   *                                 function (default = 0)
+   *
+   * Return value:                   number of line segments on the local
+   *                                 processor
+   *
+   * NOTES:
+   *  - The same cells are used as in computeLengthOfZeroLevelSetCurve(),
+   *    so the same requirements on the ghostcells of phi and psi apply.
+   *
+   *  - The segments are oriented in the direction of 
+   *    \f$ \nabla \phi \times \nabla \psi \f$, so they may be 
+   *    joined into polylines (e.g. using 
+   *    createZeroLevelSetCurveFromSegments() from the serial package)
+   *    after they are gathered onto a single processor.
+   *
+   *  - Segments are ordered by level and then by patch (in the order 
+   *    visited by PatchLevel::Iterator), so the result does not depend
+   *    on the number of threads.
+   *
+   */
+  static int extractZeroLevelSetCurveSegments(
+    Pointer< PatchHierarchy<DIM> > patch_hierarchy,
+    vector<LSMLIB_REAL>& segments,
+    const int phi_handle,
+    const int psi_handle,
+    const int control_volume_handle,
+    const int phi_component = 0,
+    const int psi_component = 0);
+
+  /*!
+   * writeZeroLevelSetSurface() extracts the zero level set of phi on the
+   * patches owned by the local processor as a triangle mesh (3D) or a
+   * collection of line segments (2D) and writes it to a binary file.
+   * Each processor writes its own file, so no communication is required.
+   *
+   * Arguments:
+   *  - patch_hierarchy (in):        PatchHierarchy on which to compute 
+   *                                 the zero level set
+   *  - file_base (in):              base name of output files; the 
+   *                                 processor number is appended to the
+   *                                 file name (e.g. "file_base.3")
+   *  - phi_handle (in):             PatchData handle for phi
+   *  - control_volume_handle (in):  PatchData handle for control volume
+   *  - field_handle (in):           PatchData handle for extension field
+   *                                 to interpolate to the vertices; -1 
+   *                                 if no field should be written 
+   *                                 (default = -1)
+   *  - phi_component (in):          component of phi to use as level set 
+   *                                 function (default = 0)
+   *  - field_component (in):        component of field to write
+   *                                 (default = 0)
+   *
+   * Return value:                   number of elements written by the 
+   *                                 local processor
+   *
+   * NOTES:
+   *  - The mesh is computed using the cells of the dual grid (i.e. the 
+   *    grid whose nodes are the cell centers), so phi and the field
+   *    must have at least one ghostcell, and the ghostcells must be 
+   *    filled before this function is called.
+   *
+   *  - Only dual cells whose lower corners have positive control volume 
+   *    are used, so regions covered by finer levels are skipped.
+   *
+   *  - The file format is described in the documentation for
+   *    writeZeroLevelSetSurfaceToBinaryFile() (serial package).  Vertices
+   *    on patch boundaries are duplicated in the output.
+   *
+   *  - Only DIM = 2 and DIM = 3 are supported.
+   *
+   */
+  static int writeZeroLevelSetSurface(
+    Pointer< PatchHierarchy<DIM> > patch_hierarchy,
+    const string& file_base,
+    const int phi_handle,
+    const int control_volume_handle,
+    const int field_handle = -1,
+    const int phi_component = 0,
+    const int field_component = 0);
+
   /*!
    * computeVolumeIntegral() computes the volume integral of the specified
    * function over one of two regions:  region with phi < 0 or region with
@@ -1067,6 +1485,34 @@ public:
     const int dst_component = 0,
     const int src_component = 0); 
 
+  /*!
+   * getPatchNumbers() returns the numbers of the patches on the 
+   * specified PatchLevel that are owned by the local processor.
+   *
+   * Arguments:
+   *  - level (in):            PatchLevel 
+   *  - patch_numbers (out):   numbers of the local patches (in the 
+   *                           order visited by PatchLevel::Iterator)
+   *
+   * Return value:             none
+   *
+   * NOTES:
+   *  - The patch loops in the parallel level set method classes 
+   *    iterate over this list (rather than a PatchLevel::Iterator) 
+   *    so that the patches on a level can be processed concurrently.
+   *    When LSMLIB is compiled with OpenMP enabled (e.g. by adding 
+   *    the OpenMP compiler flag to CXXFLAGS and FFLAGS), patch loops 
+   *    that only access existing PatchData are distributed over the 
+   *    OpenMP threads on each processor.
+   *  - Reductions over patches (e.g. stable time step sizes and 
+   *    integrals) are combined in patch order, so their results do 
+   *    not depend on the number of threads.
+   *
+   */
+  static void getPatchNumbers(
+    Pointer< PatchLevel<DIM> > level,
+    vector<int>& patch_numbers);
+
   //! @}
 
 protected:
@@ -1101,6 +1547,86 @@ protected:
    */
   static void initializeComputeUnitNormalParameters();
 
+  /*!
+   * getSpatialDerivativesScratchData() returns the scratch PatchData 
+   * required to compute spatial derivatives of the specified type 
+   * and order.
+   *
+   * Arguments:
+   *  - spatial_derivative_type (in):   type of spatial derivative 
+   *  - spatial_derivative_order (in):  order of spatial derivative
+   *
+   * Return value:                      ComponentSelector with the 
+   *                                    scratch PatchData handles set
+   *
+   * NOTES:
+   *  - The scratch PatchData is allocated for an entire PatchLevel 
+   *    before the patch loop because PatchData allocation is not 
+   *    thread-safe.
+   *
+   */
+  static ComponentSelector getSpatialDerivativesScratchData(
+    const SPATIAL_DERIVATIVE_TYPE spatial_derivative_type,
+    const int spatial_derivative_order);
+
+  /*!
+   * computeZeroLevelSetCurveSegmentsOnPatch() computes the line segments
+   * that make up the curve defined by the zero level sets of phi and psi
+   * on a single Patch.
+   *
+   * Arguments:
+   *  - patch (in):                  Patch on which to compute the curve
+   *  - segments (out):              endpoints of line segments (NULL if
+   *                                 only the length is required)
+   *  - phi_handle (in):             PatchData handle for phi
+   *  - psi_handle (in):             PatchData handle for psi
+   *  - control_volume_handle (in):  PatchData handle for control volume
+   *  - phi_component (in):          component of phi to use as level set 
+   *                                 function
+   *  - psi_component (in):          component of psi to use as level set 
+   *                                 function
+   *
+   * Return value:                   length of the curve on the Patch
+   *
+   */
+  static LSMLIB_REAL computeZeroLevelSetCurveSegmentsOnPatch(
+    Pointer< Patch<DIM> > patch,
+    vector<LSMLIB_REAL>* segments,
+    const int phi_handle,
+    const int psi_handle,
+    const int control_volume_handle,
+    const int phi_component,
+    const int psi_component);
+
+  /*!
+   * computeZeroLevelSetSurfaceOnPatch() computes the zero level set of 
+   * phi on a single Patch.
+   *
+   * Arguments:
+   *  - patch (in):                  Patch on which to compute the zero 
+   *                                 level set
+   *  - surface (in/out):            ZeroLevelSetSurface that the zero 
+   *                                 level set is added to
+   *  - phi_handle (in):             PatchData handle for phi
+   *  - control_volume_handle (in):  PatchData handle for control volume
+   *  - field_handle (in):           PatchData handle for extension field
+   *                                 (-1 if no field)
+   *  - phi_component (in):          component of phi to use as level set 
+   *                                 function
+   *  - field_component (in):        component of field to use
+   *
+   * Return value:                   number of elements added
+   *
+   */
+  static int computeZeroLevelSetSurfaceOnPatch(
+    Pointer< Patch<DIM> > patch,
+    ZeroLevelSetSurface* surface,
+    const int phi_handle,
+    const int control_volume_handle,
+    const int field_handle,
+    const int phi_component,
+    const int field_component);
+
   //! @}
 
   /******************************************************************
@@ -216,6 +216,93 @@ public:
     const int psi_handle,
     const int component) = 0;
 
+  /*!
+   * providesBatchedVelocityFieldComputation() indicates whether the
+   * concrete subclass of LevelSetMethodVelocityFieldStrategy computes
+   * the velocity fields for all components of a vector level set 
+   * function with a single call to computeVelocityFieldForAllComponents().
+   *
+   * Arguments:     none
+   *
+   * Return value:  true if the LevelSetFunctionIntegrator should call
+   *                computeVelocityFieldForAllComponents() once per 
+   *                stage (instead of calling computeVelocityField() 
+   *                once per component); false otherwise
+   *
+   * NOTES: 
+   *  - Batched computation requires the velocity fields for different
+   *    components to be stored in different PatchData (i.e. 
+   *    getExternalVelocityFieldPatchDataHandle() and 
+   *    getNormalVelocityFieldPatchDataHandle() must return distinct
+   *    handles for distinct components, unless the velocity field 
+   *    does not depend on the component).
+   *
+   *  - The default implementation returns false.
+   *
+   */
+  virtual bool providesBatchedVelocityFieldComputation() const {
+    return false;
+  }
+
+  /*!
+   * velocityFieldIsStageInvariant() indicates whether the velocity 
+   * field is the same at all stages of a time step (e.g. when the 
+   * velocity field is frozen over a time step or does not depend on
+   * time or on the level set functions).
+   *
+   * Arguments:     none
+   *
+   * Return value:  true if the velocity field computed at the first 
+   *                stage of a TVD Runge-Kutta step may be reused in 
+   *                the later stages; false otherwise
+   *
+   * NOTES: 
+   *  - For vector level set functions, the velocity field is only 
+   *    reused if providesBatchedVelocityFieldComputation() also 
+   *    returns true (otherwise the velocity fields for different 
+   *    components may be stored in the same PatchData).
+   *
+   *  - The default implementation returns false.
+   *
+   */
+  virtual bool velocityFieldIsStageInvariant() const {
+    return false;
+  }
+
+  /*!
+   * computeVelocityFieldForAllComponents() computes all necessary level 
+   * set method velocity fields for all components of the level set 
+   * functions on the entire hierarchy.  
+   *
+   * Arguments:
+   *  - time (in):            time that velocity field is to be computed
+   *  - phi_handle (in):      PatchData handle for phi
+   *  - psi_handle (in):      PatchData handle for psi
+   *  - num_components (in):  number of components of level set functions
+   *
+   * Return value:            none
+   *
+   * NOTES: 
+   *  - This method is only called by the LevelSetFunctionIntegrator
+   *    when providesBatchedVelocityFieldComputation() returns true.
+   *
+   *  - The notes for computeVelocityField() also apply to this method.
+   *
+   *  - The default implementation calls computeVelocityField() for 
+   *    each component.  Subclasses should override it to share work 
+   *    (e.g. a single flow solve) between components.
+   *
+   */
+  virtual void computeVelocityFieldForAllComponents(
+    const LSMLIB_REAL time,
+    const int phi_handle,
+    const int psi_handle,
+    const int num_components) {
+    for (int comp = 0; comp < num_components; comp++) {
+      computeVelocityField(time, phi_handle, psi_handle, comp);
+    }
+  }
+
   //! @}
 
 
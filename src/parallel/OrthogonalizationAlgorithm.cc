@@ -21,6 +21,7 @@ extern "C" {
 #include "LSMLIB_config.h"
 #include "LSMLIB_DefaultParameters.h"
 #include "OrthogonalizationAlgorithm.h" 
+#include "LevelSetMethodStatistics.h" 
 
 // SAMRAI Headers
 #include "CartesianPatchGeometry.h" 
@@ -229,6 +230,10 @@ void OrthogonalizationAlgorithm<DIM>::orthogonalizeLevelSetFunctions(
   const IntVector<DIM>& lower_bc_evolved,
   const IntVector<DIM>& upper_bc_evolved)
 {
+  LevelSetMethodScopedTimer timer(
+    LevelSetMethodStatistics::getStatistics()->getTimer(
+      "OrthogonalizationAlgorithm::orthogonalizeLevelSetFunctions()"));
+
   // compute the number of components of level set function
   if (d_num_field_components == 0) {
     Pointer< PatchLevel<DIM> > level = d_patch_hierarchy->getPatchLevel(0);
@@ -282,6 +287,9 @@ void OrthogonalizationAlgorithm<DIM>::
     const IntVector<DIM>& lower_bc_evolved,
     const IntVector<DIM>& upper_bc_evolved)
 {
+  LevelSetMethodScopedTimer timer(
+    LevelSetMethodStatistics::getStatistics()->getTimer(
+      "OrthogonalizationAlgorithm::orthogonalizeLevelSetFunctions()"));
 
   if (level_set_fcn == PHI) {
     d_fixed_psi_field_ext_alg->computeExtensionFieldForSingleComponent(
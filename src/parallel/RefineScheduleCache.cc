@@ -0,0 +1,251 @@
+/*
+ * File:        RefineScheduleCache.cc
+ * Copyrights:  (c) 2005 The Trustees of Princeton University and Board of
+ *                  Regents of the University of Texas.  All rights reserved.
+ *              (c) 2009 Kevin T. Chu.  All rights reserved.
+ * Revision:    $Revision$
+ * Modified:    $Date$
+ * Description: Implementation file for cache of refine schedules shared
+ *              by the parallel level set method algorithms
+ */
+
+#ifndef included_RefineScheduleCache_cc
+#define included_RefineScheduleCache_cc
+
+#include "RefineScheduleCache.h"
+#include "LevelSetMethodStatistics.h"
+
+// SAMRAI header files
+#include "tbox/ShutdownRegistry.h"
+#include "tbox/Utilities.h"
+
+#ifdef DEBUG_CHECK_ASSERTIONS
+#ifndef included_assert
+#define included_assert
+#include <assert.h>
+#endif
+#endif
+
+
+/****************************************************************
+ *
+ * Methods for RefineScheduleCache class
+ *
+ ****************************************************************/
+
+namespace LSMLIB {
+
+/* initialize static data members */
+template <int DIM>
+RefineScheduleCache<DIM>* RefineScheduleCache<DIM>::s_cache_instance = NULL;
+
+
+/* getCache() */
+template <int DIM>
+RefineScheduleCache<DIM>* RefineScheduleCache<DIM>::getCache()
+{
+  if (!s_cache_instance) {
+    s_cache_instance = new RefineScheduleCache<DIM>;
+
+    // NOTE: the cached schedules must be released before SAMRAI
+    //       (and MPI) are shut down
+    ShutdownRegistry::registerShutdownRoutine(freeCache, 254);
+  }
+  return s_cache_instance;
+}
+
+
+/* freeCache() */
+template <int DIM>
+void RefineScheduleCache<DIM>::freeCache()
+{
+  if (s_cache_instance) delete s_cache_instance;
+  s_cache_instance = NULL;
+}
+
+
+/* getSchedule() */
+template <int DIM>
+Pointer< RefineSchedule<DIM> > RefineScheduleCache<DIM>::getSchedule(
+  Pointer< RefineAlgorithm<DIM> > refine_alg,
+  const IntVector<DIM>& ghostcell_width,
+  Pointer< PatchHierarchy<DIM> > hierarchy,
+  const int level_number,
+  RefinePatchStrategy<DIM>* patch_strategy)
+{
+#ifdef DEBUG_CHECK_ASSERTIONS
+  assert(!refine_alg.isNull());
+  assert(!hierarchy.isNull());
+  assert( (level_number >= 0)
+       && (level_number <= hierarchy->getFinestLevelNumber()) );
+#endif
+
+  Pointer< PatchLevel<DIM> > level = hierarchy->getPatchLevel(level_number);
+  Pointer< PatchLevel<DIM> > coarser_level;
+  if (level_number > 0) {
+    coarser_level = hierarchy->getPatchLevel(level_number-1);
+  }
+
+  // look for a schedule with the same fill pattern
+  for (int i = 0; i < d_num_entries; i++) {
+    ScheduleEntry& entry = d_entries[i];
+    if ( (entry.hierarchy == hierarchy.getPointer()) &&
+         (entry.level_number == level_number) &&
+         (entry.level == level.getPointer()) &&
+         (entry.coarser_level == coarser_level.getPointer()) &&
+         (entry.ghostcell_width == ghostcell_width) &&
+         (entry.patch_strategy == patch_strategy) &&
+         refine_alg->checkConsistency(entry.schedule) ) {
+
+      LevelSetMethodStatistics::getStatistics()->incrementCounter(
+        "RefineScheduleCache::schedules reused");
+      return entry.schedule;
+    }
+  }
+
+  // no suitable schedule in the cache, so create a new one
+  ScheduleEntry entry;
+  entry.schedule = refine_alg->createSchedule(level,
+                                              level_number-1,
+                                              hierarchy,
+                                              patch_strategy);
+  entry.configured_alg = refine_alg;
+  entry.hierarchy = hierarchy.getPointer();
+  entry.level = level.getPointer();
+  entry.coarser_level = coarser_level.getPointer();
+  entry.level_number = level_number;
+  entry.ghostcell_width = ghostcell_width;
+  entry.patch_strategy = patch_strategy;
+
+  if (d_num_entries == d_entries.getSize()) {
+    d_entries.resizeArray(2*d_num_entries + 1);
+  }
+  d_entries[d_num_entries] = entry;
+  d_num_entries++;
+
+  LevelSetMethodStatistics::getStatistics()->incrementCounter(
+    "RefineScheduleCache::schedules created");
+
+  return entry.schedule;
+}
+
+
+/* fillData() */
+template <int DIM>
+void RefineScheduleCache<DIM>::fillData(
+  Pointer< RefineAlgorithm<DIM> > refine_alg,
+  Pointer< RefineSchedule<DIM> > schedule,
+  const LSMLIB_REAL time)
+{
+#ifdef DEBUG_CHECK_ASSERTIONS
+  assert(!refine_alg.isNull());
+  assert(!schedule.isNull());
+#endif
+
+  const int idx = findEntry(schedule);
+  if (idx < 0) {
+    // schedule has been removed from the cache, so the algorithm it
+    // is configured for is unknown
+    refine_alg->resetSchedule(schedule);
+  } else if (d_entries[idx].configured_alg.getPointer() !=
+             refine_alg.getPointer()) {
+    // schedule was last used by another algorithm
+    refine_alg->resetSchedule(schedule);
+    d_entries[idx].configured_alg = refine_alg;
+    LevelSetMethodStatistics::getStatistics()->incrementCounter(
+      "RefineScheduleCache::schedules reset");
+  }
+
+  // NOTE: true indicates that physical boundary conditions should
+  //       be set.
+  schedule->fillData(time,true);
+}
+
+
+/* resetHierarchyConfiguration() */
+template <int DIM>
+void RefineScheduleCache<DIM>::resetHierarchyConfiguration(
+  Pointer< PatchHierarchy<DIM> > hierarchy,
+  const int coarsest_level,
+  const int finest_level)
+{
+#ifdef DEBUG_CHECK_ASSERTIONS
+  assert(!hierarchy.isNull());
+#endif
+
+  const int finest_level_number = hierarchy->getFinestLevelNumber();
+
+  // NOTE: levels coarser than coarsest_level have not changed, but
+  //       their PatchLevels are compared anyway so that schedules for
+  //       any replaced PatchLevel are released.
+  int num_kept = 0;
+  for (int i = 0; i < d_num_entries; i++) {
+    const ScheduleEntry& entry = d_entries[i];
+    bool stale = false;
+    if (entry.hierarchy == hierarchy.getPointer()) {
+      const int ln = entry.level_number;
+      if (ln > finest_level_number) {
+        stale = true;
+      } else {
+        const PatchLevel<DIM>* coarser_level = 
+          (ln > 0) ? hierarchy->getPatchLevel(ln-1).getPointer() : NULL;
+        stale = (entry.level != hierarchy->getPatchLevel(ln).getPointer())
+             || (entry.coarser_level != coarser_level);
+      }
+    }
+    if (!stale) {
+      if (num_kept != i) d_entries[num_kept] = entry;
+      num_kept++;
+    }
+  }
+
+  // release the schedules (and the PatchLevels they reference) held 
+  // by removed entries
+  for (int i = num_kept; i < d_num_entries; i++) {
+    d_entries[i] = ScheduleEntry();
+  }
+  d_num_entries = num_kept;
+}
+
+
+/* clearCache() */
+template <int DIM>
+void RefineScheduleCache<DIM>::clearCache()
+{
+  d_entries.resizeArray(0);
+  d_num_entries = 0;
+}
+
+
+/* findEntry() */
+template <int DIM>
+int RefineScheduleCache<DIM>::findEntry(
+  const Pointer< RefineSchedule<DIM> > schedule) const
+{
+  for (int i = 0; i < d_num_entries; i++) {
+    if (d_entries[i].schedule.getPointer() == schedule.getPointer()) {
+      return i;
+    }
+  }
+  return -1;
+}
+
+
+/* Constructor */
+template <int DIM>
+RefineScheduleCache<DIM>::RefineScheduleCache()
+{
+  d_num_entries = 0;
+}
+
+
+/* Destructor */
+template <int DIM>
+RefineScheduleCache<DIM>::~RefineScheduleCache()
+{
+  clearCache();
+}
+
+} // end LSMLIB namespace
+
+#endif
@@ -0,0 +1,307 @@
+/*
+ * File:        RefineScheduleCache.h
+ * Copyrights:  (c) 2005 The Trustees of Princeton University and Board of
+ *                  Regents of the University of Texas.  All rights reserved.
+ *              (c) 2009 Kevin T. Chu.  All rights reserved.
+ * Revision:    $Revision$
+ * Modified:    $Date$
+ * Description: Header file for cache of refine schedules shared by the
+ *              parallel level set method algorithms
+ */
+
+#ifndef included_RefineScheduleCache_h
+#define included_RefineScheduleCache_h
+
+/*! \class LSMLIB::RefineScheduleCache
+ *
+ * \brief
+ * RefineScheduleCache holds the RefineSchedules used by the
+ * LevelSetFunctionIntegrator, ReinitializationAlgorithm and
+ * FieldExtensionAlgorithm classes to fill ghost cells so that all
+ * algorithms that fill data with the same communication pattern share
+ * a single schedule and schedules are only rebuilt when the PatchLevels
+ * they were built for change.
+ *
+ * Building a RefineSchedule requires computing the overlaps between all
+ * of the patches on a level (and the next coarser level), which is
+ * often more expensive than the data exchange itself.  The cache keeps
+ * one schedule per fill pattern, which is defined by the
+ * PatchHierarchy, level number, ghost cell width, RefinePatchStrategy
+ * and the PatchData registered with the RefineAlgorithm.  Two
+ * RefineAlgorithms have the same fill pattern when
+ * RefineAlgorithm::checkConsistency() accepts the schedule of one for
+ * the other (i.e. they register the same number of refine operations
+ * with matching PatchData types and ghost cell widths), so the TVD
+ * Runge-Kutta stages of an algorithm (and the algorithms for different
+ * level set functions) share schedules even though they fill different
+ * PatchData.
+ *
+ * There is a single RefineScheduleCache object per processor (for each
+ * spatial dimension).  It is created the first time getCache() is
+ * called and is deallocated by the SAMRAI ShutdownRegistry.
+ *
+ *
+ * <h3> USAGE: </h3>
+ *
+ *  -# Whenever the configuration of the PatchHierarchy changes, call
+ *     resetHierarchyConfiguration() to drop schedules for PatchLevels
+ *     that have been replaced or removed, then get schedules from the
+ *     cache (instead of calling RefineAlgorithm::createSchedule())
+ *     using getSchedule().
+ *  -# Fill ghost cells using fillData() (instead of
+ *     RefineSchedule::fillData()).
+ *
+ *
+ * <h3> NOTES </h3>
+ *
+ *  - Because a schedule may be shared, it is configured for the
+ *    RefineAlgorithm that most recently used it.  fillData() calls
+ *    RefineAlgorithm::resetSchedule() when the schedule is filled
+ *    for a different RefineAlgorithm.  Resetting a schedule only
+ *    replaces the refine operations it carries out (the overlaps are
+ *    not recomputed), so it is much less expensive than creating a
+ *    schedule.
+ *
+ *  - The cache only records the addresses of the PatchHierarchy and
+ *    PatchLevels that a schedule was built for; it does not hold
+ *    references to them.  The PatchLevels are kept alive by the
+ *    schedule itself until resetHierarchyConfiguration() drops it, so
+ *    their addresses cannot be reused by new PatchLevels while the
+ *    schedule is in the cache.
+ *
+ */
+
+#include "SAMRAI_config.h"
+#include "IntVector.h"
+#include "PatchHierarchy.h"
+#include "PatchLevel.h"
+#include "RefineAlgorithm.h"
+#include "RefinePatchStrategy.h"
+#include "RefineSchedule.h"
+#include "tbox/Array.h"
+#include "tbox/Pointer.h"
+
+#include "LSMLIB_config.h"
+
+// SAMRAI namespaces
+using namespace SAMRAI;
+using namespace hier;
+using namespace tbox;
+using namespace xfer;
+
+
+/******************************************************************
+ *
+ * RefineScheduleCache Class Definition
+ *
+ ******************************************************************/
+
+namespace LSMLIB {
+
+template<int DIM> class RefineScheduleCache
+{
+public:
+
+  //! @{
+  /*!
+   ****************************************************************
+   *
+   * @name Methods for accessing the cache
+   *
+   ****************************************************************/
+
+  /*!
+   * getCache() returns a pointer to the RefineScheduleCache object,
+   * creating it if necessary.
+   *
+   * Arguments:      none
+   *
+   * Return value:   pointer to RefineScheduleCache object
+   *
+   */
+  static RefineScheduleCache<DIM>* getCache();
+
+  /*!
+   * freeCache() deallocates the RefineScheduleCache object (and
+   * all of the cached schedules).
+   *
+   * Arguments:      none
+   *
+   * Return value:   none
+   *
+   */
+  static void freeCache();
+
+  //! @}
+
+
+  //! @{
+  /*!
+   ****************************************************************
+   *
+   * @name Methods for using cached schedules
+   *
+   ****************************************************************/
+
+  /*!
+   * getSchedule() returns a RefineSchedule that fills the ghost cells
+   * on the specified level for the specified RefineAlgorithm.  If the
+   * cache contains a schedule for the same PatchHierarchy, level,
+   * ghost cell width and RefinePatchStrategy that is consistent with
+   * refine_alg, that schedule is returned.  Otherwise, a new schedule
+   * is created and added to the cache.
+   *
+   * Arguments:
+   *  - refine_alg (in):      RefineAlgorithm that will be used to fill
+   *                          the ghost cells
+   *  - ghostcell_width (in): ghost cell width of the PatchData to be
+   *                          filled
+   *  - hierarchy (in):       PatchHierarchy
+   *  - level_number (in):    number of the PatchLevel to fill
+   *  - patch_strategy (in):  RefinePatchStrategy used to set physical
+   *                          boundary conditions (may be NULL)
+   *
+   * Return value:            RefineSchedule for the level
+   *
+   * NOTES:
+   *  - The returned schedule may be shared with other algorithms, so
+   *    it must be filled using fillData().
+   *
+   */
+  Pointer< RefineSchedule<DIM> > getSchedule(
+    Pointer< RefineAlgorithm<DIM> > refine_alg,
+    const IntVector<DIM>& ghostcell_width,
+    Pointer< PatchHierarchy<DIM> > hierarchy,
+    const int level_number,
+    RefinePatchStrategy<DIM>* patch_strategy = NULL);
+
+  /*!
+   * fillData() fills the ghost cells of the PatchData registered with
+   * refine_alg using a schedule obtained from getSchedule().  The
+   * schedule is reconfigured for refine_alg if it was last used by a
+   * different RefineAlgorithm.
+   *
+   * Arguments:
+   *  - refine_alg (in):  RefineAlgorithm whose PatchData should be
+   *                      filled
+   *  - schedule (in):    RefineSchedule obtained from getSchedule()
+   *                      for refine_alg
+   *  - time (in):        time at which to fill the ghost cells
+   *
+   * Return value:        none
+   *
+   * NOTES:
+   *  - Physical boundary conditions are set by the
+   *    RefinePatchStrategy the schedule was created with.
+   *
+   */
+  void fillData(
+    Pointer< RefineAlgorithm<DIM> > refine_alg,
+    Pointer< RefineSchedule<DIM> > schedule,
+    const LSMLIB_REAL time);
+
+  /*!
+   * resetHierarchyConfiguration() removes the schedules for the
+   * specified PatchHierarchy that are no longer valid (i.e. schedules
+   * for levels that no longer exist and for levels whose PatchLevel
+   * or next coarser PatchLevel has been replaced).
+   *
+   * Arguments:
+   *  - hierarchy (in):       PatchHierarchy
+   *  - coarsest_level (in):  coarsest level in hierarchy that changed
+   *  - finest_level (in):    finest level in hierarchy that changed
+   *
+   * Return value:            none
+   *
+   * NOTES:
+   *  - Every algorithm that obtains schedules from the cache calls
+   *    this method from its own resetHierarchyConfiguration() method,
+   *    so it is called several times for each change in the
+   *    PatchHierarchy.  Only the first call removes any schedules, so
+   *    schedules created by the algorithms that are reset first are
+   *    reused by the algorithms that are reset later.
+   *
+   */
+  void resetHierarchyConfiguration(
+    Pointer< PatchHierarchy<DIM> > hierarchy,
+    const int coarsest_level,
+    const int finest_level);
+
+  /*!
+   * clearCache() removes all schedules from the cache.
+   *
+   * Arguments:      none
+   *
+   * Return value:   none
+   *
+   */
+  void clearCache();
+
+  //! @}
+
+
+  /*
+   * ScheduleEntry holds a cached schedule along with the data used
+   * to decide whether it may be reused.
+   */
+  struct ScheduleEntry {
+    Pointer< RefineSchedule<DIM> > schedule;
+    Pointer< RefineAlgorithm<DIM> > configured_alg;
+    const PatchHierarchy<DIM>* hierarchy;
+    const PatchLevel<DIM>* level;
+    const PatchLevel<DIM>* coarser_level;
+    int level_number;
+    IntVector<DIM> ghostcell_width;
+    RefinePatchStrategy<DIM>* patch_strategy;
+  };
+
+
+protected:
+
+  /*
+   * The constructor and destructor are protected to ensure that
+   * the RefineScheduleCache object is only created/destroyed
+   * via getCache()/freeCache().
+   */
+  RefineScheduleCache();
+  virtual ~RefineScheduleCache();
+
+  /*
+   * findEntry() returns the index of the entry for the specified
+   * schedule or -1 if the schedule is not in the cache.
+   */
+  int findEntry(const Pointer< RefineSchedule<DIM> > schedule) const;
+
+  /****************************************************************
+   *
+   * Data members
+   *
+   ****************************************************************/
+
+  // the cache object
+  static RefineScheduleCache<DIM>* s_cache_instance;
+
+  // cached schedules
+  Array< ScheduleEntry > d_entries;
+  int d_num_entries;
+
+private:
+
+  /*
+   * Private copy constructor to prevent use.
+   */
+  RefineScheduleCache(const RefineScheduleCache& rhs){}
+
+  /*
+   * Private assignment operator to prevent use.
+   */
+  const RefineScheduleCache& operator=(
+    const RefineScheduleCache& rhs) {
+      return *this;
+  }
+
+};
+
+} // end LSMLIB namespace
+
+#endif
@@ -20,6 +20,8 @@ extern "C" {
 #include "LSMLIB_config.h"
 #include "LSMLIB_DefaultParameters.h"
 #include "ReinitializationAlgorithm.h" 
+#include "LevelSetMethodStatistics.h" 
+#include "RefineScheduleCache.h" 
 
 // SAMRAI Headers
 #include "CartesianPatchGeometry.h" 
@@ -179,6 +181,9 @@ void ReinitializationAlgorithm<DIM>::reinitializeLevelSetFunctions(
   const IntVector<DIM>& lower_bc,
   const IntVector<DIM>& upper_bc)
 {
+  LevelSetMethodScopedTimer timer(
+    LevelSetMethodStatistics::getStatistics()->getTimer(
+      "ReinitializationAlgorithm::reinitializeLevelSetFunctions()"));
 
   // reset hierarchy configuration if necessary
   if (d_hierarchy_configuration_needs_reset) {
@@ -341,6 +346,9 @@ void ReinitializationAlgorithm<DIM>::reinitializeLevelSetFunctions(
                 << endl );
   }
 
+  LevelSetMethodStatistics::getStatistics()->incrementCounter(
+    "ReinitializationAlgorithm::iterations", count);
+
   // VERBOSE MODE
   if (d_verbose_mode) {
     pout << endl;
@@ -371,6 +379,9 @@ void ReinitializationAlgorithm<DIM>::
     const IntVector<DIM>& lower_bc,
     const IntVector<DIM>& upper_bc)
 {
+  LevelSetMethodScopedTimer timer(
+    LevelSetMethodStatistics::getStatistics()->getTimer(
+      "ReinitializationAlgorithm::reinitializeLevelSetFunctions()"));
 
   // reset hierarchy configuration if necessary
   if (d_hierarchy_configuration_needs_reset) {
@@ -499,6 +510,9 @@ void ReinitializationAlgorithm<DIM>::
                 << endl );
   }
 
+  LevelSetMethodStatistics::getStatistics()->incrementCounter(
+    "ReinitializationAlgorithm::iterations", count);
+
   // VERBOSE MODE
   if (d_verbose_mode) {
     pout << endl;
@@ -533,19 +547,24 @@ void ReinitializationAlgorithm<DIM>::resetHierarchyConfiguration(
   // reset d_grid_geometry
   d_grid_geometry = d_patch_hierarchy->getGridGeometry();
 
-  // compute RefineSchedules for filling phi boundary data
+  // get RefineSchedules for filling phi boundary data from the
+  // schedule cache (shared with the other level set method algorithms)
+  RefineScheduleCache<DIM>* sched_cache = 
+    RefineScheduleCache<DIM>::getCache();
+  sched_cache->resetHierarchyConfiguration(
+    hierarchy, coarsest_level, finest_level);
   int num_levels = hierarchy->getNumberLevels();
   for (int k = 0; k < d_tvd_runge_kutta_order; k++) {
     d_phi_fill_bdry_sched[k].resizeArray(num_levels);
 
     for (int ln = coarsest_level; ln <= finest_level; ln++) {
-      Pointer< PatchLevel<DIM> > level = hierarchy->getPatchLevel(ln);
- 
       // reset data transfer configuration for boundary filling
       // before time advance
       d_phi_fill_bdry_sched[k][ln] =
-        d_phi_fill_bdry_alg[k]->createSchedule(
-          level, ln-1, hierarchy, 0);  // NULL RefinePatchStrategy
+        sched_cache->getSchedule(d_phi_fill_bdry_alg[k],
+                                 d_phi_scratch_ghostcell_width,
+                                 hierarchy, ln,
+                                 0);  // NULL RefinePatchStrategy
  
     } // end loop over levels
   } // end loop over TVD Runge-Kutta stages
@@ -586,10 +605,13 @@ void ReinitializationAlgorithm<DIM>::advanceReinitializationEqnUsingTVDRK1(
     0, phi_component);
 
   const int num_levels = d_patch_hierarchy->getNumberLevels();
+  RefineScheduleCache<DIM>* sched_cache = 
+    RefineScheduleCache<DIM>::getCache();
   for ( int ln=0 ; ln < num_levels; ln++ ) {
     // NOTE: 0.0 is "current time" and true indicates that physical 
     //       boundary conditions should be set.
-    d_phi_fill_bdry_sched[rk_stage][ln]->fillData(0.0,true);
+    sched_cache->fillData(d_phi_fill_bdry_alg[rk_stage],
+                          d_phi_fill_bdry_sched[rk_stage][ln], 0.0);
   }
   d_bc_module->imposeBoundaryConditions(
     d_phi_scr_handles[rk_stage], 
@@ -635,10 +657,13 @@ void ReinitializationAlgorithm<DIM>::advanceReinitializationEqnUsingTVDRK2(
     0, phi_component);
 
   const int num_levels = d_patch_hierarchy->getNumberLevels();
+  RefineScheduleCache<DIM>* sched_cache = 
+    RefineScheduleCache<DIM>::getCache();
   for ( int ln=0 ; ln < num_levels; ln++ ) {
     // NOTE: 0.0 is "current time" and true indicates that physical 
     //       boundary conditions should be set.
-    d_phi_fill_bdry_sched[rk_stage][ln]->fillData(0.0,true);
+    sched_cache->fillData(d_phi_fill_bdry_alg[rk_stage],
+                          d_phi_fill_bdry_sched[rk_stage][ln], 0.0);
   }
   d_bc_module->imposeBoundaryConditions(
     d_phi_scr_handles[rk_stage], 
@@ -669,7 +694,8 @@ void ReinitializationAlgorithm<DIM>::advanceReinitializationEqnUsingTVDRK2(
   for ( int ln=0 ; ln < num_levels; ln++ ) {
     // NOTE: 0.0 is "current time" and true indicates that physical 
     //       boundary conditions should be set.
-    d_phi_fill_bdry_sched[rk_stage][ln]->fillData(0.0,true);
+    sched_cache->fillData(d_phi_fill_bdry_alg[rk_stage],
+                          d_phi_fill_bdry_sched[rk_stage][ln], 0.0);
   }
   d_bc_module->imposeBoundaryConditions(
     d_phi_scr_handles[rk_stage], 
@@ -718,10 +744,13 @@ void ReinitializationAlgorithm<DIM>::advanceReinitializationEqnUsingTVDRK3(
     0, phi_component);
 
   const int num_levels = d_patch_hierarchy->getNumberLevels();
+  RefineScheduleCache<DIM>* sched_cache = 
+    RefineScheduleCache<DIM>::getCache();
   for ( int ln=0 ; ln < num_levels; ln++ ) {
     // NOTE: 0.0 is "current time" and true indicates that physical 
     //       boundary conditions should be set.
-    d_phi_fill_bdry_sched[rk_stage][ln]->fillData(0.0,true);
+    sched_cache->fillData(d_phi_fill_bdry_alg[rk_stage],
+                          d_phi_fill_bdry_sched[rk_stage][ln], 0.0);
   }
   d_bc_module->imposeBoundaryConditions(
     d_phi_scr_handles[rk_stage], 
@@ -752,7 +781,8 @@ void ReinitializationAlgorithm<DIM>::advanceReinitializationEqnUsingTVDRK3(
   for ( int ln=0 ; ln < num_levels; ln++ ) {
     // NOTE: 0.0 is "current time" and true indicates that physical 
     //       boundary conditions should be set.
-    d_phi_fill_bdry_sched[rk_stage][ln]->fillData(0.0,true);
+    sched_cache->fillData(d_phi_fill_bdry_alg[rk_stage],
+                          d_phi_fill_bdry_sched[rk_stage][ln], 0.0);
   }
   d_bc_module->imposeBoundaryConditions(
     d_phi_scr_handles[rk_stage], 
@@ -784,7 +814,8 @@ void ReinitializationAlgorithm<DIM>::advanceReinitializationEqnUsingTVDRK3(
   for ( int ln=0 ; ln < num_levels; ln++ ) {
     // NOTE: 0.0 is "current time" and true indicates that physical 
     //       boundary conditions should be set.
-    d_phi_fill_bdry_sched[rk_stage][ln]->fillData(0.0,true);
+    sched_cache->fillData(d_phi_fill_bdry_alg[rk_stage],
+                          d_phi_fill_bdry_sched[rk_stage][ln], 0.0);
   }
   d_bc_module->imposeBoundaryConditions(
     d_phi_scr_handles[rk_stage], 
@@ -830,9 +861,15 @@ void ReinitializationAlgorithm<DIM>::computeReinitializationEqnRHS(
 
     Pointer< PatchLevel<DIM> > level = d_patch_hierarchy->getPatchLevel(ln);
     
-    typename PatchLevel<DIM>::Iterator pi;
-    for (pi.initialize(level); pi; pi++) { // loop over patches
-      const int pn = *pi;
+    // patches are independent, so they may be processed concurrently
+    vector<int> patch_numbers;
+    LevelSetMethodToolbox<DIM>::getPatchNumbers(level, patch_numbers);
+    const int num_patches = patch_numbers.size();
+#ifdef _OPENMP
+#pragma omp parallel for schedule(dynamic)
+#endif
+    for (int p = 0; p < num_patches; p++) { // loop over patches
+      const int pn = patch_numbers[p];
       Pointer< Patch<DIM> > patch = level->getPatch(pn);
       if ( patch.isNull() ) {
         TBOX_ERROR(  d_object_name
@@ -0,0 +1,20 @@
+/*
+ * File:        RefineScheduleCache.NDIM.cc
+ * Copyrights:  (c) 2005 The Trustees of Princeton University and Board of
+ *                  Regents of the University of Texas.  All rights reserved.
+ *              (c) 2009 Kevin T. Chu.  All rights reserved.
+ * Revision:    $Revision$
+ * Modified:    $Date$
+ * Description: Explicit template instantiation of LSMLIB classes 
+ */
+
+#include "SAMRAI_config.h"
+
+#include "RefineScheduleCache.h"
+#include "RefineScheduleCache.cc"
+#include "tbox/Array.h"
+#include "tbox/Array.C"
+
+template class LSMLIB::RefineScheduleCache<NDIM>;
+template class SAMRAI::tbox::Array<
+  LSMLIB::RefineScheduleCache<NDIM>::ScheduleEntry >;
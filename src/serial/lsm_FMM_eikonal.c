@@ -24,6 +24,15 @@
  *    -# FMM_NDIM:  the number of spatial dimensions.
  *    -# FMM_EIKONAL_SOLVE_EIKONAL_EQUATION:  desired name of function 
  *       that solves the Eikonal equation.
+ *    -# FMM_EIKONAL_CREATE_EIKONAL_CONTEXT:  desired name of function 
+ *       that creates a reusable context for Eikonal equation solves.
+ *    -# FMM_EIKONAL_DESTROY_EIKONAL_CONTEXT:  desired name of function 
+ *       that destroys a context.
+ *    -# FMM_EIKONAL_SOLVE_EIKONAL_EQUATION_USING_CONTEXT:  desired name 
+ *       of function that solves the Eikonal equation using a context.
+ *    -# FMM_EIKONAL_SOLVE_EIKONAL_EQUATION_BATCH:  desired name of 
+ *       function that solves a batch of Eikonal equations that share 
+ *       the same speed function, mask and grid.
  *    -# FMM_EIKONAL_INITIALIZE_FRONT:  desired name of function that
  *       initializes the values on the front.
  *    -# FMM_EIKONAL_UPDATE_GRID_POINT_ORDER1:  desired name of function 
@@ -38,6 +47,18 @@
  *
  *
  * <h3> NOTES: </h3>
+ * - All of the memory required for a calculation is owned by the 
+ *   FMM_EikonalContext, so repeated calculations on the same grid using 
+ *   the same context do not allocate memory.  
+ *   FMM_EIKONAL_SOLVE_EIKONAL_EQUATION creates and destroys a context 
+ *   for each calculation.
+ *
+ * - When LSMLIB is compiled with OpenMP enabled, the problems in a
+ *   batch passed to FMM_EIKONAL_SOLVE_EIKONAL_EQUATION_BATCH are solved 
+ *   concurrently.  A single FMM_EikonalContext is created for each 
+ *   thread before any problem is solved, and each thread reuses its 
+ *   context for all of the problems it solves.
+ *
  * - Because this code depends on macros, care must be taken to 
  *   ensure that macros do not conflict.
  *
@@ -55,6 +76,10 @@
 #include "FMM_Heap.h"
 #include "FMM_Macros.h"
 
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
 
 /*
  * This macro protect against misuse of the code in this file.  It will
@@ -66,6 +91,18 @@
 #ifndef FMM_EIKONAL_SOLVE_EIKONAL_EQUATION
 #error "lsm_FMM_eikonal: required macro FMM_EIKONAL_SOLVE_EIKONAL_EQUATION not defined!"
 #endif
+#ifndef FMM_EIKONAL_CREATE_EIKONAL_CONTEXT
+#error "lsm_FMM_eikonal: required macro FMM_EIKONAL_CREATE_EIKONAL_CONTEXT not defined!"
+#endif
+#ifndef FMM_EIKONAL_DESTROY_EIKONAL_CONTEXT
+#error "lsm_FMM_eikonal: required macro FMM_EIKONAL_DESTROY_EIKONAL_CONTEXT not defined!"
+#endif
+#ifndef FMM_EIKONAL_SOLVE_EIKONAL_EQUATION_USING_CONTEXT
+#error "lsm_FMM_eikonal: required macro FMM_EIKONAL_SOLVE_EIKONAL_EQUATION_USING_CONTEXT not defined!"
+#endif
+#ifndef FMM_EIKONAL_SOLVE_EIKONAL_EQUATION_BATCH
+#error "lsm_FMM_eikonal: required macro FMM_EIKONAL_SOLVE_EIKONAL_EQUATION_BATCH not defined!"
+#endif
 #ifndef FMM_EIKONAL_INITIALIZE_FRONT
 #error "lsm_FMM_eikonal: required macro FMM_EIKONAL_INITIALIZE_FRONT not defined!"
 #endif
@@ -83,6 +120,15 @@ struct FMM_FieldData {
   LSMLIB_REAL *speed;       /* speed function               */
 };
 
+struct FMM_EikonalContext {
+  int num_dims;                 /* number of dimensions of grid       */
+  int num_gridpoints;           /* number of grid points              */
+  int reset_required;           /* flag indicating that fmm_core_data */
+                                /* has been used and must be reset    */
+  FMM_FieldData fmm_field_data;
+  FMM_CoreData *fmm_core_data;
+};
+
 
 /*============= FMM Eikonal Equation Solver Functions ===============*/
 
@@ -134,19 +180,33 @@ LSMLIB_REAL FMM_EIKONAL_UPDATE_GRID_POINT_ORDER2(
   LSMLIB_REAL *dx);
 
 
-/*==================== Function Definitions =========================*/
-
-
-int FMM_EIKONAL_SOLVE_EIKONAL_EQUATION(
+/*
+ * FMM_Eikonal_solveUsingContext() carries out the calculation for 
+ * FMM_EIKONAL_SOLVE_EIKONAL_EQUATION_USING_CONTEXT().  When
+ * outside_domain is not NULL, it is taken to be the list of the 
+ * num_outside_domain grid points outside of the mathematical/physical
+ * domain (computed from the speed function and mask), so the grid does
+ * not need to be scanned to find them.
+ */
+static int FMM_Eikonal_solveUsingContext(
+  FMM_EikonalContext *context,
   LSMLIB_REAL *phi,
   LSMLIB_REAL *speed,
   LSMLIB_REAL *mask,
+  int *outside_domain,
+  int num_outside_domain);
+
+
+/*==================== Function Definitions =========================*/
+
+
+FMM_EikonalContext* FMM_EIKONAL_CREATE_EIKONAL_CONTEXT(
   int spatial_discretization_order,
   int *grid_dims,
   LSMLIB_REAL *dx)
 {
-  /* fast marching method data */
-  FMM_CoreData *fmm_core_data;
+  /* context */
+  FMM_EikonalContext *context;
 
   /* pointers to callback functions */
   updateGridPointFuncPtr updateGridPoint;
@@ -154,7 +214,7 @@ int FMM_EIKONAL_SOLVE_EIKONAL_EQUATION(
 
   /* auxiliary variables */
   int num_gridpoints;       /* number of grid points */
-  int i, idx;               /* loop variables */
+  int i;                    /* loop variable */
 
 
   /******************************************************
@@ -172,74 +232,139 @@ int FMM_EIKONAL_SOLVE_EIKONAL_EQUATION(
            "ERROR: Invalid spatial derivative order.  Only first-\n");
     fprintf(stderr,
            "       and second-order finite differences supported.\n");
-    return LSM_FMM_ERR_INVALID_SPATIAL_DISCRETIZATION_ORDER;
+    return 0;
+  }
+
+  /* compute number of grid points */
+  num_gridpoints = 1;
+  for (i = 0; i < FMM_NDIM; i++) {
+    num_gridpoints *= grid_dims[i];
   }
 
   /********************************************
-   * set up FMM Field Data
+   * set up context and FMM Field Data
    ********************************************/
-  FMM_FieldData *fmm_field_data = 
-    (FMM_FieldData*) malloc(sizeof(FMM_FieldData));
-  if (!fmm_field_data) return LSM_FMM_ERR_FMM_DATA_CREATION_ERROR;
-  fmm_field_data->phi   = phi;
-  fmm_field_data->speed = speed;
+  context = (FMM_EikonalContext*) malloc(sizeof(FMM_EikonalContext));
+  if (!context) return 0;
+  context->num_dims = FMM_NDIM;
+  context->num_gridpoints = num_gridpoints;
+  context->reset_required = 0;
+  context->fmm_field_data.phi   = 0;
+  context->fmm_field_data.speed = 0;
    
   /********************************************
    * initialize FMM Core Data
    ********************************************/
-  fmm_core_data = FMM_Core_createFMM_CoreData(
-    fmm_field_data,
+  context->fmm_core_data = FMM_Core_createFMM_CoreData(
+    &(context->fmm_field_data),
     FMM_NDIM,
     grid_dims,
     dx,
     initializeFront,
     updateGridPoint);
-  if (!fmm_core_data) return LSM_FMM_ERR_FMM_DATA_CREATION_ERROR;
+  if (!(context->fmm_core_data)) {
+    free(context);
+    return 0;
+  }
+
+  return context;
+}
+
+
+void FMM_EIKONAL_DESTROY_EIKONAL_CONTEXT(FMM_EikonalContext *context)
+{
+  if (!context) return;
+
+  FMM_Core_destroyFMM_CoreData(context->fmm_core_data);
+  free(context);
+}
+
+
+int FMM_EIKONAL_SOLVE_EIKONAL_EQUATION_USING_CONTEXT(
+  FMM_EikonalContext *context,
+  LSMLIB_REAL *phi,
+  LSMLIB_REAL *speed,
+  LSMLIB_REAL *mask)
+{
+  /* check that the context is compatible with the calculation */
+  if ( (!context) || (context->num_dims != FMM_NDIM) ) {
+    fprintf(stderr,
+           "ERROR: Invalid FMM context.  The context must be created\n");
+    fprintf(stderr,
+           "       for the same number of dimensions as the calculation.\n");
+    return LSM_FMM_ERR_INVALID_CONTEXT;
+  }
+
+  return FMM_Eikonal_solveUsingContext(context, phi, speed, mask, 0, 0);
+}
+
+
+static int FMM_Eikonal_solveUsingContext(
+  FMM_EikonalContext *context,
+  LSMLIB_REAL *phi,
+  LSMLIB_REAL *speed,
+  LSMLIB_REAL *mask,
+  int *outside_domain,
+  int num_outside_domain)
+{
+  /* fast marching method data */
+  FMM_CoreData *fmm_core_data;
+  int *gridpoint_status;
+
+  /* auxiliary variables */
+  int num_gridpoints;       /* number of grid points */
+  int idx;                  /* loop variable */
+  int n;                    /* loop variable */
+
+
+  fmm_core_data = context->fmm_core_data;
+  num_gridpoints = context->num_gridpoints;
+
+  /* restore FMM Core Data to its initial state if it has been used */
+  if (context->reset_required) {
+    FMM_Core_resetFMM_CoreData(fmm_core_data);
+  }
+  context->reset_required = 1;
+
+  /********************************************
+   * set up FMM Field Data
+   ********************************************/
+  context->fmm_field_data.phi   = phi;
+  context->fmm_field_data.speed = speed;
 
   /********************************************
    * initialize phi and mark grid points
    * outside of the mathematical/physical 
    * domain
    ********************************************/
-  num_gridpoints = 1;
-  for (i = 0; i < FMM_NDIM; i++) {
-    num_gridpoints *= grid_dims[i];
-  }
+  gridpoint_status = FMM_Core_getGridPointStatusDataArray(fmm_core_data);
+  if (outside_domain) {
 
-  for (idx = 0; idx < num_gridpoints; idx++) {
-
-    /* temporary variables */
-    int grid_idx[FMM_NDIM];   /* grid index */
-    int idx_remainder = idx;
-
-    /* compute grid_idx */
-    for (i = 0; i < FMM_NDIM; i++) {
-      grid_idx[i] = idx_remainder%grid_dims[i];
-      idx_remainder -= grid_idx[i];
-      idx_remainder /= grid_dims[i];
+    for (n = 0; n < num_outside_domain; n++) {
+      idx = outside_domain[n];
+      gridpoint_status[idx] = OUTSIDE_DOMAIN;
+      phi[idx] = LSMLIB_REAL_MAX;
     }
 
-    /* grid points with a negative mask value are taken to */
-    /* be outside of the mathemtatical/physical domain     */
-    if ((mask) && (mask[idx] < 0)) {
+  } else {
 
-      FMM_Core_markPointOutsideDomain(fmm_core_data, grid_idx);
+    for (idx = 0; idx < num_gridpoints; idx++) {
 
-      /* set phi to LSMLIB_REAL_MAX (i.e. infinity) */
-      phi[idx] = LSMLIB_REAL_MAX;
-    }
+      /* grid points with a negative mask value are taken to be     */
+      /* outside of the mathemtatical/physical domain.  grid points */
+      /* with a non-positive speed are also taken to be outside of  */
+      /* the mathemtatical/physical domain.                         */
+      if ( ((mask) && (mask[idx] < 0)) || (speed[idx] < LSMLIB_ZERO_TOL) ) {
 
-    /* grid points with a non-positive speed are taken to */
-    /* be outside of the mathemtatical/physical domain    */
-    if (speed[idx] < LSMLIB_ZERO_TOL) {
+        gridpoint_status[idx] = OUTSIDE_DOMAIN;
 
-      FMM_Core_markPointOutsideDomain(fmm_core_data, grid_idx);
+        /* set phi to LSMLIB_REAL_MAX (i.e. infinity) */
+        phi[idx] = LSMLIB_REAL_MAX;
+      }
 
-      /* speed is zero, so set phi to be LSMLIB_REAL_MAX (i.e. infinity) */
-      phi[idx] = LSMLIB_REAL_MAX;
-    }
+    } /* end loop over grid to mark points outside of domain */ 
 
-  } /* end loop over grid to mark points outside of domain */ 
+  }
 
   /* initialize grid points around the front */ 
   FMM_Core_initializeFront(fmm_core_data); 
@@ -249,11 +374,177 @@ int FMM_EIKONAL_SOLVE_EIKONAL_EQUATION(
     FMM_Core_advanceFront(fmm_core_data);
   }
 
+  return LSM_FMM_ERR_SUCCESS;
+}
+
+
+/* 
+ * FMM_EIKONAL_SOLVE_EIKONAL_EQUATION() creates a context for the 
+ * calculation, calls FMM_EIKONAL_SOLVE_EIKONAL_EQUATION_USING_CONTEXT(),
+ * and destroys the context.
+ */
+int FMM_EIKONAL_SOLVE_EIKONAL_EQUATION(
+  LSMLIB_REAL *phi,
+  LSMLIB_REAL *speed,
+  LSMLIB_REAL *mask,
+  int spatial_discretization_order,
+  int *grid_dims,
+  LSMLIB_REAL *dx)
+{
+  FMM_EikonalContext *context;
+  int err_code;
+
+  if ( (spatial_discretization_order != 1) && 
+       (spatial_discretization_order != 2) ) {
+    fprintf(stderr,
+           "ERROR: Invalid spatial derivative order.  Only first-\n");
+    fprintf(stderr,
+           "       and second-order finite differences supported.\n");
+    return LSM_FMM_ERR_INVALID_SPATIAL_DISCRETIZATION_ORDER;
+  }
+
+  context = FMM_EIKONAL_CREATE_EIKONAL_CONTEXT(
+    spatial_discretization_order, grid_dims, dx);
+  if (!context) return LSM_FMM_ERR_FMM_DATA_CREATION_ERROR;
+
+  err_code = FMM_EIKONAL_SOLVE_EIKONAL_EQUATION_USING_CONTEXT(
+    context, phi, speed, mask);
+
+  FMM_EIKONAL_DESTROY_EIKONAL_CONTEXT(context);
+
+  return err_code;
+}
+
+/* 
+ * FMM_EIKONAL_SOLVE_EIKONAL_EQUATION_BATCH() distributes the problems 
+ * in the batch over the available threads.  One context is created for
+ * each thread before any problem is solved, and each thread uses its 
+ * context for every problem that it is assigned.  If any context cannot
+ * be created, no problem in the batch is solved.  The grid points 
+ * outside of the mathematical/physical domain depend only on the speed 
+ * function and mask, so they are found once for the entire batch.
+ */
+int FMM_EIKONAL_SOLVE_EIKONAL_EQUATION_BATCH(
+  LSMLIB_REAL **phi,
+  int num_problems,
+  LSMLIB_REAL *speed,
+  LSMLIB_REAL *mask,
+  int spatial_discretization_order,
+  int *grid_dims,
+  LSMLIB_REAL *dx)
+{
+  int err_code = LSM_FMM_ERR_SUCCESS;
+
+  /* one context per thread */
+  FMM_EikonalContext **contexts;
+  int num_contexts;
+
+  /* grid points outside of the mathematical/physical domain */
+  int *outside_domain = NULL;
+  int num_outside_domain = 0;
+
+  /* auxiliary variables */
+  int num_gridpoints;       /* number of grid points */
+  int idx;                  /* loop variable */
+
+  if ( (spatial_discretization_order != 1) && 
+       (spatial_discretization_order != 2) ) {
+    fprintf(stderr,
+           "ERROR: Invalid spatial derivative order.  Only first-\n");
+    fprintf(stderr,
+           "       and second-order finite differences supported.\n");
+    return LSM_FMM_ERR_INVALID_SPATIAL_DISCRETIZATION_ORDER;
+  }
+
+  /* create contexts (there is no need for more threads than problems) */
+#ifdef _OPENMP
+  num_contexts = omp_get_max_threads();
+#else
+  num_contexts = 1;
+#endif
+  if (num_contexts > num_problems) num_contexts = num_problems;
+  if (num_contexts < 1) num_contexts = 1;
+  contexts = (FMM_EikonalContext**) 
+    calloc(num_contexts, sizeof(FMM_EikonalContext*));
+  if (!contexts) return LSM_FMM_ERR_FMM_DATA_CREATION_ERROR;
+  for (idx = 0; idx < num_contexts; idx++) {
+    contexts[idx] = FMM_EIKONAL_CREATE_EIKONAL_CONTEXT(
+      spatial_discretization_order, grid_dims, dx);
+    if (!contexts[idx]) {
+      fprintf(stderr,
+             "ERROR: Unable to create FMM context %d of %d.  None of the\n",
+             idx+1, num_contexts);
+      fprintf(stderr,
+             "       problems in the batch were solved.\n");
+      err_code = LSM_FMM_ERR_FMM_DATA_CREATION_ERROR;
+      break;
+    }
+  }
+
+  /* compute number of grid points */
+  num_gridpoints = 1;
+  for (idx = 0; idx < FMM_NDIM; idx++) {
+    num_gridpoints *= grid_dims[idx];
+  }
+
+  /* find grid points outside of the mathematical/physical domain */
+  /* (see FMM_Eikonal_solveUsingContext())                         */
+  if (err_code == LSM_FMM_ERR_SUCCESS) {
+    outside_domain = (int*) malloc(num_gridpoints*sizeof(int));
+    if (!outside_domain) err_code = LSM_FMM_ERR_FMM_DATA_CREATION_ERROR;
+  }
+  if (err_code != LSM_FMM_ERR_SUCCESS) {
+    for (idx = 0; idx < num_contexts; idx++) {
+      FMM_EIKONAL_DESTROY_EIKONAL_CONTEXT(contexts[idx]);
+    }
+    free(contexts);
+    return err_code;
+  }
+  for (idx = 0; idx < num_gridpoints; idx++) {
+    if ( ((mask) && (mask[idx] < 0)) || (speed[idx] < LSMLIB_ZERO_TOL) ) {
+      outside_domain[num_outside_domain++] = idx;
+    }
+  }
+
+#ifdef _OPENMP
+#pragma omp parallel num_threads(num_contexts)
+#endif
+  {
+    /* NOTE: speed and the list of grid points outside of the domain */
+    /*       are only read during the solves, so they are shared by  */
+    /*       all threads                                             */
+#ifdef _OPENMP
+    FMM_EikonalContext *context = contexts[omp_get_thread_num()];
+#else
+    FMM_EikonalContext *context = contexts[0];
+#endif
+    int n;              /* loop variable */
+    int thread_err;     /* error code for current problem */
+
+#ifdef _OPENMP
+#pragma omp for schedule(dynamic)
+#endif
+    for (n = 0; n < num_problems; n++) {
+      thread_err = FMM_Eikonal_solveUsingContext(
+        context, phi[n], speed, mask, 
+        outside_domain, num_outside_domain);
+      if (thread_err != LSM_FMM_ERR_SUCCESS) {
+#ifdef _OPENMP
+#pragma omp critical
+#endif
+        err_code = thread_err;
+      }
+    }
+  }
+
   /* clean up memory */
-  FMM_Core_destroyFMM_CoreData(fmm_core_data);
-  free(fmm_field_data);
+  for (idx = 0; idx < num_contexts; idx++) {
+    FMM_EIKONAL_DESTROY_EIKONAL_CONTEXT(contexts[idx]);
+  }
+  free(contexts);
+  free(outside_domain);
 
-  return LSM_FMM_ERR_SUCCESS;
+  return err_code;
 }
 
 void FMM_EIKONAL_INITIALIZE_FRONT(
@@ -21,6 +21,12 @@
 /* Define required macros */
 #define FMM_NDIM                               2 
 #define FMM_EIKONAL_SOLVE_EIKONAL_EQUATION     solveEikonalEquation2d
+#define FMM_EIKONAL_CREATE_EIKONAL_CONTEXT     createEikonalContext2d
+#define FMM_EIKONAL_DESTROY_EIKONAL_CONTEXT    destroyEikonalContext2d
+#define FMM_EIKONAL_SOLVE_EIKONAL_EQUATION_USING_CONTEXT                  \
+        solveEikonalEquationUsingContext2d
+#define FMM_EIKONAL_SOLVE_EIKONAL_EQUATION_BATCH                          \
+        solveEikonalEquationBatch2d
 #define FMM_EIKONAL_INITIALIZE_FRONT           FMM_initializeFront_Eikonal2d
 #define FMM_EIKONAL_UPDATE_GRID_POINT_ORDER1                              \
         FMM_updateGridPoint_Eikonal2d_Order1
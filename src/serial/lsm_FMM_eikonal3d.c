@@ -21,6 +21,12 @@
 /* Define required macros */
 #define FMM_NDIM                               3 
 #define FMM_EIKONAL_SOLVE_EIKONAL_EQUATION     solveEikonalEquation3d
+#define FMM_EIKONAL_CREATE_EIKONAL_CONTEXT     createEikonalContext3d
+#define FMM_EIKONAL_DESTROY_EIKONAL_CONTEXT    destroyEikonalContext3d
+#define FMM_EIKONAL_SOLVE_EIKONAL_EQUATION_USING_CONTEXT                  \
+        solveEikonalEquationUsingContext3d
+#define FMM_EIKONAL_SOLVE_EIKONAL_EQUATION_BATCH                          \
+        solveEikonalEquationBatch3d
 #define FMM_EIKONAL_INITIALIZE_FRONT           FMM_initializeFront_Eikonal3d
 #define FMM_EIKONAL_UPDATE_GRID_POINT_ORDER1                              \
         FMM_updateGridPoint_Eikonal3d_Order1
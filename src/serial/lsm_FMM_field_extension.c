@@ -29,6 +29,15 @@
  *    -# FMM_COMPUTE_EXTENSION_FIELDS:  desired name of function
  *       that computes the extensions of fields off of the zero 
  *       level set 
+ *    -# FMM_CREATE_FIELD_EXTENSION_CONTEXT:  desired name of function
+ *       that creates a reusable context for distance function and 
+ *       extension field calculations
+ *    -# FMM_DESTROY_FIELD_EXTENSION_CONTEXT:  desired name of function
+ *       that destroys a context
+ *    -# FMM_COMPUTE_DISTANCE_FUNCTION_USING_CONTEXT:  desired name of 
+ *       function that computes the distance function using a context
+ *    -# FMM_COMPUTE_EXTENSION_FIELDS_USING_CONTEXT:  desired name of 
+ *       function that computes the extension fields using a context
  *    -# FMM_INITIALIZE_FRONT_ORDER1:  desired name of function that
  *       initializes the values on the front using a first-order scheme
  *    -# FMM_INITIALIZE_FRONT_ORDER2:  desired name of function that
@@ -39,6 +48,14 @@
  *    -# FMM_UPDATE_GRID_POINT_ORDER2:  desired name of function
  *       that updates the value of the solution at grid points using
  *       a second-order accurate discretization
+ *    -# FMM_ACCEPT_GRID_POINT_ORDER1:  desired name of function
+ *       that computes the extension field values at grid points
+ *       when they are accepted using a first-order accurate 
+ *       discretization
+ *    -# FMM_ACCEPT_GRID_POINT_ORDER2:  desired name of function
+ *       that computes the extension field values at grid points
+ *       when they are accepted using a second-order accurate 
+ *       discretization
  * -# Include this file at the end of the implementation file
  *    for the n-dimentsional Eikonal equation solver.
  * -# Compile code.
@@ -52,6 +69,21 @@
  *   norm.  All results should, however, be second-order accurate in 
  *   the L2 norm.
  * 
+ * - The distance function at a trial grid point is recomputed every 
+ *   time one of its neighbors is accepted, but the extension field 
+ *   values are only computed once, when the grid point is accepted 
+ *   (i.e. from the final set of upwind neighbors).  Only the 
+ *   FMM_UPDATE_GRID_POINT_* functions are called during trial updates;
+ *   the FMM_ACCEPT_GRID_POINT_* functions are registered with 
+ *   FMM_Core_setAcceptGridPointCallback().
+ *
+ * - All of the memory required for a calculation (the FMM_FieldData,
+ *   the extension field scratch arrays and the FMM_CoreData) is owned 
+ *   by the FMM_FieldExtensionContext, so repeated calculations on the 
+ *   same grid using the same context do not allocate memory.  
+ *   FMM_COMPUTE_DISTANCE_FUNCTION and FMM_COMPUTE_EXTENSION_FIELDS 
+ *   create and destroy a context for each calculation.
+ *
  * - Because this code depends on macros, care must be taken to
  *   ensure that macros do not conflict.
  *
@@ -83,6 +115,18 @@
 #ifndef FMM_COMPUTE_EXTENSION_FIELDS
 #error "lsm_FMM_field_extension: required macro FMM_COMPUTE_EXTENSION_FIELDS not defined!"
 #endif
+#ifndef FMM_CREATE_FIELD_EXTENSION_CONTEXT
+#error "lsm_FMM_field_extension: required macro FMM_CREATE_FIELD_EXTENSION_CONTEXT not defined!"
+#endif
+#ifndef FMM_DESTROY_FIELD_EXTENSION_CONTEXT
+#error "lsm_FMM_field_extension: required macro FMM_DESTROY_FIELD_EXTENSION_CONTEXT not defined!"
+#endif
+#ifndef FMM_COMPUTE_DISTANCE_FUNCTION_USING_CONTEXT
+#error "lsm_FMM_field_extension: required macro FMM_COMPUTE_DISTANCE_FUNCTION_USING_CONTEXT not defined!"
+#endif
+#ifndef FMM_COMPUTE_EXTENSION_FIELDS_USING_CONTEXT
+#error "lsm_FMM_field_extension: required macro FMM_COMPUTE_EXTENSION_FIELDS_USING_CONTEXT not defined!"
+#endif
 #ifndef FMM_INITIALIZE_FRONT_ORDER1
 #error "lsm_FMM_field_extension: required macro FMM_INITIALIZE_FRONT_ORDER1 not defined!"
 #endif
@@ -95,6 +139,12 @@
 #ifndef FMM_UPDATE_GRID_POINT_ORDER2
 #error "lsm_FMM_field_extension: required macro FMM_UPDATE_GRID_POINT_ORDER2 not defined!"
 #endif
+#ifndef FMM_ACCEPT_GRID_POINT_ORDER1
+#error "lsm_FMM_field_extension: required macro FMM_ACCEPT_GRID_POINT_ORDER1 not defined!"
+#endif
+#ifndef FMM_ACCEPT_GRID_POINT_ORDER2
+#error "lsm_FMM_field_extension: required macro FMM_ACCEPT_GRID_POINT_ORDER2 not defined!"
+#endif
 
 
 /*=============== lsm_FMM_field_extension Data Structures =============*/
@@ -114,6 +164,24 @@ struct FMM_FieldData {
   LSMLIB_REAL *extension_fields_sum_div_dist_sq; 
   LSMLIB_REAL *extension_fields_minus;
   LSMLIB_REAL *extension_fields_plus;
+
+  /* bit mask (one bit per coordinate direction) of the directions in */
+  /* which the second-order stencil was used in the last distance     */
+  /* function update at each grid point (only used for second-order   */
+  /* extension field calculations)                                    */
+  unsigned char *second_order_stencil_mask;
+};
+
+struct FMM_FieldExtensionContext {
+  int num_dims;                     /* number of dimensions of grid        */
+  int num_gridpoints;               /* number of grid points               */
+  int max_num_extension_fields;     /* number of extension fields that     */
+                                    /* scratch memory is allocated for     */
+  int reset_required;               /* flag indicating that fmm_core_data  */
+                                    /* has been used and must be reset     */
+  acceptGridPointFuncPtr acceptGridPoint;
+  FMM_FieldData fmm_field_data;
+  FMM_CoreData *fmm_core_data;
 };
 
 
@@ -160,15 +228,12 @@ void FMM_INITIALIZE_FRONT_ORDER2(
 /* 
  * FMM_UPDATE_GRID_POINT_ORDER1() implements the callback function 
  * required by FMM_Core::FMM_Core_updateNeighbors() to update the
- * distance function and extension fields at a grid point.  It 
- * computes and returns the updated distance function and extension
- * field values of the specified grid point using values of neighbors
- * that have status "KNOWN".
+ * distance function at a grid point.  It computes and returns the 
+ * updated distance function value of the specified grid point using 
+ * values of neighbors that have status "KNOWN".
  *
  * The approximation to the distance function is computed
- * using a first-order finite-difference scheme.  The
- * extension fields are calculated using a first-order
- * approximation to the grad(F)*grad(dist) = 0 equation.
+ * using a first-order finite-difference scheme.
  */
 LSMLIB_REAL FMM_UPDATE_GRID_POINT_ORDER1(
   FMM_CoreData *fmm_core_data,
@@ -181,15 +246,12 @@ LSMLIB_REAL FMM_UPDATE_GRID_POINT_ORDER1(
 /* 
  * FMM_UPDATE_GRID_POINT_ORDER2() implements the callback function 
  * required by FMM_Core::FMM_Core_updateNeighbors() to update the
- * distance function and extension fields at a grid point.  It 
- * computes and returns the updated distance function and extension
- * field values of the specified grid point using values of neighbors
- * that have status "KNOWN".
+ * distance function at a grid point.  It computes and returns the 
+ * updated distance function value of the specified grid point using 
+ * values of neighbors that have status "KNOWN".
  *
  * The approximation to the distance function is computed
  * using a second-order finite-difference scheme.  
- * The extension fields are calculated using a second-order
- * approximation to the grad(F)*grad(dist) = 0 equation.
  */
 LSMLIB_REAL FMM_UPDATE_GRID_POINT_ORDER2(
   FMM_CoreData *fmm_core_data,
@@ -199,33 +261,66 @@ LSMLIB_REAL FMM_UPDATE_GRID_POINT_ORDER2(
   int *grid_dims,
   LSMLIB_REAL *dx);
 
+/* 
+ * FMM_ACCEPT_GRID_POINT_ORDER1() implements the callback function 
+ * invoked by FMM_Core::FMM_Core_advanceFront() when a grid point is
+ * accepted.  It computes the extension field values at the grid
+ * point from the final distance function value and the extension 
+ * field values of the upwind neighbors.
+ *
+ * The extension fields are calculated using a first-order
+ * approximation to the grad(F)*grad(dist) = 0 equation.
+ */
+void FMM_ACCEPT_GRID_POINT_ORDER1(
+  FMM_CoreData *fmm_core_data,
+  FMM_FieldData *fmm_field_data,
+  int *grid_idx,
+  int num_dims,
+  int *grid_dims,
+  LSMLIB_REAL *dx);
+
+/* 
+ * FMM_ACCEPT_GRID_POINT_ORDER2() implements the callback function 
+ * invoked by FMM_Core::FMM_Core_advanceFront() when a grid point is
+ * accepted.  It computes the extension field values at the grid
+ * point from the final distance function value and the extension 
+ * field values of the upwind neighbors.
+ *
+ * The extension fields are calculated using a first-order 
+ * discretization of grad(F) and a second-order discretization of
+ * grad(dist) in the grad(F)*grad(dist) = 0 equation.
+ */
+void FMM_ACCEPT_GRID_POINT_ORDER2(
+  FMM_CoreData *fmm_core_data,
+  FMM_FieldData *fmm_field_data,
+  int *grid_idx,
+  int num_dims,
+  int *grid_dims,
+  LSMLIB_REAL *dx);
+
 
 /*==================== Function Definitions =========================*/
 
 
-int FMM_COMPUTE_EXTENSION_FIELDS(
-  LSMLIB_REAL *distance_function,
-  LSMLIB_REAL **extension_fields,
-  LSMLIB_REAL *phi,
-  LSMLIB_REAL *mask,
-  LSMLIB_REAL **source_fields,
-  LSMLIB_REAL *extension_mask,
-  int num_extension_fields,
+FMM_FieldExtensionContext* FMM_CREATE_FIELD_EXTENSION_CONTEXT(
+  int max_num_extension_fields,
   int spatial_discretization_order,
   int *grid_dims,
   LSMLIB_REAL *dx)
 {
-  /* fast marching method data */
-  FMM_CoreData *fmm_core_data;
+  /* context */
+  FMM_FieldExtensionContext *context;
+  FMM_FieldData *fmm_field_data;
 
   /* pointers to callback functions */
   updateGridPointFuncPtr updateGridPoint;
   initializeFrontFuncPtr initializeFront;
+  acceptGridPointFuncPtr acceptGridPoint;
 
   /* auxiliary variables */
   int num_gridpoints;       /* number of grid points */
-  int i, j, idx;            /* loop variables */
-  LSMLIB_REAL *ptr;         /* pointer to field data */
+  int num_fields;           /* number of extension fields to allocate for */
+  int i;                    /* loop variable */
 
 
   /******************************************************
@@ -237,6 +332,7 @@ int FMM_COMPUTE_EXTENSION_FIELDS(
 
     initializeFront = &FMM_INITIALIZE_FRONT_ORDER1;
     updateGridPoint = &FMM_UPDATE_GRID_POINT_ORDER1;
+    acceptGridPoint = &FMM_ACCEPT_GRID_POINT_ORDER1;
 
   } else if (spatial_discretization_order == 2) {
 
@@ -245,105 +341,212 @@ int FMM_COMPUTE_EXTENSION_FIELDS(
     /*       is not fully implemented yet.                    */
     initializeFront = &FMM_INITIALIZE_FRONT_ORDER1; 
     updateGridPoint = &FMM_UPDATE_GRID_POINT_ORDER2;
+    acceptGridPoint = &FMM_ACCEPT_GRID_POINT_ORDER2;
 
   } else {
     fprintf(stderr,
            "ERROR: Invalid spatial derivative order.  Only first-\n");
     fprintf(stderr,
            "       and second-order finite differences supported.\n");
-    return LSM_FMM_ERR_INVALID_SPATIAL_DISCRETIZATION_ORDER;
+    return 0;
+  }
+
+  /* compute number of grid points */
+  num_gridpoints = 1;
+  for (i = 0; i < FMM_NDIM; i++) {
+    num_gridpoints *= grid_dims[i];
   }
 
   /********************************************
-   * set up FMM Field Data
+   * set up context
    ********************************************/
-  FMM_FieldData *fmm_field_data = 
-    (FMM_FieldData*) malloc(sizeof(FMM_FieldData));
-  if (!fmm_field_data) return LSM_FMM_ERR_FMM_DATA_CREATION_ERROR;
-  fmm_field_data->phi = phi;
-  fmm_field_data->distance_function = distance_function;
-  fmm_field_data->num_extension_fields = num_extension_fields;
-  fmm_field_data->source_fields = source_fields;
-  fmm_field_data->extension_fields = extension_fields;
-  fmm_field_data->extension_mask = extension_mask;
-
-  /* allocate memory for extension field calculations */
-  if (num_extension_fields > 0) {
-    fmm_field_data->extension_fields_cur = 
-      (LSMLIB_REAL*) malloc(num_extension_fields*sizeof(LSMLIB_REAL));
-    fmm_field_data->extension_fields_sum_div_dist_sq = 
-      (LSMLIB_REAL*) malloc(num_extension_fields*sizeof(LSMLIB_REAL));
-    fmm_field_data->extension_fields_minus = 
-      (LSMLIB_REAL*) malloc(num_extension_fields*sizeof(LSMLIB_REAL));
-    fmm_field_data->extension_fields_plus = 
-      (LSMLIB_REAL*) malloc(num_extension_fields*sizeof(LSMLIB_REAL));
-    fmm_field_data->extension_fields_numerator = 
-      (LSMLIB_REAL*) malloc(num_extension_fields*sizeof(LSMLIB_REAL));
-    fmm_field_data->extension_fields_denominator = 
-      (LSMLIB_REAL*) malloc(num_extension_fields*sizeof(LSMLIB_REAL));
-  } else {
-    fmm_field_data->extension_fields_cur = 0;
-    fmm_field_data->extension_fields_sum_div_dist_sq = 0;
-    fmm_field_data->extension_fields_minus = 0;
-    fmm_field_data->extension_fields_plus = 0;
-    fmm_field_data->extension_fields_numerator = 0;
-    fmm_field_data->extension_fields_denominator = 0;
-  }
+  context = 
+    (FMM_FieldExtensionContext*) malloc(sizeof(FMM_FieldExtensionContext));
+  if (!context) return 0;
+  context->num_dims = FMM_NDIM;
+  context->num_gridpoints = num_gridpoints;
+  context->max_num_extension_fields = 
+    (max_num_extension_fields > 0) ? max_num_extension_fields : 0;
+  context->acceptGridPoint = acceptGridPoint;
+  context->reset_required = 0;
 
   /********************************************
-   * initialize phi and extension fields
+   * set up FMM Field Data
    ********************************************/
-  num_gridpoints = 1;
-  for (i = 0; i < FMM_NDIM; i++) {
-    num_gridpoints *= grid_dims[i];
-  }
-  for (i = 0, ptr = distance_function; i < num_gridpoints; i++, ptr++) {
-    *ptr = LSM_FMM_DEFAULT_UPDATE_VALUE;
-  }
+  fmm_field_data = &(context->fmm_field_data);
+  fmm_field_data->phi = 0;
+  fmm_field_data->distance_function = 0;
+  fmm_field_data->num_extension_fields = 0;
+  fmm_field_data->source_fields = 0;
+  fmm_field_data->extension_fields = 0;
+  fmm_field_data->extension_mask = 0;
 
-  for (j = 0; j < num_extension_fields; j++) {
-    for (i = 0, ptr = extension_fields[j]; i < num_gridpoints; i++, ptr++) {
-      *ptr = LSM_FMM_DEFAULT_UPDATE_VALUE;
-    }
+  /* allocate memory for extension field calculations */
+  /* NOTE: the scratch arrays are always allocated so */
+  /*       that malloc() is never passed a zero size  */
+  num_fields = context->max_num_extension_fields;
+  if (num_fields < 1) num_fields = 1;
+  fmm_field_data->extension_fields_cur = 
+    (LSMLIB_REAL*) malloc(num_fields*sizeof(LSMLIB_REAL));
+  fmm_field_data->extension_fields_sum_div_dist_sq = 
+    (LSMLIB_REAL*) malloc(num_fields*sizeof(LSMLIB_REAL));
+  fmm_field_data->extension_fields_minus = 
+    (LSMLIB_REAL*) malloc(num_fields*sizeof(LSMLIB_REAL));
+  fmm_field_data->extension_fields_plus = 
+    (LSMLIB_REAL*) malloc(num_fields*sizeof(LSMLIB_REAL));
+  fmm_field_data->extension_fields_numerator = 
+    (LSMLIB_REAL*) malloc(num_fields*sizeof(LSMLIB_REAL));
+  fmm_field_data->extension_fields_denominator = 
+    (LSMLIB_REAL*) malloc(num_fields*sizeof(LSMLIB_REAL));
+  if ( (spatial_discretization_order == 2) && 
+       (context->max_num_extension_fields > 0) ) {
+    fmm_field_data->second_order_stencil_mask = 
+      (unsigned char*) malloc(num_gridpoints*sizeof(unsigned char));
+  } else {
+    fmm_field_data->second_order_stencil_mask = 0;
   }
 
   /********************************************
    * initialize FMM Core Data
    ********************************************/
-  fmm_core_data = FMM_Core_createFMM_CoreData(
+  context->fmm_core_data = FMM_Core_createFMM_CoreData(
     fmm_field_data,
     FMM_NDIM,
     grid_dims,
     dx,
     initializeFront,
     updateGridPoint);
-  if (!fmm_core_data) return LSM_FMM_ERR_FMM_DATA_CREATION_ERROR;
 
-  /* mark grid points outside of domain */
-  for (idx = 0; idx < num_gridpoints; idx++) {
+  if ( !(context->fmm_core_data) ||
+       !(fmm_field_data->extension_fields_cur) ||
+       !(fmm_field_data->extension_fields_sum_div_dist_sq) ||
+       !(fmm_field_data->extension_fields_minus) ||
+       !(fmm_field_data->extension_fields_plus) ||
+       !(fmm_field_data->extension_fields_numerator) ||
+       !(fmm_field_data->extension_fields_denominator) ||
+       ( (spatial_discretization_order == 2) && 
+         (context->max_num_extension_fields > 0) &&
+         !(fmm_field_data->second_order_stencil_mask) ) ) {
+    FMM_DESTROY_FIELD_EXTENSION_CONTEXT(context);
+    return 0;
+  }
 
-    /* temporary variables */
-    int grid_idx[FMM_NDIM];   /* grid index */
-    int idx_remainder = idx;
-   
-    /* compute grid_idx */
-    for (i = 0; i < FMM_NDIM; i++) {
-      grid_idx[i] = idx_remainder%grid_dims[i];
-      idx_remainder -= grid_idx[i];
-      idx_remainder /= grid_dims[i];
-    }
+  return context;
+}
+
+
+void FMM_DESTROY_FIELD_EXTENSION_CONTEXT(FMM_FieldExtensionContext *context)
+{
+  FMM_FieldData *fmm_field_data;
 
-    if ((mask) && (mask[idx] < 0)) {
-      FMM_Core_markPointOutsideDomain(fmm_core_data, grid_idx);
+  if (!context) return;
 
-      /* set distance_function and extension fields to LSMLIB_REAL_MAX */
-      distance_function[idx] = LSMLIB_REAL_MAX;
-      for (i = 0; i < num_extension_fields; i++) {
-        extension_fields[i][idx] = LSMLIB_REAL_MAX;
+  fmm_field_data = &(context->fmm_field_data);
+  if (context->fmm_core_data) {
+    FMM_Core_destroyFMM_CoreData(context->fmm_core_data);
+  }
+  free(fmm_field_data->extension_fields_cur);
+  free(fmm_field_data->extension_fields_sum_div_dist_sq);
+  free(fmm_field_data->extension_fields_minus);
+  free(fmm_field_data->extension_fields_plus);
+  free(fmm_field_data->extension_fields_numerator);
+  free(fmm_field_data->extension_fields_denominator);
+  if (fmm_field_data->second_order_stencil_mask) {
+    free(fmm_field_data->second_order_stencil_mask);
+  }
+  free(context);
+}
+
+
+int FMM_COMPUTE_EXTENSION_FIELDS_USING_CONTEXT(
+  FMM_FieldExtensionContext *context,
+  LSMLIB_REAL *distance_function,
+  LSMLIB_REAL **extension_fields,
+  LSMLIB_REAL *phi,
+  LSMLIB_REAL *mask,
+  LSMLIB_REAL **source_fields,
+  LSMLIB_REAL *extension_mask,
+  int num_extension_fields)
+{
+  /* fast marching method data */
+  FMM_CoreData *fmm_core_data;
+  FMM_FieldData *fmm_field_data;
+
+  /* auxiliary variables */
+  int num_gridpoints;       /* number of grid points */
+  int i, j;                 /* loop variables */
+  LSMLIB_REAL *ptr;         /* pointer to field data */
+
+
+  /* check that the context is compatible with the calculation */
+  if ( (!context) || (context->num_dims != FMM_NDIM) ||
+       (num_extension_fields > context->max_num_extension_fields) ) {
+    fprintf(stderr,
+           "ERROR: Invalid FMM context.  The context must be created\n");
+    fprintf(stderr,
+           "       for the same number of dimensions and at least as\n");
+    fprintf(stderr,
+           "       many extension fields as the calculation.\n");
+    return LSM_FMM_ERR_INVALID_CONTEXT;
+  }
+
+  fmm_core_data = context->fmm_core_data;
+  fmm_field_data = &(context->fmm_field_data);
+  num_gridpoints = context->num_gridpoints;
+
+  /* restore FMM Core Data to its initial state if it has been used */
+  if (context->reset_required) {
+    FMM_Core_resetFMM_CoreData(fmm_core_data);
+  }
+  context->reset_required = 1;
+
+  /********************************************
+   * set up FMM Field Data
+   ********************************************/
+  fmm_field_data->phi = phi;
+  fmm_field_data->distance_function = distance_function;
+  fmm_field_data->num_extension_fields = num_extension_fields;
+  fmm_field_data->source_fields = source_fields;
+  fmm_field_data->extension_fields = extension_fields;
+  fmm_field_data->extension_mask = extension_mask;
+
+  /* compute extension field values only when grid points are accepted */
+  FMM_Core_setAcceptGridPointCallback(fmm_core_data, 
+    (num_extension_fields > 0) ? context->acceptGridPoint : 0);
+
+  /********************************************
+   * initialize distance function and extension 
+   * fields (grid points outside of the domain 
+   * are set to LSMLIB_REAL_MAX)
+   ********************************************/
+  if (mask) {
+
+    for (i = 0, ptr = distance_function; i < num_gridpoints; i++, ptr++) {
+      *ptr = (mask[i] < 0) ? LSMLIB_REAL_MAX : LSM_FMM_DEFAULT_UPDATE_VALUE;
+    }
+
+    for (j = 0; j < num_extension_fields; j++) {
+      for (i = 0, ptr = extension_fields[j]; i < num_gridpoints; i++, ptr++) {
+        *ptr = (mask[i] < 0) ? LSMLIB_REAL_MAX : LSM_FMM_DEFAULT_UPDATE_VALUE;
       }
+    }
+
+    /* mark grid points outside of domain */
+    FMM_Core_markPointsOutsideDomain(fmm_core_data, mask);
+
+  } else {
+
+    for (i = 0, ptr = distance_function; i < num_gridpoints; i++, ptr++) {
+      *ptr = LSM_FMM_DEFAULT_UPDATE_VALUE;
+    }
 
+    for (j = 0; j < num_extension_fields; j++) {
+      for (i = 0, ptr = extension_fields[j]; i < num_gridpoints; i++, ptr++) {
+        *ptr = LSM_FMM_DEFAULT_UPDATE_VALUE;
+      }
     }
-  } /* end loop over grid to mark points outside of domain */
+
+  }
 
   /* initialize grid points around the front */ 
   FMM_Core_initializeFront(fmm_core_data); 
@@ -353,19 +556,73 @@ int FMM_COMPUTE_EXTENSION_FIELDS(
     FMM_Core_advanceFront(fmm_core_data);
   }
 
-  /* clean up memory */
-  FMM_Core_destroyFMM_CoreData(fmm_core_data);
-  if (num_extension_fields > 0) {
-    free(fmm_field_data->extension_fields_cur);
-    free(fmm_field_data->extension_fields_sum_div_dist_sq);
-    free(fmm_field_data->extension_fields_minus);
-    free(fmm_field_data->extension_fields_plus);
-    free(fmm_field_data->extension_fields_numerator);
-    free(fmm_field_data->extension_fields_denominator);
+  return LSM_FMM_ERR_SUCCESS;
+}
+
+
+/* 
+ * FMM_COMPUTE_DISTANCE_FUNCTION_USING_CONTEXT() just calls 
+ * FMM_COMPUTE_EXTENSION_FIELDS_USING_CONTEXT() with no source/extension 
+ * fields (i.e. NULL source/extension field pointers).
+ */
+int FMM_COMPUTE_DISTANCE_FUNCTION_USING_CONTEXT(
+  FMM_FieldExtensionContext *context,
+  LSMLIB_REAL *distance_function,
+  LSMLIB_REAL *phi,
+  LSMLIB_REAL *mask)
+{
+  return FMM_COMPUTE_EXTENSION_FIELDS_USING_CONTEXT(
+           context,
+           distance_function,
+           0, /*  NULL extension fields pointer */
+           phi,
+           mask,
+           0, /*  NULL source fields pointer */
+           0, /*  NULL extension_mask pointer */
+           0  /*  zero extension fields to compute */);
+}
+
+
+/* 
+ * FMM_COMPUTE_EXTENSION_FIELDS() creates a context for the calculation,
+ * calls FMM_COMPUTE_EXTENSION_FIELDS_USING_CONTEXT(), and destroys the 
+ * context.
+ */
+int FMM_COMPUTE_EXTENSION_FIELDS(
+  LSMLIB_REAL *distance_function,
+  LSMLIB_REAL **extension_fields,
+  LSMLIB_REAL *phi,
+  LSMLIB_REAL *mask,
+  LSMLIB_REAL **source_fields,
+  LSMLIB_REAL *extension_mask,
+  int num_extension_fields,
+  int spatial_discretization_order,
+  int *grid_dims,
+  LSMLIB_REAL *dx)
+{
+  FMM_FieldExtensionContext *context;
+  int err_code;
+
+  if ( (spatial_discretization_order != 1) && 
+       (spatial_discretization_order != 2) ) {
+    fprintf(stderr,
+           "ERROR: Invalid spatial derivative order.  Only first-\n");
+    fprintf(stderr,
+           "       and second-order finite differences supported.\n");
+    return LSM_FMM_ERR_INVALID_SPATIAL_DISCRETIZATION_ORDER;
   }
-  free(fmm_field_data);
 
-  return LSM_FMM_ERR_SUCCESS;
+  context = FMM_CREATE_FIELD_EXTENSION_CONTEXT(
+    num_extension_fields, spatial_discretization_order, grid_dims, dx);
+  if (!context) return LSM_FMM_ERR_FMM_DATA_CREATION_ERROR;
+
+  err_code = FMM_COMPUTE_EXTENSION_FIELDS_USING_CONTEXT(
+    context, distance_function, extension_fields, phi, mask,
+    source_fields, extension_mask, num_extension_fields);
+
+  FMM_DESTROY_FIELD_EXTENSION_CONTEXT(context);
+
+  return err_code;
 }
 
 /* 
@@ -964,6 +1221,7 @@ void FMM_INITIALIZE_FRONT_ORDER2(
 }
 
 
+
 LSMLIB_REAL FMM_UPDATE_GRID_POINT_ORDER1(
   FMM_CoreData *fmm_core_data,
   FMM_FieldData *fmm_field_data,
@@ -976,19 +1234,9 @@ LSMLIB_REAL FMM_UPDATE_GRID_POINT_ORDER1(
 
   /* FMM Field Data variables */
   LSMLIB_REAL *distance_function = fmm_field_data->distance_function; 
-  int num_extension_fields = fmm_field_data->num_extension_fields; 
-  LSMLIB_REAL **extension_fields = fmm_field_data->extension_fields; 
-
-  /* variables for extension field calculations */
-  LSMLIB_REAL *extension_fields_numerator = 
-    fmm_field_data->extension_fields_numerator;
-  LSMLIB_REAL *extension_fields_denominator =
-    fmm_field_data->extension_fields_denominator;
 
   /* variables used in distance function update */
   PointStatus  neighbor_status;
-  int use_plus[FMM_NDIM];
-  int dir_used[FMM_NDIM];
   LSMLIB_REAL phi_upwind[FMM_NDIM];
   LSMLIB_REAL phi_plus;
   LSMLIB_REAL inv_dx_sq; 
@@ -1004,7 +1252,6 @@ LSMLIB_REAL FMM_UPDATE_GRID_POINT_ORDER1(
 
   /* auxilliary variables */
   int dir;  /* loop variable for spatial directions */
-  int k;    /* loop variable for extension fields */
   int l;    /* extra loop variable */ 
   int idx_cur_gridpoint, idx_neighbor;
   int grid_idx_out_of_bounds;
@@ -1012,21 +1259,12 @@ LSMLIB_REAL FMM_UPDATE_GRID_POINT_ORDER1(
   /* unused function parameters */
   (void) num_dims;
 
-  /* initialize auxilliary variables for extension field calculations */
-  for (k = 0; k < num_extension_fields; k++) {
-    extension_fields_numerator[k] = 0;
-    extension_fields_denominator[k] = 0;
-  }
-
   /* calculate update to distance function */
   for (dir = 0; dir < FMM_NDIM; dir++) { /* loop over coord directions */
     for (l = 0; l < FMM_NDIM; l++) { /* reset offset */
       offset[l] = 0; 
     }
 
-    /* changed to true if has KNOWN neighbor */
-    dir_used[dir] = LSM_FMM_FALSE;  
-
     /* find "upwind" direction and phi value */
     phi_upwind[dir] = LSMLIB_REAL_MAX;
 
@@ -1041,8 +1279,6 @@ LSMLIB_REAL FMM_UPDATE_GRID_POINT_ORDER1(
       neighbor_status = (PointStatus) gridpoint_status[idx_neighbor];
       if (KNOWN == neighbor_status) {
         phi_upwind[dir] = distance_function[idx_neighbor];
-        use_plus[dir] = LSM_FMM_FALSE;
-        dir_used[dir] = LSM_FMM_TRUE;
       }
     }
 
@@ -1065,8 +1301,6 @@ LSMLIB_REAL FMM_UPDATE_GRID_POINT_ORDER1(
          */
         if (LSM_FMM_ABS(phi_plus) < LSM_FMM_ABS(phi_upwind[dir])) {
           phi_upwind[dir] = phi_plus;
-          use_plus[dir] = LSM_FMM_TRUE;
-          dir_used[dir] = LSM_FMM_TRUE;
         }
       }
     }
@@ -1132,48 +1366,145 @@ LSMLIB_REAL FMM_UPDATE_GRID_POINT_ORDER1(
   } /* end switch on value of discriminant */
 
 
-  /* calculate extension field values */
-  if (num_extension_fields > 0) {
+  /* set updated distance function */
+  distance_function[idx_cur_gridpoint] = dist_updated;
 
-    for (dir = 0; dir < FMM_NDIM; dir++) { /* loop over coord directions */
+  return dist_updated;
+}
 
-      /*
-       * only accumulate values from the current direction if this
-       * direction was used in the update of the distance function
-       */
-      if (dir_used[dir]) {
-        for (l = 0; l < FMM_NDIM; l++) { /* reset offset */
-          offset[l] = 0; 
-        }
-        offset[dir] = (use_plus[dir] ? 1 : -1);
-        for (l = 0; l < FMM_NDIM; l++) {
-          neighbor[l] = grid_idx[l] + offset[l];
-        }
-        LSM_FMM_IDX(idx_neighbor, neighbor, grid_dims);
-  
-        inv_dx_sq = 1/dx[dir]; inv_dx_sq *= inv_dx_sq;
 
-        for (k = 0; k < num_extension_fields; k++) {
-          LSMLIB_REAL dist_diff = dist_updated - phi_upwind[dir];
-          extension_fields_numerator[k] += 
-            inv_dx_sq*dist_diff*extension_fields[k][idx_neighbor];
-          extension_fields_denominator[k] += inv_dx_sq*dist_diff;
+void FMM_ACCEPT_GRID_POINT_ORDER1(
+  FMM_CoreData *fmm_core_data,
+  FMM_FieldData *fmm_field_data,
+  int *grid_idx,
+  int num_dims,
+  int *grid_dims,
+  LSMLIB_REAL *dx)
+{
+  int *gridpoint_status = FMM_Core_getGridPointStatusDataArray(fmm_core_data);
+
+  /* FMM Field Data variables */
+  LSMLIB_REAL *distance_function = fmm_field_data->distance_function; 
+  int num_extension_fields = fmm_field_data->num_extension_fields; 
+  LSMLIB_REAL **extension_fields = fmm_field_data->extension_fields; 
+
+  /* variables for extension field calculations */
+  LSMLIB_REAL *extension_fields_numerator = 
+    fmm_field_data->extension_fields_numerator;
+  LSMLIB_REAL *extension_fields_denominator =
+    fmm_field_data->extension_fields_denominator;
+  LSMLIB_REAL dist_cur;
+
+  /* variables used to find the upwind neighbors */
+  PointStatus  neighbor_status;
+  int use_plus[FMM_NDIM];
+  int dir_used[FMM_NDIM];
+  LSMLIB_REAL phi_upwind[FMM_NDIM];
+  LSMLIB_REAL phi_plus;
+  LSMLIB_REAL inv_dx_sq; 
+  int offset[FMM_NDIM]; 
+  int neighbor[FMM_NDIM];
+
+  /* auxilliary variables */
+  int dir;  /* loop variable for spatial directions */
+  int k;    /* loop variable for extension fields */
+  int l;    /* extra loop variable */ 
+  int idx_cur_gridpoint, idx_neighbor;
+  int grid_idx_out_of_bounds;
+
+  /* unused function parameters */
+  (void) num_dims;
+
+  /* initialize auxilliary variables for extension field calculations */
+  for (k = 0; k < num_extension_fields; k++) {
+    extension_fields_numerator[k] = 0;
+    extension_fields_denominator[k] = 0;
+  }
+
+  /* get final value of distance function at current grid point */
+  LSM_FMM_IDX(idx_cur_gridpoint, grid_idx, grid_dims);
+  dist_cur = distance_function[idx_cur_gridpoint];
+
+  /* 
+   * find the upwind neighbors (using the same criteria as
+   * FMM_UPDATE_GRID_POINT_ORDER1()).  Since the current grid 
+   * point was last updated when its last neighbor became KNOWN, 
+   * these are the neighbors used to compute dist_cur.
+   */
+  for (dir = 0; dir < FMM_NDIM; dir++) { /* loop over coord directions */
+    for (l = 0; l < FMM_NDIM; l++) { /* reset offset */
+      offset[l] = 0; 
+    }
+
+    /* changed to true if has KNOWN neighbor */
+    dir_used[dir] = LSM_FMM_FALSE;  
+
+    /* find "upwind" direction and phi value */
+    phi_upwind[dir] = LSMLIB_REAL_MAX;
+
+    /* check minus direction */
+    offset[dir] = -1;
+    for (l = 0; l < FMM_NDIM; l++) {
+      neighbor[l] = grid_idx[l] + offset[l];
+    }
+    LSM_FMM_IDX_OUT_OF_BOUNDS(grid_idx_out_of_bounds,neighbor,grid_dims);
+    if (!grid_idx_out_of_bounds) {
+      LSM_FMM_IDX(idx_neighbor, neighbor, grid_dims);
+      neighbor_status = (PointStatus) gridpoint_status[idx_neighbor];
+      if (KNOWN == neighbor_status) {
+        phi_upwind[dir] = distance_function[idx_neighbor];
+        use_plus[dir] = LSM_FMM_FALSE;
+        dir_used[dir] = LSM_FMM_TRUE;
+      }
+    }
+
+    /* check plus direction */
+    offset[dir] = 1;
+    for (l = 0; l < FMM_NDIM; l++) {
+      neighbor[l] = grid_idx[l] + offset[l];
+    }
+    LSM_FMM_IDX_OUT_OF_BOUNDS(grid_idx_out_of_bounds,neighbor,grid_dims);
+    if (!grid_idx_out_of_bounds) {
+      LSM_FMM_IDX(idx_neighbor, neighbor, grid_dims);
+      neighbor_status = (PointStatus) gridpoint_status[idx_neighbor];
+      if (KNOWN == neighbor_status) {
+        phi_plus = distance_function[idx_neighbor];
+        if (LSM_FMM_ABS(phi_plus) < LSM_FMM_ABS(phi_upwind[dir])) {
+          phi_upwind[dir] = phi_plus;
+          use_plus[dir] = LSM_FMM_TRUE;
+          dir_used[dir] = LSM_FMM_TRUE;
         }
+      }
+    }
 
+    /*
+     * only accumulate values from the current direction if this
+     * direction was used in the update of the distance function
+     */
+    if (dir_used[dir]) {
+      offset[dir] = (use_plus[dir] ? 1 : -1);
+      for (l = 0; l < FMM_NDIM; l++) {
+        neighbor[l] = grid_idx[l] + offset[l];
       }
+      LSM_FMM_IDX(idx_neighbor, neighbor, grid_dims);
 
-    } /* loop over coordinate directions */
-  } /* end case: num_extension_fields > 0 */
+      inv_dx_sq = 1/dx[dir]; inv_dx_sq *= inv_dx_sq;
 
+      for (k = 0; k < num_extension_fields; k++) {
+        LSMLIB_REAL dist_diff = dist_cur - phi_upwind[dir];
+        extension_fields_numerator[k] += 
+          inv_dx_sq*dist_diff*extension_fields[k][idx_neighbor];
+        extension_fields_denominator[k] += inv_dx_sq*dist_diff;
+      }
+    }
 
-  /* set updated quantities */
-  distance_function[idx_cur_gridpoint] = dist_updated;
+  } /* loop over coordinate directions */
+
+  /* set extension field values */
   for (k = 0; k < num_extension_fields; k++) {
     extension_fields[k][idx_cur_gridpoint] =
       extension_fields_numerator[k]/extension_fields_denominator[k];
   }
-
-  return dist_updated;
 }
 
 
@@ -1189,19 +1520,11 @@ LSMLIB_REAL FMM_UPDATE_GRID_POINT_ORDER2(
 
   /* FMM Field Data variables */
   LSMLIB_REAL *distance_function = fmm_field_data->distance_function; 
-  int num_extension_fields = fmm_field_data->num_extension_fields; 
-  LSMLIB_REAL **extension_fields = fmm_field_data->extension_fields; 
-
-  /* variables for extension field calculations */
-  LSMLIB_REAL *extension_fields_numerator = 
-    fmm_field_data->extension_fields_numerator;
-  LSMLIB_REAL *extension_fields_denominator =
-    fmm_field_data->extension_fields_denominator;
+  unsigned char *second_order_stencil_mask = 
+    fmm_field_data->second_order_stencil_mask;
 
   /* variables used in distance function update */
   PointStatus  neighbor_status;
-  int use_plus[FMM_NDIM];
-  int dir_used[FMM_NDIM];
   LSMLIB_REAL phi_upwind1[FMM_NDIM], phi_upwind2[FMM_NDIM];
   int second_order_switch[FMM_NDIM];
   LSMLIB_REAL phi_plus;
@@ -1219,7 +1542,6 @@ LSMLIB_REAL FMM_UPDATE_GRID_POINT_ORDER2(
 
   /* auxilliary variables */
   int dir;  /* loop variable for spatial directions */
-  int k;    /* loop variable for extension fields */
   int l;    /* extra loop variable */ 
   int idx_cur_gridpoint, idx_neighbor1, idx_neighbor2;
   int grid_idx_out_of_bounds;
@@ -1227,21 +1549,12 @@ LSMLIB_REAL FMM_UPDATE_GRID_POINT_ORDER2(
   /* unused function parameters */
   (void) num_dims;
 
-  /* initialize auxilliary variables used for extension field calculation */
-  for (k = 0; k < num_extension_fields; k++) {
-    extension_fields_numerator[k] = 0;
-    extension_fields_denominator[k] = 0;
-  }
-
   /* calculate update to distance function */
   for (dir = 0; dir < FMM_NDIM; dir++) { /* loop over coord directions */
     for (l = 0; l < FMM_NDIM; l++) { /* reset offset */
       offset[l] = 0; 
     }
 
-    /* changed to true if has KNOWN neighbor */
-    dir_used[dir] = LSM_FMM_FALSE;  
-
     /* reset phi_upwind1 and phi_upwind2 to LSMLIB_REAL_MAX */
     phi_upwind1[dir] = LSMLIB_REAL_MAX;
     phi_upwind2[dir] = LSMLIB_REAL_MAX;
@@ -1262,8 +1575,6 @@ LSMLIB_REAL FMM_UPDATE_GRID_POINT_ORDER2(
       neighbor_status = (PointStatus) gridpoint_status[idx_neighbor1];
       if (KNOWN == neighbor_status) {
         phi_upwind1[dir] = distance_function[idx_neighbor1];
-        use_plus[dir] = LSM_FMM_FALSE;
-        dir_used[dir] = LSM_FMM_TRUE;
 
         /* check for neighbor required for second-order accuracy */
         LSM_FMM_IDX_OUT_OF_BOUNDS(grid_idx_out_of_bounds,neighbor2,grid_dims);
@@ -1303,8 +1614,6 @@ LSMLIB_REAL FMM_UPDATE_GRID_POINT_ORDER2(
           phi_upwind1[dir] = phi_plus;
           phi_upwind2[dir] = LSMLIB_REAL_MAX;
           second_order_switch[dir] = 0;
-          use_plus[dir] = LSM_FMM_TRUE;
-          dir_used[dir] = LSM_FMM_TRUE;
           
           /* check for neighbor required for second-order accuracy */
           LSM_FMM_IDX_OUT_OF_BOUNDS(grid_idx_out_of_bounds,neighbor2,grid_dims);
@@ -1395,78 +1704,188 @@ LSMLIB_REAL FMM_UPDATE_GRID_POINT_ORDER2(
 
   } /* end switch on value of discriminant */
 
+  /* record directions in which the second-order stencil was used */
+  /* (required to compute the extension fields when the grid      */
+  /* point is accepted)                                           */
+  if (second_order_stencil_mask) {
+    unsigned char stencil_mask = 0;
+    for (dir = 0; dir < FMM_NDIM; dir++) {
+      if (second_order_switch[dir] == 1) stencil_mask |= (1 << dir);
+    }
+    second_order_stencil_mask[idx_cur_gridpoint] = stencil_mask;
+  }
 
-  /* calculate extension field values */
-  if (num_extension_fields > 0) {
 
-    for (dir = 0; dir < FMM_NDIM; dir++) { /* loop over coord directions */
+  /* set updated distance function */
+  distance_function[idx_cur_gridpoint] = dist_updated;
 
-      /*
-       * only accumulate values from the current direction if this
-       * direction was used in the update of the distance function
-       */
-      if (dir_used[dir]) {
-        for (l = 0; l < FMM_NDIM; l++) { /* reset offset */
-          offset[l] = 0; 
-        }
-        offset[dir] = (use_plus[dir] == LSM_FMM_TRUE ? 1 : -1);
-        for (l = 0; l < FMM_NDIM; l++) {
-          neighbor1[l] = grid_idx[l] + offset[l];
-          neighbor2[l] = grid_idx[l] + 2*offset[l];
+  return dist_updated;
+}
+
+
+void FMM_ACCEPT_GRID_POINT_ORDER2(
+  FMM_CoreData *fmm_core_data,
+  FMM_FieldData *fmm_field_data,
+  int *grid_idx,
+  int num_dims,
+  int *grid_dims,
+  LSMLIB_REAL *dx)
+{
+  int *gridpoint_status = FMM_Core_getGridPointStatusDataArray(fmm_core_data);
+
+  /* FMM Field Data variables */
+  LSMLIB_REAL *distance_function = fmm_field_data->distance_function; 
+  int num_extension_fields = fmm_field_data->num_extension_fields; 
+  LSMLIB_REAL **extension_fields = fmm_field_data->extension_fields; 
+  unsigned char *second_order_stencil_mask = 
+    fmm_field_data->second_order_stencil_mask;
+
+  /* variables for extension field calculations */
+  LSMLIB_REAL *extension_fields_numerator = 
+    fmm_field_data->extension_fields_numerator;
+  LSMLIB_REAL *extension_fields_denominator =
+    fmm_field_data->extension_fields_denominator;
+  LSMLIB_REAL dist_cur;
+
+  /* variables used to find the upwind neighbors */
+  PointStatus  neighbor_status;
+  int use_plus[FMM_NDIM];
+  int dir_used[FMM_NDIM];
+  LSMLIB_REAL phi_upwind1[FMM_NDIM];
+  LSMLIB_REAL phi_plus;
+  LSMLIB_REAL inv_dx_sq; 
+  int offset[FMM_NDIM]; 
+  int neighbor1[FMM_NDIM];
+  int neighbor2[FMM_NDIM];
+
+  /* auxilliary variables */
+  int dir;  /* loop variable for spatial directions */
+  int k;    /* loop variable for extension fields */
+  int l;    /* extra loop variable */ 
+  int idx_cur_gridpoint, idx_neighbor1, idx_neighbor2;
+  int grid_idx_out_of_bounds;
+
+  /* unused function parameters */
+  (void) num_dims;
+
+  /* initialize auxilliary variables used for extension field calculation */
+  for (k = 0; k < num_extension_fields; k++) {
+    extension_fields_numerator[k] = 0;
+    extension_fields_denominator[k] = 0;
+  }
+
+  /* get final value of distance function at current grid point */
+  LSM_FMM_IDX(idx_cur_gridpoint, grid_idx, grid_dims);
+  dist_cur = distance_function[idx_cur_gridpoint];
+
+  /* 
+   * find the upwind neighbors (using the same criteria as
+   * FMM_UPDATE_GRID_POINT_ORDER2()).  Since the current grid 
+   * point was last updated when its last neighbor became KNOWN, 
+   * these are the neighbors used to compute dist_cur.  The
+   * second-order neighbors are NOT recomputed because they may
+   * have become KNOWN after the last update; instead, the 
+   * second-order stencil recorded during the last update is used.
+   */
+  for (dir = 0; dir < FMM_NDIM; dir++) { /* loop over coord directions */
+    for (l = 0; l < FMM_NDIM; l++) { /* reset offset */
+      offset[l] = 0; 
+    }
+
+    /* changed to true if has KNOWN neighbor */
+    dir_used[dir] = LSM_FMM_FALSE;  
+
+    /* find "upwind" direction and phi value */
+    phi_upwind1[dir] = LSMLIB_REAL_MAX;
+
+    /* check minus direction */
+    offset[dir] = -1;
+    for (l = 0; l < FMM_NDIM; l++) {
+      neighbor1[l] = grid_idx[l] + offset[l];
+    }
+    LSM_FMM_IDX_OUT_OF_BOUNDS(grid_idx_out_of_bounds,neighbor1,grid_dims);
+    if (!grid_idx_out_of_bounds) {
+      LSM_FMM_IDX(idx_neighbor1, neighbor1, grid_dims);
+      neighbor_status = (PointStatus) gridpoint_status[idx_neighbor1];
+      if (KNOWN == neighbor_status) {
+        phi_upwind1[dir] = distance_function[idx_neighbor1];
+        use_plus[dir] = LSM_FMM_FALSE;
+        dir_used[dir] = LSM_FMM_TRUE;
+      }
+    }
+
+    /* check plus direction */
+    offset[dir] = 1;
+    for (l = 0; l < FMM_NDIM; l++) {
+      neighbor1[l] = grid_idx[l] + offset[l];
+    }
+    LSM_FMM_IDX_OUT_OF_BOUNDS(grid_idx_out_of_bounds,neighbor1,grid_dims);
+    if (!grid_idx_out_of_bounds) {
+      LSM_FMM_IDX(idx_neighbor1, neighbor1, grid_dims);
+      neighbor_status = (PointStatus) gridpoint_status[idx_neighbor1];
+      if (KNOWN == neighbor_status) {
+        phi_plus = distance_function[idx_neighbor1];
+        if (LSM_FMM_ABS(phi_plus) < LSM_FMM_ABS(phi_upwind1[dir])) {
+          phi_upwind1[dir] = phi_plus;
+          use_plus[dir] = LSM_FMM_TRUE;
+          dir_used[dir] = LSM_FMM_TRUE;
         }
-        LSM_FMM_IDX(idx_neighbor1, neighbor1, grid_dims);
-        LSM_FMM_IDX(idx_neighbor2, neighbor2, grid_dims);
+      }
+    }
+
+    /*
+     * only accumulate values from the current direction if this
+     * direction was used in the update of the distance function
+     */
+    if (dir_used[dir]) {
+      offset[dir] = (use_plus[dir] == LSM_FMM_TRUE ? 1 : -1);
+      for (l = 0; l < FMM_NDIM; l++) {
+        neighbor1[l] = grid_idx[l] + offset[l];
+        neighbor2[l] = grid_idx[l] + 2*offset[l];
+      }
+      LSM_FMM_IDX(idx_neighbor1, neighbor1, grid_dims);
   
-        inv_dx_sq = 1/dx[dir]; inv_dx_sq *= inv_dx_sq;
-        if (second_order_switch[dir] == 1) {
+      inv_dx_sq = 1/dx[dir]; inv_dx_sq *= inv_dx_sq;
+      if (second_order_stencil_mask[idx_cur_gridpoint] & (1 << dir)) {
 
-          LSMLIB_REAL grad_dist = 1.5*dist_updated - 2.0*phi_upwind1[dir] 
-                                + 0.5*phi_upwind2[dir]; 
+        LSMLIB_REAL phi_upwind2;
+        LSMLIB_REAL grad_dist;
 
-          for (k = 0; k < num_extension_fields; k++) {
-  
-          /* KTC - second-order discretization seems to lead to  */
-          /*       larger errors than first-order discretization */
-          /*       Currently using first-order discretization.   */
-          /*       FIX ME!!!                                     */
-          /*
-            extension_fields_numerator[k] +=  
-               inv_dx_sq*grad_dist
-              *( 2.0*extension_fields[k][idx_neighbor1]
-               - 0.5*extension_fields[k][idx_neighbor2] );
-            extension_fields_denominator[k] += 1.5*inv_dx_sq*grad_dist;
-           */
-
-            extension_fields_numerator[k] += 
-              inv_dx_sq*grad_dist*extension_fields[k][idx_neighbor1];
-            extension_fields_denominator[k] += inv_dx_sq*grad_dist;
-          }
+        LSM_FMM_IDX(idx_neighbor2, neighbor2, grid_dims);
+        phi_upwind2 = distance_function[idx_neighbor2];
+        grad_dist = 1.5*dist_cur - 2.0*phi_upwind1[dir] + 0.5*phi_upwind2; 
 
-        } else {
+        /* KTC - second-order discretization seems to lead to  */
+        /*       larger errors than first-order discretization */
+        /*       Currently using first-order discretization    */
+        /*       of the gradient of the extension fields.      */
+        for (k = 0; k < num_extension_fields; k++) {
+          extension_fields_numerator[k] += 
+            inv_dx_sq*grad_dist*extension_fields[k][idx_neighbor1];
+          extension_fields_denominator[k] += inv_dx_sq*grad_dist;
+        }
+
+      } else {
 
-          LSMLIB_REAL grad_dist = dist_updated - phi_upwind1[dir];
+        LSMLIB_REAL grad_dist = dist_cur - phi_upwind1[dir];
 
-          for (k = 0; k < num_extension_fields; k++) {
-            extension_fields_numerator[k] += 
-              inv_dx_sq*grad_dist*extension_fields[k][idx_neighbor1];
+        for (k = 0; k < num_extension_fields; k++) {
+          extension_fields_numerator[k] += 
+            inv_dx_sq*grad_dist*extension_fields[k][idx_neighbor1];
           extension_fields_denominator[k] += inv_dx_sq*grad_dist;
-          } 
+        } 
 
-        } /* end switch on second_order_switch[dir] */
+      } /* end switch on second-order stencil */
  
-      } /* end case: current direction used */
-    } /* loop over coordinate directions */
-  } /* end case: num_extension_fields > 0 */
+    } /* end case: current direction used */
 
+  } /* loop over coordinate directions */
 
-  /* set updated quantities */
-  distance_function[idx_cur_gridpoint] = dist_updated;
+  /* set extension field values */
   for (k = 0; k < num_extension_fields; k++) {
     extension_fields[k][idx_cur_gridpoint] =
       extension_fields_numerator[k]/extension_fields_denominator[k];
   }
-
-  return dist_updated;
 }
 
 #endif
@@ -23,6 +23,14 @@
 #define FMM_NDIM                         2
 #define FMM_COMPUTE_DISTANCE_FUNCTION    computeDistanceFunction2d
 #define FMM_COMPUTE_EXTENSION_FIELDS     computeExtensionFields2d
+#define FMM_CREATE_FIELD_EXTENSION_CONTEXT                                  \
+        createFieldExtensionContext2d
+#define FMM_DESTROY_FIELD_EXTENSION_CONTEXT                                 \
+        destroyFieldExtensionContext2d
+#define FMM_COMPUTE_DISTANCE_FUNCTION_USING_CONTEXT                         \
+        computeDistanceFunctionUsingContext2d
+#define FMM_COMPUTE_EXTENSION_FIELDS_USING_CONTEXT                          \
+        computeExtensionFieldsUsingContext2d
 #define FMM_INITIALIZE_FRONT_ORDER1                                         \
         FMM_initializeFront_FieldExtension2d_Order1
 #define FMM_INITIALIZE_FRONT_ORDER2                                         \
@@ -31,6 +39,10 @@
         FMM_updateGridPoint_FieldExtension2d_Order1
 #define FMM_UPDATE_GRID_POINT_ORDER2                                        \
         FMM_updateGridPoint_FieldExtension2d_Order2
+#define FMM_ACCEPT_GRID_POINT_ORDER1                                        \
+        FMM_acceptGridPoint_FieldExtension2d_Order1
+#define FMM_ACCEPT_GRID_POINT_ORDER2                                        \
+        FMM_acceptGridPoint_FieldExtension2d_Order2
 
 
 /* Include "templated" implementation of Fast Marching Method */
@@ -23,6 +23,14 @@
 #define FMM_NDIM                         3
 #define FMM_COMPUTE_DISTANCE_FUNCTION    computeDistanceFunction3d
 #define FMM_COMPUTE_EXTENSION_FIELDS     computeExtensionFields3d
+#define FMM_CREATE_FIELD_EXTENSION_CONTEXT                                  \
+        createFieldExtensionContext3d
+#define FMM_DESTROY_FIELD_EXTENSION_CONTEXT                                 \
+        destroyFieldExtensionContext3d
+#define FMM_COMPUTE_DISTANCE_FUNCTION_USING_CONTEXT                         \
+        computeDistanceFunctionUsingContext3d
+#define FMM_COMPUTE_EXTENSION_FIELDS_USING_CONTEXT                          \
+        computeExtensionFieldsUsingContext3d
 #define FMM_INITIALIZE_FRONT_ORDER1                                         \
         FMM_initializeFront_FieldExtension3d_Order1
 #define FMM_INITIALIZE_FRONT_ORDER2                                         \
@@ -31,6 +39,10 @@
         FMM_updateGridPoint_FieldExtension3d_Order1
 #define FMM_UPDATE_GRID_POINT_ORDER2                                        \
         FMM_updateGridPoint_FieldExtension3d_Order2
+#define FMM_ACCEPT_GRID_POINT_ORDER1                                        \
+        FMM_acceptGridPoint_FieldExtension3d_Order1
+#define FMM_ACCEPT_GRID_POINT_ORDER2                                        \
+        FMM_acceptGridPoint_FieldExtension3d_Order2
 
 
 /* Include "templated" implementation of Fast Marching Method */
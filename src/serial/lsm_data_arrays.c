@@ -70,6 +70,7 @@ LSM_DataArrays *allocateLSMDataArrays(void)
   lsm_data_arrays->index_x = LSMLIB_SERIAL_dummy_pointer_int;
   lsm_data_arrays->index_y = LSMLIB_SERIAL_dummy_pointer_int;
   lsm_data_arrays->index_z = LSMLIB_SERIAL_dummy_pointer_int;
+  lsm_data_arrays->index_lin = LSMLIB_SERIAL_dummy_pointer_int;
   lsm_data_arrays->num_index_pts = 0;
   for(i=0; i < 10; i++)
   {
@@ -253,8 +254,14 @@ void  allocateMemoryForLSMDataArrays(
   { 
     if( lsm_data_arrays->index_z == LSMLIB_SERIAL_dummy_pointer_int )
       lsm_data_arrays->index_z = (int*) malloc(grid->num_gridpts*ISZ);
+    if( lsm_data_arrays->index_lin == LSMLIB_SERIAL_dummy_pointer_int )
+      lsm_data_arrays->index_lin = (int*) malloc(grid->num_gridpts*ISZ);
+  }
+  else
+  {
+    lsm_data_arrays->index_z = (int*) NULL;
+    lsm_data_arrays->index_lin = (int*) NULL;
   }
-  else  lsm_data_arrays->index_z = (int*) NULL;
   
   if( lsm_data_arrays->index_outer_pts == LSMLIB_SERIAL_dummy_pointer_int )
   {
@@ -342,6 +349,7 @@ void  freeMemoryForLSMDataArrays(LSM_DataArrays *lsm_data_arrays)
   free(lsm_data_arrays->index_x);
   free(lsm_data_arrays->index_y);
   free(lsm_data_arrays->index_z);
+  free(lsm_data_arrays->index_lin);
 
   free(lsm_data_arrays->index_outer_pts);
   
@@ -77,6 +77,7 @@ typedef struct _LSM_DataArrays
   unsigned char *narrow_band;
   int    num_index_pts;
   int    *index_x, *index_y, *index_z;
+  int    *index_lin; /* linear offsets of narrow band voxels (3D only) */
   int    n_lo[10], n_hi[10]; //10 levels should be more than enough
   
   /* array for outer narrow band points storage */
@@ -130,6 +131,11 @@ LSM_DataArrays *allocateLSMDataArrays(void);
  *   If memory has already been allocated for a particular data array or
  *  the data pointer is set to NULL, it will not be reallocated.
  *
+ * - Calculations that use the LSM*D_LOW_STORAGE_TVD_RK* routines to 
+ *   advance phi in time only need phi and phi_stage1, so phi_stage2
+ *   and phi_next may be set to NULL before calling 
+ *   allocateMemoryForLSMDataArrays().
+ *
  */
 void allocateMemoryForLSMDataArrays(
   LSM_DataArrays *lsm_data_arrays,
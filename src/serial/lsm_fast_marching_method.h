@@ -40,7 +40,18 @@ extern "C" {
  *
  * - Error Codes:  0 - successful computation,
  *                 1 - FMM_Data creation error,
- *                 2 - invalid spatial discretization order
+ *                 2 - invalid spatial discretization order,
+ *                 3 - invalid FMM context
+ *
+ * - When FMM calculations are carried out repeatedly on the same grid
+ *   (e.g. reinitializing the level set function every few time steps),
+ *   the memory allocation and initialization required for each 
+ *   calculation can be avoided by creating an FMM context once (using 
+ *   createFieldExtensionContext*d() or createEikonalContext*d()), 
+ *   passing it to the "UsingContext" versions of the FMM functions, 
+ *   and destroying it when it is no longer needed.  The results are
+ *   identical to those computed by the functions that do not take a
+ *   context.
  *
  * - While @ref lsm_fast_marching_method.h only provides functions 
  *   for 2D and 3D FMM calculations, LSMLIB is capable of supporting higher 
@@ -54,6 +65,20 @@ extern "C" {
  */
 
 
+/*!
+ * FMM_FieldExtensionContext is an opaque data structure that owns all 
+ * of the memory required to compute distance functions and extension 
+ * fields on a fixed grid.
+ */
+typedef struct FMM_FieldExtensionContext FMM_FieldExtensionContext;
+
+/*!
+ * FMM_EikonalContext is an opaque data structure that owns all of the 
+ * memory required to solve the Eikonal equation on a fixed grid.
+ */
+typedef struct FMM_EikonalContext FMM_EikonalContext;
+
+
 /*!
  * computeExtensionFields2d uses the FMM algorithm to compute the 
  * distance function and extension fields from the original level set
@@ -261,6 +286,245 @@ int solveEikonalEquation2d(
   int *grid_dims,
   LSMLIB_REAL *dx);
 
+/*!
+ * createFieldExtensionContext2d creates a context for computing 
+ * distance functions and extension fields on a 2D grid.
+ *
+ * Arguments:
+ *  - max_num_extension_fields (in):      maximum number of extension 
+ *                                        fields that will be computed 
+ *                                        using the context
+ *  - spatial_discretization_order (in):  order of finite differences used 
+ *                                        to compute spatial derivatives
+ *  - grid_dims (in):                     array of index space extents for all 
+ *                                        fields 
+ *  - dx (in):                            array of grid cell sizes in each 
+ *                                        coordinate direction
+ *
+ * Return value:                          pointer to new context; NULL if 
+ *                                        the context could not be created
+ *
+ * NOTES:
+ *  - The context must be destroyed using destroyFieldExtensionContext2d().
+ *
+ */
+FMM_FieldExtensionContext* createFieldExtensionContext2d(
+  int max_num_extension_fields,
+  int spatial_discretization_order,
+  int *grid_dims,
+  LSMLIB_REAL *dx);
+
+/*!
+ * destroyFieldExtensionContext2d frees the memory associated with a 
+ * context created by createFieldExtensionContext2d().
+ *
+ * Arguments:
+ *  - context (in):  context to destroy (may be NULL)
+ *
+ * Return value:     none
+ *
+ */
+void destroyFieldExtensionContext2d(FMM_FieldExtensionContext *context);
+
+/*!
+ * computeExtensionFieldsUsingContext2d computes the distance function 
+ * and extension fields using a context created by 
+ * createFieldExtensionContext2d().  It is equivalent to 
+ * computeExtensionFields2d() with the spatial discretization order, 
+ * grid_dims and dx used to create the context, but does not allocate 
+ * memory.
+ *
+ * Arguments:
+ *  - context (in/out):                   FMM context 
+ *  - distance_function (out):            updated distance function
+ *  - extension_fields (out):             extension fields
+ *  - phi (in):                           original level set function
+ *  - mask (in):                          mask for domain of problem;
+ *                                        grid points outside of the domain
+ *                                        of the problem should be set to a 
+ *                                        negative value.  
+ *  - source_fields(in):                  source fields used to compute 
+ *                                        extension fields
+ *  - extension_mask(in):                 extension velocities to
+ *                                        ignore when evaluating the
+ *                                        interface values; masked
+ *                                        grid points should be
+ *                                        negative
+ *  - num_extension_fields (in):          number of extension fields to compute
+ *
+ * Return value:                          error code (see NOTES for translation)
+ *
+ * NOTES:
+ *  - num_extension_fields may not exceed the max_num_extension_fields
+ *    used to create the context.
+ *
+ *  - A context may not be used by more than one calculation at a time.
+ *
+ *  - See computeExtensionFields2d() for additional notes.
+ *
+ */
+int computeExtensionFieldsUsingContext2d(
+  FMM_FieldExtensionContext *context,
+  LSMLIB_REAL *distance_function,
+  LSMLIB_REAL **extension_fields,
+  LSMLIB_REAL *phi,
+  LSMLIB_REAL *mask,
+  LSMLIB_REAL **source_fields,
+  LSMLIB_REAL *extension_mask,
+  int num_extension_fields);
+
+/*!
+ * computeDistanceFunctionUsingContext2d computes the distance function 
+ * using a context created by createFieldExtensionContext2d().  It is 
+ * equivalent to computeDistanceFunction2d() with the spatial 
+ * discretization order, grid_dims and dx used to create the context, 
+ * but does not allocate memory.
+ *
+ * Arguments:
+ *  - context (in/out):                   FMM context 
+ *  - distance_function (out):            updated distance function
+ *  - phi (in):                           original level set function
+ *  - mask (in):                          mask for domain of problem;
+ *                                        grid points outside of the domain
+ *                                        of the problem should be set to a 
+ *                                        negative value.
+ *
+ * Return value:                          error code (see NOTES for translation)
+ *
+ * NOTES:
+ *  - See computeDistanceFunction2d() for additional notes.
+ *
+ */
+int computeDistanceFunctionUsingContext2d(
+  FMM_FieldExtensionContext *context,
+  LSMLIB_REAL *distance_function,
+  LSMLIB_REAL *phi,
+  LSMLIB_REAL *mask);
+
+/*!
+ * createEikonalContext2d creates a context for solving the Eikonal 
+ * equation on a 2D grid.
+ *
+ * Arguments:
+ *  - spatial_discretization_order (in):  order of finite differences used 
+ *                                        to compute spatial derivatives
+ *  - grid_dims (in):                     array of index space extents for all 
+ *                                        fields 
+ *  - dx (in):                            array of grid cell sizes in each 
+ *                                        coordinate direction
+ *
+ * Return value:                          pointer to new context; NULL if 
+ *                                        the context could not be created
+ *
+ * NOTES:
+ *  - The context must be destroyed using destroyEikonalContext2d().
+ *
+ */
+FMM_EikonalContext* createEikonalContext2d(
+  int spatial_discretization_order,
+  int *grid_dims,
+  LSMLIB_REAL *dx);
+
+/*!
+ * destroyEikonalContext2d frees the memory associated with a context 
+ * created by createEikonalContext2d().
+ *
+ * Arguments:
+ *  - context (in):  context to destroy (may be NULL)
+ *
+ * Return value:     none
+ *
+ */
+void destroyEikonalContext2d(FMM_EikonalContext *context);
+
+/*!
+ * solveEikonalEquationUsingContext2d solves the Eikonal equation using 
+ * a context created by createEikonalContext2d().  It is equivalent to 
+ * solveEikonalEquation2d() with the spatial discretization order, 
+ * grid_dims and dx used to create the context, but does not allocate 
+ * memory.
+ *
+ * Arguments:
+ *  - context (in/out):                   FMM context 
+ *  - phi (in/out):                       pointer to solution to Eikonal 
+ *                                        equation phi must be initialized as 
+ *                                        specified in the NOTES for
+ *                                        solveEikonalEquation2d(). 
+ *  - speed (in):                         pointer to speed field
+ *  - mask (in):                          mask for domain of problem;
+ *                                        grid points outside of the domain
+ *                                        of the problem should be set to a 
+ *                                        negative value.
+ *
+ * Return value:                          error code (see NOTES for translation)
+ *
+ * NOTES:
+ *  - A context may not be used by more than one calculation at a time.
+ *
+ */
+int solveEikonalEquationUsingContext2d(
+  FMM_EikonalContext *context,
+  LSMLIB_REAL *phi,
+  LSMLIB_REAL *speed,
+  LSMLIB_REAL *mask);
+
+/*!
+ * solveEikonalEquationBatch2d solves a batch of Eikonal equations 
+ * that share the same speed function, mask and grid (e.g. travel-time 
+ * calculations for many different sets of boundary data).  Each problem
+ * in the batch is solved exactly as it would be by 
+ * solveEikonalEquation2d().
+ *
+ * Arguments:
+ *  - phi (in/out):                       array of num_problems pointers 
+ *                                        to solutions of the Eikonal 
+ *                                        equations; each phi must be 
+ *                                        initialized as specified in the 
+ *                                        NOTES for solveEikonalEquation2d().
+ *  - num_problems (in):                  number of problems in batch
+ *  - speed (in):                         pointer to speed field
+ *  - mask (in):                          mask for domain of problem;
+ *                                        grid points outside of the domain
+ *                                        of the problem should be set to a 
+ *                                        negative value.
+ *  - spatial_discretization_order (in):  order of finite differences used 
+ *                                        to compute spatial derivatives
+ *  - grid_dims (in):                     array of index space extents for all 
+ *                                        fields 
+ *  - dx (in):                            array of grid cell sizes in each 
+ *                                        coordinate direction
+ *
+ * Return value:                          error code (see NOTES for translation);
+ *                                        if more than one problem fails, 
+ *                                        the error code for one of them
+ *
+ * NOTES:
+ *  - When LSMLIB is compiled with OpenMP enabled, the problems are 
+ *    solved concurrently.  Each thread allocates the memory for a single
+ *    FMM context, so the memory required is proportional to the number 
+ *    of threads rather than the number of problems.
+ *
+ *  - All of the FMM contexts are created before any problem is solved.
+ *    If any of them cannot be created, none of the problems in the 
+ *    batch are solved and LSM_FMM_ERR_FMM_DATA_CREATION_ERROR is 
+ *    returned.
+ *
+ *  - The grid points outside of the domain of the problem (negative
+ *    mask or non-positive speed) are found once for the entire batch
+ *    rather than once for each problem.
+ *
+ *  - The phi data arrays must not overlap.
+ *
+ */
+int solveEikonalEquationBatch2d(
+  LSMLIB_REAL **phi,
+  int num_problems,
+  LSMLIB_REAL *speed,
+  LSMLIB_REAL *mask,
+  int spatial_discretization_order,
+  int *grid_dims,
+  LSMLIB_REAL *dx);
+
 /*!
  * computeExtensionFields3d uses the FMM algorithm to compute the 
  * distance function and extension fields from the original level set
@@ -468,6 +732,245 @@ int solveEikonalEquation3d(
   int *grid_dims,
   LSMLIB_REAL *dx);
 
+/*!
+ * createFieldExtensionContext3d creates a context for computing 
+ * distance functions and extension fields on a 3D grid.
+ *
+ * Arguments:
+ *  - max_num_extension_fields (in):      maximum number of extension 
+ *                                        fields that will be computed 
+ *                                        using the context
+ *  - spatial_discretization_order (in):  order of finite differences used 
+ *                                        to compute spatial derivatives
+ *  - grid_dims (in):                     array of index space extents for all 
+ *                                        fields 
+ *  - dx (in):                            array of grid cell sizes in each 
+ *                                        coordinate direction
+ *
+ * Return value:                          pointer to new context; NULL if 
+ *                                        the context could not be created
+ *
+ * NOTES:
+ *  - The context must be destroyed using destroyFieldExtensionContext3d().
+ *
+ */
+FMM_FieldExtensionContext* createFieldExtensionContext3d(
+  int max_num_extension_fields,
+  int spatial_discretization_order,
+  int *grid_dims,
+  LSMLIB_REAL *dx);
+
+/*!
+ * destroyFieldExtensionContext3d frees the memory associated with a 
+ * context created by createFieldExtensionContext3d().
+ *
+ * Arguments:
+ *  - context (in):  context to destroy (may be NULL)
+ *
+ * Return value:     none
+ *
+ */
+void destroyFieldExtensionContext3d(FMM_FieldExtensionContext *context);
+
+/*!
+ * computeExtensionFieldsUsingContext3d computes the distance function 
+ * and extension fields using a context created by 
+ * createFieldExtensionContext3d().  It is equivalent to 
+ * computeExtensionFields3d() with the spatial discretization order, 
+ * grid_dims and dx used to create the context, but does not allocate 
+ * memory.
+ *
+ * Arguments:
+ *  - context (in/out):                   FMM context 
+ *  - distance_function (out):            updated distance function
+ *  - extension_fields (out):             extension fields
+ *  - phi (in):                           original level set function
+ *  - mask (in):                          mask for domain of problem;
+ *                                        grid points outside of the domain
+ *                                        of the problem should be set to a 
+ *                                        negative value.  
+ *  - source_fields(in):                  source fields used to compute 
+ *                                        extension fields
+ *  - extension_mask(in):                 extension velocities to
+ *                                        ignore when evaluating the
+ *                                        interface values; masked
+ *                                        grid points should be
+ *                                        negative
+ *  - num_extension_fields (in):          number of extension fields to compute
+ *
+ * Return value:                          error code (see NOTES for translation)
+ *
+ * NOTES:
+ *  - num_extension_fields may not exceed the max_num_extension_fields
+ *    used to create the context.
+ *
+ *  - A context may not be used by more than one calculation at a time.
+ *
+ *  - See computeExtensionFields3d() for additional notes.
+ *
+ */
+int computeExtensionFieldsUsingContext3d(
+  FMM_FieldExtensionContext *context,
+  LSMLIB_REAL *distance_function,
+  LSMLIB_REAL **extension_fields,
+  LSMLIB_REAL *phi,
+  LSMLIB_REAL *mask,
+  LSMLIB_REAL **source_fields,
+  LSMLIB_REAL *extension_mask,
+  int num_extension_fields);
+
+/*!
+ * computeDistanceFunctionUsingContext3d computes the distance function 
+ * using a context created by createFieldExtensionContext3d().  It is 
+ * equivalent to computeDistanceFunction3d() with the spatial 
+ * discretization order, grid_dims and dx used to create the context, 
+ * but does not allocate memory.
+ *
+ * Arguments:
+ *  - context (in/out):                   FMM context 
+ *  - distance_function (out):            updated distance function
+ *  - phi (in):                           original level set function
+ *  - mask (in):                          mask for domain of problem;
+ *                                        grid points outside of the domain
+ *                                        of the problem should be set to a 
+ *                                        negative value.
+ *
+ * Return value:                          error code (see NOTES for translation)
+ *
+ * NOTES:
+ *  - See computeDistanceFunction3d() for additional notes.
+ *
+ */
+int computeDistanceFunctionUsingContext3d(
+  FMM_FieldExtensionContext *context,
+  LSMLIB_REAL *distance_function,
+  LSMLIB_REAL *phi,
+  LSMLIB_REAL *mask);
+
+/*!
+ * createEikonalContext3d creates a context for solving the Eikonal 
+ * equation on a 3D grid.
+ *
+ * Arguments:
+ *  - spatial_discretization_order (in):  order of finite differences used 
+ *                                        to compute spatial derivatives
+ *  - grid_dims (in):                     array of index space extents for all 
+ *                                        fields 
+ *  - dx (in):                            array of grid cell sizes in each 
+ *                                        coordinate direction
+ *
+ * Return value:                          pointer to new context; NULL if 
+ *                                        the context could not be created
+ *
+ * NOTES:
+ *  - The context must be destroyed using destroyEikonalContext3d().
+ *
+ */
+FMM_EikonalContext* createEikonalContext3d(
+  int spatial_discretization_order,
+  int *grid_dims,
+  LSMLIB_REAL *dx);
+
+/*!
+ * destroyEikonalContext3d frees the memory associated with a context 
+ * created by createEikonalContext3d().
+ *
+ * Arguments:
+ *  - context (in):  context to destroy (may be NULL)
+ *
+ * Return value:     none
+ *
+ */
+void destroyEikonalContext3d(FMM_EikonalContext *context);
+
+/*!
+ * solveEikonalEquationUsingContext3d solves the Eikonal equation using 
+ * a context created by createEikonalContext3d().  It is equivalent to 
+ * solveEikonalEquation3d() with the spatial discretization order, 
+ * grid_dims and dx used to create the context, but does not allocate 
+ * memory.
+ *
+ * Arguments:
+ *  - context (in/out):                   FMM context 
+ *  - phi (in/out):                       pointer to solution to Eikonal 
+ *                                        equation phi must be initialized as 
+ *                                        specified in the NOTES for
+ *                                        solveEikonalEquation3d(). 
+ *  - speed (in):                         pointer to speed field
+ *  - mask (in):                          mask for domain of problem;
+ *                                        grid points outside of the domain
+ *                                        of the problem should be set to a 
+ *                                        negative value.
+ *
+ * Return value:                          error code (see NOTES for translation)
+ *
+ * NOTES:
+ *  - A context may not be used by more than one calculation at a time.
+ *
+ */
+int solveEikonalEquationUsingContext3d(
+  FMM_EikonalContext *context,
+  LSMLIB_REAL *phi,
+  LSMLIB_REAL *speed,
+  LSMLIB_REAL *mask);
+
+/*!
+ * solveEikonalEquationBatch3d solves a batch of Eikonal equations 
+ * that share the same speed function, mask and grid (e.g. travel-time 
+ * calculations for many different sets of boundary data).  Each problem
+ * in the batch is solved exactly as it would be by 
+ * solveEikonalEquation3d().
+ *
+ * Arguments:
+ *  - phi (in/out):                       array of num_problems pointers 
+ *                                        to solutions of the Eikonal 
+ *                                        equations; each phi must be 
+ *                                        initialized as specified in the 
+ *                                        NOTES for solveEikonalEquation3d().
+ *  - num_problems (in):                  number of problems in batch
+ *  - speed (in):                         pointer to speed field
+ *  - mask (in):                          mask for domain of problem;
+ *                                        grid points outside of the domain
+ *                                        of the problem should be set to a 
+ *                                        negative value.
+ *  - spatial_discretization_order (in):  order of finite differences used 
+ *                                        to compute spatial derivatives
+ *  - grid_dims (in):                     array of index space extents for all 
+ *                                        fields 
+ *  - dx (in):                            array of grid cell sizes in each 
+ *                                        coordinate direction
+ *
+ * Return value:                          error code (see NOTES for translation);
+ *                                        if more than one problem fails, 
+ *                                        the error code for one of them
+ *
+ * NOTES:
+ *  - When LSMLIB is compiled with OpenMP enabled, the problems are 
+ *    solved concurrently.  Each thread allocates the memory for a single
+ *    FMM context, so the memory required is proportional to the number 
+ *    of threads rather than the number of problems.
+ *
+ *  - All of the FMM contexts are created before any problem is solved.
+ *    If any of them cannot be created, none of the problems in the 
+ *    batch are solved and LSM_FMM_ERR_FMM_DATA_CREATION_ERROR is 
+ *    returned.
+ *
+ *  - The grid points outside of the domain of the problem (negative
+ *    mask or non-positive speed) are found once for the entire batch
+ *    rather than once for each problem.
+ *
+ *  - The phi data arrays must not overlap.
+ *
+ */
+int solveEikonalEquationBatch3d(
+  LSMLIB_REAL **phi,
+  int num_problems,
+  LSMLIB_REAL *speed,
+  LSMLIB_REAL *mask,
+  int spatial_discretization_order,
+  int *grid_dims,
+  LSMLIB_REAL *dx);
+
 #ifdef __cplusplus
 }
 #endif
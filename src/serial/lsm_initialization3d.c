@@ -12,6 +12,7 @@
 #include <float.h>
 #include <stdlib.h>
 #include "lsm_initialization3d.h"
+#include "lsm_fast_marching_method.h"
 #include "lsm_macros.h"
 
 
@@ -519,3 +520,316 @@ void createIntersectionOfBoxes(
     
   free(phi1);
 }
+
+
+/*
+ * computeSquaredDistanceTransform1d() computes the lower envelope of the 
+ * parabolas w*(q - p)^2 + f[p] (Felzenszwalb and Huttenlocher, "Distance 
+ * Transforms of Sampled Functions", Theory of Computing, vol 8, 2012), 
+ * i.e. 
+ *
+ *   d[q] = min_p ( w*(q - p)^2 + f[p] ).
+ *
+ * Samples of f that are equal to LSMLIB_REAL_MAX are ignored.  If all 
+ * of the samples are ignored, d is set to LSMLIB_REAL_MAX.
+ *
+ * v (n ints) and z (n+1 LSMLIB_REALs) are scratch arrays.
+ */
+static void computeSquaredDistanceTransform1d(
+  LSMLIB_REAL *d, 
+  LSMLIB_REAL *f, 
+  int n, 
+  LSMLIB_REAL w, 
+  int *v, 
+  LSMLIB_REAL *z)
+{
+  int k = -1;   /* index of rightmost parabola in lower envelope */
+  int p, q;
+  LSMLIB_REAL s;
+
+  /* compute lower envelope */
+  for (q = 0; q < n; q++) {
+    if (f[q] >= LSMLIB_REAL_MAX) continue;
+
+    if (k < 0) {
+      k = 0;
+      v[0] = q;
+      z[0] = -LSMLIB_REAL_MAX;
+      z[1] = LSMLIB_REAL_MAX;
+      continue;
+    }
+
+    while (1) {
+      p = v[k];
+      s = ( (f[q] + w*q*q) - (f[p] + w*p*p) ) / (2*w*(q - p));
+      if ( (s > z[k]) || (k == 0) ) break;
+      k--;
+    }
+    k++;
+    v[k] = q;
+    z[k] = s;
+    z[k+1] = LSMLIB_REAL_MAX;
+  }
+
+  /* no feature points */
+  if (k < 0) {
+    for (q = 0; q < n; q++) d[q] = LSMLIB_REAL_MAX;
+    return;
+  }
+
+  /* fill in values of distance transform */
+  k = 0;
+  for (q = 0; q < n; q++) {
+    while (z[k+1] < q) k++;
+    p = v[k];
+    d[q] = w*(q - p)*(q - p) + f[p];
+  }
+}
+
+
+/*
+ * computeSquaredDistanceTransform3d() computes the squared Euclidean 
+ * distance from every grid point to the nearest grid point with 
+ * (labels[idx] == label) == feature_flag by applying the 1d transform 
+ * along each coordinate direction in turn.
+ */
+static void computeSquaredDistanceTransform3d(
+  LSMLIB_REAL *dist_sq,
+  unsigned char *labels,
+  unsigned char label,
+  int feature_flag,
+  Grid *grid)
+{
+  int nx = grid->grid_dims_ghostbox[0];
+  int ny = grid->grid_dims_ghostbox[1];
+  int nz = grid->grid_dims_ghostbox[2];
+  int nxy = nx*ny;
+  int max_dim = nx;
+  int dir;
+
+  if (ny > max_dim) max_dim = ny;
+  if (nz > max_dim) max_dim = nz;
+
+  /* initialize squared distance to zero at feature points */
+  {
+    int idx;
+    for (idx = 0; idx < grid->num_gridpts; idx++) {
+      dist_sq[idx] = ( (labels[idx] == label) == feature_flag ) 
+                   ? 0.0 : LSMLIB_REAL_MAX;
+    }
+  }
+
+  /* transform along x, then y, then z */
+  for (dir = 0; dir < 3; dir++) {
+    int n      = grid->grid_dims_ghostbox[dir];
+    int stride = (dir == 0) ? 1 : ((dir == 1) ? nx : nxy);
+    int num_lines = grid->num_gridpts/n;
+    LSMLIB_REAL w = (grid->dx)[dir]*(grid->dx)[dir];
+
+#ifdef _OPENMP
+#pragma omp parallel
+#endif
+    {
+      /* scratch data for a single line of grid points */
+      LSMLIB_REAL *f = (LSMLIB_REAL*) malloc(max_dim*sizeof(LSMLIB_REAL));
+      LSMLIB_REAL *d = (LSMLIB_REAL*) malloc(max_dim*sizeof(LSMLIB_REAL));
+      LSMLIB_REAL *z = (LSMLIB_REAL*) malloc((max_dim+1)*sizeof(LSMLIB_REAL));
+      int *v = (int*) malloc(max_dim*sizeof(int));
+      int line, offset, q;
+
+#ifdef _OPENMP
+#pragma omp for schedule(static)
+#endif
+      for (line = 0; line < num_lines; line++) {
+
+        /* compute index of first grid point on line */
+        if (dir == 0) {
+          offset = line*nx;
+        } else if (dir == 1) {
+          offset = (line%nx) + (line/nx)*nxy;
+        } else {
+          offset = line;
+        }
+
+        for (q = 0; q < n; q++) f[q] = dist_sq[offset + q*stride];
+        computeSquaredDistanceTransform1d(d, f, n, w, v, z);
+        for (q = 0; q < n; q++) dist_sq[offset + q*stride] = d[q];
+      }
+
+      free(f);
+      free(d);
+      free(z);
+      free(v);
+    }
+  }
+}
+
+
+void createSignedDistanceFromVoxelLabels3d(
+  LSMLIB_REAL *phi,
+  unsigned char *labels,
+  unsigned char inside_label,
+  Grid *grid)
+{
+  LSMLIB_REAL *dist_sq_to_outside;
+  LSMLIB_REAL half_dx;
+  int idx;
+
+  /* half of the smallest grid spacing */
+  half_dx = (grid->dx)[0];
+  if ((grid->dx)[1] < half_dx) half_dx = (grid->dx)[1];
+  if ((grid->dx)[2] < half_dx) half_dx = (grid->dx)[2];
+  half_dx *= 0.5;
+
+  /* phi is used to hold the squared distance to the inside region */
+  computeSquaredDistanceTransform3d(phi, labels, inside_label, 1, grid);
+
+  dist_sq_to_outside = 
+    (LSMLIB_REAL*) malloc(grid->num_gridpts*sizeof(LSMLIB_REAL));
+  computeSquaredDistanceTransform3d(dist_sq_to_outside, 
+                                    labels, inside_label, 0, grid);
+
+  /* combine distance transforms into signed distance function */
+#ifdef _OPENMP
+#pragma omp parallel for schedule(static)
+#endif
+  for (idx = 0; idx < grid->num_gridpts; idx++) {
+    if (labels[idx] == inside_label) {
+      phi[idx] = (dist_sq_to_outside[idx] < LSMLIB_REAL_MAX) 
+               ? half_dx - sqrt(dist_sq_to_outside[idx]) : -LSMLIB_REAL_MAX;
+    } else {
+      phi[idx] = (phi[idx] < LSMLIB_REAL_MAX) 
+               ? sqrt(phi[idx]) - half_dx : LSMLIB_REAL_MAX;
+    }
+  }
+
+  free(dist_sq_to_outside);
+}
+
+
+void createSignedDistanceFromTriangleMesh3d(
+  LSMLIB_REAL *phi,
+  TriangleMesh *mesh,
+  LSMLIB_REAL band_width,
+  int use_fmm_outside_band,
+  Grid *grid)
+{
+  int nx = grid->grid_dims_ghostbox[0];
+  int ny = grid->grid_dims_ghostbox[1];
+  int nz = grid->grid_dims_ghostbox[2];
+  int nxy = nx*ny;
+  int num_gridpts = grid->num_gridpts;
+  unsigned char *in_band;
+  int *queue;
+  int queue_head, queue_tail;
+  int num_band_pts;
+  LSMLIB_REAL max_dx;
+  int idx, k;
+
+  /* make sure that the band separates the inside and outside regions */
+  max_dx = (grid->dx)[0];
+  if ((grid->dx)[1] > max_dx) max_dx = (grid->dx)[1];
+  if ((grid->dx)[2] > max_dx) max_dx = (grid->dx)[2];
+  if (band_width < 2*max_dx) band_width = 2*max_dx;
+
+  if (mesh->num_bvh_nodes == 0) buildTriangleMeshBVH(mesh);
+
+  /* compute exact signed distance for grid points within band */
+  in_band = (unsigned char*) malloc(num_gridpts*sizeof(unsigned char));
+  num_band_pts = 0;
+#ifdef _OPENMP
+#pragma omp parallel for schedule(dynamic) reduction(+:num_band_pts)
+#endif
+  for (k = 0; k < nz; k++) {
+    int i, j, idx_ijk;
+    LSMLIB_REAL x[3];
+
+    x[2] = (grid->x_lo_ghostbox)[2] + (grid->dx)[2]*k;
+    for (j = 0; j < ny; j++) {
+      x[1] = (grid->x_lo_ghostbox)[1] + (grid->dx)[1]*j;
+      for (i = 0; i < nx; i++) {
+        x[0] = (grid->x_lo_ghostbox)[0] + (grid->dx)[0]*i;
+        idx_ijk = i + j*nx + k*nxy;
+        in_band[idx_ijk] = (unsigned char) 
+          computeSignedDistanceToTriangleMesh(&(phi[idx_ijk]), mesh, x,
+                                              band_width);
+        if (in_band[idx_ijk]) {
+          num_band_pts++;
+        } else {
+          phi[idx_ijk] = 0.0;
+        }
+      }
+    }
+  }
+
+  /* if the surface does not come near the grid, all grid points */
+  /* are taken to be outside of the surface                      */
+  if (num_band_pts == 0) {
+    for (idx = 0; idx < num_gridpts; idx++) phi[idx] = band_width;
+    free(in_band);
+    return;
+  }
+
+  /* propagate sign from band to remaining grid points using a */
+  /* breadth-first traversal of the grid                       */
+  queue = (int*) malloc(num_gridpts*sizeof(int));
+  queue_head = 0;
+  queue_tail = 0;
+  for (idx = 0; idx < num_gridpts; idx++) {
+    if (in_band[idx]) queue[queue_tail++] = idx;
+  }
+  while (queue_head < queue_tail) {
+    int nbr[6], n, num_nbrs = 0;
+    int i, j;
+    idx = queue[queue_head++];
+    i = idx%nx;
+    j = (idx/nx)%ny;
+    k = idx/nxy;
+    if (i > 0)    nbr[num_nbrs++] = idx-1;
+    if (i < nx-1) nbr[num_nbrs++] = idx+1;
+    if (j > 0)    nbr[num_nbrs++] = idx-nx;
+    if (j < ny-1) nbr[num_nbrs++] = idx+nx;
+    if (k > 0)    nbr[num_nbrs++] = idx-nxy;
+    if (k < nz-1) nbr[num_nbrs++] = idx+nxy;
+    for (n = 0; n < num_nbrs; n++) {
+      if (phi[nbr[n]] == 0.0 && !in_band[nbr[n]]) {
+        phi[nbr[n]] = (phi[idx] < 0) ? -band_width : band_width;
+        queue[queue_tail++] = nbr[n];
+      }
+    }
+  }
+  free(queue);
+
+  /* compute distance outside of band by solving the Eikonal equation */
+  /* with the (unsigned) distance in the band as boundary data        */
+  if (use_fmm_outside_band) {
+    LSMLIB_REAL *dist = 
+      (LSMLIB_REAL*) malloc(num_gridpts*sizeof(LSMLIB_REAL));
+    LSMLIB_REAL *speed = 
+      (LSMLIB_REAL*) malloc(num_gridpts*sizeof(LSMLIB_REAL));
+
+    for (idx = 0; idx < num_gridpts; idx++) {
+      dist[idx] = in_band[idx] ? fabs(phi[idx]) : -1.0;
+      speed[idx] = 1.0;
+    }
+
+    /* first-order FMM: the second-order stencil can leave far-field */
+    /* points unset (dist < 0) when fewer than two upwind neighbors  */
+    /* are available                                                 */
+    solveEikonalEquation3d(dist, speed, NULL, 1,
+                           grid->grid_dims_ghostbox, grid->dx);
+
+    /* points that the FMM did not reach keep the +/- band_width */
+    /* value assigned by the sign propagation                    */
+    for (idx = 0; idx < num_gridpts; idx++) {
+      if (!in_band[idx] && dist[idx] >= 0) {
+        phi[idx] = (phi[idx] < 0) ? -dist[idx] : dist[idx];
+      }
+    }
+
+    free(dist);
+    free(speed);
+  }
+
+  free(in_band);
+}
@@ -19,6 +19,7 @@ extern "C" {
 
 
 #include "lsm_grid.h"
+#include "lsm_triangle_mesh.h"
 
 /*! \file lsm_initialization3d.h
  * 
@@ -605,6 +606,112 @@ void  createIntersectionOfBoxes(
   Grid *grid);     
 
 
+/*!
+ * createSignedDistanceFromVoxelLabels3d() sets phi to be the signed 
+ * distance function for the region occupied by the grid points with
+ * a specified label in a labeled (e.g. segmented) voxel image.  The 
+ * distance is computed exactly (up to the voxel resolution of the
+ * image) using the separable Euclidean distance transform of 
+ * Felzenszwalb and Huttenlocher, which requires O(N) operations for 
+ * a grid with N grid points.
+ * 
+ * Arguments:
+ *  - phi (out):          level set function 
+ *  - labels (in):        label of each grid point
+ *  - inside_label (in):  label of the grid points that lie in the region 
+ *                        where phi is negative
+ *  - grid (in):          pointer to Grid data structure 
+ *
+ * Return value:          none
+ *
+ * NOTES: 
+ * - At a grid point with label inside_label, phi is set to 
+ *   -(d - dx_min/2), where d is the distance to the nearest grid point 
+ *   with a different label and dx_min is the smallest grid spacing.  
+ *   At all other grid points, phi is set to d - dx_min/2, where d is
+ *   the distance to the nearest grid point with label inside_label.
+ *   Shifting the distance by half a grid cell places the zero level 
+ *   set between the inside and outside grid points.
+ *
+ * - If no grid points (or all grid points) have label inside_label, 
+ *   phi is set to LSMLIB_REAL_MAX (or -LSMLIB_REAL_MAX).
+ *
+ * - The labels and phi data arrays are assumed to span the entire
+ *   ghostbox of the grid.
+ *
+ * - When LSMLIB is compiled with OpenMP enabled, the transforms along 
+ *   the grid lines in each coordinate direction are computed 
+ *   concurrently.
+ *
+ * - Is it the user's responsbility to ensure that memory for phi
+ *   has been allocated. 
+ *
+ */
+void createSignedDistanceFromVoxelLabels3d(
+  LSMLIB_REAL *phi,
+  unsigned char *labels,
+  unsigned char inside_label,
+  Grid *grid);
+
+
+/*!
+ * createSignedDistanceFromTriangleMesh3d() sets phi to be the signed 
+ * distance function for the region enclosed by a closed triangle mesh
+ * (e.g. read from an STL or OBJ file using the functions in 
+ * @ref lsm_triangle_mesh.h).  
+ *
+ * The signed distance is computed exactly (using closest point queries
+ * accelerated by a bounding volume hierarchy) only at grid points within
+ * a band around the surface.  The sign at the remaining grid points is
+ * determined by propagating the sign outward from the band.  The 
+ * magnitude of phi at the remaining grid points is either set to the 
+ * width of the band or computed by solving the Eikonal equation 
+ * |grad(phi)| = 1 with the fast marching method.
+ * 
+ * Arguments:
+ *  - phi (out):                  level set function 
+ *  - mesh (in):                  pointer to TriangleMesh
+ *  - band_width (in):            width of band around the surface 
+ *                                within which phi is computed exactly 
+ *  - use_fmm_outside_band (in):  flag indicating whether the fast marching
+ *                                method should be used to compute phi 
+ *                                outside of the band.  If it is zero, phi
+ *                                is set to +/- band_width outside of the
+ *                                band.
+ *  - grid (in):                  pointer to Grid data structure 
+ *
+ * Return value:                  none
+ *
+ * NOTES: 
+ * - The mesh must be closed and consistently oriented with outward 
+ *   facing normals (see @ref lsm_triangle_mesh.h).  phi is negative
+ *   inside of the region enclosed by the mesh.
+ *
+ * - band_width is increased to twice the largest grid spacing if it is
+ *   smaller so that the band separates the inside and outside regions.
+ *
+ * - The BVH for the mesh is built (using buildTriangleMeshBVH()) if 
+ *   it has not already been built.
+ *
+ * - When LSMLIB is compiled with OpenMP enabled, the calculations for
+ *   different z-slabs of the grid within the band are carried out 
+ *   concurrently.
+ *
+ * - If the surface does not come within band_width of any grid point,
+ *   phi is set to band_width everywhere.
+ *
+ * - Is it the user's responsbility to ensure that memory for phi
+ *   has been allocated. 
+ *
+ */
+void createSignedDistanceFromTriangleMesh3d(
+  LSMLIB_REAL *phi,
+  TriangleMesh *mesh,
+  LSMLIB_REAL band_width,
+  int use_fmm_outside_band,
+  Grid *grid);
+
+
 #ifdef __cplusplus
 }
 #endif
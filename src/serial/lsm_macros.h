@@ -110,13 +110,13 @@ extern "C" {
    int idx, l;                                                               \
                                                                              \
    if(grid->num_dims == 3)                                                   \
-     for(l = (p->n_lo)[0]; l < (p->n_hi)[0]; l++)                            \
+     for(l = (p->n_lo)[0]; l <= (p->n_hi)[0]; l++)                           \
      {                                                                       \
   idx = (p->index_x)[l] + (p->index_y)[l]*nx + (p->index_z)[l]*nxy;          \
         phi_masked[idx] = (mask[idx] > phi[idx]) ? mask[idx] : phi[idx];     \
      }                                                                       \
    else                                                                      \
-     for(l = (p->n_lo)[0]; l < (p->n_hi)[0]; l++)                            \
+     for(l = (p->n_lo)[0]; l <= (p->n_hi)[0]; l++)                           \
      {                                                                       \
   idx = (p->index_x)[l] + (p->index_y)[l]*nx;                                \
         phi_masked[idx] = (mask[idx] > phi[idx]) ? mask[idx] : phi[idx];     \
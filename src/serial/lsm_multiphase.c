@@ -0,0 +1,781 @@
+/*
+ * File:        lsm_multiphase.c
+ * Copyrights:  (c) 2005 The Trustees of Princeton University and Board of
+ *                  Regents of the University of Texas.  All rights reserved.
+ *              (c) 2009 Kevin T. Chu.  All rights reserved.
+ * Revision:    $Revision$
+ * Modified:    $Date$
+ * Description: Implementation file for sparse storage of multi-phase
+ *              (vector) level set functions in serial LSMLIB calculations
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include <float.h>
+
+#include "lsm_multiphase.h"
+
+
+/*============= Helper functions for multi-phase manipulation =============*/
+
+/*
+ * insertMultiPhaseCellValue() stores the value of the level set function
+ * for the specified phase at the grid cell with index idx if the phase is
+ * among the max_phases_per_cell nearest phases.  If the phase is already
+ * stored at the grid cell, its value is replaced.
+ */
+static void insertMultiPhaseCellValue(LSM_MultiPhase *multiphase,
+                                      int idx, int phase,
+                                      LSMLIB_REAL value);
+
+/*
+ * sortMultiPhaseCell() sorts the slots for a grid cell in order of
+ * increasing phi.
+ */
+static void sortMultiPhaseCell(int *phase_id, LSMLIB_REAL *phi,
+                               int num_slots);
+
+/*
+ * lookupMultiPhaseValue() returns the value of the level set function for
+ * the specified phase at the grid cell with index idx or default_value
+ * if the phase is not stored at the grid cell.
+ */
+static LSMLIB_REAL lookupMultiPhaseValue(LSM_MultiPhase *multiphase,
+                                         int idx, int phase,
+                                         LSMLIB_REAL default_value);
+
+/*
+ * getMultiPhaseNeighbors() computes the indices of the neighbors of
+ * grid cell (i,j,k) in each coordinate direction.  Neighbors of grid
+ * cells on the boundary of the fillbox are ghostcells, so the
+ * ghostcells must be filled (see fillMultiPhaseGhostCells()) before
+ * the data at the neighbors is used.
+ */
+static void getMultiPhaseNeighbors(Grid *grid, int i, int j, int k,
+                                   int *idx_minus, int *idx_plus);
+
+/*
+ * getMultiPhaseSourceIndex() returns the index of the grid cell in the
+ * fillbox that supplies the data for grid cell (i,j,k) under the
+ * boundary conditions (i.e. the index of (i,j,k) itself if it lies in
+ * the fillbox).
+ */
+static int getMultiPhaseSourceIndex(LSM_MultiPhase *multiphase,
+                                    int i, int j, int k);
+
+/*
+ * MULTIPHASE_MIN() and MULTIPHASE_MAX() return the minimum and maximum
+ * of their arguments
+ */
+#define MULTIPHASE_MIN(x, y)   ( (x) < (y) ? (x) : (y) )
+#define MULTIPHASE_MAX(x, y)   ( (x) > (y) ? (x) : (y) )
+
+
+/*============== Multi-phase data management functions ===================*/
+
+LSM_MultiPhase *createMultiPhase(
+  Grid *grid,
+  int num_phases,
+  int max_phases_per_cell,
+  LSMLIB_REAL far_value)
+{
+  LSM_MultiPhase *multiphase;
+  int num_slots = grid->num_gridpts*max_phases_per_cell;
+  int num_candidates = (1 + 2*grid->num_dims)*max_phases_per_cell;
+  int bdry;
+
+  if (max_phases_per_cell < 2) {
+    fprintf(stderr,
+            "\nmax_phases_per_cell (%d) must be at least 2.\n",
+            max_phases_per_cell);
+    return NULL;
+  }
+  if (far_value <= 0) {
+    fprintf(stderr, "\nfar_value must be positive.\n");
+    return NULL;
+  }
+
+  multiphase = (LSM_MultiPhase *)calloc(1,sizeof(LSM_MultiPhase));
+  multiphase->grid = grid;
+  multiphase->num_phases = num_phases;
+  multiphase->max_phases_per_cell = max_phases_per_cell;
+  multiphase->far_value = far_value;
+  for (bdry = 0; bdry < 6; bdry++) {
+    multiphase->bc_type[bdry] = MULTIPHASE_HOMOGENEOUS_NEUMANN_BC;
+  }
+
+  multiphase->phase_id = (int *)malloc(num_slots*sizeof(int));
+  multiphase->phi = (LSMLIB_REAL *)malloc(num_slots*sizeof(LSMLIB_REAL));
+  multiphase->phase_id_scratch = (int *)malloc(num_slots*sizeof(int));
+  multiphase->phi_scratch =
+    (LSMLIB_REAL *)malloc(num_slots*sizeof(LSMLIB_REAL));
+  multiphase->candidate_phase_id =
+    (int *)malloc(num_candidates*sizeof(int));
+  multiphase->candidate_phi =
+    (LSMLIB_REAL *)malloc(num_candidates*sizeof(LSMLIB_REAL));
+
+  clearMultiPhase(multiphase);
+
+  return multiphase;
+}
+
+
+void destroyMultiPhase(LSM_MultiPhase *multiphase)
+{
+  if (multiphase) {
+    free(multiphase->phase_id);
+    free(multiphase->phi);
+    free(multiphase->phase_id_scratch);
+    free(multiphase->phi_scratch);
+    free(multiphase->candidate_phase_id);
+    free(multiphase->candidate_phi);
+    free(multiphase);
+  }
+}
+
+
+void clearMultiPhase(LSM_MultiPhase *multiphase)
+{
+  int num_slots = multiphase->grid->num_gridpts
+                * multiphase->max_phases_per_cell;
+  int s;
+
+  for (s = 0; s < num_slots; s++) {
+    multiphase->phase_id[s] = -1;
+    multiphase->phi[s] = multiphase->far_value;
+  }
+}
+
+
+void setMultiPhaseBoundaryConditions(
+  LSM_MultiPhase *multiphase,
+  int bdry_location_idx,
+  int bc_type)
+{
+  int num_dims = multiphase->grid->num_dims;
+  int bdry;
+
+  if ( (bc_type != MULTIPHASE_HOMOGENEOUS_NEUMANN_BC) &&
+       (bc_type != MULTIPHASE_PERIODIC_BC) ) {
+    fprintf(stderr, "\nInvalid multi-phase boundary condition (%d).\n",
+            bc_type);
+    return;
+  }
+
+  switch (bdry_location_idx) {
+    case X_LO: case X_HI: case Y_LO: case Y_HI: case Z_LO: case Z_HI: {
+      if (bdry_location_idx >= 2*num_dims) break;
+      multiphase->bc_type[bdry_location_idx] = bc_type;
+      return;
+    }
+    case X_LO_AND_X_HI: case Y_LO_AND_Y_HI: case Z_LO_AND_Z_HI: {
+      bdry = 2*(bdry_location_idx - X_LO_AND_X_HI);
+      if (bdry >= 2*num_dims) break;
+      multiphase->bc_type[bdry] = bc_type;
+      multiphase->bc_type[bdry+1] = bc_type;
+      return;
+    }
+    case ALL_BOUNDARIES: {
+      for (bdry = 0; bdry < 2*num_dims; bdry++) {
+        multiphase->bc_type[bdry] = bc_type;
+      }
+      return;
+    }
+  }
+
+  fprintf(stderr, "\nInvalid boundary location index (%d).\n",
+          bdry_location_idx);
+}
+
+
+void fillMultiPhaseGhostCells(LSM_MultiPhase *multiphase)
+{
+  Grid *grid = multiphase->grid;
+  int K = multiphase->max_phases_per_cell;
+  int nx = grid->grid_dims_ghostbox[0];
+  int nxy = grid->grid_dims_ghostbox[0]*grid->grid_dims_ghostbox[1];
+  int klo_gb = (grid->num_dims == 3) ? grid->klo_gb : 0;
+  int khi_gb = (grid->num_dims == 3) ? grid->khi_gb : 0;
+  int klo_fb = (grid->num_dims == 3) ? grid->klo_fb : 0;
+  int khi_fb = (grid->num_dims == 3) ? grid->khi_fb : 0;
+  int i, j, k, idx, idx_src, interior_row;
+
+  for (k = klo_gb; k <= khi_gb; k++) {
+    for (j = grid->jlo_gb; j <= grid->jhi_gb; j++) {
+
+      /* only the ends of rows that pass through the fillbox */
+      /* are ghostcells                                      */
+      interior_row = (j >= grid->jlo_fb) && (j <= grid->jhi_fb)
+                  && (k >= klo_fb) && (k <= khi_fb);
+
+      for (i = grid->ilo_gb; i <= grid->ihi_gb; i++) {
+        if ( interior_row && (i == grid->ilo_fb) ) {
+          i = grid->ihi_fb + 1;
+          if (i > grid->ihi_gb) break;
+        }
+
+        idx = i + j*nx + k*nxy;
+        idx_src = getMultiPhaseSourceIndex(multiphase, i, j, k);
+        memcpy(multiphase->phase_id + idx*K,
+               multiphase->phase_id + idx_src*K, K*sizeof(int));
+        memcpy(multiphase->phi + idx*K,
+               multiphase->phi + idx_src*K, K*sizeof(LSMLIB_REAL));
+      }
+    }
+  }
+}
+
+
+void insertMultiPhaseDenseData(
+  LSM_MultiPhase *multiphase,
+  int phase,
+  LSMLIB_REAL *phi)
+{
+  int num_gridpts = multiphase->grid->num_gridpts;
+  int idx;
+
+  for (idx = 0; idx < num_gridpts; idx++) {
+    insertMultiPhaseCellValue(multiphase, idx, phase, phi[idx]);
+  }
+}
+
+
+void initializeMultiPhaseFromLabels(
+  LSM_MultiPhase *multiphase,
+  int *labels)
+{
+  Grid *grid = multiphase->grid;
+  int nx = grid->grid_dims_ghostbox[0];
+  int nxy = grid->grid_dims_ghostbox[0]*grid->grid_dims_ghostbox[1];
+  int klo_fb = (grid->num_dims == 3) ? grid->klo_fb : 0;
+  int khi_fb = (grid->num_dims == 3) ? grid->khi_fb : 0;
+  int idx_minus[3], idx_plus[3];
+  LSMLIB_REAL half_dx;
+  int i, j, k, dim, idx;
+
+  clearMultiPhase(multiphase);
+
+  half_dx = 0.5*grid->dx[0];
+  for (dim = 1; dim < grid->num_dims; dim++) {
+    half_dx = MULTIPHASE_MIN(half_dx, 0.5*grid->dx[dim]);
+  }
+
+  for (k = klo_fb; k <= khi_fb; k++) {
+    for (j = grid->jlo_fb; j <= grid->jhi_fb; j++) {
+      for (i = grid->ilo_fb; i <= grid->ihi_fb; i++) {
+        idx = i + j*nx + k*nxy;
+
+        insertMultiPhaseCellValue(multiphase, idx, labels[idx], -half_dx);
+        for (dim = 0; dim < grid->num_dims; dim++) {
+
+          /* labels are not required in the ghostcells, so neighbors  */
+          /* outside of the fillbox are determined by the boundary    */
+          /* conditions                                               */
+          idx_minus[dim] = getMultiPhaseSourceIndex(multiphase,
+            i - (dim == 0), j - (dim == 1), k - (dim == 2));
+          idx_plus[dim] = getMultiPhaseSourceIndex(multiphase,
+            i + (dim == 0), j + (dim == 1), k + (dim == 2));
+
+          if (labels[idx_minus[dim]] != labels[idx]) {
+            insertMultiPhaseCellValue(multiphase, idx,
+              labels[idx_minus[dim]], 0.5*grid->dx[dim]);
+          }
+          if (labels[idx_plus[dim]] != labels[idx]) {
+            insertMultiPhaseCellValue(multiphase, idx,
+              labels[idx_plus[dim]], 0.5*grid->dx[dim]);
+          }
+        }
+      }
+    }
+  }
+}
+
+
+LSMLIB_REAL getMultiPhaseValue(
+  LSM_MultiPhase *multiphase,
+  int idx,
+  int phase)
+{
+  return lookupMultiPhaseValue(multiphase, idx, phase,
+                               multiphase->far_value);
+}
+
+
+void copyMultiPhaseToDenseData(
+  LSM_MultiPhase *multiphase,
+  int phase,
+  LSMLIB_REAL *phi)
+{
+  int num_gridpts = multiphase->grid->num_gridpts;
+  int idx;
+
+  for (idx = 0; idx < num_gridpts; idx++) {
+    phi[idx] = lookupMultiPhaseValue(multiphase, idx, phase,
+                                     multiphase->far_value);
+  }
+}
+
+
+void computeMultiPhaseLabels(
+  LSM_MultiPhase *multiphase,
+  int *labels)
+{
+  int num_gridpts = multiphase->grid->num_gridpts;
+  int K = multiphase->max_phases_per_cell;
+  int idx;
+
+  /* the nearest phase is stored in the first slot */
+  for (idx = 0; idx < num_gridpts; idx++) {
+    labels[idx] = multiphase->phase_id[idx*K];
+  }
+}
+
+
+/*================== Multi-phase evolution functions =====================*/
+
+void advanceMultiPhaseLevelSets(
+  LSM_MultiPhase *multiphase,
+  LSMLIB_REAL *vel_n,
+  LSMLIB_REAL curvature_coef,
+  LSMLIB_REAL dt)
+{
+  Grid *grid = multiphase->grid;
+  int K = multiphase->max_phases_per_cell;
+  LSMLIB_REAL far_value = multiphase->far_value;
+  int nx = grid->grid_dims_ghostbox[0];
+  int nxy = grid->grid_dims_ghostbox[0]*grid->grid_dims_ghostbox[1];
+  int klo_fb = (grid->num_dims == 3) ? grid->klo_fb : 0;
+  int khi_fb = (grid->num_dims == 3) ? grid->khi_fb : 0;
+  int idx_minus[3], idx_plus[3];
+  int i, j, k, s, dim, idx, slot, phase;
+  LSMLIB_REAL phi_cur, phi_minus, phi_plus, D_minus, D_plus;
+  LSMLIB_REAL vel, norm_grad_phi_sq, laplacian_phi, phi_next;
+
+  fillMultiPhaseGhostCells(multiphase);
+  memcpy(multiphase->phi_scratch, multiphase->phi,
+         grid->num_gridpts*K*sizeof(LSMLIB_REAL));
+
+  for (k = klo_fb; k <= khi_fb; k++) {
+    for (j = grid->jlo_fb; j <= grid->jhi_fb; j++) {
+      for (i = grid->ilo_fb; i <= grid->ihi_fb; i++) {
+        idx = i + j*nx + k*nxy;
+        getMultiPhaseNeighbors(grid, i, j, k, idx_minus, idx_plus);
+
+        for (s = 0; s < K; s++) {
+          slot = idx*K + s;
+          phase = multiphase->phase_id[slot];
+          if (phase < 0) break;
+
+          phi_cur = multiphase->phi[slot];
+          vel = (vel_n) ? vel_n[phase] : 0.0;
+          norm_grad_phi_sq = 0.0;
+          laplacian_phi = 0.0;
+
+          for (dim = 0; dim < grid->num_dims; dim++) {
+            phi_minus = lookupMultiPhaseValue(multiphase,
+              idx_minus[dim], phase,
+              MULTIPHASE_MIN(far_value, phi_cur + grid->dx[dim]));
+            phi_plus = lookupMultiPhaseValue(multiphase,
+              idx_plus[dim], phase,
+              MULTIPHASE_MIN(far_value, phi_cur + grid->dx[dim]));
+
+            D_minus = (phi_cur - phi_minus)/grid->dx[dim];
+            D_plus = (phi_plus - phi_cur)/grid->dx[dim];
+
+            /* Godunov upwinding for the normal velocity term */
+            if (vel > 0) {
+              norm_grad_phi_sq +=
+                MULTIPHASE_MAX(D_minus,0)*MULTIPHASE_MAX(D_minus,0)
+              + MULTIPHASE_MIN(D_plus,0)*MULTIPHASE_MIN(D_plus,0);
+            } else {
+              norm_grad_phi_sq +=
+                MULTIPHASE_MIN(D_minus,0)*MULTIPHASE_MIN(D_minus,0)
+              + MULTIPHASE_MAX(D_plus,0)*MULTIPHASE_MAX(D_plus,0);
+            }
+
+            laplacian_phi += (D_plus - D_minus)/grid->dx[dim];
+          }
+
+          phi_next = phi_cur + dt*( -vel*sqrt(norm_grad_phi_sq)
+                                  + curvature_coef*laplacian_phi );
+          multiphase->phi_scratch[slot] =
+            MULTIPHASE_MIN(phi_next, far_value);
+        }
+
+      }
+    }
+  }
+
+  /* swap phi and scratch data and restore sort order */
+  {
+    LSMLIB_REAL *tmp = multiphase->phi;
+    multiphase->phi = multiphase->phi_scratch;
+    multiphase->phi_scratch = tmp;
+  }
+  for (idx = 0; idx < grid->num_gridpts; idx++) {
+    sortMultiPhaseCell(multiphase->phase_id + idx*K,
+                       multiphase->phi + idx*K, K);
+  }
+}
+
+
+LSMLIB_REAL computeMultiPhaseStableDt(
+  LSM_MultiPhase *multiphase,
+  LSMLIB_REAL *vel_n,
+  LSMLIB_REAL curvature_coef,
+  LSMLIB_REAL cfl_number)
+{
+  Grid *grid = multiphase->grid;
+  LSMLIB_REAL max_vel = 0.0;
+  LSMLIB_REAL inv_dx_sum = 0.0, inv_dx_sq_sum = 0.0;
+  LSMLIB_REAL inv_dt;
+  int p, dim;
+
+  if (vel_n) {
+    for (p = 0; p < multiphase->num_phases; p++) {
+      max_vel = MULTIPHASE_MAX(max_vel, fabs(vel_n[p]));
+    }
+  }
+  for (dim = 0; dim < grid->num_dims; dim++) {
+    inv_dx_sum += 1.0/grid->dx[dim];
+    inv_dx_sq_sum += 1.0/(grid->dx[dim]*grid->dx[dim]);
+  }
+
+  inv_dt = max_vel*inv_dx_sum + 2.0*fabs(curvature_coef)*inv_dx_sq_sum;
+  if (inv_dt == 0) return LSMLIB_REAL_MAX;
+
+  return cfl_number/inv_dt;
+}
+
+
+void projectMultiPhaseLevelSets(LSM_MultiPhase *multiphase)
+{
+  int num_gridpts = multiphase->grid->num_gridpts;
+  int K = multiphase->max_phases_per_cell;
+  int idx, s;
+  LSMLIB_REAL shift;
+  int *phase_id;
+  LSMLIB_REAL *phi;
+
+  for (idx = 0; idx < num_gridpts; idx++) {
+    phase_id = multiphase->phase_id + idx*K;
+    phi = multiphase->phi + idx*K;
+
+    /* skip grid cells that store fewer than two phases */
+    if (phase_id[1] < 0) continue;
+
+    shift = 0.5*(phi[0] + phi[1]);
+    for (s = 0; (s < K) && (phase_id[s] >= 0); s++) {
+      phi[s] -= shift;
+    }
+  }
+}
+
+
+void reinitializeMultiPhaseLevelSets(
+  LSM_MultiPhase *multiphase,
+  int num_iterations)
+{
+  Grid *grid = multiphase->grid;
+  int K = multiphase->max_phases_per_cell;
+  LSMLIB_REAL far_value = multiphase->far_value;
+  int nx = grid->grid_dims_ghostbox[0];
+  int nxy = grid->grid_dims_ghostbox[0]*grid->grid_dims_ghostbox[1];
+  int klo_fb = (grid->num_dims == 3) ? grid->klo_fb : 0;
+  int khi_fb = (grid->num_dims == 3) ? grid->khi_fb : 0;
+  int idx_minus[3], idx_plus[3];
+  int i, j, k, s, dim, idx, slot, phase, iter;
+  LSMLIB_REAL phi_cur, phi_minus, phi_plus, D_minus, D_plus;
+  LSMLIB_REAL sgn, norm_grad_phi_sq, phi_next;
+  LSMLIB_REAL dt, min_dx, inv_dx_sum = 0.0;
+
+  min_dx = grid->dx[0];
+  for (dim = 0; dim < grid->num_dims; dim++) {
+    inv_dx_sum += 1.0/grid->dx[dim];
+    min_dx = MULTIPHASE_MIN(min_dx, grid->dx[dim]);
+  }
+  dt = 0.5/inv_dx_sum;
+
+  for (iter = 0; iter < num_iterations; iter++) {
+
+    fillMultiPhaseGhostCells(multiphase);
+    memcpy(multiphase->phi_scratch, multiphase->phi,
+           grid->num_gridpts*K*sizeof(LSMLIB_REAL));
+
+    for (k = klo_fb; k <= khi_fb; k++) {
+      for (j = grid->jlo_fb; j <= grid->jhi_fb; j++) {
+        for (i = grid->ilo_fb; i <= grid->ihi_fb; i++) {
+          idx = i + j*nx + k*nxy;
+          getMultiPhaseNeighbors(grid, i, j, k, idx_minus, idx_plus);
+
+          for (s = 0; s < K; s++) {
+            slot = idx*K + s;
+            phase = multiphase->phase_id[slot];
+            if (phase < 0) break;
+
+            phi_cur = multiphase->phi[slot];
+            sgn = phi_cur/sqrt(phi_cur*phi_cur + min_dx*min_dx);
+            norm_grad_phi_sq = 0.0;
+
+            for (dim = 0; dim < grid->num_dims; dim++) {
+              phi_minus = lookupMultiPhaseValue(multiphase,
+                idx_minus[dim], phase,
+                MULTIPHASE_MIN(far_value, phi_cur + grid->dx[dim]));
+              phi_plus = lookupMultiPhaseValue(multiphase,
+                idx_plus[dim], phase,
+                MULTIPHASE_MIN(far_value, phi_cur + grid->dx[dim]));
+
+              D_minus = (phi_cur - phi_minus)/grid->dx[dim];
+              D_plus = (phi_plus - phi_cur)/grid->dx[dim];
+
+              /* Godunov upwinding with velocity sgn */
+              if (sgn > 0) {
+                norm_grad_phi_sq += MULTIPHASE_MAX(
+                  MULTIPHASE_MAX(D_minus,0)*MULTIPHASE_MAX(D_minus,0),
+                  MULTIPHASE_MIN(D_plus,0)*MULTIPHASE_MIN(D_plus,0));
+              } else {
+                norm_grad_phi_sq += MULTIPHASE_MAX(
+                  MULTIPHASE_MIN(D_minus,0)*MULTIPHASE_MIN(D_minus,0),
+                  MULTIPHASE_MAX(D_plus,0)*MULTIPHASE_MAX(D_plus,0));
+              }
+            }
+
+            phi_next = phi_cur - dt*sgn*(sqrt(norm_grad_phi_sq) - 1.0);
+            multiphase->phi_scratch[slot] =
+              MULTIPHASE_MIN(phi_next, far_value);
+          }
+
+        }
+      }
+    }
+
+    /* swap phi and scratch data and restore sort order */
+    {
+      LSMLIB_REAL *tmp = multiphase->phi;
+      multiphase->phi = multiphase->phi_scratch;
+      multiphase->phi_scratch = tmp;
+    }
+    for (idx = 0; idx < grid->num_gridpts; idx++) {
+      sortMultiPhaseCell(multiphase->phase_id + idx*K,
+                         multiphase->phi + idx*K, K);
+    }
+
+    updateMultiPhaseActiveSets(multiphase);
+
+  } /* end loop over iterations */
+}
+
+
+void updateMultiPhaseActiveSets(LSM_MultiPhase *multiphase)
+{
+  Grid *grid = multiphase->grid;
+  int K = multiphase->max_phases_per_cell;
+  LSMLIB_REAL far_value = multiphase->far_value;
+  int *cand_id = multiphase->candidate_phase_id;
+  LSMLIB_REAL *cand_phi = multiphase->candidate_phi;
+  int nx = grid->grid_dims_ghostbox[0];
+  int nxy = grid->grid_dims_ghostbox[0]*grid->grid_dims_ghostbox[1];
+  int klo_fb = (grid->num_dims == 3) ? grid->klo_fb : 0;
+  int khi_fb = (grid->num_dims == 3) ? grid->khi_fb : 0;
+  int idx_minus[3], idx_plus[3];
+  int i, j, k, s, c, n, dim, side, idx, idx_nbr, phase;
+  int num_own, num_cand;
+  LSMLIB_REAL value;
+  int *phase_id_new;
+  LSMLIB_REAL *phi_new;
+
+  fillMultiPhaseGhostCells(multiphase);
+  memcpy(multiphase->phase_id_scratch, multiphase->phase_id,
+         grid->num_gridpts*K*sizeof(int));
+  memcpy(multiphase->phi_scratch, multiphase->phi,
+         grid->num_gridpts*K*sizeof(LSMLIB_REAL));
+
+  for (k = klo_fb; k <= khi_fb; k++) {
+    for (j = grid->jlo_fb; j <= grid->jhi_fb; j++) {
+      for (i = grid->ilo_fb; i <= grid->ihi_fb; i++) {
+        idx = i + j*nx + k*nxy;
+        getMultiPhaseNeighbors(grid, i, j, k, idx_minus, idx_plus);
+
+        /* phases stored at the grid cell keep their values */
+        num_cand = 0;
+        for (s = 0; s < K; s++) {
+          phase = multiphase->phase_id[idx*K + s];
+          if (phase < 0) break;
+          cand_id[num_cand] = phase;
+          cand_phi[num_cand] = multiphase->phi[idx*K + s];
+          num_cand++;
+        }
+        num_own = num_cand;
+
+        /* phases stored at neighboring grid cells */
+        for (dim = 0; dim < grid->num_dims; dim++) {
+          for (side = 0; side < 2; side++) {
+            idx_nbr = (side == 0) ? idx_minus[dim] : idx_plus[dim];
+
+            for (s = 0; s < K; s++) {
+              phase = multiphase->phase_id[idx_nbr*K + s];
+              if (phase < 0) break;
+              value = multiphase->phi[idx_nbr*K + s] + grid->dx[dim];
+
+              for (c = 0; c < num_cand; c++) {
+                if (cand_id[c] == phase) break;
+              }
+              if (c == num_cand) {
+                cand_id[num_cand] = phase;
+                cand_phi[num_cand] = value;
+                num_cand++;
+              } else if ( (c >= num_own) && (value < cand_phi[c]) ) {
+                cand_phi[c] = value;
+              }
+            }
+          }
+        }
+
+        /* keep the K nearest candidates */
+        sortMultiPhaseCell(cand_id, cand_phi, num_cand);
+        phase_id_new = multiphase->phase_id_scratch + idx*K;
+        phi_new = multiphase->phi_scratch + idx*K;
+        for (n = 0; n < K; n++) {
+          if ( (n < num_cand) && (cand_phi[n] < far_value) ) {
+            phase_id_new[n] = cand_id[n];
+            phi_new[n] = cand_phi[n];
+          } else {
+            phase_id_new[n] = -1;
+            phi_new[n] = far_value;
+          }
+        }
+
+      }
+    }
+  }
+
+  /* swap active sets and scratch data */
+  {
+    int *tmp_id = multiphase->phase_id;
+    LSMLIB_REAL *tmp_phi = multiphase->phi;
+    multiphase->phase_id = multiphase->phase_id_scratch;
+    multiphase->phi = multiphase->phi_scratch;
+    multiphase->phase_id_scratch = tmp_id;
+    multiphase->phi_scratch = tmp_phi;
+  }
+}
+
+
+/*=========== Helper functions for multi-phase manipulation ===============*/
+
+void insertMultiPhaseCellValue(LSM_MultiPhase *multiphase,
+                               int idx, int phase,
+                               LSMLIB_REAL value)
+{
+  int K = multiphase->max_phases_per_cell;
+  int *phase_id = multiphase->phase_id + idx*K;
+  LSMLIB_REAL *phi = multiphase->phi + idx*K;
+  int s;
+
+  if ( (phase < 0) || (value >= multiphase->far_value) ) return;
+
+  for (s = 0; s < K; s++) {
+    if ( (phase_id[s] == phase) || (phase_id[s] < 0) ) break;
+  }
+
+  if (s == K) {
+    /* replace the farthest phase if the new phase is nearer */
+    if (value >= phi[K-1]) return;
+    s = K-1;
+  }
+
+  phase_id[s] = phase;
+  phi[s] = value;
+  sortMultiPhaseCell(phase_id, phi, K);
+}
+
+
+void sortMultiPhaseCell(int *phase_id, LSMLIB_REAL *phi, int num_slots)
+{
+  int s, t, id_tmp;
+  LSMLIB_REAL phi_tmp;
+
+  /* insertion sort (num_slots is small) */
+  for (s = 1; s < num_slots; s++) {
+    id_tmp = phase_id[s];
+    phi_tmp = phi[s];
+    for (t = s; (t > 0) && (phi[t-1] > phi_tmp); t--) {
+      phase_id[t] = phase_id[t-1];
+      phi[t] = phi[t-1];
+    }
+    phase_id[t] = id_tmp;
+    phi[t] = phi_tmp;
+  }
+}
+
+
+LSMLIB_REAL lookupMultiPhaseValue(LSM_MultiPhase *multiphase,
+                                  int idx, int phase,
+                                  LSMLIB_REAL default_value)
+{
+  int K = multiphase->max_phases_per_cell;
+  int *phase_id = multiphase->phase_id + idx*K;
+  int s;
+
+  for (s = 0; (s < K) && (phase_id[s] >= 0); s++) {
+    if (phase_id[s] == phase) return multiphase->phi[idx*K + s];
+  }
+  return default_value;
+}
+
+
+void getMultiPhaseNeighbors(Grid *grid, int i, int j, int k,
+                            int *idx_minus, int *idx_plus)
+{
+  int nx = grid->grid_dims_ghostbox[0];
+  int nxy = grid->grid_dims_ghostbox[0]*grid->grid_dims_ghostbox[1];
+  int idx = i + j*nx + k*nxy;
+
+  idx_minus[0] = idx - 1;
+  idx_plus[0]  = idx + 1;
+  idx_minus[1] = idx - nx;
+  idx_plus[1]  = idx + nx;
+  if (grid->num_dims == 3) {
+    idx_minus[2] = idx - nxy;
+    idx_plus[2]  = idx + nxy;
+  } else {
+    idx_minus[2] = idx;
+    idx_plus[2]  = idx;
+  }
+}
+
+
+int getMultiPhaseSourceIndex(LSM_MultiPhase *multiphase,
+                             int i, int j, int k)
+{
+  Grid *grid = multiphase->grid;
+  int nx = grid->grid_dims_ghostbox[0];
+  int nxy = grid->grid_dims_ghostbox[0]*grid->grid_dims_ghostbox[1];
+  int index[3], lo[3], hi[3];
+  int dim, n;
+
+  index[0] = i; lo[0] = grid->ilo_fb; hi[0] = grid->ihi_fb;
+  index[1] = j; lo[1] = grid->jlo_fb; hi[1] = grid->jhi_fb;
+  index[2] = k; lo[2] = grid->klo_fb; hi[2] = grid->khi_fb;
+
+  for (dim = 0; dim < grid->num_dims; dim++) {
+    n = hi[dim] - lo[dim] + 1;
+    if (index[dim] < lo[dim]) {
+      if (multiphase->bc_type[2*dim] == MULTIPHASE_PERIODIC_BC) {
+        index[dim] = lo[dim] + ((index[dim] - lo[dim])%n + n)%n;
+      } else {
+        index[dim] = lo[dim];
+      }
+    } else if (index[dim] > hi[dim]) {
+      if (multiphase->bc_type[2*dim+1] == MULTIPHASE_PERIODIC_BC) {
+        index[dim] = lo[dim] + (index[dim] - lo[dim])%n;
+      } else {
+        index[dim] = hi[dim];
+      }
+    }
+  }
+
+  return index[0] + index[1]*nx + index[2]*nxy;
+}
@@ -0,0 +1,502 @@
+/*
+ * File:        lsm_multiphase.h
+ * Copyrights:  (c) 2005 The Trustees of Princeton University and Board of
+ *                  Regents of the University of Texas.  All rights reserved.
+ *              (c) 2009 Kevin T. Chu.  All rights reserved.
+ * Revision:    $Revision$
+ * Modified:    $Date$
+ * Description: Header file for sparse storage of multi-phase (vector)
+ *              level set functions in serial LSMLIB calculations
+ */
+
+#ifndef included_lsm_multiphase_h
+#define included_lsm_multiphase_h
+
+#include <stdio.h>
+#include "LSMLIB_config.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+
+/*! \file lsm_multiphase.h
+ *
+ * \brief
+ * @ref lsm_multiphase.h provides sparse storage and evolution kernels
+ * for multi-phase level set calculations (e.g. grain growth and foams)
+ * that involve a large number of phases.
+ *
+ * Each phase p is represented by a level set function phi_p that is
+ * negative inside of phase p.  Instead of storing all num_phases level
+ * set functions at every grid cell, only the max_phases_per_cell (K)
+ * phases with the smallest values of phi at a grid cell (i.e. the phases
+ * that are nearest to the grid cell) are stored.  All other phases are
+ * assumed to have the value far_value at the grid cell.  Memory and work
+ * therefore scale as K times the number of grid cells, independent of
+ * the number of phases.
+ *
+ * Typical usage:
+ *  -# create the multi-phase data structure with createMultiPhase()
+ *     and, if necessary, change the boundary conditions using 
+ *     setMultiPhaseBoundaryConditions()
+ *  -# set the initial data using initializeMultiPhaseFromLabels() or
+ *     insertMultiPhaseDenseData() (one call per phase)
+ *  -# reinitialize with reinitializeMultiPhaseLevelSets()
+ *  -# each time step: advance the level set functions using
+ *     advanceMultiPhaseLevelSets(), remove overlaps and vacuum regions
+ *     using projectMultiPhaseLevelSets(), and update the phases stored
+ *     at each grid cell using updateMultiPhaseActiveSets()
+ *  -# periodically call reinitializeMultiPhaseLevelSets()
+ *
+ * NOTES:
+ * - The evolution and reinitialization kernels operate on the fillbox
+ *   of the grid.  Boundary conditions are imposed by filling the 
+ *   ghostcells of the grid (see fillMultiPhaseGhostCells()) before 
+ *   each sweep over the fillbox, so the grid must have at least one 
+ *   ghostcell in each coordinate direction.  Homogeneous Neumann and 
+ *   periodic boundary conditions are supported.
+ *
+ * - The spatial discretizations are first-order accurate.
+ *
+ */
+
+#include "lsm_grid.h"
+#include "lsm_boundary_conditions.h"
+
+
+/*! \enum MULTIPHASE_BC_TYPE
+ *
+ * Enumerated type for specifying the boundary conditions for the
+ * multi-phase level set functions.
+ */
+typedef enum { 
+  MULTIPHASE_HOMOGENEOUS_NEUMANN_BC = 0, 
+  MULTIPHASE_PERIODIC_BC            = 1 } MULTIPHASE_BC_TYPE;
+
+
+/*!
+ * Structure 'LSM_MultiPhase' stores the phases and level set function
+ * values for the phases that are active at each grid cell.
+ *
+ * NOTES:
+ * - The data for the grid cell with index idx (i.e. i + j*nx + k*nx*ny,
+ *   where nx and ny are the dimensions of the ghostbox of the grid) is
+ *   stored in slots idx*max_phases_per_cell through
+ *   (idx+1)*max_phases_per_cell - 1 of the phase_id and phi arrays.
+ *
+ * - The slots for each grid cell are sorted in order of increasing phi.
+ *   Unused slots are at the end of the list and have phase_id equal
+ *   to -1 and phi equal to far_value.
+ *
+ * - bc_type[2*dim] and bc_type[2*dim+1] are the boundary conditions
+ *   at the lower and upper boundaries in the dim coordinate direction.
+ *
+ */
+typedef struct _LSM_MultiPhase
+{
+  /* the grid covered by the multi-phase data (not owned) */
+  Grid *grid;
+
+  /* total number of phases */
+  int num_phases;
+
+  /* maximum number of phases stored at each grid cell */
+  int max_phases_per_cell;
+
+  /* value of the level set functions for phases that are not stored */
+  /* at a grid cell                                                   */
+  LSMLIB_REAL far_value;
+
+  /* boundary condition (MULTIPHASE_BC_TYPE) for each boundary */
+  int bc_type[6];
+
+  /* phase and level set function value for each slot */
+  int         *phase_id;
+  LSMLIB_REAL *phi;
+
+  /* scratch space used by the evolution kernels */
+  int         *phase_id_scratch;
+  LSMLIB_REAL *phi_scratch;
+  int         *candidate_phase_id;
+  LSMLIB_REAL *candidate_phi;
+
+} LSM_MultiPhase;
+
+
+/*! @{
+ ****************************************************************
+ *
+ * @name Multi-phase data management functions
+ *
+ ****************************************************************/
+
+/*!
+ * createMultiPhase() allocates a LSM_MultiPhase data structure that
+ * covers the specified grid.  Initially, no phases are stored at any
+ * grid cell.
+ *
+ * Arguments:
+ *  - grid (in):                 pointer to Grid
+ *  - num_phases (in):           total number of phases
+ *  - max_phases_per_cell (in):  maximum number of phases stored at
+ *                               each grid cell
+ *  - far_value (in):            value of the level set functions for
+ *                               phases that are not stored at a grid
+ *                               cell
+ *
+ * Return value:                 pointer to the newly created
+ *                               LSM_MultiPhase structure (NULL if
+ *                               max_phases_per_cell < 2 or
+ *                               far_value <= 0)
+ *
+ * NOTES:
+ * - The grid is not copied, so it must not be destroyed before the
+ *   multi-phase data structure.
+ *
+ * - far_value should be several grid cells wide.  Phases farther than
+ *   far_value from a grid cell are dropped from the grid cell.
+ *
+ * - max_phases_per_cell = 3 (2D) or 4 (3D) is sufficient to represent
+ *   triple junctions (quadruple points in 3D) and is recommended for
+ *   most calculations.
+ *
+ * - Homogeneous Neumann boundary conditions are imposed at all 
+ *   boundaries.
+ *
+ */
+LSM_MultiPhase *createMultiPhase(
+  Grid *grid,
+  int num_phases,
+  int max_phases_per_cell,
+  LSMLIB_REAL far_value);
+
+
+/*!
+ * destroyMultiPhase() frees ALL memory allocated for the multi-phase
+ * data structure (but not the Grid that it covers).
+ *
+ * Arguments:
+ *  - multiphase (in):  pointer to LSM_MultiPhase
+ *
+ * Return value:        none
+ *
+ */
+void destroyMultiPhase(LSM_MultiPhase *multiphase);
+
+
+/*!
+ * clearMultiPhase() removes all phases from all grid cells.
+ *
+ * Arguments:
+ *  - multiphase (in/out):  pointer to LSM_MultiPhase
+ *
+ * Return value:            none
+ *
+ */
+void clearMultiPhase(LSM_MultiPhase *multiphase);
+
+
+/*!
+ * setMultiPhaseBoundaryConditions() sets the boundary conditions that 
+ * are imposed at the specified boundary location(s).
+ *
+ * Arguments:
+ *  - multiphase (in/out):     pointer to LSM_MultiPhase
+ *  - bdry_location_idx (in):  boundary location index (see 
+ *                             BOUNDARY_LOCATION_IDX in
+ *                             lsm_boundary_conditions.h)
+ *  - bc_type (in):            boundary condition (MULTIPHASE_BC_TYPE)
+ *
+ * Return value:               none
+ *
+ * NOTES:
+ * - Periodic boundary conditions should be imposed at both the lower
+ *   and upper boundaries in a coordinate direction.
+ *
+ */
+void setMultiPhaseBoundaryConditions(
+  LSM_MultiPhase *multiphase,
+  int bdry_location_idx,
+  int bc_type);
+
+
+/*!
+ * fillMultiPhaseGhostCells() fills the ghostcells of the multi-phase
+ * data structure to impose the boundary conditions.  The phases and 
+ * level set function values of each ghostcell are copied from the 
+ * nearest grid cell in the fillbox (homogeneous Neumann boundary 
+ * conditions) or from the periodic image of the ghostcell in the 
+ * fillbox (periodic boundary conditions).
+ *
+ * Arguments:
+ *  - multiphase (in/out):  pointer to LSM_MultiPhase
+ *
+ * Return value:            none
+ *
+ * NOTES:
+ * - The evolution functions call fillMultiPhaseGhostCells() before
+ *   each sweep over the fillbox, so it only needs to be called 
+ *   directly when the ghostcell data is used outside of the evolution
+ *   functions (e.g. after copyMultiPhaseToDenseData()).
+ *
+ */
+void fillMultiPhaseGhostCells(LSM_MultiPhase *multiphase);
+
+
+/*!
+ * insertMultiPhaseDenseData() merges the level set function for a
+ * single phase stored as a full grid data array into the multi-phase
+ * data structure.  At each grid cell, the phase is stored only if it is
+ * among the max_phases_per_cell nearest phases.
+ *
+ * Arguments:
+ *  - multiphase (in/out):  pointer to LSM_MultiPhase
+ *  - phase (in):           phase index (0 <= phase < num_phases)
+ *  - phi (in):             level set function for phase
+ *
+ * Return value:            none
+ *
+ * NOTES:
+ * - Values of phi that are larger than or equal to far_value are
+ *   ignored.
+ *
+ */
+void insertMultiPhaseDenseData(
+  LSM_MultiPhase *multiphase,
+  int phase,
+  LSMLIB_REAL *phi);
+
+
+/*!
+ * initializeMultiPhaseFromLabels() initializes the multi-phase data
+ * structure from an array of phase labels (e.g. a Voronoi tessellation
+ * for grain growth).  At each grid cell, the level set function of the
+ * labelled phase is set to -dx/2 and the level set functions of the
+ * phases of the neighboring grid cells are set to dx/2, where dx is
+ * the grid spacing.
+ *
+ * Arguments:
+ *  - multiphase (in/out):  pointer to LSM_MultiPhase
+ *  - labels (in):          phase label for each grid cell (in the
+ *                          same layout as full grid data arrays)
+ *
+ * Return value:            none
+ *
+ * NOTES:
+ * - Only the labels in the fillbox are used.  Neighbors of grid cells
+ *   on the boundary of the fillbox are determined by the boundary
+ *   conditions.
+ *
+ * - The level set functions are only valid in a layer one grid cell
+ *   thick around each interface.  reinitializeMultiPhaseLevelSets()
+ *   and updateMultiPhaseActiveSets() should be called to extend them
+ *   to the rest of the grid.
+ *
+ */
+void initializeMultiPhaseFromLabels(
+  LSM_MultiPhase *multiphase,
+  int *labels);
+
+
+/*!
+ * getMultiPhaseValue() returns the value of the level set function for
+ * the specified phase at the specified grid cell.
+ *
+ * Arguments:
+ *  - multiphase (in):  pointer to LSM_MultiPhase
+ *  - idx (in):         index of grid cell
+ *  - phase (in):       phase index
+ *
+ * Return value:        value of the level set function (far_value if
+ *                      the phase is not stored at the grid cell)
+ *
+ */
+LSMLIB_REAL getMultiPhaseValue(
+  LSM_MultiPhase *multiphase,
+  int idx,
+  int phase);
+
+
+/*!
+ * copyMultiPhaseToDenseData() copies the level set function for a
+ * single phase into a full grid data array.
+ *
+ * Arguments:
+ *  - multiphase (in):  pointer to LSM_MultiPhase
+ *  - phase (in):       phase index
+ *  - phi (out):        level set function for phase
+ *
+ * Return value:        none
+ *
+ */
+void copyMultiPhaseToDenseData(
+  LSM_MultiPhase *multiphase,
+  int phase,
+  LSMLIB_REAL *phi);
+
+
+/*!
+ * computeMultiPhaseLabels() sets the label of each grid cell to the
+ * phase with the smallest value of the level set function (i.e. the
+ * phase that occupies the grid cell).
+ *
+ * Arguments:
+ *  - multiphase (in):  pointer to LSM_MultiPhase
+ *  - labels (out):     phase label for each grid cell (-1 for grid
+ *                      cells where no phases are stored)
+ *
+ * Return value:        none
+ *
+ */
+void computeMultiPhaseLabels(
+  LSM_MultiPhase *multiphase,
+  int *labels);
+
+/*! @} */
+
+
+/*! @{
+ ****************************************************************
+ *
+ * @name Multi-phase evolution functions
+ *
+ ****************************************************************/
+
+/*!
+ * advanceMultiPhaseLevelSets() advances the level set function of every
+ * stored phase by a single forward Euler step of
+ *
+ *   phi_t + V_p |grad(phi)| = b Laplacian(phi)
+ *
+ * where V_p is the normal velocity of phase p and b is the curvature
+ * coefficient.  For signed distance functions, b Laplacian(phi) is
+ * equal to b kappa |grad(phi)|, so the second term yields motion by
+ * mean curvature (e.g. grain boundary motion).
+ *
+ * Arguments:
+ *  - multiphase (in/out):  pointer to LSM_MultiPhase
+ *  - vel_n (in):           normal velocity for each phase (NULL if
+ *                          all phases have zero normal velocity)
+ *  - curvature_coef (in):  curvature coefficient b
+ *  - dt (in):              time step
+ *
+ * Return value:            none
+ *
+ * NOTES:
+ * - The normal velocity term is discretized using a first-order
+ *   Godunov scheme.  The curvature term is discretized using second-order
+ *   central differences.
+ *
+ * - Values for phases that are not stored at a neighboring grid cell
+ *   are extrapolated as phi + dx (i.e. assuming that the distance to
+ *   the phase increases away from the grid cell).
+ *
+ * - The set of phases stored at each grid cell is not changed.  Use
+ *   updateMultiPhaseActiveSets() to allow phases to move into new
+ *   grid cells.
+ *
+ */
+void advanceMultiPhaseLevelSets(
+  LSM_MultiPhase *multiphase,
+  LSMLIB_REAL *vel_n,
+  LSMLIB_REAL curvature_coef,
+  LSMLIB_REAL dt);
+
+
+/*!
+ * computeMultiPhaseStableDt() computes the stable time step for
+ * advanceMultiPhaseLevelSets().
+ *
+ * Arguments:
+ *  - multiphase (in):      pointer to LSM_MultiPhase
+ *  - vel_n (in):           normal velocity for each phase (may be NULL)
+ *  - curvature_coef (in):  curvature coefficient
+ *  - cfl_number (in):      CFL number (should be less than 1)
+ *
+ * Return value:            stable time step
+ *
+ */
+LSMLIB_REAL computeMultiPhaseStableDt(
+  LSM_MultiPhase *multiphase,
+  LSMLIB_REAL *vel_n,
+  LSMLIB_REAL curvature_coef,
+  LSMLIB_REAL cfl_number);
+
+
+/*!
+ * projectMultiPhaseLevelSets() removes overlaps and vacuum regions
+ * between the phases by subtracting the average of the two smallest
+ * level set function values at each grid cell from the level set
+ * functions of all of the phases stored at the grid cell.  After the
+ * projection, every grid cell belongs to exactly one phase and the
+ * interfaces between neighboring phases coincide.
+ *
+ * Arguments:
+ *  - multiphase (in/out):  pointer to LSM_MultiPhase
+ *
+ * Return value:            none
+ *
+ * NOTES:
+ * - Grid cells that store only one phase are not modified.
+ *
+ */
+void projectMultiPhaseLevelSets(LSM_MultiPhase *multiphase);
+
+
+/*!
+ * reinitializeMultiPhaseLevelSets() reinitializes the level set
+ * function of every stored phase to a signed distance function by
+ * taking several pseudo-time steps of the reinitialization equation
+ *
+ *   phi_t + S(phi_0) ( |grad(phi)| - 1 ) = 0
+ *
+ * Arguments:
+ *  - multiphase (in/out):  pointer to LSM_MultiPhase
+ *  - num_iterations (in):  number of pseudo-time steps
+ *
+ * Return value:            none
+ *
+ * NOTES:
+ * - The pseudo-time step is 0.5/(1/dx + 1/dy + 1/dz).  The number
+ *   of iterations required to reinitialize a layer of width w around
+ *   the interfaces is approximately 2 w/dx.
+ *
+ * - updateMultiPhaseActiveSets() is called after each pseudo-time step
+ *   so that the reinitialized level set functions spread to the grid
+ *   cells near the interfaces.
+ *
+ */
+void reinitializeMultiPhaseLevelSets(
+  LSM_MultiPhase *multiphase,
+  int num_iterations);
+
+
+/*!
+ * updateMultiPhaseActiveSets() updates the phases stored at each grid
+ * cell.  Phases stored at neighboring grid cells are candidates for
+ * the grid cell with the estimated value phi_neighbor + dx.  At each
+ * grid cell, the max_phases_per_cell phases with the smallest values
+ * are kept.
+ *
+ * Arguments:
+ *  - multiphase (in/out):  pointer to LSM_MultiPhase
+ *
+ * Return value:            none
+ *
+ * NOTES:
+ * - The values of phases that are already stored at a grid cell are
+ *   not modified.
+ *
+ * - Phases with values larger than or equal to far_value are removed.
+ *
+ */
+void updateMultiPhaseActiveSets(LSM_MultiPhase *multiphase);
+
+/*! @} */
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
@@ -0,0 +1,813 @@
+/*
+ * File:        lsm_sparse_grid.c
+ * Copyrights:  (c) 2005 The Trustees of Princeton University and Board of
+ *                  Regents of the University of Texas.  All rights reserved.
+ *              (c) 2009 Kevin T. Chu.  All rights reserved.
+ * Revision:    $Revision$
+ * Modified:    $Date$
+ * Description: Implementation file for sparse brick storage of data arrays
+ *              for narrow band serial LSMLIB calculations
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+
+#include "lsm_sparse_grid.h"
+
+
+/*============= Helper functions for sparse grid manipulation =============*/
+
+/*
+ * growSparseGridStorage() increases the number of bricks that storage
+ * is allocated for so that at least num_bricks bricks can be active.
+ */
+static void growSparseGridStorage(LSM_SparseGrid *sparse_grid,
+                                  int num_bricks);
+
+/*
+ * getSparseGridValue() returns the value of the field at the grid cell
+ * (i,j,k) of the full grid.  (i,j,k) is assumed to lie in the fillbox.
+ * If the cell is not covered by an active brick, the background value
+ * of the field is returned with the sign of sign_value (if the background
+ * value is signed).
+ */
+static LSMLIB_REAL getSparseGridValue(LSM_SparseGrid *sparse_grid,
+                                      int field, int i, int j, int k,
+                                      LSMLIB_REAL sign_value);
+
+/*
+ * computeSparseGridBrickInterior() computes the index of the lower
+ * corner of the interior of brick (bi,bj,bk) in the full grid (origin)
+ * and the number of grid cells of the brick interior that lie in the
+ * fillbox of the full grid (num_interior).
+ */
+static void computeSparseGridBrickInterior(LSM_SparseGrid *sparse_grid,
+                                           const int *coords,
+                                           int *origin,
+                                           int *num_interior);
+
+/*
+ * SPARSE_GRID_TABLE_IDX() computes the brick_table index for brick
+ * (bi,bj,bk).
+ */
+#define SPARSE_GRID_TABLE_IDX(sg, bi, bj, bk)                              \
+  ( (bi) + (bj)*(sg)->num_bricks[0]                                        \
+  + (bk)*(sg)->num_bricks[0]*(sg)->num_bricks[1] )
+
+/* SPARSE_GRID_CLAMP() restricts x to the range [lo,hi] */
+#define SPARSE_GRID_CLAMP(x, lo, hi)                                       \
+  ( (x) < (lo) ? (lo) : ( (x) > (hi) ? (hi) : (x) ) )
+
+/* SPARSE_GRID_SIGNED_VALUE() returns the background value with the */
+/* sign of x                                                         */
+#define SPARSE_GRID_SIGNED_VALUE(background, x)                            \
+  ( (x) < 0 ? -(background) : (background) )
+
+
+/*============== Sparse grid management functions ===================*/
+
+LSM_SparseGrid *createSparseGrid(
+  Grid *grid,
+  int brick_size,
+  int num_fields)
+{
+  LSM_SparseGrid *sparse_grid;
+  int gb_lo[3], gb_hi[3], fb_lo[3], fb_hi[3];
+  int num_table_entries;
+  int dim, idx;
+
+  gb_lo[0] = grid->ilo_gb; gb_hi[0] = grid->ihi_gb;
+  gb_lo[1] = grid->jlo_gb; gb_hi[1] = grid->jhi_gb;
+  gb_lo[2] = grid->klo_gb; gb_hi[2] = grid->khi_gb;
+  fb_lo[0] = grid->ilo_fb; fb_hi[0] = grid->ihi_fb;
+  fb_lo[1] = grid->jlo_fb; fb_hi[1] = grid->jhi_fb;
+  fb_lo[2] = grid->klo_fb; fb_hi[2] = grid->khi_fb;
+
+  /* 2D grids have a single layer of bricks in the k-direction */
+  if (grid->num_dims == 2) {
+    gb_lo[2] = 0; gb_hi[2] = 0;
+    fb_lo[2] = 0; fb_hi[2] = 0;
+  }
+
+  for (dim = 0; dim < grid->num_dims; dim++) {
+    if ( (brick_size < fb_lo[dim] - gb_lo[dim])
+      || (brick_size < gb_hi[dim] - fb_hi[dim]) ) {
+      fprintf(stderr,
+              "\nbrick_size (%d) must not be smaller than the number ",
+              brick_size);
+      fprintf(stderr, "of ghostcells.\n");
+      return NULL;
+    }
+  }
+
+  sparse_grid = (LSM_SparseGrid *)calloc(1,sizeof(LSM_SparseGrid));
+  sparse_grid->grid = grid;
+  sparse_grid->brick_size = brick_size;
+
+  sparse_grid->num_brick_gridpts = 1;
+  sparse_grid->num_brick_ghostbox_gridpts = 1;
+  num_table_entries = 1;
+  for (dim = 0; dim < 3; dim++) {
+    sparse_grid->brick_extent[dim] = (dim < grid->num_dims) ? brick_size : 1;
+    sparse_grid->fillbox_lo[dim] = fb_lo[dim];
+    sparse_grid->fillbox_hi[dim] = fb_hi[dim];
+    sparse_grid->ghostcell_width_lo[dim] = fb_lo[dim] - gb_lo[dim];
+    sparse_grid->ghostcell_width_hi[dim] = gb_hi[dim] - fb_hi[dim];
+    sparse_grid->brick_dims_ghostbox[dim] =
+      sparse_grid->ghostcell_width_lo[dim] + sparse_grid->brick_extent[dim]
+    + sparse_grid->ghostcell_width_hi[dim];
+    sparse_grid->num_bricks[dim] =
+      (fb_hi[dim] - fb_lo[dim] + sparse_grid->brick_extent[dim])
+      / sparse_grid->brick_extent[dim];
+
+    sparse_grid->num_brick_gridpts *= sparse_grid->brick_extent[dim];
+    sparse_grid->num_brick_ghostbox_gridpts *=
+      sparse_grid->brick_dims_ghostbox[dim];
+    num_table_entries *= sparse_grid->num_bricks[dim];
+  }
+
+  sparse_grid->brick_table = (int *)malloc(num_table_entries*sizeof(int));
+  for (idx = 0; idx < num_table_entries; idx++) {
+    sparse_grid->brick_table[idx] = -1;
+  }
+  sparse_grid->brick_flags =
+    (unsigned char *)calloc(num_table_entries,sizeof(unsigned char));
+
+  sparse_grid->num_fields = num_fields;
+  sparse_grid->field_data =
+    (LSMLIB_REAL **)calloc(num_fields,sizeof(LSMLIB_REAL *));
+  sparse_grid->background_value =
+    (LSMLIB_REAL *)calloc(num_fields,sizeof(LSMLIB_REAL));
+  sparse_grid->signed_background = (int *)calloc(num_fields,sizeof(int));
+
+  return sparse_grid;
+}
+
+
+void destroySparseGrid(LSM_SparseGrid *sparse_grid)
+{
+  int field;
+
+  if (!sparse_grid) return;
+
+  for (field = 0; field < sparse_grid->num_fields; field++) {
+    free(sparse_grid->field_data[field]);
+  }
+  free(sparse_grid->field_data);
+  free(sparse_grid->background_value);
+  free(sparse_grid->signed_background);
+  free(sparse_grid->brick_table);
+  free(sparse_grid->brick_flags);
+  free(sparse_grid->brick_coords);
+  free(sparse_grid);
+}
+
+
+void setSparseGridBackgroundValue(
+  LSM_SparseGrid *sparse_grid,
+  int field,
+  LSMLIB_REAL background_value,
+  int signed_background)
+{
+  sparse_grid->background_value[field] = background_value;
+  sparse_grid->signed_background[field] = signed_background;
+}
+
+
+int activateSparseGridBrick(
+  LSM_SparseGrid *sparse_grid,
+  int bi, int bj, int bk)
+{
+  int table_idx, brick_idx;
+  int field, idx;
+  LSMLIB_REAL *data;
+
+  if ( (bi < 0) || (bi >= sparse_grid->num_bricks[0])
+    || (bj < 0) || (bj >= sparse_grid->num_bricks[1])
+    || (bk < 0) || (bk >= sparse_grid->num_bricks[2]) ) {
+    return -1;
+  }
+
+  table_idx = SPARSE_GRID_TABLE_IDX(sparse_grid, bi, bj, bk);
+  if (sparse_grid->brick_table[table_idx] >= 0) {
+    return sparse_grid->brick_table[table_idx];
+  }
+
+  if (sparse_grid->num_active_bricks == sparse_grid->num_alloc_bricks) {
+    growSparseGridStorage(sparse_grid, sparse_grid->num_active_bricks+1);
+  }
+
+  brick_idx = sparse_grid->num_active_bricks++;
+  sparse_grid->brick_table[table_idx] = brick_idx;
+  sparse_grid->brick_coords[3*brick_idx]   = bi;
+  sparse_grid->brick_coords[3*brick_idx+1] = bj;
+  sparse_grid->brick_coords[3*brick_idx+2] = bk;
+
+  for (field = 0; field < sparse_grid->num_fields; field++) {
+    data = SPARSE_GRID_BRICK_DATA(sparse_grid, field, brick_idx);
+    for (idx = 0; idx < sparse_grid->num_brick_gridpts; idx++) {
+      data[idx] = sparse_grid->background_value[field];
+    }
+  }
+
+  return brick_idx;
+}
+
+
+void deactivateSparseGridBrick(
+  LSM_SparseGrid *sparse_grid,
+  int brick_idx)
+{
+  int last_idx = sparse_grid->num_active_bricks - 1;
+  int *coords;
+  int field;
+
+  if ( (brick_idx < 0) || (brick_idx > last_idx) ) return;
+
+  coords = sparse_grid->brick_coords + 3*brick_idx;
+  sparse_grid->brick_table[
+    SPARSE_GRID_TABLE_IDX(sparse_grid, coords[0], coords[1], coords[2])] = -1;
+
+  /* move last active brick into storage of deactivated brick */
+  if (brick_idx != last_idx) {
+    for (field = 0; field < sparse_grid->num_fields; field++) {
+      memcpy(SPARSE_GRID_BRICK_DATA(sparse_grid, field, brick_idx),
+             SPARSE_GRID_BRICK_DATA(sparse_grid, field, last_idx),
+             sparse_grid->num_brick_gridpts*sizeof(LSMLIB_REAL));
+    }
+    coords[0] = sparse_grid->brick_coords[3*last_idx];
+    coords[1] = sparse_grid->brick_coords[3*last_idx+1];
+    coords[2] = sparse_grid->brick_coords[3*last_idx+2];
+    sparse_grid->brick_table[
+      SPARSE_GRID_TABLE_IDX(sparse_grid, coords[0], coords[1], coords[2])] =
+      brick_idx;
+  }
+
+  sparse_grid->num_active_bricks--;
+}
+
+
+void fillSparseGridBrickGrid(
+  LSM_SparseGrid *sparse_grid,
+  int brick_idx,
+  Grid *brick_grid)
+{
+  Grid *grid = sparse_grid->grid;
+  int *coords = sparse_grid->brick_coords + 3*brick_idx;
+  int origin, num_interior;
+  int fb_lo, fb_hi;
+  int dim;
+
+  /* start with a copy of the full grid so that all other fields */
+  /* (e.g. narrow band marks and widths) are the same            */
+  *brick_grid = *grid;
+  brick_grid->num_gridpts = sparse_grid->num_brick_ghostbox_gridpts;
+
+  for (dim = 0; dim < grid->num_dims; dim++) {
+
+    origin = sparse_grid->fillbox_lo[dim] + coords[dim]*sparse_grid->brick_size;
+    num_interior = sparse_grid->fillbox_hi[dim] - origin + 1;
+    if (num_interior > sparse_grid->brick_size) {
+      num_interior = sparse_grid->brick_size;
+    }
+    fb_lo = sparse_grid->ghostcell_width_lo[dim];
+    fb_hi = fb_lo + num_interior - 1;
+
+    brick_grid->grid_dims[dim] = num_interior;
+    brick_grid->grid_dims_ghostbox[dim] = sparse_grid->brick_dims_ghostbox[dim];
+    brick_grid->x_lo_ghostbox[dim] = grid->x_lo_ghostbox[dim]
+      + (origin - sparse_grid->ghostcell_width_lo[dim])*grid->dx[dim];
+    brick_grid->x_hi_ghostbox[dim] = brick_grid->x_lo_ghostbox[dim]
+      + sparse_grid->brick_dims_ghostbox[dim]*grid->dx[dim];
+    brick_grid->x_lo[dim] = brick_grid->x_lo_ghostbox[dim]
+      + fb_lo*grid->dx[dim];
+    brick_grid->x_hi[dim] = brick_grid->x_lo[dim]
+      + num_interior*grid->dx[dim];
+
+    /* the offsets between the fillboxes and the ghostbox of the brick */
+    /* are the same as for the full grid                               */
+    switch (dim) {
+      case 0: {
+        brick_grid->ilo_gb = 0;
+        brick_grid->ihi_gb = sparse_grid->brick_dims_ghostbox[0] - 1;
+        brick_grid->ilo_fb = fb_lo;   brick_grid->ihi_fb = fb_hi;
+        brick_grid->ilo_D1_fb = fb_lo - (grid->ilo_fb - grid->ilo_D1_fb);
+        brick_grid->ihi_D1_fb = fb_hi + (grid->ihi_D1_fb - grid->ihi_fb);
+        brick_grid->ilo_D2_fb = fb_lo - (grid->ilo_fb - grid->ilo_D2_fb);
+        brick_grid->ihi_D2_fb = fb_hi + (grid->ihi_D2_fb - grid->ihi_fb);
+        brick_grid->ilo_D3_fb = fb_lo - (grid->ilo_fb - grid->ilo_D3_fb);
+        brick_grid->ihi_D3_fb = fb_hi + (grid->ihi_D3_fb - grid->ihi_fb);
+        break;
+      }
+      case 1: {
+        brick_grid->jlo_gb = 0;
+        brick_grid->jhi_gb = sparse_grid->brick_dims_ghostbox[1] - 1;
+        brick_grid->jlo_fb = fb_lo;   brick_grid->jhi_fb = fb_hi;
+        brick_grid->jlo_D1_fb = fb_lo - (grid->jlo_fb - grid->jlo_D1_fb);
+        brick_grid->jhi_D1_fb = fb_hi + (grid->jhi_D1_fb - grid->jhi_fb);
+        brick_grid->jlo_D2_fb = fb_lo - (grid->jlo_fb - grid->jlo_D2_fb);
+        brick_grid->jhi_D2_fb = fb_hi + (grid->jhi_D2_fb - grid->jhi_fb);
+        brick_grid->jlo_D3_fb = fb_lo - (grid->jlo_fb - grid->jlo_D3_fb);
+        brick_grid->jhi_D3_fb = fb_hi + (grid->jhi_D3_fb - grid->jhi_fb);
+        break;
+      }
+      case 2: {
+        brick_grid->klo_gb = 0;
+        brick_grid->khi_gb = sparse_grid->brick_dims_ghostbox[2] - 1;
+        brick_grid->klo_fb = fb_lo;   brick_grid->khi_fb = fb_hi;
+        brick_grid->klo_D1_fb = fb_lo - (grid->klo_fb - grid->klo_D1_fb);
+        brick_grid->khi_D1_fb = fb_hi + (grid->khi_D1_fb - grid->khi_fb);
+        brick_grid->klo_D2_fb = fb_lo - (grid->klo_fb - grid->klo_D2_fb);
+        brick_grid->khi_D2_fb = fb_hi + (grid->khi_D2_fb - grid->khi_fb);
+        brick_grid->klo_D3_fb = fb_lo - (grid->klo_fb - grid->klo_D3_fb);
+        brick_grid->khi_D3_fb = fb_hi + (grid->khi_D3_fb - grid->khi_fb);
+        break;
+      }
+    }
+  }
+}
+
+
+/*================== Sparse grid data functions ======================*/
+
+void getSparseGridBrickData(
+  LSM_SparseGrid *sparse_grid,
+  int field,
+  int brick_idx,
+  LSMLIB_REAL *brick_data)
+{
+  int *dims = sparse_grid->brick_dims_ghostbox;
+  int *g_lo = sparse_grid->ghostcell_width_lo;
+  int *extent = sparse_grid->brick_extent;
+  int nx = dims[0];
+  int nxy = dims[0]*dims[1];
+  int origin[3], num_interior[3], int_lo[3], int_hi[3];
+  int i, j, k, ii, jj, kk, dim;
+  int row_is_interior;
+  LSMLIB_REAL *data = SPARSE_GRID_BRICK_DATA(sparse_grid, field, brick_idx);
+
+  /* local index range of the brick interior that lies in the fillbox */
+  computeSparseGridBrickInterior(sparse_grid,
+    sparse_grid->brick_coords + 3*brick_idx, origin, num_interior);
+  for (dim = 0; dim < 3; dim++) {
+    int_lo[dim] = g_lo[dim];
+    int_hi[dim] = g_lo[dim] + num_interior[dim] - 1;
+  }
+
+  /* copy interior of the brick */
+  for (k = int_lo[2]; k <= int_hi[2]; k++) {
+    for (j = int_lo[1]; j <= int_hi[1]; j++) {
+      memcpy(brick_data + int_lo[0] + j*nx + k*nxy,
+             data + (j-g_lo[1])*extent[0]
+                  + (k-g_lo[2])*extent[0]*extent[1],
+             num_interior[0]*sizeof(LSMLIB_REAL));
+    }
+  }
+
+  /* gather ghostcells */
+  for (k = 0; k < dims[2]; k++) {
+    kk = SPARSE_GRID_CLAMP(k, int_lo[2], int_hi[2]);
+    for (j = 0; j < dims[1]; j++) {
+      jj = SPARSE_GRID_CLAMP(j, int_lo[1], int_hi[1]);
+      row_is_interior = (jj == j) && (kk == k);
+
+      for (i = 0; i < dims[0]; i++) {
+
+        /* skip over interior of the brick */
+        if ( row_is_interior && (i == int_lo[0]) ) {
+          i = int_hi[0];
+          continue;
+        }
+
+        ii = SPARSE_GRID_CLAMP(i, int_lo[0], int_hi[0]);
+
+        /* the sign of the background value is taken from the */
+        /* nearest grid cell in the interior of the brick     */
+        brick_data[i + j*nx + k*nxy] = getSparseGridValue(sparse_grid, field,
+          origin[0] + i - g_lo[0],
+          origin[1] + j - g_lo[1],
+          origin[2] + k - g_lo[2],
+          brick_data[ii + jj*nx + kk*nxy]);
+      }
+    }
+  }
+}
+
+
+void setSparseGridBrickData(
+  LSM_SparseGrid *sparse_grid,
+  int field,
+  int brick_idx,
+  const LSMLIB_REAL *brick_data)
+{
+  int *dims = sparse_grid->brick_dims_ghostbox;
+  int *g_lo = sparse_grid->ghostcell_width_lo;
+  int *extent = sparse_grid->brick_extent;
+  int nx = dims[0];
+  int nxy = dims[0]*dims[1];
+  int origin[3], num_interior[3];
+  int j, k;
+  LSMLIB_REAL *data = SPARSE_GRID_BRICK_DATA(sparse_grid, field, brick_idx);
+
+  computeSparseGridBrickInterior(sparse_grid,
+    sparse_grid->brick_coords + 3*brick_idx, origin, num_interior);
+
+  for (k = 0; k < num_interior[2]; k++) {
+    for (j = 0; j < num_interior[1]; j++) {
+      memcpy(data + j*extent[0] + k*extent[0]*extent[1],
+             brick_data + g_lo[0] + (j+g_lo[1])*nx + (k+g_lo[2])*nxy,
+             num_interior[0]*sizeof(LSMLIB_REAL));
+    }
+  }
+}
+
+
+int activateSparseGridBricksFromDenseData(
+  LSM_SparseGrid *sparse_grid,
+  int field,
+  LSMLIB_REAL *data,
+  LSMLIB_REAL width)
+{
+  Grid *grid = sparse_grid->grid;
+  int *extent = sparse_grid->brick_extent;
+  int *fb_lo = sparse_grid->fillbox_lo;
+  int *fb_hi = sparse_grid->fillbox_hi;
+  int *nb = sparse_grid->num_bricks;
+  int nx = grid->grid_dims_ghostbox[0];
+  int nxy = grid->grid_dims_ghostbox[0]*grid->grid_dims_ghostbox[1];
+  int num_table_entries = nb[0]*nb[1]*nb[2];
+  int dk_lo = (grid->num_dims == 3) ? -1 : 0;
+  int dk_hi = (grid->num_dims == 3) ?  1 : 0;
+  int i, j, k, bi, bj, bk, di, dj, dk, t;
+
+  /* flag bricks containing the narrow band */
+  for (k = fb_lo[2]; k <= fb_hi[2]; k++) {
+    for (j = fb_lo[1]; j <= fb_hi[1]; j++) {
+      for (i = fb_lo[0]; i <= fb_hi[0]; i++) {
+        if (fabs(data[i + j*nx + k*nxy]) < width) {
+          sparse_grid->brick_flags[ SPARSE_GRID_TABLE_IDX(sparse_grid,
+            (i-fb_lo[0])/extent[0],
+            (j-fb_lo[1])/extent[1],
+            (k-fb_lo[2])/extent[2]) ] = 1;
+        }
+      }
+    }
+  }
+
+  /* activate flagged bricks and their neighbors */
+  for (bk = 0; bk < nb[2]; bk++) {
+    for (bj = 0; bj < nb[1]; bj++) {
+      for (bi = 0; bi < nb[0]; bi++) {
+        if (!sparse_grid->brick_flags[
+               SPARSE_GRID_TABLE_IDX(sparse_grid, bi, bj, bk)]) continue;
+        for (dk = dk_lo; dk <= dk_hi; dk++) {
+          for (dj = -1; dj <= 1; dj++) {
+            for (di = -1; di <= 1; di++) {
+              activateSparseGridBrick(sparse_grid, bi+di, bj+dj, bk+dk);
+            }
+          }
+        }
+      }
+    }
+  }
+
+  for (t = 0; t < num_table_entries; t++) {
+    sparse_grid->brick_flags[t] = 0;
+  }
+
+  copyDenseDataToSparseGrid(sparse_grid, field, data);
+
+  return sparse_grid->num_active_bricks;
+}
+
+
+void copyDenseDataToSparseGrid(
+  LSM_SparseGrid *sparse_grid,
+  int field,
+  LSMLIB_REAL *data)
+{
+  Grid *grid = sparse_grid->grid;
+  int *extent = sparse_grid->brick_extent;
+  int nx = grid->grid_dims_ghostbox[0];
+  int nxy = grid->grid_dims_ghostbox[0]*grid->grid_dims_ghostbox[1];
+  int brick_idx;
+  int lo[3];
+  int i, j, k, ii, jj, kk, dim;
+  LSMLIB_REAL *brick_data;
+
+  for (brick_idx = 0; brick_idx < sparse_grid->num_active_bricks;
+       brick_idx++) {
+
+    brick_data = SPARSE_GRID_BRICK_DATA(sparse_grid, field, brick_idx);
+
+    /* index of lower corner of brick interior in the full grid */
+    for (dim = 0; dim < 3; dim++) {
+      lo[dim] = sparse_grid->fillbox_lo[dim]
+        + sparse_grid->brick_coords[3*brick_idx+dim]*extent[dim];
+    }
+
+    for (k = 0; k < extent[2]; k++) {
+      kk = SPARSE_GRID_CLAMP(lo[2]+k, 0, grid->grid_dims_ghostbox[2]-1);
+      for (j = 0; j < extent[1]; j++) {
+        jj = SPARSE_GRID_CLAMP(lo[1]+j, 0, grid->grid_dims_ghostbox[1]-1);
+        for (i = 0; i < extent[0]; i++) {
+          ii = SPARSE_GRID_CLAMP(lo[0]+i, 0, grid->grid_dims_ghostbox[0]-1);
+          *brick_data++ = data[ii + jj*nx + kk*nxy];
+        }
+      }
+    }
+  }
+}
+
+
+void copySparseGridToDenseData(
+  LSM_SparseGrid *sparse_grid,
+  int field,
+  LSMLIB_REAL *data)
+{
+  Grid *grid = sparse_grid->grid;
+  int *fb_lo = sparse_grid->fillbox_lo;
+  int *fb_hi = sparse_grid->fillbox_hi;
+  int nx = grid->grid_dims_ghostbox[0];
+  int nxy = grid->grid_dims_ghostbox[0]*grid->grid_dims_ghostbox[1];
+  int i, j, k, idx;
+  LSMLIB_REAL last_value;
+
+  for (k = fb_lo[2]; k <= fb_hi[2]; k++) {
+    for (j = fb_lo[1]; j <= fb_hi[1]; j++) {
+      last_value = 1.0;
+      for (i = fb_lo[0]; i <= fb_hi[0]; i++) {
+        idx = i + j*nx + k*nxy;
+        data[idx] = getSparseGridValue(sparse_grid, field, i, j, k,
+                                       last_value);
+        last_value = data[idx];
+      }
+    }
+  }
+}
+
+
+int updateSparseGridActiveBricks(
+  LSM_SparseGrid *sparse_grid,
+  int phi_field,
+  LSMLIB_REAL width)
+{
+  Grid *grid = sparse_grid->grid;
+  int *extent = sparse_grid->brick_extent;
+  int *nb = sparse_grid->num_bricks;
+  int nx = extent[0];
+  int nxy = extent[0]*extent[1];
+  int num_table_entries = nb[0]*nb[1]*nb[2];
+  int dk_lo = (grid->num_dims == 3) ? -1 : 0;
+  int dk_hi = (grid->num_dims == 3) ?  1 : 0;
+  int num_changed = 0;
+  int brick_idx, t, nbr_t, num_nbrs, idx;
+  int *coords;
+  int new_coords[3], origin[3], nbr_origin[3];
+  int num_interior[3], int_hi[3], offset[3];
+  int i, j, k, ii, jj, kk, di, dj, dk, dim;
+  int found;
+  LSMLIB_REAL *data, *nbr_data;
+  LSMLIB_REAL dist, value;
+
+  /* flag bricks whose interior contains the narrow band */
+  for (brick_idx = 0; brick_idx < sparse_grid->num_active_bricks;
+       brick_idx++) {
+
+    data = SPARSE_GRID_BRICK_DATA(sparse_grid, phi_field, brick_idx);
+    coords = sparse_grid->brick_coords + 3*brick_idx;
+    computeSparseGridBrickInterior(sparse_grid, coords, origin, num_interior);
+
+    found = 0;
+    for (k = 0; (k < num_interior[2]) && !found; k++) {
+      for (j = 0; (j < num_interior[1]) && !found; j++) {
+        for (i = 0; i < num_interior[0]; i++) {
+          if (fabs(data[i + j*nx + k*nxy]) < width) {
+            found = 1;
+            break;
+          }
+        }
+      }
+    }
+
+    if (found) {
+      sparse_grid->brick_flags[
+        SPARSE_GRID_TABLE_IDX(sparse_grid, coords[0], coords[1], coords[2])]
+        = 1;
+    }
+  }
+
+  /* flag all neighbors of bricks containing the narrow band as needed */
+  for (brick_idx = 0; brick_idx < sparse_grid->num_active_bricks;
+       brick_idx++) {
+    coords = sparse_grid->brick_coords + 3*brick_idx;
+    t = SPARSE_GRID_TABLE_IDX(sparse_grid, coords[0], coords[1], coords[2]);
+    if (!(sparse_grid->brick_flags[t] & 1)) continue;
+
+    for (dk = dk_lo; dk <= dk_hi; dk++) {
+      for (dj = -1; dj <= 1; dj++) {
+        for (di = -1; di <= 1; di++) {
+          if ( (coords[0]+di < 0) || (coords[0]+di >= nb[0])
+            || (coords[1]+dj < 0) || (coords[1]+dj >= nb[1])
+            || (coords[2]+dk < 0) || (coords[2]+dk >= nb[2]) ) continue;
+          sparse_grid->brick_flags[ SPARSE_GRID_TABLE_IDX(sparse_grid,
+            coords[0]+di, coords[1]+dj, coords[2]+dk) ] |= 2;
+        }
+      }
+    }
+  }
+
+  /* deactivate bricks that are no longer needed                 */
+  /* NOTE: looping backwards ensures that the brick moved into the */
+  /*       storage of a deactivated brick has already been checked */
+  for (brick_idx = sparse_grid->num_active_bricks-1; brick_idx >= 0;
+       brick_idx--) {
+    coords = sparse_grid->brick_coords + 3*brick_idx;
+    t = SPARSE_GRID_TABLE_IDX(sparse_grid, coords[0], coords[1], coords[2]);
+    if (!(sparse_grid->brick_flags[t] & 2)) {
+      deactivateSparseGridBrick(sparse_grid, brick_idx);
+      num_changed++;
+    }
+  }
+
+  /* activate needed bricks */
+  for (t = 0; t < num_table_entries; t++) {
+    if ( !(sparse_grid->brick_flags[t] & 2)
+      || (sparse_grid->brick_table[t] >= 0) ) continue;
+
+    coords = new_coords;
+    coords[0] = t % nb[0];
+    coords[1] = (t / nb[0]) % nb[1];
+    coords[2] = t / (nb[0]*nb[1]);
+    for (dim = 0; dim < 3; dim++) {
+      origin[dim] = sparse_grid->fillbox_lo[dim] + coords[dim]*extent[dim];
+    }
+    brick_idx = activateSparseGridBrick(sparse_grid,
+                                        coords[0], coords[1], coords[2]);
+    num_changed++;
+
+    if (!sparse_grid->signed_background[phi_field]) continue;
+
+    /* extrapolate level set function from the neighboring bricks that */
+    /* contain the narrow band (using the smallest extrapolated value)   */
+    data = SPARSE_GRID_BRICK_DATA(sparse_grid, phi_field, brick_idx);
+    num_nbrs = 0;
+    for (dk = dk_lo; dk <= dk_hi; dk++) {
+      for (dj = -1; dj <= 1; dj++) {
+        for (di = -1; di <= 1; di++) {
+          if ( (coords[0]+di < 0) || (coords[0]+di >= nb[0])
+            || (coords[1]+dj < 0) || (coords[1]+dj >= nb[1])
+            || (coords[2]+dk < 0) || (coords[2]+dk >= nb[2]) ) continue;
+          nbr_t = SPARSE_GRID_TABLE_IDX(sparse_grid,
+            coords[0]+di, coords[1]+dj, coords[2]+dk);
+          if (!(sparse_grid->brick_flags[nbr_t] & 1)) continue;
+
+          nbr_data = SPARSE_GRID_BRICK_DATA(sparse_grid, phi_field,
+                                            sparse_grid->brick_table[nbr_t]);
+          computeSparseGridBrickInterior(sparse_grid,
+            sparse_grid->brick_coords + 3*sparse_grid->brick_table[nbr_t],
+            nbr_origin, num_interior);
+          for (dim = 0; dim < 3; dim++) {
+            int_hi[dim] = num_interior[dim] - 1;
+          }
+
+          for (k = 0; k < extent[2]; k++) {
+            offset[2] = origin[2] - nbr_origin[2] + k;
+            kk = SPARSE_GRID_CLAMP(offset[2], 0, int_hi[2]);
+            for (j = 0; j < extent[1]; j++) {
+              offset[1] = origin[1] - nbr_origin[1] + j;
+              jj = SPARSE_GRID_CLAMP(offset[1], 0, int_hi[1]);
+              for (i = 0; i < extent[0]; i++) {
+                offset[0] = origin[0] - nbr_origin[0] + i;
+                ii = SPARSE_GRID_CLAMP(offset[0], 0, int_hi[0]);
+
+                value = nbr_data[ii + jj*nx + kk*nxy];
+                dist = fabs(value) + sqrt(
+                    (offset[0]-ii)*(offset[0]-ii)*grid->dx[0]*grid->dx[0]
+                  + (offset[1]-jj)*(offset[1]-jj)*grid->dx[1]*grid->dx[1]
+                  + (offset[2]-kk)*(offset[2]-kk)*grid->dx[2]*grid->dx[2]);
+                idx = i + j*nx + k*nxy;
+                if ( (num_nbrs == 0) || (dist < fabs(data[idx])) ) {
+                  data[idx] = SPARSE_GRID_SIGNED_VALUE(dist, value);
+                }
+              }
+            }
+          }
+          num_nbrs++;
+        }
+      }
+    }
+  }
+
+  for (t = 0; t < num_table_entries; t++) {
+    sparse_grid->brick_flags[t] = 0;
+  }
+
+  return num_changed;
+}
+
+
+void printSparseGrid(LSM_SparseGrid *sparse_grid, FILE *fp)
+{
+  int *nb = sparse_grid->num_bricks;
+  double brick_bytes =
+    (double) sparse_grid->num_brick_gridpts*sizeof(LSMLIB_REAL);
+  double dense_bytes =
+    (double) sparse_grid->grid->num_gridpts*sizeof(LSMLIB_REAL);
+
+  fprintf(fp, "Brick size: %d (%d x %d x %d ghostbox)\n",
+          sparse_grid->brick_size,
+          sparse_grid->brick_dims_ghostbox[0],
+          sparse_grid->brick_dims_ghostbox[1],
+          sparse_grid->brick_dims_ghostbox[2]);
+  fprintf(fp, "Number of bricks: %d x %d x %d\n", nb[0], nb[1], nb[2]);
+  fprintf(fp, "Active bricks: %d of %d (%d allocated)\n",
+          sparse_grid->num_active_bricks, nb[0]*nb[1]*nb[2],
+          sparse_grid->num_alloc_bricks);
+  fprintf(fp, "Memory per field: %g MB (dense grid: %g MB)\n",
+          sparse_grid->num_alloc_bricks*brick_bytes/1048576.0,
+          dense_bytes/1048576.0);
+}
+
+
+/*============= Helper functions for sparse grid manipulation =============*/
+
+static void growSparseGridStorage(LSM_SparseGrid *sparse_grid,
+                                  int num_bricks)
+{
+  int num_alloc = 2*sparse_grid->num_alloc_bricks;
+  int field;
+
+  if (num_alloc < 16) num_alloc = 16;
+  if (num_alloc < num_bricks) num_alloc = num_bricks;
+
+  sparse_grid->brick_coords = (int *)realloc(sparse_grid->brick_coords,
+                                             3*num_alloc*sizeof(int));
+  for (field = 0; field < sparse_grid->num_fields; field++) {
+    sparse_grid->field_data[field] = (LSMLIB_REAL *)realloc(
+      sparse_grid->field_data[field],
+      ((size_t) num_alloc)*sparse_grid->num_brick_gridpts*sizeof(LSMLIB_REAL));
+    if (!sparse_grid->field_data[field]) {
+      fprintf(stderr, "\nUnable to allocate memory for %d bricks.\n",
+              num_alloc);
+      exit(1);
+    }
+  }
+  sparse_grid->num_alloc_bricks = num_alloc;
+}
+
+
+static LSMLIB_REAL getSparseGridValue(LSM_SparseGrid *sparse_grid,
+                                      int field, int i, int j, int k,
+                                      LSMLIB_REAL sign_value)
+{
+  int *extent = sparse_grid->brick_extent;
+  int *fb_lo = sparse_grid->fillbox_lo;
+  int *fb_hi = sparse_grid->fillbox_hi;
+  int bi, bj, bk, brick_idx;
+  LSMLIB_REAL background;
+
+  /* copy extrapolation for grid cells outside of the fillbox */
+  i = SPARSE_GRID_CLAMP(i, fb_lo[0], fb_hi[0]);
+  j = SPARSE_GRID_CLAMP(j, fb_lo[1], fb_hi[1]);
+  k = SPARSE_GRID_CLAMP(k, fb_lo[2], fb_hi[2]);
+
+  bi = (i - fb_lo[0])/extent[0];
+  bj = (j - fb_lo[1])/extent[1];
+  bk = (k - fb_lo[2])/extent[2];
+  brick_idx = sparse_grid->brick_table[
+    SPARSE_GRID_TABLE_IDX(sparse_grid, bi, bj, bk)];
+
+  if (brick_idx < 0) {
+    background = sparse_grid->background_value[field];
+    if (sparse_grid->signed_background[field]) {
+      return SPARSE_GRID_SIGNED_VALUE(background, sign_value);
+    }
+    return background;
+  }
+
+  return SPARSE_GRID_BRICK_DATA(sparse_grid, field, brick_idx)[
+      (i - fb_lo[0] - bi*extent[0])
+    + (j - fb_lo[1] - bj*extent[1])*extent[0]
+    + (k - fb_lo[2] - bk*extent[2])*extent[0]*extent[1] ];
+}
+
+
+static void computeSparseGridBrickInterior(LSM_SparseGrid *sparse_grid,
+                                           const int *coords,
+                                           int *origin,
+                                           int *num_interior)
+{
+  int dim;
+
+  for (dim = 0; dim < 3; dim++) {
+    origin[dim] = sparse_grid->fillbox_lo[dim]
+                + coords[dim]*sparse_grid->brick_extent[dim];
+    num_interior[dim] = sparse_grid->fillbox_hi[dim] - origin[dim] + 1;
+    if (num_interior[dim] > sparse_grid->brick_extent[dim]) {
+      num_interior[dim] = sparse_grid->brick_extent[dim];
+    }
+  }
+}
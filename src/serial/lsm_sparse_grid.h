@@ -0,0 +1,515 @@
+/*
+ * File:        lsm_sparse_grid.h
+ * Copyrights:  (c) 2005 The Trustees of Princeton University and Board of
+ *                  Regents of the University of Texas.  All rights reserved.
+ *              (c) 2009 Kevin T. Chu.  All rights reserved.
+ * Revision:    $Revision$
+ * Modified:    $Date$
+ * Description: Header file for sparse brick storage of data arrays
+ *              for narrow band serial LSMLIB calculations
+ */
+
+#ifndef included_lsm_sparse_grid_h
+#define included_lsm_sparse_grid_h
+
+#include <stdio.h>
+#include "LSMLIB_config.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+
+/*! \file lsm_sparse_grid.h
+ *
+ * \brief
+ * @ref lsm_sparse_grid.h provides sparse storage for data arrays in
+ * narrow band level set method calculations.
+ *
+ * The fillbox of the computational grid is divided into cubic bricks
+ * (squares in 2D) of brick_size^3 grid cells.  Memory is allocated only
+ * for "active" bricks (i.e. bricks that lie near the zero level set), so
+ * the storage required scales with the size of the narrow band rather
+ * than the size of the grid.
+ *
+ * Only the interior of each brick is stored.  To apply a kernel to a
+ * brick, the brick data together with its ghostcells is gathered into
+ * a small dense scratch array (the "brick ghostbox") using 
+ * getSparseGridBrickData().  A Grid structure describing the brick 
+ * ghostbox can be obtained from fillSparseGridBrickGrid(), so the 
+ * existing LSMLIB toolbox kernels (both the full grid and the _LOCAL
+ * versions) and serial functions can be applied brick by brick without
+ * modification.  Results are copied back to the brick interior using
+ * setSparseGridBrickData().
+ *
+ * Typical usage:
+ *  -# create the sparse grid with createSparseGrid()
+ *  -# activate bricks near the zero level set (e.g. with
+ *     activateSparseGridBricksFromDenseData() or activateSparseGridBrick())
+ *     and set the initial data on each brick
+ *  -# each time step: loop over the active bricks; for each brick,
+ *     gather the input fields into brick ghostbox arrays using
+ *     getSparseGridBrickData(), apply the toolbox kernels using the 
+ *     brick Grid and store the result in a different field (e.g. 
+ *     phi_next) using setSparseGridBrickData()
+ *  -# periodically call updateSparseGridActiveBricks() to follow the
+ *     motion of the zero level set
+ *
+ * The brick ghostbox arrays and the scratch arrays that do not need to
+ * persist between bricks (e.g. D1, the spatial derivatives and the 
+ * narrow band arrays used by the _LOCAL kernels) should be allocated 
+ * only once at the size of a single brick ghostbox (e.g. by calling 
+ * allocateMemoryForLSMDataArrays() with a brick Grid) and reused for 
+ * every brick.
+ *
+ */
+
+#include "lsm_grid.h"
+
+
+/*!
+ * Structure 'LSM_SparseGrid' stores the brick layout and the data
+ * for each field stored on the sparse grid.
+ *
+ * NOTES:
+ * - Brick (bi,bj,bk) covers the grid cells with indices
+ *   ilo_fb + bi*brick_size <= i < ilo_fb + (bi+1)*brick_size (and
+ *   similarly for j and k), where ilo_fb is the lower fillbox index
+ *   of the full Grid.
+ *
+ * - The interior data for brick b of field f is stored contiguously
+ *   starting at field_data[f] + b*num_brick_gridpts in the same (i 
+ *   fastest) order as the full grid data arrays.  The ghostcells of 
+ *   a brick are not stored.
+ *
+ * - The field data pointers may change when bricks are activated
+ *   (because the brick storage may be reallocated), so pointers to
+ *   brick data should be retrieved again after bricks are activated.
+ *
+ */
+typedef struct _LSM_SparseGrid
+{
+  /* the (full) grid covered by the sparse grid (not owned) */
+  Grid *grid;
+
+  /* number of grid cells along each edge of a brick */
+  int brick_size;
+
+  /* number of grid cells along each edge of a brick in each coordinate */
+  /* direction (equal to brick_size except in the k-direction for 2D)  */
+  int brick_extent[3];
+
+  /* index space for the fillbox of the grid (i.e. the region covered */
+  /* by the interiors of the bricks)                                   */
+  int fillbox_lo[3], fillbox_hi[3];
+
+  /* number of ghostcells at the lower and upper side of each brick */
+  int ghostcell_width_lo[3], ghostcell_width_hi[3];
+
+  /* dimensions of a brick INCLUDING ghostcells (i.e. of the brick */
+  /* ghostbox arrays filled by getSparseGridBrickData())           */
+  int brick_dims_ghostbox[3];
+
+  /* number of grid points stored for each brick (i.e. EXCLUDING */
+  /* ghostcells)                                                  */
+  int num_brick_gridpts;
+
+  /* number of grid points in a brick INCLUDING ghostcells */
+  int num_brick_ghostbox_gridpts;
+
+  /* number of bricks in each coordinate direction */
+  int num_bricks[3];
+
+  /* brick_table[bi + bj*num_bricks[0] + bk*num_bricks[0]*num_bricks[1]] */
+  /* is the index of brick (bi,bj,bk) or -1 if the brick is inactive    */
+  int *brick_table;
+
+  /* brick coordinates (bi,bj,bk) of each active brick */
+  int *brick_coords;
+
+  /* number of active bricks and number of bricks allocated */
+  int num_active_bricks, num_alloc_bricks;
+
+  /* data for each field */
+  int           num_fields;
+  LSMLIB_REAL **field_data;
+
+  /* background value for each field (used for inactive bricks) */
+  LSMLIB_REAL  *background_value;
+
+  /* flag indicating whether the sign of the background value should */
+  /* be taken from the neighboring data (e.g. for level set functions) */
+  int          *signed_background;
+
+  /* scratch space used when updating the active bricks */
+  unsigned char *brick_flags;
+
+} LSM_SparseGrid;
+
+
+/*!
+ * SPARSE_GRID_BRICK_DATA() returns a pointer to the interior data for
+ * the specified brick and field.
+ *
+ * Arguments:
+ *  - sparse_grid (in):  pointer to LSM_SparseGrid
+ *  - field (in):        field index
+ *  - brick_idx (in):    brick index
+ *
+ */
+#define SPARSE_GRID_BRICK_DATA(sparse_grid, field, brick_idx)              \
+  ( (sparse_grid)->field_data[(field)]                                     \
+  + (brick_idx)*(sparse_grid)->num_brick_gridpts )
+
+
+/*! @{
+ ****************************************************************
+ *
+ * @name Sparse grid management functions
+ *
+ ****************************************************************/
+
+/*!
+ * createSparseGrid() allocates a LSM_SparseGrid data structure that
+ * covers the specified grid.  Initially, no bricks are active.
+ *
+ * Arguments:
+ *  - grid (in):        pointer to Grid
+ *  - brick_size (in):  number of grid cells along each edge of a brick
+ *  - num_fields (in):  number of fields to store on the sparse grid
+ *
+ * Return value:        pointer to the newly created LSM_SparseGrid
+ *                      structure (NULL if brick_size is smaller than the
+ *                      number of ghostcells)
+ *
+ * NOTES:
+ * - The grid is not copied, so it must not be destroyed before the
+ *   sparse grid.
+ *
+ * - brick_size must be at least as large as the number of ghostcells
+ *   of the grid.  Larger bricks reduce the relative cost of gathering
+ *   the ghostcells of each brick but increase the number of grid 
+ *   points stored away from the zero level set, so brick sizes of 8 
+ *   to 16 are recommended for typical narrow band widths.
+ *
+ * - The background value of all fields is initially set to zero
+ *   (unsigned).
+ *
+ */
+LSM_SparseGrid *createSparseGrid(
+  Grid *grid,
+  int brick_size,
+  int num_fields);
+
+
+/*!
+ * destroySparseGrid() frees ALL memory allocated for the sparse grid
+ * (but not the Grid that it covers).
+ *
+ * Arguments:
+ *  - sparse_grid (in):  pointer to LSM_SparseGrid
+ *
+ * Return value:         none
+ *
+ */
+void destroySparseGrid(LSM_SparseGrid *sparse_grid);
+
+
+/*!
+ * setSparseGridBackgroundValue() sets the value used for grid cells
+ * that are not covered by an active brick.
+ *
+ * Arguments:
+ *  - sparse_grid (in/out):    pointer to LSM_SparseGrid
+ *  - field (in):              field index
+ *  - background_value (in):   background value
+ *  - signed_background (in):  1 if the sign of the background value
+ *                             should be taken from the nearest data
+ *                             on an active brick (e.g. for level set
+ *                             functions); 0 otherwise
+ *
+ * Return value:               none
+ *
+ * NOTES:
+ * - For level set functions, the background value should be larger
+ *   than the narrow band width (e.g. grid->gamma).
+ *
+ */
+void setSparseGridBackgroundValue(
+  LSM_SparseGrid *sparse_grid,
+  int field,
+  LSMLIB_REAL background_value,
+  int signed_background);
+
+
+/*!
+ * activateSparseGridBrick() activates brick (bi,bj,bk).  The data for
+ * a newly activated brick is set to the background value of each field.
+ *
+ * Arguments:
+ *  - sparse_grid (in/out):  pointer to LSM_SparseGrid
+ *  - bi, bj, bk (in):       brick coordinates
+ *
+ * Return value:             index of brick (-1 if the brick coordinates
+ *                           are out of range)
+ *
+ * NOTES:
+ * - If the brick is already active, its data is not modified.
+ *
+ * - The field data pointers may change when a brick is activated.
+ *
+ */
+int activateSparseGridBrick(
+  LSM_SparseGrid *sparse_grid,
+  int bi, int bj, int bk);
+
+
+/*!
+ * deactivateSparseGridBrick() deactivates the specified brick and
+ * releases its storage for reuse.
+ *
+ * Arguments:
+ *  - sparse_grid (in/out):  pointer to LSM_SparseGrid
+ *  - brick_idx (in):        index of brick
+ *
+ * Return value:             none
+ *
+ * NOTES:
+ * - The last active brick is moved into the storage of the deactivated
+ *   brick, so the index of the last active brick changes.
+ *
+ */
+void deactivateSparseGridBrick(
+  LSM_SparseGrid *sparse_grid,
+  int brick_idx);
+
+
+/*!
+ * fillSparseGridBrickGrid() sets the elements of a Grid structure so
+ * that it describes a single brick (including its ghostcells).
+ * The brick Grid may be passed to any function or toolbox kernel that
+ * operates on data arrays defined on a Grid (e.g. the brick ghostbox
+ * arrays filled by getSparseGridBrickData()).
+ *
+ * Arguments:
+ *  - sparse_grid (in):  pointer to LSM_SparseGrid
+ *  - brick_idx (in):    index of brick
+ *  - brick_grid (out):  pointer to Grid to fill
+ *
+ * Return value:         none
+ *
+ * NOTES:
+ * - brick_grid is assumed to be allocated by the user (e.g. as a
+ *   local Grid variable).
+ *
+ * - The fillbox of a brick at the upper boundary of the computational
+ *   domain is truncated so that it does not extend beyond the fillbox
+ *   of the full grid.
+ *
+ * - The spacing between the fillbox and ghostbox (as well as the D1,
+ *   D2, D3 fillboxes) of the brick Grid are the same as for the full
+ *   grid.
+ *
+ */
+void fillSparseGridBrickGrid(
+  LSM_SparseGrid *sparse_grid,
+  int brick_idx,
+  Grid *brick_grid);
+
+/*! @} */
+
+
+/*! @{
+ ****************************************************************
+ *
+ * @name Sparse grid data functions
+ *
+ ****************************************************************/
+
+/*!
+ * getSparseGridBrickData() gathers the data for a single brick 
+ * (including its ghostcells) into a brick ghostbox array.
+ *
+ * Arguments:
+ *  - sparse_grid (in):  pointer to LSM_SparseGrid
+ *  - field (in):        field index
+ *  - brick_idx (in):    index of brick
+ *  - brick_data (out):  brick ghostbox array of size 
+ *                       num_brick_ghostbox_gridpts
+ *
+ * Return value:         none
+ *
+ * NOTES:
+ * - Ghostcells that lie in the interior of the computational domain
+ *   are copied from neighboring active bricks.  Ghostcells covered by
+ *   inactive bricks are set to the background value of the field 
+ *   (with the sign of the nearest grid cell in the brick if the 
+ *   background value is signed).
+ *
+ * - Ghostcells outside of the computational domain are filled by
+ *   copying the value of the nearest grid cell in the domain (i.e.
+ *   copy extrapolation).  Other boundary conditions may be imposed
+ *   afterwards by applying the functions in lsm_boundary_conditions.h
+ *   to bricks at the boundary of the domain with their brick Grid.
+ *
+ */
+void getSparseGridBrickData(
+  LSM_SparseGrid *sparse_grid,
+  int field,
+  int brick_idx,
+  LSMLIB_REAL *brick_data);
+
+
+/*!
+ * setSparseGridBrickData() copies the interior of a brick ghostbox 
+ * array to the storage for a single brick.
+ *
+ * Arguments:
+ *  - sparse_grid (in/out):  pointer to LSM_SparseGrid
+ *  - field (in):            field index
+ *  - brick_idx (in):        index of brick
+ *  - brick_data (in):       brick ghostbox array of size 
+ *                           num_brick_ghostbox_gridpts
+ *
+ * Return value:             none
+ *
+ * NOTES:
+ * - Because the ghostcells of a brick are gathered from the interiors
+ *   of its neighbors, the result of a time step should be stored in a
+ *   different field than its input until all bricks have been 
+ *   processed.
+ *
+ */
+void setSparseGridBrickData(
+  LSM_SparseGrid *sparse_grid,
+  int field,
+  int brick_idx,
+  const LSMLIB_REAL *brick_data);
+
+
+/*!
+ * activateSparseGridBricksFromDenseData() activates all bricks that
+ * contain a grid cell in the fillbox where |data| < width, together
+ * with their neighboring bricks.  The data is then copied to the
+ * active bricks.
+ *
+ * Arguments:
+ *  - sparse_grid (in/out):  pointer to LSM_SparseGrid
+ *  - field (in):            field index
+ *  - data (in):             data array of size (grid->num_gridpts)
+ *  - width (in):            narrow band width
+ *
+ * Return value:             number of active bricks
+ *
+ */
+int activateSparseGridBricksFromDenseData(
+  LSM_SparseGrid *sparse_grid,
+  int field,
+  LSMLIB_REAL *data,
+  LSMLIB_REAL width);
+
+
+/*!
+ * copyDenseDataToSparseGrid() copies data from a full grid data array
+ * to the interiors of all active bricks.
+ *
+ * Arguments:
+ *  - sparse_grid (in/out):  pointer to LSM_SparseGrid
+ *  - field (in):            field index
+ *  - data (in):             data array of size (grid->num_gridpts)
+ *
+ * Return value:             none
+ *
+ * NOTES:
+ * - Grid cells in the interior of a brick at the upper boundary of the
+ *   computational domain that lie outside of the ghostbox of the full 
+ *   grid are set by copying the value of the nearest grid cell in the
+ *   ghostbox.
+ *
+ */
+void copyDenseDataToSparseGrid(
+  LSM_SparseGrid *sparse_grid,
+  int field,
+  LSMLIB_REAL *data);
+
+
+/*!
+ * copySparseGridToDenseData() copies the fillbox data from the active
+ * bricks to a full grid data array.  Grid cells that are not covered
+ * by an active brick are set to the background value.
+ *
+ * Arguments:
+ *  - sparse_grid (in):  pointer to LSM_SparseGrid
+ *  - field (in):        field index
+ *  - data (out):        data array of size (grid->num_gridpts)
+ *
+ * Return value:         none
+ *
+ * NOTES:
+ * - The ghostcells of the full grid are NOT set.
+ *
+ * - If the background value is signed, the sign of the data in an
+ *   inactive brick is taken from the nearest grid cell in an active
+ *   brick along the i-direction (or positive if there is none).
+ *
+ */
+void copySparseGridToDenseData(
+  LSM_SparseGrid *sparse_grid,
+  int field,
+  LSMLIB_REAL *data);
+
+
+/*!
+ * updateSparseGridActiveBricks() updates the set of active bricks to
+ * follow the motion of the zero level set.  Bricks that contain a grid
+ * cell in their fillbox where |phi| < width and all of their
+ * neighbors are activated.  All other bricks are deactivated.
+ *
+ * Arguments:
+ *  - sparse_grid (in/out):  pointer to LSM_SparseGrid
+ *  - phi_field (in):        field index of level set function
+ *  - width (in):            narrow band width
+ *
+ * Return value:             number of bricks activated or deactivated
+ *
+ * NOTES:
+ * - If the level set function field has a signed background value, the
+ *   level set function in newly activated bricks is initialized by
+ *   extrapolating the data in a neighboring brick:
+ *   phi = sign(phi_nbr) * (|phi_nbr| + distance), where phi_nbr is the
+ *   value in the nearest grid cell of the neighboring brick.  The level
+ *   set function should be reinitialized after new bricks are 
+ *   activated.  All other fields are set to their background value.
+ *
+ * - Since the zero level set moves at most one grid cell per time step,
+ *   calling updateSparseGridActiveBricks() every few time steps is
+ *   sufficient as long as width is at least a few grid cells smaller
+ *   than brick_size.
+ *
+ */
+int updateSparseGridActiveBricks(
+  LSM_SparseGrid *sparse_grid,
+  int phi_field,
+  LSMLIB_REAL width);
+
+
+/*!
+ * printSparseGrid() prints the brick layout and memory usage of the
+ * sparse grid.
+ *
+ * Arguments:
+ *  - sparse_grid (in):  pointer to LSM_SparseGrid
+ *  - fp (in):           FILE pointer for output
+ *
+ * Return value:         none
+ *
+ */
+void printSparseGrid(LSM_SparseGrid *sparse_grid, FILE *fp);
+
+/*! @} */
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
@@ -0,0 +1,756 @@
+/*
+ * File:        lsm_triangle_mesh.c
+ * Copyrights:  (c) 2005 The Trustees of Princeton University and Board of
+ *                  Regents of the University of Texas.  All rights reserved.
+ *              (c) 2009 Kevin T. Chu.  All rights reserved.
+ * Revision:    $Revision$
+ * Modified:    $Date$
+ * Description: Implementation file for triangle mesh data structures and
+ *              closest point queries
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include <float.h>
+
+#include "lsm_triangle_mesh.h"
+
+/* maximum number of triangles in a leaf node of the BVH */
+#define LSM_TRIANGLE_MESH_BVH_LEAF_SIZE     (4)
+
+/* maximum depth of the BVH (the BVH is balanced, so this is */
+/* far larger than required for any mesh that fits in memory) */
+#define LSM_TRIANGLE_MESH_BVH_MAX_DEPTH     (128)
+
+/* codes for the feature of a triangle that contains the closest point */
+#define LSM_TRIANGLE_MESH_FACE              (0)
+#define LSM_TRIANGLE_MESH_VERTEX0           (1)
+#define LSM_TRIANGLE_MESH_VERTEX1           (2)
+#define LSM_TRIANGLE_MESH_VERTEX2           (3)
+#define LSM_TRIANGLE_MESH_EDGE01            (4)
+#define LSM_TRIANGLE_MESH_EDGE12            (5)
+#define LSM_TRIANGLE_MESH_EDGE20            (6)
+
+
+/*========================= Helper Data Structures ========================*/
+
+/* vertex used for merging vertices with identical coordinates */
+typedef struct {
+  LSMLIB_REAL x[3];
+  int raw_idx;
+} WeldVertex;
+
+/* triangle edge used for computing edge pseudonormals */
+typedef struct {
+  int v_lo, v_hi;
+  int tri_edge;     /* 3*triangle + local edge number */
+} MeshEdge;
+
+/* sort key used for building the BVH */
+typedef struct {
+  LSMLIB_REAL key;
+  int tri;
+} SortKey;
+
+
+/*========================= Helper Functions ==============================*/
+
+static TriangleMesh *allocateTriangleMesh(void)
+{
+  TriangleMesh *mesh = (TriangleMesh*) malloc(sizeof(TriangleMesh));
+  mesh->num_vertices = 0;
+  mesh->vertices = NULL;
+  mesh->num_triangles = 0;
+  mesh->triangles = NULL;
+  mesh->num_bvh_nodes = 0;
+  mesh->bvh_nodes = NULL;
+  mesh->bvh_triangles = NULL;
+  mesh->face_normals = NULL;
+  mesh->edge_normals = NULL;
+  mesh->vertex_normals = NULL;
+  return mesh;
+}
+
+static void freeTriangleMeshBVH(TriangleMesh *mesh)
+{
+  free(mesh->bvh_nodes);
+  free(mesh->bvh_triangles);
+  free(mesh->face_normals);
+  free(mesh->edge_normals);
+  free(mesh->vertex_normals);
+  mesh->num_bvh_nodes = 0;
+  mesh->bvh_nodes = NULL;
+  mesh->bvh_triangles = NULL;
+  mesh->face_normals = NULL;
+  mesh->edge_normals = NULL;
+  mesh->vertex_normals = NULL;
+}
+
+static int compareWeldVertices(const void *a, const void *b)
+{
+  const WeldVertex *va = (const WeldVertex*) a;
+  const WeldVertex *vb = (const WeldVertex*) b;
+  int i;
+  for (i = 0; i < 3; i++) {
+    if (va->x[i] < vb->x[i]) return -1;
+    if (va->x[i] > vb->x[i]) return 1;
+  }
+  return 0;
+}
+
+static int compareMeshEdges(const void *a, const void *b)
+{
+  const MeshEdge *ea = (const MeshEdge*) a;
+  const MeshEdge *eb = (const MeshEdge*) b;
+  if (ea->v_lo != eb->v_lo) return (ea->v_lo < eb->v_lo) ? -1 : 1;
+  if (ea->v_hi != eb->v_hi) return (ea->v_hi < eb->v_hi) ? -1 : 1;
+  return 0;
+}
+
+static int compareSortKeys(const void *a, const void *b)
+{
+  const SortKey *ka = (const SortKey*) a;
+  const SortKey *kb = (const SortKey*) b;
+  if (ka->key < kb->key) return -1;
+  if (ka->key > kb->key) return 1;
+  return (ka->tri < kb->tri) ? -1 : ((ka->tri > kb->tri) ? 1 : 0);
+}
+
+/*
+ * createWeldedTriangleMesh() creates a TriangleMesh from the coordinates
+ * of the three vertices of each triangle (9 values per triangle) by
+ * merging vertices with identical coordinates.
+ */
+static TriangleMesh *createWeldedTriangleMesh(
+  int num_triangles,
+  LSMLIB_REAL *triangle_coords)
+{
+  TriangleMesh *mesh;
+  WeldVertex *weld;
+  int num_raw = 3*num_triangles;
+  int i, d;
+
+  mesh = allocateTriangleMesh();
+  mesh->num_triangles = num_triangles;
+  mesh->triangles = (int*) malloc(num_raw*sizeof(int));
+  mesh->vertices = (LSMLIB_REAL*) malloc(3*num_raw*sizeof(LSMLIB_REAL));
+
+  weld = (WeldVertex*) malloc(num_raw*sizeof(WeldVertex));
+  for (i = 0; i < num_raw; i++) {
+    for (d = 0; d < 3; d++) weld[i].x[d] = triangle_coords[3*i+d];
+    weld[i].raw_idx = i;
+  }
+  qsort(weld, num_raw, sizeof(WeldVertex), compareWeldVertices);
+
+  mesh->num_vertices = 0;
+  for (i = 0; i < num_raw; i++) {
+    if ( (i == 0) || compareWeldVertices(&weld[i-1], &weld[i]) ) {
+      for (d = 0; d < 3; d++) {
+        mesh->vertices[3*mesh->num_vertices+d] = weld[i].x[d];
+      }
+      mesh->num_vertices++;
+    }
+    mesh->triangles[weld[i].raw_idx] = mesh->num_vertices-1;
+  }
+  mesh->vertices = (LSMLIB_REAL*) realloc(mesh->vertices,
+    3*(mesh->num_vertices > 0 ? mesh->num_vertices : 1)*sizeof(LSMLIB_REAL));
+
+  free(weld);
+  return mesh;
+}
+
+/*
+ * closestPointOnTriangle() computes the point q on triangle (a,b,c)
+ * closest to p and returns the squared distance from p to q.  feature
+ * is set to the code for the feature (face, edge or vertex) of the
+ * triangle that contains q.  (See C. Ericson, "Real-Time Collision
+ * Detection", 2005, Section 5.1.5.)
+ */
+static LSMLIB_REAL closestPointOnTriangle(
+  LSMLIB_REAL *q,
+  int *feature,
+  const LSMLIB_REAL *p,
+  const LSMLIB_REAL *a,
+  const LSMLIB_REAL *b,
+  const LSMLIB_REAL *c)
+{
+  LSMLIB_REAL ab[3], ac[3], ap[3], bp[3], cp[3];
+  LSMLIB_REAL d1, d2, d3, d4, d5, d6, va, vb, vc, v, w, denom;
+  LSMLIB_REAL dist_sq;
+  int i;
+
+  for (i = 0; i < 3; i++) {
+    ab[i] = b[i] - a[i];
+    ac[i] = c[i] - a[i];
+    ap[i] = p[i] - a[i];
+    bp[i] = p[i] - b[i];
+    cp[i] = p[i] - c[i];
+  }
+
+  d1 = ab[0]*ap[0] + ab[1]*ap[1] + ab[2]*ap[2];
+  d2 = ac[0]*ap[0] + ac[1]*ap[1] + ac[2]*ap[2];
+  d3 = ab[0]*bp[0] + ab[1]*bp[1] + ab[2]*bp[2];
+  d4 = ac[0]*bp[0] + ac[1]*bp[1] + ac[2]*bp[2];
+  d5 = ab[0]*cp[0] + ab[1]*cp[1] + ab[2]*cp[2];
+  d6 = ac[0]*cp[0] + ac[1]*cp[1] + ac[2]*cp[2];
+  vc = d1*d4 - d3*d2;
+  vb = d5*d2 - d1*d6;
+  va = d3*d6 - d5*d4;
+
+  if ( (d1 <= 0) && (d2 <= 0) ) {
+    for (i = 0; i < 3; i++) q[i] = a[i];
+    *feature = LSM_TRIANGLE_MESH_VERTEX0;
+  } else if ( (d3 >= 0) && (d4 <= d3) ) {
+    for (i = 0; i < 3; i++) q[i] = b[i];
+    *feature = LSM_TRIANGLE_MESH_VERTEX1;
+  } else if ( (d6 >= 0) && (d5 <= d6) ) {
+    for (i = 0; i < 3; i++) q[i] = c[i];
+    *feature = LSM_TRIANGLE_MESH_VERTEX2;
+  } else if ( (vc <= 0) && (d1 >= 0) && (d3 <= 0) ) {
+    v = d1/(d1 - d3);
+    for (i = 0; i < 3; i++) q[i] = a[i] + v*ab[i];
+    *feature = LSM_TRIANGLE_MESH_EDGE01;
+  } else if ( (vb <= 0) && (d2 >= 0) && (d6 <= 0) ) {
+    w = d2/(d2 - d6);
+    for (i = 0; i < 3; i++) q[i] = a[i] + w*ac[i];
+    *feature = LSM_TRIANGLE_MESH_EDGE20;
+  } else if ( (va <= 0) && ((d4 - d3) >= 0) && ((d5 - d6) >= 0) ) {
+    w = (d4 - d3)/((d4 - d3) + (d5 - d6));
+    for (i = 0; i < 3; i++) q[i] = b[i] + w*(c[i] - b[i]);
+    *feature = LSM_TRIANGLE_MESH_EDGE12;
+  } else {
+    denom = 1.0/(va + vb + vc);
+    v = vb*denom;
+    w = vc*denom;
+    for (i = 0; i < 3; i++) q[i] = a[i] + ab[i]*v + ac[i]*w;
+    *feature = LSM_TRIANGLE_MESH_FACE;
+  }
+
+  dist_sq = 0;
+  for (i = 0; i < 3; i++) dist_sq += (p[i] - q[i])*(p[i] - q[i]);
+  return dist_sq;
+}
+
+/*
+ * boxDistanceSquared() computes the squared distance from p to the
+ * axis-aligned box [lo,hi].
+ */
+static LSMLIB_REAL boxDistanceSquared(
+  const LSMLIB_REAL *p,
+  const LSMLIB_REAL *lo,
+  const LSMLIB_REAL *hi)
+{
+  LSMLIB_REAL dist_sq = 0, delta;
+  int i;
+  for (i = 0; i < 3; i++) {
+    if (p[i] < lo[i]) {
+      delta = lo[i] - p[i];
+      dist_sq += delta*delta;
+    } else if (p[i] > hi[i]) {
+      delta = p[i] - hi[i];
+      dist_sq += delta*delta;
+    }
+  }
+  return dist_sq;
+}
+
+/*
+ * computeTriangleMeshNormals() computes the face normals and the
+ * angle-weighted edge and vertex pseudonormals.
+ */
+static void computeTriangleMeshNormals(TriangleMesh *mesh)
+{
+  int nt = mesh->num_triangles;
+  int nv = mesh->num_vertices;
+  LSMLIB_REAL *face_normals, *edge_normals, *vertex_normals;
+  MeshEdge *edges;
+  int t, i, d, e, e_end;
+
+  face_normals = (LSMLIB_REAL*) malloc(3*(nt > 0 ? nt : 1)*sizeof(LSMLIB_REAL));
+  edge_normals = (LSMLIB_REAL*) malloc(9*(nt > 0 ? nt : 1)*sizeof(LSMLIB_REAL));
+  vertex_normals = (LSMLIB_REAL*) calloc(3*(nv > 0 ? nv : 1),
+                                         sizeof(LSMLIB_REAL));
+
+  /* face normals and vertex pseudonormals */
+  for (t = 0; t < nt; t++) {
+    const int *tri = &(mesh->triangles[3*t]);
+    LSMLIB_REAL *n = &(face_normals[3*t]);
+    LSMLIB_REAL e1[3], e2[3], norm;
+
+    for (d = 0; d < 3; d++) {
+      e1[d] = mesh->vertices[3*tri[1]+d] - mesh->vertices[3*tri[0]+d];
+      e2[d] = mesh->vertices[3*tri[2]+d] - mesh->vertices[3*tri[0]+d];
+    }
+    n[0] = e1[1]*e2[2] - e1[2]*e2[1];
+    n[1] = e1[2]*e2[0] - e1[0]*e2[2];
+    n[2] = e1[0]*e2[1] - e1[1]*e2[0];
+    norm = sqrt(n[0]*n[0] + n[1]*n[1] + n[2]*n[2]);
+    if (norm > 0) {
+      for (d = 0; d < 3; d++) n[d] /= norm;
+    }
+
+    /* add angle-weighted face normal to vertex pseudonormals */
+    for (i = 0; i < 3; i++) {
+      const LSMLIB_REAL *v0 = &(mesh->vertices[3*tri[i]]);
+      const LSMLIB_REAL *v1 = &(mesh->vertices[3*tri[(i+1)%3]]);
+      const LSMLIB_REAL *v2 = &(mesh->vertices[3*tri[(i+2)%3]]);
+      LSMLIB_REAL a[3], b[3], len_a, len_b, cos_angle;
+      for (d = 0; d < 3; d++) {
+        a[d] = v1[d] - v0[d];
+        b[d] = v2[d] - v0[d];
+      }
+      len_a = sqrt(a[0]*a[0] + a[1]*a[1] + a[2]*a[2]);
+      len_b = sqrt(b[0]*b[0] + b[1]*b[1] + b[2]*b[2]);
+      if ( (len_a > 0) && (len_b > 0) ) {
+        cos_angle = (a[0]*b[0] + a[1]*b[1] + a[2]*b[2])/(len_a*len_b);
+        if (cos_angle > 1) cos_angle = 1;
+        if (cos_angle < -1) cos_angle = -1;
+        for (d = 0; d < 3; d++) {
+          vertex_normals[3*tri[i]+d] += acos(cos_angle)*n[d];
+        }
+      }
+    }
+  }
+
+  /* edge pseudonormals: sum of normals of faces sharing the edge */
+  edges = (MeshEdge*) malloc(3*(nt > 0 ? nt : 1)*sizeof(MeshEdge));
+  for (t = 0; t < nt; t++) {
+    for (i = 0; i < 3; i++) {
+      int va = mesh->triangles[3*t+i];
+      int vb = mesh->triangles[3*t+(i+1)%3];
+      edges[3*t+i].v_lo = (va < vb) ? va : vb;
+      edges[3*t+i].v_hi = (va < vb) ? vb : va;
+      edges[3*t+i].tri_edge = 3*t+i;
+    }
+  }
+  qsort(edges, 3*nt, sizeof(MeshEdge), compareMeshEdges);
+
+  for (e = 0; e < 3*nt; e = e_end) {
+    LSMLIB_REAL sum[3] = {0, 0, 0};
+    for (e_end = e;
+         (e_end < 3*nt) && !compareMeshEdges(&edges[e], &edges[e_end]);
+         e_end++) {
+      t = edges[e_end].tri_edge/3;
+      for (d = 0; d < 3; d++) sum[d] += face_normals[3*t+d];
+    }
+    for (i = e; i < e_end; i++) {
+      for (d = 0; d < 3; d++) {
+        edge_normals[3*edges[i].tri_edge+d] = sum[d];
+      }
+    }
+  }
+  free(edges);
+
+  mesh->face_normals = face_normals;
+  mesh->edge_normals = edge_normals;
+  mesh->vertex_normals = vertex_normals;
+}
+
+/*
+ * buildBVHNode() recursively builds the subtree of the BVH containing
+ * bvh_triangles[first, first+count) and returns the index of its root.
+ */
+static int buildBVHNode(
+  TriangleMesh *mesh,
+  LSMLIB_REAL *centroids,
+  SortKey *keys,
+  int first,
+  int count)
+{
+  int node_idx = mesh->num_bvh_nodes++;
+  TriangleMeshBVHNode *node = &(mesh->bvh_nodes[node_idx]);
+  LSMLIB_REAL c_lo[3], c_hi[3];
+  int i, j, d, axis, half;
+
+  /* compute bounding box of triangles and of their centroids */
+  for (d = 0; d < 3; d++) {
+    node->box_lo[d] = c_lo[d] = LSMLIB_REAL_MAX;
+    node->box_hi[d] = c_hi[d] = -LSMLIB_REAL_MAX;
+  }
+  for (i = first; i < first+count; i++) {
+    int t = mesh->bvh_triangles[i];
+    for (j = 0; j < 3; j++) {
+      const LSMLIB_REAL *v = &(mesh->vertices[3*mesh->triangles[3*t+j]]);
+      for (d = 0; d < 3; d++) {
+        if (v[d] < node->box_lo[d]) node->box_lo[d] = v[d];
+        if (v[d] > node->box_hi[d]) node->box_hi[d] = v[d];
+      }
+    }
+    for (d = 0; d < 3; d++) {
+      if (centroids[3*t+d] < c_lo[d]) c_lo[d] = centroids[3*t+d];
+      if (centroids[3*t+d] > c_hi[d]) c_hi[d] = centroids[3*t+d];
+    }
+  }
+
+  if (count <= LSM_TRIANGLE_MESH_BVH_LEAF_SIZE) {
+    node->left_child = -1;
+    node->right_child = -1;
+    node->first_triangle = first;
+    node->num_triangles = count;
+    return node_idx;
+  }
+
+  /* split at the median centroid along the longest axis */
+  axis = 0;
+  for (d = 1; d < 3; d++) {
+    if (c_hi[d] - c_lo[d] > c_hi[axis] - c_lo[axis]) axis = d;
+  }
+  for (i = 0; i < count; i++) {
+    keys[i].tri = mesh->bvh_triangles[first+i];
+    keys[i].key = centroids[3*keys[i].tri+axis];
+  }
+  qsort(keys, count, sizeof(SortKey), compareSortKeys);
+  for (i = 0; i < count; i++) {
+    mesh->bvh_triangles[first+i] = keys[i].tri;
+  }
+
+  half = count/2;
+  node->first_triangle = first;
+  node->num_triangles = 0;
+  node->left_child = buildBVHNode(mesh, centroids, keys, first, half);
+  node->right_child = buildBVHNode(mesh, centroids, keys,
+                                   first+half, count-half);
+  return node_idx;
+}
+
+
+/*========================= API Functions =================================*/
+
+TriangleMesh *createTriangleMesh(
+  int num_vertices,
+  LSMLIB_REAL *vertices,
+  int num_triangles,
+  int *triangles)
+{
+  TriangleMesh *mesh = allocateTriangleMesh();
+
+  mesh->num_vertices = num_vertices;
+  mesh->vertices = (LSMLIB_REAL*) malloc(
+    3*(num_vertices > 0 ? num_vertices : 1)*sizeof(LSMLIB_REAL));
+  memcpy(mesh->vertices, vertices, 3*num_vertices*sizeof(LSMLIB_REAL));
+
+  mesh->num_triangles = num_triangles;
+  mesh->triangles = (int*) malloc(
+    3*(num_triangles > 0 ? num_triangles : 1)*sizeof(int));
+  memcpy(mesh->triangles, triangles, 3*num_triangles*sizeof(int));
+
+  return mesh;
+}
+
+
+TriangleMesh *readTriangleMeshFromSTLFile(char *file_name)
+{
+  TriangleMesh *mesh;
+  FILE *fp;
+  LSMLIB_REAL *coords = NULL;
+  int num_triangles = 0;
+  int capacity = 0;
+  unsigned int num_binary_triangles = 0;
+  long file_size;
+  char header[80];
+  int is_binary = 0;
+  int i;
+
+  fp = fopen(file_name, "rb");
+  if (!fp) {
+    fprintf(stderr, "\nUnable to open STL file '%s'.\n", file_name);
+    return NULL;
+  }
+
+  /* binary STL files consist of an 80 byte header, a 4 byte triangle */
+  /* count and 50 bytes for each triangle                             */
+  fseek(fp, 0, SEEK_END);
+  file_size = ftell(fp);
+  fseek(fp, 0, SEEK_SET);
+  if ( (fread(header, 1, 80, fp) == 80) &&
+       (fread(&num_binary_triangles, 4, 1, fp) == 1) &&
+       (file_size == 84 + 50*(long) num_binary_triangles) ) {
+    is_binary = 1;
+  }
+
+  if (is_binary) {
+
+    float data[12];
+    unsigned short attribute;
+
+    num_triangles = (int) num_binary_triangles;
+    coords = (LSMLIB_REAL*) malloc(
+      9*(num_triangles > 0 ? num_triangles : 1)*sizeof(LSMLIB_REAL));
+    for (i = 0; i < num_triangles; i++) {
+      int j;
+      if ( (fread(data, sizeof(float), 12, fp) != 12) ||
+           (fread(&attribute, 2, 1, fp) != 1) ) {
+        fprintf(stderr, "\nUnexpected end of STL file '%s'.\n", file_name);
+        free(coords);
+        fclose(fp);
+        return NULL;
+      }
+      /* NOTE: data[0-2] contains the facet normal, which is not used */
+      for (j = 0; j < 9; j++) coords[9*i+j] = data[3+j];
+    }
+
+  } else {
+
+    char token[256];
+    double x, y, z;
+    int num_coords = 0;
+
+    fseek(fp, 0, SEEK_SET);
+    while (fscanf(fp, "%255s", token) == 1) {
+      if (strcmp(token, "vertex")) continue;
+      if (fscanf(fp, "%lf %lf %lf", &x, &y, &z) != 3) {
+        fprintf(stderr, "\nInvalid vertex in STL file '%s'.\n", file_name);
+        free(coords);
+        fclose(fp);
+        return NULL;
+      }
+      if (num_coords + 3 > capacity) {
+        capacity = (capacity > 0) ? 2*capacity : 9*1024;
+        coords = (LSMLIB_REAL*) realloc(coords,
+                                        capacity*sizeof(LSMLIB_REAL));
+      }
+      coords[num_coords++] = x;
+      coords[num_coords++] = y;
+      coords[num_coords++] = z;
+    }
+    if (num_coords%9 != 0) {
+      fprintf(stderr, "\nIncomplete facet in STL file '%s'.\n", file_name);
+      free(coords);
+      fclose(fp);
+      return NULL;
+    }
+    num_triangles = num_coords/9;
+  }
+  fclose(fp);
+
+  mesh = createWeldedTriangleMesh(num_triangles, coords);
+  free(coords);
+  return mesh;
+}
+
+
+TriangleMesh *readTriangleMeshFromOBJFile(char *file_name)
+{
+  TriangleMesh *mesh;
+  FILE *fp;
+  char line[4096];
+  LSMLIB_REAL *vertices = NULL;
+  int *triangles = NULL;
+  int num_vertices = 0, vertex_capacity = 0;
+  int num_triangles = 0, triangle_capacity = 0;
+  int i;
+
+  fp = fopen(file_name, "r");
+  if (!fp) {
+    fprintf(stderr, "\nUnable to open OBJ file '%s'.\n", file_name);
+    return NULL;
+  }
+
+  while (fgets(line, sizeof(line), fp)) {
+
+    if ( (line[0] == 'v') && ((line[1] == ' ') || (line[1] == '\t')) ) {
+
+      double x, y, z;
+      if (sscanf(line+2, "%lf %lf %lf", &x, &y, &z) != 3) continue;
+      if (num_vertices == vertex_capacity) {
+        vertex_capacity = (vertex_capacity > 0) ? 2*vertex_capacity : 1024;
+        vertices = (LSMLIB_REAL*) realloc(vertices,
+          3*vertex_capacity*sizeof(LSMLIB_REAL));
+      }
+      vertices[3*num_vertices]   = x;
+      vertices[3*num_vertices+1] = y;
+      vertices[3*num_vertices+2] = z;
+      num_vertices++;
+
+    } else if ( (line[0] == 'f') &&
+                ((line[1] == ' ') || (line[1] == '\t')) ) {
+
+      /* split polygonal faces into a fan of triangles */
+      int face_vertices[3];
+      int num_face_vertices = 0;
+      char *token = strtok(line+2, " \t\r\n");
+      while (token) {
+        long idx = strtol(token, NULL, 10);
+        idx = (idx < 0) ? num_vertices + idx : idx - 1;
+        if (num_face_vertices < 2) {
+          face_vertices[num_face_vertices++] = (int) idx;
+        } else {
+          face_vertices[2] = (int) idx;
+          if (num_triangles == triangle_capacity) {
+            triangle_capacity = (triangle_capacity > 0)
+                              ? 2*triangle_capacity : 1024;
+            triangles = (int*) realloc(triangles,
+              3*triangle_capacity*sizeof(int));
+          }
+          triangles[3*num_triangles]   = face_vertices[0];
+          triangles[3*num_triangles+1] = face_vertices[1];
+          triangles[3*num_triangles+2] = face_vertices[2];
+          num_triangles++;
+          face_vertices[1] = face_vertices[2];
+        }
+        token = strtok(NULL, " \t\r\n");
+      }
+    }
+  }
+  fclose(fp);
+
+  for (i = 0; i < 3*num_triangles; i++) {
+    if ( (triangles[i] < 0) || (triangles[i] >= num_vertices) ) {
+      fprintf(stderr, "\nInvalid vertex index in OBJ file '%s'.\n",
+              file_name);
+      free(vertices);
+      free(triangles);
+      return NULL;
+    }
+  }
+
+  mesh = createTriangleMesh(num_vertices, vertices, num_triangles, triangles);
+  free(vertices);
+  free(triangles);
+  return mesh;
+}
+
+
+void destroyTriangleMesh(TriangleMesh *mesh)
+{
+  if (!mesh) return;
+  freeTriangleMeshBVH(mesh);
+  free(mesh->vertices);
+  free(mesh->triangles);
+  free(mesh);
+}
+
+
+void buildTriangleMeshBVH(TriangleMesh *mesh)
+{
+  int nt = mesh->num_triangles;
+  LSMLIB_REAL *centroids;
+  SortKey *keys;
+  int num_bvh_triangles;
+  int t, d;
+
+  freeTriangleMeshBVH(mesh);
+  computeTriangleMeshNormals(mesh);
+
+  /* only non-degenerate triangles are stored in the BVH */
+  mesh->bvh_triangles = (int*) malloc((nt > 0 ? nt : 1)*sizeof(int));
+  centroids = (LSMLIB_REAL*) malloc(3*(nt > 0 ? nt : 1)*sizeof(LSMLIB_REAL));
+  num_bvh_triangles = 0;
+  for (t = 0; t < nt; t++) {
+    const LSMLIB_REAL *n = &(mesh->face_normals[3*t]);
+    if (n[0]*n[0] + n[1]*n[1] + n[2]*n[2] == 0) continue;
+    mesh->bvh_triangles[num_bvh_triangles++] = t;
+    for (d = 0; d < 3; d++) {
+      centroids[3*t+d] = ( mesh->vertices[3*mesh->triangles[3*t]+d]
+                         + mesh->vertices[3*mesh->triangles[3*t+1]+d]
+                         + mesh->vertices[3*mesh->triangles[3*t+2]+d] )/3.0;
+    }
+  }
+
+  if (num_bvh_triangles > 0) {
+    mesh->bvh_nodes = (TriangleMeshBVHNode*) malloc(
+      (2*num_bvh_triangles)*sizeof(TriangleMeshBVHNode));
+    keys = (SortKey*) malloc(num_bvh_triangles*sizeof(SortKey));
+    mesh->num_bvh_nodes = 0;
+    buildBVHNode(mesh, centroids, keys, 0, num_bvh_triangles);
+    free(keys);
+  }
+
+  free(centroids);
+}
+
+
+int computeSignedDistanceToTriangleMesh(
+  LSMLIB_REAL *signed_distance,
+  TriangleMesh *mesh,
+  LSMLIB_REAL *point,
+  LSMLIB_REAL max_distance)
+{
+  int stack[LSM_TRIANGLE_MESH_BVH_MAX_DEPTH];
+  int stack_size = 0;
+  LSMLIB_REAL best_dist_sq, dist_sq;
+  LSMLIB_REAL best_q[3], q[3];
+  int best_tri = -1, best_feature = 0, feature;
+  const LSMLIB_REAL *n;
+  LSMLIB_REAL dot;
+  int i, d;
+
+  if (mesh->num_bvh_nodes == 0) return 0;
+
+  best_dist_sq = max_distance*max_distance;
+  stack[stack_size++] = 0;
+
+  while (stack_size > 0) {
+    const TriangleMeshBVHNode *node = &(mesh->bvh_nodes[stack[--stack_size]]);
+
+    if (boxDistanceSquared(point, node->box_lo, node->box_hi) > best_dist_sq) {
+      continue;
+    }
+
+    if (node->left_child < 0) {
+
+      /* leaf node: check triangles */
+      for (i = node->first_triangle;
+           i < node->first_triangle + node->num_triangles; i++) {
+        int t = mesh->bvh_triangles[i];
+        const int *tri = &(mesh->triangles[3*t]);
+        dist_sq = closestPointOnTriangle(q, &feature, point,
+                                         &(mesh->vertices[3*tri[0]]),
+                                         &(mesh->vertices[3*tri[1]]),
+                                         &(mesh->vertices[3*tri[2]]));
+        if (dist_sq <= best_dist_sq) {
+          best_dist_sq = dist_sq;
+          best_tri = t;
+          best_feature = feature;
+          for (d = 0; d < 3; d++) best_q[d] = q[d];
+        }
+      }
+
+    } else {
+
+      /* push farther child first so that nearer child is searched first */
+      const TriangleMeshBVHNode *left = &(mesh->bvh_nodes[node->left_child]);
+      const TriangleMeshBVHNode *right = &(mesh->bvh_nodes[node->right_child]);
+      LSMLIB_REAL dist_left =
+        boxDistanceSquared(point, left->box_lo, left->box_hi);
+      LSMLIB_REAL dist_right =
+        boxDistanceSquared(point, right->box_lo, right->box_hi);
+      if (dist_left < dist_right) {
+        stack[stack_size++] = node->right_child;
+        stack[stack_size++] = node->left_child;
+      } else {
+        stack[stack_size++] = node->left_child;
+        stack[stack_size++] = node->right_child;
+      }
+    }
+  }
+
+  if (best_tri < 0) return 0;
+
+  /* determine sign using pseudonormal of closest feature */
+  switch (best_feature) {
+    case LSM_TRIANGLE_MESH_VERTEX0:
+    case LSM_TRIANGLE_MESH_VERTEX1:
+    case LSM_TRIANGLE_MESH_VERTEX2:
+      n = &(mesh->vertex_normals[
+            3*mesh->triangles[3*best_tri + best_feature
+                              - LSM_TRIANGLE_MESH_VERTEX0]]);
+      break;
+    case LSM_TRIANGLE_MESH_EDGE01:
+    case LSM_TRIANGLE_MESH_EDGE12:
+    case LSM_TRIANGLE_MESH_EDGE20:
+      n = &(mesh->edge_normals[
+            3*(3*best_tri + best_feature - LSM_TRIANGLE_MESH_EDGE01)]);
+      break;
+    default:
+      n = &(mesh->face_normals[3*best_tri]);
+  }
+
+  dot = 0;
+  for (d = 0; d < 3; d++) dot += (point[d] - best_q[d])*n[d];
+
+  *signed_distance = (dot < 0) ? -sqrt(best_dist_sq) : sqrt(best_dist_sq);
+  return 1;
+}
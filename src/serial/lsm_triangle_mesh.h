@@ -0,0 +1,227 @@
+/*
+ * File:        lsm_triangle_mesh.h
+ * Copyrights:  (c) 2005 The Trustees of Princeton University and Board of
+ *                  Regents of the University of Texas.  All rights reserved.
+ *              (c) 2009 Kevin T. Chu.  All rights reserved.
+ * Revision:    $Revision$
+ * Modified:    $Date$
+ * Description: Header file for triangle mesh data structures and
+ *              closest point queries
+ */
+
+#ifndef included_lsm_triangle_mesh_h
+#define included_lsm_triangle_mesh_h
+
+#include "LSMLIB_config.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+
+/*! \file lsm_triangle_mesh.h
+ *
+ * \brief
+ * @ref lsm_triangle_mesh.h provides support for reading closed triangle
+ * meshes (e.g. from CAD models) and computing the signed distance from
+ * points to the surface represented by the mesh.  It is used by
+ * createSignedDistanceFromTriangleMesh3d() (see
+ * @ref lsm_initialization3d.h) to initialize level set functions from
+ * complex geometries.
+ *
+ * Closest point queries are accelerated using a bounding volume
+ * hierarchy (BVH) of axis-aligned bounding boxes, so the cost of a
+ * query grows only logarithmically with the number of triangles.  The
+ * sign of the distance is determined using the angle-weighted
+ * pseudonormals of Baerentzen and Aanaes ("Signed Distance Computation
+ * Using the Angle Weighted Pseudonormal", IEEE Trans. Vis. Comput.
+ * Graphics, vol 11, 2005), which give the correct sign for points whose
+ * closest point lies on an edge or vertex of the mesh.
+ *
+ * Typical usage:
+ *  -# read the mesh with readTriangleMeshFromSTLFile() or
+ *     readTriangleMeshFromOBJFile() (or create it from vertex and
+ *     triangle arrays with createTriangleMesh())
+ *  -# build the BVH with buildTriangleMeshBVH()
+ *  -# compute distances with computeSignedDistanceToTriangleMesh()
+ *  -# free the mesh with destroyTriangleMesh()
+ *
+ * NOTES:
+ *  - The mesh is assumed to be closed (i.e. watertight) and
+ *    consistently oriented with the vertices of each triangle ordered
+ *    counterclockwise when viewed from outside of the enclosed region.
+ *    Points inside of the enclosed region have negative signed distance.
+ *
+ */
+
+
+/*!
+ * The 'TriangleMeshBVHNode' structure is a node of the bounding volume
+ * hierarchy for a TriangleMesh.
+ */
+typedef struct _TriangleMeshBVHNode {
+
+  /* bounding box of triangles in subtree */
+  LSMLIB_REAL box_lo[3];
+  LSMLIB_REAL box_hi[3];
+
+  /* indices of child nodes (-1 for leaf nodes) */
+  int left_child;
+  int right_child;
+
+  /* range of bvh_triangles contained in leaf node */
+  int first_triangle;
+  int num_triangles;
+
+} TriangleMeshBVHNode;
+
+
+/*!
+ * The 'TriangleMesh' structure contains an indexed triangle mesh along
+ * with the data required for closest point queries.
+ */
+typedef struct _TriangleMesh {
+
+  /* vertex coordinates (x,y,z for each vertex) */
+  int num_vertices;
+  LSMLIB_REAL *vertices;
+
+  /* vertex indices (three for each triangle) */
+  int num_triangles;
+  int *triangles;
+
+  /* data computed by buildTriangleMeshBVH() */
+  int num_bvh_nodes;
+  TriangleMeshBVHNode *bvh_nodes;
+  int *bvh_triangles;            /* triangle indices ordered by leaf */
+  LSMLIB_REAL *face_normals;     /* unit normal of each triangle     */
+  LSMLIB_REAL *edge_normals;     /* pseudonormals of the three edges */
+                                 /* (v0v1, v1v2, v2v0) of each       */
+                                 /* triangle                         */
+  LSMLIB_REAL *vertex_normals;   /* pseudonormal of each vertex      */
+
+} TriangleMesh;
+
+
+/*!
+ * createTriangleMesh() creates a TriangleMesh from arrays of vertex
+ * coordinates and triangle vertex indices.
+ *
+ * Arguments:
+ *  - num_vertices (in):   number of vertices
+ *  - vertices (in):       vertex coordinates (x, y, z for each vertex)
+ *  - num_triangles (in):  number of triangles
+ *  - triangles (in):      vertex indices (zero-based) of the three
+ *                         vertices of each triangle
+ *
+ * Return value:           pointer to new TriangleMesh
+ *
+ * NOTES:
+ *  - The vertices and triangles arrays are copied.
+ *
+ */
+TriangleMesh *createTriangleMesh(
+  int num_vertices,
+  LSMLIB_REAL *vertices,
+  int num_triangles,
+  int *triangles);
+
+/*!
+ * readTriangleMeshFromSTLFile() reads a TriangleMesh from an ASCII or
+ * binary STL file.
+ *
+ * Arguments:
+ *  - file_name (in):  name of STL file
+ *
+ * Return value:       pointer to new TriangleMesh; NULL if the file
+ *                     could not be read
+ *
+ * NOTES:
+ *  - Because STL files store the coordinates of the vertices of each
+ *    triangle separately, vertices with identical coordinates are
+ *    merged so that the connectivity of the mesh is recovered.
+ *
+ */
+TriangleMesh *readTriangleMeshFromSTLFile(char *file_name);
+
+/*!
+ * readTriangleMeshFromOBJFile() reads a TriangleMesh from a Wavefront
+ * OBJ file.
+ *
+ * Arguments:
+ *  - file_name (in):  name of OBJ file
+ *
+ * Return value:       pointer to new TriangleMesh; NULL if the file
+ *                     could not be read
+ *
+ * NOTES:
+ *  - Only vertex ("v") and face ("f") records are used.  Faces with
+ *    more than three vertices are split into triangles.
+ *
+ */
+TriangleMesh *readTriangleMeshFromOBJFile(char *file_name);
+
+/*!
+ * destroyTriangleMesh() frees the memory associated with a TriangleMesh.
+ *
+ * Arguments:
+ *  - mesh (in):  pointer to TriangleMesh
+ *
+ * Return value:  none
+ *
+ */
+void destroyTriangleMesh(TriangleMesh *mesh);
+
+/*!
+ * buildTriangleMeshBVH() computes the bounding volume hierarchy and
+ * pseudonormals required by computeSignedDistanceToTriangleMesh().
+ *
+ * Arguments:
+ *  - mesh (in/out):  pointer to TriangleMesh
+ *
+ * Return value:      none
+ *
+ * NOTES:
+ *  - Any previously computed BVH is replaced.
+ *
+ */
+void buildTriangleMeshBVH(TriangleMesh *mesh);
+
+/*!
+ * computeSignedDistanceToTriangleMesh() computes the signed distance
+ * from a point to the surface represented by a TriangleMesh if the
+ * distance does not exceed the specified maximum distance.
+ *
+ * Arguments:
+ *  - signed_distance (out):  signed distance from point to surface
+ *                            (negative inside of the surface)
+ *  - mesh (in):              pointer to TriangleMesh
+ *  - point (in):             coordinates of point
+ *  - max_distance (in):      maximum distance of interest
+ *
+ * Return value:              1 if the distance from the point to the
+ *                            surface is no greater than max_distance;
+ *                            0 otherwise (in which case signed_distance
+ *                            is not set)
+ *
+ * NOTES:
+ *  - Parts of the BVH that lie farther than max_distance from the
+ *    point are not searched, so queries for points far from the
+ *    surface are inexpensive.
+ *
+ *  - buildTriangleMeshBVH() MUST be called before this function.
+ *    Queries do not modify the mesh, so they may be carried out
+ *    concurrently.
+ *
+ */
+int computeSignedDistanceToTriangleMesh(
+  LSMLIB_REAL *signed_distance,
+  TriangleMesh *mesh,
+  LSMLIB_REAL *point,
+  LSMLIB_REAL max_distance);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
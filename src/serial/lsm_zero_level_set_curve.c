@@ -0,0 +1,525 @@
+/*
+ * File:        lsm_zero_level_set_curve.c
+ * Copyrights:  (c) 2005 The Trustees of Princeton University and Board of
+ *                  Regents of the University of Texas.  All rights reserved.
+ *              (c) 2009 Kevin T. Chu.  All rights reserved.
+ * Revision:    $Revision$
+ * Modified:    $Date$
+ * Description: Implementation file for extraction of curves defined by the
+ *              zero level sets of two level set functions
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <math.h>
+
+#include "lsm_zero_level_set_curve.h"
+#include "lsm_geometry3d.h"
+
+/* tolerance for merging segment endpoints (relative to grid spacing) */
+#define LSM_ZLS_CURVE_MERGE_TOL_FACTOR      (1.0e-4)
+
+/* initial size of segment buffers (in segments per grid cell along */
+/* the boundary of a z-slab)                                         */
+#define LSM_ZLS_CURVE_SLAB_BUFFER_FACTOR    (2)
+
+
+/*========================= Helper Data Structures ========================*/
+
+/* directed edge between two merged vertices */
+typedef struct {
+  int v_start, v_end;
+} CurveEdge;
+
+/* spatial hash table used for merging segment endpoints */
+typedef struct {
+  LSMLIB_REAL tolerance;
+  int table_size;            /* power of 2 */
+  int *bucket_head;          /* first vertex in each bucket (-1 if empty) */
+  int *next_vertex;          /* next vertex in same bucket                */
+  long *vertex_cell;         /* hash cell containing each vertex          */
+  LSMLIB_REAL *vertices;
+  int num_vertices;
+} VertexHash;
+
+
+/*========================= Helper Functions ==============================*/
+
+static int compareCurveEdges(const void *a, const void *b)
+{
+  const CurveEdge *e1 = (const CurveEdge*) a;
+  const CurveEdge *e2 = (const CurveEdge*) b;
+  if (e1->v_start != e2->v_start) return (e1->v_start < e2->v_start) ? -1 : 1;
+  if (e1->v_end != e2->v_end) return (e1->v_end < e2->v_end) ? -1 : 1;
+  return 0;
+}
+
+static int hashCell(const long *cell, int table_size)
+{
+  unsigned long h = ((unsigned long) cell[0])*73856093UL
+                  ^ ((unsigned long) cell[1])*19349663UL
+                  ^ ((unsigned long) cell[2])*83492791UL;
+  return (int) (h & (unsigned long) (table_size-1));
+}
+
+/*
+ * findOrAddVertex() returns the index of a vertex within the merge
+ * tolerance of x, adding a new vertex if there is no such vertex.
+ * Because the hash cells have width equal to the tolerance, it is
+ * sufficient to search the 27 cells surrounding the cell containing x.
+ */
+static int findOrAddVertex(VertexHash *hash, const LSMLIB_REAL *x)
+{
+  const LSMLIB_REAL tol_sq = hash->tolerance*hash->tolerance;
+  long cell[3], nbr_cell[3];
+  int di, dj, dk, v, d;
+
+  for (d = 0; d < 3; d++) {
+    cell[d] = (long) floor(x[d]/hash->tolerance);
+  }
+
+  for (dk = -1; dk <= 1; dk++) {
+    for (dj = -1; dj <= 1; dj++) {
+      for (di = -1; di <= 1; di++) {
+        nbr_cell[0] = cell[0]+di;
+        nbr_cell[1] = cell[1]+dj;
+        nbr_cell[2] = cell[2]+dk;
+        v = hash->bucket_head[hashCell(nbr_cell, hash->table_size)];
+        while (v >= 0) {
+          const long *v_cell = &(hash->vertex_cell[3*v]);
+          if ( (v_cell[0] == nbr_cell[0]) && (v_cell[1] == nbr_cell[1]) &&
+               (v_cell[2] == nbr_cell[2]) ) {
+            const LSMLIB_REAL *y = &(hash->vertices[3*v]);
+            LSMLIB_REAL dist_sq = (x[0]-y[0])*(x[0]-y[0])
+                                + (x[1]-y[1])*(x[1]-y[1])
+                                + (x[2]-y[2])*(x[2]-y[2]);
+            if (dist_sq <= tol_sq) return v;
+          }
+          v = hash->next_vertex[v];
+        }
+      }
+    }
+  }
+
+  /* add new vertex */
+  v = hash->num_vertices++;
+  for (d = 0; d < 3; d++) {
+    hash->vertices[3*v+d] = x[d];
+    hash->vertex_cell[3*v+d] = cell[d];
+  }
+  d = hashCell(cell, hash->table_size);
+  hash->next_vertex[v] = hash->bucket_head[d];
+  hash->bucket_head[d] = v;
+
+  return v;
+}
+
+/*
+ * findSegmentsInSlabs() computes the line segments and length of the
+ * {phi=0,psi=0} curve in each z-slab of cells in the fillbox.  If
+ * slab_segments is NULL, only the lengths are computed.  Returns 0 on
+ * success and the error code from LSM3D_findLineSegmentsInBox() on
+ * failure.
+ */
+static int findSegmentsInSlabs(
+  LSMLIB_REAL *phi,
+  LSMLIB_REAL *psi,
+  Grid *grid,
+  int num_slabs,
+  LSMLIB_REAL **slab_segments,
+  int *slab_num_segments,
+  LSMLIB_REAL *slab_length)
+{
+  /* cells with lower corners in [*lo_fb, *hi_fb-1] */
+  const int ilo_ib = grid->ilo_fb, ihi_ib = grid->ihi_fb-1;
+  const int jlo_ib = grid->jlo_fb, jhi_ib = grid->jhi_fb-1;
+  const int initial_capacity = LSM_ZLS_CURVE_SLAB_BUFFER_FACTOR
+    *(grid->grid_dims_ghostbox[0] + grid->grid_dims_ghostbox[1]);
+  int err_code = 0;
+  int s;
+
+#ifdef _OPENMP
+#pragma omp parallel for schedule(dynamic)
+#endif
+  for (s = 0; s < num_slabs; s++) {
+    const int k = grid->klo_fb + s;
+    LSMLIB_REAL *buffer = NULL;
+    int capacity = 0;
+    int num_segments;
+
+    if (slab_segments) {
+      capacity = initial_capacity;
+      buffer = (LSMLIB_REAL*) malloc(6*capacity*sizeof(LSMLIB_REAL));
+    }
+
+    num_segments = LSM3D_findLineSegmentsInBox(
+      buffer, capacity, &(slab_length[s]), phi, psi,
+      &(grid->ilo_gb), &(grid->ihi_gb),
+      &(grid->jlo_gb), &(grid->jhi_gb),
+      &(grid->klo_gb), &(grid->khi_gb),
+      NULL,
+      &(grid->ilo_gb), &(grid->ihi_gb),
+      &(grid->jlo_gb), &(grid->jhi_gb),
+      &(grid->klo_gb), &(grid->khi_gb),
+      &ilo_ib, &ihi_ib, &jlo_ib, &jhi_ib, &k, &k,
+      grid->x_lo_ghostbox,
+      &(grid->dx[0]), &(grid->dx[1]), &(grid->dx[2]));
+
+    /* recompute segments if the buffer was too small */
+    if ( (slab_segments) && (num_segments > capacity) ) {
+      capacity = num_segments;
+      buffer = (LSMLIB_REAL*) realloc(buffer,
+                                      6*capacity*sizeof(LSMLIB_REAL));
+      num_segments = LSM3D_findLineSegmentsInBox(
+        buffer, capacity, &(slab_length[s]), phi, psi,
+        &(grid->ilo_gb), &(grid->ihi_gb),
+        &(grid->jlo_gb), &(grid->jhi_gb),
+        &(grid->klo_gb), &(grid->khi_gb),
+        NULL,
+        &(grid->ilo_gb), &(grid->ihi_gb),
+        &(grid->jlo_gb), &(grid->jhi_gb),
+        &(grid->klo_gb), &(grid->khi_gb),
+        &ilo_ib, &ihi_ib, &jlo_ib, &jhi_ib, &k, &k,
+        grid->x_lo_ghostbox,
+        &(grid->dx[0]), &(grid->dx[1]), &(grid->dx[2]));
+    }
+
+    if (num_segments < 0) {
+#ifdef _OPENMP
+#pragma omp critical
+#endif
+      err_code = num_segments;
+      num_segments = 0;
+    }
+
+    slab_num_segments[s] = num_segments;
+    if (slab_segments) {
+      if (num_segments == 0) {
+        free(buffer);
+        buffer = NULL;
+      }
+      slab_segments[s] = buffer;
+    }
+  }
+
+  return err_code;
+}
+
+
+/*========================= Library Functions =============================*/
+
+ZeroLevelSetCurve *extractZeroLevelSetCurve3d(
+  LSMLIB_REAL *phi,
+  LSMLIB_REAL *psi,
+  Grid *grid)
+{
+  ZeroLevelSetCurve *curve;
+  const int num_slabs = (grid->khi_fb > grid->klo_fb) ?
+                        grid->khi_fb - grid->klo_fb : 0;
+  LSMLIB_REAL **slab_segments;
+  int *slab_num_segments;
+  LSMLIB_REAL *slab_length;
+  LSMLIB_REAL *segments;
+  LSMLIB_REAL tolerance;
+  int num_segments;
+  int err_code;
+  int s;
+
+  if (grid->num_dims != 3) {
+    fprintf(stderr,
+      "ERROR: extractZeroLevelSetCurve3d() requires a 3D grid\n");
+    return NULL;
+  }
+
+  /* compute line segments in each z-slab */
+  slab_segments = (LSMLIB_REAL**) malloc((num_slabs+1)*sizeof(LSMLIB_REAL*));
+  slab_num_segments = (int*) malloc((num_slabs+1)*sizeof(int));
+  slab_length = (LSMLIB_REAL*) malloc((num_slabs+1)*sizeof(LSMLIB_REAL));
+  err_code = findSegmentsInSlabs(phi, psi, grid, num_slabs,
+                                 slab_segments, slab_num_segments,
+                                 slab_length);
+
+  /* concatenate line segments in slab order */
+  num_segments = 0;
+  for (s = 0; s < num_slabs; s++) num_segments += slab_num_segments[s];
+  segments = (LSMLIB_REAL*) malloc((6*num_segments+1)*sizeof(LSMLIB_REAL));
+  num_segments = 0;
+  for (s = 0; s < num_slabs; s++) {
+    int n;
+    for (n = 0; n < 6*slab_num_segments[s]; n++) {
+      segments[6*num_segments+n] = slab_segments[s][n];
+    }
+    num_segments += slab_num_segments[s];
+    free(slab_segments[s]);
+  }
+  free(slab_segments);
+  free(slab_num_segments);
+  free(slab_length);
+
+  if (err_code != 0) {
+    fprintf(stderr,
+      "ERROR: extractZeroLevelSetCurve3d() failed to compute line\n");
+    fprintf(stderr,
+      "       segments (LSM3D_findLineInTetrahedron() error code %d)\n",
+      err_code);
+    free(segments);
+    return NULL;
+  }
+
+  /* join line segments into polylines */
+  tolerance = grid->dx[0];
+  if (grid->dx[1] < tolerance) tolerance = grid->dx[1];
+  if (grid->dx[2] < tolerance) tolerance = grid->dx[2];
+  tolerance *= LSM_ZLS_CURVE_MERGE_TOL_FACTOR;
+  curve = createZeroLevelSetCurveFromSegments(num_segments, segments,
+                                              tolerance);
+  free(segments);
+
+  return curve;
+}
+
+
+LSMLIB_REAL computeLengthOfZeroLevelSetCurve3d(
+  LSMLIB_REAL *phi,
+  LSMLIB_REAL *psi,
+  Grid *grid)
+{
+  const int num_slabs = (grid->khi_fb > grid->klo_fb) ?
+                        grid->khi_fb - grid->klo_fb : 0;
+  int *slab_num_segments;
+  LSMLIB_REAL *slab_length;
+  LSMLIB_REAL length = 0.0;
+  int err_code;
+  int s;
+
+  if (grid->num_dims != 3) {
+    fprintf(stderr,
+      "ERROR: computeLengthOfZeroLevelSetCurve3d() requires a 3D grid\n");
+    return -1.0;
+  }
+
+  slab_num_segments = (int*) malloc((num_slabs+1)*sizeof(int));
+  slab_length = (LSMLIB_REAL*) malloc((num_slabs+1)*sizeof(LSMLIB_REAL));
+  err_code = findSegmentsInSlabs(phi, psi, grid, num_slabs,
+                                 NULL, slab_num_segments, slab_length);
+
+  /* sum in slab order so that the result does not depend on the */
+  /* number of threads                                           */
+  for (s = 0; s < num_slabs; s++) length += slab_length[s];
+
+  free(slab_num_segments);
+  free(slab_length);
+
+  if (err_code != 0) {
+    fprintf(stderr,
+      "ERROR: computeLengthOfZeroLevelSetCurve3d() failed to compute line\n");
+    fprintf(stderr,
+      "       segments (LSM3D_findLineInTetrahedron() error code %d)\n",
+      err_code);
+    return -1.0;
+  }
+
+  return length;
+}
+
+
+ZeroLevelSetCurve *createZeroLevelSetCurveFromSegments(
+  int num_segments,
+  LSMLIB_REAL *segments,
+  LSMLIB_REAL tolerance)
+{
+  ZeroLevelSetCurve *curve;
+  VertexHash hash;
+  CurveEdge *edges;
+  int num_edges;
+  int *out_pos, *out_end, *in_degree, *vertex_map;
+  int num_poly_vertices;
+  int pass, n, v;
+
+  if (tolerance <= 0) {
+    fprintf(stderr,
+      "ERROR: createZeroLevelSetCurveFromSegments() requires a positive\n");
+    fprintf(stderr, "       tolerance\n");
+    return NULL;
+  }
+
+  /* merge segment endpoints */
+  hash.tolerance = tolerance;
+  hash.table_size = 16;
+  while (hash.table_size < 4*num_segments) hash.table_size *= 2;
+  hash.bucket_head = (int*) malloc(hash.table_size*sizeof(int));
+  for (n = 0; n < hash.table_size; n++) hash.bucket_head[n] = -1;
+  hash.next_vertex = (int*) malloc((2*num_segments+1)*sizeof(int));
+  hash.vertex_cell = (long*) malloc((6*num_segments+1)*sizeof(long));
+  hash.vertices = (LSMLIB_REAL*) malloc(
+    (6*num_segments+1)*sizeof(LSMLIB_REAL));
+  hash.num_vertices = 0;
+
+  edges = (CurveEdge*) malloc((num_segments+1)*sizeof(CurveEdge));
+  num_edges = 0;
+  for (n = 0; n < num_segments; n++) {
+    int v_start = findOrAddVertex(&hash, &(segments[6*n]));
+    int v_end = findOrAddVertex(&hash, &(segments[6*n+3]));
+
+    /* discard segments whose endpoints coincide */
+    if (v_start != v_end) {
+      edges[num_edges].v_start = v_start;
+      edges[num_edges].v_end = v_end;
+      num_edges++;
+    }
+  }
+  free(hash.bucket_head);
+  free(hash.next_vertex);
+  free(hash.vertex_cell);
+
+  /* sort edges by starting vertex and remove duplicate edges */
+  qsort(edges, num_edges, sizeof(CurveEdge), compareCurveEdges);
+  if (num_edges > 0) {
+    int num_unique = 1;
+    for (n = 1; n < num_edges; n++) {
+      if (compareCurveEdges(&(edges[n]), &(edges[num_unique-1])) != 0) {
+        edges[num_unique++] = edges[n];
+      }
+    }
+    num_edges = num_unique;
+  }
+
+  /* compute outgoing edge ranges and in-degree of vertices */
+  out_pos = (int*) malloc((hash.num_vertices+1)*sizeof(int));
+  out_end = (int*) malloc((hash.num_vertices+1)*sizeof(int));
+  in_degree = (int*) malloc((hash.num_vertices+1)*sizeof(int));
+  for (v = 0; v < hash.num_vertices; v++) {
+    out_pos[v] = 0; out_end[v] = 0; in_degree[v] = 0;
+  }
+  for (n = num_edges-1; n >= 0; n--) {
+    out_pos[edges[n].v_start] = n;
+    in_degree[edges[n].v_end]++;
+  }
+  for (n = 0; n < num_edges; n++) {
+    out_end[edges[n].v_start] = n+1;
+  }
+
+  /* allocate curve */
+  curve = (ZeroLevelSetCurve*) malloc(sizeof(ZeroLevelSetCurve));
+  curve->num_polylines = 0;
+  curve->polyline_offsets = (int*) malloc((num_edges+1)*sizeof(int));
+  curve->polyline_vertices = (int*) malloc((2*num_edges+1)*sizeof(int));
+  curve->polyline_is_closed = (int*) malloc((num_edges+1)*sizeof(int));
+  curve->polyline_offsets[0] = 0;
+  curve->length = 0.0;
+  num_poly_vertices = 0;
+
+  /* walk edges to form polylines.  open polylines are started at */
+  /* vertices with no incoming edges (first pass); the remaining  */
+  /* edges form closed polylines (second pass).                   */
+  for (pass = 0; pass < 2; pass++) {
+    for (v = 0; v < hash.num_vertices; v++) {
+      if ( (pass == 0) && (in_degree[v] > 0) ) continue;
+
+      while (out_pos[v] < out_end[v]) {
+        int first = num_poly_vertices;
+        int cur = v;
+
+        curve->polyline_vertices[num_poly_vertices++] = cur;
+        while (out_pos[cur] < out_end[cur]) {
+          const LSMLIB_REAL *x_start = &(hash.vertices[3*cur]);
+          const LSMLIB_REAL *x_end;
+          LSMLIB_REAL seg_x, seg_y, seg_z;
+
+          cur = edges[out_pos[cur]++].v_end;
+          x_end = &(hash.vertices[3*cur]);
+          seg_x = x_end[0] - x_start[0];
+          seg_y = x_end[1] - x_start[1];
+          seg_z = x_end[2] - x_start[2];
+          curve->length += sqrt(seg_x*seg_x + seg_y*seg_y + seg_z*seg_z);
+
+          curve->polyline_vertices[num_poly_vertices++] = cur;
+        }
+
+        /* do not repeat first vertex of closed polylines */
+        if ( (cur == v) && (num_poly_vertices - first > 2) ) {
+          num_poly_vertices--;
+          curve->polyline_is_closed[curve->num_polylines] = 1;
+        } else {
+          curve->polyline_is_closed[curve->num_polylines] = 0;
+        }
+        curve->num_polylines++;
+        curve->polyline_offsets[curve->num_polylines] = num_poly_vertices;
+      }
+    }
+  }
+  free(edges);
+  free(out_pos);
+  free(out_end);
+  free(in_degree);
+
+  /* keep only vertices used by polylines (numbered in the order */
+  /* that they appear in the polylines)                          */
+  vertex_map = (int*) malloc((hash.num_vertices+1)*sizeof(int));
+  for (v = 0; v < hash.num_vertices; v++) vertex_map[v] = -1;
+  curve->num_vertices = 0;
+  for (n = 0; n < num_poly_vertices; n++) {
+    v = curve->polyline_vertices[n];
+    if (vertex_map[v] < 0) vertex_map[v] = curve->num_vertices++;
+    curve->polyline_vertices[n] = vertex_map[v];
+  }
+  curve->vertices = (LSMLIB_REAL*) malloc(
+    (3*curve->num_vertices+1)*sizeof(LSMLIB_REAL));
+  for (v = 0; v < hash.num_vertices; v++) {
+    if (vertex_map[v] >= 0) {
+      int d;
+      for (d = 0; d < 3; d++) {
+        curve->vertices[3*vertex_map[v]+d] = hash.vertices[3*v+d];
+      }
+    }
+  }
+  free(vertex_map);
+  free(hash.vertices);
+
+  return curve;
+}
+
+
+void destroyZeroLevelSetCurve(ZeroLevelSetCurve *curve)
+{
+  if (curve) {
+    free(curve->vertices);
+    free(curve->polyline_offsets);
+    free(curve->polyline_vertices);
+    free(curve->polyline_is_closed);
+    free(curve);
+  }
+}
+
+
+void writeZeroLevelSetCurveToAsciiFile(
+  ZeroLevelSetCurve *curve,
+  char *file_name)
+{
+  FILE *fp;
+  int n, m;
+
+  fp = fopen(file_name, "w");
+  if (!fp) {
+    fprintf(stderr,
+      "ERROR: unable to open file '%s' for writing\n", file_name);
+    return;
+  }
+
+  for (n = 0; n < curve->num_polylines; n++) {
+    int first = curve->polyline_offsets[n];
+    int last = curve->polyline_offsets[n+1];
+
+    if (n > 0) fprintf(fp, "NaN NaN NaN\n");
+    for (m = first; m < last; m++) {
+      LSMLIB_REAL *x = &(curve->vertices[3*curve->polyline_vertices[m]]);
+      fprintf(fp, "%.12g %.12g %.12g\n", x[0], x[1], x[2]);
+    }
+    if (curve->polyline_is_closed[n]) {
+      LSMLIB_REAL *x = &(curve->vertices[3*curve->polyline_vertices[first]]);
+      fprintf(fp, "%.12g %.12g %.12g\n", x[0], x[1], x[2]);
+    }
+  }
+
+  fclose(fp);
+}
@@ -0,0 +1,200 @@
+/*
+ * File:        lsm_zero_level_set_curve.h
+ * Copyrights:  (c) 2005 The Trustees of Princeton University and Board of
+ *                  Regents of the University of Texas.  All rights reserved.
+ *              (c) 2009 Kevin T. Chu.  All rights reserved.
+ * Revision:    $Revision$
+ * Modified:    $Date$
+ * Description: Header file for extraction of curves defined by the
+ *              zero level sets of two level set functions
+ */
+
+#ifndef included_lsm_zero_level_set_curve_h
+#define included_lsm_zero_level_set_curve_h
+
+#include "LSMLIB_config.h"
+#include "lsm_grid.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+
+/*! \file lsm_zero_level_set_curve.h
+ *
+ * \brief
+ * @ref lsm_zero_level_set_curve.h provides support for extracting the
+ * curve \f$ \{ \phi = 0, \psi = 0 \} \f$ in codimension-two level set
+ * method calculations in three space dimensions.
+ *
+ * The curve is computed by decomposing each grid cell into six
+ * tetrahedra and finding the line segment within each tetrahedron
+ * where the linear interpolants of \f$ \phi \f$ and \f$ \psi \f$
+ * vanish (see LSM3D_findLineSegmentsInBox() in @ref lsm_geometry3d.h).
+ * The line segments are then joined into polylines.
+ *
+ * Typical usage:
+ *  -# extract the curve with extractZeroLevelSetCurve3d()
+ *  -# use the polylines (or write them to a file with
+ *     writeZeroLevelSetCurveToAsciiFile())
+ *  -# free the curve with destroyZeroLevelSetCurve()
+ *
+ * When only the length of the curve is required,
+ * computeLengthOfZeroLevelSetCurve3d() avoids the cost of joining the
+ * line segments.
+ *
+ */
+
+
+/*!
+ * The 'ZeroLevelSetCurve' structure contains a curve represented as a
+ * collection of polylines.
+ */
+typedef struct _ZeroLevelSetCurve {
+
+  /* vertex coordinates (x,y,z for each vertex) */
+  int num_vertices;
+  LSMLIB_REAL *vertices;
+
+  /* polylines: the vertices of polyline n are                      */
+  /*   polyline_vertices[polyline_offsets[n]] through               */
+  /*   polyline_vertices[polyline_offsets[n+1]-1].                  */
+  /* NOTE: the first vertex of a closed polyline is NOT repeated at */
+  /*       the end of the polyline.                                 */
+  int num_polylines;
+  int *polyline_offsets;         /* num_polylines+1 entries */
+  int *polyline_vertices;
+  int *polyline_is_closed;       /* 1 if polyline is closed; 0 otherwise */
+
+  /* total length of curve */
+  LSMLIB_REAL length;
+
+} ZeroLevelSetCurve;
+
+
+/*!
+ * extractZeroLevelSetCurve3d() extracts the curve defined by the zero
+ * level sets of \f$ \phi \f$ and \f$ \psi \f$ as a collection of
+ * polylines.
+ *
+ * Arguments:
+ *  - phi (in):   level set function \f$ \phi \f$
+ *  - psi (in):   level set function \f$ \psi \f$
+ *  - grid (in):  pointer to Grid
+ *
+ * Return value:  pointer to new ZeroLevelSetCurve; NULL if an error
+ *                occurred
+ *
+ * NOTES:
+ *  - Only the grid cells whose corners all lie in the interior of the
+ *    computational domain (i.e. the fillbox) are used.
+ *
+ *  - Polylines are oriented in the direction of
+ *    \f$ \nabla \phi \times \nabla \psi \f$.
+ *
+ *  - When LSMLIB is compiled with OpenMP enabled, the z-slabs of the
+ *    grid are processed in parallel.  The result does not depend on
+ *    the number of threads.
+ *
+ */
+ZeroLevelSetCurve *extractZeroLevelSetCurve3d(
+  LSMLIB_REAL *phi,
+  LSMLIB_REAL *psi,
+  Grid *grid);
+
+/*!
+ * computeLengthOfZeroLevelSetCurve3d() computes the length of the
+ * curve defined by the zero level sets of \f$ \phi \f$ and \f$ \psi \f$.
+ *
+ * Arguments:
+ *  - phi (in):   level set function \f$ \phi \f$
+ *  - psi (in):   level set function \f$ \psi \f$
+ *  - grid (in):  pointer to Grid
+ *
+ * Return value:  length of curve; negative if an error occurred
+ *
+ * NOTES:
+ *  - The same grid cells are used as in extractZeroLevelSetCurve3d(),
+ *    so the result agrees with the length of the extracted curve
+ *    (up to round-off).
+ *
+ */
+LSMLIB_REAL computeLengthOfZeroLevelSetCurve3d(
+  LSMLIB_REAL *phi,
+  LSMLIB_REAL *psi,
+  Grid *grid);
+
+/*!
+ * createZeroLevelSetCurveFromSegments() joins line segments into
+ * polylines.
+ *
+ * Arguments:
+ *  - num_segments (in):  number of line segments
+ *  - segments (in):      endpoints of line segments (x,y,z of first
+ *                        endpoint followed by x,y,z of second endpoint
+ *                        for each segment)
+ *  - tolerance (in):     distance within which endpoints are considered
+ *                        to be the same vertex
+ *
+ * Return value:          pointer to new ZeroLevelSetCurve; NULL if
+ *                        tolerance is not positive
+ *
+ * NOTES:
+ *  - Segments are joined only when the second endpoint of one segment
+ *    coincides with the first endpoint of the next, so the segments
+ *    should be consistently oriented (as are the segments computed by
+ *    LSM3D_findLineSegmentsInBox()).
+ *
+ *  - Segments that appear more than once (e.g. segments computed on
+ *    the faces of adjacent patches) are used only once, and segments
+ *    whose endpoints coincide are discarded.
+ *
+ *  - This function is useful for joining segments gathered from
+ *    several patches (e.g. by
+ *    LevelSetMethodToolbox::extractZeroLevelSetCurveSegments()).
+ *
+ */
+ZeroLevelSetCurve *createZeroLevelSetCurveFromSegments(
+  int num_segments,
+  LSMLIB_REAL *segments,
+  LSMLIB_REAL tolerance);
+
+/*!
+ * destroyZeroLevelSetCurve() frees the memory associated with a
+ * ZeroLevelSetCurve.
+ *
+ * Arguments:
+ *  - curve (in):  pointer to ZeroLevelSetCurve
+ *
+ * Return value:   none
+ *
+ */
+void destroyZeroLevelSetCurve(ZeroLevelSetCurve *curve);
+
+/*!
+ * writeZeroLevelSetCurveToAsciiFile() writes the polylines of a
+ * ZeroLevelSetCurve to an ASCII file.
+ *
+ * Arguments:
+ *  - curve (in):      pointer to ZeroLevelSetCurve
+ *  - file_name (in):  name of output file
+ *
+ * Return value:       none
+ *
+ * NOTES:
+ *  - Each line of the file contains the coordinates of one vertex.
+ *    Polylines are separated by a line containing "NaN NaN NaN", and
+ *    the first vertex of each closed polyline is repeated at the end
+ *    of the polyline, so the file can be loaded and plotted directly
+ *    in MATLAB (e.g. with plot3()).
+ *
+ */
+void writeZeroLevelSetCurveToAsciiFile(
+  ZeroLevelSetCurve *curve,
+  char *file_name);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
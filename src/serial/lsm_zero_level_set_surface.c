@@ -0,0 +1,921 @@
+/*
+ * File:        lsm_zero_level_set_surface.c
+ * Copyrights:  (c) 2005 The Trustees of Princeton University and Board of
+ *                  Regents of the University of Texas.  All rights reserved.
+ *              (c) 2009 Kevin T. Chu.  All rights reserved.
+ * Revision:    $Revision$
+ * Modified:    $Date$
+ * Description: Implementation file for extraction of the zero level set
+ *              as a triangle mesh (3D) or line segment mesh (2D)
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "lsm_zero_level_set_surface.h"
+
+/* initial sizes of vertex, element, and edge table arrays */
+#define LSM_ZLS_SURFACE_INITIAL_SIZE        (1024)
+
+/* number of keys reserved for the edges emanating from each grid point */
+#define LSM_ZLS_SURFACE_EDGES_PER_POINT     (8)
+
+
+/*========================= Helper Data Structures ========================*/
+
+/*
+ * Corners of a grid cell are numbered using the bits of the corner
+ * index:  bit 0 = x-offset, bit 1 = y-offset, bit 2 = z-offset.
+ *
+ * Each grid cell is decomposed into simplices that share the main
+ * diagonal of the cell.  The corners of each simplex are listed so
+ * that the offset of every corner contains the offsets of the
+ * preceding corners, so every edge of a simplex is identified by its
+ * lower corner and its direction (a nonzero bitmask).
+ *
+ * The parity of a simplex is the sign of the determinant of the edge
+ * vectors from its first corner to its remaining corners (i.e. the sign
+ * of the permutation of the coordinate directions traversed along the
+ * path from corner 0 to the opposite corner of the cell).
+ */
+static const int LSM_ZLS_SURFACE_TRIANGLES[2][3] = {
+  {0, 1, 3}, {0, 2, 3}
+};
+static const int LSM_ZLS_SURFACE_TRIANGLE_PARITY[2] = {1, -1};
+static const int LSM_ZLS_SURFACE_TETRAHEDRA[6][4] = {
+  {0, 1, 3, 7}, {0, 1, 5, 7}, {0, 2, 3, 7},
+  {0, 2, 6, 7}, {0, 4, 5, 7}, {0, 4, 6, 7}
+};
+static const int LSM_ZLS_SURFACE_TETRAHEDRON_PARITY[6] = {
+  1, -1, -1, 1, 1, -1
+};
+
+/* hash table that maps cell edges to surface vertices */
+typedef struct {
+  int capacity;              /* power of 2 */
+  int num_entries;
+  long *keys;                /* -1 for empty slots */
+  int *vertex_idx;
+} EdgeVertexTable;
+
+/* description of the data arrays used to compute the surface */
+typedef struct {
+  const LSMLIB_REAL *phi;
+  int phi_stride[3];
+  const LSMLIB_REAL *field;  /* NULL if no vertex field */
+  int field_stride[3];
+  LSMLIB_REAL dx[3];
+} SurfaceArrays;
+
+
+/*========================= Helper Functions ==============================*/
+
+static EdgeVertexTable *createEdgeVertexTable(void)
+{
+  EdgeVertexTable *table = (EdgeVertexTable*) malloc(sizeof(EdgeVertexTable));
+  int i;
+  if (!table) return NULL;
+  table->capacity = LSM_ZLS_SURFACE_INITIAL_SIZE;
+  table->num_entries = 0;
+  table->keys = (long*) malloc(table->capacity*sizeof(long));
+  table->vertex_idx = (int*) malloc(table->capacity*sizeof(int));
+  if (!table->keys || !table->vertex_idx) {
+    free(table->keys); free(table->vertex_idx); free(table);
+    return NULL;
+  }
+  for (i = 0; i < table->capacity; i++) table->keys[i] = -1;
+  return table;
+}
+
+static void destroyEdgeVertexTable(EdgeVertexTable *table)
+{
+  if (!table) return;
+  free(table->keys);
+  free(table->vertex_idx);
+  free(table);
+}
+
+static int hashEdgeKey(long key, int capacity)
+{
+  unsigned long h = ((unsigned long) key)*11400714819323198485UL;
+  h ^= (h >> 29);
+  return (int) (h & (unsigned long) (capacity-1));
+}
+
+/* returns slot containing key or the empty slot where it belongs */
+static int findEdgeSlot(const EdgeVertexTable *table, long key)
+{
+  int slot = hashEdgeKey(key, table->capacity);
+  while ( (table->keys[slot] != -1) && (table->keys[slot] != key) ) {
+    slot = (slot+1) & (table->capacity-1);
+  }
+  return slot;
+}
+
+static int growEdgeVertexTable(EdgeVertexTable *table)
+{
+  const int old_capacity = table->capacity;
+  long *old_keys = table->keys;
+  int *old_vertex_idx = table->vertex_idx;
+  int i;
+
+  table->capacity = 2*old_capacity;
+  table->keys = (long*) malloc(table->capacity*sizeof(long));
+  table->vertex_idx = (int*) malloc(table->capacity*sizeof(int));
+  if (!table->keys || !table->vertex_idx) {
+    free(table->keys); free(table->vertex_idx);
+    table->keys = old_keys;
+    table->vertex_idx = old_vertex_idx;
+    table->capacity = old_capacity;
+    return 1;
+  }
+  for (i = 0; i < table->capacity; i++) table->keys[i] = -1;
+  for (i = 0; i < old_capacity; i++) {
+    if (old_keys[i] != -1) {
+      int slot = findEdgeSlot(table, old_keys[i]);
+      table->keys[slot] = old_keys[i];
+      table->vertex_idx[slot] = old_vertex_idx[i];
+    }
+  }
+  free(old_keys);
+  free(old_vertex_idx);
+  return 0;
+}
+
+static int reserveSurfaceVertices(ZeroLevelSetSurface *surface, int num_new)
+{
+  int size = surface->max_num_vertices;
+  LSMLIB_REAL *vertices, *vertex_field;
+
+  if (surface->num_vertices + num_new <= size) return 0;
+  while (surface->num_vertices + num_new > size) size *= 2;
+
+  vertices = (LSMLIB_REAL*) realloc(surface->vertices,
+    surface->num_dims*size*sizeof(LSMLIB_REAL));
+  if (!vertices) return 1;
+  surface->vertices = vertices;
+  if (surface->vertex_field) {
+    vertex_field = (LSMLIB_REAL*) realloc(surface->vertex_field,
+      size*sizeof(LSMLIB_REAL));
+    if (!vertex_field) return 1;
+    surface->vertex_field = vertex_field;
+  }
+  surface->max_num_vertices = size;
+  return 0;
+}
+
+static int reserveSurfaceElements(ZeroLevelSetSurface *surface, int num_new)
+{
+  int size = surface->max_num_elements;
+  int *elements;
+
+  if (surface->num_elements + num_new <= size) return 0;
+  while (surface->num_elements + num_new > size) size *= 2;
+
+  elements = (int*) realloc(surface->elements,
+    surface->num_dims*size*sizeof(int));
+  if (!elements) return 1;
+  surface->elements = elements;
+  surface->max_num_elements = size;
+  return 0;
+}
+
+/*
+ * getEdgeVertex() returns the index of the surface vertex on the edge
+ * from corner 'lo' to corner 'hi' of the grid cell, creating the vertex
+ * if it does not already exist; -1 is returned if memory could not be
+ * allocated.
+ */
+static int getEdgeVertex(
+  ZeroLevelSetSurface *surface,
+  EdgeVertexTable *table,
+  const SurfaceArrays *arrays,
+  const int phi_idx,
+  const int field_idx,
+  const LSMLIB_REAL *x_corner,
+  const LSMLIB_REAL *phi_corner,
+  int lo,
+  int hi)
+{
+  const int num_dims = surface->num_dims;
+  int dir = hi ^ lo;
+  int lo_offset = 0;
+  long key;
+  int slot, v, dim;
+  LSMLIB_REAL t;
+
+  /* vertices that lie within a relative distance LSMLIB_ZERO_TOL of */
+  /* a grid point (e.g. because phi at the grid point is zero up to  */
+  /* roundoff) are moved onto the grid point and identified by the   */
+  /* grid point alone so that they are shared by all edges that meet */
+  /* at the grid point.  Otherwise, nearly coincident vertices would */
+  /* produce elements with (nearly) zero area.                       */
+  t = phi_corner[lo]/(phi_corner[lo] - phi_corner[hi]);
+  if (t <= LSMLIB_ZERO_TOL) {
+    t = 0.0;
+    dir = 0;
+  } else if (t >= 1.0 - LSMLIB_ZERO_TOL) {
+    t = 0.0;
+    lo = hi;
+    dir = 0;
+  }
+
+  for (dim = 0; dim < num_dims; dim++) {
+    if (lo & (1<<dim)) lo_offset += arrays->phi_stride[dim];
+  }
+  key = ((long) (phi_idx + lo_offset))*LSM_ZLS_SURFACE_EDGES_PER_POINT + dir;
+
+  slot = findEdgeSlot(table, key);
+  if (table->keys[slot] == key) return table->vertex_idx[slot];
+
+  /* create new vertex */
+  if (reserveSurfaceVertices(surface, 1)) return -1;
+  v = surface->num_vertices++;
+  for (dim = 0; dim < num_dims; dim++) {
+    LSMLIB_REAL offset = ((lo>>dim) & 1) + t*((dir>>dim) & 1);
+    surface->vertices[num_dims*v+dim] = x_corner[dim]
+                                      + offset*arrays->dx[dim];
+  }
+  if (surface->vertex_field) {
+    int lo_field_offset = 0, hi_field_offset = 0;
+    for (dim = 0; dim < num_dims; dim++) {
+      if (lo & (1<<dim)) lo_field_offset += arrays->field_stride[dim];
+      if (hi & (1<<dim)) hi_field_offset += arrays->field_stride[dim];
+    }
+    surface->vertex_field[v] =
+      (1.0-t)*arrays->field[field_idx+lo_field_offset]
+      + t*arrays->field[field_idx+hi_field_offset];
+  }
+
+  /* record vertex in edge table */
+  table->keys[slot] = key;
+  table->vertex_idx[slot] = v;
+  table->num_entries++;
+  if (2*table->num_entries > table->capacity) {
+    if (growEdgeVertexTable(table)) return -1;
+  }
+
+  return v;
+}
+
+/*
+ * addElement() appends an element to the surface, reversing its 
+ * orientation if 'reverse' is nonzero.  Degenerate elements (i.e. 
+ * elements with repeated vertices) are discarded.  Returns the number
+ * of elements added or -1 if memory could not be allocated.
+ */
+static int addElement(
+  ZeroLevelSetSurface *surface,
+  const int *vertex,
+  const int reverse)
+{
+  const int num_dims = surface->num_dims;
+  int *element;
+
+  if ( (vertex[0] == vertex[1])
+    || ( (num_dims == 3) 
+      && ((vertex[2] == vertex[0]) || (vertex[2] == vertex[1])) ) ) {
+    return 0;
+  }
+  if (reserveSurfaceElements(surface, 1)) return -1;
+
+  /* reverse order of last two vertices if requested */
+  element = &(surface->elements[num_dims*surface->num_elements]);
+  if (num_dims == 2) {
+    element[0] = reverse ? vertex[1] : vertex[0];
+    element[1] = reverse ? vertex[0] : vertex[1];
+  } else {
+    element[0] = vertex[0];
+    element[1] = reverse ? vertex[2] : vertex[1];
+    element[2] = reverse ? vertex[1] : vertex[2];
+  }
+  surface->num_elements++;
+
+  return 1;
+}
+
+/*
+ * addCell() adds the zero level set within the grid cell whose lower
+ * corner has linear index phi_idx (field_idx) in the phi (field) array
+ * and coordinates x_corner.  Returns the number of elements added or
+ * -1 if memory could not be allocated.
+ */
+static int addCell(
+  ZeroLevelSetSurface *surface,
+  EdgeVertexTable *table,
+  const SurfaceArrays *arrays,
+  const int phi_idx,
+  const int field_idx,
+  const LSMLIB_REAL *x_corner)
+{
+  const int num_dims = surface->num_dims;
+  const int num_corners = 1<<num_dims;
+  const int num_simplices = (num_dims == 2) ? 2 : 6;
+  LSMLIB_REAL phi_corner[8];
+  int num_pos;
+  int num_added = 0;
+  int c, s, dim;
+
+  /* gather values of phi at corners of cell */
+  num_pos = 0;
+  for (c = 0; c < num_corners; c++) {
+    int offset = 0;
+    for (dim = 0; dim < num_dims; dim++) {
+      if (c & (1<<dim)) offset += arrays->phi_stride[dim];
+    }
+    phi_corner[c] = arrays->phi[phi_idx+offset];
+    if (phi_corner[c] > 0) num_pos++;
+  }
+  if ( (num_pos == 0) || (num_pos == num_corners) ) return 0;
+
+  for (s = 0; s < num_simplices; s++) {
+
+    const int *corner = (num_dims == 2) ? LSM_ZLS_SURFACE_TRIANGLES[s]
+                                        : LSM_ZLS_SURFACE_TETRAHEDRA[s];
+    const int parity = (num_dims == 2) ? LSM_ZLS_SURFACE_TRIANGLE_PARITY[s]
+                                       : LSM_ZLS_SURFACE_TETRAHEDRON_PARITY[s];
+    int pos[4], neg[4];        /* positions of corners within simplex */
+    int n_pos = 0, n_neg = 0;
+    int vertex[4];
+    int reverse;
+    int num_new;
+    int k;
+
+    for (k = 0; k <= num_dims; k++) {
+      if (phi_corner[corner[k]] > 0) {
+        pos[n_pos++] = k;
+      } else {
+        neg[n_neg++] = k;
+      }
+    }
+    if ( (n_pos == 0) || (n_neg == 0) ) continue;
+
+    /* 
+     * The orientation of each element is determined from the sign
+     * pattern of phi at the corners of the simplex and the parity of
+     * the simplex so that the normal of every element points towards
+     * the region where phi is positive.  Unlike a geometric test, this
+     * orientation does not depend on the positions of the vertices, 
+     * so it is consistent between neighboring elements even when the
+     * elements are (nearly) degenerate.
+     */
+    if ( (n_pos == 1) || (n_neg == 1) ) {
+
+      /* single element from edges adjacent to isolated corner.  For */
+      /* a simplex with positive parity and an isolated negative     */
+      /* corner in position 0, the element with vertices listed in   */
+      /* the order of the other corners is correctly oriented.       */
+      const int iso = (n_pos == 1) ? pos[0] : neg[0];
+      const int *other = (n_pos == 1) ? neg : pos;
+      int orientation = (iso%2 == 0) ? parity : -parity;
+      if (n_pos == 1) orientation = -orientation;
+      reverse = (orientation < 0);
+
+      for (k = 0; k < num_dims; k++) {
+        int lo = corner[iso];
+        int hi = corner[other[k]];
+        if (lo > hi) {
+          hi = lo;
+          lo = corner[other[k]];
+        }
+        vertex[k] = getEdgeVertex(surface, table, arrays, phi_idx, field_idx,
+                                  x_corner, phi_corner, lo, hi);
+        if (vertex[k] < 0) return -1;
+      }
+      num_new = addElement(surface, vertex, reverse);
+      if (num_new < 0) return -1;
+      num_added += num_new;
+
+    } else {
+
+      /* two positive and two negative corners (3D only): the zero  */
+      /* level set is a quadrilateral, which is split in two.  For  */
+      /* a simplex with positive parity and positive corners in     */
+      /* positions 0 and 1, the quadrilateral must be reversed; the */
+      /* orientation changes sign with the parity of the            */
+      /* permutation (pos[0],pos[1],neg[0],neg[1]).                 */
+      int quad[4], tri[3];
+      int edge_lo[4], edge_hi[4];
+      int perm[4] = {pos[0], pos[1], neg[0], neg[1]};
+      int perm_parity = 1;
+      int l;
+      for (k = 0; k < 4; k++) {
+        for (l = k+1; l < 4; l++) {
+          if (perm[k] > perm[l]) perm_parity = -perm_parity;
+        }
+      }
+      reverse = (parity*perm_parity > 0);
+
+      edge_lo[0] = corner[pos[0]]; edge_hi[0] = corner[neg[0]];
+      edge_lo[1] = corner[pos[0]]; edge_hi[1] = corner[neg[1]];
+      edge_lo[2] = corner[pos[1]]; edge_hi[2] = corner[neg[1]];
+      edge_lo[3] = corner[pos[1]]; edge_hi[3] = corner[neg[0]];
+      for (k = 0; k < 4; k++) {
+        int lo = (edge_lo[k] < edge_hi[k]) ? edge_lo[k] : edge_hi[k];
+        int hi = (edge_lo[k] < edge_hi[k]) ? edge_hi[k] : edge_lo[k];
+        quad[k] = getEdgeVertex(surface, table, arrays, phi_idx, field_idx,
+                                x_corner, phi_corner, lo, hi);
+        if (quad[k] < 0) return -1;
+      }
+      tri[0] = quad[0]; tri[1] = quad[1]; tri[2] = quad[2];
+      num_new = addElement(surface, tri, reverse);
+      if (num_new < 0) return -1;
+      num_added += num_new;
+      tri[0] = quad[0]; tri[1] = quad[2]; tri[2] = quad[3];
+      num_new = addElement(surface, tri, reverse);
+      if (num_new < 0) return -1;
+      num_added += num_new;
+
+    }
+
+  } /* end loop over simplices */
+
+  return num_added;
+}
+
+/* computes strides of an array with the specified ghostbox */
+static void computeStrides(int *stride, const int *gb, const int num_dims)
+{
+  int dim;
+  stride[0] = 1;
+  stride[1] = stride[2] = 0;
+  for (dim = 1; dim < num_dims; dim++) {
+    stride[dim] = stride[dim-1]*(gb[2*dim-1] - gb[2*dim-2] + 1);
+  }
+}
+
+/* sets up the phi_gb and fillbox cell ranges for a Grid */
+static int setupGridBoxes(
+  ZeroLevelSetSurface *surface,
+  Grid *grid,
+  int *gb,
+  int *ib,
+  const char *function_name)
+{
+  const int *fb_lo[3];
+  const int *fb_hi[3];
+  int dim;
+
+  if ( !surface || (grid->num_dims != surface->num_dims) ) {
+    fprintf(stderr,
+      "ERROR: %s() requires a ZeroLevelSetSurface with the same number\n",
+      function_name);
+    fprintf(stderr,
+      "       of dimensions as the grid\n");
+    return 1;
+  }
+
+  fb_lo[0] = &(grid->ilo_fb); fb_hi[0] = &(grid->ihi_fb);
+  fb_lo[1] = &(grid->jlo_fb); fb_hi[1] = &(grid->jhi_fb);
+  fb_lo[2] = &(grid->klo_fb); fb_hi[2] = &(grid->khi_fb);
+  for (dim = 0; dim < grid->num_dims; dim++) {
+    gb[2*dim] = 0;
+    gb[2*dim+1] = grid->grid_dims_ghostbox[dim]-1;
+    ib[2*dim] = *(fb_lo[dim]);
+    ib[2*dim+1] = *(fb_hi[dim])-1;
+  }
+  return 0;
+}
+
+/* common implementation of the narrow band extraction routines */
+static int extractZeroLevelSetSurfaceLocal(
+  ZeroLevelSetSurface *surface,
+  LSMLIB_REAL *phi,
+  LSMLIB_REAL *field,
+  Grid *grid,
+  int **index,
+  int nlo_index,
+  int nhi_index,
+  unsigned char *narrow_band,
+  unsigned char mark_fb,
+  const char *function_name)
+{
+  const int num_dims = surface ? surface->num_dims : 0;
+  const int num_corners = 1<<num_dims;
+  SurfaceArrays arrays;
+  EdgeVertexTable *table;
+  int gb[6], ib[6];
+  int num_added = 0;
+  int l, c, dim;
+
+  if (setupGridBoxes(surface, grid, gb, ib, function_name)) return -1;
+
+  arrays.phi = phi;
+  arrays.field = surface->vertex_field ? field : NULL;
+  computeStrides(arrays.phi_stride, gb, num_dims);
+  computeStrides(arrays.field_stride, gb, num_dims);
+  for (dim = 0; dim < 3; dim++) arrays.dx[dim] = grid->dx[dim];
+
+  table = createEdgeVertexTable();
+  if (!table) return -1;
+
+  for (l = nlo_index; l <= nhi_index; l++) {
+
+    int idx = 0;
+    int in_band = 1;
+    LSMLIB_REAL x_corner[3];
+    int num_cell_elements;
+
+    for (dim = 0; dim < num_dims; dim++) {
+      int i = index[dim][l];
+      if ( (i < gb[2*dim]) || (i >= gb[2*dim+1]) ) in_band = 0;
+      idx += (i - gb[2*dim])*arrays.phi_stride[dim];
+      x_corner[dim] = grid->x_lo_ghostbox[dim]
+                    + (i - gb[2*dim])*grid->dx[dim];
+    }
+    if (!in_band) continue;
+
+    /* check that all corners of the cell are in the narrow band */
+    for (c = 0; (c < num_corners) && in_band; c++) {
+      int offset = 0;
+      unsigned char nb_value;
+      for (dim = 0; dim < num_dims; dim++) {
+        if (c & (1<<dim)) offset += arrays.phi_stride[dim];
+      }
+      nb_value = narrow_band[idx+offset];
+      if ( (nb_value == 0) || (nb_value > mark_fb) ) in_band = 0;
+    }
+    if (!in_band) continue;
+
+    num_cell_elements = addCell(surface, table, &arrays, idx, idx, x_corner);
+    if (num_cell_elements < 0) {
+      fprintf(stderr,
+        "ERROR: %s() failed to allocate memory\n", function_name);
+      destroyEdgeVertexTable(table);
+      return -1;
+    }
+    num_added += num_cell_elements;
+
+  } /* end loop over narrow band points */
+
+  destroyEdgeVertexTable(table);
+  return num_added;
+}
+
+
+/*========================= Library Functions =============================*/
+
+ZeroLevelSetSurface *createZeroLevelSetSurface(
+  int num_dims,
+  int has_vertex_field)
+{
+  ZeroLevelSetSurface *surface;
+
+  if ( (num_dims != 2) && (num_dims != 3) ) {
+    fprintf(stderr,
+      "ERROR: createZeroLevelSetSurface() requires num_dims = 2 or 3\n");
+    return NULL;
+  }
+
+  surface = (ZeroLevelSetSurface*) malloc(sizeof(ZeroLevelSetSurface));
+  surface->num_dims = num_dims;
+  surface->num_vertices = 0;
+  surface->num_elements = 0;
+  surface->max_num_vertices = LSM_ZLS_SURFACE_INITIAL_SIZE;
+  surface->max_num_elements = LSM_ZLS_SURFACE_INITIAL_SIZE;
+  surface->vertices = (LSMLIB_REAL*) malloc(
+    num_dims*surface->max_num_vertices*sizeof(LSMLIB_REAL));
+  surface->vertex_field = has_vertex_field ?
+    (LSMLIB_REAL*) malloc(surface->max_num_vertices*sizeof(LSMLIB_REAL)) :
+    NULL;
+  surface->elements = (int*) malloc(
+    num_dims*surface->max_num_elements*sizeof(int));
+
+  return surface;
+}
+
+
+void resetZeroLevelSetSurface(ZeroLevelSetSurface *surface)
+{
+  if (!surface) return;
+  surface->num_vertices = 0;
+  surface->num_elements = 0;
+}
+
+
+void destroyZeroLevelSetSurface(ZeroLevelSetSurface *surface)
+{
+  if (!surface) return;
+  free(surface->vertices);
+  free(surface->vertex_field);
+  free(surface->elements);
+  free(surface);
+}
+
+
+int extractZeroLevelSetSurface2d(
+  ZeroLevelSetSurface *surface,
+  LSMLIB_REAL *phi,
+  LSMLIB_REAL *field,
+  Grid *grid)
+{
+  int gb[6], ib[6];
+
+  if (setupGridBoxes(surface, grid, gb, ib, "extractZeroLevelSetSurface2d"))
+    return -1;
+
+  return addZeroLevelSetSurfaceInBox(surface, phi, gb, field, gb,
+                                     NULL, gb, ib,
+                                     grid->x_lo_ghostbox, grid->dx);
+}
+
+
+int extractZeroLevelSetSurface3d(
+  ZeroLevelSetSurface *surface,
+  LSMLIB_REAL *phi,
+  LSMLIB_REAL *field,
+  Grid *grid)
+{
+  int gb[6], ib[6];
+
+  if (setupGridBoxes(surface, grid, gb, ib, "extractZeroLevelSetSurface3d"))
+    return -1;
+
+  return addZeroLevelSetSurfaceInBox(surface, phi, gb, field, gb,
+                                     NULL, gb, ib,
+                                     grid->x_lo_ghostbox, grid->dx);
+}
+
+
+int extractZeroLevelSetSurfaceLocal2d(
+  ZeroLevelSetSurface *surface,
+  LSMLIB_REAL *phi,
+  LSMLIB_REAL *field,
+  Grid *grid,
+  int *index_x,
+  int *index_y,
+  int nlo_index,
+  int nhi_index,
+  unsigned char *narrow_band,
+  unsigned char mark_fb)
+{
+  int *index[2];
+  index[0] = index_x;
+  index[1] = index_y;
+  return extractZeroLevelSetSurfaceLocal(surface, phi, field, grid,
+                                         index, nlo_index, nhi_index,
+                                         narrow_band, mark_fb,
+                                         "extractZeroLevelSetSurfaceLocal2d");
+}
+
+
+int extractZeroLevelSetSurfaceLocal3d(
+  ZeroLevelSetSurface *surface,
+  LSMLIB_REAL *phi,
+  LSMLIB_REAL *field,
+  Grid *grid,
+  int *index_x,
+  int *index_y,
+  int *index_z,
+  int nlo_index,
+  int nhi_index,
+  unsigned char *narrow_band,
+  unsigned char mark_fb)
+{
+  int *index[3];
+  index[0] = index_x;
+  index[1] = index_y;
+  index[2] = index_z;
+  return extractZeroLevelSetSurfaceLocal(surface, phi, field, grid,
+                                         index, nlo_index, nhi_index,
+                                         narrow_band, mark_fb,
+                                         "extractZeroLevelSetSurfaceLocal3d");
+}
+
+
+int addZeroLevelSetSurfaceInBox(
+  ZeroLevelSetSurface *surface,
+  const LSMLIB_REAL *phi,
+  const int *phi_gb,
+  const LSMLIB_REAL *field,
+  const int *field_gb,
+  const LSMLIB_REAL *control_vol,
+  const int *control_vol_gb,
+  const int *ib,
+  const LSMLIB_REAL *x_lo,
+  const LSMLIB_REAL *dx)
+{
+  const int num_dims = surface->num_dims;
+  SurfaceArrays arrays;
+  EdgeVertexTable *table;
+  int control_vol_stride[3];
+  int lo[3] = {0, 0, 0}, hi[3] = {0, 0, 0};
+  int num_added = 0;
+  int i, j, k, dim;
+
+  arrays.phi = phi;
+  arrays.field = surface->vertex_field ? field : NULL;
+  computeStrides(arrays.phi_stride, phi_gb, num_dims);
+  computeStrides(arrays.field_stride, field_gb, num_dims);
+  computeStrides(control_vol_stride, control_vol_gb, num_dims);
+  for (dim = 0; dim < 3; dim++) {
+    arrays.dx[dim] = (dim < num_dims) ? dx[dim] : 0.0;
+  }
+
+  /* limit cells to those whose corners all lie in the ghostboxes */
+  for (dim = 0; dim < num_dims; dim++) {
+    lo[dim] = ib[2*dim];
+    hi[dim] = ib[2*dim+1];
+    if (lo[dim] < phi_gb[2*dim]) lo[dim] = phi_gb[2*dim];
+    if (hi[dim] > phi_gb[2*dim+1]-1) hi[dim] = phi_gb[2*dim+1]-1;
+    if (arrays.field) {
+      if (lo[dim] < field_gb[2*dim]) lo[dim] = field_gb[2*dim];
+      if (hi[dim] > field_gb[2*dim+1]-1) hi[dim] = field_gb[2*dim+1]-1;
+    }
+    if (control_vol) {
+      if (lo[dim] < control_vol_gb[2*dim]) lo[dim] = control_vol_gb[2*dim];
+      if (hi[dim] > control_vol_gb[2*dim+1]) hi[dim] = control_vol_gb[2*dim+1];
+    }
+    if (lo[dim] > hi[dim]) return 0;
+  }
+
+  table = createEdgeVertexTable();
+  if (!table) return -1;
+
+  for (k = lo[2]; k <= hi[2]; k++) {
+    for (j = lo[1]; j <= hi[1]; j++) {
+      for (i = lo[0]; i <= hi[0]; i++) {
+
+        const int cell[3] = {i, j, k};
+        int phi_idx = 0, field_idx = 0, control_vol_idx = 0;
+        LSMLIB_REAL x_corner[3];
+        int num_cell_elements;
+
+        for (dim = 0; dim < num_dims; dim++) {
+          phi_idx += (cell[dim] - phi_gb[2*dim])*arrays.phi_stride[dim];
+          field_idx += (cell[dim] - field_gb[2*dim])*arrays.field_stride[dim];
+          control_vol_idx +=
+            (cell[dim] - control_vol_gb[2*dim])*control_vol_stride[dim];
+          x_corner[dim] = x_lo[dim] + (cell[dim] - phi_gb[2*dim])*dx[dim];
+        }
+
+        /* skip cells excluded by control volume */
+        if ( control_vol && (control_vol[control_vol_idx] <= 0) ) continue;
+
+        num_cell_elements = addCell(surface, table, &arrays,
+                                    phi_idx, field_idx, x_corner);
+        if (num_cell_elements < 0) {
+          fprintf(stderr,
+            "ERROR: addZeroLevelSetSurfaceInBox() failed to allocate memory\n");
+          destroyEdgeVertexTable(table);
+          return -1;
+        }
+        num_added += num_cell_elements;
+
+      }
+    }
+  } /* end loop over grid cells */
+
+  destroyEdgeVertexTable(table);
+  return num_added;
+}
+
+
+int appendZeroLevelSetSurface(
+  ZeroLevelSetSurface *surface,
+  ZeroLevelSetSurface *other)
+{
+  const int num_dims = surface->num_dims;
+  const int vertex_offset = surface->num_vertices;
+  int n;
+
+  if (other->num_dims != num_dims) {
+    fprintf(stderr,
+      "ERROR: appendZeroLevelSetSurface() requires surfaces with the same\n");
+    fprintf(stderr,
+      "       number of dimensions\n");
+    return 1;
+  }
+  if ( reserveSurfaceVertices(surface, other->num_vertices)
+    || reserveSurfaceElements(surface, other->num_elements) ) {
+    fprintf(stderr,
+      "ERROR: appendZeroLevelSetSurface() failed to allocate memory\n");
+    return 1;
+  }
+
+  for (n = 0; n < num_dims*other->num_vertices; n++) {
+    surface->vertices[num_dims*vertex_offset+n] = other->vertices[n];
+  }
+  if (surface->vertex_field) {
+    for (n = 0; n < other->num_vertices; n++) {
+      surface->vertex_field[vertex_offset+n] =
+        (other->vertex_field) ? other->vertex_field[n] : 0.0;
+    }
+  }
+  for (n = 0; n < num_dims*other->num_elements; n++) {
+    surface->elements[num_dims*surface->num_elements+n] =
+      other->elements[n] + vertex_offset;
+  }
+  surface->num_vertices += other->num_vertices;
+  surface->num_elements += other->num_elements;
+
+  return 0;
+}
+
+
+int writeZeroLevelSetSurfaceToBinaryFile(
+  ZeroLevelSetSurface *surface,
+  char *file_name)
+{
+  FILE *fp;
+  int header[5];
+  int num_dims = surface->num_dims;
+
+  fp = fopen(file_name,"w");
+  if (!fp) {
+    fprintf(stderr,
+      "ERROR: writeZeroLevelSetSurfaceToBinaryFile() could not open %s\n",
+      file_name);
+    return 1;
+  }
+
+  header[0] = num_dims;
+  header[1] = (surface->vertex_field) ? 1 : 0;
+  header[2] = surface->num_vertices;
+  header[3] = surface->num_elements;
+  header[4] = sizeof(LSMLIB_REAL);
+  fwrite(header, sizeof(int), 5, fp);
+  fwrite(surface->vertices, sizeof(LSMLIB_REAL),
+         num_dims*surface->num_vertices, fp);
+  if (surface->vertex_field) {
+    fwrite(surface->vertex_field, sizeof(LSMLIB_REAL),
+           surface->num_vertices, fp);
+  }
+  fwrite(surface->elements, sizeof(int), num_dims*surface->num_elements, fp);
+
+  fclose(fp);
+  return 0;
+}
+
+
+ZeroLevelSetSurface *readZeroLevelSetSurfaceFromBinaryFile(
+  char *file_name)
+{
+  ZeroLevelSetSurface *surface;
+  FILE *fp;
+  int header[5];
+  int num_dims;
+  int ok;
+
+  fp = fopen(file_name,"r");
+  if (!fp) {
+    fprintf(stderr,
+      "ERROR: readZeroLevelSetSurfaceFromBinaryFile() could not open %s\n",
+      file_name);
+    return NULL;
+  }
+
+  if ( (fread(header, sizeof(int), 5, fp) != 5)
+    || (header[4] != sizeof(LSMLIB_REAL)) ) {
+    fprintf(stderr,
+      "ERROR: readZeroLevelSetSurfaceFromBinaryFile() found invalid header\n");
+    fprintf(stderr,
+      "       or precision mismatch in %s\n", file_name);
+    fclose(fp);
+    return NULL;
+  }
+
+  num_dims = header[0];
+  surface = createZeroLevelSetSurface(num_dims, header[1]);
+  if (!surface) {
+    fclose(fp);
+    return NULL;
+  }
+  if ( reserveSurfaceVertices(surface, header[2])
+    || reserveSurfaceElements(surface, header[3]) ) {
+    fprintf(stderr,
+      "ERROR: readZeroLevelSetSurfaceFromBinaryFile() failed to allocate\n");
+    fprintf(stderr,
+      "       memory\n");
+    destroyZeroLevelSetSurface(surface);
+    fclose(fp);
+    return NULL;
+  }
+  surface->num_vertices = header[2];
+  surface->num_elements = header[3];
+
+  ok = (fread(surface->vertices, sizeof(LSMLIB_REAL),
+              num_dims*surface->num_vertices, fp)
+        == (size_t) (num_dims*surface->num_vertices));
+  if (ok && surface->vertex_field) {
+    ok = (fread(surface->vertex_field, sizeof(LSMLIB_REAL),
+                surface->num_vertices, fp)
+          == (size_t) surface->num_vertices);
+  }
+  if (ok) {
+    ok = (fread(surface->elements, sizeof(int),
+                num_dims*surface->num_elements, fp)
+          == (size_t) (num_dims*surface->num_elements));
+  }
+  fclose(fp);
+
+  if (!ok) {
+    fprintf(stderr,
+      "ERROR: readZeroLevelSetSurfaceFromBinaryFile() could not read %s\n",
+      file_name);
+    destroyZeroLevelSetSurface(surface);
+    return NULL;
+  }
+
+  return surface;
+}
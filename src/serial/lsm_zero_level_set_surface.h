@@ -0,0 +1,404 @@
+/*
+ * File:        lsm_zero_level_set_surface.h
+ * Copyrights:  (c) 2005 The Trustees of Princeton University and Board of
+ *                  Regents of the University of Texas.  All rights reserved.
+ *              (c) 2009 Kevin T. Chu.  All rights reserved.
+ * Revision:    $Revision$
+ * Modified:    $Date$
+ * Description: Header file for extraction of the zero level set as a
+ *              triangle mesh (3D) or line segment mesh (2D)
+ */
+
+#ifndef included_lsm_zero_level_set_surface_h
+#define included_lsm_zero_level_set_surface_h
+
+#include "LSMLIB_config.h"
+#include "lsm_grid.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+
+/*! \file lsm_zero_level_set_surface.h
+ *
+ * \brief
+ * @ref lsm_zero_level_set_surface.h provides support for extracting the
+ * zero level set of a level set function as a triangle mesh (in three
+ * space dimensions) or as a collection of line segments (in two space
+ * dimensions) and writing it to a compact binary file.  Writing the
+ * zero level set instead of the entire level set function reduces the
+ * size of the output from O(N^3) to O(N^2) per frame (O(N^2) to O(N)
+ * in two space dimensions).
+ *
+ * The zero level set is computed by decomposing each grid cell into
+ * simplices (six tetrahedra in 3D and two triangles in 2D) that share
+ * the main diagonal of the cell and finding the zero level set of the
+ * linear interpolant of \f$ \phi \f$ within each simplex.  Because the
+ * decomposition is the same for all grid cells, the resulting mesh is
+ * free of cracks and has no ambiguous cases.  Vertices on grid cell
+ * edges shared by neighboring cells are shared by the elements in
+ * those cells.
+ *
+ * Optionally, the value of an extension field at each vertex (computed
+ * by linear interpolation) is stored along with the mesh.
+ *
+ * Typical usage:
+ *  -# create a ZeroLevelSetSurface with createZeroLevelSetSurface()
+ *  -# for each output frame
+ *     -# clear the surface with resetZeroLevelSetSurface()
+ *     -# add the zero level set of \f$ \phi \f$ to the surface using
+ *        extractZeroLevelSetSurface2d()/extractZeroLevelSetSurface3d()
+ *        (or the narrow band versions)
+ *     -# write the surface with writeZeroLevelSetSurfaceToBinaryFile()
+ *  -# free the surface with destroyZeroLevelSetSurface()
+ *
+ * The memory required by the surface grows with the size of the zero
+ * level set, not the size of the grid, and is reused across frames.
+ *
+ */
+
+
+/*!
+ * The 'ZeroLevelSetSurface' structure contains the zero level set of
+ * a level set function represented as a collection of simplices
+ * (triangles in 3D; line segments in 2D).
+ */
+typedef struct _ZeroLevelSetSurface {
+
+  /* number of space dimensions (2 or 3) */
+  int num_dims;
+
+  /* vertex coordinates (num_dims values for each vertex) */
+  int num_vertices;
+  LSMLIB_REAL *vertices;
+
+  /* extension field value at each vertex (NULL if not requested) */
+  LSMLIB_REAL *vertex_field;
+
+  /* elements (num_dims vertex indices for each element) */
+  int num_elements;
+  int *elements;
+
+  /* allocated sizes of vertex and element arrays */
+  int max_num_vertices;
+  int max_num_elements;
+
+} ZeroLevelSetSurface;
+
+
+/*!
+ * createZeroLevelSetSurface() allocates an empty ZeroLevelSetSurface.
+ *
+ * Arguments:
+ *  - num_dims (in):          number of space dimensions (2 or 3)
+ *  - has_vertex_field (in):  1 if extension field values should be
+ *                            stored at the vertices; 0 otherwise
+ *
+ * Return value:              pointer to new ZeroLevelSetSurface; NULL if
+ *                            num_dims is invalid
+ *
+ */
+ZeroLevelSetSurface *createZeroLevelSetSurface(
+  int num_dims,
+  int has_vertex_field);
+
+/*!
+ * resetZeroLevelSetSurface() removes all vertices and elements from a
+ * ZeroLevelSetSurface without freeing its memory.
+ *
+ * Arguments:
+ *  - surface (in):  pointer to ZeroLevelSetSurface
+ *
+ * Return value:     none
+ *
+ */
+void resetZeroLevelSetSurface(ZeroLevelSetSurface *surface);
+
+/*!
+ * destroyZeroLevelSetSurface() frees the memory associated with a
+ * ZeroLevelSetSurface.
+ *
+ * Arguments:
+ *  - surface (in):  pointer to ZeroLevelSetSurface
+ *
+ * Return value:     none
+ *
+ */
+void destroyZeroLevelSetSurface(ZeroLevelSetSurface *surface);
+
+/*!
+ * extractZeroLevelSetSurface2d() adds the zero level set of
+ * \f$ \phi \f$ on a 2D grid to a ZeroLevelSetSurface as a collection
+ * of line segments.
+ *
+ * Arguments:
+ *  - surface (in/out):  pointer to ZeroLevelSetSurface (num_dims = 2)
+ *  - phi (in):          level set function \f$ \phi \f$
+ *  - field (in):        extension field to interpolate to the vertices;
+ *                       ignored if surface has no vertex field
+ *  - grid (in):         pointer to Grid
+ *
+ * Return value:         number of elements added; negative if an error
+ *                       occurred
+ *
+ * NOTES:
+ *  - Only the grid cells whose corners all lie in the interior of the
+ *    computational domain (i.e. the fillbox) are used.
+ *
+ *  - Segments are oriented so that \f$ \nabla \phi \f$ points to the
+ *    right of the segment (i.e. segments bounding the region where
+ *    \f$ \phi < 0 \f$ are traversed counterclockwise).
+ *
+ */
+int extractZeroLevelSetSurface2d(
+  ZeroLevelSetSurface *surface,
+  LSMLIB_REAL *phi,
+  LSMLIB_REAL *field,
+  Grid *grid);
+
+/*!
+ * extractZeroLevelSetSurface3d() adds the zero level set of
+ * \f$ \phi \f$ on a 3D grid to a ZeroLevelSetSurface as a triangle
+ * mesh.
+ *
+ * Arguments:
+ *  - surface (in/out):  pointer to ZeroLevelSetSurface (num_dims = 3)
+ *  - phi (in):          level set function \f$ \phi \f$
+ *  - field (in):        extension field to interpolate to the vertices;
+ *                       ignored if surface has no vertex field
+ *  - grid (in):         pointer to Grid
+ *
+ * Return value:         number of elements added; negative if an error
+ *                       occurred
+ *
+ * NOTES:
+ *  - Only the grid cells whose corners all lie in the interior of the
+ *    computational domain (i.e. the fillbox) are used.
+ *
+ *  - Triangles are oriented so that their normals (computed using the
+ *    right-hand rule) point in the direction of \f$ \nabla \phi \f$.
+ *    The orientation is determined from the signs of \f$ \phi \f$ at
+ *    the grid points, so neighboring triangles are consistently 
+ *    oriented.
+ *
+ *  - Vertices that lie within a relative distance LSMLIB_ZERO_TOL of a
+ *    grid point are placed at the grid point and triangles with 
+ *    repeated vertices are discarded, so values of \f$ \phi \f$ that
+ *    vanish up to roundoff do not produce zero-area triangles.
+ *
+ */
+int extractZeroLevelSetSurface3d(
+  ZeroLevelSetSurface *surface,
+  LSMLIB_REAL *phi,
+  LSMLIB_REAL *field,
+  Grid *grid);
+
+/*!
+ * extractZeroLevelSetSurfaceLocal2d() is the narrow band version of
+ * extractZeroLevelSetSurface2d().  Only grid cells whose lower corners
+ * are narrow band points are visited.
+ *
+ * Arguments:
+ *  - surface (in/out):  pointer to ZeroLevelSetSurface (num_dims = 2)
+ *  - phi (in):          level set function \f$ \phi \f$
+ *  - field (in):        extension field to interpolate to the vertices;
+ *                       ignored if surface has no vertex field
+ *  - grid (in):         pointer to Grid
+ *  - index_x,
+ *    index_y (in):      coordinates of local (narrow band) points
+ *  - nlo_index,
+ *    nhi_index (in):    index range of points to loop over in index_*
+ *  - narrow_band (in):  array that marks voxels outside desired fillbox
+ *  - mark_fb (in):      upper limit narrow band value for voxels in
+ *                       fillbox
+ *
+ * Return value:         number of elements added; negative if an error
+ *                       occurred
+ *
+ * NOTES:
+ *  - A grid cell is used only if all of its corners lie in the narrow
+ *    band and the fillbox (i.e. 0 < narrow_band <= mark_fb).  As long
+ *    as the zero level set lies well inside of the narrow band, the
+ *    result is the same as extractZeroLevelSetSurface2d().
+ *
+ */
+int extractZeroLevelSetSurfaceLocal2d(
+  ZeroLevelSetSurface *surface,
+  LSMLIB_REAL *phi,
+  LSMLIB_REAL *field,
+  Grid *grid,
+  int *index_x,
+  int *index_y,
+  int nlo_index,
+  int nhi_index,
+  unsigned char *narrow_band,
+  unsigned char mark_fb);
+
+/*!
+ * extractZeroLevelSetSurfaceLocal3d() is the narrow band version of
+ * extractZeroLevelSetSurface3d().  Only grid cells whose lower corners
+ * are narrow band points are visited.
+ *
+ * Arguments:
+ *  - surface (in/out):  pointer to ZeroLevelSetSurface (num_dims = 3)
+ *  - phi (in):          level set function \f$ \phi \f$
+ *  - field (in):        extension field to interpolate to the vertices;
+ *                       ignored if surface has no vertex field
+ *  - grid (in):         pointer to Grid
+ *  - index_x, index_y,
+ *    index_z (in):      coordinates of local (narrow band) points
+ *  - nlo_index,
+ *    nhi_index (in):    index range of points to loop over in index_*
+ *  - narrow_band (in):  array that marks voxels outside desired fillbox
+ *  - mark_fb (in):      upper limit narrow band value for voxels in
+ *                       fillbox
+ *
+ * Return value:         number of elements added; negative if an error
+ *                       occurred
+ *
+ * NOTES:
+ *  - A grid cell is used only if all of its corners lie in the narrow
+ *    band and the fillbox (i.e. 0 < narrow_band <= mark_fb).  As long
+ *    as the zero level set lies well inside of the narrow band, the
+ *    result is the same as extractZeroLevelSetSurface3d().
+ *
+ */
+int extractZeroLevelSetSurfaceLocal3d(
+  ZeroLevelSetSurface *surface,
+  LSMLIB_REAL *phi,
+  LSMLIB_REAL *field,
+  Grid *grid,
+  int *index_x,
+  int *index_y,
+  int *index_z,
+  int nlo_index,
+  int nhi_index,
+  unsigned char *narrow_band,
+  unsigned char mark_fb);
+
+/*!
+ * addZeroLevelSetSurfaceInBox() adds the zero level set of
+ * \f$ \phi \f$ within a box of grid cells to a ZeroLevelSetSurface.
+ * It is the low-level routine used by extractZeroLevelSetSurface2d()
+ * and extractZeroLevelSetSurface3d() and may be used directly to
+ * extract the zero level set from arrays that are not associated with
+ * a Grid (e.g. the data on a patch of a SAMRAI PatchHierarchy).
+ *
+ * Arguments:
+ *  - surface (in/out):     pointer to ZeroLevelSetSurface
+ *  - phi (in):             level set function \f$ \phi \f$
+ *  - phi_gb (in):          index range for ghostbox of phi
+ *  - field (in):           extension field to interpolate to the
+ *                          vertices; ignored if surface has no vertex
+ *                          field
+ *  - field_gb (in):        index range for ghostbox of field
+ *  - control_vol (in):     control volume data (used to exclude cells
+ *                          from the calculation); may be NULL
+ *  - control_vol_gb (in):  index range for ghostbox of control_vol
+ *  - ib (in):              index range of lower corners of cells to
+ *                          include in calculation
+ *  - x_lo (in):            coordinates of grid point with index phi_gb
+ *                          lower corner
+ *  - dx (in):              grid spacing
+ *
+ * Return value:            number of elements added; negative if an
+ *                          error occurred
+ *
+ * NOTES:
+ *  - All index ranges are arrays of length 2*num_dims ordered as
+ *    (ilo, ihi, jlo, jhi, klo, khi).
+ *
+ *  - A grid cell with lower corner (i,j,k) has corners at the grid
+ *    points (i,j,k) through (i+1,j+1,k+1), so only cells whose corners
+ *    all lie in the ghostbox of phi are included.
+ *
+ *  - When control_vol is not NULL, a cell is included only if the
+ *    control volume at its lower corner is positive.
+ *
+ *  - Vertices are shared only between elements added by the same
+ *    call, so adjacent boxes (e.g. patches) have separate copies of
+ *    the vertices on their common boundary.
+ *
+ */
+int addZeroLevelSetSurfaceInBox(
+  ZeroLevelSetSurface *surface,
+  const LSMLIB_REAL *phi,
+  const int *phi_gb,
+  const LSMLIB_REAL *field,
+  const int *field_gb,
+  const LSMLIB_REAL *control_vol,
+  const int *control_vol_gb,
+  const int *ib,
+  const LSMLIB_REAL *x_lo,
+  const LSMLIB_REAL *dx);
+
+/*!
+ * appendZeroLevelSetSurface() appends the vertices and elements of one
+ * ZeroLevelSetSurface to another.
+ *
+ * Arguments:
+ *  - surface (in/out):  pointer to ZeroLevelSetSurface to append to
+ *  - other (in):        pointer to ZeroLevelSetSurface to append
+ *
+ * Return value:         0 if successful; 1 if the surfaces have 
+ *                       different numbers of dimensions or memory could
+ *                       not be allocated
+ *
+ * NOTES:
+ *  - If surface has a vertex field but other does not, the vertex 
+ *    field values of the appended vertices are set to zero.
+ *
+ */
+int appendZeroLevelSetSurface(
+  ZeroLevelSetSurface *surface,
+  ZeroLevelSetSurface *other);
+
+/*!
+ * writeZeroLevelSetSurfaceToBinaryFile() writes a ZeroLevelSetSurface
+ * to a binary file.
+ *
+ * The data is output in the following order:
+ * -# num_dims, has_vertex_field (1 or 0), num_vertices, num_elements,
+ *    and sizeof(LSMLIB_REAL) (5 integers)
+ * -# vertex coordinates (num_dims*num_vertices LSMLIB_REAL values)
+ * -# vertex field values (num_vertices LSMLIB_REAL values; only if
+ *    has_vertex_field is 1)
+ * -# elements (num_dims*num_elements integers)
+ *
+ * Arguments:
+ *  - surface (in):    pointer to ZeroLevelSetSurface
+ *  - file_name (in):  name of output file
+ *
+ * Return value:       0 if successful; 1 if the file could not be
+ *                     written
+ *
+ * NOTES:
+ *  - If a file with the specified file_name already exists, it is
+ *    overwritten.
+ *
+ */
+int writeZeroLevelSetSurfaceToBinaryFile(
+  ZeroLevelSetSurface *surface,
+  char *file_name);
+
+/*!
+ * readZeroLevelSetSurfaceFromBinaryFile() reads a ZeroLevelSetSurface
+ * from a binary file written by writeZeroLevelSetSurfaceToBinaryFile().
+ *
+ * Arguments:
+ *  - file_name (in):  name of input file
+ *
+ * Return value:       pointer to new ZeroLevelSetSurface; NULL if the
+ *                     file could not be read or was written with a
+ *                     different precision
+ *
+ */
+ZeroLevelSetSurface *readZeroLevelSetSurfaceFromBinaryFile(
+  char *file_name);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
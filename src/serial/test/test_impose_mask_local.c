@@ -0,0 +1,132 @@
+/*
+ * File:        test_impose_mask_local.c
+ * Copyrights:  (c) 2005 The Trustees of Princeton University and Board of
+ *                  Regents of the University of Texas.  All rights reserved.
+ *              (c) 2009 Kevin T. Chu.  All rights reserved.
+ * Revision:    $Revision$
+ * Modified:    $Date$
+ *
+ */
+
+/*
+ * This program tests the IMPOSE_MASK_LOCAL() macro in lsm_macros.h on
+ * 3D and 2D grids with 16 grid cells in each coordinate direction.
+ *
+ * The narrow band consists of the voxels of a box (level 0) followed by
+ * the voxels of the next layer in the x-direction (level 1), both in
+ * grid order.  phi is 1 everywhere and mask is 2 everywhere.
+ *
+ * The following properties are checked:
+ *  - every level 0 voxel, including the last one (n_hi[0]), is masked;
+ *    and
+ *  - no other voxel is changed.
+ *
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "lsm_grid.h"
+#include "lsm_data_arrays.h"
+#include "lsm_macros.h"
+
+static int testImposeMaskLocal(int num_dims);
+
+int main(void)
+{
+  int num_errors_3d, num_errors_2d;
+
+  num_errors_3d = testImposeMaskLocal(3);
+  num_errors_2d = testImposeMaskLocal(2);
+
+  printf("3D voxels with wrong value:  %d\n", num_errors_3d);
+  printf("2D voxels with wrong value:  %d\n", num_errors_2d);
+
+  if ( (num_errors_3d > 0) || (num_errors_2d > 0) ) {
+    printf("FAILED\n");
+    return 1;
+  }
+  printf("PASSED\n");
+  return 0;
+}
+
+
+/* testImposeMaskLocal() imposes the mask on the level 0 voxels and */
+/* returns the number of voxels with the wrong value                */
+static int testImposeMaskLocal(int num_dims)
+{
+  LSMLIB_REAL x_lo[3] = {-1.0, -1.0, -1.0};
+  LSMLIB_REAL x_hi[3] = {1.0, 1.0, 1.0};
+  LSMLIB_REAL dx = 2.0/16;
+  Grid *grid;
+  LSM_DataArrays data_arrays;
+  LSM_DataArrays *d = &data_arrays;
+  LSMLIB_REAL *phi, *mask;
+  int *in_level0;
+  int nx, nxy;
+  int ilo = 4, ihi = 9, jlo = 5, jhi = 8, klo = 6, khi = 7;
+  int num_errors = 0;
+  int i, j, k, l, idx;
+
+  grid = createGridSetDx(num_dims, dx, x_lo, x_hi, LOW);
+  nx = grid->grid_dims_ghostbox[0];
+  nxy = nx*grid->grid_dims_ghostbox[1];
+  if (num_dims == 2) klo = khi = 0;
+
+  phi = (LSMLIB_REAL*) malloc(grid->num_gridpts*sizeof(LSMLIB_REAL));
+  mask = (LSMLIB_REAL*) malloc(grid->num_gridpts*sizeof(LSMLIB_REAL));
+  in_level0 = (int*) malloc(grid->num_gridpts*sizeof(int));
+  d->index_x = (int*) malloc(grid->num_gridpts*sizeof(int));
+  d->index_y = (int*) malloc(grid->num_gridpts*sizeof(int));
+  d->index_z = (int*) malloc(grid->num_gridpts*sizeof(int));
+  for (idx = 0; idx < grid->num_gridpts; idx++) {
+    phi[idx] = 1.0;
+    mask[idx] = 2.0;
+    in_level0[idx] = 0;
+  }
+
+  /* level 0: the box [ilo,ihi]x[jlo,jhi]x[klo,khi] */
+  l = 0;
+  d->n_lo[0] = l;
+  for (k = klo; k <= khi; k++) {
+    for (j = jlo; j <= jhi; j++) {
+      for (i = ilo; i <= ihi; i++) {
+        d->index_x[l] = i;
+        d->index_y[l] = j;
+        d->index_z[l] = k;
+        in_level0[i + j*nx + k*nxy] = 1;
+        l++;
+      }
+    }
+  }
+  d->n_hi[0] = l-1;
+
+  /* level 1: the layer i = ihi+1 next to the box */
+  d->n_lo[1] = l;
+  for (k = klo; k <= khi; k++) {
+    for (j = jlo; j <= jhi; j++) {
+      d->index_x[l] = ihi+1;
+      d->index_y[l] = j;
+      d->index_z[l] = k;
+      l++;
+    }
+  }
+  d->n_hi[1] = l-1;
+
+  IMPOSE_MASK_LOCAL(phi, mask, phi, grid, d)
+
+  for (idx = 0; idx < grid->num_gridpts; idx++) {
+    LSMLIB_REAL phi_expected = in_level0[idx] ? 2.0 : 1.0;
+    if (phi[idx] != phi_expected) num_errors++;
+  }
+
+  free(d->index_z);
+  free(d->index_y);
+  free(d->index_x);
+  free(in_level0);
+  free(mask);
+  free(phi);
+  destroyGrid(grid);
+
+  return num_errors;
+}
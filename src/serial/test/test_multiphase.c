@@ -0,0 +1,237 @@
+/*
+ * File:        test_multiphase.c
+ * Copyrights:  (c) 2005 The Trustees of Princeton University and Board of
+ *                  Regents of the University of Texas.  All rights reserved.
+ *              (c) 2009 Kevin T. Chu.  All rights reserved.
+ * Revision:    $Revision$
+ * Modified:    $Date$
+ *
+ */
+
+/*
+ * This program tests the multi-phase level set functions in
+ * lsm_multiphase.h on a 64^2 grid covering the domain [-1,1]^2.
+ *
+ * Two disks of radius 0.3 (phases 1 and 2) in a background phase
+ * (phase 0) are evolved by mean curvature with periodic boundary
+ * conditions.  The same configuration shifted by half of the domain in
+ * each coordinate direction (so that both disks are split across the
+ * boundaries) is evolved alongside it.  A planar interface (phase 0 for
+ * x < 0.1 and phase 1 elsewhere) is evolved with the default homogeneous
+ * Neumann boundary conditions.
+ *
+ * The following properties are checked:
+ *  - periodic boundary conditions: the level set functions of the
+ *    shifted configuration are the shifted level set functions of the
+ *    original configuration;
+ *  - consistency: at every grid cell in the fillbox, exactly one phase
+ *    (the phase returned by computeMultiPhaseLabels()) has phi <= 0 and
+ *    no other phase has phi < 0 (i.e. the phases neither overlap nor
+ *    leave vacuum);
+ *  - the disks shrink under curvature flow but do not vanish; and
+ *  - homogeneous Neumann boundary conditions: every row of labels for
+ *    the planar interface is identical.
+ *
+ */
+
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "lsm_grid.h"
+#include "lsm_boundary_conditions.h"
+#include "lsm_multiphase.h"
+
+#define NUM_PHASES       (3)
+#define NUM_STEPS        (100)
+#define REINIT_INTERVAL  (10)
+#define NUM_REINIT_ITERS (10)
+
+static void evolveMultiPhase(LSM_MultiPhase *multiphase,
+                             LSMLIB_REAL curvature_coef);
+static int countInconsistentCells(LSM_MultiPhase *multiphase, int *labels);
+
+int main(void)
+{
+  LSMLIB_REAL x_lo[2] = {-1.0, -1.0};
+  LSMLIB_REAL x_hi[2] = {1.0, 1.0};
+  LSMLIB_REAL dx = 2.0/64;
+  LSMLIB_REAL radius = 0.3;
+  LSMLIB_REAL curvature_coef = 1.0;
+  Grid *grid;
+  LSM_MultiPhase *multiphase, *multiphase_shifted, *multiphase_planar;
+  int *labels, *labels_shifted, *labels_planar;
+  int nx, n_fb[2];
+  int num_shift_errors = 0;
+  int num_inconsistent = 0;
+  int num_row_errors = 0;
+  int area_initial = 0, area_final = 0;
+  int i, j, i_s, j_s, idx, idx_s, p;
+
+  grid = createGridSetDx(2, dx, x_lo, x_hi, LOW);
+  nx = grid->grid_dims_ghostbox[0];
+  n_fb[0] = grid->ihi_fb - grid->ilo_fb + 1;
+  n_fb[1] = grid->jhi_fb - grid->jlo_fb + 1;
+
+  labels = (int*) malloc(grid->num_gridpts*sizeof(int));
+  labels_shifted = (int*) malloc(grid->num_gridpts*sizeof(int));
+  labels_planar = (int*) malloc(grid->num_gridpts*sizeof(int));
+  for (idx = 0; idx < grid->num_gridpts; idx++) {
+    labels[idx] = labels_shifted[idx] = labels_planar[idx] = 0;
+  }
+
+  for (j = grid->jlo_fb; j <= grid->jhi_fb; j++) {
+    for (i = grid->ilo_fb; i <= grid->ihi_fb; i++) {
+      LSMLIB_REAL x = grid->x_lo_ghostbox[0] + dx*i;
+      LSMLIB_REAL y = grid->x_lo_ghostbox[1] + dx*j;
+      idx = i + j*nx;
+
+      if ((x+0.4)*(x+0.4) + y*y < radius*radius) {
+        labels[idx] = 1;
+        area_initial++;
+      } else if ((x-0.4)*(x-0.4) + y*y < radius*radius) {
+        labels[idx] = 2;
+      }
+      labels_planar[idx] = (x < 0.1) ? 0 : 1;
+    }
+  }
+  for (j = grid->jlo_fb; j <= grid->jhi_fb; j++) {
+    for (i = grid->ilo_fb; i <= grid->ihi_fb; i++) {
+      i_s = grid->ilo_fb + (i - grid->ilo_fb + n_fb[0]/2)%n_fb[0];
+      j_s = grid->jlo_fb + (j - grid->jlo_fb + n_fb[1]/2)%n_fb[1];
+      labels_shifted[i_s + j_s*nx] = labels[i + j*nx];
+    }
+  }
+
+  multiphase = createMultiPhase(grid, NUM_PHASES, 3, 6*dx);
+  multiphase_shifted = createMultiPhase(grid, NUM_PHASES, 3, 6*dx);
+  multiphase_planar = createMultiPhase(grid, 2, 2, 6*dx);
+  setMultiPhaseBoundaryConditions(multiphase, ALL_BOUNDARIES,
+                                  MULTIPHASE_PERIODIC_BC);
+  setMultiPhaseBoundaryConditions(multiphase_shifted, ALL_BOUNDARIES,
+                                  MULTIPHASE_PERIODIC_BC);
+
+  initializeMultiPhaseFromLabels(multiphase, labels);
+  initializeMultiPhaseFromLabels(multiphase_shifted, labels_shifted);
+  initializeMultiPhaseFromLabels(multiphase_planar, labels_planar);
+
+  evolveMultiPhase(multiphase, curvature_coef);
+  evolveMultiPhase(multiphase_shifted, curvature_coef);
+  evolveMultiPhase(multiphase_planar, curvature_coef);
+
+  /* periodic boundary conditions */
+  for (j = grid->jlo_fb; j <= grid->jhi_fb; j++) {
+    for (i = grid->ilo_fb; i <= grid->ihi_fb; i++) {
+      i_s = grid->ilo_fb + (i - grid->ilo_fb + n_fb[0]/2)%n_fb[0];
+      j_s = grid->jlo_fb + (j - grid->jlo_fb + n_fb[1]/2)%n_fb[1];
+      idx = i + j*nx;
+      idx_s = i_s + j_s*nx;
+      for (p = 0; p < NUM_PHASES; p++) {
+        if (fabs(getMultiPhaseValue(multiphase, idx, p)
+               - getMultiPhaseValue(multiphase_shifted, idx_s, p))
+            > 1.e-12) {
+          num_shift_errors++;
+        }
+      }
+    }
+  }
+
+  /* consistency */
+  num_inconsistent += countInconsistentCells(multiphase, labels);
+  num_inconsistent += countInconsistentCells(multiphase_shifted,
+                                             labels_shifted);
+  num_inconsistent += countInconsistentCells(multiphase_planar,
+                                             labels_planar);
+  for (j = grid->jlo_fb; j <= grid->jhi_fb; j++) {
+    for (i = grid->ilo_fb; i <= grid->ihi_fb; i++) {
+      if (labels[i + j*nx] == 1) area_final++;
+    }
+  }
+
+  /* homogeneous Neumann boundary conditions */
+  for (j = grid->jlo_fb + 1; j <= grid->jhi_fb; j++) {
+    for (i = grid->ilo_fb; i <= grid->ihi_fb; i++) {
+      if (labels_planar[i + j*nx] != labels_planar[i + grid->jlo_fb*nx]) {
+        num_row_errors++;
+      }
+    }
+  }
+
+  printf("periodic shift errors:             %d\n", num_shift_errors);
+  printf("inconsistent grid cells:           %d\n", num_inconsistent);
+  printf("area of phase 1 (initial, final):  %d, %d\n",
+         area_initial, area_final);
+  printf("planar interface row errors:       %d\n", num_row_errors);
+
+  destroyMultiPhase(multiphase_planar);
+  destroyMultiPhase(multiphase_shifted);
+  destroyMultiPhase(multiphase);
+  free(labels_planar);
+  free(labels_shifted);
+  free(labels);
+  destroyGrid(grid);
+
+  if ( (num_shift_errors > 0) || (num_inconsistent > 0)
+    || (num_row_errors > 0) || (area_final >= area_initial)
+    || (area_final == 0) ) {
+    printf("FAILED\n");
+    return 1;
+  }
+  printf("PASSED\n");
+  return 0;
+}
+
+
+/* evolveMultiPhase() reinitializes the level set functions and */
+/* advances them by mean curvature for NUM_STEPS time steps     */
+static void evolveMultiPhase(LSM_MultiPhase *multiphase,
+                             LSMLIB_REAL curvature_coef)
+{
+  LSMLIB_REAL dt;
+  int step;
+
+  reinitializeMultiPhaseLevelSets(multiphase, NUM_REINIT_ITERS);
+
+  dt = computeMultiPhaseStableDt(multiphase, NULL, curvature_coef, 0.5);
+  for (step = 1; step <= NUM_STEPS; step++) {
+    advanceMultiPhaseLevelSets(multiphase, NULL, curvature_coef, dt);
+    projectMultiPhaseLevelSets(multiphase);
+    updateMultiPhaseActiveSets(multiphase);
+    if (step%REINIT_INTERVAL == 0) {
+      reinitializeMultiPhaseLevelSets(multiphase, NUM_REINIT_ITERS);
+    }
+  }
+}
+
+
+/* countInconsistentCells() computes the labels and counts the grid   */
+/* cells in the fillbox where the labeled phase does not have phi <= 0 */
+/* or another phase has phi < 0                                       */
+static int countInconsistentCells(LSM_MultiPhase *multiphase, int *labels)
+{
+  Grid *grid = multiphase->grid;
+  int K = multiphase->max_phases_per_cell;
+  int nx = grid->grid_dims_ghostbox[0];
+  int num_inconsistent = 0;
+  int i, j, s;
+
+  computeMultiPhaseLabels(multiphase, labels);
+  for (j = grid->jlo_fb; j <= grid->jhi_fb; j++) {
+    for (i = grid->ilo_fb; i <= grid->ihi_fb; i++) {
+      int *phase_id = multiphase->phase_id + (i + j*nx)*K;
+      LSMLIB_REAL *phi = multiphase->phi + (i + j*nx)*K;
+      int consistent = (labels[i + j*nx] >= 0)
+                    && (getMultiPhaseValue(multiphase, i + j*nx,
+                                           labels[i + j*nx]) <= 0);
+
+      for (s = 0; (s < K) && (phase_id[s] >= 0); s++) {
+        if ( (phase_id[s] != labels[i + j*nx]) && (phi[s] < 0) ) {
+          consistent = 0;
+        }
+      }
+      if (!consistent) num_inconsistent++;
+    }
+  }
+
+  return num_inconsistent;
+}
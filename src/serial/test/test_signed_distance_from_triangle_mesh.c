@@ -0,0 +1,141 @@
+/*
+ * File:        test_signed_distance_from_triangle_mesh.c
+ * Copyrights:  (c) 2005 The Trustees of Princeton University and Board of
+ *                  Regents of the University of Texas.  All rights reserved.
+ *              (c) 2009 Kevin T. Chu.  All rights reserved.
+ * Revision:    $Revision$
+ * Modified:    $Date$
+ *
+ */
+
+/*
+ * This program tests that createSignedDistanceFromTriangleMesh3d()
+ * computes the correct sign of phi at grid points outside of the band
+ * when the fast marching method is used to compute the distance outside
+ * of the band.
+ *
+ * The surface is the cube [-0.5,0.5]^3 read from an 8-vertex OBJ file.
+ * phi is computed on the domain [-1,1]^3 with dx = 0.02 and a band width
+ * of 0.1.  At every grid point farther than the band width from the
+ * surface, the sign of phi must agree with the sign of the exact signed
+ * distance and |phi| must be at least the band width (less one grid
+ * cell).
+ *
+ */
+
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "lsm_grid.h"
+#include "lsm_initialization3d.h"
+#include "lsm_triangle_mesh.h"
+
+#define OBJ_FILE_NAME  "cube.obj"
+
+static void writeCubeOBJFile(char *file_name);
+static LSMLIB_REAL signedDistanceToCube(LSMLIB_REAL *x);
+
+int main(void)
+{
+  LSMLIB_REAL x_lo[3] = {-1.0, -1.0, -1.0};
+  LSMLIB_REAL x_hi[3] = {1.0, 1.0, 1.0};
+  LSMLIB_REAL dx = 0.02;
+  LSMLIB_REAL band_width = 0.1;
+  Grid *grid;
+  TriangleMesh *mesh;
+  LSMLIB_REAL *phi;
+  int num_outside_band = 0;
+  int num_wrong_sign = 0;
+  int num_too_small = 0;
+  int i, j, k;
+
+  writeCubeOBJFile(OBJ_FILE_NAME);
+  mesh = readTriangleMeshFromOBJFile(OBJ_FILE_NAME);
+  if (!mesh) {
+    printf("FAILED: unable to read %s\n", OBJ_FILE_NAME);
+    return 1;
+  }
+
+  grid = createGridSetDx(3, dx, x_lo, x_hi, LOW);
+  phi = (LSMLIB_REAL*) malloc(grid->num_gridpts*sizeof(LSMLIB_REAL));
+
+  createSignedDistanceFromTriangleMesh3d(phi, mesh, band_width, 1, grid);
+
+  for (k = 0; k < grid->grid_dims_ghostbox[2]; k++) {
+    for (j = 0; j < grid->grid_dims_ghostbox[1]; j++) {
+      for (i = 0; i < grid->grid_dims_ghostbox[0]; i++) {
+        int idx = i + grid->grid_dims_ghostbox[0]
+                    * (j + grid->grid_dims_ghostbox[1]*k);
+        LSMLIB_REAL x[3];
+        LSMLIB_REAL dist;
+
+        x[0] = grid->x_lo_ghostbox[0] + dx*i;
+        x[1] = grid->x_lo_ghostbox[1] + dx*j;
+        x[2] = grid->x_lo_ghostbox[2] + dx*k;
+        dist = signedDistanceToCube(x);
+        if (fabs(dist) <= band_width) continue;
+
+        num_outside_band++;
+        if (phi[idx]*dist <= 0) num_wrong_sign++;
+        if (fabs(phi[idx]) < band_width - dx) num_too_small++;
+      }
+    }
+  }
+
+  printf("grid points outside of band:       %d\n", num_outside_band);
+  printf("grid points with wrong sign:       %d\n", num_wrong_sign);
+  printf("grid points with |phi| too small:  %d\n", num_too_small);
+
+  free(phi);
+  destroyGrid(grid);
+  destroyTriangleMesh(mesh);
+  remove(OBJ_FILE_NAME);
+
+  if (num_wrong_sign > 0 || num_too_small > 0) {
+    printf("FAILED\n");
+    return 1;
+  }
+  printf("PASSED\n");
+  return 0;
+}
+
+
+/* writeCubeOBJFile() writes the cube [-0.5,0.5]^3 with outward */
+/* facing quadrilateral faces to an OBJ file                    */
+static void writeCubeOBJFile(char *file_name)
+{
+  FILE *fp = fopen(file_name, "w");
+  fprintf(fp, "# cube [-0.5,0.5]^3\n");
+  fprintf(fp, "v -0.5 -0.5 -0.5\n");
+  fprintf(fp, "v  0.5 -0.5 -0.5\n");
+  fprintf(fp, "v  0.5  0.5 -0.5\n");
+  fprintf(fp, "v -0.5  0.5 -0.5\n");
+  fprintf(fp, "v -0.5 -0.5  0.5\n");
+  fprintf(fp, "v  0.5 -0.5  0.5\n");
+  fprintf(fp, "v  0.5  0.5  0.5\n");
+  fprintf(fp, "v -0.5  0.5  0.5\n");
+  fprintf(fp, "f 1 4 3 2\n");
+  fprintf(fp, "f 5 6 7 8\n");
+  fprintf(fp, "f 1 2 6 5\n");
+  fprintf(fp, "f 4 8 7 3\n");
+  fprintf(fp, "f 1 5 8 4\n");
+  fprintf(fp, "f 2 3 7 6\n");
+  fclose(fp);
+}
+
+
+/* signedDistanceToCube() computes the exact signed distance from */
+/* the point x to the surface of the cube [-0.5,0.5]^3            */
+static LSMLIB_REAL signedDistanceToCube(LSMLIB_REAL *x)
+{
+  LSMLIB_REAL q, q_max = -1.0, dist_sq = 0.0;
+  int n;
+
+  for (n = 0; n < 3; n++) {
+    q = fabs(x[n]) - 0.5;
+    if (q > q_max) q_max = q;
+    if (q > 0) dist_sq += q*q;
+  }
+  return (q_max > 0) ? sqrt(dist_sq) : q_max;
+}
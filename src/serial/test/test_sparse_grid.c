@@ -0,0 +1,177 @@
+/*
+ * File:        test_sparse_grid.c
+ * Copyrights:  (c) 2005 The Trustees of Princeton University and Board of
+ *                  Regents of the University of Texas.  All rights reserved.
+ *              (c) 2009 Kevin T. Chu.  All rights reserved.
+ * Revision:    $Revision$
+ * Modified:    $Date$
+ *
+ */
+
+/*
+ * This program tests the sparse brick storage in lsm_sparse_grid.h for
+ * the signed distance function of a sphere of radius 0.5 on a 160^3
+ * grid (with the ghostcells required for HIGH accuracy) using 8^3
+ * bricks.
+ *
+ * The following properties are checked:
+ *  - round trip: copying the data to the sparse grid and back
+ *    reproduces the data exactly in active bricks; elsewhere the
+ *    background value with the correct sign is returned;
+ *  - ghostcell fill: every grid cell of the brick ghostbox arrays
+ *    filled by getSparseGridBrickData() matches the dense data (or the
+ *    background value for cells covered by inactive bricks);
+ *  - setSparseGridBrickData() stores the interior of a brick ghostbox
+ *    array; and
+ *  - the sparse grid requires less memory than the dense grid.
+ *
+ */
+
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "lsm_grid.h"
+#include "lsm_initialization3d.h"
+#include "lsm_sparse_grid.h"
+
+#define PHI_FIELD   (0)
+#define COPY_FIELD  (1)
+
+int main(void)
+{
+  LSMLIB_REAL x_lo[3] = {-1.0, -1.0, -1.0};
+  LSMLIB_REAL x_hi[3] = {1.0, 1.0, 1.0};
+  LSMLIB_REAL dx = 2.0/160;
+  LSMLIB_REAL width, background;
+  Grid *grid;
+  LSM_SparseGrid *sparse_grid;
+  LSMLIB_REAL *phi, *phi_sparse, *brick_data;
+  int nx, nxy;
+  int num_round_trip_errors = 0;
+  int num_ghostcell_errors = 0;
+  int num_set_errors = 0;
+  double sparse_bytes, dense_bytes;
+  int brick_idx, i, j, k, idx;
+
+  grid = createGridSetDx(3, dx, x_lo, x_hi, HIGH);
+  nx = grid->grid_dims_ghostbox[0];
+  nxy = nx*grid->grid_dims_ghostbox[1];
+  phi = (LSMLIB_REAL*) malloc(grid->num_gridpts*sizeof(LSMLIB_REAL));
+  phi_sparse = (LSMLIB_REAL*) malloc(grid->num_gridpts*sizeof(LSMLIB_REAL));
+  createSphere(phi, 0.0, 0.0, 0.0, 0.5, -1, grid);
+
+  width = 6*dx;
+  background = 2*width;
+  sparse_grid = createSparseGrid(grid, 8, 2);
+  setSparseGridBackgroundValue(sparse_grid, PHI_FIELD, background, 1);
+  setSparseGridBackgroundValue(sparse_grid, COPY_FIELD, background, 1);
+  activateSparseGridBricksFromDenseData(sparse_grid, PHI_FIELD, phi, width);
+  printSparseGrid(sparse_grid, stdout);
+
+  /* round trip */
+  copySparseGridToDenseData(sparse_grid, PHI_FIELD, phi_sparse);
+  for (k = grid->klo_fb; k <= grid->khi_fb; k++) {
+    for (j = grid->jlo_fb; j <= grid->jhi_fb; j++) {
+      for (i = grid->ilo_fb; i <= grid->ihi_fb; i++) {
+        int bi = (i - grid->ilo_fb)/sparse_grid->brick_size;
+        int bj = (j - grid->jlo_fb)/sparse_grid->brick_size;
+        int bk = (k - grid->klo_fb)/sparse_grid->brick_size;
+        int t = bi + sparse_grid->num_bricks[0]
+                   * (bj + sparse_grid->num_bricks[1]*bk);
+        idx = i + j*nx + k*nxy;
+        if (sparse_grid->brick_table[t] >= 0) {
+          if (phi_sparse[idx] != phi[idx]) num_round_trip_errors++;
+        } else {
+          if ( (fabs(phi_sparse[idx]) != background)
+            || (phi_sparse[idx]*phi[idx] < 0) ) num_round_trip_errors++;
+        }
+      }
+    }
+  }
+
+  /* ghostcell fill and set */
+  brick_data = (LSMLIB_REAL*) malloc(
+    sparse_grid->num_brick_ghostbox_gridpts*sizeof(LSMLIB_REAL));
+  for (brick_idx = 0; brick_idx < sparse_grid->num_active_bricks;
+       brick_idx++) {
+    int *dims = sparse_grid->brick_dims_ghostbox;
+    int *coords = sparse_grid->brick_coords + 3*brick_idx;
+
+    getSparseGridBrickData(sparse_grid, PHI_FIELD, brick_idx, brick_data);
+
+    for (k = 0; k < dims[2]; k++) {
+      for (j = 0; j < dims[1]; j++) {
+        for (i = 0; i < dims[0]; i++) {
+          /* index of the grid cell in the full grid (copy extrapolation */
+          /* outside of the fillbox)                                      */
+          int ii = grid->ilo_fb + coords[0]*sparse_grid->brick_size
+                 + i - sparse_grid->ghostcell_width_lo[0];
+          int jj = grid->jlo_fb + coords[1]*sparse_grid->brick_size
+                 + j - sparse_grid->ghostcell_width_lo[1];
+          int kk = grid->klo_fb + coords[2]*sparse_grid->brick_size
+                 + k - sparse_grid->ghostcell_width_lo[2];
+          int t;
+          LSMLIB_REAL value = brick_data[i + j*dims[0] + k*dims[0]*dims[1]];
+
+          if (ii < grid->ilo_fb) ii = grid->ilo_fb;
+          if (ii > grid->ihi_fb) ii = grid->ihi_fb;
+          if (jj < grid->jlo_fb) jj = grid->jlo_fb;
+          if (jj > grid->jhi_fb) jj = grid->jhi_fb;
+          if (kk < grid->klo_fb) kk = grid->klo_fb;
+          if (kk > grid->khi_fb) kk = grid->khi_fb;
+          t = (ii - grid->ilo_fb)/sparse_grid->brick_size
+            + sparse_grid->num_bricks[0]
+            * ( (jj - grid->jlo_fb)/sparse_grid->brick_size
+              + sparse_grid->num_bricks[1]
+              * ((kk - grid->klo_fb)/sparse_grid->brick_size) );
+          idx = ii + jj*nx + kk*nxy;
+
+          if (sparse_grid->brick_table[t] >= 0) {
+            if (value != phi[idx]) num_ghostcell_errors++;
+          } else {
+            if (fabs(value) != background) num_ghostcell_errors++;
+          }
+        }
+      }
+    }
+
+    setSparseGridBrickData(sparse_grid, COPY_FIELD, brick_idx, brick_data);
+  }
+
+  copySparseGridToDenseData(sparse_grid, COPY_FIELD, phi_sparse);
+  for (k = grid->klo_fb; k <= grid->khi_fb; k++) {
+    for (j = grid->jlo_fb; j <= grid->jhi_fb; j++) {
+      for (i = grid->ilo_fb; i <= grid->ihi_fb; i++) {
+        idx = i + j*nx + k*nxy;
+        if (fabs(phi[idx]) < width && phi_sparse[idx] != phi[idx]) {
+          num_set_errors++;
+        }
+      }
+    }
+  }
+
+  sparse_bytes = (double) sparse_grid->num_alloc_bricks
+               * sparse_grid->num_brick_gridpts*sizeof(LSMLIB_REAL);
+  dense_bytes = (double) grid->num_gridpts*sizeof(LSMLIB_REAL);
+
+  printf("round trip errors:       %d\n", num_round_trip_errors);
+  printf("ghostcell errors:        %d\n", num_ghostcell_errors);
+  printf("set brick data errors:   %d\n", num_set_errors);
+  printf("memory per field (MB):   %g sparse, %g dense\n",
+         sparse_bytes/1048576.0, dense_bytes/1048576.0);
+
+  free(brick_data);
+  free(phi_sparse);
+  free(phi);
+  destroySparseGrid(sparse_grid);
+  destroyGrid(grid);
+
+  if ( (num_round_trip_errors > 0) || (num_ghostcell_errors > 0)
+    || (num_set_errors > 0) || (sparse_bytes >= dense_bytes) ) {
+    printf("FAILED\n");
+    return 1;
+  }
+  printf("PASSED\n");
+  return 0;
+}
@@ -0,0 +1,166 @@
+/*
+ * File:        test_zero_level_set_surface.c
+ * Copyrights:  (c) 2005 The Trustees of Princeton University and Board of
+ *                  Regents of the University of Texas.  All rights reserved.
+ *              (c) 2009 Kevin T. Chu.  All rights reserved.
+ * Revision:    $Revision$
+ * Modified:    $Date$
+ *
+ */
+
+/*
+ * This program tests that extractZeroLevelSetSurface3d() produces a
+ * closed, consistently oriented triangle mesh for the zero level set
+ * of a sphere of radius 0.5 on the domain [-1,1]^3 with dx = 0.05.
+ * For this grid, phi vanishes up to roundoff (|phi| ~ 1e-17) at the
+ * grid points where the sphere intersects the coordinate axes and at
+ * other grid points on the sphere.
+ *
+ * The following properties of the mesh are checked:
+ *  - no triangle has zero area;
+ *  - every edge is shared by exactly two triangles that traverse it
+ *    in opposite directions (i.e. the mesh is closed and consistently
+ *    oriented);
+ *  - the Euler characteristic is 2; and
+ *  - the volume enclosed by the mesh is positive (i.e. the normals
+ *    point outward) and close to the volume of the sphere.
+ *
+ */
+
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "lsm_grid.h"
+#include "lsm_initialization3d.h"
+#include "lsm_zero_level_set_surface.h"
+
+#define PI  (3.14159265358979323846)
+
+typedef struct {
+  int v0, v1;         /* vertices in the order traversed by triangle */
+} DirectedEdge;
+
+static int compareEdges(const void *a, const void *b);
+
+int main(void)
+{
+  LSMLIB_REAL x_lo[3] = {-1.0, -1.0, -1.0};
+  LSMLIB_REAL x_hi[3] = {1.0, 1.0, 1.0};
+  LSMLIB_REAL dx = 0.05;
+  LSMLIB_REAL radius = 0.5;
+  Grid *grid;
+  LSMLIB_REAL *phi;
+  ZeroLevelSetSurface *surface;
+  DirectedEdge *edges;
+  int num_edges;
+  int num_near_zero_phi = 0;
+  int num_zero_area = 0;
+  int num_same_direction = 0;
+  int num_nonmanifold = 0;
+  int euler_characteristic;
+  LSMLIB_REAL volume = 0.0;
+  LSMLIB_REAL exact_volume = 4.0/3.0*PI*radius*radius*radius;
+  int idx, e, n;
+
+  grid = createGridSetDx(3, dx, x_lo, x_hi, LOW);
+  phi = (LSMLIB_REAL*) malloc(grid->num_gridpts*sizeof(LSMLIB_REAL));
+  createSphere(phi, 0.0, 0.0, 0.0, radius, -1, grid);
+  for (idx = 0; idx < grid->num_gridpts; idx++) {
+    if ( (phi[idx] != 0.0) && (fabs(phi[idx]) < 1.e-12) ) {
+      num_near_zero_phi++;
+    }
+  }
+
+  surface = createZeroLevelSetSurface(3, 0);
+  if (extractZeroLevelSetSurface3d(surface, phi, NULL, grid) <= 0) {
+    printf("FAILED: no triangles extracted\n");
+    return 1;
+  }
+
+  /* check areas and collect directed edges */
+  num_edges = 3*surface->num_elements;
+  edges = (DirectedEdge*) malloc(num_edges*sizeof(DirectedEdge));
+  for (e = 0; e < surface->num_elements; e++) {
+    int *tri = &(surface->elements[3*e]);
+    LSMLIB_REAL *x0 = &(surface->vertices[3*tri[0]]);
+    LSMLIB_REAL *x1 = &(surface->vertices[3*tri[1]]);
+    LSMLIB_REAL *x2 = &(surface->vertices[3*tri[2]]);
+    LSMLIB_REAL a[3], b[3], normal[3];
+    for (n = 0; n < 3; n++) {
+      a[n] = x1[n] - x0[n];
+      b[n] = x2[n] - x0[n];
+    }
+    normal[0] = a[1]*b[2] - a[2]*b[1];
+    normal[1] = a[2]*b[0] - a[0]*b[2];
+    normal[2] = a[0]*b[1] - a[1]*b[0];
+    if (0.5*sqrt(normal[0]*normal[0] + normal[1]*normal[1]
+               + normal[2]*normal[2]) < 1.e-12*dx*dx) {
+      num_zero_area++;
+    }
+    volume += (x0[0]*normal[0] + x0[1]*normal[1] + x0[2]*normal[2])/6.0;
+
+    for (n = 0; n < 3; n++) {
+      edges[3*e+n].v0 = tri[n];
+      edges[3*e+n].v1 = tri[(n+1)%3];
+    }
+  }
+
+  /* every directed edge must appear exactly once and its reverse */
+  /* must also appear exactly once                                 */
+  qsort(edges, num_edges, sizeof(DirectedEdge), compareEdges);
+  for (e = 0; e < num_edges; e++) {
+    DirectedEdge reverse;
+    if ( (e > 0) && (compareEdges(&edges[e], &edges[e-1]) == 0) ) {
+      num_same_direction++;
+      continue;
+    }
+    reverse.v0 = edges[e].v1;
+    reverse.v1 = edges[e].v0;
+    if (!bsearch(&reverse, edges, num_edges, sizeof(DirectedEdge),
+                 compareEdges)) {
+      num_nonmanifold++;
+    }
+  }
+  euler_characteristic = surface->num_vertices - num_edges/2
+                       + surface->num_elements;
+
+  printf("grid points with |phi| < 1e-12:          %d\n", num_near_zero_phi);
+  printf("vertices:                                %d\n",
+         surface->num_vertices);
+  printf("triangles:                               %d\n",
+         surface->num_elements);
+  printf("zero-area triangles:                     %d\n", num_zero_area);
+  printf("edges traversed in same direction:       %d\n",
+         num_same_direction);
+  printf("edges without oppositely directed edge:  %d\n", num_nonmanifold);
+  printf("Euler characteristic:                    %d\n",
+         euler_characteristic);
+  printf("enclosed volume (exact):                 %g (%g)\n",
+         volume, exact_volume);
+
+  free(edges);
+  destroyZeroLevelSetSurface(surface);
+  free(phi);
+  destroyGrid(grid);
+
+  if ( (num_zero_area > 0) || (num_same_direction > 0)
+    || (num_nonmanifold > 0) || (euler_characteristic != 2)
+    || (fabs(volume - exact_volume) > 0.05*exact_volume) ) {
+    printf("FAILED\n");
+    return 1;
+  }
+  printf("PASSED\n");
+  return 0;
+}
+
+
+/* compareEdges() orders directed edges lexicographically */
+static int compareEdges(const void *a, const void *b)
+{
+  const DirectedEdge *e1 = (const DirectedEdge*) a;
+  const DirectedEdge *e2 = (const DirectedEdge*) b;
+  if (e1->v0 != e2->v0) return (e1->v0 < e2->v0) ? -1 : 1;
+  if (e1->v1 != e2->v1) return (e1->v1 < e2->v1) ? -1 : 1;
+  return 0;
+}
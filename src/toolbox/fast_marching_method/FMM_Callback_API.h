@@ -101,6 +101,43 @@ LSMLIB_REAL updateGridPoint_CallbackFunc(
   int *grid_dims,
   LSMLIB_REAL *dx);
 
+/*!
+ * acceptGridPoint_CallbackFunc() defines the signature of the (optional)
+ * callback function invoked by FMM_Core_advanceFront() when a grid 
+ * point is accepted (i.e. its status is changed to KNOWN).  It is
+ * typically used to compute quantities at the grid point that depend
+ * only on the final set of KNOWN neighbors (e.g. extension field 
+ * values), so that they are computed once instead of every time 
+ * updateGridPoint_CallbackFunc() is called for the grid point.
+ *
+ * Arguments:
+ *  - fmm_core_data (in/out):       FMM_CoreData "object" actively managing 
+ *                                  the FMM computation
+ *  - fmm_field_data (in/out):      pointer to FMM_FieldData containing
+ *                                  application specific field data
+ *  - grid_idx (in):                integer array containing the grid index 
+ *                                  of the accepted grid point
+ *  - num_dims (in):                number of dimensions for FMM computation
+ *  - grid_dims (in):               integer array of dimensions of computational
+ *                                  grid
+ *  - dx (in):                      LSMLIB_REAL array containing grid cell 
+ *                                  sizes in each of the coordinate directions
+ *
+ * Return value:                    none
+ *
+ * NOTES:
+ *  - The callback function is registered using 
+ *    FMM_Core_setAcceptGridPointCallback().
+ *
+ */
+void acceptGridPoint_CallbackFunc(
+  FMM_CoreData *fmm_core_data, 
+  FMM_FieldData *fmm_field_data, 
+  int *grid_idx,
+  int num_dims,
+  int *grid_dims,
+  LSMLIB_REAL *dx);
+
 #ifdef __cplusplus
 }
 #endif
@@ -74,6 +74,7 @@ struct FMM_CoreData {
   /* function pointer to grid update function */
   initializeFrontFuncPtr initializeFront;
   updateGridPointFuncPtr updateGridPoint;
+  acceptGridPointFuncPtr acceptGridPoint;
 
   /* internal data */
   int* heapnode_handles;
@@ -121,6 +122,7 @@ FMM_CoreData* FMM_Core_createFMM_CoreData(
   fmm_core_data->fmm_field_data = fmm_field_data;
   fmm_core_data->initializeFront = initializeFront;
   fmm_core_data->updateGridPoint = updateGridPoint;
+  fmm_core_data->acceptGridPoint = FMM_CORE_NULL;
 
   /* initialize grid_dims and dx to zero */
   for (i = 0; i < FMM_CORE_MAX_NDIM; i++) {
@@ -144,6 +146,10 @@ FMM_CoreData* FMM_Core_createFMM_CoreData(
   fmm_core_data->trial_points = 
     FMM_Heap_createHeap(num_dims,initial_heap_size,0); 
 
+  /* create an FMM_Heap to store the known points on the initial front */
+  fmm_core_data->known_points = 
+    FMM_Heap_createHeap(num_dims,initial_heap_size,0); 
+
   /* initialize heapnode handles to have a default value of -1 */
   ptr = fmm_core_data->heapnode_handles;
   for (i = 0; i < num_gridpoints; i++, ptr++) {
@@ -160,13 +166,38 @@ FMM_CoreData* FMM_Core_createFMM_CoreData(
 }
 
 
+void FMM_Core_resetFMM_CoreData(FMM_CoreData *fmm_core_data)
+{
+  int num_dims = fmm_core_data->num_dims; 
+  int *grid_dims = fmm_core_data->grid_dims;
+  int num_gridpoints;              /* number of grid points */
+  int i;                           /* loop variable */
+  int *handle_ptr, *status_ptr;    /* integer pointer loop variables */
+
+  /* compute number of grid points */
+  num_gridpoints = 1;
+  for (i = 0; i < num_dims; i++) num_gridpoints *= grid_dims[i];
+
+  /* empty the heaps (the memory allocated for them is retained) */
+  FMM_Heap_clear(fmm_core_data->trial_points);
+  FMM_Heap_clear(fmm_core_data->known_points);
+
+  /* reset heapnode handles to -1 and gridpoint status to FAR */
+  handle_ptr = fmm_core_data->heapnode_handles;
+  status_ptr = fmm_core_data->gridpoint_status;
+  for (i = 0; i < num_gridpoints; i++, handle_ptr++, status_ptr++) {
+    *handle_ptr = -1;
+    *status_ptr = FAR;
+  }
+}
+
+
 void FMM_Core_destroyFMM_CoreData(FMM_CoreData *fmm_core_data)
 {
   free(fmm_core_data->heapnode_handles);
   free(fmm_core_data->gridpoint_status);
   FMM_Heap_destroyHeap(fmm_core_data->trial_points);
-  if (fmm_core_data->known_points != FMM_CORE_NULL)
-    FMM_Heap_destroyHeap(fmm_core_data->known_points);
+  FMM_Heap_destroyHeap(fmm_core_data->known_points);
   free(fmm_core_data);
 }
 
@@ -174,32 +205,15 @@ void FMM_Core_destroyFMM_CoreData(FMM_CoreData *fmm_core_data)
 void FMM_Core_initializeFront(FMM_CoreData *fmm_core_data)
 {
   int num_dims = fmm_core_data->num_dims; 
-  int *grid_dims = fmm_core_data->grid_dims;
   FMM_FieldData *fmm_field_data = fmm_core_data->fmm_field_data;
-  int num_gridpoints;
 
   /* list of known points */
-  FMM_Heap *known_points; 
-  int initial_heap_size;
+  FMM_Heap *known_points = fmm_core_data->known_points; 
   int grid_idx[FMM_CORE_MAX_NDIM];
 
   /* auxilliary variables */
   int i;         /* loop variable */
 
-  /* compute the number of grid points and initial heap size */
-  num_gridpoints = 1;
-  initial_heap_size = 0;
-  for (i = 0; i < num_dims; i++) {
-    num_gridpoints *= grid_dims[i];
-    initial_heap_size += grid_dims[i];
-  }
-
-  /* create FMM_Heap to contain known points      */
-  /* NOTE: using default heap growth factor by    */
-  /*       specifying 0 for the second argument   */
-  known_points = FMM_Heap_createHeap(num_dims,initial_heap_size,0);
-  fmm_core_data->known_points = known_points;
-
   /* let user-provided callback function find and initialize the front */
   fmm_core_data->initializeFront(
     fmm_core_data, 
@@ -240,10 +254,6 @@ void FMM_Core_initializeFront(FMM_CoreData *fmm_core_data)
     }
 
   } /* end loop over "known" points */
-
-  /* clean up memory */
-  FMM_Heap_destroyHeap(known_points);
-  fmm_core_data->known_points = FMM_CORE_NULL;
 }
 
 
@@ -315,6 +325,34 @@ void FMM_Core_markPointOutsideDomain(
 
 }
 
+void FMM_Core_markPointsOutsideDomain(
+  FMM_CoreData *fmm_core_data, 
+  LSMLIB_REAL *mask)
+{
+  int num_dims = fmm_core_data->num_dims; 
+  int *grid_dims = fmm_core_data->grid_dims;
+  int *gridpoint_status = fmm_core_data->gridpoint_status; 
+  int num_gridpoints;   /* number of grid points */
+  int i, idx;           /* loop variables */
+
+  /* compute number of grid points */
+  num_gridpoints = 1;
+  for (i = 0; i < num_dims; i++) num_gridpoints *= grid_dims[i];
+
+  /* set status of grid points with a negative mask value to */
+  /* OUTSIDE_DOMAIN                                          */
+  for (idx = 0; idx < num_gridpoints; idx++) {
+    if (mask[idx] < 0) gridpoint_status[idx] = OUTSIDE_DOMAIN;
+  }
+}
+
+void FMM_Core_setAcceptGridPointCallback(
+  FMM_CoreData *fmm_core_data,
+  acceptGridPointFuncPtr acceptGridPoint)
+{
+  fmm_core_data->acceptGridPoint = acceptGridPoint;
+}
+
 /* 
  * NOTES:
  *  (1) There may be some error in the update of cells on the border 
@@ -348,6 +386,17 @@ void FMM_Core_advanceFront(FMM_CoreData *fmm_core_data)
   FMM_CORE_IDX(idx, num_dims, min_node.grid_idx, grid_dims);
   gridpoint_status[idx] = KNOWN;
 
+  /* let user-provided callback function finalize the values at */
+  /* the accepted grid point                                    */
+  if (fmm_core_data->acceptGridPoint) {
+    fmm_core_data->acceptGridPoint(fmm_core_data, 
+                                   fmm_core_data->fmm_field_data,
+                                   min_node.grid_idx,
+                                   fmm_core_data->num_dims, 
+                                   fmm_core_data->grid_dims, 
+                                   fmm_core_data->dx);
+  }
+
   /* update neighbors */
   FMM_Core_updateNeighbors(fmm_core_data, min_node.grid_idx);
 
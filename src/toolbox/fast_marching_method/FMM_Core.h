@@ -37,10 +37,17 @@ extern "C" {
  * -# Create an FMM_CoreData structure using FMM_Core_createFMM_CoreData().
  * -# Initialize the front using FMM_Core_initializeFront().  
  * -# Mark grid points that are outside of the mathematical domain for 
- *    the problem using the FMM_Core_markPointOutsideDomain() function.
+ *    the problem using the FMM_Core_markPointOutsideDomain() or
+ *    FMM_Core_markPointsOutsideDomain() functions.
+ * -# Optionally, register a callback function that is invoked whenever
+ *    a grid point is accepted (i.e. its status is changed to KNOWN)
+ *    using FMM_Core_setAcceptGridPointCallback().
  * -# Advance the front as far as desired using FMM_Core_advanceFront().
  *    Typically, the front is advanced until there are no more grid 
  *    points to update.
+ * -# To carry out another FMM calculation on the same grid, reset the
+ *    FMM_CoreData using FMM_Core_resetFMM_CoreData() and repeat the
+ *    previous steps (except for creating the FMM_CoreData).
  * -# Clean up the memory allocated for the FMM_CoreData using
  *    FMM_Core_destroyFMM_CoreData().
  *
@@ -94,6 +101,20 @@ typedef LSMLIB_REAL (*updateGridPointFuncPtr)(
   LSMLIB_REAL *dx);
 
 
+/*!
+ * acceptGridPointFuncPtr is a function pointer to one of the callback 
+ * functions defined in @ref FMM_Callback_API.h.  Unlike the other 
+ * callback functions, this callback function is optional.
+ */
+typedef void (*acceptGridPointFuncPtr)(  
+  FMM_CoreData *fmm_core_data,
+  FMM_FieldData *fmm_field_data,
+  int *grid_idx,
+  int num_dims,
+  int *grid_dims,
+  LSMLIB_REAL *dx);
+
+
 /*================== FMM_Core Function Declarations ==================*/
 
 /*!
@@ -156,6 +177,26 @@ FMM_CoreData* FMM_Core_createFMM_CoreData(
  */
 void FMM_Core_destroyFMM_CoreData(FMM_CoreData *fmm_core_data);
 
+/*!
+ * FMM_Core_resetFMM_CoreData() restores an FMM_CoreData structure to
+ * the state it had immediately after it was created so that it can be 
+ * reused for another FMM calculation on the same grid.  
+ *
+ * Arguments:
+ *  - fmm_core_data (in/out):  FMM_CoreData "object" to be reset
+ *
+ * Return value:               none
+ *
+ * NOTES:
+ *  - No memory is allocated or freed.  The FMM_FieldData, callback 
+ *    functions, grid dimensions and grid spacing are unchanged.
+ *
+ *  - All grid points are given status FAR (including grid points
+ *    that were previously marked as being outside of the domain).
+ *
+ */
+void FMM_Core_resetFMM_CoreData(FMM_CoreData *fmm_core_data);
+
 /*!
  * FMM_Core_initializeFront() sets the initial set of "known" and "trial"
  * points.  It first initializes the list of "known" points by 
@@ -231,6 +272,67 @@ void FMM_Core_markPointOutsideDomain(
   FMM_CoreData *fmm_core_data, 
   int *grid_idx);
 
+/*!
+ * FMM_Core_markPointsOutsideDomain() sets all grid points with a
+ * negative mask value as being outside of the mathematical domain for 
+ * the problem.
+ *
+ * Arguments:
+ *  - fmm_core_data (in):  FMM_CoreData "object" actively managing the 
+ *                         FMM computation
+ *  - mask (in):           mask for domain of problem; grid points 
+ *                         outside of the domain of the problem should 
+ *                         be set to a negative value
+ *
+ * Return value:           none
+ *
+ * NOTES:
+ *  - This function is equivalent to calling 
+ *    FMM_Core_markPointOutsideDomain() for every grid point with a
+ *    negative mask value, but makes a single pass through the
+ *    data arrays.
+ *
+ *  - It is assumed that the mask data array has the same index space
+ *    extents as the grid used to create the FMM_CoreData and is 
+ *    stored in Fortran order (i.e. column-major order).
+ *
+ */
+void FMM_Core_markPointsOutsideDomain(
+  FMM_CoreData *fmm_core_data, 
+  LSMLIB_REAL *mask);
+
+/*!
+ * FMM_Core_setAcceptGridPointCallback() sets the callback function 
+ * that is invoked by FMM_Core_advanceFront() when a grid point is 
+ * accepted (i.e. removed from the set of "trial" points and given
+ * status KNOWN).
+ *
+ * Arguments:
+ *  - fmm_core_data (in/out):  FMM_CoreData "object" actively managing 
+ *                             the FMM computation
+ *  - acceptGridPoint (in):    callback function pointer that is used
+ *                             to finalize the values at grid points 
+ *                             when they are accepted (see 
+ *                             @ref FMM_Callback_API.h for more details);
+ *                             NULL disables the callback
+ *
+ * Return value:               none
+ *
+ * NOTES:
+ *  - By default, no callback function is invoked when a grid point 
+ *    is accepted.
+ *
+ *  - The callback function is invoked before the neighbors of the
+ *    accepted grid point are updated.
+ *
+ *  - The callback function is NOT invoked for the grid points on the 
+ *    initial front (which are set by FMM_Core_setInitialFrontPoint()).
+ *
+ */
+void FMM_Core_setAcceptGridPointCallback(
+  FMM_CoreData *fmm_core_data,
+  acceptGridPointFuncPtr acceptGridPoint);
+
 /*!
  * FMM_Core_advanceFront() advances the front of "known" grid points by
  * a single grid point.  It basically carries out the main update
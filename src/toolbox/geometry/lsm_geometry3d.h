@@ -600,6 +600,99 @@ int LSM3D_findLineInTetrahedron(
   const LSMLIB_REAL *phi,
   const LSMLIB_REAL *psi);
 
+/*!
+ * LSM3D_findLineSegmentsInBox() finds the line segments that make up the
+ * curve defined by the zero-level sets of \f$ \phi \f$ and \f$ \psi \f$
+ * within a box of grid cells.  Each grid cell is decomposed into six 
+ * tetrahedra and the line segment within each tetrahedron is computed 
+ * using LSM3D_findLineInTetrahedron().  Cells where either 
+ * \f$ \phi \f$ or \f$ \psi \f$ has the same sign at all eight 
+ * corners are skipped.
+ *
+ * Arguments:
+ *  - segments (out):         endpoints of line segments (endpt1 and 
+ *                            endpt2 for each segment, i.e. 6 values per
+ *                            segment); may be NULL
+ *  - max_num_segments (in):  number of segments that segments array 
+ *                            can hold
+ *  - length (out):           total length of line segments
+ *  - phi (in):               level set function \f$ \phi \f$
+ *  - psi (in):               level set function \f$ \psi \f$
+ *  - *_gb (in):              index range for ghostbox of phi and psi
+ *  - control_vol (in):       control volume data (used to exclude cells
+ *                            from the calculation); may be NULL
+ *  - *_control_vol_gb (in):  index range for ghostbox of control_vol
+ *  - *_ib (in):              index range of lower corners of cells to 
+ *                            include in calculation 
+ *  - x_lo (in):              coordinates of grid point with index 
+ *                            (ilo_gb, jlo_gb, klo_gb)
+ *  - dx, dy, dz (in):        grid spacing
+ *
+ * Return value:              number of line segments found; negative
+ *                            if LSM3D_findLineInTetrahedron() failed 
+ *                            (the value is the error code it returned)
+ *
+ * NOTES:
+ *  - A grid cell with lower corner (i,j,k) has corners at the grid 
+ *    points (i,j,k) through (i+1,j+1,k+1), so only cells whose corners
+ *    all lie in the ghostbox are included.  To find the curve in 
+ *    adjacent boxes (e.g. patches) without gaps or duplicate segments, 
+ *    include the lower corners of the cells in the interior box of each
+ *    patch and fill one layer of ghost cells.
+ *
+ *  - When control_vol is not NULL, a cell is included only if the 
+ *    control volume at its lower corner is positive.  The ghostbox of
+ *    control_vol must contain the lower corners of the cells in the
+ *    interior box.
+ *
+ *  - Segments beyond max_num_segments are not stored but are included
+ *    in the return value and length, so the required size of the 
+ *    segments array can be obtained by calling the function with 
+ *    segments set to NULL.
+ *
+ *  - (endpt2 - endpt1) for each segment points in the direction 
+ *    [ grad(phi) cross grad(psi) ], so segments from neighboring cells
+ *    may be joined into oriented curves.
+ *
+ *  - Values of \f$ \phi \f$ and \f$ \psi \f$ that are exactly zero 
+ *    are treated as small positive values (LSMLIB_ZERO_TOL) so that 
+ *    the curve never lies in a face shared by two tetrahedra.
+ *
+ *  - Because the cell decomposition is the same for all cells, the 
+ *    endpoints of segments on a face shared by two cells agree up to 
+ *    round-off error.
+ *
+ */
+int LSM3D_findLineSegmentsInBox(
+  LSMLIB_REAL *segments,
+  const int max_num_segments,
+  LSMLIB_REAL *length,
+  const LSMLIB_REAL *phi,
+  const LSMLIB_REAL *psi,
+  const int *ilo_gb,
+  const int *ihi_gb,
+  const int *jlo_gb,
+  const int *jhi_gb,
+  const int *klo_gb,
+  const int *khi_gb,
+  const LSMLIB_REAL *control_vol,
+  const int *ilo_control_vol_gb,
+  const int *ihi_control_vol_gb,
+  const int *jlo_control_vol_gb,
+  const int *jhi_control_vol_gb,
+  const int *klo_control_vol_gb,
+  const int *khi_control_vol_gb,
+  const int *ilo_ib,
+  const int *ihi_ib,
+  const int *jlo_ib,
+  const int *jhi_ib,
+  const int *klo_ib,
+  const int *khi_ib,
+  const LSMLIB_REAL *x_lo,
+  const LSMLIB_REAL *dx,
+  const LSMLIB_REAL *dy,
+  const LSMLIB_REAL *dz);
+
 #ifdef __cplusplus
 }
 #endif
@@ -904,3 +904,161 @@ int LSM3D_findLineInTetrahedron(
   return count;
 }
 
+
+
+/*
+ * LSM_GEOM_3D_KUHN_TETRAHEDRA lists the corners of the six tetrahedra 
+ * used to decompose a grid cell.  Corners of the cell are numbered 
+ * using the bits of the corner number: bit 0 (1, 2) is set if the 
+ * corner is at the upper end of the cell in the x (y, z) direction.  
+ * All of the tetrahedra share the main diagonal of the cell, so the 
+ * decompositions of neighboring cells are consistent on shared faces.
+ */
+static const int LSM_GEOM_3D_KUHN_TETRAHEDRA[6][4] = {
+  {0, 1, 3, 7},
+  {0, 1, 5, 7},
+  {0, 2, 3, 7},
+  {0, 2, 6, 7},
+  {0, 4, 5, 7},
+  {0, 4, 6, 7} };
+
+
+int LSM3D_findLineSegmentsInBox(
+  LSMLIB_REAL *segments,
+  const int max_num_segments,
+  LSMLIB_REAL *length,
+  const LSMLIB_REAL *phi,
+  const LSMLIB_REAL *psi,
+  const int *ilo_gb,
+  const int *ihi_gb,
+  const int *jlo_gb,
+  const int *jhi_gb,
+  const int *klo_gb,
+  const int *khi_gb,
+  const LSMLIB_REAL *control_vol,
+  const int *ilo_control_vol_gb,
+  const int *ihi_control_vol_gb,
+  const int *jlo_control_vol_gb,
+  const int *jhi_control_vol_gb,
+  const int *klo_control_vol_gb,
+  const int *khi_control_vol_gb,
+  const int *ilo_ib,
+  const int *ihi_ib,
+  const int *jlo_ib,
+  const int *jhi_ib,
+  const int *klo_ib,
+  const int *khi_ib,
+  const LSMLIB_REAL *x_lo,
+  const LSMLIB_REAL *dx,
+  const LSMLIB_REAL *dy,
+  const LSMLIB_REAL *dz)
+{
+  /* data array layout */
+  const int nx = *ihi_gb - *ilo_gb + 1;
+  const int ny = *jhi_gb - *jlo_gb + 1;
+  const int nxy = nx*ny;
+  const int nx_cv = *ihi_control_vol_gb - *ilo_control_vol_gb + 1;
+  const int ny_cv = *jhi_control_vol_gb - *jlo_control_vol_gb + 1;
+  const int nxy_cv = nx_cv*ny_cv;
+
+  /* offsets of cell corners relative to lower corner */
+  int corner_offset[8];
+
+  /* cells to process (cells need all corners within ghostbox) */
+  const int i_min = (*ilo_ib > *ilo_gb) ? *ilo_ib : *ilo_gb;
+  const int j_min = (*jlo_ib > *jlo_gb) ? *jlo_ib : *jlo_gb;
+  const int k_min = (*klo_ib > *klo_gb) ? *klo_ib : *klo_gb;
+  const int i_max = (*ihi_ib < *ihi_gb) ? *ihi_ib : *ihi_gb-1;
+  const int j_max = (*jhi_ib < *jhi_gb) ? *jhi_ib : *jhi_gb-1;
+  const int k_max = (*khi_ib < *khi_gb) ? *khi_ib : *khi_gb-1;
+
+  int num_segments = 0;
+  int i, j, k, c;
+
+  for (c = 0; c < 8; c++) {
+    corner_offset[c] = (c & 1) + ((c >> 1) & 1)*nx + ((c >> 2) & 1)*nxy;
+  }
+
+  *length = 0.0;
+
+  for (k = k_min; k <= k_max; k++) {
+    for (j = j_min; j <= j_max; j++) {
+      for (i = i_min; i <= i_max; i++) {
+
+        int idx_cell = (i-*ilo_gb) + (j-*jlo_gb)*nx + (k-*klo_gb)*nxy;
+        LSMLIB_REAL phi_corner[8], psi_corner[8];
+        LSMLIB_REAL x_corner[8][3];
+        int num_phi_pos = 0, num_psi_pos = 0;
+        int t;
+
+        /* skip cells excluded by the control volume */
+        if ( (control_vol) && 
+             (control_vol[ (i-*ilo_control_vol_gb) 
+                         + (j-*jlo_control_vol_gb)*nx_cv
+                         + (k-*klo_control_vol_gb)*nxy_cv ] <= 0) ) {
+          continue;
+        }
+
+        /* gather values at corners of cell.  values that are exactly  */
+        /* zero are treated as small positive values so that the line  */
+        /* never lies in a face shared by two tetrahedra               */
+        for (c = 0; c < 8; c++) {
+          phi_corner[c] = phi[idx_cell + corner_offset[c]];
+          psi_corner[c] = psi[idx_cell + corner_offset[c]];
+          if (phi_corner[c] == 0) phi_corner[c] = LSMLIB_ZERO_TOL;
+          if (psi_corner[c] == 0) psi_corner[c] = LSMLIB_ZERO_TOL;
+          if (phi_corner[c] > 0) num_phi_pos++;
+          if (psi_corner[c] > 0) num_psi_pos++;
+        }
+
+        /* skip cells where phi or psi does not change sign */
+        if ( (num_phi_pos == 0) || (num_phi_pos == 8) ||
+             (num_psi_pos == 0) || (num_psi_pos == 8) ) continue;
+
+        /* compute coordinates of corners of cell */
+        for (c = 0; c < 8; c++) {
+          x_corner[c][0] = x_lo[0] + (*dx)*(i - *ilo_gb + (c & 1));
+          x_corner[c][1] = x_lo[1] + (*dy)*(j - *jlo_gb + ((c >> 1) & 1));
+          x_corner[c][2] = x_lo[2] + (*dz)*(k - *klo_gb + ((c >> 2) & 1));
+        }
+
+        /* find {phi=0,psi=0} line in each tetrahedron of the cell */
+        for (t = 0; t < 6; t++) {
+          const int *tet = LSM_GEOM_3D_KUHN_TETRAHEDRA[t];
+          LSMLIB_REAL phi_tet[4], psi_tet[4];
+          LSMLIB_REAL endpt1[3], endpt2[3];
+          LSMLIB_REAL seg_x, seg_y, seg_z;
+          int count;
+
+          for (c = 0; c < 4; c++) {
+            phi_tet[c] = phi_corner[tet[c]];
+            psi_tet[c] = psi_corner[tet[c]];
+          }
+
+          count = LSM3D_findLineInTetrahedron(endpt1, endpt2,
+            x_corner[tet[0]], x_corner[tet[1]],
+            x_corner[tet[2]], x_corner[tet[3]],
+            phi_tet, psi_tet);
+
+          if (count < 0) return count;  /* error */
+          if (count < 2) continue;      /* no line segment */
+
+          if ( (segments) && (num_segments < max_num_segments) ) {
+            LSMLIB_REAL *seg = &(segments[6*num_segments]);
+            seg[0] = endpt1[0]; seg[1] = endpt1[1]; seg[2] = endpt1[2];
+            seg[3] = endpt2[0]; seg[4] = endpt2[1]; seg[5] = endpt2[2];
+          }
+          num_segments++;
+
+          seg_x = endpt2[0] - endpt1[0];
+          seg_y = endpt2[1] - endpt1[1];
+          seg_z = endpt2[2] - endpt1[2];
+          *length += sqrt(seg_x*seg_x + seg_y*seg_y + seg_z*seg_z);
+        }
+
+      }
+    }
+  } /* end loop over cells */
+
+  return num_segments;
+}
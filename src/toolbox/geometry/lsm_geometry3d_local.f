@@ -0,0 +1,387 @@
+c***********************************************************************
+c
+c  File:        lsm_geometry3d_local.f
+c  Copyrights:  (c) 2005 The Trustees of Princeton University and Board of
+c                   Regents of the University of Texas.  All rights reserved.
+c               (c) 2009 Kevin T. Chu.  All rights reserved.
+c  Revision:    $Revision$
+c  Modified:    $Date$
+c  Description: F77 routines for 3D level set method geometry subroutines 
+c               for narrow-band computations
+c
+c***********************************************************************
+
+c***********************************************************************
+c
+c  lsm3dVolumeRegionPhiLessThanZeroLocal() computes the volume of the 
+c  region where the level set function is less than 0.  Only the narrow 
+c  band voxels are visited; the remaining voxels are accounted for by 
+c  the number of voxels outside of the narrow band where phi < 0.
+c
+c  Arguments:
+c    volume (out):             volume of the region where phi < 0
+c    phi (in):                 level set function
+c    dx, dy, dz (in):          grid spacing
+c    epsilon (in):             width of numerical smoothing to use for 
+c                              Heaviside function
+c    num_vox_outside_nb (in):  number of voxels in fillbox that are not
+c                              in the narrow band and have phi < 0
+c    *_gb (in):                index range for ghostbox
+c    index_*(in):              coordinates of local (narrow band) points
+c    n*_index(in):             index range of points to loop over in 
+c                              index_*
+c    narrow_band(in):          array that marks voxels outside desired 
+c                              fillbox
+c    mark_fb(in):              upper limit narrow band value for voxels 
+c                              in fillbox
+c
+c***********************************************************************
+      subroutine lsm3dVolumeRegionPhiLessThanZeroLocal(
+     &  volume,
+     &  phi,
+     &  ilo_phi_gb, ihi_phi_gb,
+     &  jlo_phi_gb, jhi_phi_gb,
+     &  klo_phi_gb, khi_phi_gb,
+     &  dx, dy, dz,
+     &  epsilon,
+     &  num_vox_outside_nb,
+     &  index_x,
+     &  index_y, 
+     &  index_z, 
+     &  nlo_index, nhi_index,
+     &  narrow_band,
+     &  ilo_nb_gb, ihi_nb_gb, 
+     &  jlo_nb_gb, jhi_nb_gb, 
+     &  klo_nb_gb, khi_nb_gb,
+     &  mark_fb)
+c***********************************************************************
+c { begin subroutine
+      implicit none
+
+      real volume
+
+c     _gb refers to ghostbox 
+      integer ilo_phi_gb, ihi_phi_gb
+      integer jlo_phi_gb, jhi_phi_gb
+      integer klo_phi_gb, khi_phi_gb
+      real phi(ilo_phi_gb:ihi_phi_gb,
+     &         jlo_phi_gb:jhi_phi_gb,
+     &         klo_phi_gb:khi_phi_gb)
+      real dx,dy,dz
+      real epsilon
+      integer num_vox_outside_nb
+      integer nlo_index, nhi_index
+      integer index_x(nlo_index:nhi_index)
+      integer index_y(nlo_index:nhi_index)
+      integer index_z(nlo_index:nhi_index)
+      integer ilo_nb_gb, ihi_nb_gb
+      integer jlo_nb_gb, jhi_nb_gb
+      integer klo_nb_gb, khi_nb_gb
+      integer*1 narrow_band(ilo_nb_gb:ihi_nb_gb,
+     &                      jlo_nb_gb:jhi_nb_gb,
+     &                      klo_nb_gb:khi_nb_gb)
+      integer*1 mark_fb
+
+c     local variables      
+      integer i,j,k,l
+      real phi_cur
+      real phi_cur_over_epsilon
+      real one_minus_H
+      real dV
+      real pi
+      parameter (pi=3.14159265358979323846d0)
+      real one_over_pi
+      parameter (one_over_pi=0.31830988618379d0)
+
+
+c     compute dV = dx * dy * dz
+      dV = dx * dy * dz
+
+c     initialize volume with contribution from voxels outside of the
+c     narrow band
+      volume = num_vox_outside_nb*dV
+
+c     { begin loop over indexed points
+      do l=nlo_index, nhi_index              
+        i=index_x(l)
+        j=index_y(l)
+        k=index_z(l)
+
+c       include only fill box points (marked appropriately)
+        if( narrow_band(i,j,k) .le. mark_fb ) then
+
+          phi_cur = phi(i,j,k)
+          phi_cur_over_epsilon = phi_cur/epsilon
+
+          if (phi_cur .lt. -epsilon) then
+            volume = volume + dV
+          elseif (phi_cur .lt. epsilon) then
+            one_minus_H = 0.5d0*(1 - phi_cur_over_epsilon
+     &                             - one_over_pi
+     &                             * sin(pi*phi_cur_over_epsilon))
+            volume = volume + one_minus_H*dV
+          endif
+
+        endif
+      enddo
+c     } end loop over indexed points
+
+      return
+      end
+c } end subroutine
+c***********************************************************************
+
+
+c***********************************************************************
+c
+c  lsm3dVolumeRegionPhiGreaterThanZeroLocal() computes the volume of the 
+c  region where the level set function is greater than 0.  Only the narrow 
+c  band voxels are visited; the remaining voxels are accounted for by 
+c  the number of voxels outside of the narrow band where phi > 0.
+c
+c  Arguments:
+c    volume (out):             volume of the region where phi > 0
+c    phi (in):                 level set function
+c    dx, dy, dz (in):          grid spacing
+c    epsilon (in):             width of numerical smoothing to use for 
+c                              Heaviside function
+c    num_vox_outside_nb (in):  number of voxels in fillbox that are not
+c                              in the narrow band and have phi > 0
+c    *_gb (in):                index range for ghostbox
+c    index_*(in):              coordinates of local (narrow band) points
+c    n*_index(in):             index range of points to loop over in 
+c                              index_*
+c    narrow_band(in):          array that marks voxels outside desired 
+c                              fillbox
+c    mark_fb(in):              upper limit narrow band value for voxels 
+c                              in fillbox
+c
+c***********************************************************************
+      subroutine lsm3dVolumeRegionPhiGreaterThanZeroLocal(
+     &  volume,
+     &  phi,
+     &  ilo_phi_gb, ihi_phi_gb,
+     &  jlo_phi_gb, jhi_phi_gb,
+     &  klo_phi_gb, khi_phi_gb,
+     &  dx, dy, dz,
+     &  epsilon,
+     &  num_vox_outside_nb,
+     &  index_x,
+     &  index_y, 
+     &  index_z, 
+     &  nlo_index, nhi_index,
+     &  narrow_band,
+     &  ilo_nb_gb, ihi_nb_gb, 
+     &  jlo_nb_gb, jhi_nb_gb, 
+     &  klo_nb_gb, khi_nb_gb,
+     &  mark_fb)
+c***********************************************************************
+c { begin subroutine
+      implicit none
+
+      real volume
+
+c     _gb refers to ghostbox 
+      integer ilo_phi_gb, ihi_phi_gb
+      integer jlo_phi_gb, jhi_phi_gb
+      integer klo_phi_gb, khi_phi_gb
+      real phi(ilo_phi_gb:ihi_phi_gb,
+     &         jlo_phi_gb:jhi_phi_gb,
+     &         klo_phi_gb:khi_phi_gb)
+      real dx,dy,dz
+      real epsilon
+      integer num_vox_outside_nb
+      integer nlo_index, nhi_index
+      integer index_x(nlo_index:nhi_index)
+      integer index_y(nlo_index:nhi_index)
+      integer index_z(nlo_index:nhi_index)
+      integer ilo_nb_gb, ihi_nb_gb
+      integer jlo_nb_gb, jhi_nb_gb
+      integer klo_nb_gb, khi_nb_gb
+      integer*1 narrow_band(ilo_nb_gb:ihi_nb_gb,
+     &                      jlo_nb_gb:jhi_nb_gb,
+     &                      klo_nb_gb:khi_nb_gb)
+      integer*1 mark_fb
+
+c     local variables      
+      integer i,j,k,l
+      real phi_cur
+      real phi_cur_over_epsilon
+      real H
+      real dV
+      real pi
+      parameter (pi=3.14159265358979323846d0)
+      real one_over_pi
+      parameter (one_over_pi=0.31830988618379d0)
+
+
+c     compute dV = dx * dy * dz
+      dV = dx * dy * dz
+
+c     initialize volume with contribution from voxels outside of the
+c     narrow band
+      volume = num_vox_outside_nb*dV
+
+c     { begin loop over indexed points
+      do l=nlo_index, nhi_index              
+        i=index_x(l)
+        j=index_y(l)
+        k=index_z(l)
+
+c       include only fill box points (marked appropriately)
+        if( narrow_band(i,j,k) .le. mark_fb ) then
+
+          phi_cur = phi(i,j,k)
+          phi_cur_over_epsilon = phi_cur/epsilon
+
+          if (phi_cur .gt. epsilon) then
+            volume = volume + dV
+          elseif (phi_cur .gt. -epsilon) then
+            H = 0.5d0*(1 + phi_cur_over_epsilon
+     &                   + one_over_pi*sin(pi*phi_cur_over_epsilon))
+            volume = volume + H*dV
+          endif
+
+        endif
+      enddo
+c     } end loop over indexed points
+
+      return
+      end
+c } end subroutine
+c***********************************************************************
+
+
+c***********************************************************************
+c
+c  lsm3dSurfaceAreaZeroLevelSetLocal() computes the surface area of the 
+c  surface defined by the zero level set.  Only the narrow band voxels 
+c  are visited.
+c
+c  Arguments:
+c    area (out):           area of the surface defined by the zero level
+c                          set
+c    phi (in):             level set function
+c    phi_* (in):           components of grad(phi)
+c    dx, dy, dz (in):      grid spacing
+c    epsilon (in):         width of numerical smoothing to use for 
+c                          delta function
+c    *_gb (in):            index range for ghostbox
+c    index_*(in):          coordinates of local (narrow band) points
+c    n*_index(in):         index range of points to loop over in index_*
+c    narrow_band(in):      array that marks voxels outside desired fillbox
+c    mark_fb(in):          upper limit narrow band value for voxels in 
+c                          fillbox
+c
+c***********************************************************************
+      subroutine lsm3dSurfaceAreaZeroLevelSetLocal(
+     &  area,
+     &  phi,
+     &  ilo_phi_gb, ihi_phi_gb,
+     &  jlo_phi_gb, jhi_phi_gb,
+     &  klo_phi_gb, khi_phi_gb,
+     &  phi_x, phi_y, phi_z,
+     &  ilo_grad_phi_gb, ihi_grad_phi_gb,
+     &  jlo_grad_phi_gb, jhi_grad_phi_gb,
+     &  klo_grad_phi_gb, khi_grad_phi_gb,
+     &  dx, dy, dz,
+     &  epsilon,
+     &  index_x,
+     &  index_y, 
+     &  index_z, 
+     &  nlo_index, nhi_index,
+     &  narrow_band,
+     &  ilo_nb_gb, ihi_nb_gb, 
+     &  jlo_nb_gb, jhi_nb_gb, 
+     &  klo_nb_gb, khi_nb_gb,
+     &  mark_fb)
+c***********************************************************************
+c { begin subroutine
+      implicit none
+
+      real area
+
+c     _gb refers to ghostbox 
+      integer ilo_phi_gb, ihi_phi_gb
+      integer jlo_phi_gb, jhi_phi_gb
+      integer klo_phi_gb, khi_phi_gb
+      integer ilo_grad_phi_gb, ihi_grad_phi_gb
+      integer jlo_grad_phi_gb, jhi_grad_phi_gb
+      integer klo_grad_phi_gb, khi_grad_phi_gb
+      real phi(ilo_phi_gb:ihi_phi_gb,
+     &         jlo_phi_gb:jhi_phi_gb,
+     &         klo_phi_gb:khi_phi_gb)
+      real phi_x(ilo_grad_phi_gb:ihi_grad_phi_gb,
+     &           jlo_grad_phi_gb:jhi_grad_phi_gb,
+     &           klo_grad_phi_gb:khi_grad_phi_gb)
+      real phi_y(ilo_grad_phi_gb:ihi_grad_phi_gb,
+     &           jlo_grad_phi_gb:jhi_grad_phi_gb,
+     &           klo_grad_phi_gb:khi_grad_phi_gb)
+      real phi_z(ilo_grad_phi_gb:ihi_grad_phi_gb,
+     &           jlo_grad_phi_gb:jhi_grad_phi_gb,
+     &           klo_grad_phi_gb:khi_grad_phi_gb)
+      real dx,dy,dz
+      real epsilon
+      integer nlo_index, nhi_index
+      integer index_x(nlo_index:nhi_index)
+      integer index_y(nlo_index:nhi_index)
+      integer index_z(nlo_index:nhi_index)
+      integer ilo_nb_gb, ihi_nb_gb
+      integer jlo_nb_gb, jhi_nb_gb
+      integer klo_nb_gb, khi_nb_gb
+      integer*1 narrow_band(ilo_nb_gb:ihi_nb_gb,
+     &                      jlo_nb_gb:jhi_nb_gb,
+     &                      klo_nb_gb:khi_nb_gb)
+      integer*1 mark_fb
+
+c     local variables      
+      integer i,j,k,l
+      real one_over_epsilon
+      real phi_cur
+      real delta
+      real norm_grad_phi
+      real dV
+      real pi
+      parameter (pi=3.14159265358979323846d0)
+
+
+c     compute dV = dx * dy * dz
+      dV = dx * dy * dz
+
+c     compute one_over_epsilon
+      one_over_epsilon = 1.d0/epsilon
+
+c     initialize area to zero
+      area = 0.0d0
+
+c     { begin loop over indexed points
+      do l=nlo_index, nhi_index              
+        i=index_x(l)
+        j=index_y(l)
+        k=index_z(l)
+
+c       include only fill box points (marked appropriately)
+        if( narrow_band(i,j,k) .le. mark_fb ) then
+
+          phi_cur = phi(i,j,k)
+
+          if (abs(phi_cur) .lt. epsilon) then
+            delta = 0.5d0*one_over_epsilon
+     &                   *( 1+cos(pi*phi_cur*one_over_epsilon) ) 
+
+            norm_grad_phi = sqrt(
+     &          phi_x(i,j,k)*phi_x(i,j,k)
+     &        + phi_y(i,j,k)*phi_y(i,j,k)
+     &        + phi_z(i,j,k)*phi_z(i,j,k) )
+
+            area = area + delta*norm_grad_phi*dV
+          endif
+
+        endif
+      enddo
+c     } end loop over indexed points
+
+      return
+      end
+c } end subroutine
+c***********************************************************************
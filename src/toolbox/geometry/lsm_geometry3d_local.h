@@ -0,0 +1,236 @@
+/*
+ * File:        lsm_geometry3d_local.h
+ * Copyrights:  (c) 2005 The Trustees of Princeton University and Board of
+ *                  Regents of the University of Texas.  All rights reserved.
+ *              (c) 2009 Kevin T. Chu.  All rights reserved.
+ * Revision:    $Revision$
+ * Modified:    $Date$
+ * Description: Header file for 3D Fortran 77 level set method narrow-band
+ *              geometry subroutines
+ */
+
+#ifndef INCLUDED_LSM_GEOMETRY_3D_LOCAL_H
+#define INCLUDED_LSM_GEOMETRY_3D_LOCAL_H
+
+#include "LSMLIB_config.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*! \file lsm_geometry3d_local.h
+ *
+ * \brief
+ * @ref lsm_geometry3d_local.h provides support for computing various
+ * geometric quantities in three space dimensions using only the voxels
+ * of the narrow band.
+ *
+ */
+
+
+/* Link between C/C++ and Fortran function names
+ *
+ *      name in                        name in
+ *      C/C++ code                     Fortran code
+ *      ----------                     ------------
+ */
+#define LSM3D_VOLUME_REGION_PHI_LESS_THAN_ZERO_LOCAL                       \
+                                lsm3dvolumeregionphilessthanzerolocal_
+#define LSM3D_VOLUME_REGION_PHI_GREATER_THAN_ZERO_LOCAL                    \
+                                lsm3dvolumeregionphigreaterthanzerolocal_
+#define LSM3D_SURFACE_AREA_ZERO_LEVEL_SET_LOCAL                            \
+                                lsm3dsurfaceareazerolevelsetlocal_
+
+
+/*!
+ * LSM3D_VOLUME_REGION_PHI_LESS_THAN_ZERO_LOCAL() computes the volume of
+ * the region where the level set function is less than 0.  Only the
+ * narrow band voxels are visited; the voxels outside of the narrow band
+ * are accounted for by the number of such voxels where phi < 0.
+ *
+ * Arguments:
+ *  - volume (out):          volume of the region where \f$ \phi < 0 \f$
+ *  - phi (in):              level set function
+ *  - dx, dy, dz (in):       grid spacing
+ *  - epsilon (in):          width of numerical smoothing to use for
+ *                           Heaviside function
+ *  - num_vox_outside_nb (in): number of voxels in fillbox that are
+ *                           not in the narrow band and have phi < 0
+ *  - *_gb (in):             index range for ghostbox
+ *  - index_*(in):           coordinates of local (narrow band) points
+ *  - n*_index(in):          index range of points to loop over in index_*
+ *  - narrow_band(in):       array that marks voxels outside desired fillbox
+ *  - mark_fb(in):           upper limit narrow band value for voxels in
+ *                           fillbox
+ *
+ * Return value:             none
+ *
+ * NOTES:
+ *  - The result is the same as LSM3D_VOLUME_REGION_PHI_LESS_THAN_ZERO()
+ *    (up to round-off) as long as \f$ |\phi| \ge \epsilon \f$ outside
+ *    of the narrow band.
+ *
+ *  - num_vox_outside_nb can be maintained as the narrow band moves
+ *    using LSM3D_VOXEL_COUNT_LESS_THAN_ZERO_LOCAL() (see
+ *    @ref lsm_utilities3d_local.h).
+ *
+ */
+void LSM3D_VOLUME_REGION_PHI_LESS_THAN_ZERO_LOCAL(
+  LSMLIB_REAL *volume,
+  const LSMLIB_REAL *phi,
+  const int *ilo_phi_gb,
+  const int *ihi_phi_gb,
+  const int *jlo_phi_gb,
+  const int *jhi_phi_gb,
+  const int *klo_phi_gb,
+  const int *khi_phi_gb,
+  const LSMLIB_REAL *dx,
+  const LSMLIB_REAL *dy,
+  const LSMLIB_REAL *dz,
+  const LSMLIB_REAL *epsilon,
+  const int *num_vox_outside_nb,
+  const int *index_x,
+  const int *index_y,
+  const int *index_z,
+  const int *nlo_index,
+  const int *nhi_index,
+  const unsigned char *narrow_band,
+  const int *ilo_nb_gb,
+  const int *ihi_nb_gb,
+  const int *jlo_nb_gb,
+  const int *jhi_nb_gb,
+  const int *klo_nb_gb,
+  const int *khi_nb_gb,
+  const unsigned char *mark_fb);
+
+
+/*!
+ * LSM3D_VOLUME_REGION_PHI_GREATER_THAN_ZERO_LOCAL() computes the volume
+ * of the region where the level set function is greater than 0.  Only
+ * the narrow band voxels are visited; the voxels outside of the narrow
+ * band are accounted for by the number of such voxels where phi > 0.
+ *
+ * Arguments:
+ *  - volume (out):          volume of the region where \f$ \phi > 0 \f$
+ *  - phi (in):              level set function
+ *  - dx, dy, dz (in):       grid spacing
+ *  - epsilon (in):          width of numerical smoothing to use for
+ *                           Heaviside function
+ *  - num_vox_outside_nb (in): number of voxels in fillbox that are
+ *                           not in the narrow band and have phi > 0
+ *  - *_gb (in):             index range for ghostbox
+ *  - index_*(in):           coordinates of local (narrow band) points
+ *  - n*_index(in):          index range of points to loop over in index_*
+ *  - narrow_band(in):       array that marks voxels outside desired fillbox
+ *  - mark_fb(in):           upper limit narrow band value for voxels in
+ *                           fillbox
+ *
+ * Return value:             none
+ *
+ * NOTES:
+ *  - The result is the same as LSM3D_VOLUME_REGION_PHI_GREATER_THAN_ZERO()
+ *    (up to round-off) as long as \f$ |\phi| \ge \epsilon \f$ outside
+ *    of the narrow band.
+ *
+ */
+void LSM3D_VOLUME_REGION_PHI_GREATER_THAN_ZERO_LOCAL(
+  LSMLIB_REAL *volume,
+  const LSMLIB_REAL *phi,
+  const int *ilo_phi_gb,
+  const int *ihi_phi_gb,
+  const int *jlo_phi_gb,
+  const int *jhi_phi_gb,
+  const int *klo_phi_gb,
+  const int *khi_phi_gb,
+  const LSMLIB_REAL *dx,
+  const LSMLIB_REAL *dy,
+  const LSMLIB_REAL *dz,
+  const LSMLIB_REAL *epsilon,
+  const int *num_vox_outside_nb,
+  const int *index_x,
+  const int *index_y,
+  const int *index_z,
+  const int *nlo_index,
+  const int *nhi_index,
+  const unsigned char *narrow_band,
+  const int *ilo_nb_gb,
+  const int *ihi_nb_gb,
+  const int *jlo_nb_gb,
+  const int *jhi_nb_gb,
+  const int *klo_nb_gb,
+  const int *khi_nb_gb,
+  const unsigned char *mark_fb);
+
+
+/*!
+ * LSM3D_SURFACE_AREA_ZERO_LEVEL_SET_LOCAL() computes the surface area of
+ * the surface defined by the zero level set.  Only the narrow band voxels
+ * are visited.
+ *
+ * Arguments:
+ *  - area (out):            area of the surface defined by the zero level
+ *                           set
+ *  - phi (in):              level set function
+ *  - phi_* (in):            components of \f$ \nabla \phi \f$
+ *  - dx, dy, dz (in):       grid spacing
+ *  - epsilon (in):          width of numerical smoothing to use for
+ *                           delta function
+ *  - *_gb (in):             index range for ghostbox
+ *  - index_*(in):           coordinates of local (narrow band) points
+ *  - n*_index(in):          index range of points to loop over in index_*
+ *  - narrow_band(in):       array that marks voxels outside desired fillbox
+ *  - mark_fb(in):           upper limit narrow band value for voxels in
+ *                           fillbox
+ *
+ * Return value:             none
+ *
+ * NOTES:
+ *  - The result is the same as LSM3D_SURFACE_AREA_ZERO_LEVEL_SET()
+ *    (up to round-off) as long as \f$ |\phi| \ge \epsilon \f$ outside
+ *    of the narrow band.
+ *
+ *  - \f$ \nabla \phi \f$ is only required at the narrow band voxels
+ *    where \f$ |\phi| < \epsilon \f$.
+ *
+ */
+void LSM3D_SURFACE_AREA_ZERO_LEVEL_SET_LOCAL(
+  LSMLIB_REAL *area,
+  const LSMLIB_REAL *phi,
+  const int *ilo_phi_gb,
+  const int *ihi_phi_gb,
+  const int *jlo_phi_gb,
+  const int *jhi_phi_gb,
+  const int *klo_phi_gb,
+  const int *khi_phi_gb,
+  const LSMLIB_REAL *phi_x,
+  const LSMLIB_REAL *phi_y,
+  const LSMLIB_REAL *phi_z,
+  const int *ilo_grad_phi_gb,
+  const int *ihi_grad_phi_gb,
+  const int *jlo_grad_phi_gb,
+  const int *jhi_grad_phi_gb,
+  const int *klo_grad_phi_gb,
+  const int *khi_grad_phi_gb,
+  const LSMLIB_REAL *dx,
+  const LSMLIB_REAL *dy,
+  const LSMLIB_REAL *dz,
+  const LSMLIB_REAL *epsilon,
+  const int *index_x,
+  const int *index_y,
+  const int *index_z,
+  const int *nlo_index,
+  const int *nhi_index,
+  const unsigned char *narrow_band,
+  const int *ilo_nb_gb,
+  const int *ihi_nb_gb,
+  const int *jlo_nb_gb,
+  const int *jhi_nb_gb,
+  const int *klo_nb_gb,
+  const int *khi_nb_gb,
+  const unsigned char *mark_fb);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
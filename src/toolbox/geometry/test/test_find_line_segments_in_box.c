@@ -0,0 +1,134 @@
+/*
+ * File:        test_find_line_segments_in_box.c
+ * Copyrights:  (c) 2005 The Trustees of Princeton University and Board of
+ *                  Regents of the University of Texas.  All rights reserved.
+ *              (c) 2009 Kevin T. Chu.  All rights reserved.
+ * Revision:    $Revision$
+ * Modified:    $Date$
+ *
+ */
+
+/*
+ * This program tests that the LSM3D_findLineSegmentsInBox() function
+ * computes the curve where a plane crosses a cylinder.
+ *
+ * phi is the plane z = z0, and psi is the signed distance function for
+ * the cylinder of radius r whose axis is the z-axis, so the
+ * {phi=0,psi=0} curve is a circle of radius r.  Both functions are
+ * sampled on the domain [-1,1]^3 with dx = 0.05.
+ *
+ * The following properties of the line segments are checked:
+ *  - the end of every segment is the start of exactly one segment
+ *    (i.e. the segments join into closed, consistently oriented
+ *    polylines);
+ *  - following the segments from the first segment visits all of the
+ *    segments (i.e. there is exactly one polyline); and
+ *  - the length of the polyline is close to 2*pi*r.
+ *
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <math.h>
+#include "LSMLIB_config.h"
+#include "lsm_geometry3d.h"
+
+#define PI  (3.14159265358979323846)
+#define N   (41)
+
+int main(void)
+{
+  LSMLIB_REAL *phi, *psi, *segments;
+  LSMLIB_REAL x_lo[3] = {-1.0, -1.0, -1.0};
+  LSMLIB_REAL dx = 0.05;
+  LSMLIB_REAL z0 = 0.0123;
+  LSMLIB_REAL radius = 0.5137;
+  LSMLIB_REAL exact_length = 2.0*PI*radius;
+  LSMLIB_REAL length, dist;
+  int ilo_gb = 0, ihi_gb = N-1;
+  int ilo_ib = 0, ihi_ib = N-2;
+  int *next;
+  int num_segments, num_unmatched = 0, num_visited = 0;
+  int i, j, k, idx, s, t, n;
+
+  phi = (LSMLIB_REAL*) malloc(N*N*N*sizeof(LSMLIB_REAL));
+  psi = (LSMLIB_REAL*) malloc(N*N*N*sizeof(LSMLIB_REAL));
+  for (k = 0; k < N; k++) {
+    for (j = 0; j < N; j++) {
+      for (i = 0; i < N; i++) {
+        LSMLIB_REAL x = x_lo[0] + i*dx;
+        LSMLIB_REAL y = x_lo[1] + j*dx;
+        LSMLIB_REAL z = x_lo[2] + k*dx;
+        idx = i + N*(j + N*k);
+        phi[idx] = z - z0;
+        psi[idx] = sqrt(x*x + y*y) - radius;
+      }
+    }
+  }
+
+  /* count the segments, then compute them */
+  num_segments = LSM3D_findLineSegmentsInBox(
+    NULL, 0, &length, phi, psi,
+    &ilo_gb, &ihi_gb, &ilo_gb, &ihi_gb, &ilo_gb, &ihi_gb,
+    NULL, &ilo_gb, &ihi_gb, &ilo_gb, &ihi_gb, &ilo_gb, &ihi_gb,
+    &ilo_ib, &ihi_ib, &ilo_ib, &ihi_ib, &ilo_ib, &ihi_ib,
+    x_lo, &dx, &dx, &dx);
+  if (num_segments <= 0) {
+    printf("FAILED: no line segments found (%d)\n", num_segments);
+    return 1;
+  }
+  segments = (LSMLIB_REAL*) malloc(6*num_segments*sizeof(LSMLIB_REAL));
+  LSM3D_findLineSegmentsInBox(
+    segments, num_segments, &length, phi, psi,
+    &ilo_gb, &ihi_gb, &ilo_gb, &ihi_gb, &ilo_gb, &ihi_gb,
+    NULL, &ilo_gb, &ihi_gb, &ilo_gb, &ihi_gb, &ilo_gb, &ihi_gb,
+    &ilo_ib, &ihi_ib, &ilo_ib, &ihi_ib, &ilo_ib, &ihi_ib,
+    x_lo, &dx, &dx, &dx);
+
+  /* join the end of each segment to the start of the next segment */
+  next = (int*) malloc(num_segments*sizeof(int));
+  for (s = 0; s < num_segments; s++) {
+    int num_matches = 0;
+    next[s] = -1;
+    for (t = 0; t < num_segments; t++) {
+      dist = 0.0;
+      for (n = 0; n < 3; n++) {
+        LSMLIB_REAL d = segments[6*s+3+n] - segments[6*t+n];
+        dist += d*d;
+      }
+      if (sqrt(dist) < 1.e-10) {
+        next[s] = t;
+        num_matches++;
+      }
+    }
+    if (num_matches != 1) num_unmatched++;
+  }
+
+  /* follow the polyline that starts with the first segment */
+  if (num_unmatched == 0) {
+    s = 0;
+    do {
+      s = next[s];
+      num_visited++;
+    } while ( (s != 0) && (num_visited <= num_segments) );
+  }
+
+  printf("line segments:                      %d\n", num_segments);
+  printf("segments without unique successor:  %d\n", num_unmatched);
+  printf("segments in first polyline:         %d\n", num_visited);
+  printf("length (exact):                     %g (%g)\n",
+         length, exact_length);
+
+  free(next);
+  free(segments);
+  free(psi);
+  free(phi);
+
+  if ( (num_unmatched > 0) || (num_visited != num_segments)
+    || (fabs(length - exact_length) > 0.01*exact_length) ) {
+    printf("FAILED\n");
+    return 1;
+  }
+  printf("PASSED\n");
+  return 0;
+}
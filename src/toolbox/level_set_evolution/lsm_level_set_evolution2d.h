@@ -44,6 +44,8 @@ extern "C" {
                                      lsm2daddconstprecomputedcurvtermtolserhs_	
 #define LSM2D_ADD_EXTERNAL_AND_NORMAL_VEL_TERM_TO_LSE_RHS \
                                     lsm2daddexternalandnormalveltermtolserhs_				
+#define LSM2D_COMPUTE_ADVECTION_AND_NORMAL_VEL_LSE_RHS \
+                                  lsm2dcomputeadvectionandnormalvellserhs_
 
 /*!
  * LSM2D_ZERO_OUT_LEVEL_SET_EQN_RHS() zeros out the right-hand side of 
@@ -367,6 +369,87 @@ void LSM2D_ADD_EXTERNAL_AND_NORMAL_VEL_TERM_TO_LSE_RHS(
   const int *ihi_rhs_fb,
   const int *jlo_rhs_fb, 
   const int *jhi_rhs_fb);
+
+/*!
+ * LSM2D_COMPUTE_ADVECTION_AND_NORMAL_VEL_LSE_RHS() computes the 
+ * right-hand side of the level set equation when it is written in 
+ * the form:
+ *   
+ * \f[
+ *   
+ *    \phi_t = -\vec{V} \cdot \nabla \phi - V_n |\nabla \phi|
+ *   
+ * \f]
+ *   
+ * in a single pass over the fillbox.  The upwind approximation to 
+ * \f$ \nabla \phi \f$ used in the advection term is selected from 
+ * phi_*_plus and phi_*_minus, so upwind derivatives do not need to be 
+ * computed separately.
+ *   
+ * Arguments:
+ *  - lse_rhs (out):          right-hand of level set equation
+ *  - phi_*_plus (in):        components of forward approx to 
+ *                            \f$ \nabla \phi \f$ at t = t_cur
+ *  - phi_*_minus (in):       components of backward approx to 
+ *                            \f$ \nabla \phi \f$ at t = t_cur
+ *  - vel_* (in):             components of external velocity at 
+ *                            t = t_cur
+ *  - vel_n (in):             normal velocity at t = t_cur
+ *  - *_gb (in):              index range for ghostbox
+ *  - *_fb (in):              index range for fillbox
+ *  - use_external_vel (in):  1 to include the advection term; 0 to 
+ *                            omit it
+ *  - use_normal_vel (in):    1 to include the normal velocity term; 
+ *                            0 to omit it
+ *
+ * Return value:              none
+ *
+ * NOTES:
+ *  - lse_rhs is set (not added to) in the fillbox, so it does not
+ *    need to be zeroed out beforehand.
+ *  - The result is the same as zeroing out lse_rhs and then calling
+ *    LSM2D_ADD_ADVECTION_TERM_TO_LSE_RHS() (with upwind derivatives) 
+ *    and LSM2D_ADD_NORMAL_VEL_TERM_TO_LSE_RHS().
+ *  - vel_* and vel_n are not accessed when the corresponding term is
+ *    omitted, so any valid pointer may be passed for them.
+ *
+ */
+void LSM2D_COMPUTE_ADVECTION_AND_NORMAL_VEL_LSE_RHS(
+  LSMLIB_REAL *lse_rhs,
+  const int *ilo_lse_rhs_gb, 
+  const int *ihi_lse_rhs_gb,
+  const int *jlo_lse_rhs_gb, 
+  const int *jhi_lse_rhs_gb,
+  const LSMLIB_REAL *phi_x_plus,
+  const LSMLIB_REAL *phi_y_plus,
+  const int *ilo_grad_phi_plus_gb, 
+  const int *ihi_grad_phi_plus_gb,
+  const int *jlo_grad_phi_plus_gb, 
+  const int *jhi_grad_phi_plus_gb,
+  const LSMLIB_REAL *phi_x_minus,
+  const LSMLIB_REAL *phi_y_minus,
+  const int *ilo_grad_phi_minus_gb, 
+  const int *ihi_grad_phi_minus_gb,
+  const int *jlo_grad_phi_minus_gb, 
+  const int *jhi_grad_phi_minus_gb,
+  const LSMLIB_REAL *vel_x,
+  const LSMLIB_REAL *vel_y,
+  const int *ilo_vel_gb, 
+  const int *ihi_vel_gb,
+  const int *jlo_vel_gb, 
+  const int *jhi_vel_gb,
+  const LSMLIB_REAL *vel_n,
+  const int *ilo_vel_n_gb, 
+  const int *ihi_vel_n_gb,
+  const int *jlo_vel_n_gb, 
+  const int *jhi_vel_n_gb,
+  const int *ilo_fb, 
+  const int *ihi_fb,
+  const int *jlo_fb, 
+  const int *jhi_fb,
+  const int *use_external_vel,
+  const int *use_normal_vel);
+
 #ifdef __cplusplus
 }
 #endif
@@ -47,6 +47,12 @@ extern "C" {
                                        lsm3daddconstprecomputedcurvtermtolserhslocal_					
 #define LSM3D_ADD_EXTERNAL_AND_NORMAL_VEL_TERM_TO_LSE_RHS_LOCAL	\
                                   lsm3daddexternalandnormalveltermtolserhslocal_						
+#define LSM3D_ZERO_OUT_LEVEL_SET_EQN_RHS_LOCAL_LINEAR         \
+                                        lsm3dzerooutlevelseteqnrhslocallinear_
+#define LSM3D_ADD_CONST_NORMAL_VEL_TERM_TO_LSE_RHS_LOCAL_LINEAR   \
+                                  lsm3daddconstnormalveltermtolserhslocallinear_
+#define LSM3D_ADD_CONST_CURV_TERM_TO_LSE_RHS_LOCAL_LINEAR         \
+                                        lsm3daddconstcurvtermtolserhslocallinear_
 
 
 /*!
@@ -495,6 +501,103 @@ void LSM3D_ADD_EXTERNAL_AND_NORMAL_VEL_TERM_TO_LSE_RHS_LOCAL(
   const int *klo_nb_gb,
   const int *khi_nb_gb,
   const unsigned char *mark_fb);
+
+/*!
+*
+*  LSM3D_ZERO_OUT_LEVEL_SET_EQN_RHS_LOCAL_LINEAR() is identical to 
+*  LSM3D_ZERO_OUT_LEVEL_SET_EQN_RHS_LOCAL() except that the narrow band 
+*  points are specified by their linear offsets into lse_rhs (see 
+*  LSM3D_COMPUTE_NARROW_BAND_LINEAR_INDEX()).
+*
+*  Arguments:
+*    lse_rhs (in/out):  right-hand of level set equation
+*    index_lin(in):     linear offsets of local (narrow band) points
+*    n*_index(in):      index range of points in index_lin
+*
+*/
+void LSM3D_ZERO_OUT_LEVEL_SET_EQN_RHS_LOCAL_LINEAR(
+  LSMLIB_REAL *lse_rhs,
+  const int *index_lin,
+  const int *nlo_index,
+  const int *nhi_index);
+
+/*!
+*
+*  LSM3D_ADD_CONST_NORMAL_VEL_TERM_TO_LSE_RHS_LOCAL_LINEAR() is identical
+*  to LSM3D_ADD_CONST_NORMAL_VEL_TERM_TO_LSE_RHS_LOCAL() except that the 
+*  narrow band points are specified by their linear offsets into the 
+*  data arrays.
+*
+*  Arguments:
+*    lse_rhs (in/out):  right-hand of level set equation
+*    phi_*_plus (in):   components of forward approx to grad(phi) at 
+*                       t = t_cur
+*    phi_*_minus (in):  components of backward approx to grad(phi) at 
+*                       t = t_cur
+*    vel_n (in):        scalar normal velocity at t = t_cur
+*    index_lin(in):     linear offsets of local (narrow band) points
+*    n*_index(in):      index range of points in index_lin
+*    narrow_band(in):   array that marks voxels outside desired fillbox
+*    mark_fb(in):       upper limit narrow band value for voxels in 
+*                       fillbox
+*
+*  NOTES:
+*   - all arrays (including narrow_band) must have the same ghostbox
+*
+*/
+void LSM3D_ADD_CONST_NORMAL_VEL_TERM_TO_LSE_RHS_LOCAL_LINEAR(
+  LSMLIB_REAL *lse_rhs,
+  const LSMLIB_REAL *phi_x_plus, 
+  const LSMLIB_REAL *phi_y_plus, 
+  const LSMLIB_REAL *phi_z_plus,
+  const LSMLIB_REAL *phi_x_minus, 
+  const LSMLIB_REAL *phi_y_minus, 
+  const LSMLIB_REAL *phi_z_minus,
+  const LSMLIB_REAL *vel_n, 
+  const int *index_lin,
+  const int *nlo_index,
+  const int *nhi_index, 
+  const unsigned char *narrow_band,
+  const unsigned char *mark_fb);
+
+/*!
+*
+*  LSM3D_ADD_CONST_CURV_TERM_TO_LSE_RHS_LOCAL_LINEAR() is identical to
+*  LSM3D_ADD_CONST_CURV_TERM_TO_LSE_RHS_LOCAL() except that the narrow 
+*  band points are specified by their linear offsets into the data 
+*  arrays.
+*
+*  Arguments:
+*    lse_rhs (in/out):  right-hand of level set equation
+*    phi_*      (in):   derivatives (the 1st and 2nd order)   
+*    b     (in):        scalar curvature term component 
+*    index_lin(in):     linear offsets of local (narrow band) points
+*    n*_index(in):      index range of points in index_lin
+*    narrow_band(in):   array that marks voxels outside desired fillbox
+*    mark_fb(in):       upper limit narrow band value for voxels in 
+*                       fillbox
+*
+*  NOTES:
+*   - all arrays (including narrow_band) must have the same ghostbox
+*
+*/
+void LSM3D_ADD_CONST_CURV_TERM_TO_LSE_RHS_LOCAL_LINEAR(
+  LSMLIB_REAL *lse_rhs,
+  const LSMLIB_REAL *phi_x,
+  const LSMLIB_REAL *phi_y,
+  const LSMLIB_REAL *phi_z,
+  const LSMLIB_REAL *phi_xx,
+  const LSMLIB_REAL *phi_xy,
+  const LSMLIB_REAL *phi_xz,
+  const LSMLIB_REAL *phi_yy,
+  const LSMLIB_REAL *phi_yz,
+  const LSMLIB_REAL *phi_zz,
+  const LSMLIB_REAL *b,
+  const int *index_lin,
+  const int *nlo_index,
+  const int *nhi_index,
+  const unsigned char *narrow_band,
+  const unsigned char *mark_fb);
   
 #ifdef __cplusplus
 }
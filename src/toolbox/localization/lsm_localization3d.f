@@ -33,6 +33,11 @@ c                      band voxels
 c    n_hi(in/out):     array, n_hi[L] is ending index of the level L narrow
 c                      band voxels
 c    level(in):        number of narrow band levels to mark
+c    max_mark(in):     voxels with narrow_band values greater than max_mark
+c                      (e.g. boundary layer marks) are treated as voxels
+c                      that are not in the narrow band; use 127 if only
+c                      voxels with narrow_band value 0 should be treated
+c                      as not in the narrow band
 c    *_gb (in):        index range for ghostbox
 c
 c Notes:
@@ -43,6 +48,9 @@ c     in that range saved in arrays index_x,index_y,index_z
 c    - voxels that are outside fillbox ARE still INCLUDED in the narrow 
 c     band; use lsm3dMarkNarrowBandBoundaryLayer() to distinguish the voxels
 c    near volume boundary
+c    - if the level 0 voxels are stored in grid order, the voxels of each
+c     level L >= 1 are also stored in grid order (the neighbors of the 
+c     level L-1 voxels are generated in grid order, so no sort is needed)
 c
 c***********************************************************************
       subroutine lsm3dMarkNarrowBandNeighbors(
@@ -55,7 +63,8 @@ c***********************************************************************
      &  index_z,
      &  nlo_index, nhi_index,
      &  n_lo, n_hi,
-     &  level)
+     &  level,
+     &  max_mark)
 c***********************************************************************
 c { begin subroutine
       implicit none
@@ -71,6 +80,7 @@ c { begin subroutine
       integer index_z(nlo_index:nhi_index)
       integer level
       integer n_lo(0:level), n_hi(0:level)
+      integer max_mark
       
       integer i, j, k, l, m, count
       integer*1 mark
@@ -90,63 +100,75 @@ c       { begin examine points from one level less
 	  k=index_z(m)
 
 c         check upper x-coordinate neighbor 
-	  if( (i .lt. ihi_nb_gb) .and. 
-     &        (narrow_band(i+1,j,k) .eq. 0) ) then
-	    index_x(count) = i+1
-	    index_y(count) = j
-	    index_z(count) = k
-	    narrow_band(i+1,j,k) = mark
-	    count = count+1
+	  if( i .lt. ihi_nb_gb ) then
+	    if( (narrow_band(i+1,j,k) .eq. 0) .or.
+     &          (narrow_band(i+1,j,k) .gt. max_mark) ) then
+	      index_x(count) = i+1
+	      index_y(count) = j
+	      index_z(count) = k
+	      narrow_band(i+1,j,k) = mark
+	      count = count+1
+	    endif
 	  endif
 
 c         check lower x-coordinate neighbor  
-	  if( (i .gt. ilo_nb_gb) .and. 
-     &        (narrow_band(i-1,j,k) .eq. 0) ) then
-	    index_x(count) = i-1
-	    index_y(count) = j
-	    index_z(count) = k
-	    narrow_band(i-1,j,k) = mark
-	    count = count+1
+	  if( i .gt. ilo_nb_gb ) then
+	    if( (narrow_band(i-1,j,k) .eq. 0) .or.
+     &          (narrow_band(i-1,j,k) .gt. max_mark) ) then
+	      index_x(count) = i-1
+	      index_y(count) = j
+	      index_z(count) = k
+	      narrow_band(i-1,j,k) = mark
+	      count = count+1
+	    endif
 	  endif
 
 c         check upper y-coordinate neighbor
-	  if( (j .lt. jhi_nb_gb) .and. 
-     &       (narrow_band(i,j+1,k) .eq. 0) ) then
-	    index_x(count) = i
-	    index_y(count) = j+1
-	    index_z(count) = k
-	    narrow_band(i,j+1,k) = mark
-	    count = count+1
+	  if( j .lt. jhi_nb_gb ) then
+	    if( (narrow_band(i,j+1,k) .eq. 0) .or.
+     &          (narrow_band(i,j+1,k) .gt. max_mark) ) then
+	      index_x(count) = i
+	      index_y(count) = j+1
+	      index_z(count) = k
+	      narrow_band(i,j+1,k) = mark
+	      count = count+1
+	    endif
 	  endif
 
 c         check lower y-coordinate neighbor  
-	  if( (j .gt. jlo_nb_gb) .and.
-     &        (narrow_band(i,j-1,k) .eq. 0) ) then
-	    index_x(count) = i
-	    index_y(count) = j-1
-	    index_z(count) = k
-	    narrow_band(i,j-1,k) = mark
-	    count = count+1
+	  if( j .gt. jlo_nb_gb ) then
+	    if( (narrow_band(i,j-1,k) .eq. 0) .or.
+     &          (narrow_band(i,j-1,k) .gt. max_mark) ) then
+	      index_x(count) = i
+	      index_y(count) = j-1
+	      index_z(count) = k
+	      narrow_band(i,j-1,k) = mark
+	      count = count+1
+	    endif
 	  endif
 
 c         check upper z-coordinate neighbor  
-	  if( (k .lt. khi_nb_gb) .and. 
-     &        (narrow_band(i,j,k+1) .eq. 0) ) then
-	    index_x(count) = i
-	    index_y(count) = j
-	    index_z(count) = k+1
-	    narrow_band(i,j,k+1) = mark
-	    count = count+1
+	  if( k .lt. khi_nb_gb ) then
+	    if( (narrow_band(i,j,k+1) .eq. 0) .or.
+     &          (narrow_band(i,j,k+1) .gt. max_mark) ) then
+	      index_x(count) = i
+	      index_y(count) = j
+	      index_z(count) = k+1
+	      narrow_band(i,j,k+1) = mark
+	      count = count+1
+	    endif
 	  endif
 
 c         check lower z-coordinate neighbor  
-	  if( (k .gt. klo_nb_gb) .and.
-     &        (narrow_band(i,j,k-1) .eq. 0) ) then
-	    index_x(count) = i
-	    index_y(count) = j
-	    index_z(count) = k-1
-	    narrow_band(i,j,k-1) = mark
-	    count = count+1
+	  if( k .gt. klo_nb_gb ) then
+	    if( (narrow_band(i,j,k-1) .eq. 0) .or.
+     &          (narrow_band(i,j,k-1) .gt. max_mark) ) then
+	      index_x(count) = i
+	      index_y(count) = j
+	      index_z(count) = k-1
+	      narrow_band(i,j,k-1) = mark
+	      count = count+1
+	    endif
 	  endif
 	 
         enddo
@@ -155,6 +177,16 @@ c       } end examine points one level less
 	if( count .gt. ( n_hi(l-1) + 1 ) ) then 
 	  n_lo(l) = n_hi(l-1) + 1
 	  n_hi(l) = count - 1
+
+c         put level l voxels in grid order (voxels are found in the
+c         order of their level l-1 neighbors, which is not cache-friendly)
+          call lsm3dSortNarrowBandIndices(
+     &      index_x, index_y, index_z,
+     &      nlo_index, nhi_index,
+     &      n_lo(l), n_hi(l),
+     &      ilo_nb_gb, ihi_nb_gb,
+     &      jlo_nb_gb, jhi_nb_gb,
+     &      klo_nb_gb, khi_nb_gb)
 	else
 	  n_lo(l) = -1
 	  n_hi(l) = -1
@@ -170,6 +202,142 @@ c***********************************************************************
 
 
 
+c***********************************************************************
+c FUNCTION INTERNAL TO THIS FILE- DO NOT DELETE THIS DOCUMENTATION!
+c
+c lsm3dSortNarrowBandIndices() sorts the narrow band voxels stored in 
+c positions n_start through n_end of the index_[xyz] arrays so that they
+c are in the same order as the voxels in the grid (i.e. ordered by z- 
+c then y- then x-coordinate).  
+c
+c The voxels are sorted by their grid position (i.e. their offset from
+c the first grid point of the ghostbox) using a least significant digit
+c radix sort, so the cost is linear in the number of voxels.  The 
+c positions n_start through n_end of index_x and index_y hold the grid
+c positions during the sort, so no additional storage is required.
+c
+c Arguments:
+c    index_[xyz](in/out): array with [xyz] coordinates of narrow band voxels
+c    n*_index(in):        (allocated) index range of index_[xyz] arrays 
+c    n_start(in):         first position of voxels to sort
+c    n_end(in):           last position of voxels to sort
+c    *_gb (in):           index range for ghostbox
+c
+c***********************************************************************
+      subroutine lsm3dSortNarrowBandIndices(
+     &  index_x,
+     &  index_y, 
+     &  index_z,
+     &  nlo_index, nhi_index,
+     &  n_start, n_end,
+     &  ilo_nb_gb, ihi_nb_gb,
+     &  jlo_nb_gb, jhi_nb_gb,
+     &  klo_nb_gb, khi_nb_gb)
+c***********************************************************************
+c { begin subroutine
+      implicit none
+      
+      integer nlo_index, nhi_index
+      integer index_x(nlo_index:nhi_index)
+      integer index_y(nlo_index:nhi_index)
+      integer index_z(nlo_index:nhi_index)
+      integer n_start, n_end
+      integer ilo_nb_gb, ihi_nb_gb
+      integer jlo_nb_gb, jhi_nb_gb
+      integer klo_nb_gb, khi_nb_gb
+      
+c     local variables      
+      integer radix
+      parameter (radix = 2048)
+      integer bucket(0:radix-1)
+      integer m, b, c, total, pos, digit_size, max_pos
+      integer nx, nxy
+      logical pos_in_x
+
+      if (n_end .le. n_start) return
+
+      nx  = ihi_nb_gb - ilo_nb_gb + 1
+      nxy = nx*(jhi_nb_gb - jlo_nb_gb + 1)
+      max_pos = nxy*(khi_nb_gb - klo_nb_gb + 1) - 1
+
+c     replace the coordinates in index_x by the grid positions
+      do m=n_start,n_end
+        index_x(m) = (index_x(m) - ilo_nb_gb)
+     &             + (index_y(m) - jlo_nb_gb)*nx
+     &             + (index_z(m) - klo_nb_gb)*nxy
+      enddo
+
+c     { begin loop over digits (the grid positions alternate between
+c     index_x and index_y)
+      pos_in_x = .true.
+      digit_size = 1
+   10 continue
+
+        do b=0,radix-1
+          bucket(b) = 0
+        enddo
+
+        if (pos_in_x) then
+          do m=n_start,n_end
+            b = mod(index_x(m)/digit_size, radix)
+            bucket(b) = bucket(b)+1
+          enddo
+        else
+          do m=n_start,n_end
+            b = mod(index_y(m)/digit_size, radix)
+            bucket(b) = bucket(b)+1
+          enddo
+        endif
+
+c       bucket(b) is the position of the next voxel with digit b
+        total = n_start
+        do b=0,radix-1
+          c = bucket(b)
+          bucket(b) = total
+          total = total + c
+        enddo
+
+        if (pos_in_x) then
+          do m=n_start,n_end
+            b = mod(index_x(m)/digit_size, radix)
+            index_y(bucket(b)) = index_x(m)
+            bucket(b) = bucket(b)+1
+          enddo
+        else
+          do m=n_start,n_end
+            b = mod(index_y(m)/digit_size, radix)
+            index_x(bucket(b)) = index_y(m)
+            bucket(b) = bucket(b)+1
+          enddo
+        endif
+        pos_in_x = .not. pos_in_x
+
+      if (max_pos/digit_size .ge. radix) then
+        digit_size = digit_size*radix
+        goto 10
+      endif
+c     } end loop over digits
+
+c     recover the coordinates from the sorted grid positions
+      do m=n_start,n_end
+        if (pos_in_x) then
+          pos = index_x(m)
+        else
+          pos = index_y(m)
+        endif
+        index_z(m) = klo_nb_gb + pos/nxy
+        pos = mod(pos, nxy)
+        index_y(m) = jlo_nb_gb + pos/nx
+        index_x(m) = ilo_nb_gb + mod(pos, nx)
+      enddo
+      
+      return
+      end
+c } end subroutine
+c*********************************************************************** 
+
+
+
 c***********************************************************************
       subroutine lsm3dDetermineNarrowBand(
      &  phi,
@@ -284,7 +452,7 @@ c      } end loop over grid
      &   index_x, index_y, index_z,
      &   nlo_index, nhi_index,
      &   n_lo, n_hi,
-     &   level)
+     &   level, 127)
          
       else
         n_hi(0) = count;
@@ -299,6 +467,316 @@ c } end subroutine
 c***********************************************************************      
  
 
+c***********************************************************************
+      subroutine lsm3dUpdateNarrowBand(
+     &  phi,
+     &  ilo_gb, ihi_gb,
+     &  jlo_gb, jhi_gb,
+     &  klo_gb, khi_gb,
+     &  narrow_band,
+     &  ilo_nb_gb, ihi_nb_gb,
+     &  jlo_nb_gb, jhi_nb_gb,
+     &  klo_nb_gb, khi_nb_gb,
+     &  index_x,
+     &  index_y, 
+     &  index_z,
+     &  nlo_index, nhi_index,
+     &  n_lo, n_hi,
+     &  index_outer,
+     &  nlo_index_outer, nhi_index_outer,
+     &  nlo_outer_plus, nhi_outer_plus,
+     &  nlo_outer_minus, nhi_outer_minus,
+     &  width,
+     &  width_inner,
+     &  level,
+     &  num_neg_change)
+c***********************************************************************
+c { begin subroutine
+      implicit none
+      
+      integer ilo_gb, ihi_gb
+      integer jlo_gb, jhi_gb
+      integer klo_gb, khi_gb
+      integer ilo_nb_gb, ihi_nb_gb
+      integer jlo_nb_gb, jhi_nb_gb
+      integer klo_nb_gb, khi_nb_gb
+      real phi(ilo_gb:ihi_gb,jlo_gb:jhi_gb,klo_gb:khi_gb)
+      integer*1 narrow_band(ilo_nb_gb:ihi_nb_gb,jlo_nb_gb:jhi_nb_gb,
+     &                      klo_nb_gb:khi_nb_gb)
+      integer nlo_index, nhi_index
+      integer index_x(nlo_index:nhi_index)
+      integer index_y(nlo_index:nhi_index)
+      integer index_z(nlo_index:nhi_index)
+      real width, width_inner
+      integer nlo_index_outer, nhi_index_outer
+      integer nlo_outer_plus, nhi_outer_plus
+      integer nlo_outer_minus, nhi_outer_minus
+      integer index_outer(nlo_index_outer:nhi_index_outer)
+      integer level
+      integer n_lo(0:level), n_hi(0:level)
+      integer num_neg_change
+      
+c     local variables      
+      integer i,j,k,l,m,n, count, count_outer_minus, count_outer_plus
+      integer ii,jj,kk
+      integer lmax, num_add, max_add, ix, iy, iz, max_mark
+      integer p, q, w
+      integer num_neg_old, num_neg_new
+      logical less
+      real abs_phi_val
+      integer*1  one, zero
+      integer di(6), dj(6), dk(6)
+      data di / 1,-1, 0, 0, 0, 0 /
+      data dj / 0, 0, 1,-1, 0, 0 /
+      data dk / 0, 0, 0, 0, 1,-1 /
+
+      one = 1
+      zero = 0
+      max_mark = level+1
+      num_neg_change = 0
+      num_neg_old = 0
+      num_neg_new = 0
+      
+c     an empty narrow band stays empty
+      if( n_hi(0) .lt. n_lo(0) ) return
+
+c     find outermost (nonempty) level of previous narrow band
+      lmax = 0
+      do l=1,level
+        if( (n_lo(l) .lt. nlo_index) .or. (n_hi(l) .lt. n_lo(l)) ) exit
+        lmax = l
+      enddo
+
+c     reset marks of previous narrow band voxels (all levels are stored
+c     consecutively) so that voxels carrying boundary layer marks are
+c     not picked up again by the halo loop; voxels of the previous 
+c     narrow band with phi < 0 are counted along the way
+      do m=n_lo(0),n_hi(lmax)
+        i=index_x(m)
+        j=index_y(m)
+        k=index_z(m)
+        if( phi(i,j,k) .lt. 0.d0 ) num_neg_old = num_neg_old+1
+        if( abs(phi(i,j,k)) .lt. width ) then
+          narrow_band(i,j,k) = one
+        else
+          narrow_band(i,j,k) = zero
+        endif
+      enddo
+
+c     voxels that are added to level 0 (i.e. voxels of levels L >= 1 
+c     and of the halo with abs(phi) < width) are temporarily stored in 
+c     index_outer, which is split into three segments holding the x-, 
+c     y- and z-coordinates of the added voxels
+      max_add = (nhi_index_outer - nlo_index_outer + 1)/3
+      ix = nlo_index_outer
+      iy = ix + max_add
+      iz = iy + max_add
+      num_add = 0
+
+c     { begin loop over levels L >= 1 of previous narrow band
+      do m=n_hi(0)+1,n_hi(lmax)
+        i=index_x(m)
+        j=index_y(m)
+        k=index_z(m)
+        if( abs(phi(i,j,k)) .lt. width ) then
+          if( num_add .ge. max_add ) goto 100
+          index_outer(ix+num_add) = i
+          index_outer(iy+num_add) = j
+          index_outer(iz+num_add) = k
+          num_add = num_add+1
+          if( phi(i,j,k) .lt. 0.d0 ) num_neg_new = num_neg_new+1
+        endif
+      enddo
+c     } end loop over levels L >= 1
+
+c     { begin loop over one-layer halo of previous narrow band
+      do m=n_lo(lmax),n_hi(lmax)
+        do n=1,6
+          ii = index_x(m) + di(n)
+          jj = index_y(m) + dj(n)
+          kk = index_z(m) + dk(n)
+          
+          if( (ii .ge. ilo_nb_gb) .and. (ii .le. ihi_nb_gb) .and.
+     &        (jj .ge. jlo_nb_gb) .and. (jj .le. jhi_nb_gb) .and.
+     &        (kk .ge. klo_nb_gb) .and. (kk .le. khi_nb_gb) ) then
+            if( (narrow_band(ii,jj,kk) .eq. 0) .or.
+     &          (narrow_band(ii,jj,kk) .gt. max_mark) ) then
+              if( abs(phi(ii,jj,kk)) .lt. width ) then
+                if( num_add .ge. max_add ) goto 100
+                index_outer(ix+num_add) = ii
+                index_outer(iy+num_add) = jj
+                index_outer(iz+num_add) = kk
+                num_add = num_add+1
+                narrow_band(ii,jj,kk) = one
+                if( phi(ii,jj,kk) .lt. 0.d0 ) then
+                  num_neg_new = num_neg_new+1
+                endif
+              endif
+            endif
+          endif
+          
+        enddo
+      enddo
+c     } end loop over halo
+
+c     { begin loop over previous level 0 narrow band; voxels that remain
+c       in the narrow band are compacted in place (preserving grid order)
+      count = nlo_index
+      do m=n_lo(0),n_hi(0)
+        i=index_x(m)
+        j=index_y(m)
+        k=index_z(m)
+        
+        if( abs(phi(i,j,k)) .lt. width ) then
+          index_x(count) = i
+          index_y(count) = j
+          index_z(count) = k
+          count = count+1
+          if( phi(i,j,k) .lt. 0.d0 ) num_neg_new = num_neg_new+1
+        endif
+      enddo
+c     } end loop over previous level 0 narrow band 
+
+c     put the (typically few) added voxels in grid order
+      call lsm3dSortNarrowBandIndices(
+     &  index_outer(ix), index_outer(iy), index_outer(iz),
+     &  1, max_add,
+     &  1, num_add,
+     &  ilo_nb_gb, ihi_nb_gb,
+     &  jlo_nb_gb, jhi_nb_gb,
+     &  klo_nb_gb, khi_nb_gb)
+
+c     { begin merge of added voxels into level 0 narrow band
+c       (the merge proceeds from the back, so no additional storage is
+c        required)
+      p = count-1
+      q = num_add-1
+      w = count-1+num_add
+c       (less indicates that added voxel q precedes voxel p)
+   30 if (q .ge. 0) then
+        if (p .lt. nlo_index) then
+          less = .false.
+        elseif (index_outer(iz+q) .ne. index_z(p)) then
+          less = index_outer(iz+q) .lt. index_z(p)
+        elseif (index_outer(iy+q) .ne. index_y(p)) then
+          less = index_outer(iy+q) .lt. index_y(p)
+        else
+          less = index_outer(ix+q) .lt. index_x(p)
+        endif
+
+        if (less) then
+          index_x(w) = index_x(p)
+          index_y(w) = index_y(p)
+          index_z(w) = index_z(p)
+          p = p-1
+        else
+          index_x(w) = index_outer(ix+q)
+          index_y(w) = index_outer(iy+q)
+          index_z(w) = index_outer(iz+q)
+          q = q-1
+        endif
+        w = w-1
+        goto 30
+      endif
+c     } end merge
+
+      n_lo(0) = nlo_index
+      n_hi(0) = count-1+num_add
+      
+c     { begin loop over level 0 narrow band to find outer layer voxels
+c     (outer narrow band points with negative phi are stored at the 
+c      front and the positive at the end of the index_outer array)
+      count_outer_minus = nlo_index_outer
+      nlo_outer_minus =   nlo_index_outer
+      
+      count_outer_plus =  nhi_index_outer
+      nhi_outer_plus =    nhi_index_outer
+
+      do m=n_lo(0),n_hi(0)
+        abs_phi_val = abs(phi(index_x(m),index_y(m),index_z(m)))
+        if( abs_phi_val .ge. width_inner )  then
+          if( phi(index_x(m),index_y(m),index_z(m)) .le. 0d0 ) then
+            index_outer(count_outer_minus) = m
+            count_outer_minus = count_outer_minus+1
+          else
+            index_outer(count_outer_plus) = m
+            count_outer_plus = count_outer_plus-1
+          endif     
+        endif
+      enddo
+c     } end loop over level 0 narrow band
+
+      nhi_outer_minus = count_outer_minus - 1
+      nlo_outer_plus  = count_outer_plus  + 1
+
+      if( n_hi(0) .ge. n_lo(0) ) then
+        call  lsm3dMarkNarrowBandNeighbors(
+     &    narrow_band,
+     &    ilo_nb_gb, ihi_nb_gb, jlo_nb_gb, jhi_nb_gb, 
+     &    klo_nb_gb, khi_nb_gb,
+     &    index_x, index_y, index_z,
+     &    nlo_index, nhi_index,
+     &    n_lo, n_hi,
+     &    level, max_mark)
+
+c       count voxels with phi < 0 in the new levels L >= 1 (level 0 
+c       voxels have already been counted)
+        do l=1,level
+          if( (n_lo(l) .lt. nlo_index) .or.
+     &        (n_hi(l) .lt. n_lo(l)) ) exit
+          do m=n_lo(l),n_hi(l)
+            if( phi(index_x(m),index_y(m),index_z(m)) .lt. 0.d0 ) then
+              num_neg_new = num_neg_new+1
+            endif
+          enddo
+        enddo
+      else
+        do l=1,level
+          n_lo(l) = -1
+          n_hi(l) = -1
+        enddo
+      endif
+
+      num_neg_change = num_neg_new - num_neg_old
+          
+      return
+
+c     not enough scratch space for the added voxels, so rebuild the 
+c     narrow band from scratch
+  100 continue
+      call lsm3dDetermineNarrowBand(
+     &  phi,
+     &  ilo_gb, ihi_gb, jlo_gb, jhi_gb, klo_gb, khi_gb,
+     &  narrow_band,
+     &  ilo_nb_gb, ihi_nb_gb, jlo_nb_gb, jhi_nb_gb,
+     &  klo_nb_gb, khi_nb_gb,
+     &  index_x, index_y, index_z,
+     &  nlo_index, nhi_index,
+     &  n_lo, n_hi,
+     &  index_outer,
+     &  nlo_index_outer, nhi_index_outer,
+     &  nlo_outer_plus, nhi_outer_plus,
+     &  nlo_outer_minus, nhi_outer_minus,
+     &  width, width_inner, level)
+
+c     count voxels with phi < 0 in the rebuilt narrow band (all levels)
+      num_neg_new = 0
+      do l=0,level
+        if( (n_lo(l) .lt. nlo_index) .or. (n_hi(l) .lt. n_lo(l)) ) exit
+        do m=n_lo(l),n_hi(l)
+          if( phi(index_x(m),index_y(m),index_z(m)) .lt. 0.d0 ) then
+            num_neg_new = num_neg_new+1
+          endif
+        enddo
+      enddo
+      num_neg_change = num_neg_new - num_neg_old
+
+      return
+      end     
+c } end subroutine
+c***********************************************************************      
+ 
+
 c***********************************************************************
       subroutine lsm3dMarkNarrowBandBoundaryLayer(
      &  narrow_band,
@@ -469,7 +947,7 @@ c     } end loop over grid
      &  index_x, index_y, index_z,
      &  nlo_index, nhi_index,
      &  n_lo, n_hi,
-     &  level)  
+     &  level, 127)  
       
       return
       end
@@ -774,3 +1252,107 @@ c       } end loop over indexed points
       end
 c } end subroutine
 c***********************************************************************
+
+
+c***********************************************************************
+      subroutine lsm3dComputeNarrowBandLinearIndex(
+     &  index_lin,
+     &  index_x,
+     &  index_y,
+     &  index_z,
+     &  nlo_index, nhi_index,
+     &  ilo_gb, ihi_gb,
+     &  jlo_gb, jhi_gb,
+     &  klo_gb, khi_gb)
+c***********************************************************************
+c { begin subroutine
+      implicit none
+
+c     _gb refers to ghostbox
+      integer ilo_gb, ihi_gb
+      integer jlo_gb, jhi_gb
+      integer klo_gb, khi_gb
+      integer nlo_index, nhi_index
+      integer index_lin(nlo_index:nhi_index)
+      integer index_x(nlo_index:nhi_index)
+      integer index_y(nlo_index:nhi_index)
+      integer index_z(nlo_index:nhi_index)
+      
+c     local variables      
+      integer l, nx, nxy
+
+      nx  = ihi_gb - ilo_gb + 1
+      nxy = nx*(jhi_gb - jlo_gb + 1)
+
+c     { begin loop over indexed points
+      do l=nlo_index, nhi_index      
+        index_lin(l) = (index_x(l) - ilo_gb) 
+     &               + (index_y(l) - jlo_gb)*nx
+     &               + (index_z(l) - klo_gb)*nxy
+      enddo
+c     } end loop over indexed points
+      
+      return
+      end
+c } end subroutine
+c***********************************************************************
+
+
+c***********************************************************************
+      subroutine lsm3dMultiplyCutOffLSERHSLOCALLinear(
+     &  phi,
+     &  lse_rhs,
+     &  index_lin,
+     &  nlo_index, nhi_index,
+     &  narrow_band,
+     &  mark_fb,
+     &  beta, gamma)
+c**********************************************************************
+c { begin subroutine
+      implicit none
+
+      real lse_rhs(0:*)
+      real phi(0:*)
+      integer nlo_index, nhi_index
+      integer index_lin(nlo_index:nhi_index)
+      real beta, gamma
+      integer*1 narrow_band(0:*)
+      integer*1 mark_fb
+      
+c     local variables      
+      integer l, m
+      real abs_phi_val, cut_off_coeff
+      real gb_const1, gb_const2, temp
+      
+      gb_const1 = gamma - 3*beta;
+      gb_const2 = (gamma - beta);
+      gb_const2 = gb_const2*gb_const2*gb_const2;
+      
+c     { begin loop over indexed points
+      do l=nlo_index, nhi_index      
+        m=index_lin(l)
+	
+        if( narrow_band(m) .le. mark_fb ) then
+
+	    abs_phi_val = abs(phi(m))
+	      	      
+	    if( abs_phi_val .le. beta ) then
+	       cut_off_coeff = 1
+	    else if( abs_phi_val .le. gamma ) then
+	       temp = (abs_phi_val - gamma);
+	       cut_off_coeff = ( temp * temp
+     &               *(2*abs_phi_val + gb_const1) ) / gb_const2
+	    else 
+	       cut_off_coeff = 0
+	    endif
+	    
+            lse_rhs(m) = cut_off_coeff*lse_rhs(m)
+	endif
+	    
+      enddo 
+c     } end loop over indexed points
+	
+      return
+      end
+c } end subroutine
+c***********************************************************************
@@ -35,6 +35,7 @@ extern "C" {
  */
  
  #define LSM3D_DETERMINE_NARROW_BAND           lsm3ddeterminenarrowband_
+ #define LSM3D_UPDATE_NARROW_BAND              lsm3dupdatenarrowband_
  #define LSM3D_MARK_NARROW_BAND_BOUNDARY_LAYER lsm3dmarknarrowbandboundarylayer_
  #define LSM3D_DETERMINE_NARROW_BAND_FROM_MASK lsm3ddeterminenarrowbandfrommask_
  #define LSM3D_MULTIPLY_CUT_OFF_LSE_RHS_LOCAL  lsm3dmultiplycutofflserhslocal_
@@ -42,6 +43,9 @@ extern "C" {
  
  #define LSM3D_IMPOSE_MASK_LOCAL               lsm3dimposemasklocal_
  #define LSM3D_COPY_DATA_LOCAL                 lsm3dcopydatalocal_
+ #define LSM3D_COMPUTE_NARROW_BAND_LINEAR_INDEX lsm3dcomputenarrowbandlinearindex_
+ #define LSM3D_MULTIPLY_CUT_OFF_LSE_RHS_LOCAL_LINEAR \
+                                        lsm3dmultiplycutofflserhslocallinear_
  
 #ifdef __cplusplus
 extern "C" {
@@ -85,6 +89,9 @@ extern "C" {
 *     negative phi values separately in order to be able to identify change
 *     of signs for phi (i.e. when zero level set crosses into the outer layer),
 *     see lsm3dCheckOuterNarrowBandLayer() 
+*    - the voxels of each narrow band level are stored in grid order 
+*     (ordered by z- then y- then x-coordinate), so loops over the index_* 
+*     arrays access memory nearly sequentially
 */ 
  void LSM3D_DETERMINE_NARROW_BAND(
  const LSMLIB_REAL *phi,
@@ -120,6 +127,104 @@ extern "C" {
  const int *level);
  
  
+/*!
+*
+*  LSM3D_UPDATE_NARROW_BAND() updates a narrow band previously computed by
+*  LSM3D_DETERMINE_NARROW_BAND() (or LSM3D_UPDATE_NARROW_BAND()) after the
+*  level set function has changed.  Only the voxels of the previous narrow 
+*  band (all levels) and the one-layer halo surrounding it are examined,
+*  so the cost is proportional to the size of the narrow band rather than 
+*  the size of the grid.  The narrow band levels, index_* arrays and 
+*  index_outer arrays are the same as those that LSM3D_DETERMINE_NARROW_BAND()
+*  would compute (including the ordering of the narrow band voxels).
+*
+*  Arguments:
+*    phi(in):            level set functions (assumed signed distance 
+*                        function)
+*    narrow_band(in/out): array with values L+1 for narrow band level L 
+*                        voxels and 0 otherwise
+*    index_*(in/out):    array with coordinates of narrow band voxels
+*                        indices of level L narrow band stored consecutively
+*    n*_index(in):       (allocated) index range of index_* arrays 
+*    n_lo(in/out):       array, n_lo[L] is starting index of the level L 
+*                        narrow band voxels
+*    n_hi(in/out):       array, n_hi[L] is ending index of the level L 
+*                        narrow band voxels  
+*    level(in):          number of narrow band levels to mark
+*    width(in):          narrow band width (distance to the zero level set)
+*    width_inner(in):    inner narrow band width
+*    index_outer(out):   indices of the narrow band voxels such that 
+*                        width_inner <= abs(phi) < width
+*    n*_plus(out):       index range of 'index_outer' elements for which
+*                        phi values satisfy  0 < width_inner <= phi < width  
+*    n*_minus(out):      index range of 'index_outer' elements for which
+*                        phi values satisfy  0> -width_inner >= phi > -width 
+*    *_gb (in):          index range for ghostbox
+*    num_neg_change(out): change in the number of narrow band voxels 
+*                        (all levels) where phi < 0, i.e. the number of 
+*                        voxels with phi < 0 that enter the narrow band
+*                        minus the number that leave it
+*
+*    Notes:
+*    - phi is assumed to have changed only within the previous narrow band 
+*      (e.g. by the _LOCAL level set evolution and reinitialization 
+*      routines).  Because the cut-off function keeps the zero level set
+*      inside the inner narrow band, the update only needs to be done
+*      after LSM3D_CHECK_OUTER_NARROW_BAND_LAYER() detects a sign change
+*      in the outer layer (or, more generally, after reinitialization)
+*    - voxels that remain in level 0 keep their (grid) order; voxels that
+*      are added to level 0 are sorted and merged into the level 0 list, so
+*      the cost of maintaining the grid ordering is proportional to the
+*      number of added voxels rather than the size of the narrow band
+*    - narrow_band values greater than level+1 (e.g. boundary layer marks
+*      set by LSM3D_MARK_NARROW_BAND_BOUNDARY_LAYER()) are treated as voxels
+*      that are not in the narrow band, so boundary layers do not need to 
+*      be removed before the update 
+*    - index_outer is used as scratch space for voxels added to level 0;
+*      if it is too small, the narrow band is rebuilt by 
+*      LSM3D_DETERMINE_NARROW_BAND()
+*    - num_neg_change is accumulated while the narrow band is updated
+*      (only the new levels L >= 1 require an additional pass), so 
+*      the number of voxels with phi < 0 outside of the narrow band can 
+*      be maintained without counting the narrow band voxels before and
+*      after the update
+*    - if the previous narrow band is empty, it is not changed 
+*/ 
+ void LSM3D_UPDATE_NARROW_BAND(
+ const LSMLIB_REAL *phi,
+ const int *ilo_gb, 
+ const int *ihi_gb,
+ const int *jlo_gb, 
+ const int *jhi_gb,
+ const int *klo_gb, 
+ const int *khi_gb,
+ unsigned char *narrow_band,
+ const int *ilo_nb_gb, 
+ const int *ihi_nb_gb,
+ const int *jlo_nb_gb, 
+ const int *jhi_nb_gb,
+ const int *klo_nb_gb, 
+ const int *khi_nb_gb,
+ int *index_x,
+ int *index_y, 
+ int *index_z,
+ const int *nlo_index, 
+ const int *nhi_index,
+ int *n_lo,
+ int *n_hi,
+ int  *index_outer,
+ const int *nlo_index_outer, 
+ const int *nhi_index_outer,
+ int *nlo_index_outer_plus, 
+ int *nhi_index_outer_plus,
+ int *nlo_index_outer_minus, 
+ int *nhi_index_outer_minus,
+ const LSMLIB_REAL *width,
+ const LSMLIB_REAL *width_inner,
+ const int *level,
+ int *num_neg_change);
+ 
+ 
 /*!
 * LSM3D_MARK_NARROW_BAND_BOUNDARY_LAYER() marks planes x = ilo_fb, x = ihi_fb,
 * y = jlo_fb, y = jhi_fb, z = klo_fb and z = khi_fb in narrow band array 
@@ -252,6 +357,37 @@ extern "C" {
  const LSMLIB_REAL *beta,
  const LSMLIB_REAL *gamma);
 
+/*!
+*
+*  LSM3D_MULTIPLY_CUT_OFF_LSE_RHS_LOCAL_LINEAR() is identical to 
+*  LSM3D_MULTIPLY_CUT_OFF_LSE_RHS_LOCAL() except that the narrow band 
+*  voxels are specified by their linear offsets (see 
+*  LSM3D_COMPUTE_NARROW_BAND_LINEAR_INDEX()).
+*
+*  Arguments:
+*    phi(in):           level set method function
+*    lse_rhs (in/out):  right-hand of level set equation         
+*    index_lin(in):     linear offsets of narrow band voxels
+*    n*_index:          index range of index_lin array
+*    narrow_band(in):   array that marks voxels outside desired fillbox
+*    mark_fb(in):       upper limit narrow band value for voxels in 
+*                       fillbox
+*
+*  NOTES:
+*   - phi, lse_rhs and narrow_band must have the same ghostbox
+*
+*/
+ void LSM3D_MULTIPLY_CUT_OFF_LSE_RHS_LOCAL_LINEAR(
+ const LSMLIB_REAL *phi,
+ LSMLIB_REAL *lse_rhs,
+ const int *index_lin,
+ const int *nlo_index, 
+ const int *nhi_index,
+ const unsigned char *narrow_band,
+ const unsigned char *mark_fb,
+ const LSMLIB_REAL *beta,
+ const LSMLIB_REAL *gamma);
+
 /*!
 *
 *  LSM3D_CHECK_OUTER_NARROW_BAND_LAYER() checks outer narrow band voxels for 
@@ -364,6 +500,46 @@ extern "C" {
   const int *index_z,
   const int *nlo_index,
   const int *nhi_index);  
+
+/*!
+*  LSM3D_COMPUTE_NARROW_BAND_LINEAR_INDEX() computes the linear offsets of 
+*  the narrow band voxels into arrays with the specified ghostbox, i.e.
+*
+*    index_lin[l] = (index_x[l]-ilo_gb) + (index_y[l]-jlo_gb)*nx 
+*                 + (index_z[l]-klo_gb)*nx*ny
+*
+*  where nx and ny are the number of grid points in the x- and 
+*  y-directions of the ghostbox.  The linear offsets are used by the 
+*  narrow band routines that take a single index array (the _LINEAR
+*  variants of the narrow band derivative, right-hand side and TVD 
+*  Runge-Kutta routines), which avoids reconstructing the array offset 
+*  from (i,j,k) at every voxel.
+*
+*  Arguments:
+*    index_lin (out):    linear offsets of narrow band voxels
+*    index_*(in):        array with coordinates of narrow band voxels
+*    n*_index(in):       index range of index_* arrays
+*    *_gb (in):          index range for ghostbox
+*
+*  NOTES:
+*   - the linear offsets must be recomputed whenever the narrow band
+*     changes (e.g. after LSM3D_DETERMINE_NARROW_BAND() or 
+*     LSM3D_UPDATE_NARROW_BAND())
+*
+*/
+ void  LSM3D_COMPUTE_NARROW_BAND_LINEAR_INDEX(
+  int *index_lin,
+  const int *index_x,
+  const int *index_y,
+  const int *index_z,
+  const int *nlo_index,
+  const int *nhi_index,
+  const int *ilo_gb, 
+  const int *ihi_gb,
+  const int *jlo_gb, 
+  const int *jhi_gb,
+  const int *klo_gb, 
+  const int *khi_gb);
  
 #ifdef __cplusplus
 }
@@ -37,6 +37,8 @@ extern "C" {
                                      lsm3dcomputereinitializationeqnrhslocal_
 #define LSM3D_COMPUTE_ORTHOGONALIZATION_EQN_RHS_LOCAL                           \
                                      lsm3dcomputeorthogonalizationeqnrhslocal_				     
+#define LSM3D_COMPUTE_REINITIALIZATION_EQN_RHS_LOCAL_LINEAR                     \
+                                     lsm3dcomputereinitializationeqnrhslocallinear_
 
 void LSM3D_COMPUTE_REINITIALIZATION_EQN_RHS_LOCAL(
   LSMLIB_REAL *reinit_rhs,
@@ -164,6 +166,26 @@ void LSM3D_COMPUTE_ORTHOGONALIZATION_EQN_RHS_LOCAL(
   const int *khi_nb_gb,
   const unsigned char *mark_fb);
 
+void LSM3D_COMPUTE_REINITIALIZATION_EQN_RHS_LOCAL_LINEAR(
+  LSMLIB_REAL *reinit_rhs,
+  const LSMLIB_REAL* phi,
+  const LSMLIB_REAL* phi0,
+  const LSMLIB_REAL *phi_x_plus, 
+  const LSMLIB_REAL *phi_y_plus,
+  const LSMLIB_REAL *phi_z_plus,
+  const LSMLIB_REAL *phi_x_minus, 
+  const LSMLIB_REAL *phi_y_minus,
+  const LSMLIB_REAL *phi_z_minus,
+  const LSMLIB_REAL *dx, 
+  const LSMLIB_REAL *dy,
+  const LSMLIB_REAL *dz,
+  const int *use_phi0_for_sgn,
+  const int *index_lin,
+  const int *nlo_index,
+  const int *nhi_index,  
+  const unsigned char *narrow_band,
+  const unsigned char *mark_fb);
+
   
 #ifdef __cplusplus
 }
@@ -0,0 +1,562 @@
+/*
+ * File:        lsm_spatial_derivative_kernels.h
+ * Copyrights:  (c) 2005 The Trustees of Princeton University and Board of
+ *                  Regents of the University of Texas.  All rights reserved.
+ *              (c) 2009 Kevin T. Chu.  All rights reserved.
+ * Revision:    $Revision$
+ * Modified:    $Date$
+ * Description: Header file for C++ templated ENO/WENO spatial derivative
+ *              and level set equation RHS kernels
+ */
+
+#ifndef INCLUDED_LSM_SPATIAL_DERIVATIVE_KERNELS_H
+#define INCLUDED_LSM_SPATIAL_DERIVATIVE_KERNELS_H
+
+#include <math.h>
+#include "LSMLIB_config.h"
+
+/*! \file lsm_spatial_derivative_kernels.h
+ *
+ * \brief
+ * @ref lsm_spatial_derivative_kernels.h provides header-only C++
+ * implementations of the HJ ENO/WENO spatial derivative kernels and the
+ * level set equation RHS kernel that are templated on the number of
+ * spatial dimensions, the order of the spatial discretization, and the
+ * floating-point type.
+ *
+ * Because the dimension, the stencil and the stride in the x-direction
+ * are compile-time constants, the compiler can fully unroll the stencils
+ * and vectorize the inner (x-direction) loops.  Unlike the Fortran 77
+ * kernels, no scratch space for undivided differences is required; the
+ * undivided differences are computed directly from phi.
+ *
+ * The kernels perform the same floating-point operations (in the same
+ * order) as the corresponding Fortran 77 kernels in
+ * @ref lsm_spatial_derivatives1d.h, @ref lsm_spatial_derivatives2d.h,
+ * @ref lsm_spatial_derivatives3d.h and @ref lsm_level_set_evolution3d.h,
+ * so they produce identical results when compiled without
+ * floating-point contraction or reassociation.
+ *
+ * Supported values of SCHEME_ORDER:  1, 2, 3 (HJ ENO) and 5 (HJ WENO).
+ *
+ * NOTES:
+ *  - All data arrays are stored in the same (i fastest) order as the
+ *    Fortran arrays and are described by their ghostbox (LSMKernelBox).
+ *  - The phi ghostbox must be at least
+ *    LSMHJStencil<SCHEME_ORDER,REAL>::GHOST_WIDTH cells wider than the
+ *    fillbox in each coordinate direction.
+ *
+ */
+
+namespace LSMLIB {
+
+
+/*!
+ * LSMKernelTraits provides the tolerances used by the kernels for
+ * the specified floating-point type.  The values are the same as the
+ * values used by the Fortran 77 kernels (lsmlib_zero_tol and
+ * tiny_nonzero_number).
+ */
+template <class REAL> struct LSMKernelTraits;
+
+template <> struct LSMKernelTraits<double>
+{
+  static double zeroTol() { return 1.e-11; }
+  static double tinyNonzeroNumber() { return 1.e-99; }
+};
+
+template <> struct LSMKernelTraits<float>
+{
+  static float zeroTol() { return 1.e-5f; }
+  static float tinyNonzeroNumber() { return 1.e-35f; }
+};
+
+
+/*!
+ * LSMKernelBox describes the index range of a box of grid cells (e.g.
+ * the ghostbox of a data array or the fillbox for a computation).
+ * Entries for unused dimensions (e.g. the k-direction in 2D) are zero.
+ */
+struct LSMKernelBox
+{
+  int lo[3];
+  int hi[3];
+
+  LSMKernelBox()
+  {
+    for (int dir = 0; dir < 3; dir++) { lo[dir] = 0; hi[dir] = 0; }
+  }
+
+  /*!
+   * Constructor
+   *
+   * Arguments:
+   *  - lo_in, hi_in (in):  lower and upper indices of box
+   *  - num_dims (in):      number of dimensions
+   */
+  LSMKernelBox(const int* lo_in, const int* hi_in, const int num_dims)
+  {
+    for (int dir = 0; dir < 3; dir++) {
+      lo[dir] = (dir < num_dims) ? lo_in[dir] : 0;
+      hi[dir] = (dir < num_dims) ? hi_in[dir] : 0;
+    }
+  }
+
+  //! stride between neighboring cells in the specified direction
+  int stride(const int dir) const
+  {
+    int s = 1;
+    for (int d = 0; d < dir; d++) s *= hi[d] - lo[d] + 1;
+    return s;
+  }
+
+  //! offset of cell (i,j,k) from the start of a data array on the box
+  int offset(const int i, const int j, const int k) const
+  {
+    return (i - lo[0])
+         + (j - lo[1])*(hi[0] - lo[0] + 1)
+         + (k - lo[2])*(hi[0] - lo[0] + 1)*(hi[1] - lo[1] + 1);
+  }
+};
+
+
+/*!
+ * LSMHJStencil<SCHEME_ORDER,REAL> computes the forward (plus) and
+ * backward (minus) HJ ENO/WENO approximations to the derivative of phi
+ * at a single grid cell in a single coordinate direction.
+ *
+ * compute() arguments:
+ *  - p (in):         pointer to phi at the grid cell
+ *  - s (in):         stride between neighboring cells in the
+ *                    coordinate direction
+ *  - inv_dx (in):    1/(grid spacing) in the coordinate direction
+ *  - plus (out):     forward approximation to the derivative
+ *  - minus (out):    backward approximation to the derivative
+ */
+template <int SCHEME_ORDER, class REAL> struct LSMHJStencil;
+
+template <class REAL> struct LSMHJStencil<1,REAL>
+{
+  enum { GHOST_WIDTH = 1 };
+
+  static inline void compute(const REAL* p, const int s,
+                             const REAL inv_dx,
+                             REAL& plus, REAL& minus)
+  {
+    plus = (p[s] - p[0])*inv_dx;
+    minus = (p[0] - p[-s])*inv_dx;
+  }
+};
+
+template <class REAL> struct LSMHJStencil<2,REAL>
+{
+  enum { GHOST_WIDTH = 2 };
+
+  static inline void compute(const REAL* p, const int s,
+                             const REAL inv_dx,
+                             REAL& plus, REAL& minus)
+  {
+    const REAL half = 0.5;
+
+    // D1_m = phi(m) - phi(m-1) for m = i-1, ..., i+2
+    const REAL D1_m1 = p[-s] - p[-2*s];
+    const REAL D1_0  = p[0] - p[-s];
+    const REAL D1_p1 = p[s] - p[0];
+    const REAL D1_p2 = p[2*s] - p[s];
+
+    // D2_m = D1_(m+1) - D1_m for m = i-1, i, i+1
+    const REAL D2_m1 = D1_0 - D1_m1;
+    const REAL D2_0  = D1_p1 - D1_0;
+    const REAL D2_p1 = D1_p2 - D1_p1;
+
+    plus = (fabs(D2_0) < fabs(D2_p1)) ?
+           (D1_p1 - half*D2_0)*inv_dx : (D1_p1 - half*D2_p1)*inv_dx;
+    minus = (fabs(D2_m1) < fabs(D2_0)) ?
+            (D1_0 + half*D2_m1)*inv_dx : (D1_0 + half*D2_0)*inv_dx;
+  }
+};
+
+template <class REAL> struct LSMHJStencil<3,REAL>
+{
+  enum { GHOST_WIDTH = 3 };
+
+  static inline void compute(const REAL* p, const int s,
+                             const REAL inv_dx,
+                             REAL& plus, REAL& minus)
+  {
+    const REAL half = 0.5;
+    const REAL third = 1.0/3.0;
+    const REAL sixth = 1.0/6.0;
+
+    // D1_m = phi(m) - phi(m-1) for m = i-2, ..., i+3
+    const REAL D1_m2 = p[-2*s] - p[-3*s];
+    const REAL D1_m1 = p[-s] - p[-2*s];
+    const REAL D1_0  = p[0] - p[-s];
+    const REAL D1_p1 = p[s] - p[0];
+    const REAL D1_p2 = p[2*s] - p[s];
+    const REAL D1_p3 = p[3*s] - p[2*s];
+
+    // D2_m = D1_(m+1) - D1_m for m = i-2, ..., i+2
+    const REAL D2_m2 = D1_m1 - D1_m2;
+    const REAL D2_m1 = D1_0 - D1_m1;
+    const REAL D2_0  = D1_p1 - D1_0;
+    const REAL D2_p1 = D1_p2 - D1_p1;
+    const REAL D2_p2 = D1_p3 - D1_p2;
+
+    // D3_m = D2_m - D2_(m-1) for m = i-1, ..., i+2
+    const REAL D3_m1 = D2_m1 - D2_m2;
+    const REAL D3_0  = D2_0 - D2_m1;
+    const REAL D3_p1 = D2_p1 - D2_0;
+    const REAL D3_p2 = D2_p2 - D2_p1;
+
+    REAL val;
+
+    // plus
+    val = D1_p1;
+    if (fabs(D2_0) < fabs(D2_p1)) {
+      val = val - half*D2_0;
+      val = (fabs(D3_0) < fabs(D3_p1)) ?
+            val - sixth*D3_0 : val - sixth*D3_p1;
+    } else {
+      val = val - half*D2_p1;
+      val = (fabs(D3_p1) < fabs(D3_p2)) ?
+            val + third*D3_p1 : val + third*D3_p2;
+    }
+    plus = val*inv_dx;
+
+    // minus
+    val = D1_0;
+    if (fabs(D2_m1) < fabs(D2_0)) {
+      val = val + half*D2_m1;
+      val = (fabs(D3_m1) < fabs(D3_0)) ?
+            val + third*D3_m1 : val + third*D3_0;
+    } else {
+      val = val + half*D2_0;
+      val = (fabs(D3_0) < fabs(D3_p1)) ?
+            val - sixth*D3_0 : val - sixth*D3_p1;
+    }
+    minus = val*inv_dx;
+  }
+};
+
+template <class REAL> struct LSMHJStencil<5,REAL>
+{
+  enum { GHOST_WIDTH = 3 };
+
+  /*!
+   * weno5() computes the WENO5 approximation from the divided
+   * differences v1, ..., v5 (ordered in the upwind direction).
+   */
+  static inline REAL weno5(const REAL v1, const REAL v2, const REAL v3,
+                           const REAL v4, const REAL v5)
+  {
+    const REAL one_third = 1.0/3.0;
+    const REAL seven_sixths = 7.0/6.0;
+    const REAL eleven_sixths = 11.0/6.0;
+    const REAL one_sixth = 1.0/6.0;
+    const REAL five_sixths = 5.0/6.0;
+    const REAL thirteen_twelfths = 13.0/12.0;
+    const REAL one_fourth = 0.25;
+
+    // compute eps
+    REAL max_v_sq = v1*v1;
+    if (v2*v2 > max_v_sq) max_v_sq = v2*v2;
+    if (v3*v3 > max_v_sq) max_v_sq = v3*v3;
+    if (v4*v4 > max_v_sq) max_v_sq = v4*v4;
+    if (v5*v5 > max_v_sq) max_v_sq = v5*v5;
+    const REAL eps = REAL(1e-6)*max_v_sq
+                   + LSMKernelTraits<REAL>::tinyNonzeroNumber();
+
+    // candidate approximations
+    const REAL phi_1 = one_third*v1 - seven_sixths*v2 + eleven_sixths*v3;
+    const REAL phi_2 = -one_sixth*v2 + five_sixths*v3 + one_third*v4;
+    const REAL phi_3 = one_third*v3 + five_sixths*v4 - one_sixth*v5;
+
+    // smoothness measures
+    const REAL t1 = v1 - 2.0*v2 + v3, t2 = v1 - 4.0*v2 + 3.0*v3;
+    const REAL t3 = v2 - 2.0*v3 + v4, t4 = v2 - v4;
+    const REAL t5 = v3 - 2.0*v4 + v5, t6 = 3.0*v3 - 4.0*v4 + v5;
+    const REAL S1 = thirteen_twelfths*(t1*t1) + one_fourth*(t2*t2);
+    const REAL S2 = thirteen_twelfths*(t3*t3) + one_fourth*(t4*t4);
+    const REAL S3 = thirteen_twelfths*(t5*t5) + one_fourth*(t6*t6);
+
+    // normalized weights
+    REAL a1 = REAL(0.1)/((S1+eps)*(S1+eps));
+    REAL a2 = REAL(0.6)/((S2+eps)*(S2+eps));
+    REAL a3 = REAL(0.3)/((S3+eps)*(S3+eps));
+    const REAL inv_sum_a = REAL(1.0)/(a1 + a2 + a3);
+    a1 = a1*inv_sum_a;
+    a2 = a2*inv_sum_a;
+    a3 = a3*inv_sum_a;
+
+    return a1*phi_1 + a2*phi_2 + a3*phi_3;
+  }
+
+  static inline void compute(const REAL* p, const int s,
+                             const REAL inv_dx,
+                             REAL& plus, REAL& minus)
+  {
+    plus = weno5( (p[3*s] - p[2*s])*inv_dx, (p[2*s] - p[s])*inv_dx,
+                  (p[s] - p[0])*inv_dx, (p[0] - p[-s])*inv_dx,
+                  (p[-s] - p[-2*s])*inv_dx );
+    minus = weno5( (p[-2*s] - p[-3*s])*inv_dx, (p[-s] - p[-2*s])*inv_dx,
+                   (p[0] - p[-s])*inv_dx, (p[s] - p[0])*inv_dx,
+                   (p[2*s] - p[s])*inv_dx );
+  }
+};
+
+
+/*
+ * LSMHJGradientLoop applies the HJ stencil in coordinate direction
+ * DIR and then recurses to direction DIR+1.  The recursion makes
+ * the x-direction stride a compile-time constant (equal to 1).
+ */
+template <int DIM, int SCHEME_ORDER, class REAL, int DIR>
+struct LSMHJGradientLoop
+{
+  static void apply(
+    REAL* const grad_phi_plus[], const LSMKernelBox& grad_phi_plus_gb,
+    REAL* const grad_phi_minus[], const LSMKernelBox& grad_phi_minus_gb,
+    const REAL* phi, const LSMKernelBox& phi_gb,
+    const LSMKernelBox& fillbox, const REAL* dx)
+  {
+    const int s = (DIR == 0) ? 1 : phi_gb.stride(DIR);
+    const REAL inv_dx = REAL(1.0)/dx[DIR];
+    const int n = fillbox.hi[0] - fillbox.lo[0] + 1;
+
+    for (int k = fillbox.lo[2]; k <= fillbox.hi[2]; k++) {
+      for (int j = fillbox.lo[1]; j <= fillbox.hi[1]; j++) {
+        const REAL* p = phi + phi_gb.offset(fillbox.lo[0], j, k);
+        REAL* plus = grad_phi_plus[DIR]
+                   + grad_phi_plus_gb.offset(fillbox.lo[0], j, k);
+        REAL* minus = grad_phi_minus[DIR]
+                    + grad_phi_minus_gb.offset(fillbox.lo[0], j, k);
+        for (int i = 0; i < n; i++) {
+          LSMHJStencil<SCHEME_ORDER,REAL>::compute(
+            p + i, s, inv_dx, plus[i], minus[i]);
+        }
+      }
+    }
+
+    LSMHJGradientLoop<DIM,SCHEME_ORDER,REAL,DIR+1>::apply(
+      grad_phi_plus, grad_phi_plus_gb, grad_phi_minus, grad_phi_minus_gb,
+      phi, phi_gb, fillbox, dx);
+  }
+};
+
+template <int DIM, int SCHEME_ORDER, class REAL>
+struct LSMHJGradientLoop<DIM,SCHEME_ORDER,REAL,DIM>
+{
+  static void apply(
+    REAL* const*, const LSMKernelBox&,
+    REAL* const*, const LSMKernelBox&,
+    const REAL*, const LSMKernelBox&,
+    const LSMKernelBox&, const REAL*) {}
+};
+
+
+/*!
+ * lsmComputeHJPlusAndMinusGradients() computes the forward (plus) and
+ * backward (minus) HJ ENO/WENO approximations to the gradient of phi.
+ * It is equivalent to LSM{1,2,3}D_HJ_ENO{1,2,3}/LSM{1,2,3}D_HJ_WENO5.
+ *
+ * Template parameters:
+ *  - DIM:           number of spatial dimensions (1, 2 or 3)
+ *  - SCHEME_ORDER:  1, 2, 3 (HJ ENO) or 5 (HJ WENO)
+ *  - REAL:          floating-point type
+ *
+ * Arguments:
+ *  - grad_phi_plus (out):   DIM components of grad(phi) in plus direction
+ *  - grad_phi_minus (out):  DIM components of grad(phi) in minus direction
+ *  - phi (in):              phi
+ *  - dx (in):               grid spacing (DIM entries)
+ *  - *_gb (in):             ghostboxes of data arrays
+ *  - fillbox (in):          cells where the gradients are computed
+ *
+ * Return value:             none
+ *
+ */
+template <int DIM, int SCHEME_ORDER, class REAL>
+inline void lsmComputeHJPlusAndMinusGradients(
+  REAL* const grad_phi_plus[], const LSMKernelBox& grad_phi_plus_gb,
+  REAL* const grad_phi_minus[], const LSMKernelBox& grad_phi_minus_gb,
+  const REAL* phi, const LSMKernelBox& phi_gb,
+  const LSMKernelBox& fillbox,
+  const REAL* dx)
+{
+  LSMHJGradientLoop<DIM,SCHEME_ORDER,REAL,0>::apply(
+    grad_phi_plus, grad_phi_plus_gb, grad_phi_minus, grad_phi_minus_gb,
+    phi, phi_gb, fillbox, dx);
+}
+
+
+/*
+ * LSMUpwindHJGradientLoop is the upwind analogue of LSMHJGradientLoop.
+ */
+template <int DIM, int SCHEME_ORDER, class REAL, int DIR>
+struct LSMUpwindHJGradientLoop
+{
+  static void apply(
+    REAL* const grad_phi[], const LSMKernelBox& grad_phi_gb,
+    const REAL* phi, const LSMKernelBox& phi_gb,
+    const REAL* const vel[], const LSMKernelBox& vel_gb,
+    const LSMKernelBox& fillbox, const REAL* dx)
+  {
+    const int s = (DIR == 0) ? 1 : phi_gb.stride(DIR);
+    const REAL inv_dx = REAL(1.0)/dx[DIR];
+    const REAL zero_tol = LSMKernelTraits<REAL>::zeroTol();
+    const int n = fillbox.hi[0] - fillbox.lo[0] + 1;
+
+    for (int k = fillbox.lo[2]; k <= fillbox.hi[2]; k++) {
+      for (int j = fillbox.lo[1]; j <= fillbox.hi[1]; j++) {
+        const REAL* p = phi + phi_gb.offset(fillbox.lo[0], j, k);
+        const REAL* v = vel[DIR] + vel_gb.offset(fillbox.lo[0], j, k);
+        REAL* grad = grad_phi[DIR]
+                   + grad_phi_gb.offset(fillbox.lo[0], j, k);
+        for (int i = 0; i < n; i++) {
+          REAL plus, minus;
+          LSMHJStencil<SCHEME_ORDER,REAL>::compute(
+            p + i, s, inv_dx, plus, minus);
+          grad[i] = (fabs(v[i]) < zero_tol) ? REAL(0)
+                  : ( (v[i] > 0) ? minus : plus );
+        }
+      }
+    }
+
+    LSMUpwindHJGradientLoop<DIM,SCHEME_ORDER,REAL,DIR+1>::apply(
+      grad_phi, grad_phi_gb, phi, phi_gb, vel, vel_gb, fillbox, dx);
+  }
+};
+
+template <int DIM, int SCHEME_ORDER, class REAL>
+struct LSMUpwindHJGradientLoop<DIM,SCHEME_ORDER,REAL,DIM>
+{
+  static void apply(
+    REAL* const*, const LSMKernelBox&,
+    const REAL*, const LSMKernelBox&,
+    const REAL* const*, const LSMKernelBox&,
+    const LSMKernelBox&, const REAL*) {}
+};
+
+
+/*!
+ * lsmComputeUpwindHJGradient() computes the upwind HJ ENO/WENO
+ * approximation to the gradient of phi for the specified velocity
+ * field.  It is equivalent to
+ * LSM{1,2,3}D_UPWIND_HJ_ENO{1,2,3}/LSM{1,2,3}D_UPWIND_HJ_WENO5.
+ *
+ * Arguments:
+ *  - grad_phi (out):  DIM components of upwind grad(phi)
+ *  - phi (in):        phi
+ *  - vel (in):        DIM components of velocity
+ *  - dx (in):         grid spacing (DIM entries)
+ *  - *_gb (in):       ghostboxes of data arrays
+ *  - fillbox (in):    cells where the gradient is computed
+ *
+ * Return value:       none
+ *
+ */
+template <int DIM, int SCHEME_ORDER, class REAL>
+inline void lsmComputeUpwindHJGradient(
+  REAL* const grad_phi[], const LSMKernelBox& grad_phi_gb,
+  const REAL* phi, const LSMKernelBox& phi_gb,
+  const REAL* const vel[], const LSMKernelBox& vel_gb,
+  const LSMKernelBox& fillbox,
+  const REAL* dx)
+{
+  LSMUpwindHJGradientLoop<DIM,SCHEME_ORDER,REAL,0>::apply(
+    grad_phi, grad_phi_gb, phi, phi_gb, vel, vel_gb, fillbox, dx);
+}
+
+
+/*!
+ * lsmComputeAdvectionAndNormalVelLSERHS() sets the right-hand side of
+ * the level set equation to the sum of the advection term (computed
+ * using upwind selection of the plus/minus gradients) and the normal
+ * velocity term (computed using Godunov's method).  It is equivalent
+ * to LSM{1,2,3}D_COMPUTE_ADVECTION_AND_NORMAL_VEL_LSE_RHS.
+ *
+ * Arguments:
+ *  - lse_rhs (out):         right-hand side of level set equation
+ *  - grad_phi_plus (in):    DIM components of grad(phi) in plus direction
+ *  - grad_phi_minus (in):   DIM components of grad(phi) in minus direction
+ *  - vel (in):              DIM components of external velocity (NULL
+ *                           if there is no external velocity)
+ *  - vel_n (in):            normal velocity (NULL if there is no normal
+ *                           velocity)
+ *  - *_gb (in):             ghostboxes of data arrays
+ *  - fillbox (in):          cells where the RHS is computed
+ *
+ * Return value:             none
+ *
+ */
+template <int DIM, class REAL>
+inline void lsmComputeAdvectionAndNormalVelLSERHS(
+  REAL* lse_rhs, const LSMKernelBox& lse_rhs_gb,
+  const REAL* const grad_phi_plus[], const LSMKernelBox& grad_phi_plus_gb,
+  const REAL* const grad_phi_minus[],
+  const LSMKernelBox& grad_phi_minus_gb,
+  const REAL* const vel[], const LSMKernelBox& vel_gb,
+  const REAL* vel_n, const LSMKernelBox& vel_n_gb,
+  const LSMKernelBox& fillbox)
+{
+  const REAL zero_tol = LSMKernelTraits<REAL>::zeroTol();
+  const REAL zero = 0.0;
+
+  for (int k = fillbox.lo[2]; k <= fillbox.hi[2]; k++) {
+    for (int j = fillbox.lo[1]; j <= fillbox.hi[1]; j++) {
+      for (int i = fillbox.lo[0]; i <= fillbox.hi[0]; i++) {
+
+        const int idx_plus = grad_phi_plus_gb.offset(i,j,k);
+        const int idx_minus = grad_phi_minus_gb.offset(i,j,k);
+        REAL rhs_cur = 0.0;
+
+        // advection term
+        if (vel) {
+          const int idx_vel = vel_gb.offset(i,j,k);
+          REAL vel_dot_grad_phi = 0.0;
+          for (int dir = 0; dir < DIM; dir++) {
+            const REAL vel_cur = vel[dir][idx_vel];
+            const REAL phi_cur = (fabs(vel_cur) < zero_tol) ? zero
+              : ( (vel_cur > 0) ? grad_phi_minus[dir][idx_minus]
+                                : grad_phi_plus[dir][idx_plus] );
+            vel_dot_grad_phi = (dir == 0) ? vel_cur*phi_cur
+                             : vel_dot_grad_phi + vel_cur*phi_cur;
+          }
+          rhs_cur = rhs_cur - vel_dot_grad_phi;
+        }
+
+        // normal velocity term
+        if (vel_n) {
+          const REAL vel_n_cur = vel_n[vel_n_gb.offset(i,j,k)];
+          if (fabs(vel_n_cur) >= zero_tol) {
+            REAL norm_grad_phi_sq = 0.0;
+            for (int dir = 0; dir < DIM; dir++) {
+              const REAL plus = grad_phi_plus[dir][idx_plus];
+              const REAL minus = grad_phi_minus[dir][idx_minus];
+              REAL a, b;
+              if (vel_n_cur > zero) {
+                a = (minus > zero) ? minus : zero;
+                b = (plus < zero) ? plus : zero;
+              } else {
+                a = (minus < zero) ? minus : zero;
+                b = (plus > zero) ? plus : zero;
+              }
+              const REAL a_sq = a*a, b_sq = b*b;
+              const REAL max_sq = (a_sq > b_sq) ? a_sq : b_sq;
+              norm_grad_phi_sq = (dir == 0) ? max_sq
+                               : norm_grad_phi_sq + max_sq;
+            }
+            rhs_cur = rhs_cur - vel_n_cur*sqrt(norm_grad_phi_sq);
+          }
+        }
+
+        lse_rhs[lse_rhs_gb.offset(i,j,k)] = rhs_cur;
+      }
+    }
+  }
+}
+
+} // end LSMLIB namespace
+
+#endif
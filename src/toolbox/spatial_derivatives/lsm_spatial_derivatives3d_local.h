@@ -43,6 +43,10 @@ extern "C" {
 #define LSM3D_COMPUTE_AVE_GRAD_PHI_LOCAL lsm3dcomputeavegradphilocal_
 #define LSM3D_GRADIENT_MAGNITUDE_LOCAL   lsm3dgradientmagnitudelocal_
 
+#define LSM3D_HJ_ENO2_LOCAL_LINEAR       lsm3dhjeno2locallinear_
+#define LSM3D_CENTRAL_GRAD_ORDER2_LOCAL_LINEAR  \
+                                         lsm3dcentralgradorder2locallinear_
+
 
 #ifdef __cplusplus
 extern "C" {
@@ -459,7 +463,110 @@ void LSM3D_GRADIENT_MAGNITUDE_LOCAL(
   const int *klo_nb_gb,
   const int *khi_nb_gb,
   const unsigned char *mark_fb);   
-   
+
+
+/*
+ * The _LINEAR variants of the narrow band derivative routines take the
+ * linear offsets of the narrow band points into the data arrays 
+ * (computed by LSM3D_COMPUTE_NARROW_BAND_LINEAR_INDEX()) instead of their
+ * (i,j,k) coordinates.  Neighboring values are loaded at fixed offsets 
+ * from the linear offset of the point.  All arrays (including 
+ * narrow_band) must have the same ghostbox.
+ */
+
+/*!
+*
+*  LSM3D_HJ_ENO2_LOCAL_LINEAR() is identical to LSM3D_HJ_ENO2_LOCAL() 
+*  except that the narrow band points are specified by their linear 
+*  offsets.
+*
+*  Arguments:
+*    phi_*_plus (out):   components of grad(phi) in plus direction 
+*    phi_*_minus (out):  components of grad(phi) in minus direction
+*    phi (in):           phi
+*    D1 (in):            scratch space for holding undivided first-differences
+*    D2 (in):            scratch space for holding undivided second-differences
+*    *_gb (in):          index range for ghostbox
+*    dx, dy, dz (in):    grid spacing
+*    index_lin(in):      linear offsets of local (narrow band) points
+*    n*_index[012](in):  index range of points in index_lin that are in
+*                        level [012] of the narrow band
+*    narrow_band(in):    array that marks voxels outside desired fillbox
+*    mark_*(in):         upper limit narrow band value for voxels in 
+*                        the appropriate fillbox
+*
+*  NOTES:
+*   - index_lin ranges at minimum from nlo_index0 to nhi_index2
+*/
+void LSM3D_HJ_ENO2_LOCAL_LINEAR(
+  LSMLIB_REAL *phi_x_plus,
+  LSMLIB_REAL *phi_y_plus,
+  LSMLIB_REAL *phi_z_plus,
+  LSMLIB_REAL *phi_x_minus,
+  LSMLIB_REAL *phi_y_minus,
+  LSMLIB_REAL *phi_z_minus,
+  const LSMLIB_REAL *phi,
+  LSMLIB_REAL *D1,
+  LSMLIB_REAL *D2,
+  const int *ilo_gb,
+  const int *ihi_gb,
+  const int *jlo_gb,
+  const int *jhi_gb,
+  const int *klo_gb,
+  const int *khi_gb,
+  const LSMLIB_REAL *dx,
+  const LSMLIB_REAL *dy,
+  const LSMLIB_REAL *dz,
+  const int *index_lin,
+  const int *nlo_index0,
+  const int *nhi_index0,
+  const int *nlo_index1,
+  const int *nhi_index1,
+  const int *nlo_index2,
+  const int *nhi_index2,
+  const unsigned char *narrow_band,
+  const unsigned char *mark_fb,
+  const unsigned char *mark_D1,
+  const unsigned char *mark_D2);
+
+/*!
+*
+*  LSM3D_CENTRAL_GRAD_ORDER2_LOCAL_LINEAR() is identical to 
+*  LSM3D_CENTRAL_GRAD_ORDER2_LOCAL() except that the narrow band points 
+*  are specified by their linear offsets.
+*
+*  Arguments:
+*    phi_* (out):      components of grad(phi) 
+*    phi (in):         phi
+*    *_gb (in):        index range for ghostbox
+*    dx, dy, dz (in):  grid spacing
+*    index_lin(in):    linear offsets of local (narrow band) points
+*    n*_index(in):     index range of points to loop over in index_lin
+*    narrow_band(in):  array that marks voxels outside desired fillbox
+*    mark_fb(in):      upper limit narrow band value for voxels in 
+*                      fillbox
+*
+*/
+void LSM3D_CENTRAL_GRAD_ORDER2_LOCAL_LINEAR(
+  LSMLIB_REAL *phi_x,
+  LSMLIB_REAL *phi_y,
+  LSMLIB_REAL *phi_z,
+  const LSMLIB_REAL *phi,
+  const int *ilo_gb,
+  const int *ihi_gb,
+  const int *jlo_gb,
+  const int *jhi_gb,
+  const int *klo_gb,
+  const int *khi_gb,
+  const LSMLIB_REAL *dx,
+  const LSMLIB_REAL *dy,
+  const LSMLIB_REAL *dz,
+  const int *index_lin,
+  const int *nlo_index,
+  const int *nhi_index,
+  const unsigned char *narrow_band,
+  const unsigned char *mark_fb);
+
 
 #ifdef __cplusplus
 }
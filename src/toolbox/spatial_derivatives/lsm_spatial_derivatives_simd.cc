@@ -0,0 +1,643 @@
+/*
+ * File:        lsm_spatial_derivatives_simd.cc
+ * Copyrights:  (c) 2005 The Trustees of Princeton University and Board of
+ *                  Regents of the University of Texas.  All rights reserved.
+ *              (c) 2009 Kevin T. Chu.  All rights reserved.
+ * Revision:    $Revision$
+ * Modified:    $Date$
+ * Description: SIMD versions of the 2D/3D HJ WENO5 routines with runtime
+ *              selection of the instruction set
+ */
+
+#include <stdlib.h>
+
+#include "lsm_spatial_derivatives_simd.h"
+#include "lsm_spatial_derivative_kernels.h"
+
+/*
+ * NOTES:
+ *  - The vector kernels are written using GCC vector extensions and
+ *    compiled for a specific instruction set by calling them from
+ *    functions with the target attribute.  The vector kernels are
+ *    forced inline so that they are compiled for the instruction set of
+ *    the calling function.
+ *  - The vector kernels perform the same operations in the same order
+ *    as LSMHJStencil<5,REAL> (and the Fortran WENO5 kernels).  Floating-
+ *    point contraction (i.e. generation of FMA instructions, which are
+ *    part of AVX-512) is disabled so that the results are identical to
+ *    the scalar results.
+ *  - This file must not depend on the C++ runtime library because
+ *    liblsm_toolbox is also linked into C programs.
+ */
+
+#if defined(LSMLIB_DOUBLE_PRECISION) && defined(__GNUC__) && \
+    (defined(__x86_64__) || defined(__i386__))
+#define LSM_HAVE_X86_SIMD
+#endif
+
+#if defined(__clang__)
+#pragma STDC FP_CONTRACT OFF
+#elif defined(__GNUC__)
+#pragma GCC optimize ("fp-contract=off")
+#endif
+
+#define LSM_FORCE_INLINE inline __attribute__((always_inline))
+
+using namespace LSMLIB;
+
+typedef LSMLIB_REAL REAL;
+
+#ifdef LSM_HAVE_X86_SIMD
+typedef double LSMVec2d __attribute__((vector_size(16)));
+typedef double LSMVec4d __attribute__((vector_size(32)));
+typedef double LSMVec8d __attribute__((vector_size(64)));
+#endif
+
+
+/*============================ Vector kernels ============================*/
+
+/*
+ * lsmLoadDiffVec() loads the divided differences (q[s] - q[0])*inv_dx
+ * for a vector of consecutive grid cells starting at the (possibly
+ * unaligned) address q.
+ *
+ * NOTE: vectors are passed by reference (rather than returned) to avoid
+ *       passing vectors by value in functions that are not compiled
+ *       for a SIMD instruction set.
+ */
+template <class V>
+static LSM_FORCE_INLINE void lsmLoadDiffVec(
+  V& d, const REAL* q, const int s, const REAL inv_dx)
+{
+  V lo, hi;
+  __builtin_memcpy(&lo, q, sizeof(V));
+  __builtin_memcpy(&hi, q + s, sizeof(V));
+  d = (hi - lo)*inv_dx;
+}
+
+/*
+ * lsmWENO5Vec() is the vector version of LSMHJStencil<5,REAL>::weno5().
+ */
+template <class V>
+static LSM_FORCE_INLINE void lsmWENO5Vec(
+  V& result,
+  const V& v1, const V& v2, const V& v3, const V& v4, const V& v5)
+{
+  const REAL one_third = 1.0/3.0;
+  const REAL seven_sixths = 7.0/6.0;
+  const REAL eleven_sixths = 11.0/6.0;
+  const REAL one_sixth = 1.0/6.0;
+  const REAL five_sixths = 5.0/6.0;
+  const REAL thirteen_twelfths = 13.0/12.0;
+  const REAL one_fourth = 0.25;
+
+  // compute eps
+  V max_v_sq = v1*v1;
+  V v_sq;
+  v_sq = v2*v2; max_v_sq = (v_sq > max_v_sq) ? v_sq : max_v_sq;
+  v_sq = v3*v3; max_v_sq = (v_sq > max_v_sq) ? v_sq : max_v_sq;
+  v_sq = v4*v4; max_v_sq = (v_sq > max_v_sq) ? v_sq : max_v_sq;
+  v_sq = v5*v5; max_v_sq = (v_sq > max_v_sq) ? v_sq : max_v_sq;
+  const V eps = REAL(1e-6)*max_v_sq
+              + LSMKernelTraits<REAL>::tinyNonzeroNumber();
+
+  // candidate approximations
+  const V phi_1 = one_third*v1 - seven_sixths*v2 + eleven_sixths*v3;
+  const V phi_2 = -(one_sixth*v2) + five_sixths*v3 + one_third*v4;
+  const V phi_3 = one_third*v3 + five_sixths*v4 - one_sixth*v5;
+
+  // smoothness measures
+  const V t1 = v1 - 2.0*v2 + v3, t2 = v1 - 4.0*v2 + 3.0*v3;
+  const V t3 = v2 - 2.0*v3 + v4, t4 = v2 - v4;
+  const V t5 = v3 - 2.0*v4 + v5, t6 = 3.0*v3 - 4.0*v4 + v5;
+  const V S1 = thirteen_twelfths*(t1*t1) + one_fourth*(t2*t2);
+  const V S2 = thirteen_twelfths*(t3*t3) + one_fourth*(t4*t4);
+  const V S3 = thirteen_twelfths*(t5*t5) + one_fourth*(t6*t6);
+
+  // normalized weights
+  V a1 = REAL(0.1)/((S1+eps)*(S1+eps));
+  V a2 = REAL(0.6)/((S2+eps)*(S2+eps));
+  V a3 = REAL(0.3)/((S3+eps)*(S3+eps));
+  const V inv_sum_a = REAL(1.0)/(a1 + a2 + a3);
+  a1 = a1*inv_sum_a;
+  a2 = a2*inv_sum_a;
+  a3 = a3*inv_sum_a;
+
+  result = a1*phi_1 + a2*phi_2 + a3*phi_3;
+}
+
+/*
+ * lsmHJWENO5Row() computes the plus and minus WENO5 derivatives for
+ * n consecutive grid cells in the x-direction.  s is the stride in the
+ * direction of the derivative.
+ */
+template <class V, int W>
+static LSM_FORCE_INLINE void lsmHJWENO5Row(
+  const REAL* p, const int s, const REAL inv_dx,
+  REAL* plus, REAL* minus, const int n)
+{
+  int i = 0;
+  if (W > 1) {
+    for ( ; i + W <= n; i += W) {
+      const REAL* q = p + i;
+      V d_m2, d_m1, d_0, d_p1, d_p2, d_p3;
+      lsmLoadDiffVec<V>(d_m2, q-3*s, s, inv_dx);
+      lsmLoadDiffVec<V>(d_m1, q-2*s, s, inv_dx);
+      lsmLoadDiffVec<V>(d_0, q-s, s, inv_dx);
+      lsmLoadDiffVec<V>(d_p1, q, s, inv_dx);
+      lsmLoadDiffVec<V>(d_p2, q+s, s, inv_dx);
+      lsmLoadDiffVec<V>(d_p3, q+2*s, s, inv_dx);
+      V plus_vec, minus_vec;
+      lsmWENO5Vec<V>(plus_vec, d_p3, d_p2, d_p1, d_0, d_m1);
+      lsmWENO5Vec<V>(minus_vec, d_m2, d_m1, d_0, d_p1, d_p2);
+      __builtin_memcpy(plus + i, &plus_vec, sizeof(V));
+      __builtin_memcpy(minus + i, &minus_vec, sizeof(V));
+    }
+  }
+
+  // remainder
+  for ( ; i < n; i++) {
+    LSMHJStencil<5,REAL>::compute(p + i, s, inv_dx, plus[i], minus[i]);
+  }
+}
+
+/*
+ * lsmUpwindHJWENO5Row() computes the upwind WENO5 derivative for
+ * n consecutive grid cells in the x-direction.
+ */
+template <class V, int W>
+static LSM_FORCE_INLINE void lsmUpwindHJWENO5Row(
+  const REAL* p, const int s, const REAL inv_dx,
+  const REAL* vel, REAL* grad, const int n)
+{
+  const REAL zero_tol = LSMKernelTraits<REAL>::zeroTol();
+  int i = 0;
+  if (W > 1) {
+    const V zero = V();
+    for ( ; i + W <= n; i += W) {
+      const REAL* q = p + i;
+      V d_m2, d_m1, d_0, d_p1, d_p2, d_p3;
+      lsmLoadDiffVec<V>(d_m2, q-3*s, s, inv_dx);
+      lsmLoadDiffVec<V>(d_m1, q-2*s, s, inv_dx);
+      lsmLoadDiffVec<V>(d_0, q-s, s, inv_dx);
+      lsmLoadDiffVec<V>(d_p1, q, s, inv_dx);
+      lsmLoadDiffVec<V>(d_p2, q+s, s, inv_dx);
+      lsmLoadDiffVec<V>(d_p3, q+2*s, s, inv_dx);
+      V plus, minus, v;
+      lsmWENO5Vec<V>(plus, d_p3, d_p2, d_p1, d_0, d_m1);
+      lsmWENO5Vec<V>(minus, d_m2, d_m1, d_0, d_p1, d_p2);
+      __builtin_memcpy(&v, vel + i, sizeof(V));
+      const V abs_v = (v < zero) ? -v : v;
+      const V upwind = (v > zero) ? minus : plus;
+      const V grad_vec = (abs_v < zero_tol) ? zero : upwind;
+      __builtin_memcpy(grad + i, &grad_vec, sizeof(V));
+    }
+  }
+
+  // remainder
+  for ( ; i < n; i++) {
+    REAL plus, minus;
+    LSMHJStencil<5,REAL>::compute(p + i, s, inv_dx, plus, minus);
+    grad[i] = (fabs(vel[i]) < zero_tol) ? REAL(0)
+            : ( (vel[i] > 0) ? minus : plus );
+  }
+}
+
+/*
+ * lsmHJWENO5Box() computes the plus and minus WENO5 derivatives on
+ * the fillbox.  The x-direction row kernel is called with a constant
+ * stride so that the compiler can simplify the x-direction loads.
+ */
+template <class V, int W>
+static LSM_FORCE_INLINE void lsmHJWENO5Box(
+  REAL* const grad_phi_plus[], const LSMKernelBox& grad_phi_plus_gb,
+  REAL* const grad_phi_minus[], const LSMKernelBox& grad_phi_minus_gb,
+  const REAL* phi, const LSMKernelBox& phi_gb,
+  const LSMKernelBox& fillbox, const REAL* dx, const int num_dims)
+{
+  const int n = fillbox.hi[0] - fillbox.lo[0] + 1;
+  for (int dir = 0; dir < num_dims; dir++) {
+    const int s = phi_gb.stride(dir);
+    const REAL inv_dx = REAL(1.0)/dx[dir];
+    for (int k = fillbox.lo[2]; k <= fillbox.hi[2]; k++) {
+      for (int j = fillbox.lo[1]; j <= fillbox.hi[1]; j++) {
+        const REAL* p = phi + phi_gb.offset(fillbox.lo[0], j, k);
+        REAL* plus = grad_phi_plus[dir]
+                   + grad_phi_plus_gb.offset(fillbox.lo[0], j, k);
+        REAL* minus = grad_phi_minus[dir]
+                    + grad_phi_minus_gb.offset(fillbox.lo[0], j, k);
+        if (dir == 0) {
+          lsmHJWENO5Row<V,W>(p, 1, inv_dx, plus, minus, n);
+        } else {
+          lsmHJWENO5Row<V,W>(p, s, inv_dx, plus, minus, n);
+        }
+      }
+    }
+  }
+}
+
+/*
+ * lsmUpwindHJWENO5Box() computes the upwind WENO5 derivatives on
+ * the fillbox.
+ */
+template <class V, int W>
+static LSM_FORCE_INLINE void lsmUpwindHJWENO5Box(
+  REAL* const grad_phi[], const LSMKernelBox& grad_phi_gb,
+  const REAL* phi, const LSMKernelBox& phi_gb,
+  const REAL* const vel[], const LSMKernelBox& vel_gb,
+  const LSMKernelBox& fillbox, const REAL* dx, const int num_dims)
+{
+  const int n = fillbox.hi[0] - fillbox.lo[0] + 1;
+  for (int dir = 0; dir < num_dims; dir++) {
+    const int s = phi_gb.stride(dir);
+    const REAL inv_dx = REAL(1.0)/dx[dir];
+    for (int k = fillbox.lo[2]; k <= fillbox.hi[2]; k++) {
+      for (int j = fillbox.lo[1]; j <= fillbox.hi[1]; j++) {
+        const REAL* p = phi + phi_gb.offset(fillbox.lo[0], j, k);
+        const REAL* v = vel[dir] + vel_gb.offset(fillbox.lo[0], j, k);
+        REAL* grad = grad_phi[dir]
+                   + grad_phi_gb.offset(fillbox.lo[0], j, k);
+        if (dir == 0) {
+          lsmUpwindHJWENO5Row<V,W>(p, 1, inv_dx, v, grad, n);
+        } else {
+          lsmUpwindHJWENO5Row<V,W>(p, s, inv_dx, v, grad, n);
+        }
+      }
+    }
+  }
+}
+
+
+/*================ Instruction set specific implementations ===============*/
+
+#define LSM_HJ_WENO5_BOX_ARGS                                              \
+  REAL* const grad_phi_plus[], const LSMKernelBox& grad_phi_plus_gb,      \
+  REAL* const grad_phi_minus[], const LSMKernelBox& grad_phi_minus_gb,    \
+  const REAL* phi, const LSMKernelBox& phi_gb,                            \
+  const LSMKernelBox& fillbox, const REAL* dx, const int num_dims
+
+#define LSM_HJ_WENO5_BOX_CALL                                              \
+  grad_phi_plus, grad_phi_plus_gb, grad_phi_minus, grad_phi_minus_gb,     \
+  phi, phi_gb, fillbox, dx, num_dims
+
+#define LSM_UPWIND_HJ_WENO5_BOX_ARGS                                       \
+  REAL* const grad_phi[], const LSMKernelBox& grad_phi_gb,                \
+  const REAL* phi, const LSMKernelBox& phi_gb,                            \
+  const REAL* const vel[], const LSMKernelBox& vel_gb,                    \
+  const LSMKernelBox& fillbox, const REAL* dx, const int num_dims
+
+#define LSM_UPWIND_HJ_WENO5_BOX_CALL                                       \
+  grad_phi, grad_phi_gb, phi, phi_gb, vel, vel_gb, fillbox, dx, num_dims
+
+static void lsmHJWENO5Scalar(LSM_HJ_WENO5_BOX_ARGS)
+{
+  lsmHJWENO5Box<REAL,1>(LSM_HJ_WENO5_BOX_CALL);
+}
+
+static void lsmUpwindHJWENO5Scalar(LSM_UPWIND_HJ_WENO5_BOX_ARGS)
+{
+  lsmUpwindHJWENO5Box<REAL,1>(LSM_UPWIND_HJ_WENO5_BOX_CALL);
+}
+
+#if defined(LSM_HAVE_X86_SIMD) && defined(__SSE2__)
+
+static void lsmHJWENO5SSE2(LSM_HJ_WENO5_BOX_ARGS)
+{
+  lsmHJWENO5Box<LSMVec2d,2>(LSM_HJ_WENO5_BOX_CALL);
+}
+
+static void lsmUpwindHJWENO5SSE2(LSM_UPWIND_HJ_WENO5_BOX_ARGS)
+{
+  lsmUpwindHJWENO5Box<LSMVec2d,2>(LSM_UPWIND_HJ_WENO5_BOX_CALL);
+}
+
+#endif
+
+#ifdef LSM_HAVE_X86_SIMD
+
+__attribute__((target("avx2")))
+static void lsmHJWENO5AVX2(LSM_HJ_WENO5_BOX_ARGS)
+{
+  lsmHJWENO5Box<LSMVec4d,4>(LSM_HJ_WENO5_BOX_CALL);
+}
+
+__attribute__((target("avx2")))
+static void lsmUpwindHJWENO5AVX2(LSM_UPWIND_HJ_WENO5_BOX_ARGS)
+{
+  lsmUpwindHJWENO5Box<LSMVec4d,4>(LSM_UPWIND_HJ_WENO5_BOX_CALL);
+}
+
+__attribute__((target("avx512f")))
+static void lsmHJWENO5AVX512(LSM_HJ_WENO5_BOX_ARGS)
+{
+  lsmHJWENO5Box<LSMVec8d,8>(LSM_HJ_WENO5_BOX_CALL);
+}
+
+__attribute__((target("avx512f")))
+static void lsmUpwindHJWENO5AVX512(LSM_UPWIND_HJ_WENO5_BOX_ARGS)
+{
+  lsmUpwindHJWENO5Box<LSMVec8d,8>(LSM_UPWIND_HJ_WENO5_BOX_CALL);
+}
+
+#endif
+
+
+/*========================= Runtime dispatch ==============================*/
+
+/*
+ * s_simd_width caches the SIMD width selected for the current CPU
+ * (0 = not yet selected).  Concurrent initialization from several
+ * threads is harmless because every thread selects the same value.
+ */
+static int s_simd_width = 0;
+
+int LSM_HJ_WENO5_SIMD_WIDTH(void)
+{
+  if (s_simd_width == 0) {
+    int width = 1;
+#ifdef LSM_HAVE_X86_SIMD
+    if (!getenv("LSMLIB_DISABLE_SIMD")) {
+#ifdef __SSE2__
+      width = 2;
+#endif
+      __builtin_cpu_init();
+      if (__builtin_cpu_supports("avx512f")) {
+        width = 8;
+      } else if (__builtin_cpu_supports("avx2")) {
+        width = 4;
+      }
+    }
+#endif
+    s_simd_width = width;
+  }
+  return s_simd_width;
+}
+
+static void lsmHJWENO5Dispatch(LSM_HJ_WENO5_BOX_ARGS)
+{
+  switch (LSM_HJ_WENO5_SIMD_WIDTH()) {
+#ifdef LSM_HAVE_X86_SIMD
+    case 8: lsmHJWENO5AVX512(LSM_HJ_WENO5_BOX_CALL); break;
+    case 4: lsmHJWENO5AVX2(LSM_HJ_WENO5_BOX_CALL); break;
+#endif
+#if defined(LSM_HAVE_X86_SIMD) && defined(__SSE2__)
+    case 2: lsmHJWENO5SSE2(LSM_HJ_WENO5_BOX_CALL); break;
+#endif
+    default: lsmHJWENO5Scalar(LSM_HJ_WENO5_BOX_CALL);
+  }
+}
+
+static void lsmUpwindHJWENO5Dispatch(LSM_UPWIND_HJ_WENO5_BOX_ARGS)
+{
+  switch (LSM_HJ_WENO5_SIMD_WIDTH()) {
+#ifdef LSM_HAVE_X86_SIMD
+    case 8: lsmUpwindHJWENO5AVX512(LSM_UPWIND_HJ_WENO5_BOX_CALL); break;
+    case 4: lsmUpwindHJWENO5AVX2(LSM_UPWIND_HJ_WENO5_BOX_CALL); break;
+#endif
+#if defined(LSM_HAVE_X86_SIMD) && defined(__SSE2__)
+    case 2: lsmUpwindHJWENO5SSE2(LSM_UPWIND_HJ_WENO5_BOX_CALL); break;
+#endif
+    default: lsmUpwindHJWENO5Scalar(LSM_UPWIND_HJ_WENO5_BOX_CALL);
+  }
+}
+
+/* lsmMakeBox() creates a LSMKernelBox from Fortran-style index ranges */
+static LSMKernelBox lsmMakeBox(
+  const int *ilo, const int *ihi,
+  const int *jlo, const int *jhi,
+  const int *klo, const int *khi)
+{
+  LSMKernelBox box;
+  box.lo[0] = *ilo; box.hi[0] = *ihi;
+  box.lo[1] = *jlo; box.hi[1] = *jhi;
+  if (klo) { box.lo[2] = *klo; box.hi[2] = *khi; }
+  return box;
+}
+
+
+/*=========================== C interface =================================*/
+
+extern "C" {
+
+void LSM2D_HJ_WENO5_SIMD(
+  LSMLIB_REAL *phi_x_plus,
+  LSMLIB_REAL *phi_y_plus,
+  const int *ilo_grad_phi_plus_gb,
+  const int *ihi_grad_phi_plus_gb,
+  const int *jlo_grad_phi_plus_gb,
+  const int *jhi_grad_phi_plus_gb,
+  LSMLIB_REAL *phi_x_minus,
+  LSMLIB_REAL *phi_y_minus,
+  const int *ilo_grad_phi_minus_gb,
+  const int *ihi_grad_phi_minus_gb,
+  const int *jlo_grad_phi_minus_gb,
+  const int *jhi_grad_phi_minus_gb,
+  const LSMLIB_REAL *phi,
+  const int *ilo_phi_gb,
+  const int *ihi_phi_gb,
+  const int *jlo_phi_gb,
+  const int *jhi_phi_gb,
+  LSMLIB_REAL *D1,
+  const int *ilo_D1_gb,
+  const int *ihi_D1_gb,
+  const int *jlo_D1_gb,
+  const int *jhi_D1_gb,
+  const int *ilo_fb,
+  const int *ihi_fb,
+  const int *jlo_fb,
+  const int *jhi_fb,
+  const LSMLIB_REAL *dx,
+  const LSMLIB_REAL *dy)
+{
+  REAL* const grad_phi_plus[2] = {phi_x_plus, phi_y_plus};
+  REAL* const grad_phi_minus[2] = {phi_x_minus, phi_y_minus};
+  const REAL dx_all[2] = {*dx, *dy};
+
+  lsmHJWENO5Dispatch(
+    grad_phi_plus,
+    lsmMakeBox(ilo_grad_phi_plus_gb, ihi_grad_phi_plus_gb,
+               jlo_grad_phi_plus_gb, jhi_grad_phi_plus_gb, 0, 0),
+    grad_phi_minus,
+    lsmMakeBox(ilo_grad_phi_minus_gb, ihi_grad_phi_minus_gb,
+               jlo_grad_phi_minus_gb, jhi_grad_phi_minus_gb, 0, 0),
+    phi,
+    lsmMakeBox(ilo_phi_gb, ihi_phi_gb, jlo_phi_gb, jhi_phi_gb, 0, 0),
+    lsmMakeBox(ilo_fb, ihi_fb, jlo_fb, jhi_fb, 0, 0),
+    dx_all, 2);
+}
+
+
+void LSM3D_HJ_WENO5_SIMD(
+  LSMLIB_REAL *phi_x_plus,
+  LSMLIB_REAL *phi_y_plus,
+  LSMLIB_REAL *phi_z_plus,
+  const int *ilo_grad_phi_plus_gb,
+  const int *ihi_grad_phi_plus_gb,
+  const int *jlo_grad_phi_plus_gb,
+  const int *jhi_grad_phi_plus_gb,
+  const int *klo_grad_phi_plus_gb,
+  const int *khi_grad_phi_plus_gb,
+  LSMLIB_REAL *phi_x_minus,
+  LSMLIB_REAL *phi_y_minus,
+  LSMLIB_REAL *phi_z_minus,
+  const int *ilo_grad_phi_minus_gb,
+  const int *ihi_grad_phi_minus_gb,
+  const int *jlo_grad_phi_minus_gb,
+  const int *jhi_grad_phi_minus_gb,
+  const int *klo_grad_phi_minus_gb,
+  const int *khi_grad_phi_minus_gb,
+  const LSMLIB_REAL *phi,
+  const int *ilo_phi_gb,
+  const int *ihi_phi_gb,
+  const int *jlo_phi_gb,
+  const int *jhi_phi_gb,
+  const int *klo_phi_gb,
+  const int *khi_phi_gb,
+  LSMLIB_REAL *D1,
+  const int *ilo_D1_gb,
+  const int *ihi_D1_gb,
+  const int *jlo_D1_gb,
+  const int *jhi_D1_gb,
+  const int *klo_D1_gb,
+  const int *khi_D1_gb,
+  const int *ilo_fb,
+  const int *ihi_fb,
+  const int *jlo_fb,
+  const int *jhi_fb,
+  const int *klo_fb,
+  const int *khi_fb,
+  const LSMLIB_REAL *dx,
+  const LSMLIB_REAL *dy,
+  const LSMLIB_REAL *dz)
+{
+  REAL* const grad_phi_plus[3] = {phi_x_plus, phi_y_plus, phi_z_plus};
+  REAL* const grad_phi_minus[3] = {phi_x_minus, phi_y_minus, phi_z_minus};
+  const REAL dx_all[3] = {*dx, *dy, *dz};
+
+  lsmHJWENO5Dispatch(
+    grad_phi_plus,
+    lsmMakeBox(ilo_grad_phi_plus_gb, ihi_grad_phi_plus_gb,
+               jlo_grad_phi_plus_gb, jhi_grad_phi_plus_gb,
+               klo_grad_phi_plus_gb, khi_grad_phi_plus_gb),
+    grad_phi_minus,
+    lsmMakeBox(ilo_grad_phi_minus_gb, ihi_grad_phi_minus_gb,
+               jlo_grad_phi_minus_gb, jhi_grad_phi_minus_gb,
+               klo_grad_phi_minus_gb, khi_grad_phi_minus_gb),
+    phi,
+    lsmMakeBox(ilo_phi_gb, ihi_phi_gb, jlo_phi_gb, jhi_phi_gb,
+               klo_phi_gb, khi_phi_gb),
+    lsmMakeBox(ilo_fb, ihi_fb, jlo_fb, jhi_fb, klo_fb, khi_fb),
+    dx_all, 3);
+}
+
+
+void LSM2D_UPWIND_HJ_WENO5_SIMD(
+  LSMLIB_REAL *phi_x,
+  LSMLIB_REAL *phi_y,
+  const int *ilo_grad_phi_gb,
+  const int *ihi_grad_phi_gb,
+  const int *jlo_grad_phi_gb,
+  const int *jhi_grad_phi_gb,
+  const LSMLIB_REAL *phi,
+  const int *ilo_phi_gb,
+  const int *ihi_phi_gb,
+  const int *jlo_phi_gb,
+  const int *jhi_phi_gb,
+  const LSMLIB_REAL *vel_x,
+  const LSMLIB_REAL *vel_y,
+  const int *ilo_vel_gb,
+  const int *ihi_vel_gb,
+  const int *jlo_vel_gb,
+  const int *jhi_vel_gb,
+  LSMLIB_REAL *D1,
+  const int *ilo_D1_gb,
+  const int *ihi_D1_gb,
+  const int *jlo_D1_gb,
+  const int *jhi_D1_gb,
+  const int *ilo_fb,
+  const int *ihi_fb,
+  const int *jlo_fb,
+  const int *jhi_fb,
+  const LSMLIB_REAL *dx,
+  const LSMLIB_REAL *dy)
+{
+  REAL* const grad_phi[2] = {phi_x, phi_y};
+  const REAL* const vel[2] = {vel_x, vel_y};
+  const REAL dx_all[2] = {*dx, *dy};
+
+  lsmUpwindHJWENO5Dispatch(
+    grad_phi,
+    lsmMakeBox(ilo_grad_phi_gb, ihi_grad_phi_gb,
+               jlo_grad_phi_gb, jhi_grad_phi_gb, 0, 0),
+    phi,
+    lsmMakeBox(ilo_phi_gb, ihi_phi_gb, jlo_phi_gb, jhi_phi_gb, 0, 0),
+    vel,
+    lsmMakeBox(ilo_vel_gb, ihi_vel_gb, jlo_vel_gb, jhi_vel_gb, 0, 0),
+    lsmMakeBox(ilo_fb, ihi_fb, jlo_fb, jhi_fb, 0, 0),
+    dx_all, 2);
+}
+
+
+void LSM3D_UPWIND_HJ_WENO5_SIMD(
+  LSMLIB_REAL *phi_x,
+  LSMLIB_REAL *phi_y,
+  LSMLIB_REAL *phi_z,
+  const int *ilo_grad_phi_gb,
+  const int *ihi_grad_phi_gb,
+  const int *jlo_grad_phi_gb,
+  const int *jhi_grad_phi_gb,
+  const int *klo_grad_phi_gb,
+  const int *khi_grad_phi_gb,
+  const LSMLIB_REAL *phi,
+  const int *ilo_phi_gb,
+  const int *ihi_phi_gb,
+  const int *jlo_phi_gb,
+  const int *jhi_phi_gb,
+  const int *klo_phi_gb,
+  const int *khi_phi_gb,
+  const LSMLIB_REAL *vel_x,
+  const LSMLIB_REAL *vel_y,
+  const LSMLIB_REAL *vel_z,
+  const int *ilo_vel_gb,
+  const int *ihi_vel_gb,
+  const int *jlo_vel_gb,
+  const int *jhi_vel_gb,
+  const int *klo_vel_gb,
+  const int *khi_vel_gb,
+  LSMLIB_REAL *D1,
+  const int *ilo_D1_gb,
+  const int *ihi_D1_gb,
+  const int *jlo_D1_gb,
+  const int *jhi_D1_gb,
+  const int *klo_D1_gb,
+  const int *khi_D1_gb,
+  const int *ilo_fb,
+  const int *ihi_fb,
+  const int *jlo_fb,
+  const int *jhi_fb,
+  const int *klo_fb,
+  const int *khi_fb,
+  const LSMLIB_REAL *dx,
+  const LSMLIB_REAL *dy,
+  const LSMLIB_REAL *dz)
+{
+  REAL* const grad_phi[3] = {phi_x, phi_y, phi_z};
+  const REAL* const vel[3] = {vel_x, vel_y, vel_z};
+  const REAL dx_all[3] = {*dx, *dy, *dz};
+
+  lsmUpwindHJWENO5Dispatch(
+    grad_phi,
+    lsmMakeBox(ilo_grad_phi_gb, ihi_grad_phi_gb,
+               jlo_grad_phi_gb, jhi_grad_phi_gb,
+               klo_grad_phi_gb, khi_grad_phi_gb),
+    phi,
+    lsmMakeBox(ilo_phi_gb, ihi_phi_gb, jlo_phi_gb, jhi_phi_gb,
+               klo_phi_gb, khi_phi_gb),
+    vel,
+    lsmMakeBox(ilo_vel_gb, ihi_vel_gb, jlo_vel_gb, jhi_vel_gb,
+               klo_vel_gb, khi_vel_gb),
+    lsmMakeBox(ilo_fb, ihi_fb, jlo_fb, jhi_fb, klo_fb, khi_fb),
+    dx_all, 3);
+}
+
+} // end extern "C"
@@ -0,0 +1,261 @@
+/*
+ * File:        lsm_spatial_derivatives_simd.h
+ * Copyrights:  (c) 2005 The Trustees of Princeton University and Board of
+ *                  Regents of the University of Texas.  All rights reserved.
+ *              (c) 2009 Kevin T. Chu.  All rights reserved.
+ * Revision:    $Revision$
+ * Modified:    $Date$
+ * Description: Header file for SIMD versions of the 2D/3D HJ WENO5 routines
+ */
+
+#ifndef INCLUDED_LSM_SPATIAL_DERIVATIVES_SIMD_H
+#define INCLUDED_LSM_SPATIAL_DERIVATIVES_SIMD_H
+
+#include "LSMLIB_config.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*! \file lsm_spatial_derivatives_simd.h
+ *
+ * \brief
+ * @ref lsm_spatial_derivatives_simd.h provides explicitly vectorized
+ * versions of the 2D and 3D HJ WENO5 plus/minus and upwind derivative
+ * routines.
+ *
+ * The instruction set is selected at runtime from the features of the
+ * CPU:  AVX-512 (8 doubles per vector), AVX2 (4 doubles per vector),
+ * SSE2 (2 doubles per vector) or a scalar fallback.  The SIMD routines
+ * produce the same results (bit for bit) as LSM2D_HJ_WENO5,
+ * LSM3D_HJ_WENO5, LSM2D_UPWIND_HJ_WENO5 and LSM3D_UPWIND_HJ_WENO5, and
+ * have the same argument lists, so calls to the Fortran routines can be
+ * replaced by calls to the SIMD routines without any other changes.
+ *
+ * NOTES:
+ *  - The SIMD code paths are only available when LSMLIB is compiled
+ *    with GCC-compatible compilers on x86 processors and
+ *    LSMLIB_REAL is double.  Otherwise, the scalar fallback is used.
+ *  - Setting the environment variable LSMLIB_DISABLE_SIMD forces the
+ *    scalar fallback.
+ *  - The D1 scratch space is not used by the SIMD routines.  It is
+ *    kept in the argument lists so that the SIMD routines are drop-in
+ *    replacements for the Fortran routines.
+ *
+ */
+
+
+/* Link between C/C++ names and implementation names
+ *
+ *      name in                      name of
+ *      C/C++ code                   implementation
+ *      ----------                   --------------
+ */
+#define LSM2D_HJ_WENO5_SIMD          lsm2dHJWENO5SIMD
+#define LSM3D_HJ_WENO5_SIMD          lsm3dHJWENO5SIMD
+#define LSM2D_UPWIND_HJ_WENO5_SIMD   lsm2dUpwindHJWENO5SIMD
+#define LSM3D_UPWIND_HJ_WENO5_SIMD   lsm3dUpwindHJWENO5SIMD
+#define LSM_HJ_WENO5_SIMD_WIDTH      lsmHJWENO5SIMDWidth
+
+
+/*!
+ * LSM2D_HJ_WENO5_SIMD() is the SIMD version of LSM2D_HJ_WENO5().
+ *
+ * Arguments:  same as LSM2D_HJ_WENO5()
+ *
+ * Return value:  none
+ *
+ */
+void LSM2D_HJ_WENO5_SIMD(
+  LSMLIB_REAL *phi_x_plus,
+  LSMLIB_REAL *phi_y_plus,
+  const int *ilo_grad_phi_plus_gb,
+  const int *ihi_grad_phi_plus_gb,
+  const int *jlo_grad_phi_plus_gb,
+  const int *jhi_grad_phi_plus_gb,
+  LSMLIB_REAL *phi_x_minus,
+  LSMLIB_REAL *phi_y_minus,
+  const int *ilo_grad_phi_minus_gb,
+  const int *ihi_grad_phi_minus_gb,
+  const int *jlo_grad_phi_minus_gb,
+  const int *jhi_grad_phi_minus_gb,
+  const LSMLIB_REAL *phi,
+  const int *ilo_phi_gb,
+  const int *ihi_phi_gb,
+  const int *jlo_phi_gb,
+  const int *jhi_phi_gb,
+  LSMLIB_REAL *D1,
+  const int *ilo_D1_gb,
+  const int *ihi_D1_gb,
+  const int *jlo_D1_gb,
+  const int *jhi_D1_gb,
+  const int *ilo_fb,
+  const int *ihi_fb,
+  const int *jlo_fb,
+  const int *jhi_fb,
+  const LSMLIB_REAL *dx,
+  const LSMLIB_REAL *dy);
+
+
+/*!
+ * LSM3D_HJ_WENO5_SIMD() is the SIMD version of LSM3D_HJ_WENO5().
+ *
+ * Arguments:  same as LSM3D_HJ_WENO5()
+ *
+ * Return value:  none
+ *
+ */
+void LSM3D_HJ_WENO5_SIMD(
+  LSMLIB_REAL *phi_x_plus,
+  LSMLIB_REAL *phi_y_plus,
+  LSMLIB_REAL *phi_z_plus,
+  const int *ilo_grad_phi_plus_gb,
+  const int *ihi_grad_phi_plus_gb,
+  const int *jlo_grad_phi_plus_gb,
+  const int *jhi_grad_phi_plus_gb,
+  const int *klo_grad_phi_plus_gb,
+  const int *khi_grad_phi_plus_gb,
+  LSMLIB_REAL *phi_x_minus,
+  LSMLIB_REAL *phi_y_minus,
+  LSMLIB_REAL *phi_z_minus,
+  const int *ilo_grad_phi_minus_gb,
+  const int *ihi_grad_phi_minus_gb,
+  const int *jlo_grad_phi_minus_gb,
+  const int *jhi_grad_phi_minus_gb,
+  const int *klo_grad_phi_minus_gb,
+  const int *khi_grad_phi_minus_gb,
+  const LSMLIB_REAL *phi,
+  const int *ilo_phi_gb,
+  const int *ihi_phi_gb,
+  const int *jlo_phi_gb,
+  const int *jhi_phi_gb,
+  const int *klo_phi_gb,
+  const int *khi_phi_gb,
+  LSMLIB_REAL *D1,
+  const int *ilo_D1_gb,
+  const int *ihi_D1_gb,
+  const int *jlo_D1_gb,
+  const int *jhi_D1_gb,
+  const int *klo_D1_gb,
+  const int *khi_D1_gb,
+  const int *ilo_fb,
+  const int *ihi_fb,
+  const int *jlo_fb,
+  const int *jhi_fb,
+  const int *klo_fb,
+  const int *khi_fb,
+  const LSMLIB_REAL *dx,
+  const LSMLIB_REAL *dy,
+  const LSMLIB_REAL *dz);
+
+
+/*!
+ * LSM2D_UPWIND_HJ_WENO5_SIMD() is the SIMD version of
+ * LSM2D_UPWIND_HJ_WENO5().
+ *
+ * Arguments:  same as LSM2D_UPWIND_HJ_WENO5()
+ *
+ * Return value:  none
+ *
+ */
+void LSM2D_UPWIND_HJ_WENO5_SIMD(
+  LSMLIB_REAL *phi_x,
+  LSMLIB_REAL *phi_y,
+  const int *ilo_grad_phi_gb,
+  const int *ihi_grad_phi_gb,
+  const int *jlo_grad_phi_gb,
+  const int *jhi_grad_phi_gb,
+  const LSMLIB_REAL *phi,
+  const int *ilo_phi_gb,
+  const int *ihi_phi_gb,
+  const int *jlo_phi_gb,
+  const int *jhi_phi_gb,
+  const LSMLIB_REAL *vel_x,
+  const LSMLIB_REAL *vel_y,
+  const int *ilo_vel_gb,
+  const int *ihi_vel_gb,
+  const int *jlo_vel_gb,
+  const int *jhi_vel_gb,
+  LSMLIB_REAL *D1,
+  const int *ilo_D1_gb,
+  const int *ihi_D1_gb,
+  const int *jlo_D1_gb,
+  const int *jhi_D1_gb,
+  const int *ilo_fb,
+  const int *ihi_fb,
+  const int *jlo_fb,
+  const int *jhi_fb,
+  const LSMLIB_REAL *dx,
+  const LSMLIB_REAL *dy);
+
+
+/*!
+ * LSM3D_UPWIND_HJ_WENO5_SIMD() is the SIMD version of
+ * LSM3D_UPWIND_HJ_WENO5().
+ *
+ * Arguments:  same as LSM3D_UPWIND_HJ_WENO5()
+ *
+ * Return value:  none
+ *
+ */
+void LSM3D_UPWIND_HJ_WENO5_SIMD(
+  LSMLIB_REAL *phi_x,
+  LSMLIB_REAL *phi_y,
+  LSMLIB_REAL *phi_z,
+  const int *ilo_grad_phi_gb,
+  const int *ihi_grad_phi_gb,
+  const int *jlo_grad_phi_gb,
+  const int *jhi_grad_phi_gb,
+  const int *klo_grad_phi_gb,
+  const int *khi_grad_phi_gb,
+  const LSMLIB_REAL *phi,
+  const int *ilo_phi_gb,
+  const int *ihi_phi_gb,
+  const int *jlo_phi_gb,
+  const int *jhi_phi_gb,
+  const int *klo_phi_gb,
+  const int *khi_phi_gb,
+  const LSMLIB_REAL *vel_x,
+  const LSMLIB_REAL *vel_y,
+  const LSMLIB_REAL *vel_z,
+  const int *ilo_vel_gb,
+  const int *ihi_vel_gb,
+  const int *jlo_vel_gb,
+  const int *jhi_vel_gb,
+  const int *klo_vel_gb,
+  const int *khi_vel_gb,
+  LSMLIB_REAL *D1,
+  const int *ilo_D1_gb,
+  const int *ihi_D1_gb,
+  const int *jlo_D1_gb,
+  const int *jhi_D1_gb,
+  const int *klo_D1_gb,
+  const int *khi_D1_gb,
+  const int *ilo_fb,
+  const int *ihi_fb,
+  const int *jlo_fb,
+  const int *jhi_fb,
+  const int *klo_fb,
+  const int *khi_fb,
+  const LSMLIB_REAL *dx,
+  const LSMLIB_REAL *dy,
+  const LSMLIB_REAL *dz);
+
+
+/*!
+ * LSM_HJ_WENO5_SIMD_WIDTH() returns the number of grid cells processed
+ * per vector instruction by the SIMD routines on the current CPU.
+ *
+ * Arguments:     none
+ *
+ * Return value:  8 (AVX-512), 4 (AVX2), 2 (SSE2) or 1 (scalar
+ *                fallback)
+ *
+ */
+int LSM_HJ_WENO5_SIMD_WIDTH(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
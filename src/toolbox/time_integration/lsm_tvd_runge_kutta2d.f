@@ -420,3 +420,196 @@ c     } end loop over grid
       end
 c } end subroutine
 c***********************************************************************
+
+c***********************************************************************
+c
+c  lsm2dLowStorageTVDRK2Stage2() completes advancing the solution
+c  through a single step of the second-order TVD Runge-Kutta method
+c  by overwriting u_cur with u(t_cur+dt).
+c  
+c  Arguments:
+c    u_cur (in/out):  u(t_cur) on input; u(t_cur+dt) on output
+c    u_stage1 (in):   u_approx(t_cur+dt)
+c    rhs (in):        right-hand side of time evolution equation
+c    dt (in):         step size
+c    *_gb (in):       index range for ghostbox
+c    *_fb (in):       index range for fillbox
+c
+c***********************************************************************
+      subroutine lsm2dLowStorageTVDRK2Stage2(
+     &  u_cur,
+     &  ilo_u_cur_gb, ihi_u_cur_gb,
+     &  jlo_u_cur_gb, jhi_u_cur_gb,
+     &  u_stage1,
+     &  ilo_u_stage1_gb, ihi_u_stage1_gb,
+     &  jlo_u_stage1_gb, jhi_u_stage1_gb,
+     &  rhs,
+     &  ilo_rhs_gb, ihi_rhs_gb,
+     &  jlo_rhs_gb, jhi_rhs_gb,
+     &  ilo_fb, ihi_fb, jlo_fb, jhi_fb,
+     &  dt)
+c***********************************************************************
+c { begin subroutine
+      implicit none
+
+      integer ilo_u_cur_gb, ihi_u_cur_gb
+      integer jlo_u_cur_gb, jhi_u_cur_gb
+      integer ilo_u_stage1_gb, ihi_u_stage1_gb
+      integer jlo_u_stage1_gb, jhi_u_stage1_gb
+      integer ilo_rhs_gb, ihi_rhs_gb
+      integer jlo_rhs_gb, jhi_rhs_gb
+      integer ilo_fb, ihi_fb, jlo_fb, jhi_fb
+      real u_cur(ilo_u_cur_gb:ihi_u_cur_gb,
+     &                       jlo_u_cur_gb:jhi_u_cur_gb)
+      real u_stage1(ilo_u_stage1_gb:ihi_u_stage1_gb,
+     &                          jlo_u_stage1_gb:jhi_u_stage1_gb)
+      real rhs(ilo_rhs_gb:ihi_rhs_gb,
+     &                     jlo_rhs_gb:jhi_rhs_gb)
+      integer i, j
+      real dt
+
+c     { begin loop over grid
+      do j=jlo_fb,jhi_fb
+        do i=ilo_fb,ihi_fb
+
+          u_cur(i,j) = 0.5d0*( u_cur(i,j)
+     &                       + u_stage1(i,j) + dt*rhs(i,j) )
+
+        enddo
+      enddo
+c     } end loop over grid
+
+      return
+      end
+c } end subroutine
+c***********************************************************************
+
+c***********************************************************************
+c
+c  lsm2dLowStorageTVDRK3Stage2() advances the solution through the
+c  second stage of the third-order TVD Runge-Kutta method by
+c  overwriting the first stage solution in u_stage.
+c  
+c  Arguments:
+c    u_stage (in/out):  u_approx(t_cur+dt) on input;
+c                       u_approx(t_cur+dt/2) on output
+c    u_cur (in):        u(t_cur)
+c    rhs (in):          right-hand side of time evolution equation
+c    dt (in):           step size
+c    *_gb (in):         index range for ghostbox
+c    *_fb (in):         index range for fillbox
+c
+c***********************************************************************
+      subroutine lsm2dLowStorageTVDRK3Stage2(
+     &  u_stage,
+     &  ilo_u_stage_gb, ihi_u_stage_gb,
+     &  jlo_u_stage_gb, jhi_u_stage_gb,
+     &  u_cur,
+     &  ilo_u_cur_gb, ihi_u_cur_gb,
+     &  jlo_u_cur_gb, jhi_u_cur_gb,
+     &  rhs,
+     &  ilo_rhs_gb, ihi_rhs_gb,
+     &  jlo_rhs_gb, jhi_rhs_gb,
+     &  ilo_fb, ihi_fb, jlo_fb, jhi_fb,
+     &  dt)
+c***********************************************************************
+c { begin subroutine
+      implicit none
+
+      integer ilo_u_stage_gb, ihi_u_stage_gb
+      integer jlo_u_stage_gb, jhi_u_stage_gb
+      integer ilo_u_cur_gb, ihi_u_cur_gb
+      integer jlo_u_cur_gb, jhi_u_cur_gb
+      integer ilo_rhs_gb, ihi_rhs_gb
+      integer jlo_rhs_gb, jhi_rhs_gb
+      integer ilo_fb, ihi_fb, jlo_fb, jhi_fb
+      real u_stage(ilo_u_stage_gb:ihi_u_stage_gb,
+     &                         jlo_u_stage_gb:jhi_u_stage_gb)
+      real u_cur(ilo_u_cur_gb:ihi_u_cur_gb,
+     &                       jlo_u_cur_gb:jhi_u_cur_gb)
+      real rhs(ilo_rhs_gb:ihi_rhs_gb,
+     &                     jlo_rhs_gb:jhi_rhs_gb)
+      integer i, j
+      real dt
+
+c     { begin loop over grid
+      do j=jlo_fb,jhi_fb
+        do i=ilo_fb,ihi_fb
+
+          u_stage(i,j) = 0.75d0*u_cur(i,j)
+     &                 + 0.25d0*(u_stage(i,j) + dt*rhs(i,j))
+
+        enddo
+      enddo
+c     } end loop over grid
+
+      return
+      end
+c } end subroutine
+c***********************************************************************
+
+c***********************************************************************
+c
+c  lsm2dLowStorageTVDRK3Stage3() completes advancing the solution
+c  through a single step of the third-order TVD Runge-Kutta method
+c  by overwriting u_cur with u(t_cur+dt).
+c  
+c  Arguments:
+c    u_cur (in/out):  u(t_cur) on input; u(t_cur+dt) on output
+c    u_stage (in):    u_approx(t_cur+dt/2)
+c    rhs (in):        right-hand side of time evolution equation
+c    dt (in):         step size
+c    *_gb (in):       index range for ghostbox
+c    *_fb (in):       index range for fillbox
+c
+c***********************************************************************
+      subroutine lsm2dLowStorageTVDRK3Stage3(
+     &  u_cur,
+     &  ilo_u_cur_gb, ihi_u_cur_gb,
+     &  jlo_u_cur_gb, jhi_u_cur_gb,
+     &  u_stage,
+     &  ilo_u_stage_gb, ihi_u_stage_gb,
+     &  jlo_u_stage_gb, jhi_u_stage_gb,
+     &  rhs,
+     &  ilo_rhs_gb, ihi_rhs_gb,
+     &  jlo_rhs_gb, jhi_rhs_gb,
+     &  ilo_fb, ihi_fb, jlo_fb, jhi_fb,
+     &  dt)
+c***********************************************************************
+c { begin subroutine
+      implicit none
+
+      integer ilo_u_cur_gb, ihi_u_cur_gb
+      integer jlo_u_cur_gb, jhi_u_cur_gb
+      integer ilo_u_stage_gb, ihi_u_stage_gb
+      integer jlo_u_stage_gb, jhi_u_stage_gb
+      integer ilo_rhs_gb, ihi_rhs_gb
+      integer jlo_rhs_gb, jhi_rhs_gb
+      integer ilo_fb, ihi_fb, jlo_fb, jhi_fb
+      real u_cur(ilo_u_cur_gb:ihi_u_cur_gb,
+     &                       jlo_u_cur_gb:jhi_u_cur_gb)
+      real u_stage(ilo_u_stage_gb:ihi_u_stage_gb,
+     &                         jlo_u_stage_gb:jhi_u_stage_gb)
+      real rhs(ilo_rhs_gb:ihi_rhs_gb,
+     &                     jlo_rhs_gb:jhi_rhs_gb)
+      integer i, j
+      real dt
+      real one_third, two_thirds
+      parameter (one_third = 1.d0/3.d0)
+      parameter (two_thirds = 2.d0/3.d0)
+
+c     { begin loop over grid
+      do j=jlo_fb,jhi_fb
+        do i=ilo_fb,ihi_fb
+
+          u_cur(i,j) = one_third*u_cur(i,j)
+     &               + two_thirds*( u_stage(i,j) + dt*rhs(i,j) )
+
+        enddo
+      enddo
+c     } end loop over grid
+
+      return
+      end
+c } end subroutine
+c***********************************************************************
@@ -24,6 +24,9 @@ extern "C" {
  * partial differential equations in two space dimensions via 
  * total-variation diminishing Runge-Kutta methods.  Support is provided 
  * for first-, second-, and third-order time integration.
+ * Low-storage versions of the final stages of the second- and
+ * third-order methods overwrite their input arrays so that only
+ * two solution arrays are required per time step.
  * 
  */
 
@@ -40,6 +43,9 @@ extern "C" {
 #define LSM2D_TVD_RK3_STAGE1                lsm2dtvdrk3stage1_
 #define LSM2D_TVD_RK3_STAGE2                lsm2dtvdrk3stage2_
 #define LSM2D_TVD_RK3_STAGE3                lsm2dtvdrk3stage3_
+#define LSM2D_LOW_STORAGE_TVD_RK2_STAGE2    lsm2dlowstoragetvdrk2stage2_
+#define LSM2D_LOW_STORAGE_TVD_RK3_STAGE2    lsm2dlowstoragetvdrk3stage2_
+#define LSM2D_LOW_STORAGE_TVD_RK3_STAGE3    lsm2dlowstoragetvdrk3stage3_
 
 
 /*!
@@ -289,6 +295,141 @@ void LSM2D_TVD_RK3_STAGE3(
   const int *jhi_fb,
   const LSMLIB_REAL *dt);
 
+
+/*!
+ * LSM2D_LOW_STORAGE_TVD_RK2_STAGE2() completes advancing the solution
+ * through a single step of the second-order TVD Runge-Kutta method
+ * by overwriting u_cur with u(t_cur+dt).
+ *
+ * Arguments:
+ *  - u_cur (in/out):    u(t_cur) on input; u(t_cur+dt) on output
+ *  - u_stage1 (in):     u_approx(t_cur+dt)
+ *  - rhs (in):          right-hand side of time evolution equation
+ *  - dt (in):           step size
+ *  - *_gb (in):         index range for ghostbox
+ *  - *_fb (in):         index range for fillbox
+ *
+ * Return value:         none
+ *
+ * NOTES:
+ *  - LSM2D_TVD_RK2_STAGE1() followed by
+ *    LSM2D_LOW_STORAGE_TVD_RK2_STAGE2() requires storage for only two
+ *    solution arrays (u_cur and u_stage1) and gives the same result
+ *    as LSM2D_TVD_RK2_STAGE2().
+ *
+ */
+void LSM2D_LOW_STORAGE_TVD_RK2_STAGE2(
+  LSMLIB_REAL *u_cur,
+  const int *ilo_u_cur_gb,
+  const int *ihi_u_cur_gb,
+  const int *jlo_u_cur_gb,
+  const int *jhi_u_cur_gb,
+  const LSMLIB_REAL *u_stage1,
+  const int *ilo_u_stage1_gb,
+  const int *ihi_u_stage1_gb,
+  const int *jlo_u_stage1_gb,
+  const int *jhi_u_stage1_gb,
+  const LSMLIB_REAL *rhs,
+  const int *ilo_rhs_gb,
+  const int *ihi_rhs_gb,
+  const int *jlo_rhs_gb,
+  const int *jhi_rhs_gb,
+  const int *ilo_fb,
+  const int *ihi_fb,
+  const int *jlo_fb,
+  const int *jhi_fb,
+  const LSMLIB_REAL *dt);
+
+
+/*!
+ * LSM2D_LOW_STORAGE_TVD_RK3_STAGE2() advances the solution through the
+ * second stage of the third-order TVD Runge-Kutta method by
+ * overwriting the first stage solution in u_stage.
+ *
+ * Arguments:
+ *  - u_stage (in/out):  u_approx(t_cur+dt) on input;
+ *                       u_approx(t_cur+dt/2) on output
+ *  - u_cur (in):        u(t_cur)
+ *  - rhs (in):          right-hand side of time evolution equation
+ *  - dt (in):           step size
+ *  - *_gb (in):         index range for ghostbox
+ *  - *_fb (in):         index range for fillbox
+ *
+ * Return value:         none
+ *
+ * NOTES:
+ *  - LSM2D_TVD_RK3_STAGE1() (with u_stage as its output),
+ *    LSM2D_LOW_STORAGE_TVD_RK3_STAGE2() and
+ *    LSM2D_LOW_STORAGE_TVD_RK3_STAGE3() take a complete third-order
+ *    TVD Runge-Kutta step using storage for only two solution
+ *    arrays (u_cur and u_stage).  The result is the same as
+ *    the one computed by the LSM2D_TVD_RK3_STAGE*() routines.
+ *
+ */
+void LSM2D_LOW_STORAGE_TVD_RK3_STAGE2(
+  LSMLIB_REAL *u_stage,
+  const int *ilo_u_stage_gb,
+  const int *ihi_u_stage_gb,
+  const int *jlo_u_stage_gb,
+  const int *jhi_u_stage_gb,
+  const LSMLIB_REAL *u_cur,
+  const int *ilo_u_cur_gb,
+  const int *ihi_u_cur_gb,
+  const int *jlo_u_cur_gb,
+  const int *jhi_u_cur_gb,
+  const LSMLIB_REAL *rhs,
+  const int *ilo_rhs_gb,
+  const int *ihi_rhs_gb,
+  const int *jlo_rhs_gb,
+  const int *jhi_rhs_gb,
+  const int *ilo_fb,
+  const int *ihi_fb,
+  const int *jlo_fb,
+  const int *jhi_fb,
+  const LSMLIB_REAL *dt);
+
+
+/*!
+ * LSM2D_LOW_STORAGE_TVD_RK3_STAGE3() completes advancing the solution
+ * through a single step of the third-order TVD Runge-Kutta method
+ * by overwriting u_cur with u(t_cur+dt).
+ *
+ * Arguments:
+ *  - u_cur (in/out):    u(t_cur) on input; u(t_cur+dt) on output
+ *  - u_stage (in):      u_approx(t_cur+dt/2)
+ *  - rhs (in):          right-hand side of time evolution equation
+ *  - dt (in):           step size
+ *  - *_gb (in):         index range for ghostbox
+ *  - *_fb (in):         index range for fillbox
+ *
+ * Return value:         none
+ *
+ * NOTES:
+ *  - see NOTES for LSM2D_LOW_STORAGE_TVD_RK3_STAGE2()
+ *
+ */
+void LSM2D_LOW_STORAGE_TVD_RK3_STAGE3(
+  LSMLIB_REAL *u_cur,
+  const int *ilo_u_cur_gb,
+  const int *ihi_u_cur_gb,
+  const int *jlo_u_cur_gb,
+  const int *jhi_u_cur_gb,
+  const LSMLIB_REAL *u_stage,
+  const int *ilo_u_stage_gb,
+  const int *ihi_u_stage_gb,
+  const int *jlo_u_stage_gb,
+  const int *jhi_u_stage_gb,
+  const LSMLIB_REAL *rhs,
+  const int *ilo_rhs_gb,
+  const int *ihi_rhs_gb,
+  const int *jlo_rhs_gb,
+  const int *jhi_rhs_gb,
+  const int *ilo_fb,
+  const int *ihi_fb,
+  const int *jlo_fb,
+  const int *jhi_fb,
+  const LSMLIB_REAL *dt);
+
 #ifdef __cplusplus
 }
 #endif
@@ -665,3 +665,380 @@ c     } end loop over indexed points
       end
 c } end subroutine
 c***********************************************************************
+
+
+c***********************************************************************
+c
+c  lsm3dRK1StepLOCALLinear() is identical to lsm3dRK1StepLOCAL() except that
+c  the narrow band points are specified by their linear offsets into
+c  the data arrays (see LSM3D_COMPUTE_NARROW_BAND_LINEAR_INDEX()).
+c  
+c  Arguments:
+c    u_next (out):     u(t_cur+dt)
+c    u_cur (in):       u(t_cur)
+c    rhs (in):         right-hand side of time evolution equation
+c    dt (in):          step size
+c    index_lin(in):    linear offsets of local (narrow band) points
+c    n*_index(in):     index range of points to loop over in index_lin
+c    narrow_band(in):  array that marks voxels outside desired fillbox
+c    mark_fb(in):      upper limit narrow band value for voxels in 
+c                      fillbox 
+c
+c  NOTES:
+c   - all arrays (including narrow_band) must have the same ghostbox
+c
+c***********************************************************************
+      subroutine lsm3dRK1StepLOCALLinear(
+     &  u_next,
+     &  u_cur,
+     &  rhs,
+     &  dt,
+     &  index_lin,
+     &  nlo_index, nhi_index, 
+     &  narrow_band,
+     &  mark_fb)
+c***********************************************************************
+c { begin subroutine
+      implicit none
+
+      real u_next(0:*)
+      real u_cur(0:*)
+      real rhs(0:*)
+      real dt
+      integer nlo_index, nhi_index
+      integer index_lin(nlo_index:nhi_index)
+      integer*1 narrow_band(0:*)
+      integer*1 mark_fb
+
+c     local variables      
+      integer l, m
+
+c     { begin loop over indexed points
+      do l=nlo_index, nhi_index      
+        m=index_lin(l)
+
+        if( narrow_band(m) .le. mark_fb ) then
+          u_next(m) = u_cur(m) + dt*rhs(m)
+        endif
+      enddo
+c     } end loop over indexed points
+
+      return
+      end
+c } end subroutine
+c***********************************************************************
+
+c***********************************************************************
+c
+c  lsm3dTVDRK2Stage1LOCALLinear() is identical to lsm3dTVDRK2Stage1LOCAL() except that
+c  the narrow band points are specified by their linear offsets into
+c  the data arrays (see LSM3D_COMPUTE_NARROW_BAND_LINEAR_INDEX()).
+c  
+c  Arguments:
+c    u_stage1 (out):   u_approx(t_cur+dt)
+c    u_cur (in):       u(t_cur)
+c    rhs (in):         right-hand side of time evolution equation
+c    dt (in):          step size
+c    index_lin(in):    linear offsets of local (narrow band) points
+c    n*_index(in):     index range of points to loop over in index_lin
+c    narrow_band(in):  array that marks voxels outside desired fillbox
+c    mark_fb(in):      upper limit narrow band value for voxels in 
+c                      fillbox 
+c
+c  NOTES:
+c   - all arrays (including narrow_band) must have the same ghostbox
+c   - the first stage of TVD RK2 is identical to a single RK1 step
+c
+c***********************************************************************
+      subroutine lsm3dTVDRK2Stage1LOCALLinear(
+     &  u_stage1,
+     &  u_cur,
+     &  rhs,
+     &  dt,
+     &  index_lin,
+     &  nlo_index, nhi_index, 
+     &  narrow_band,
+     &  mark_fb)
+c***********************************************************************
+c { begin subroutine
+      implicit none
+
+      real u_stage1(0:*)
+      real u_cur(0:*)
+      real rhs(0:*)
+      real dt
+      integer nlo_index, nhi_index
+      integer index_lin(nlo_index:nhi_index)
+      integer*1 narrow_band(0:*)
+      integer*1 mark_fb
+
+c     use lsm3dRK1StepLOCALLinear() to compute first stage
+      call lsm3dRK1StepLOCALLinear(u_stage1,
+     &                  u_cur,
+     &                  rhs,
+     &                  dt,
+     &                  index_lin,
+     &                  nlo_index, nhi_index,
+     &                  narrow_band,
+     &                  mark_fb)
+
+      return
+      end
+c } end subroutine
+c***********************************************************************
+
+c***********************************************************************
+c
+c  lsm3dTVDRK2Stage2LOCALLinear() is identical to lsm3dTVDRK2Stage2LOCAL() except that
+c  the narrow band points are specified by their linear offsets into
+c  the data arrays (see LSM3D_COMPUTE_NARROW_BAND_LINEAR_INDEX()).
+c  
+c  Arguments:
+c    u_next (out):     u(t_cur+dt)
+c    u_stage1 (in):    u_approx(t_cur+dt)
+c    u_cur (in):       u(t_cur)
+c    rhs (in):         right-hand side of time evolution equation
+c    dt (in):          step size
+c    index_lin(in):    linear offsets of local (narrow band) points
+c    n*_index(in):     index range of points to loop over in index_lin
+c    narrow_band(in):  array that marks voxels outside desired fillbox
+c    mark_fb(in):      upper limit narrow band value for voxels in 
+c                      fillbox 
+c
+c  NOTES:
+c   - all arrays (including narrow_band) must have the same ghostbox
+c
+c***********************************************************************
+      subroutine lsm3dTVDRK2Stage2LOCALLinear(
+     &  u_next,
+     &  u_stage1,
+     &  u_cur,
+     &  rhs,
+     &  dt,
+     &  index_lin,
+     &  nlo_index, nhi_index, 
+     &  narrow_band,
+     &  mark_fb)
+c***********************************************************************
+c { begin subroutine
+      implicit none
+
+      real u_next(0:*)
+      real u_stage1(0:*)
+      real u_cur(0:*)
+      real rhs(0:*)
+      real dt
+      integer nlo_index, nhi_index
+      integer index_lin(nlo_index:nhi_index)
+      integer*1 narrow_band(0:*)
+      integer*1 mark_fb
+
+c     local variables      
+      integer l, m
+
+c     { begin loop over indexed points
+      do l=nlo_index, nhi_index      
+        m=index_lin(l)
+
+        if( narrow_band(m) .le. mark_fb ) then
+          u_next(m) = 0.5d0*( u_cur(m) + u_stage1(m) + dt*rhs(m) )
+        endif
+      enddo
+c     } end loop over indexed points
+
+      return
+      end
+c } end subroutine
+c***********************************************************************
+
+c***********************************************************************
+c
+c  lsm3dTVDRK3Stage1LOCALLinear() is identical to lsm3dTVDRK3Stage1LOCAL() except that
+c  the narrow band points are specified by their linear offsets into
+c  the data arrays (see LSM3D_COMPUTE_NARROW_BAND_LINEAR_INDEX()).
+c  
+c  Arguments:
+c    u_stage1 (out):   u_approx(t_cur+dt)
+c    u_cur (in):       u(t_cur)
+c    rhs (in):         right-hand side of time evolution equation
+c    dt (in):          step size
+c    index_lin(in):    linear offsets of local (narrow band) points
+c    n*_index(in):     index range of points to loop over in index_lin
+c    narrow_band(in):  array that marks voxels outside desired fillbox
+c    mark_fb(in):      upper limit narrow band value for voxels in 
+c                      fillbox 
+c
+c  NOTES:
+c   - all arrays (including narrow_band) must have the same ghostbox
+c   - the first stage of TVD RK3 is identical to a single RK1 step
+c
+c***********************************************************************
+      subroutine lsm3dTVDRK3Stage1LOCALLinear(
+     &  u_stage1,
+     &  u_cur,
+     &  rhs,
+     &  dt,
+     &  index_lin,
+     &  nlo_index, nhi_index, 
+     &  narrow_band,
+     &  mark_fb)
+c***********************************************************************
+c { begin subroutine
+      implicit none
+
+      real u_stage1(0:*)
+      real u_cur(0:*)
+      real rhs(0:*)
+      real dt
+      integer nlo_index, nhi_index
+      integer index_lin(nlo_index:nhi_index)
+      integer*1 narrow_band(0:*)
+      integer*1 mark_fb
+
+c     use lsm3dRK1StepLOCALLinear() to compute first stage
+      call lsm3dRK1StepLOCALLinear(u_stage1,
+     &                  u_cur,
+     &                  rhs,
+     &                  dt,
+     &                  index_lin,
+     &                  nlo_index, nhi_index,
+     &                  narrow_band,
+     &                  mark_fb)
+
+      return
+      end
+c } end subroutine
+c***********************************************************************
+
+c***********************************************************************
+c
+c  lsm3dTVDRK3Stage2LOCALLinear() is identical to lsm3dTVDRK3Stage2LOCAL() except that
+c  the narrow band points are specified by their linear offsets into
+c  the data arrays (see LSM3D_COMPUTE_NARROW_BAND_LINEAR_INDEX()).
+c  
+c  Arguments:
+c    u_stage2 (out):   u_approx(t_cur+dt/2)
+c    u_stage1 (in):    u_approx(t_cur+dt)
+c    u_cur (in):       u(t_cur)
+c    rhs (in):         right-hand side of time evolution equation
+c    dt (in):          step size
+c    index_lin(in):    linear offsets of local (narrow band) points
+c    n*_index(in):     index range of points to loop over in index_lin
+c    narrow_band(in):  array that marks voxels outside desired fillbox
+c    mark_fb(in):      upper limit narrow band value for voxels in 
+c                      fillbox 
+c
+c  NOTES:
+c   - all arrays (including narrow_band) must have the same ghostbox
+c
+c***********************************************************************
+      subroutine lsm3dTVDRK3Stage2LOCALLinear(
+     &  u_stage2,
+     &  u_stage1,
+     &  u_cur,
+     &  rhs,
+     &  dt,
+     &  index_lin,
+     &  nlo_index, nhi_index, 
+     &  narrow_band,
+     &  mark_fb)
+c***********************************************************************
+c { begin subroutine
+      implicit none
+
+      real u_stage2(0:*)
+      real u_stage1(0:*)
+      real u_cur(0:*)
+      real rhs(0:*)
+      real dt
+      integer nlo_index, nhi_index
+      integer index_lin(nlo_index:nhi_index)
+      integer*1 narrow_band(0:*)
+      integer*1 mark_fb
+
+c     local variables      
+      integer l, m
+
+c     { begin loop over indexed points
+      do l=nlo_index, nhi_index      
+        m=index_lin(l)
+
+        if( narrow_band(m) .le. mark_fb ) then
+          u_stage2(m) = 0.75d0*u_cur(m)
+     &              + 0.25d0*(u_stage1(m) + dt*rhs(m))
+        endif
+      enddo
+c     } end loop over indexed points
+
+      return
+      end
+c } end subroutine
+c***********************************************************************
+
+c***********************************************************************
+c
+c  lsm3dTVDRK3Stage3LOCALLinear() is identical to lsm3dTVDRK3Stage3LOCAL() except that
+c  the narrow band points are specified by their linear offsets into
+c  the data arrays (see LSM3D_COMPUTE_NARROW_BAND_LINEAR_INDEX()).
+c  
+c  Arguments:
+c    u_next (out):     u(t_cur+dt)
+c    u_stage2 (in):    u_approx(t_cur+dt/2)
+c    u_cur (in):       u(t_cur)
+c    rhs (in):         right-hand side of time evolution equation
+c    dt (in):          step size
+c    index_lin(in):    linear offsets of local (narrow band) points
+c    n*_index(in):     index range of points to loop over in index_lin
+c    narrow_band(in):  array that marks voxels outside desired fillbox
+c    mark_fb(in):      upper limit narrow band value for voxels in 
+c                      fillbox 
+c
+c  NOTES:
+c   - all arrays (including narrow_band) must have the same ghostbox
+c
+c***********************************************************************
+      subroutine lsm3dTVDRK3Stage3LOCALLinear(
+     &  u_next,
+     &  u_stage2,
+     &  u_cur,
+     &  rhs,
+     &  dt,
+     &  index_lin,
+     &  nlo_index, nhi_index, 
+     &  narrow_band,
+     &  mark_fb)
+c***********************************************************************
+c { begin subroutine
+      implicit none
+
+      real u_next(0:*)
+      real u_stage2(0:*)
+      real u_cur(0:*)
+      real rhs(0:*)
+      real dt
+      integer nlo_index, nhi_index
+      integer index_lin(nlo_index:nhi_index)
+      integer*1 narrow_band(0:*)
+      integer*1 mark_fb
+
+c     local variables      
+      integer l, m
+      real one_third, two_thirds
+      parameter (one_third = 1.d0/3.d0)
+      parameter (two_thirds = 2.d0/3.d0)
+
+c     { begin loop over indexed points
+      do l=nlo_index, nhi_index      
+        m=index_lin(l)
+
+        if( narrow_band(m) .le. mark_fb ) then
+          u_next(m) = one_third*u_cur(m)
+     &            + two_thirds*( u_stage2(m) + dt*rhs(m) )
+        endif
+      enddo
+c     } end loop over indexed points
+
+      return
+      end
+c } end subroutine
+c***********************************************************************
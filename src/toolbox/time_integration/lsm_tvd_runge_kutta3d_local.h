@@ -25,6 +25,12 @@
 #define LSM3D_TVD_RK3_STAGE1_LOCAL                lsm3dtvdrk3stage1local_
 #define LSM3D_TVD_RK3_STAGE2_LOCAL                lsm3dtvdrk3stage2local_
 #define LSM3D_TVD_RK3_STAGE3_LOCAL                lsm3dtvdrk3stage3local_
+#define LSM3D_RK1_STEP_LOCAL_LINEAR               lsm3drk1steplocallinear_
+#define LSM3D_TVD_RK2_STAGE1_LOCAL_LINEAR         lsm3dtvdrk2stage1locallinear_
+#define LSM3D_TVD_RK2_STAGE2_LOCAL_LINEAR         lsm3dtvdrk2stage2locallinear_
+#define LSM3D_TVD_RK3_STAGE1_LOCAL_LINEAR         lsm3dtvdrk3stage1locallinear_
+#define LSM3D_TVD_RK3_STAGE2_LOCAL_LINEAR         lsm3dtvdrk3stage2locallinear_
+#define LSM3D_TVD_RK3_STAGE3_LOCAL_LINEAR         lsm3dtvdrk3stage3locallinear_
 
 #include "LSMLIB_config.h"
 
@@ -277,6 +283,84 @@ void LSM3D_TVD_RK3_STAGE1_LOCAL(
   const int *klo_nb_gb,
   const int *khi_nb_gb,
   const unsigned char *mark_fb);
+
+
+/*
+ * The _LINEAR variants of the narrow band TVD Runge-Kutta routines take
+ * the linear offsets of the narrow band points into the data arrays 
+ * (computed by LSM3D_COMPUTE_NARROW_BAND_LINEAR_INDEX()) instead of their
+ * (i,j,k) coordinates.  All arrays (including narrow_band) must have the 
+ * same ghostbox.
+ */
+
+void LSM3D_RK1_STEP_LOCAL_LINEAR(
+  LSMLIB_REAL *u_next,
+  const LSMLIB_REAL *u_cur,
+  const LSMLIB_REAL *rhs,
+  const LSMLIB_REAL *dt,
+  const int *index_lin,
+  const int *nlo_index,
+  const int *nhi_index,
+  const unsigned char *narrow_band,
+  const unsigned char *mark_fb);
+
+void LSM3D_TVD_RK2_STAGE1_LOCAL_LINEAR(
+  LSMLIB_REAL *u_stage1,
+  const LSMLIB_REAL *u_cur,
+  const LSMLIB_REAL *rhs,
+  const LSMLIB_REAL *dt,
+  const int *index_lin,
+  const int *nlo_index,
+  const int *nhi_index,
+  const unsigned char *narrow_band,
+  const unsigned char *mark_fb);
+
+void LSM3D_TVD_RK2_STAGE2_LOCAL_LINEAR(
+  LSMLIB_REAL *u_next,
+  const LSMLIB_REAL *u_stage1,
+  const LSMLIB_REAL *u_cur,
+  const LSMLIB_REAL *rhs,
+  const LSMLIB_REAL *dt,
+  const int *index_lin,
+  const int *nlo_index,
+  const int *nhi_index,
+  const unsigned char *narrow_band,
+  const unsigned char *mark_fb);
+
+void LSM3D_TVD_RK3_STAGE1_LOCAL_LINEAR(
+  LSMLIB_REAL *u_stage1,
+  const LSMLIB_REAL *u_cur,
+  const LSMLIB_REAL *rhs,
+  const LSMLIB_REAL *dt,
+  const int *index_lin,
+  const int *nlo_index,
+  const int *nhi_index,
+  const unsigned char *narrow_band,
+  const unsigned char *mark_fb);
+
+void LSM3D_TVD_RK3_STAGE2_LOCAL_LINEAR(
+  LSMLIB_REAL *u_stage2,
+  const LSMLIB_REAL *u_stage1,
+  const LSMLIB_REAL *u_cur,
+  const LSMLIB_REAL *rhs,
+  const LSMLIB_REAL *dt,
+  const int *index_lin,
+  const int *nlo_index,
+  const int *nhi_index,
+  const unsigned char *narrow_band,
+  const unsigned char *mark_fb);
+
+void LSM3D_TVD_RK3_STAGE3_LOCAL_LINEAR(
+  LSMLIB_REAL *u_next,
+  const LSMLIB_REAL *u_stage2,
+  const LSMLIB_REAL *u_cur,
+  const LSMLIB_REAL *rhs,
+  const LSMLIB_REAL *dt,
+  const int *index_lin,
+  const int *nlo_index,
+  const int *nhi_index,
+  const unsigned char *narrow_band,
+  const unsigned char *mark_fb);
        
 #ifdef __cplusplus
 }
@@ -34,6 +34,11 @@ extern "C" {
  *      ----------                     ------------
  */
 #define LSM3D_MAX_NORM_DIFF_LOCAL      lsm3dmaxnormdifflocal_
+#define LSM3D_AVE_ABS_DIFF_LOCAL       lsm3daveabsdifflocal_
+#define LSM3D_VOXEL_COUNT_GREATER_THAN_ZERO_LOCAL                         \
+                                       lsm3dvoxelcountgreaterthanzerolocal_
+#define LSM3D_VOXEL_COUNT_LESS_THAN_ZERO_LOCAL                            \
+                                       lsm3dvoxelcountlessthanzerolocal_
 
 #define LSM3D_COMPUTE_STABLE_ADVECTION_DT_LOCAL                           \
                                        lsm3dcomputestableadvectiondtlocal_
@@ -92,6 +97,146 @@ void LSM3D_MAX_NORM_DIFF_LOCAL(
   const int *khi_nb_gb,
   const unsigned char *mark_fb);
 
+/*!
+*
+*  LSM3D_AVE_ABS_DIFF_LOCAL() computes the average pointwise abs. difference 
+*  between the two specified scalar fields.
+*  The routine loops only over local (narrow band) points. 
+*
+*  Arguments:
+*    ave_abs_diff (out):   average of the difference between the fields
+*    field1 (in):          scalar field 1
+*    field2 (in):          scalar field 2
+*    index_*(in):          coordinates of local (narrow band) points
+*    n*_index(in):         index range of points in index_*
+*    *_gb (in):            index range for ghostbox
+*    narrow_band(in):      array that marks voxels outside desired fillbox
+*    mark_fb(in):          upper limit narrow band value for voxels in 
+*                          fillbox
+*
+*/
+void LSM3D_AVE_ABS_DIFF_LOCAL(
+  LSMLIB_REAL *ave_abs_diff,
+  const LSMLIB_REAL *field1,
+  const int *ilo_field1_gb, 
+  const int *ihi_field1_gb,
+  const int *jlo_field1_gb, 
+  const int *jhi_field1_gb,
+  const int *klo_field1_gb, 
+  const int *khi_field1_gb,
+  const LSMLIB_REAL *field2,
+  const int *ilo_field2_gb, 
+  const int *ihi_field2_gb,
+  const int *jlo_field2_gb, 
+  const int *jhi_field2_gb,
+  const int *klo_field2_gb, 
+  const int *khi_field2_gb,
+  const int *index_x,
+  const int *index_y, 
+  const int *index_z,
+  const int *nlo_index,
+  const int *nhi_index,
+  const unsigned char *narrow_band,
+  const int *ilo_nb_gb,
+  const int *ihi_nb_gb,
+  const int *jlo_nb_gb,
+  const int *jhi_nb_gb,
+  const int *klo_nb_gb,
+  const int *khi_nb_gb,
+  const unsigned char *mark_fb);
+
+/*!
+*
+*  LSM3D_VOXEL_COUNT_GREATER_THAN_ZERO_LOCAL() counts the number of local
+*  (narrow band) voxels where phi > 0.
+*
+*  Arguments:
+*    count (out):          number of narrow band voxels where phi > 0
+*    phi (in):             level set function
+*    *_gb (in):            index range for ghostbox
+*    index_*(in):          coordinates of local (narrow band) points
+*    n*_index(in):         index range of points in index_*
+*    narrow_band(in):      array that marks voxels outside desired fillbox
+*    mark_fb(in):          upper limit narrow band value for voxels in 
+*                          fillbox
+*
+*  NOTES:
+*   - see LSM3D_VOXEL_COUNT_LESS_THAN_ZERO_LOCAL() for how to use the
+*     count to track the number of voxels outside of the narrow band.
+*
+*/
+void LSM3D_VOXEL_COUNT_GREATER_THAN_ZERO_LOCAL(
+  int *count,
+  const LSMLIB_REAL *phi,
+  const int *ilo_gb, 
+  const int *ihi_gb,
+  const int *jlo_gb, 
+  const int *jhi_gb,
+  const int *klo_gb, 
+  const int *khi_gb,
+  const int *index_x,
+  const int *index_y, 
+  const int *index_z,
+  const int *nlo_index,
+  const int *nhi_index,
+  const unsigned char *narrow_band,
+  const int *ilo_nb_gb,
+  const int *ihi_nb_gb,
+  const int *jlo_nb_gb,
+  const int *jhi_nb_gb,
+  const int *klo_nb_gb,
+  const int *khi_nb_gb,
+  const unsigned char *mark_fb);
+
+/*!
+*
+*  LSM3D_VOXEL_COUNT_LESS_THAN_ZERO_LOCAL() counts the number of local
+*  (narrow band) voxels where phi < 0.
+*
+*  Arguments:
+*    count (out):          number of narrow band voxels where phi < 0
+*    phi (in):             level set function
+*    *_gb (in):            index range for ghostbox
+*    index_*(in):          coordinates of local (narrow band) points
+*    n*_index(in):         index range of points in index_*
+*    narrow_band(in):      array that marks voxels outside desired fillbox
+*    mark_fb(in):          upper limit narrow band value for voxels in 
+*                          fillbox
+*
+*  NOTES:
+*   - The number of voxels with phi < 0 that lie outside of the narrow 
+*     band (needed by LSM3D_VOLUME_REGION_PHI_LESS_THAN_ZERO_LOCAL()) 
+*     can be maintained without sweeping the grid: compute it once 
+*     (LSM3D_VOXEL_COUNT_LESS_THAN_ZERO() minus this count) when the 
+*     narrow band is determined, and afterwards subtract the 
+*     num_neg_change returned by LSM3D_UPDATE_NARROW_BAND() after each
+*     update.  This requires that phi is changed only within the narrow
+*     band between updates.
+*
+*/
+void LSM3D_VOXEL_COUNT_LESS_THAN_ZERO_LOCAL(
+  int *count,
+  const LSMLIB_REAL *phi,
+  const int *ilo_gb, 
+  const int *ihi_gb,
+  const int *jlo_gb, 
+  const int *jhi_gb,
+  const int *klo_gb, 
+  const int *khi_gb,
+  const int *index_x,
+  const int *index_y, 
+  const int *index_z,
+  const int *nlo_index,
+  const int *nhi_index,
+  const unsigned char *narrow_band,
+  const int *ilo_nb_gb,
+  const int *ihi_nb_gb,
+  const int *jlo_nb_gb,
+  const int *jhi_nb_gb,
+  const int *klo_nb_gb,
+  const int *khi_nb_gb,
+  const unsigned char *mark_fb);
+
 /*!
 *
 *  LSM3D_COMPUTE_STABLE_ADVECTION_DT_LOCAL() computes the stable time step size 